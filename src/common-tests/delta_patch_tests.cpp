@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "common/delta_patch.h"
+#include "common/error.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+static std::vector<u8> RandomBuffer(size_t size, u32 seed)
+{
+  std::mt19937 rng(seed);
+  std::vector<u8> buffer(size);
+  for (u8& b : buffer)
+    b = static_cast<u8>(rng());
+  return buffer;
+}
+
+TEST(DeltaPatch, RoundTrip)
+{
+  const std::vector<u8> base = RandomBuffer(200000, 1);
+
+  // Flip a range, insert a run, and delete a run, like consecutive builds of a binary would.
+  std::vector<u8> modified = base;
+  for (size_t i = 50000; i < 55000; i++)
+    modified[i] ^= 0x5A;
+  const std::vector<u8> inserted = RandomBuffer(3000, 2);
+  modified.insert(modified.begin() + 100000, inserted.begin(), inserted.end());
+  modified.erase(modified.begin() + 150000, modified.begin() + 152000);
+
+  std::vector<u8> patch;
+  ASSERT_TRUE(DeltaPatch::Create(base.data(), base.size(), modified.data(), modified.size(), &patch));
+
+  // The patch should be in the ballpark of the changed bytes, not the file size.
+  EXPECT_LT(patch.size(), modified.size() / 4);
+
+  Error error;
+  std::vector<u8> output;
+  ASSERT_TRUE(DeltaPatch::Apply(patch.data(), patch.size(), base.data(), base.size(), &output, &error))
+    << error.GetDescription();
+  EXPECT_EQ(output, modified);
+}
+
+TEST(DeltaPatch, IdenticalFilesProduceTinyPatch)
+{
+  const std::vector<u8> base = RandomBuffer(100000, 3);
+
+  std::vector<u8> patch;
+  ASSERT_TRUE(DeltaPatch::Create(base.data(), base.size(), base.data(), base.size(), &patch));
+  EXPECT_LT(patch.size(), static_cast<size_t>(1024));
+
+  Error error;
+  std::vector<u8> output;
+  ASSERT_TRUE(DeltaPatch::Apply(patch.data(), patch.size(), base.data(), base.size(), &output, &error));
+  EXPECT_EQ(output, base);
+}
+
+TEST(DeltaPatch, RejectsMismatchedBase)
+{
+  const std::vector<u8> base = RandomBuffer(10000, 4);
+  const std::vector<u8> modified = RandomBuffer(10000, 5);
+
+  std::vector<u8> patch;
+  ASSERT_TRUE(DeltaPatch::Create(base.data(), base.size(), modified.data(), modified.size(), &patch));
+
+  std::vector<u8> wrong_base = base;
+  wrong_base[5000] ^= 1;
+
+  Error error;
+  std::vector<u8> output;
+  EXPECT_FALSE(DeltaPatch::Apply(patch.data(), patch.size(), wrong_base.data(), wrong_base.size(), &output, &error));
+}
+
+TEST(DeltaPatch, RejectsTruncatedPatch)
+{
+  const std::vector<u8> base = RandomBuffer(10000, 6);
+  const std::vector<u8> modified = RandomBuffer(10000, 7);
+
+  std::vector<u8> patch;
+  ASSERT_TRUE(DeltaPatch::Create(base.data(), base.size(), modified.data(), modified.size(), &patch));
+  ASSERT_GT(patch.size(), sizeof(DeltaPatch::Header));
+
+  Error error;
+  std::vector<u8> output;
+  EXPECT_FALSE(DeltaPatch::Apply(patch.data(), patch.size() - 16, base.data(), base.size(), &output, &error));
+  EXPECT_FALSE(DeltaPatch::Apply(patch.data(), sizeof(DeltaPatch::Header) - 1, base.data(), base.size(), &output,
+                                 &error));
+}
+
+TEST(DeltaPatch, HeaderCarriesBaseDigest)
+{
+  const std::vector<u8> base = RandomBuffer(10000, 8);
+  const std::vector<u8> modified = RandomBuffer(10000, 9);
+
+  std::vector<u8> patch;
+  ASSERT_TRUE(DeltaPatch::Create(base.data(), base.size(), modified.data(), modified.size(), &patch));
+
+  DeltaPatch::Header header;
+  ASSERT_TRUE(DeltaPatch::GetHeader(patch.data(), patch.size(), &header));
+  EXPECT_EQ(header.base_size, base.size());
+  EXPECT_EQ(header.output_size, modified.size());
+  EXPECT_TRUE(DeltaPatch::HashMatches(header.base_hash, base.data(), base.size()));
+  EXPECT_TRUE(DeltaPatch::HashMatches(header.output_hash, modified.data(), modified.size()));
+  EXPECT_FALSE(DeltaPatch::HashMatches(header.base_hash, modified.data(), modified.size()));
+}
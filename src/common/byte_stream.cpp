@@ -5,6 +5,7 @@
 #include "assert.h"
 #include "file_system.h"
 #include "log.h"
+#include "memmap.h"
 #include "string_util.h"
 
 #include <algorithm>
@@ -688,6 +689,120 @@ bool ReadOnlyMemoryByteStream::Discard()
   return false;
 }
 
+MemoryMappedFileByteStream::MemoryMappedFileByteStream(const void* pMemory, size_t MemSize)
+{
+  m_position = 0;
+  m_size = MemSize;
+  m_pMemory = reinterpret_cast<const u8*>(pMemory);
+}
+
+MemoryMappedFileByteStream::~MemoryMappedFileByteStream()
+{
+  MemMap::UnmapReadOnlyFile(const_cast<u8*>(m_pMemory), m_size);
+}
+
+bool MemoryMappedFileByteStream::ReadByte(u8* pDestByte)
+{
+  if (m_position < m_size)
+  {
+    *pDestByte = m_pMemory[m_position++];
+    return true;
+  }
+
+  return false;
+}
+
+u32 MemoryMappedFileByteStream::Read(void* pDestination, u32 ByteCount)
+{
+  size_t sz = ByteCount;
+  if ((m_position + sz) > m_size)
+    sz = m_size - m_position;
+
+  if (sz > 0)
+  {
+    std::memcpy(pDestination, m_pMemory + m_position, sz);
+    m_position += sz;
+  }
+
+  return static_cast<u32>(sz);
+}
+
+bool MemoryMappedFileByteStream::Read2(void* pDestination, u32 ByteCount, u32* pNumberOfBytesRead /* = nullptr */)
+{
+  u32 r = Read(pDestination, ByteCount);
+  if (pNumberOfBytesRead != nullptr)
+    *pNumberOfBytesRead = r;
+
+  return (r == ByteCount);
+}
+
+bool MemoryMappedFileByteStream::WriteByte(u8 SourceByte)
+{
+  return false;
+}
+
+u32 MemoryMappedFileByteStream::Write(const void* pSource, u32 ByteCount)
+{
+  return 0;
+}
+
+bool MemoryMappedFileByteStream::Write2(const void* pSource, u32 ByteCount, u32* pNumberOfBytesWritten /* = nullptr */)
+{
+  return false;
+}
+
+bool MemoryMappedFileByteStream::SeekAbsolute(u64 Offset)
+{
+  if (Offset > static_cast<u64>(m_size))
+    return false;
+
+  m_position = static_cast<size_t>(Offset);
+  return true;
+}
+
+bool MemoryMappedFileByteStream::SeekRelative(s64 Offset)
+{
+  if ((Offset < 0 && static_cast<u64>(-Offset) > static_cast<u64>(m_position)) ||
+      (static_cast<u64>(m_position) + Offset) > static_cast<u64>(m_size))
+  {
+    return false;
+  }
+
+  m_position = static_cast<size_t>(static_cast<s64>(m_position) + Offset);
+  return true;
+}
+
+bool MemoryMappedFileByteStream::SeekToEnd()
+{
+  m_position = m_size;
+  return true;
+}
+
+u64 MemoryMappedFileByteStream::GetSize() const
+{
+  return static_cast<u64>(m_size);
+}
+
+u64 MemoryMappedFileByteStream::GetPosition() const
+{
+  return static_cast<u64>(m_position);
+}
+
+bool MemoryMappedFileByteStream::Flush()
+{
+  return false;
+}
+
+bool MemoryMappedFileByteStream::Commit()
+{
+  return false;
+}
+
+bool MemoryMappedFileByteStream::Discard()
+{
+  return false;
+}
+
 GrowableMemoryByteStream::GrowableMemoryByteStream(void* pInitialMem, u32 InitialMemSize)
 {
   m_iPosition = 0;
@@ -1189,6 +1304,19 @@ std::unique_ptr<ReadOnlyMemoryByteStream> ByteStream::CreateReadOnlyMemoryStream
   return std::make_unique<ReadOnlyMemoryByteStream>(pMemory, Size);
 }
 
+std::unique_ptr<MemoryMappedFileByteStream> ByteStream::OpenMemoryMappedFile(const char* fileName)
+{
+  size_t size;
+  void* ptr = MemMap::MapReadOnlyFile(fileName, &size, nullptr);
+  if (!ptr)
+    return nullptr;
+
+  // Most callers consume the whole file, so get the OS reading ahead of the faults now.
+  MemMap::AdviseReadAhead(ptr, size);
+
+  return std::make_unique<MemoryMappedFileByteStream>(ptr, size);
+}
+
 std::unique_ptr<NullByteStream> ByteStream::CreateNullStream()
 {
   return std::make_unique<NullByteStream>();
@@ -28,6 +28,7 @@ class ByteStream;
 class MemoryByteStream;
 class GrowableMemoryByteStream;
 class ReadOnlyMemoryByteStream;
+class MemoryMappedFileByteStream;
 class NullByteStream;
 
 // interface class used by readers, writers, etc.
@@ -119,6 +120,10 @@ public:
   // readable memory stream
   static std::unique_ptr<ReadOnlyMemoryByteStream> CreateReadOnlyMemoryStream(const void* pMemory, u32 Size);
 
+  // memory-maps a local file for zero-copy, page-cache-friendly read-only access. returns nullptr
+  // on failure (e.g. empty file), in which case callers should fall back to OpenFile().
+  static std::unique_ptr<MemoryMappedFileByteStream> OpenMemoryMappedFile(const char* fileName);
+
   // null memory stream
   static std::unique_ptr<NullByteStream> CreateNullStream();
 
@@ -235,6 +240,38 @@ private:
   u32 m_iSize;
 };
 
+// Read-only view of a memory-mapped file. Reads are serviced directly out of the page cache, so
+// nothing is copied until the caller asks for it, and parsers can work in-place on the pointer.
+class MemoryMappedFileByteStream final : public ByteStream
+{
+public:
+  MemoryMappedFileByteStream(const void* pMemory, size_t MemSize);
+  ~MemoryMappedFileByteStream() override;
+
+  const u8* GetMemoryPointer() const { return m_pMemory; }
+  size_t GetMemorySize() const { return m_size; }
+
+  bool ReadByte(u8* pDestByte) override;
+  u32 Read(void* pDestination, u32 ByteCount) override;
+  bool Read2(void* pDestination, u32 ByteCount, u32* pNumberOfBytesRead /* = nullptr */) override;
+  bool WriteByte(u8 SourceByte) override;
+  u32 Write(const void* pSource, u32 ByteCount) override;
+  bool Write2(const void* pSource, u32 ByteCount, u32* pNumberOfBytesWritten /* = nullptr */) override;
+  bool SeekAbsolute(u64 Offset) override;
+  bool SeekRelative(s64 Offset) override;
+  bool SeekToEnd() override;
+  u64 GetSize() const override;
+  u64 GetPosition() const override;
+  bool Flush() override;
+  bool Commit() override;
+  bool Discard() override;
+
+private:
+  const u8* m_pMemory;
+  size_t m_position;
+  size_t m_size;
+};
+
 class GrowableMemoryByteStream final : public ByteStream
 {
 public:
@@ -0,0 +1,243 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "delta_patch.h"
+#include "error.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+// The command stream following the header is a sequence of u32 control words. When the top bit is
+// set, the low 31 bits give the length of a copy from the base file, and a u64 base offset
+// follows. When it is clear, the control word gives the length of a run of literal bytes, which
+// follow directly. The stream ends when the output reaches the size given in the header.
+static constexpr u32 COMMAND_COPY_FLAG = UINT32_C(0x80000000);
+static constexpr u32 MAX_COMMAND_LENGTH = UINT32_C(0x7FFFFFFF);
+
+// Matches against the base file are located via a Rabin-Karp rolling hash over BLOCK_SIZE-byte
+// windows. Matches shorter than a block are not worth the copy command overhead.
+static constexpr size_t BLOCK_SIZE = 64;
+static constexpr u64 ROLLING_HASH_PRIME = UINT64_C(1099511628211);
+
+static void ComputeHash(const void* data, size_t size, u8 hash[SHA256Digest::DIGEST_SIZE])
+{
+  SHA256Digest digest;
+  digest.Update(data, static_cast<u32>(size));
+  digest.Final(hash);
+}
+
+bool DeltaPatch::GetHeader(const void* patch, size_t patch_size, Header* out_header)
+{
+  if (patch_size < sizeof(Header))
+    return false;
+
+  std::memcpy(out_header, patch, sizeof(Header));
+  return (out_header->magic == HEADER_MAGIC && out_header->version == HEADER_VERSION);
+}
+
+bool DeltaPatch::HashMatches(const u8 hash[SHA256Digest::DIGEST_SIZE], const void* data, size_t size)
+{
+  u8 actual_hash[SHA256Digest::DIGEST_SIZE];
+  ComputeHash(data, size, actual_hash);
+  return (std::memcmp(hash, actual_hash, SHA256Digest::DIGEST_SIZE) == 0);
+}
+
+bool DeltaPatch::Apply(const void* patch, size_t patch_size, const void* base, size_t base_size,
+                       std::vector<u8>* output, Error* error)
+{
+  Header header;
+  if (!GetHeader(patch, patch_size, &header))
+  {
+    Error::SetString(error, "Patch header is invalid.");
+    return false;
+  }
+
+  if (base_size != header.base_size || !HashMatches(header.base_hash, base, base_size))
+  {
+    Error::SetString(error, "Base file does not match the file this patch was generated against.");
+    return false;
+  }
+
+  const u8* const patch_bytes = static_cast<const u8*>(patch);
+  const u8* const base_bytes = static_cast<const u8*>(base);
+  size_t patch_pos = sizeof(Header);
+
+  output->clear();
+  output->reserve(header.output_size);
+
+  while (output->size() < header.output_size)
+  {
+    u32 control;
+    if ((patch_size - patch_pos) < sizeof(control))
+    {
+      Error::SetString(error, "Patch is truncated.");
+      return false;
+    }
+    std::memcpy(&control, &patch_bytes[patch_pos], sizeof(control));
+    patch_pos += sizeof(control);
+
+    const size_t length = (control & MAX_COMMAND_LENGTH);
+    if (length == 0 || length > (header.output_size - output->size()))
+    {
+      Error::SetString(error, "Patch command length is invalid.");
+      return false;
+    }
+
+    if (control & COMMAND_COPY_FLAG)
+    {
+      u64 base_offset;
+      if ((patch_size - patch_pos) < sizeof(base_offset))
+      {
+        Error::SetString(error, "Patch is truncated.");
+        return false;
+      }
+      std::memcpy(&base_offset, &patch_bytes[patch_pos], sizeof(base_offset));
+      patch_pos += sizeof(base_offset);
+
+      if (base_offset > base_size || length > (base_size - base_offset))
+      {
+        Error::SetString(error, "Patch copy command exceeds the base file.");
+        return false;
+      }
+
+      output->insert(output->end(), &base_bytes[base_offset], &base_bytes[base_offset + length]);
+    }
+    else
+    {
+      if ((patch_size - patch_pos) < length)
+      {
+        Error::SetString(error, "Patch is truncated.");
+        return false;
+      }
+
+      output->insert(output->end(), &patch_bytes[patch_pos], &patch_bytes[patch_pos + length]);
+      patch_pos += length;
+    }
+  }
+
+  if (!HashMatches(header.output_hash, output->data(), output->size()))
+  {
+    Error::SetString(error, "Patched file failed digest verification.");
+    return false;
+  }
+
+  return true;
+}
+
+static void AppendToPatch(std::vector<u8>* patch, const void* data, size_t size)
+{
+  const u8* bytes = static_cast<const u8*>(data);
+  patch->insert(patch->end(), bytes, bytes + size);
+}
+
+static void EmitLiterals(std::vector<u8>* patch, const u8* data, size_t size)
+{
+  while (size > 0)
+  {
+    const u32 chunk = static_cast<u32>(std::min<size_t>(size, MAX_COMMAND_LENGTH));
+    AppendToPatch(patch, &chunk, sizeof(chunk));
+    AppendToPatch(patch, data, chunk);
+    data += chunk;
+    size -= chunk;
+  }
+}
+
+static void EmitCopy(std::vector<u8>* patch, u64 base_offset, size_t size)
+{
+  while (size > 0)
+  {
+    const u32 chunk = static_cast<u32>(std::min<size_t>(size, MAX_COMMAND_LENGTH));
+    const u32 control = (chunk | COMMAND_COPY_FLAG);
+    AppendToPatch(patch, &control, sizeof(control));
+    AppendToPatch(patch, &base_offset, sizeof(base_offset));
+    base_offset += chunk;
+    size -= chunk;
+  }
+}
+
+static u64 HashBlock(const u8* data)
+{
+  u64 hash = 0;
+  for (size_t i = 0; i < BLOCK_SIZE; i++)
+    hash = (hash * ROLLING_HASH_PRIME) + data[i];
+  return hash;
+}
+
+bool DeltaPatch::Create(const void* base, size_t base_size, const void* output, size_t output_size,
+                        std::vector<u8>* patch)
+{
+  const u8* const base_bytes = static_cast<const u8*>(base);
+  const u8* const output_bytes = static_cast<const u8*>(output);
+
+  Header header = {};
+  header.magic = HEADER_MAGIC;
+  header.version = HEADER_VERSION;
+  header.base_size = base_size;
+  header.output_size = output_size;
+  ComputeHash(base, base_size, header.base_hash);
+  ComputeHash(output, output_size, header.output_hash);
+
+  patch->clear();
+  AppendToPatch(patch, &header, sizeof(header));
+
+  // Index every aligned block of the base file by its rolling hash. Collisions are resolved by
+  // comparing the actual bytes below, so a multimap is not required.
+  std::unordered_map<u64, size_t> base_blocks;
+  if (base_size >= BLOCK_SIZE)
+  {
+    base_blocks.reserve(base_size / BLOCK_SIZE);
+    for (size_t offset = 0; (base_size - offset) >= BLOCK_SIZE; offset += BLOCK_SIZE)
+      base_blocks.emplace(HashBlock(&base_bytes[offset]), offset);
+  }
+
+  // Multiplier which removes the leading byte from the rolling window.
+  u64 leading_factor = 1;
+  for (size_t i = 0; i < (BLOCK_SIZE - 1); i++)
+    leading_factor *= ROLLING_HASH_PRIME;
+
+  size_t pos = 0;
+  size_t literal_start = 0;
+  u64 window_hash = (output_size >= BLOCK_SIZE) ? HashBlock(output_bytes) : 0;
+
+  while ((output_size - pos) >= BLOCK_SIZE)
+  {
+    const auto it = base_blocks.find(window_hash);
+    size_t match_length = 0;
+    size_t match_offset = 0;
+    if (it != base_blocks.end() && std::memcmp(&base_bytes[it->second], &output_bytes[pos], BLOCK_SIZE) == 0)
+    {
+      // Extend the match as far as both files agree.
+      match_offset = it->second;
+      match_length = BLOCK_SIZE;
+      while ((match_offset + match_length) < base_size && (pos + match_length) < output_size &&
+             base_bytes[match_offset + match_length] == output_bytes[pos + match_length])
+      {
+        match_length++;
+      }
+    }
+
+    if (match_length > 0)
+    {
+      EmitLiterals(patch, &output_bytes[literal_start], pos - literal_start);
+      EmitCopy(patch, match_offset, match_length);
+      pos += match_length;
+      literal_start = pos;
+      if ((output_size - pos) >= BLOCK_SIZE)
+        window_hash = HashBlock(&output_bytes[pos]);
+    }
+    else
+    {
+      // No match here; roll the window forward one byte.
+      if ((output_size - pos) > BLOCK_SIZE)
+      {
+        window_hash = ((window_hash - (output_bytes[pos] * leading_factor)) * ROLLING_HASH_PRIME) +
+                      output_bytes[pos + BLOCK_SIZE];
+      }
+      pos++;
+    }
+  }
+
+  EmitLiterals(patch, &output_bytes[literal_start], output_size - literal_start);
+  return true;
+}
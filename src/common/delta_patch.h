@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "sha256_digest.h"
+#include "types.h"
+
+#include <cstddef>
+#include <vector>
+
+class Error;
+
+/// Binary delta patches for the auto updater. A patch carries the SHA-256 digests of the file it
+/// applies to and the file it produces, followed by a stream of copy/insert commands, so that
+/// consecutive releases can ship the few percent of bytes which actually changed instead of the
+/// whole package. All integer fields are little-endian.
+namespace DeltaPatch {
+
+enum : u32
+{
+  HEADER_MAGIC = 0x50445344u, // 'DSDP'
+  HEADER_VERSION = 1u,
+};
+
+#pragma pack(push, 1)
+struct Header
+{
+  u32 magic;
+  u32 version;
+  u64 base_size;
+  u64 output_size;
+  u8 base_hash[SHA256Digest::DIGEST_SIZE];
+  u8 output_hash[SHA256Digest::DIGEST_SIZE];
+};
+#pragma pack(pop)
+
+/// Validates and returns the fixed-size patch header. Lets callers check the base file digest
+/// up front, before committing to an apply (or a download).
+bool GetHeader(const void* patch, size_t patch_size, Header* out_header);
+
+/// Returns true if the SHA-256 digest of data matches hash.
+bool HashMatches(const u8 hash[SHA256Digest::DIGEST_SIZE], const void* data, size_t size);
+
+/// Applies patch to base, producing output. The base digest is verified before applying and the
+/// output digest afterwards, so a false return means output must be discarded, but nothing else;
+/// callers are expected to fall back to a full update package.
+bool Apply(const void* patch, size_t patch_size, const void* base, size_t base_size, std::vector<u8>* output,
+           Error* error);
+
+/// Creates a patch transforming base into output. Used by release tooling; the apply side does
+/// not depend on how the patch was generated, only on the command stream being well-formed.
+bool Create(const void* base, size_t base_size, const void* output, size_t output_size, std::vector<u8>* patch);
+
+} // namespace DeltaPatch
@@ -5,6 +5,7 @@
 #include "assert.h"
 #include "types.h"
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <type_traits>
 
@@ -137,6 +138,28 @@ public:
     return val;
   }
 
+  // faster version of PopRange for POD types which can be memcpy()ed
+  template<class Y = T, std::enable_if_t<std::is_standard_layout_v<Y>&& std::is_trivial_v<Y>, int> = 0>
+  void PopRange(T* out_data, u32 count)
+  {
+    DebugAssert(m_size >= count);
+    const u32 size_before_end = CAPACITY - m_head;
+    const u32 count_before_end = (count > size_before_end) ? size_before_end : count;
+    const u32 count_after_end = count - count_before_end;
+
+    std::memcpy(out_data, &m_ptr[m_head], sizeof(T) * count_before_end);
+    m_head = (m_head + count_before_end) % CAPACITY;
+
+    if (count_after_end > 0)
+    {
+      std::memcpy(out_data + count_before_end, &m_ptr[m_head], sizeof(T) * count_after_end);
+      m_head = (m_head + count_after_end) % CAPACITY;
+    }
+
+    m_size -= count;
+  }
+
+  template<class Y = T, std::enable_if_t<!std::is_standard_layout_v<Y> || !std::is_trivial_v<Y>, int> = 0>
   void PopRange(T* out_data, u32 count)
   {
     DebugAssert(m_size >= count);
@@ -186,6 +209,146 @@ protected:
   u32 m_size = 0;
 };
 
+// Lock-free single-producer/single-consumer ring. CAPACITY must be a power of two. The producer
+// and consumer positions are free-running counters on separate cache lines, so neither side
+// false-shares with the other. Bulk transfers can avoid staging copies by reserving a contiguous
+// span with BeginWrite()/BeginRead(), filling or draining it in place, and committing with
+// EndWrite()/EndRead().
+template<typename T, u32 CAPACITY>
+class SPSCFIFOQueue
+{
+  static_assert((CAPACITY & (CAPACITY - 1)) == 0, "SPSC FIFO capacity must be a power of two");
+  static_assert(std::is_trivially_copyable_v<T>, "SPSC FIFO element type must be trivially copyable");
+
+public:
+  SPSCFIFOQueue() = default;
+  SPSCFIFOQueue(const SPSCFIFOQueue&) = delete;
+  SPSCFIFOQueue& operator=(const SPSCFIFOQueue&) = delete;
+
+  constexpr u32 GetCapacity() const { return CAPACITY; }
+
+  /// Safe to call from either thread, though the result can be stale by the time it returns.
+  u32 GetSize() const
+  {
+    return m_write_pos.load(std::memory_order_acquire) - m_read_pos.load(std::memory_order_acquire);
+  }
+  u32 GetSpace() const { return CAPACITY - GetSize(); }
+  bool IsEmpty() const { return GetSize() == 0; }
+  bool IsFull() const { return GetSize() == CAPACITY; }
+
+  /// Only safe when external synchronization guarantees neither thread is inside the queue.
+  void Clear()
+  {
+    m_read_pos.store(0, std::memory_order_release);
+    m_write_pos.store(0, std::memory_order_release);
+  }
+
+  // Producer side.
+
+  bool Push(const T& value)
+  {
+    const u32 wpos = m_write_pos.load(std::memory_order_relaxed);
+    if ((wpos - m_read_pos.load(std::memory_order_acquire)) == CAPACITY)
+      return false;
+
+    m_data[wpos % CAPACITY] = value;
+    m_write_pos.store(wpos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Pushes up to count elements, returning the number actually pushed.
+  u32 PushRange(const T* data, u32 count)
+  {
+    const u32 wpos = m_write_pos.load(std::memory_order_relaxed);
+    const u32 space = CAPACITY - (wpos - m_read_pos.load(std::memory_order_acquire));
+    count = std::min(count, space);
+    if (count == 0)
+      return 0;
+
+    const u32 offset = wpos % CAPACITY;
+    const u32 size_before_end = std::min(count, CAPACITY - offset);
+    std::memcpy(&m_data[offset], data, sizeof(T) * size_before_end);
+    if (count > size_before_end)
+      std::memcpy(&m_data[0], data + size_before_end, sizeof(T) * (count - size_before_end));
+
+    m_write_pos.store(wpos + count, std::memory_order_release);
+    return count;
+  }
+
+  /// Reserves up to max_count contiguous elements for writing in place. Returns the number
+  /// reserved, which can be less than the free space when the span would wrap around the end of
+  /// the ring; reserve again after committing.
+  u32 BeginWrite(T** pointer, u32 max_count)
+  {
+    const u32 wpos = m_write_pos.load(std::memory_order_relaxed);
+    const u32 space = CAPACITY - (wpos - m_read_pos.load(std::memory_order_acquire));
+    const u32 offset = wpos % CAPACITY;
+    *pointer = &m_data[offset];
+    return std::min(max_count, std::min(space, CAPACITY - offset));
+  }
+
+  /// Publishes count elements previously reserved with BeginWrite().
+  void EndWrite(u32 count)
+  {
+    m_write_pos.store(m_write_pos.load(std::memory_order_relaxed) + count, std::memory_order_release);
+  }
+
+  // Consumer side.
+
+  bool Pop(T* value)
+  {
+    const u32 rpos = m_read_pos.load(std::memory_order_relaxed);
+    if (rpos == m_write_pos.load(std::memory_order_acquire))
+      return false;
+
+    *value = m_data[rpos % CAPACITY];
+    m_read_pos.store(rpos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Pops up to count elements, returning the number actually popped.
+  u32 PopRange(T* data, u32 count)
+  {
+    const u32 rpos = m_read_pos.load(std::memory_order_relaxed);
+    const u32 size = m_write_pos.load(std::memory_order_acquire) - rpos;
+    count = std::min(count, size);
+    if (count == 0)
+      return 0;
+
+    const u32 offset = rpos % CAPACITY;
+    const u32 size_before_end = std::min(count, CAPACITY - offset);
+    std::memcpy(data, &m_data[offset], sizeof(T) * size_before_end);
+    if (count > size_before_end)
+      std::memcpy(data + size_before_end, &m_data[0], sizeof(T) * (count - size_before_end));
+
+    m_read_pos.store(rpos + count, std::memory_order_release);
+    return count;
+  }
+
+  /// Reserves up to max_count contiguous elements for reading in place, see BeginWrite().
+  u32 BeginRead(const T** pointer, u32 max_count)
+  {
+    const u32 rpos = m_read_pos.load(std::memory_order_relaxed);
+    const u32 size = m_write_pos.load(std::memory_order_acquire) - rpos;
+    const u32 offset = rpos % CAPACITY;
+    *pointer = &m_data[offset];
+    return std::min(max_count, std::min(size, CAPACITY - offset));
+  }
+
+  /// Releases count elements previously reserved with BeginRead().
+  void EndRead(u32 count)
+  {
+    m_read_pos.store(m_read_pos.load(std::memory_order_relaxed) + count, std::memory_order_release);
+  }
+
+private:
+  static constexpr u32 CACHE_LINE_SIZE = 64;
+
+  alignas(CACHE_LINE_SIZE) std::atomic<u32> m_write_pos{0};
+  alignas(CACHE_LINE_SIZE) std::atomic<u32> m_read_pos{0};
+  alignas(CACHE_LINE_SIZE) T m_data[CAPACITY] = {};
+};
+
 template<typename T, u32 CAPACITY>
 class InlineFIFOQueue : public FIFOQueue<T, CAPACITY>
 {
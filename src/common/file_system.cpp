@@ -7,11 +7,15 @@
 #include "log.h"
 #include "path.h"
 #include "string_util.h"
+#include "threading.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <limits>
+#include <mutex>
 #include <numeric>
 
 #ifdef __APPLE__
@@ -973,6 +977,153 @@ bool FileSystem::WriteStringToFile(const char* filename, const std::string_view&
   return true;
 }
 
+// Async I/O worker. This is the portable path: a single background thread services the
+// submission queue in order, which keeps requests against the same file sequential. If queue
+// depth at the device ever becomes the bottleneck, an io_uring/IOCP backend can be slotted in
+// behind the same submission/completion API.
+namespace {
+
+struct AsyncFileIORequest
+{
+  std::FILE* fp;
+  void* read_buffer;
+  const void* write_buffer;
+  s64 offset;
+  size_t size;
+  FileSystem::AsyncFileIOCallback callback;
+};
+
+} // namespace
+
+static void AsyncFileIOThreadEntryPoint();
+
+static std::mutex s_async_io_mutex;
+static std::condition_variable s_async_io_submitted;
+static std::condition_variable s_async_io_completed;
+static std::deque<AsyncFileIORequest> s_async_io_queue;
+static Threading::Thread s_async_io_thread;
+static std::FILE* s_async_io_current_fp = nullptr;
+static bool s_async_io_thread_started = false;
+static bool s_async_io_thread_shutdown = false;
+
+static void AsyncFileIOThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("Async File I/O");
+
+  std::unique_lock lock(s_async_io_mutex);
+  for (;;)
+  {
+    if (s_async_io_queue.empty())
+    {
+      if (s_async_io_thread_shutdown)
+        break;
+
+      s_async_io_submitted.wait(lock);
+      continue;
+    }
+
+    AsyncFileIORequest req = std::move(s_async_io_queue.front());
+    s_async_io_queue.pop_front();
+    s_async_io_current_fp = req.fp;
+    lock.unlock();
+
+    s64 result = -1;
+    if (FileSystem::FSeek64(req.fp, req.offset, SEEK_SET) == 0)
+    {
+      const size_t transferred = req.read_buffer ? std::fread(req.read_buffer, 1u, req.size, req.fp) :
+                                                   std::fwrite(req.write_buffer, 1u, req.size, req.fp);
+      if (transferred == req.size || (req.read_buffer && std::ferror(req.fp) == 0))
+        result = static_cast<s64>(transferred);
+    }
+
+    if (req.callback)
+      req.callback(result);
+
+    lock.lock();
+    s_async_io_current_fp = nullptr;
+    s_async_io_completed.notify_all();
+  }
+}
+
+static void SubmitAsyncFileIORequest(AsyncFileIORequest req)
+{
+  std::unique_lock lock(s_async_io_mutex);
+  if (!s_async_io_thread_started)
+  {
+    s_async_io_thread_shutdown = false;
+    s_async_io_thread_started = s_async_io_thread.Start(&AsyncFileIOThreadEntryPoint);
+    if (!s_async_io_thread_started)
+    {
+      // Complete synchronously instead of dropping the request on the floor.
+      Log_ErrorPrint("Failed to start async I/O thread, completing synchronously.");
+      lock.unlock();
+
+      s64 result = -1;
+      if (FileSystem::FSeek64(req.fp, req.offset, SEEK_SET) == 0)
+      {
+        const size_t transferred = req.read_buffer ? std::fread(req.read_buffer, 1u, req.size, req.fp) :
+                                                     std::fwrite(req.write_buffer, 1u, req.size, req.fp);
+        if (transferred == req.size || (req.read_buffer && std::ferror(req.fp) == 0))
+          result = static_cast<s64>(transferred);
+      }
+
+      if (req.callback)
+        req.callback(result);
+
+      return;
+    }
+  }
+
+  s_async_io_queue.push_back(std::move(req));
+  s_async_io_submitted.notify_one();
+}
+
+void FileSystem::AsyncReadFile(std::FILE* fp, void* buffer, s64 offset, size_t size, AsyncFileIOCallback callback)
+{
+  SubmitAsyncFileIORequest(AsyncFileIORequest{fp, buffer, nullptr, offset, size, std::move(callback)});
+}
+
+void FileSystem::AsyncWriteFile(std::FILE* fp, const void* buffer, s64 offset, size_t size,
+                                AsyncFileIOCallback callback)
+{
+  SubmitAsyncFileIORequest(AsyncFileIORequest{fp, nullptr, buffer, offset, size, std::move(callback)});
+}
+
+void FileSystem::WaitForAsyncFileOperations(std::FILE* fp)
+{
+  std::unique_lock lock(s_async_io_mutex);
+  const auto has_operations_pending = [fp]() {
+    if (s_async_io_current_fp == fp)
+      return true;
+
+    for (const AsyncFileIORequest& req : s_async_io_queue)
+    {
+      if (req.fp == fp)
+        return true;
+    }
+
+    return false;
+  };
+
+  while (has_operations_pending())
+    s_async_io_completed.wait(lock);
+}
+
+void FileSystem::ShutdownAsyncFileIO()
+{
+  {
+    std::unique_lock lock(s_async_io_mutex);
+    if (!s_async_io_thread_started)
+      return;
+
+    s_async_io_thread_shutdown = true;
+    s_async_io_submitted.notify_one();
+  }
+
+  s_async_io_thread.Join();
+  s_async_io_thread_started = false;
+}
+
 bool FileSystem::EnsureDirectoryExists(const char* path, bool recursive)
 {
   if (FileSystem::DirectoryExists(path))
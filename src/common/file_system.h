@@ -7,6 +7,7 @@
 
 #include <cstdio>
 #include <ctime>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -147,6 +148,25 @@ std::optional<std::string> ReadFileToString(std::FILE* fp);
 bool WriteBinaryFile(const char* filename, const void* data, size_t data_length);
 bool WriteStringToFile(const char* filename, const std::string_view& sv);
 
+/// Asynchronous file I/O. Requests form a submission queue serviced in order by a background
+/// worker thread, which is started on the first submission. The completion callback is invoked on
+/// the worker thread with the number of bytes transferred, or -1 on failure. The file must not be
+/// accessed directly, or closed, while requests against it are in flight; call
+/// WaitForAsyncFileOperations() first.
+using AsyncFileIOCallback = std::function<void(s64 bytes_transferred)>;
+
+/// Queues a read of size bytes at offset from fp into buffer.
+void AsyncReadFile(std::FILE* fp, void* buffer, s64 offset, size_t size, AsyncFileIOCallback callback);
+
+/// Queues a write of size bytes from buffer to offset in fp.
+void AsyncWriteFile(std::FILE* fp, const void* buffer, s64 offset, size_t size, AsyncFileIOCallback callback);
+
+/// Blocks until all queued operations against fp have completed.
+void WaitForAsyncFileOperations(std::FILE* fp);
+
+/// Drains the submission queue and stops the worker thread. Called on process shutdown.
+void ShutdownAsyncFileIO();
+
 /// creates a directory in the local filesystem
 /// if the directory already exists, the return value will be true.
 /// if Recursive is specified, all parent directories will be created
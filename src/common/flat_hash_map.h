@@ -0,0 +1,305 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+/**
+ * Flat open-addressing hash containers for trivially-copyable keys/values. Probing walks a
+ * contiguous slot array, so lookups touch one or two cache lines instead of chasing the list
+ * nodes of the std::unordered_* containers. Erasing leaves tombstones, which are reclaimed on
+ * the next rehash.
+ */
+
+#pragma once
+
+#include "types.h"
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+template<typename KeyType>
+struct FlatHashDefaultHash
+{
+  ALWAYS_INLINE std::size_t operator()(const KeyType& key) const
+  {
+    // std::hash is the identity for integers on common implementations, which clusters badly
+    // with power-of-two table sizes (e.g. word-aligned addresses), so mix integral keys.
+    if constexpr (std::is_integral_v<KeyType>)
+      return static_cast<std::size_t>((static_cast<u64>(key) * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+    else
+      return std::hash<KeyType>{}(key);
+  }
+};
+
+enum class FlatHashSlotState : u8
+{
+  Empty,
+  Occupied,
+  Deleted,
+};
+} // namespace detail
+
+/// Open-addressing hash map permitting duplicate keys. Entries are identified by their
+/// (key, value) pair for removal, rather than by iterator, since slots move on rehash.
+template<typename KeyType, typename ValueType, typename HashFunc = detail::FlatHashDefaultHash<KeyType>>
+class FlatHashMultiMap
+{
+  static_assert(std::is_trivially_copyable_v<KeyType> && std::is_trivially_copyable_v<ValueType>);
+
+  using SlotState = detail::FlatHashSlotState;
+
+  struct Slot
+  {
+    KeyType key;
+    ValueType value;
+    SlotState state;
+  };
+
+public:
+  FlatHashMultiMap() = default;
+  ~FlatHashMultiMap() = default;
+
+  u32 GetSize() const { return m_population; }
+  bool IsEmpty() const { return (m_population == 0); }
+
+  void Clear()
+  {
+    m_slots.reset();
+    m_capacity = 0;
+    m_population = 0;
+    m_used = 0;
+  }
+
+  void Insert(const KeyType& key, const ValueType& value)
+  {
+    if (NeedsGrow())
+      Grow();
+
+    const u32 mask = m_capacity - 1;
+    u32 idx = static_cast<u32>(HashFunc()(key)) & mask;
+    while (m_slots[idx].state == SlotState::Occupied)
+      idx = (idx + 1) & mask;
+
+    if (m_slots[idx].state == SlotState::Empty)
+      m_used++;
+    m_slots[idx] = {key, value, SlotState::Occupied};
+    m_population++;
+  }
+
+  /// Removes one entry matching both key and value, returning false if not present.
+  bool Erase(const KeyType& key, const ValueType& value)
+  {
+    if (m_population == 0)
+      return false;
+
+    const u32 mask = m_capacity - 1;
+    u32 idx = static_cast<u32>(HashFunc()(key)) & mask;
+    while (m_slots[idx].state != SlotState::Empty)
+    {
+      if (m_slots[idx].state == SlotState::Occupied && m_slots[idx].key == key && m_slots[idx].value == value)
+      {
+        m_slots[idx].state = SlotState::Deleted;
+        m_population--;
+        return true;
+      }
+
+      idx = (idx + 1) & mask;
+    }
+
+    return false;
+  }
+
+  /// Calls f(value) for every entry with the given key.
+  template<typename F>
+  void ForEachWithKey(const KeyType& key, const F& f) const
+  {
+    if (m_population == 0)
+      return;
+
+    const u32 mask = m_capacity - 1;
+    u32 idx = static_cast<u32>(HashFunc()(key)) & mask;
+    while (m_slots[idx].state != SlotState::Empty)
+    {
+      if (m_slots[idx].state == SlotState::Occupied && m_slots[idx].key == key)
+        f(m_slots[idx].value);
+
+      idx = (idx + 1) & mask;
+    }
+  }
+
+private:
+  enum : u32
+  {
+    MINIMUM_CAPACITY = 16,
+  };
+
+  // Grow when occupied+tombstone slots pass 3/4, otherwise probe chains degenerate.
+  bool NeedsGrow() const { return ((m_used + 1) * 4) >= (m_capacity * 3); }
+
+  void Grow()
+  {
+    // If most of the load is tombstones, rehashing at the same size is sufficient.
+    const u32 new_capacity =
+      (m_capacity == 0) ? MINIMUM_CAPACITY : ((m_population * 2) >= m_capacity ? (m_capacity * 2) : m_capacity);
+    std::unique_ptr<Slot[]> old_slots = std::move(m_slots);
+    const u32 old_capacity = m_capacity;
+
+    m_slots = std::unique_ptr<Slot[]>(new Slot[new_capacity]());
+    m_capacity = new_capacity;
+    m_used = m_population;
+
+    const u32 mask = new_capacity - 1;
+    for (u32 i = 0; i < old_capacity; i++)
+    {
+      if (old_slots[i].state != SlotState::Occupied)
+        continue;
+
+      u32 idx = static_cast<u32>(HashFunc()(old_slots[i].key)) & mask;
+      while (m_slots[idx].state == SlotState::Occupied)
+        idx = (idx + 1) & mask;
+      m_slots[idx] = old_slots[i];
+    }
+  }
+
+  std::unique_ptr<Slot[]> m_slots;
+  u32 m_capacity = 0;
+  u32 m_population = 0;
+  u32 m_used = 0; // occupied + tombstones
+};
+
+/// Open-addressing hash set of trivially-copyable keys.
+template<typename KeyType, typename HashFunc = detail::FlatHashDefaultHash<KeyType>>
+class FlatHashSet
+{
+  static_assert(std::is_trivially_copyable_v<KeyType>);
+
+  using SlotState = detail::FlatHashSlotState;
+
+  struct Slot
+  {
+    KeyType key;
+    SlotState state;
+  };
+
+public:
+  FlatHashSet() = default;
+  ~FlatHashSet() = default;
+
+  u32 GetSize() const { return m_population; }
+  bool IsEmpty() const { return (m_population == 0); }
+
+  void Clear()
+  {
+    m_slots.reset();
+    m_capacity = 0;
+    m_population = 0;
+    m_used = 0;
+  }
+
+  /// Returns false if the key was already present.
+  bool Insert(const KeyType& key)
+  {
+    if (NeedsGrow())
+      Grow();
+
+    const u32 mask = m_capacity - 1;
+    u32 idx = static_cast<u32>(HashFunc()(key)) & mask;
+    u32 free_idx = m_capacity;
+    while (m_slots[idx].state != SlotState::Empty)
+    {
+      if (m_slots[idx].state == SlotState::Occupied && m_slots[idx].key == key)
+        return false;
+      else if (m_slots[idx].state == SlotState::Deleted && free_idx == m_capacity)
+        free_idx = idx;
+
+      idx = (idx + 1) & mask;
+    }
+
+    if (free_idx == m_capacity)
+    {
+      free_idx = idx;
+      m_used++;
+    }
+    m_slots[free_idx] = {key, SlotState::Occupied};
+    m_population++;
+    return true;
+  }
+
+  bool Contains(const KeyType& key) const
+  {
+    if (m_population == 0)
+      return false;
+
+    const u32 mask = m_capacity - 1;
+    u32 idx = static_cast<u32>(HashFunc()(key)) & mask;
+    while (m_slots[idx].state != SlotState::Empty)
+    {
+      if (m_slots[idx].state == SlotState::Occupied && m_slots[idx].key == key)
+        return true;
+
+      idx = (idx + 1) & mask;
+    }
+
+    return false;
+  }
+
+  bool Erase(const KeyType& key)
+  {
+    if (m_population == 0)
+      return false;
+
+    const u32 mask = m_capacity - 1;
+    u32 idx = static_cast<u32>(HashFunc()(key)) & mask;
+    while (m_slots[idx].state != SlotState::Empty)
+    {
+      if (m_slots[idx].state == SlotState::Occupied && m_slots[idx].key == key)
+      {
+        m_slots[idx].state = SlotState::Deleted;
+        m_population--;
+        return true;
+      }
+
+      idx = (idx + 1) & mask;
+    }
+
+    return false;
+  }
+
+private:
+  enum : u32
+  {
+    MINIMUM_CAPACITY = 16,
+  };
+
+  bool NeedsGrow() const { return ((m_used + 1) * 4) >= (m_capacity * 3); }
+
+  void Grow()
+  {
+    const u32 new_capacity =
+      (m_capacity == 0) ? MINIMUM_CAPACITY : ((m_population * 2) >= m_capacity ? (m_capacity * 2) : m_capacity);
+    std::unique_ptr<Slot[]> old_slots = std::move(m_slots);
+    const u32 old_capacity = m_capacity;
+
+    m_slots = std::unique_ptr<Slot[]>(new Slot[new_capacity]());
+    m_capacity = new_capacity;
+    m_used = m_population;
+
+    const u32 mask = new_capacity - 1;
+    for (u32 i = 0; i < old_capacity; i++)
+    {
+      if (old_slots[i].state != SlotState::Occupied)
+        continue;
+
+      u32 idx = static_cast<u32>(HashFunc()(old_slots[i].key)) & mask;
+      while (m_slots[idx].state == SlotState::Occupied)
+        idx = (idx + 1) & mask;
+      m_slots[idx] = old_slots[i];
+    }
+  }
+
+  std::unique_ptr<Slot[]> m_slots;
+  u32 m_capacity = 0;
+  u32 m_population = 0;
+  u32 m_used = 0; // occupied + tombstones
+};
@@ -31,6 +31,23 @@
 /// Only currently using 128-bit vectors at max.
 static constexpr u32 VECTOR_ALIGNMENT = 16;
 
+/// Hints to the CPU that we're in a spin-wait loop, reducing power draw and yielding pipeline
+/// resources to the other SMT thread. Does not yield to the OS scheduler.
+ALWAYS_INLINE static void ShortPause()
+{
+#if defined(CPU_ARCH_SSE)
+  _mm_pause();
+#elif defined(CPU_ARCH_ARM64)
+#if defined(_MSC_VER) && !defined(__clang__)
+  __yield();
+#else
+  __asm__ __volatile__("yield");
+#endif
+#elif defined(CPU_ARCH_ARM32)
+  __asm__ __volatile__("yield");
+#endif
+}
+
 /// Aligns allocation/pitch size to preferred host size.
 template<typename T>
 ALWAYS_INLINE static T VectorAlign(T value)
@@ -23,7 +23,7 @@ bool LayeredSettingsInterface::GetIntValue(const char* section, const char* key,
 {
   for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
   {
-    if (SettingsInterface* sif = m_layers[layer]; sif != nullptr)
+    if (SettingsInterface* sif = GetUniqueLayer(layer); sif != nullptr)
     {
       if (sif->GetIntValue(section, key, value))
         return true;
@@ -37,7 +37,7 @@ bool LayeredSettingsInterface::GetUIntValue(const char* section, const char* key
 {
   for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
   {
-    if (SettingsInterface* sif = m_layers[layer]; sif != nullptr)
+    if (SettingsInterface* sif = GetUniqueLayer(layer); sif != nullptr)
     {
       if (sif->GetUIntValue(section, key, value))
         return true;
@@ -51,7 +51,7 @@ bool LayeredSettingsInterface::GetFloatValue(const char* section, const char* ke
 {
   for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
   {
-    if (SettingsInterface* sif = m_layers[layer]; sif != nullptr)
+    if (SettingsInterface* sif = GetUniqueLayer(layer); sif != nullptr)
     {
       if (sif->GetFloatValue(section, key, value))
         return true;
@@ -65,7 +65,7 @@ bool LayeredSettingsInterface::GetDoubleValue(const char* section, const char* k
 {
   for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
   {
-    if (SettingsInterface* sif = m_layers[layer]; sif != nullptr)
+    if (SettingsInterface* sif = GetUniqueLayer(layer); sif != nullptr)
     {
       if (sif->GetDoubleValue(section, key, value))
         return true;
@@ -79,7 +79,7 @@ bool LayeredSettingsInterface::GetBoolValue(const char* section, const char* key
 {
   for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
   {
-    if (SettingsInterface* sif = m_layers[layer]; sif != nullptr)
+    if (SettingsInterface* sif = GetUniqueLayer(layer); sif != nullptr)
     {
       if (sif->GetBoolValue(section, key, value))
         return true;
@@ -93,7 +93,7 @@ bool LayeredSettingsInterface::GetStringValue(const char* section, const char* k
 {
   for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
   {
-    if (SettingsInterface* sif = m_layers[layer]; sif != nullptr)
+    if (SettingsInterface* sif = GetUniqueLayer(layer); sif != nullptr)
     {
       if (sif->GetStringValue(section, key, value))
         return true;
@@ -137,7 +137,7 @@ bool LayeredSettingsInterface::ContainsValue(const char* section, const char* ke
 {
   for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
   {
-    if (SettingsInterface* sif = m_layers[layer]; sif != nullptr)
+    if (SettingsInterface* sif = GetUniqueLayer(layer); sif != nullptr)
     {
       if (sif->ContainsValue(section, key))
         return true;
@@ -162,7 +162,7 @@ std::vector<std::string> LayeredSettingsInterface::GetStringList(const char* sec
 
   for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
   {
-    if (SettingsInterface* sif = m_layers[layer]; sif != nullptr)
+    if (SettingsInterface* sif = GetUniqueLayer(layer); sif != nullptr)
     {
       ret = sif->GetStringList(section, key);
       if (!ret.empty())
@@ -195,7 +195,7 @@ std::vector<std::pair<std::string, std::string>> LayeredSettingsInterface::GetKe
   std::vector<std::pair<std::string, std::string>> ret;
   for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
   {
-    if (SettingsInterface* sif = m_layers[layer])
+    if (SettingsInterface* sif = GetUniqueLayer(layer))
     {
       const size_t newly_added_begin = ret.size();
       std::vector<std::pair<std::string, std::string>> entries = sif->GetKeyValueList(section);
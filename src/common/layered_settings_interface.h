@@ -64,5 +64,19 @@ private:
   static constexpr Layer FIRST_LAYER = LAYER_CMDLINE;
   static constexpr Layer LAST_LAYER = LAYER_BASE;
 
+  // Returns the layer's interface, or nullptr when it aliases an earlier layer (the input layer
+  // frequently points at the game or base layer), so lookups don't hit the same INI twice.
+  SettingsInterface* GetUniqueLayer(u32 layer) const
+  {
+    SettingsInterface* const sif = m_layers[layer];
+    for (u32 i = FIRST_LAYER; i < layer; i++)
+    {
+      if (m_layers[i] == sif)
+        return nullptr;
+    }
+
+    return sif;
+  }
+
   std::array<SettingsInterface*, NUM_LAYERS> m_layers{};
 };
\ No newline at end of file
@@ -5,11 +5,17 @@
 #include "assert.h"
 #include "file_system.h"
 #include "small_string.h"
+#include "threading.h"
 #include "timer.h"
 
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <cstring>
 #include <mutex>
 #include <vector>
 
@@ -30,6 +36,20 @@ struct RegisteredCallback
   Log::CallbackFunctionType Function;
   void* Parameter;
 };
+
+// One slot of the async ring. Channel/function names are string literals with static storage, so
+// only the pointers are captured. The sequence field follows the usual bounded-MPMC scheme:
+// equal to the slot position when free, position+1 when the record is ready for the logger
+// thread, and position+ring size once consumed.
+struct AsyncRecord
+{
+  std::atomic<u32> sequence;
+  LOGLEVEL level;
+  const char* channel;
+  const char* function;
+  u16 message_length;
+  char message[486];
+};
 } // namespace
 
 static void RegisterCallback(CallbackFunctionType callbackFunction, void* pUserParam,
@@ -59,8 +79,30 @@ static void FormatLogMessageAndPrintW(const char* channelName, const char* funct
                                       const T& callback);
 #endif
 
+static void QueueAsyncMessage(const char* channelName, const char* functionName, LOGLEVEL level,
+                              std::string_view message);
+static void AsyncLogThread();
+
 static const char s_log_level_characters[LOGLEVEL_COUNT] = {'X', 'E', 'W', 'P', 'I', 'V', 'D', 'R', 'B', 'T'};
 
+enum : u32
+{
+  ASYNC_RING_SIZE = 4096, // must be a power of two
+  ASYNC_RING_MASK = ASYNC_RING_SIZE - 1,
+};
+
+// The ring is allocated on first enable and deliberately kept around after disable, so a racing
+// producer which saw async mode enabled never writes to freed memory.
+static std::unique_ptr<AsyncRecord[]> s_async_ring;
+static std::atomic<u32> s_async_write_pos{0};
+static u32 s_async_read_pos = 0; // only touched by the logger thread
+static std::atomic<u64> s_async_dropped_messages{0};
+static std::atomic_bool s_async_enabled{false};
+static std::atomic_bool s_async_thread_shutdown{false};
+static Threading::Thread s_async_thread;
+static std::mutex s_async_wake_mutex;
+static std::condition_variable s_async_wake_cv;
+
 static std::vector<RegisteredCallback> s_callbacks;
 static std::mutex s_callback_mutex;
 
@@ -445,6 +487,122 @@ void Log::SetFileOutputParams(bool enabled, const char* filename, bool timestamp
   s_file_output_timestamp = timestamps;
 }
 
+void Log::QueueAsyncMessage(const char* channelName, const char* functionName, LOGLEVEL level, std::string_view message)
+{
+  AsyncRecord* const ring = s_async_ring.get();
+  u32 pos = s_async_write_pos.load(std::memory_order_relaxed);
+  AsyncRecord* rec;
+  for (;;)
+  {
+    rec = &ring[pos & ASYNC_RING_MASK];
+    const u32 seq = rec->sequence.load(std::memory_order_acquire);
+    const s32 diff = static_cast<s32>(seq - pos);
+    if (diff == 0)
+    {
+      if (s_async_write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (diff < 0)
+    {
+      // Ring is full. Dropping beats stalling the caller, that's the whole point of async mode.
+      s_async_dropped_messages.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    else
+    {
+      pos = s_async_write_pos.load(std::memory_order_relaxed);
+    }
+  }
+
+  rec->level = level;
+  rec->channel = channelName;
+  rec->function = functionName;
+  rec->message_length = static_cast<u16>(std::min(message.size(), sizeof(rec->message)));
+  std::memcpy(rec->message, message.data(), rec->message_length);
+  rec->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void Log::AsyncLogThread()
+{
+  Threading::SetNameOfCurrentThread("Async Logger");
+
+  for (;;)
+  {
+    bool did_work = false;
+    AsyncRecord* const ring = s_async_ring.get();
+    for (;;)
+    {
+      AsyncRecord& rec = ring[s_async_read_pos & ASYNC_RING_MASK];
+      if (rec.sequence.load(std::memory_order_acquire) != (s_async_read_pos + 1))
+        break;
+
+      {
+        std::unique_lock lock(s_callback_mutex);
+        if (FilterTest(rec.level, rec.channel, lock))
+          ExecuteCallbacks(rec.channel, rec.function, rec.level, std::string_view(rec.message, rec.message_length),
+                           lock);
+      }
+
+      rec.sequence.store(s_async_read_pos + ASYNC_RING_SIZE, std::memory_order_release);
+      s_async_read_pos++;
+      did_work = true;
+    }
+
+    if (const u64 dropped = s_async_dropped_messages.exchange(0, std::memory_order_relaxed); dropped > 0)
+    {
+      const TinyString message = TinyString::from_format("Dropped {} messages due to ring overflow.", dropped);
+      std::unique_lock lock(s_callback_mutex);
+      ExecuteCallbacks("Log", __FUNCTION__, LOGLEVEL_WARNING, message.view(), lock);
+    }
+
+    if (did_work)
+      continue;
+
+    // Producers never signal, to keep the hot path free of syscalls; poll instead. Shutdown is
+    // only acted upon with an empty ring, so everything queued beforehand still goes out.
+    std::unique_lock lock(s_async_wake_mutex);
+    if (s_async_thread_shutdown.load(std::memory_order_relaxed))
+      break;
+    s_async_wake_cv.wait_for(lock, std::chrono::milliseconds(10));
+  }
+}
+
+bool Log::IsAsyncOutputEnabled()
+{
+  return s_async_enabled.load(std::memory_order_relaxed);
+}
+
+void Log::SetAsyncOutputEnabled(bool enabled)
+{
+  if (s_async_enabled.load(std::memory_order_relaxed) == enabled)
+    return;
+
+  if (enabled)
+  {
+    if (!s_async_ring)
+    {
+      s_async_ring = std::make_unique<AsyncRecord[]>(ASYNC_RING_SIZE);
+      for (u32 i = 0; i < ASYNC_RING_SIZE; i++)
+        s_async_ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    s_async_thread_shutdown.store(false, std::memory_order_relaxed);
+    s_async_thread.Start(AsyncLogThread);
+    s_async_enabled.store(true, std::memory_order_release);
+  }
+  else
+  {
+    // Stop producers first, then let the thread drain what's left.
+    s_async_enabled.store(false, std::memory_order_release);
+    {
+      std::unique_lock lock(s_async_wake_mutex);
+      s_async_thread_shutdown.store(true, std::memory_order_relaxed);
+      s_async_wake_cv.notify_one();
+    }
+    s_async_thread.Join();
+  }
+}
+
 LOGLEVEL Log::GetLogLevel()
 {
   return s_log_level;
@@ -481,6 +639,15 @@ ALWAYS_INLINE_RELEASE bool Log::FilterTest(LOGLEVEL level, const char* channelNa
 
 void Log::Write(const char* channelName, const char* functionName, LOGLEVEL level, std::string_view message)
 {
+  // In async mode only the cheap level check happens here; the channel filter and sink fan-out
+  // run on the logger thread.
+  if (s_async_enabled.load(std::memory_order_acquire))
+  {
+    if (level <= s_log_level)
+      QueueAsyncMessage(channelName, functionName, level, message);
+    return;
+  }
+
   std::unique_lock lock(s_callback_mutex);
   if (!FilterTest(level, channelName, lock))
     return;
@@ -498,6 +665,20 @@ void Log::Writef(const char* channelName, const char* functionName, LOGLEVEL lev
 
 void Log::Writev(const char* channelName, const char* functionName, LOGLEVEL level, const char* format, va_list ap)
 {
+  if (s_async_enabled.load(std::memory_order_acquire))
+  {
+    if (level > s_log_level)
+      return;
+
+    // Format without holding any lock; anything past the record size gets truncated anyway.
+    char buffer[512];
+    const int len = std::vsnprintf(buffer, countof(buffer), format, ap);
+    if (len > 0)
+      QueueAsyncMessage(channelName, functionName, level,
+                        std::string_view(buffer, std::min(static_cast<size_t>(len), countof(buffer) - 1)));
+    return;
+  }
+
   std::unique_lock lock(s_callback_mutex);
   if (!FilterTest(level, channelName, lock))
     return;
@@ -532,6 +713,17 @@ void Log::Writev(const char* channelName, const char* functionName, LOGLEVEL lev
 void Log::WriteFmtArgs(const char* channelName, const char* functionName, LOGLEVEL level, fmt::string_view fmt,
                        fmt::format_args args)
 {
+  if (s_async_enabled.load(std::memory_order_acquire))
+  {
+    if (level > s_log_level)
+      return;
+
+    fmt::memory_buffer buffer;
+    fmt::vformat_to(std::back_inserter(buffer), fmt, args);
+    QueueAsyncMessage(channelName, functionName, level, std::string_view(buffer.data(), buffer.size()));
+    return;
+  }
+
   std::unique_lock lock(s_callback_mutex);
   if (!FilterTest(level, channelName, lock))
     return;
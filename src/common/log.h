@@ -52,6 +52,12 @@ void SetDebugOutputParams(bool enabled);
 // adds a file output
 void SetFileOutputParams(bool enabled, const char* filename, bool timestamps = true);
 
+// async mode: producers push preformatted records into a lock-free ring, and a logger thread
+// handles sink fan-out, so hot-path logging doesn't block on console/file I/O. Messages which
+// don't fit in the ring are dropped and reported by the logger thread.
+bool IsAsyncOutputEnabled();
+void SetAsyncOutputEnabled(bool enabled);
+
 // Returns the current global filtering level.
 LOGLEVEL GetLogLevel();
 
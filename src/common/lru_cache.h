@@ -85,6 +85,33 @@ public:
     }
   }
 
+  /// Evicts least-recently-used items for as long as the predicate returns true for the next
+  /// victim's value, e.g. to enforce a caller-tracked memory budget.
+  template<typename Predicate>
+  void EvictWhile(const Predicate& pred)
+  {
+    while (!m_items.empty())
+    {
+      typename MapType::iterator lowest = m_items.end();
+      for (auto iter = m_items.begin(); iter != m_items.end(); ++iter)
+      {
+        if (lowest == m_items.end() || iter->second.last_access < lowest->second.last_access)
+          lowest = iter;
+      }
+      if (!pred(lowest->second.value))
+        break;
+      m_items.erase(lowest);
+    }
+  }
+
+  /// Invokes the callback for each cached value, in no particular order.
+  template<typename Callback>
+  void ForEachItem(const Callback& cb) const
+  {
+    for (const auto& it : m_items)
+      cb(it.second.value);
+  }
+
   template<typename KeyT>
   bool Remove(const KeyT& key)
   {
@@ -13,10 +13,11 @@
 
 #if defined(_WIN32)
 #include "windows_headers.h"
-#elif !defined(__ANDROID__)
+#else
 #include <cerrno>
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #endif
 
@@ -87,6 +88,63 @@ void MemMap::UnmapSharedMemory(void* baseaddr, size_t size)
     Panic("Failed to unmap shared memory");
 }
 
+void MemMap::AdviseHugePages(void* baseaddr, size_t size)
+{
+  // Large pages on Windows require SeLockMemoryPrivilege, and unlike THP can't be split back up
+  // when the code cache changes protection at 4K granularity, so don't bother.
+}
+
+void* MemMap::MapReadOnlyFile(const char* path, size_t* out_size, Error* error)
+{
+  const HANDLE file = CreateFileW(StringUtil::UTF8StringToWideString(path).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                  NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    Error::SetWin32(error, "CreateFileW() failed: ", GetLastError());
+    return nullptr;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+  {
+    Error::SetWin32(error, "GetFileSizeEx() failed: ", GetLastError());
+    CloseHandle(file);
+    return nullptr;
+  }
+
+  const HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (!mapping)
+  {
+    Error::SetWin32(error, "CreateFileMappingW() failed: ", GetLastError());
+    CloseHandle(file);
+    return nullptr;
+  }
+
+  void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!ptr)
+    Error::SetWin32(error, "MapViewOfFile() failed: ", GetLastError());
+
+  // The view holds its own references to the mapping and the file.
+  CloseHandle(mapping);
+  CloseHandle(file);
+
+  if (ptr)
+    *out_size = static_cast<size_t>(size.QuadPart);
+  return ptr;
+}
+
+void MemMap::UnmapReadOnlyFile(void* baseaddr, size_t size)
+{
+  if (!UnmapViewOfFile(baseaddr))
+    Panic("Failed to unmap file view");
+}
+
+void MemMap::AdviseReadAhead(void* baseaddr, size_t size)
+{
+  WIN32_MEMORY_RANGE_ENTRY range = {baseaddr, size};
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
 SharedMemoryMappingArea::SharedMemoryMappingArea() = default;
 
 SharedMemoryMappingArea::~SharedMemoryMappingArea()
@@ -349,6 +407,7 @@ void* MemMap::MapSharedMemory(void* handle, size_t offset, void* baseaddr, size_
   if (ptr == MAP_FAILED)
     return nullptr;
 
+  AdviseHugePages(ptr, size);
   return ptr;
 }
 
@@ -358,6 +417,23 @@ void MemMap::UnmapSharedMemory(void* baseaddr, size_t size)
     Panic("Failed to unmap shared memory");
 }
 
+void MemMap::AdviseHugePages(void* baseaddr, size_t size)
+{
+#ifdef __linux__
+  // Only worth the syscall for mappings spanning at least one huge page. An explicit hugetlb pool
+  // isn't usable here, since the code cache write-protects RAM at 4K granularity and hugetlb
+  // mappings can't be split, so ask for transparent huge pages instead and let the kernel break
+  // them back up when a protection change lands inside one. Needs shmem_enabled=advise (or
+  // better) for the shm-backed arena, hence purely best-effort.
+  static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+  if (size < HUGE_PAGE_SIZE)
+    return;
+
+  if (madvise(baseaddr, size, MADV_HUGEPAGE) != 0)
+    Log_DevPrintf("madvise(MADV_HUGEPAGE) for %zu bytes at %p failed: %d", size, baseaddr, errno);
+#endif
+}
+
 SharedMemoryMappingArea::SharedMemoryMappingArea() = default;
 
 SharedMemoryMappingArea::~SharedMemoryMappingArea()
@@ -402,6 +478,7 @@ u8* SharedMemoryMappingArea::Map(void* file_handle, size_t file_offset, void* ma
   if (ptr == MAP_FAILED)
     return nullptr;
 
+  MemMap::AdviseHugePages(ptr, map_size);
   m_num_mappings++;
   return static_cast<u8*>(ptr);
 }
@@ -419,6 +496,56 @@ bool SharedMemoryMappingArea::Unmap(void* map_base, size_t map_size)
 
 #endif
 
+#ifndef _WIN32
+
+// Unlike the shared memory arena above, read-only file mappings are also available on Android.
+
+void* MemMap::MapReadOnlyFile(const char* path, size_t* out_size, Error* error)
+{
+  const int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    Error::SetErrno(error, "open() failed: ", errno);
+    return nullptr;
+  }
+
+  struct stat sb;
+  if (fstat(fd, &sb) != 0 || sb.st_size <= 0)
+  {
+    Error::SetErrno(error, "fstat() failed: ", errno);
+    close(fd);
+    return nullptr;
+  }
+
+  void* ptr = mmap(nullptr, static_cast<size_t>(sb.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping holds its own reference to the file.
+  close(fd);
+
+  if (ptr == MAP_FAILED)
+  {
+    Error::SetErrno(error, "mmap() failed: ", errno);
+    return nullptr;
+  }
+
+  *out_size = static_cast<size_t>(sb.st_size);
+  return ptr;
+}
+
+void MemMap::UnmapReadOnlyFile(void* baseaddr, size_t size)
+{
+  if (munmap(baseaddr, size) != 0)
+    Panic("Failed to unmap file view");
+}
+
+void MemMap::AdviseReadAhead(void* baseaddr, size_t size)
+{
+  if (madvise(baseaddr, size, MADV_WILLNEED) != 0)
+    Log_DevPrintf("madvise(MADV_WILLNEED) for %zu bytes at %p failed: %d", size, baseaddr, errno);
+}
+
+#endif
+
 #if defined(__APPLE__) && defined(__aarch64__)
 
 static thread_local int s_code_write_depth = 0;
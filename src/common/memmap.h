@@ -44,6 +44,20 @@ void* MapSharedMemory(void* handle, size_t offset, void* baseaddr, size_t size,
 void UnmapSharedMemory(void* baseaddr, size_t size);
 bool MemProtect(void* baseaddr, size_t size, PageProtect mode);
 
+/// Advises the kernel to back a large mapping with huge pages, to cut dTLB misses on the RAM
+/// arena and fastmem views. Purely advisory with graceful fallback; the kernel remains free to
+/// split pages again when 4K protection changes are applied for code invalidation.
+void AdviseHugePages(void* baseaddr, size_t size);
+
+/// Maps an existing file read-only into memory in its entirety, returning its size in out_size.
+/// The mapping keeps the file open; no handles need to be retained by the caller.
+void* MapReadOnlyFile(const char* path, size_t* out_size, Error* error);
+void UnmapReadOnlyFile(void* baseaddr, size_t size);
+
+/// Advises the kernel to start paging in the specified range ahead of demand faults
+/// (madvise(MADV_WILLNEED)/PrefetchVirtualMemory). Best-effort.
+void AdviseReadAhead(void* baseaddr, size_t size);
+
 /// JIT write protect for Apple Silicon. Needs to be called prior to writing to any RWX pages.
 #if !defined(__APPLE__) || !defined(__aarch64__)
 // clang-format off
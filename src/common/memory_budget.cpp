@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "memory_budget.h"
+#include "assert.h"
+#include "log.h"
+
+#include <atomic>
+#include <mutex>
+
+Log_SetChannel(MemoryBudget);
+
+namespace MemoryBudget {
+static constexpr u32 NUM_COMPONENTS = static_cast<u32>(Component::MaxCount);
+
+// Usage counters are atomics so subsystems can report from any thread without taking a lock, and
+// so everything here is constant-initialized regardless of global constructor order.
+static std::atomic<u64> s_total_budget{0};
+static std::atomic<u64> s_usage[NUM_COMPONENTS];
+
+static std::mutex s_handler_mutex;
+static ReclaimHandler s_handlers[NUM_COMPONENTS];
+static void* s_handler_userdata[NUM_COMPONENTS];
+} // namespace MemoryBudget
+
+void MemoryBudget::SetTotalBudget(u64 bytes)
+{
+  s_total_budget.store(bytes, std::memory_order_release);
+}
+
+u64 MemoryBudget::GetTotalBudget()
+{
+  return s_total_budget.load(std::memory_order_acquire);
+}
+
+void MemoryBudget::AddUsage(Component component, s64 delta)
+{
+  DebugAssert(component < Component::MaxCount);
+  s_usage[static_cast<u32>(component)].fetch_add(static_cast<u64>(delta), std::memory_order_acq_rel);
+}
+
+void MemoryBudget::SetUsage(Component component, u64 bytes)
+{
+  DebugAssert(component < Component::MaxCount);
+  s_usage[static_cast<u32>(component)].store(bytes, std::memory_order_release);
+}
+
+u64 MemoryBudget::GetUsage(Component component)
+{
+  DebugAssert(component < Component::MaxCount);
+  return s_usage[static_cast<u32>(component)].load(std::memory_order_acquire);
+}
+
+u64 MemoryBudget::GetTotalUsage()
+{
+  u64 total = 0;
+  for (u32 i = 0; i < NUM_COMPONENTS; i++)
+    total += s_usage[i].load(std::memory_order_acquire);
+  return total;
+}
+
+bool MemoryBudget::IsOverBudget()
+{
+  const u64 budget = GetTotalBudget();
+  return (budget != 0 && GetTotalUsage() > budget);
+}
+
+void MemoryBudget::SetReclaimHandler(Component component, ReclaimHandler handler, void* userdata)
+{
+  DebugAssert(component < Component::MaxCount);
+  std::unique_lock lock(s_handler_mutex);
+  s_handlers[static_cast<u32>(component)] = handler;
+  s_handler_userdata[static_cast<u32>(component)] = userdata;
+}
+
+void MemoryBudget::ClearReclaimHandler(Component component)
+{
+  DebugAssert(component < Component::MaxCount);
+  std::unique_lock lock(s_handler_mutex);
+  s_handlers[static_cast<u32>(component)] = nullptr;
+  s_handler_userdata[static_cast<u32>(component)] = nullptr;
+}
+
+bool MemoryBudget::ReclaimForAllocation(u64 bytes)
+{
+  const u64 budget = GetTotalBudget();
+  if (budget == 0)
+    return true;
+
+  u64 usage = GetTotalUsage();
+  if ((usage + bytes) <= budget)
+    return true;
+
+  // Handlers are invoked under the lock so a subsystem shutting down can clear its handler and
+  // know no further callbacks are in flight. Handlers must not call back into the registry's
+  // registration functions.
+  std::unique_lock lock(s_handler_mutex);
+  for (u32 i = 0; i < NUM_COMPONENTS && (usage + bytes) > budget; i++)
+  {
+    if (!s_handlers[i])
+      continue;
+
+    const u64 needed = (usage + bytes) - budget;
+    const u64 released = s_handlers[i](s_handler_userdata[i], needed);
+    if (released > 0)
+    {
+      Log_DevPrintf("Reclaimed %" PRIu64 " of %" PRIu64 " requested bytes from component %u", released, needed, i);
+      usage = GetTotalUsage();
+    }
+  }
+
+  if ((usage + bytes) > budget)
+  {
+    Log_WarningPrintf("Over memory budget: %" PRIu64 " bytes used + %" PRIu64 " byte allocation exceeds %" PRIu64
+                      " byte budget",
+                      usage, bytes, budget);
+    return false;
+  }
+
+  return true;
+}
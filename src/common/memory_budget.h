@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "types.h"
+
+/// Central accounting for the large optional memory consumers (precached disc images, replacement
+/// texture caches, rewind states, cover art caches). Subsystems report their usage as they
+/// allocate and free, and can register a reclaim handler; before making a large allocation, a
+/// subsystem asks the registry for headroom, which invokes the handlers in fixed priority order
+/// (cheapest to re-create first) until enough has been released or every handler has run. With no
+/// budget configured, accounting still happens but nothing is ever reclaimed.
+namespace MemoryBudget {
+
+/// Accounted subsystems, in reclaim priority order: components declared first are asked to release
+/// memory first.
+enum class Component : u32
+{
+  CoverCache,       // re-created by streaming covers back in, invisible to the game
+  PackTextureCache, // LRU streaming cache, entries are re-read from the pack on demand
+  RewindStates,     // dropping the oldest states only shortens the rewind history
+  DiscPrecache,     // reclaimed last, dropping it reintroduces disc I/O latency
+  MaxCount
+};
+
+/// Sets the process-wide budget in bytes. Zero disables reclaiming entirely.
+void SetTotalBudget(u64 bytes);
+u64 GetTotalBudget();
+
+/// Usage reporting. AddUsage() applies a delta, SetUsage() replaces the component's total; both
+/// are safe to call from any thread.
+void AddUsage(Component component, s64 delta);
+void SetUsage(Component component, u64 bytes);
+u64 GetUsage(Component component);
+u64 GetTotalUsage();
+
+/// Returns true when a budget is set and total usage exceeds it. Subsystems that can only shrink
+/// themselves at specific safe points (e.g. caches owned by a single thread) poll this instead of
+/// registering a handler.
+bool IsOverBudget();
+
+/// Reclaim handler: release up to the given number of bytes and return the number actually
+/// released. Handlers are invoked from whichever thread requested headroom, so they must
+/// synchronize against their owning subsystem.
+using ReclaimHandler = u64 (*)(void* userdata, u64 bytes_requested);
+void SetReclaimHandler(Component component, ReclaimHandler handler, void* userdata);
+void ClearReclaimHandler(Component component);
+
+/// Attempts to make room for an allocation of the given size, invoking reclaim handlers in
+/// priority order while the allocation would exceed the budget. Returns true if the allocation
+/// fits afterwards (always true when no budget is set). The caller is expected to proceed either
+/// way; the return value exists so it can warn.
+bool ReclaimForAllocation(u64 bytes);
+
+} // namespace MemoryBudget
@@ -7,6 +7,7 @@
 #include "string_util.h"
 
 #include <array>
+#include <cstdlib>
 #include <cstring>
 
 #ifdef __linux__
@@ -19,18 +20,40 @@
 #include <unistd.h>
 #endif
 
-// #define ProfileWithPerf
-// #define ProfileWithPerfJitDump
-
 // Perf is only supported on linux
-#if defined(__linux__) && defined(ProfileWithPerf)
+#ifdef __linux__
+
+namespace {
+enum class PerfDumpMode
+{
+  Disabled,
+  PerfMap, // /tmp/perf-<pid>.map, for perf report without perf inject
+  JitDump, // jit-<pid>.dump in the working directory, for perf inject -j
+};
+} // namespace
+
+// Selected once from the environment, so shipped builds can be profiled without a rebuild.
+static PerfDumpMode GetPerfDumpMode()
+{
+  static const PerfDumpMode mode = []() {
+    const char* value = std::getenv("DUCKSTATION_PERF_DUMP");
+    if (!value || *value == '\0')
+      return PerfDumpMode::Disabled;
+    else if (StringUtil::Strcasecmp(value, "map") == 0)
+      return PerfDumpMode::PerfMap;
+    else
+      return PerfDumpMode::JitDump;
+  }();
+  return mode;
+}
 
 static std::FILE* s_map_file = nullptr;
 static bool s_map_file_opened = false;
-static std::mutex s_mutex;
-static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
+static std::mutex s_map_mutex;
+
+static void RegisterMethodPerfMap(const void* ptr, size_t size, const char* symbol)
 {
-  std::unique_lock lock(s_mutex);
+  std::unique_lock lock(s_map_mutex);
 
   if (!s_map_file)
   {
@@ -49,7 +72,6 @@ static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
   std::fflush(s_map_file);
 }
 
-#elif defined(__linux__) && defined(ProfileWithPerfJitDump)
 enum : u32
 {
   JIT_CODE_LOAD = 0,
@@ -90,6 +112,7 @@ struct JITDUMP_CODE_LOAD
 };
 #pragma pack(pop)
 
+// Matches the clock perf record uses with -k mono.
 static u64 JitDumpTimestamp()
 {
   struct timespec ts = {};
@@ -102,35 +125,57 @@ static bool s_jitdump_file_opened = false;
 static std::mutex s_jitdump_mutex;
 static u32 s_jitdump_record_id;
 
-static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
+static void CloseJitDump()
+{
+  std::unique_lock lock(s_jitdump_mutex);
+  if (!s_jitdump_file)
+    return;
+
+  JITDUMP_RECORD_HEADER close_record = {};
+  close_record.id = JIT_CODE_CLOSE;
+  close_record.total_size = sizeof(close_record);
+  close_record.timestamp = JitDumpTimestamp();
+  std::fwrite(&close_record, sizeof(close_record), 1, s_jitdump_file);
+  std::fclose(s_jitdump_file);
+  s_jitdump_file = nullptr;
+}
+
+static void RegisterMethodJitDump(const void* ptr, size_t size, const char* symbol)
 {
   const u32 namelen = std::strlen(symbol) + 1;
 
   std::unique_lock lock(s_jitdump_mutex);
   if (!s_jitdump_file)
   {
-    if (!s_jitdump_file_opened)
-    {
-      char file[256];
-      snprintf(file, std::size(file), "jit-%d.dump", getpid());
-      s_jitdump_file = fopen(file, "w+b");
-      s_jitdump_file_opened = true;
-      if (!s_jitdump_file)
-        return;
-    }
+    if (s_jitdump_file_opened)
+      return;
+
+    char file[256];
+    snprintf(file, std::size(file), "jit-%d.dump", getpid());
+    s_jitdump_file = fopen(file, "w+b");
+    s_jitdump_file_opened = true;
+    if (!s_jitdump_file)
+      return;
 
+    // perf record only keeps the file if it sees an executable mapping of it; never unmapped.
     void* perf_marker = mmap(nullptr, 4096, PROT_READ | PROT_EXEC, MAP_PRIVATE, fileno(s_jitdump_file), 0);
     AssertMsg(perf_marker != MAP_FAILED, "Map perf marker");
 
     JITDUMP_HEADER jh = {};
 #if defined(__aarch64__)
     jh.elf_mach = EM_AARCH64;
+#elif defined(__arm__)
+    jh.elf_mach = EM_ARM;
+#elif defined(__riscv)
+    jh.elf_mach = EM_RISCV;
 #else
     jh.elf_mach = EM_X86_64;
 #endif
     jh.pid = getpid();
     jh.timestamp = JitDumpTimestamp();
     std::fwrite(&jh, sizeof(jh), 1, s_jitdump_file);
+
+    std::atexit(&CloseJitDump);
   }
 
   JITDUMP_CODE_LOAD cl = {};
@@ -139,7 +184,7 @@ static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
   cl.header.timestamp = JitDumpTimestamp();
   cl.pid = getpid();
   cl.tid = syscall(SYS_gettid);
-  cl.vma = 0;
+  cl.vma = static_cast<u64>(reinterpret_cast<uintptr_t>(ptr));
   cl.code_addr = static_cast<u64>(reinterpret_cast<uintptr_t>(ptr));
   cl.code_size = static_cast<u64>(size);
   cl.code_index = s_jitdump_record_id++;
@@ -149,12 +194,27 @@ static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
   std::fflush(s_jitdump_file);
 }
 
-#endif
-
-#if defined(__linux__) && (defined(ProfileWithPerf) || defined(ProfileWithPerfJitDump))
+static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
+{
+  switch (GetPerfDumpMode())
+  {
+    case PerfDumpMode::PerfMap:
+      RegisterMethodPerfMap(ptr, size, symbol);
+      break;
+    case PerfDumpMode::JitDump:
+      RegisterMethodJitDump(ptr, size, symbol);
+      break;
+    case PerfDumpMode::Disabled:
+    default:
+      break;
+  }
+}
 
 void PerfScope::Register(const void* ptr, size_t size, const char* symbol)
 {
+  if (GetPerfDumpMode() == PerfDumpMode::Disabled)
+    return;
+
   char full_symbol[128];
   if (HasPrefix())
     std::snprintf(full_symbol, std::size(full_symbol), "%s_%s", m_prefix, symbol);
@@ -165,6 +225,9 @@ void PerfScope::Register(const void* ptr, size_t size, const char* symbol)
 
 void PerfScope::RegisterPC(const void* ptr, size_t size, u32 pc)
 {
+  if (GetPerfDumpMode() == PerfDumpMode::Disabled)
+    return;
+
   char full_symbol[128];
   if (HasPrefix())
     std::snprintf(full_symbol, std::size(full_symbol), "%s_%08X", m_prefix, pc);
@@ -175,6 +238,9 @@ void PerfScope::RegisterPC(const void* ptr, size_t size, u32 pc)
 
 void PerfScope::RegisterKey(const void* ptr, size_t size, const char* prefix, u64 key)
 {
+  if (GetPerfDumpMode() == PerfDumpMode::Disabled)
+    return;
+
   char full_symbol[128];
   if (HasPrefix())
     std::snprintf(full_symbol, std::size(full_symbol), "%s_%s%016" PRIX64, m_prefix, prefix, key);
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "perf_trace.h"
+#include "file_system.h"
+#include "log.h"
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+Log_SetChannel(PerfTrace);
+
+namespace PerfTrace {
+namespace {
+struct TraceEvent
+{
+  enum class Type : u32
+  {
+    Zone,
+    Counter,
+  };
+
+  const char* name;
+  Common::Timer::Value start;
+  Common::Timer::Value duration;
+  double value;
+  Type type;
+  u32 thread_id;
+};
+} // namespace
+
+// Roughly a minute of frame-loop events; older events are overwritten once the ring wraps.
+static constexpr u32 EVENT_BUFFER_SIZE = 65536;
+
+static u32 GetCurrentThreadTraceId();
+
+std::atomic_bool g_capturing{false};
+
+static std::unique_ptr<TraceEvent[]> s_events;
+static std::atomic<u32> s_event_pos{0};
+static Common::Timer::Value s_capture_start_time;
+
+static std::mutex s_thread_names_mutex;
+static std::vector<std::string> s_thread_names;
+static std::atomic<u32> s_next_thread_id{0};
+
+static u32 GetCurrentThreadTraceId()
+{
+  static thread_local u32 tls_thread_id = 0xFFFFFFFFu;
+  if (tls_thread_id == 0xFFFFFFFFu)
+  {
+    tls_thread_id = s_next_thread_id.fetch_add(1, std::memory_order_relaxed);
+    std::unique_lock lock(s_thread_names_mutex);
+    if (s_thread_names.size() <= tls_thread_id)
+      s_thread_names.resize(tls_thread_id + 1);
+  }
+
+  return tls_thread_id;
+}
+
+void RegisterCurrentThread(const char* name)
+{
+  const u32 thread_id = GetCurrentThreadTraceId();
+  std::unique_lock lock(s_thread_names_mutex);
+  s_thread_names[thread_id] = name;
+}
+
+static TraceEvent* AllocateEvent()
+{
+  const u32 pos = s_event_pos.fetch_add(1, std::memory_order_relaxed);
+  return &s_events[pos % EVENT_BUFFER_SIZE];
+}
+
+void Internal::AddZone(const char* name, Common::Timer::Value start, Common::Timer::Value end)
+{
+  // Capture may have been stopped while the scope was open.
+  if (!IsCapturing())
+    return;
+
+  TraceEvent* ev = AllocateEvent();
+  ev->name = name;
+  ev->start = start;
+  ev->duration = end - start;
+  ev->value = 0.0;
+  ev->type = TraceEvent::Type::Zone;
+  ev->thread_id = GetCurrentThreadTraceId();
+}
+
+void AddCounter(const char* name, double value)
+{
+  if (!IsCapturing())
+    return;
+
+  TraceEvent* ev = AllocateEvent();
+  ev->name = name;
+  ev->start = Common::Timer::GetCurrentValue();
+  ev->duration = 0;
+  ev->value = value;
+  ev->type = TraceEvent::Type::Counter;
+  ev->thread_id = GetCurrentThreadTraceId();
+}
+
+void Start()
+{
+  if (g_capturing.load(std::memory_order_relaxed))
+    return;
+
+  if (!s_events)
+    s_events = std::make_unique<TraceEvent[]>(EVENT_BUFFER_SIZE);
+
+  s_event_pos.store(0, std::memory_order_relaxed);
+  s_capture_start_time = Common::Timer::GetCurrentValue();
+  g_capturing.store(true, std::memory_order_release);
+  Log_InfoPrint("Trace capture started.");
+}
+
+bool StopAndDump(const char* path)
+{
+  if (!g_capturing.exchange(false))
+    return false;
+
+  // Threads racing with the stop may still be finishing a write; their events simply may not make
+  // it into the dump. This is a diagnostic facility, so that's an acceptable trade for keeping the
+  // recording path lock-free.
+  const u32 pos = s_event_pos.load(std::memory_order_acquire);
+  const u32 count = std::min(pos, EVENT_BUFFER_SIZE);
+
+  auto fp = FileSystem::OpenManagedCFile(path, "wb");
+  if (!fp)
+  {
+    Log_ErrorPrintf("Failed to open '%s' for trace dump.", path);
+    return false;
+  }
+
+  std::fputs("{\"traceEvents\":[", fp.get());
+
+  bool first = true;
+  {
+    std::unique_lock lock(s_thread_names_mutex);
+    for (u32 i = 0; i < static_cast<u32>(s_thread_names.size()); i++)
+    {
+      if (s_thread_names[i].empty())
+        continue;
+
+      std::fprintf(fp.get(), "%s{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"%s\"}}",
+                   first ? "" : ",", i, s_thread_names[i].c_str());
+      first = false;
+    }
+  }
+
+  for (u32 i = 0; i < count; i++)
+  {
+    const TraceEvent& ev = s_events[(pos - count + i) % EVENT_BUFFER_SIZE];
+    const double ts = Common::Timer::ConvertValueToNanoseconds(ev.start - s_capture_start_time) / 1000.0;
+    if (ev.type == TraceEvent::Type::Zone)
+    {
+      const double dur = Common::Timer::ConvertValueToNanoseconds(ev.duration) / 1000.0;
+      std::fprintf(fp.get(), "%s{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"name\":\"%s\",\"ts\":%.3f,\"dur\":%.3f}",
+                   first ? "" : ",", ev.thread_id, ev.name, ts, dur);
+    }
+    else
+    {
+      std::fprintf(fp.get(), "%s{\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"name\":\"%s\",\"ts\":%.3f,\"args\":{\"value\":%f}}",
+                   first ? "" : ",", ev.thread_id, ev.name, ts, ev.value);
+    }
+    first = false;
+  }
+
+  std::fputs("]}\n", fp.get());
+  Log_InfoPrintf("Dumped %u trace events to '%s'.", count, path);
+  return true;
+}
+
+} // namespace PerfTrace
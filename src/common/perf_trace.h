@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "timer.h"
+#include "types.h"
+
+#include <atomic>
+
+/// Lightweight in-memory tracing facility. Zones and counters are recorded into a fixed-size ring
+/// buffer while a capture is active, and written out as Chrome trace JSON (loadable in
+/// chrome://tracing or the Perfetto UI) on demand. When no capture is active, the cost of a zone
+/// or counter is a single relaxed load.
+namespace PerfTrace {
+
+extern std::atomic_bool g_capturing;
+
+ALWAYS_INLINE static bool IsCapturing()
+{
+  return g_capturing.load(std::memory_order_relaxed);
+}
+
+/// Starts capturing into the ring buffer, allocating it on first use.
+void Start();
+
+/// Stops capturing and writes the buffered events to the given file as Chrome trace JSON.
+bool StopAndDump(const char* path);
+
+/// Associates a name with the calling thread in the dump.
+void RegisterCurrentThread(const char* name);
+
+/// Records a value on a counter track. The name must be a string literal.
+void AddCounter(const char* name, double value);
+
+namespace Internal {
+void AddZone(const char* name, Common::Timer::Value start, Common::Timer::Value end);
+}
+
+/// Records a complete event covering the lifetime of the object. The name must be a string
+/// literal, since only the pointer is stored until the dump happens.
+class Scope
+{
+public:
+  ALWAYS_INLINE Scope(const char* name) : m_name(name), m_start(IsCapturing() ? Common::Timer::GetCurrentValue() : 0)
+  {
+  }
+  ALWAYS_INLINE ~Scope()
+  {
+    if (m_start != 0)
+      Internal::AddZone(m_name, m_start, Common::Timer::GetCurrentValue());
+  }
+
+private:
+  const char* m_name;
+  Common::Timer::Value m_start;
+};
+
+} // namespace PerfTrace
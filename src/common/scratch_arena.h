@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2019-2023 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "align.h"
+#include "types.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/// Bump allocator for short-lived scratch data. Allocations are pointer bumps and are never freed
+/// individually; Reset() reclaims everything at once. Overflowing the current chunk chains in a
+/// larger one which is kept across resets, so once the arena has grown to its high-water mark,
+/// steady-state use stops touching the heap entirely.
+///
+/// Reset() invalidates every allocation made from the arena - containers backed by a
+/// ScratchAllocator must be destroyed or reconstructed before the next allocation after a reset.
+class ScratchArena
+{
+public:
+  explicit ScratchArena(size_t initial_size)
+  {
+    m_chunks.push_back(Chunk{std::make_unique<u8[]>(initial_size), initial_size});
+  }
+
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  void* Allocate(size_t size, size_t alignment)
+  {
+    const Chunk& chunk = m_chunks[m_current_chunk];
+    const uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data.get());
+    const uintptr_t ptr = Common::AlignUpPow2(base + m_used, static_cast<unsigned int>(alignment));
+    if ((ptr + size - base) <= chunk.size)
+    {
+      m_used = ptr + size - base;
+      return reinterpret_cast<void*>(ptr);
+    }
+
+    return AllocateSlow(size, alignment);
+  }
+
+  void Reset()
+  {
+    m_current_chunk = 0;
+    m_used = 0;
+  }
+
+private:
+  struct Chunk
+  {
+    std::unique_ptr<u8[]> data;
+    size_t size;
+  };
+
+  void* AllocateSlow(size_t size, size_t alignment)
+  {
+    if ((++m_current_chunk) == m_chunks.size())
+    {
+      // Double so repeated overflows converge quickly; the slack covers worst-case alignment.
+      const size_t new_size = std::max<size_t>(m_chunks.back().size * 2, size + alignment);
+      m_chunks.push_back(Chunk{std::make_unique<u8[]>(new_size), new_size});
+    }
+
+    m_used = 0;
+    return Allocate(size, alignment);
+  }
+
+  std::vector<Chunk> m_chunks;
+  size_t m_current_chunk = 0;
+  size_t m_used = 0;
+};
+
+/// Standard-library allocator adapter for ScratchArena. deallocate() is a no-op; memory comes
+/// back when the arena is reset.
+template<typename T>
+class ScratchAllocator
+{
+public:
+  using value_type = T;
+
+  explicit ScratchAllocator(ScratchArena& arena) : m_arena(&arena) {}
+
+  template<typename U>
+  ScratchAllocator(const ScratchAllocator<U>& other) : m_arena(other.GetArena())
+  {
+  }
+
+  T* allocate(size_t n) { return static_cast<T*>(m_arena->Allocate(sizeof(T) * n, alignof(T))); }
+  void deallocate(T* ptr, size_t n) {}
+
+  ScratchArena* GetArena() const { return m_arena; }
+
+  bool operator==(const ScratchAllocator& rhs) const { return (m_arena == rhs.m_arena); }
+  bool operator!=(const ScratchAllocator& rhs) const { return (m_arena != rhs.m_arena); }
+
+private:
+  ScratchArena* m_arena;
+};
@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "sha256_digest.h"
+#include <cstdio>
+#include <cstring>
+
+// straightforward FIPS 180-4 implementation, same shape as sha1_digest.cpp
+
+#define ror(value, bits) (((value) >> (bits)) | ((value) << (32 - (bits))))
+
+#define Ch(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
+#define Maj(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define S0(x) (ror(x, 2) ^ ror(x, 13) ^ ror(x, 22))
+#define S1(x) (ror(x, 6) ^ ror(x, 11) ^ ror(x, 25))
+#define s0(x) (ror(x, 7) ^ ror(x, 18) ^ ((x) >> 3))
+#define s1(x) (ror(x, 17) ^ ror(x, 19) ^ ((x) >> 10))
+
+static const u32 K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+/* Hash a single 512-bit block. This is the core of the algorithm. */
+
+static void SHA256Transform(u32 state[8], const unsigned char buffer[64])
+{
+  u32 w[64];
+  for (u32 i = 0; i < 16; i++)
+  {
+    w[i] = (static_cast<u32>(buffer[i * 4]) << 24) | (static_cast<u32>(buffer[i * 4 + 1]) << 16) |
+           (static_cast<u32>(buffer[i * 4 + 2]) << 8) | static_cast<u32>(buffer[i * 4 + 3]);
+  }
+  for (u32 i = 16; i < 64; i++)
+    w[i] = s1(w[i - 2]) + w[i - 7] + s0(w[i - 15]) + w[i - 16];
+
+  u32 a = state[0];
+  u32 b = state[1];
+  u32 c = state[2];
+  u32 d = state[3];
+  u32 e = state[4];
+  u32 f = state[5];
+  u32 g = state[6];
+  u32 h = state[7];
+
+  for (u32 i = 0; i < 64; i++)
+  {
+    const u32 t1 = h + S1(e) + Ch(e, f, g) + K[i] + w[i];
+    const u32 t2 = S0(a) + Maj(a, b, c);
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+SHA256Digest::SHA256Digest()
+{
+  Reset();
+}
+
+void SHA256Digest::Reset()
+{
+  state[0] = 0x6a09e667;
+  state[1] = 0xbb67ae85;
+  state[2] = 0x3c6ef372;
+  state[3] = 0xa54ff53a;
+  state[4] = 0x510e527f;
+  state[5] = 0x9b05688c;
+  state[6] = 0x1f83d9ab;
+  state[7] = 0x5be0cd19;
+  count = 0;
+}
+
+void SHA256Digest::Update(const void* data, u32 len)
+{
+  const u8* bytes = static_cast<const u8*>(data);
+  u32 buffered = static_cast<u32>(count & 63);
+  count += len;
+
+  if (buffered > 0)
+  {
+    const u32 wanted = 64 - buffered;
+    const u32 copy = (len < wanted) ? len : wanted;
+    std::memcpy(buffer + buffered, bytes, copy);
+    bytes += copy;
+    len -= copy;
+    buffered += copy;
+    if (buffered < 64)
+      return;
+
+    SHA256Transform(state, buffer);
+  }
+
+  while (len >= 64)
+  {
+    SHA256Transform(state, bytes);
+    bytes += 64;
+    len -= 64;
+  }
+
+  if (len > 0)
+    std::memcpy(buffer, bytes, len);
+}
+
+void SHA256Digest::Final(u8 digest[DIGEST_SIZE])
+{
+  const u64 bit_count = count << 3;
+
+  // pad out to 56 mod 64
+  static const u8 padding[64] = {0x80};
+  const u32 buffered = static_cast<u32>(count & 63);
+  Update(padding, (buffered < 56) ? (56 - buffered) : (120 - buffered));
+
+  u8 length[8];
+  for (u32 i = 0; i < 8; i++)
+    length[i] = static_cast<u8>(bit_count >> ((7 - i) * 8));
+  Update(length, sizeof(length));
+
+  for (u32 i = 0; i < 8; i++)
+  {
+    digest[i * 4] = static_cast<u8>(state[i] >> 24);
+    digest[i * 4 + 1] = static_cast<u8>(state[i] >> 16);
+    digest[i * 4 + 2] = static_cast<u8>(state[i] >> 8);
+    digest[i * 4 + 3] = static_cast<u8>(state[i]);
+  }
+
+  Reset();
+}
+
+std::string SHA256Digest::DigestToString(const u8 digest[DIGEST_SIZE])
+{
+  std::string ret;
+  ret.reserve(DIGEST_SIZE * 2);
+  for (u32 i = 0; i < DIGEST_SIZE; i++)
+  {
+    u8 nibble = digest[i] >> 4;
+    if (nibble >= 0xA)
+      ret.push_back('A' + (nibble - 0xA));
+    else
+      ret.push_back('0' + nibble);
+    nibble = digest[i] & 0xF;
+    if (nibble >= 0xA)
+      ret.push_back('A' + (nibble - 0xA));
+    else
+      ret.push_back('0' + nibble);
+  }
+
+  return ret;
+}
@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "string_intern.h"
+#include "heterogeneous_containers.h"
+
+#include <mutex>
+
+// Both set flavours are node-based, so the stored strings never move on rehash, and a view of
+// std::string::data() is null-terminated.
+static std::mutex s_intern_pool_mutex;
+static PreferUnorderedStringSet s_intern_pool;
+
+std::string_view StringIntern::Intern(const std::string_view& str)
+{
+  std::unique_lock lock(s_intern_pool_mutex);
+
+  const auto iter = s_intern_pool.find(str);
+  if (iter != s_intern_pool.end())
+    return *iter;
+
+  return *s_intern_pool.emplace(str).first;
+}
@@ -0,0 +1,16 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include <string_view>
+
+namespace StringIntern {
+
+/// Returns a view of an immutable, shared copy of str. Values which repeat across many holders
+/// (e.g. the same publisher on hundreds of game database entries) are stored once each. Returned
+/// views are null-terminated and remain valid for the lifetime of the process; the pool is
+/// append-only and never shrinks. May be called from any thread.
+std::string_view Intern(const std::string_view& str);
+
+} // namespace StringIntern
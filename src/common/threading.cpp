@@ -3,7 +3,15 @@
 
 #include "threading.h"
 #include "assert.h"
+#include <algorithm>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #if !defined(_WIN32) && !defined(__APPLE__)
 #ifndef _GNU_SOURCE
@@ -20,6 +28,7 @@
 #if defined(__linux__)
 #include <sched.h>
 #include <sys/prctl.h>
+#include <sys/resource.h>
 #include <sys/types.h>
 
 // glibc < v2.30 doesn't define gettid...
@@ -33,6 +42,7 @@
 #include <mach/mach_time.h>
 #include <mach/semaphore.h>
 #include <mach/task.h>
+#include <pthread/qos.h>
 #else
 #include <pthread_np.h>
 #endif
@@ -101,6 +111,123 @@ void Threading::Timeslice()
 #endif
 }
 
+void Threading::SetPerformanceHintForCurrentThread()
+{
+#if defined(_WIN32)
+#ifdef THREAD_POWER_THROTTLING_CURRENT_VERSION
+  // Opting out of power throttling (EcoQoS) also tells the scheduler not to park us on an
+  // efficiency core. Older SDKs don't have the struct, and older kernels fail the call; both
+  // are harmless.
+  THREAD_POWER_THROTTLING_STATE state = {};
+  state.Version = THREAD_POWER_THROTTLING_CURRENT_VERSION;
+  state.ControlMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+  state.StateMask = 0;
+  SetThreadInformation(GetCurrentThread(), ThreadPowerThrottling, &state, sizeof(state));
+#endif
+#elif defined(__APPLE__)
+  // Affinity isn't a thing on Darwin; QoS classes are how you stay on the P-cores.
+  pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+#endif
+}
+
+void Threading::SetBackgroundHintForCurrentThread()
+{
+#if defined(_WIN32)
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#ifdef THREAD_POWER_THROTTLING_CURRENT_VERSION
+  // Opting in to power throttling also nudges the scheduler towards efficiency cores.
+  THREAD_POWER_THROTTLING_STATE state = {};
+  state.Version = THREAD_POWER_THROTTLING_CURRENT_VERSION;
+  state.ControlMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+  state.StateMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+  SetThreadInformation(GetCurrentThread(), ThreadPowerThrottling, &state, sizeof(state));
+#endif
+#elif defined(__APPLE__)
+  pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+#elif defined(__linux__)
+  // On Linux, PRIO_PROCESS with pid 0 adjusts the nice value of the calling thread only.
+  setpriority(PRIO_PROCESS, 0, 10);
+#endif
+}
+
+u64 Threading::GetPerformanceCoreMask()
+{
+#if defined(_WIN32)
+  u64 mask = 0;
+  ULONG length = 0;
+  GetSystemCpuSetInformation(nullptr, 0, &length, GetCurrentProcess(), 0);
+  if (length > 0)
+  {
+    std::unique_ptr<u8[]> buffer = std::make_unique<u8[]>(length);
+    if (GetSystemCpuSetInformation(reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(buffer.get()), length, &length,
+                                   GetCurrentProcess(), 0))
+    {
+      // Performance cores report the highest efficiency class. On homogeneous parts everything
+      // is class 0, and we return 0 rather than a full mask so callers can tell the difference.
+      BYTE max_class = 0;
+      for (ULONG offset = 0; offset < length;)
+      {
+        const SYSTEM_CPU_SET_INFORMATION* info =
+          reinterpret_cast<const SYSTEM_CPU_SET_INFORMATION*>(buffer.get() + offset);
+        if (info->Type == CpuSetInformation)
+          max_class = std::max(max_class, info->CpuSet.EfficiencyClass);
+        offset += info->Size;
+      }
+      if (max_class > 0)
+      {
+        for (ULONG offset = 0; offset < length;)
+        {
+          const SYSTEM_CPU_SET_INFORMATION* info =
+            reinterpret_cast<const SYSTEM_CPU_SET_INFORMATION*>(buffer.get() + offset);
+          if (info->Type == CpuSetInformation && info->CpuSet.EfficiencyClass == max_class &&
+              info->CpuSet.LogicalProcessorIndex < 64)
+          {
+            mask |= (static_cast<u64>(1) << info->CpuSet.LogicalProcessorIndex);
+          }
+          offset += info->Size;
+        }
+      }
+    }
+  }
+
+  return mask;
+#elif defined(__linux__)
+  // cpufreq exposes the maximum frequency per core; on hybrid parts the P-cores clock higher.
+  // Missing cpufreq nodes (e.g. some VMs) leave the frequency at zero, making the mask empty.
+  u64 freqs[64] = {};
+  u64 max_freq = 0;
+  const long num_processors = std::min<long>(sysconf(_SC_NPROCESSORS_CONF), 64);
+  for (long i = 0; i < num_processors; i++)
+  {
+    char path[128];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%ld/cpufreq/cpuinfo_max_freq", i);
+    std::FILE* fp = std::fopen(path, "rb");
+    if (!fp)
+      continue;
+
+    if (std::fscanf(fp, "%" SCNu64, &freqs[i]) != 1)
+      freqs[i] = 0;
+    std::fclose(fp);
+
+    max_freq = std::max(max_freq, freqs[i]);
+  }
+
+  // All cores clocking the same means a homogeneous part, and no point restricting affinity.
+  u64 mask = 0;
+  for (long i = 0; i < num_processors; i++)
+  {
+    if (freqs[i] == max_freq && max_freq != 0)
+      mask |= (static_cast<u64>(1) << i);
+  }
+
+  return (mask == ((num_processors >= 64) ? ~static_cast<u64>(0) : ((static_cast<u64>(1) << num_processors) - 1))) ?
+           0 :
+           mask;
+#else
+  return 0;
+#endif
+}
+
 Threading::ThreadHandle::ThreadHandle() = default;
 
 #ifdef _WIN32
@@ -617,3 +744,154 @@ bool Threading::KernelSemaphore::TryWait()
   return sem_trywait(&m_sema) == 0;
 #endif
 }
+
+// Thread pool. A single shared queue keeps the implementation simple; the pool is intended for
+// coarse batch-parallel work (whole hunks, shaders, files), where per-task queue overhead is
+// noise and a work-stealing scheduler would buy nothing.
+
+static std::mutex s_thread_pool_mutex;
+static std::condition_variable s_thread_pool_work_available;
+static std::deque<std::function<void()>> s_thread_pool_queue;
+static std::vector<Threading::Thread> s_thread_pool_workers;
+static bool s_thread_pool_started = false;
+static bool s_thread_pool_shutdown = false;
+
+static void ThreadPoolWorkerEntryPoint(u32 index)
+{
+  char name[32];
+  std::snprintf(name, sizeof(name), "Worker Thread %u", index);
+  Threading::SetNameOfCurrentThread(name);
+
+  std::unique_lock lock(s_thread_pool_mutex);
+  for (;;)
+  {
+    if (s_thread_pool_queue.empty())
+    {
+      if (s_thread_pool_shutdown)
+        break;
+
+      s_thread_pool_work_available.wait(lock);
+      continue;
+    }
+
+    std::function<void()> work = std::move(s_thread_pool_queue.front());
+    s_thread_pool_queue.pop_front();
+    lock.unlock();
+    work();
+    lock.lock();
+  }
+}
+
+u32 Threading::ThreadPool::GetWorkerCount()
+{
+  // One less than the processor count, since the submitting thread participates in ParallelFor().
+  const u32 processor_count = std::thread::hardware_concurrency();
+  return std::min<u32>((processor_count > 1) ? (processor_count - 1) : 1, 16);
+}
+
+static void StartThreadPoolWorkers(std::unique_lock<std::mutex>& lock)
+{
+  s_thread_pool_started = true;
+  s_thread_pool_shutdown = false;
+
+  const u32 worker_count = Threading::ThreadPool::GetWorkerCount();
+  s_thread_pool_workers.reserve(worker_count);
+  for (u32 i = 0; i < worker_count; i++)
+  {
+    Threading::Thread worker;
+    if (!worker.Start([i]() { ThreadPoolWorkerEntryPoint(i); }))
+      break;
+
+    s_thread_pool_workers.push_back(std::move(worker));
+  }
+}
+
+void Threading::ThreadPool::QueueWork(std::function<void()> work)
+{
+  std::unique_lock lock(s_thread_pool_mutex);
+  if (!s_thread_pool_started)
+    StartThreadPoolWorkers(lock);
+
+  if (s_thread_pool_workers.empty())
+  {
+    // Nothing to service the queue, run it here instead of dropping it.
+    lock.unlock();
+    work();
+    return;
+  }
+
+  s_thread_pool_queue.push_back(std::move(work));
+  s_thread_pool_work_available.notify_one();
+}
+
+void Threading::ThreadPool::ParallelFor(u32 count, const std::function<void(u32 index)>& fn)
+{
+  if (count == 0)
+    return;
+
+  const u32 num_helpers = std::min(GetWorkerCount(), count - 1);
+  if (num_helpers == 0)
+  {
+    for (u32 i = 0; i < count; i++)
+      fn(i);
+
+    return;
+  }
+
+  struct ParallelForState
+  {
+    std::atomic<u32> next_index{0};
+    std::atomic<u32> completed{0};
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+
+  // Shared, because a queued helper can be dequeued after every index has already been claimed
+  // and ParallelFor() has returned; it then only touches the state to find there's nothing to do.
+  std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+  const std::function<void(u32 index)>* pfn = &fn;
+
+  const auto run_iterations = [state, pfn, count]() {
+    for (;;)
+    {
+      const u32 index = state->next_index.fetch_add(1, std::memory_order_relaxed);
+      if (index >= count)
+        break;
+
+      (*pfn)(index);
+
+      if (state->completed.fetch_add(1, std::memory_order_acq_rel) == (count - 1))
+      {
+        std::unique_lock lock(state->mutex);
+        state->done.notify_one();
+      }
+    }
+  };
+
+  for (u32 i = 0; i < num_helpers; i++)
+    QueueWork(run_iterations);
+
+  run_iterations();
+
+  std::unique_lock lock(state->mutex);
+  state->done.wait(lock,
+                   [&state, count]() { return (state->completed.load(std::memory_order_acquire) == count); });
+}
+
+void Threading::ThreadPool::Shutdown()
+{
+  {
+    std::unique_lock lock(s_thread_pool_mutex);
+    if (!s_thread_pool_started)
+      return;
+
+    s_thread_pool_shutdown = true;
+    s_thread_pool_work_available.notify_all();
+  }
+
+  for (Threading::Thread& worker : s_thread_pool_workers)
+    worker.Join();
+
+  s_thread_pool_workers.clear();
+  s_thread_pool_started = false;
+}
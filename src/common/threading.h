@@ -23,6 +23,19 @@ extern void SetNameOfCurrentThread(const char* name);
 // Releases a timeslice to other threads.
 extern void Timeslice();
 
+/// Marks the calling thread as performance-critical, opting it out of OS power throttling and
+/// discouraging placement on efficiency cores. Best-effort; no-op on hosts without such a
+/// mechanism. For hard pinning, use ThreadHandle::SetAffinity() with GetPerformanceCoreMask().
+extern void SetPerformanceHintForCurrentThread();
+
+/// The opposite hint: marks the calling thread as background work that should not compete with
+/// latency-critical threads for cycles. Best-effort; no-op on hosts without such a mechanism.
+extern void SetBackgroundHintForCurrentThread();
+
+/// Returns a mask of the processors the OS reports as performance cores, suitable for passing
+/// to ThreadHandle::SetAffinity(). Returns 0 when the topology is homogeneous or unknown.
+extern u64 GetPerformanceCoreMask();
+
 // --------------------------------------------------------------------------------------
 //  ThreadHandle
 // --------------------------------------------------------------------------------------
@@ -121,4 +134,27 @@ public:
   bool TryWait();
 };
 
+// Process-wide thread pool for batch-parallel work. Workers are started lazily on the first
+// submission and shared between subsystems, so short bursts of parallelism (precaching, shader
+// compiles, game list scans) don't each spawn a private set of threads and oversubscribe
+// low-core-count machines.
+namespace ThreadPool {
+
+/// Returns the number of worker threads the pool uses.
+u32 GetWorkerCount();
+
+/// Queues a unit of work for execution on a worker thread. If the workers failed to start, the
+/// work is executed on the calling thread instead. Work must not block on other queued work,
+/// otherwise the pool can deadlock.
+void QueueWork(std::function<void()> work);
+
+/// Runs fn(index) for each index in [0, count), spread across the pool with the calling thread
+/// participating. Blocks until every iteration has completed.
+void ParallelFor(u32 count, const std::function<void(u32 index)>& fn);
+
+/// Drains queued work and stops the workers. Called on process shutdown.
+void Shutdown();
+
+} // namespace ThreadPool
+
 } // namespace Threading
\ No newline at end of file
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
 
 #include "timer.h"
+#include "intrin.h"
 #include "types.h"
 #include <cstdio>
 #include <cstdlib>
@@ -15,6 +16,10 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
 namespace Common {
 
 #ifdef _WIN32
@@ -108,6 +113,7 @@ void Timer::SleepUntil(Value value, bool exact)
     // And spin off whatever time is left.
     do
     {
+      ShortPause();
       current = GetCurrentValue();
     } while (current < value);
   }
@@ -183,10 +189,30 @@ Timer::Value Timer::ConvertNanosecondsToValue(double ns)
   return static_cast<Value>(ns);
 }
 
+#ifdef __linux__
+
+// The kernel's default timer slack of 50us lets absolute sleeps overshoot; drop it to 1us for
+// this thread so the spin window before the deadline can stay short.
+static void SetMinimalTimerSlack()
+{
+  static thread_local bool slack_set = false;
+  if (slack_set)
+    return;
+
+  slack_set = true;
+  prctl(PR_SET_TIMERSLACK, 1000, 0, 0, 0);
+}
+
+#endif
+
 void Timer::SleepUntil(Value value, bool exact)
 {
   if (exact)
   {
+#ifdef __linux__
+    SetMinimalTimerSlack();
+#endif
+
     static constexpr Value min_sleep_time = static_cast<Value>(0.5 * 1000000);
     const Value wake_at = value - min_sleep_time;
     Value current = GetCurrentValue();
@@ -196,6 +222,7 @@ void Timer::SleepUntil(Value value, bool exact)
     // And spin off whatever time is left.
     do
     {
+      ShortPause();
       current = GetCurrentValue();
     } while (current < value);
   }
@@ -329,11 +356,11 @@ void Timer::BusyWait(std::uint64_t ns)
   {
     // overflow, unlikely
     while (GetCurrentValue() > end)
-      ;
+      ShortPause();
   }
 
   while (GetCurrentValue() < end)
-    ;
+    ShortPause();
 }
 
 void Timer::HybridSleep(std::uint64_t ns, std::uint64_t min_sleep_time)
@@ -344,7 +371,7 @@ void Timer::HybridSleep(std::uint64_t ns, std::uint64_t min_sleep_time)
   {
     // overflow, unlikely
     while (GetCurrentValue() > end)
-      ;
+      ShortPause();
   }
 
   std::uint64_t current = GetCurrentValue();
@@ -353,6 +380,8 @@ void Timer::HybridSleep(std::uint64_t ns, std::uint64_t min_sleep_time)
     const std::uint64_t remaining = end - current;
     if (remaining >= min_sleep_time)
       NanoSleep(min_sleep_time);
+    else
+      ShortPause();
 
     current = GetCurrentValue();
   }
@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "micro_benchmark.h"
+
+#include "core/gpu.h"
+#include "core/gpu_sw_backend.h"
+#include "core/gpu_types.h"
+#include "core/gte.h"
+#include "core/mdec.h"
+#include "core/settings.h"
+#include "core/timing_event.h"
+
+#include <array>
+
+namespace {
+
+// GTE instruction words as games issue them (sf=1, lm as appropriate).
+constexpr u32 GTE_RTPT = 0x00280030;
+constexpr u32 GTE_NCDS = 0x00080413;
+constexpr u32 GTE_INSTRUCTIONS_PER_ITERATION = 64;
+
+void SetupGTE()
+{
+  static bool initialized = false;
+  if (initialized)
+    return;
+  initialized = true;
+
+  GTE::Initialize();
+
+  // V0 and a rotation/translation setup close to what a typical scene uses; the exact values
+  // don't matter, only that the full arithmetic path runs on non-trivial data.
+  GTE::WriteRegister(0, 0x00640032); // VXY0
+  GTE::WriteRegister(1, 0x00000096); // VZ0
+  GTE::WriteRegister(6, 0x00808080); // RGBC
+
+  GTE::WriteRegister(32 + 0, 0x00001000); // RT11/RT12
+  GTE::WriteRegister(32 + 2, 0x00001000); // RT22/RT23
+  GTE::WriteRegister(32 + 4, 0x00001000); // RT33
+  GTE::WriteRegister(32 + 7, 0x00000200); // TRZ
+
+  GTE::WriteRegister(32 + 8, 0x00001000);  // L11/L12
+  GTE::WriteRegister(32 + 10, 0x00001000); // L22/L23
+  GTE::WriteRegister(32 + 12, 0x00001000); // L33
+  GTE::WriteRegister(32 + 16, 0x00001000); // LR11/LR12
+  GTE::WriteRegister(32 + 18, 0x00001000); // LR22/LR23
+  GTE::WriteRegister(32 + 20, 0x00001000); // LR33
+
+  GTE::WriteRegister(32 + 26, 0x000003E8); // H
+  GTE::WriteRegister(32 + 27, 0x00000100); // DQA
+  GTE::WriteRegister(32 + 28, 0x01000000); // DQB
+}
+
+// One colored macroblock of RLE data: per block, a DC coefficient, a handful of AC coefficients
+// to keep the IDCT off any DC-only fast path, and an end-of-block pad.
+constexpr u32 MDEC_BLOCKS_PER_MACROBLOCK = 6;
+constexpr u32 MDEC_HALFWORDS_PER_BLOCK = 8;
+constexpr u32 MDEC_WORDS_PER_MACROBLOCK = (MDEC_BLOCKS_PER_MACROBLOCK * MDEC_HALFWORDS_PER_BLOCK) / 2;
+
+std::array<u32, MDEC_WORDS_PER_MACROBLOCK> MakeMacroblockData()
+{
+  std::array<u16, MDEC_BLOCKS_PER_MACROBLOCK * MDEC_HALFWORDS_PER_BLOCK> halfwords;
+  u32 pos = 0;
+  for (u32 block = 0; block < MDEC_BLOCKS_PER_MACROBLOCK; block++)
+  {
+    halfwords[pos++] = (8u << 10) | 0x040u; // quant scale 8, DC 64
+    for (u32 coeff = 0; coeff < MDEC_HALFWORDS_PER_BLOCK - 2; coeff++)
+      halfwords[pos++] = (3u << 10) | 0x014u; // skip 3, AC 20
+    halfwords[pos++] = 0xFE00;                // end of block
+  }
+
+  std::array<u32, MDEC_WORDS_PER_MACROBLOCK> words;
+  for (u32 i = 0; i < MDEC_WORDS_PER_MACROBLOCK; i++)
+    words[i] = ZeroExtend32(halfwords[i * 2]) | (ZeroExtend32(halfwords[i * 2 + 1]) << 16);
+  return words;
+}
+
+void SetupMDEC()
+{
+  static bool initialized = false;
+  if (initialized)
+    return;
+  initialized = true;
+
+  TimingEvents::Initialize();
+  MDEC::Initialize();
+
+  // Set quantization (luma + chroma) and IDCT scale tables, which survive resets.
+  MDEC::WriteRegister(0, (2u << 29) | 1u);
+  for (u32 i = 0; i < 32; i++)
+  {
+    const u32 base = i * 4;
+    MDEC::WriteRegister(0, (2u + (base & 15)) | ((2u + ((base + 1) & 15)) << 8) | ((2u + ((base + 2) & 15)) << 16) |
+                             ((2u + ((base + 3) & 15)) << 24));
+  }
+
+  static constexpr std::array<u16, 8> scale_factors = {{23170, 32138, 30274, 27246, 23170, 18205, 12540, 6393}};
+  MDEC::WriteRegister(0, 3u << 29);
+  for (u32 i = 0; i < 32; i++)
+  {
+    MDEC::WriteRegister(0, ZeroExtend32(scale_factors[(i * 2) / 8]) |
+                             (ZeroExtend32(scale_factors[(i * 2 + 1) / 8]) << 16));
+  }
+}
+
+GPU_SW_Backend* SetupSoftwareBackend()
+{
+  static GPU_SW_Backend* backend = nullptr;
+  if (backend)
+    return backend;
+
+  // Draw synchronously on this thread, so the inner loops are what's measured, not the queue.
+  g_settings.gpu_use_thread = false;
+  backend = new GPU_SW_Backend();
+  backend->Initialize(false);
+
+  GPUBackendSetDrawingAreaCommand* cmd = backend->NewSetDrawingAreaCommand();
+  cmd->new_area = Common::Rectangle<u32>::FromExtents(0, 0, 640, 480);
+  backend->PushCommand(cmd);
+
+  return backend;
+}
+
+GPUBackendDrawPolygonCommand* NewTriangleCommand(GPU_SW_Backend* backend)
+{
+  GPUBackendDrawPolygonCommand* cmd = backend->NewDrawPolygonCommand(3);
+  cmd->params.bits = 0;
+  cmd->draw_mode.bits = 0;
+  cmd->palette.bits = 0;
+  cmd->window = {};
+  cmd->rc.bits = 0;
+  cmd->rc.primitive = GPUPrimitive::Polygon;
+  cmd->vertices[0].Set(50, 20, 0x000000FF, 0x0000);
+  cmd->vertices[1].Set(600, 60, 0x0000FF00, 0x00FF);
+  cmd->vertices[2].Set(200, 460, 0x00FF0000, 0xFF00);
+  return cmd;
+}
+
+} // namespace
+
+DEFINE_BENCHMARK(GTE_RTPT)
+{
+  SetupGTE();
+
+  while (state.KeepRunning())
+  {
+    for (u32 i = 0; i < GTE_INSTRUCTIONS_PER_ITERATION; i++)
+      GTE::ExecuteInstruction(GTE_RTPT);
+    MicroBenchmark::DoNotOptimize(GTE::ReadRegister(14)); // SXY2
+  }
+
+  state.SetItemsProcessed(GTE_INSTRUCTIONS_PER_ITERATION);
+}
+
+DEFINE_BENCHMARK(GTE_NCDS)
+{
+  SetupGTE();
+
+  while (state.KeepRunning())
+  {
+    for (u32 i = 0; i < GTE_INSTRUCTIONS_PER_ITERATION; i++)
+      GTE::ExecuteInstruction(GTE_NCDS);
+    MicroBenchmark::DoNotOptimize(GTE::ReadRegister(22)); // RGB2
+  }
+
+  state.SetItemsProcessed(GTE_INSTRUCTIONS_PER_ITERATION);
+}
+
+DEFINE_BENCHMARK(MDEC_DecodeColoredMacroblock)
+{
+  SetupMDEC();
+  static const std::array<u32, MDEC_WORDS_PER_MACROBLOCK> data = MakeMacroblockData();
+
+  while (state.KeepRunning())
+  {
+    // Reset clears the FIFOs and any pending block copy-out, but keeps the tables, so each
+    // iteration decodes exactly one 15bpp macroblock (RL decode + 6 IDCTs + colorspace).
+    MDEC::Reset();
+    MDEC::WriteRegister(0, (1u << 29) | (3u << 27) | MDEC_WORDS_PER_MACROBLOCK);
+    for (const u32 word : data)
+      MDEC::WriteRegister(0, word);
+    MicroBenchmark::DoNotOptimize(MDEC::ReadRegister(4));
+  }
+
+  state.SetItemsProcessed(MDEC_BLOCKS_PER_MACROBLOCK);
+}
+
+DEFINE_BENCHMARK(GPUSW_ShadedTriangle)
+{
+  GPU_SW_Backend* backend = SetupSoftwareBackend();
+
+  while (state.KeepRunning())
+  {
+    GPUBackendDrawPolygonCommand* cmd = NewTriangleCommand(backend);
+    cmd->rc.shading_enable = true;
+    backend->PushCommand(cmd);
+  }
+
+  state.SetItemsProcessed(1);
+}
+
+DEFINE_BENCHMARK(GPUSW_TexturedTriangle)
+{
+  GPU_SW_Backend* backend = SetupSoftwareBackend();
+
+  while (state.KeepRunning())
+  {
+    GPUBackendDrawPolygonCommand* cmd = NewTriangleCommand(backend);
+    cmd->rc.texture_enable = true;
+    cmd->draw_mode.texture_mode = GPUTextureMode::Direct16Bit;
+    backend->PushCommand(cmd);
+  }
+
+  state.SetItemsProcessed(1);
+}
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "micro_benchmark.h"
+
+#include "common/log.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace MicroBenchmark {
+
+// Run each benchmark for at least this long and this many iterations; the timer read between
+// iterations is noise at these scales.
+static constexpr double MIN_RUNTIME_SECONDS = 0.5;
+static constexpr u64 MIN_ITERATIONS = 10;
+static constexpr u64 MAX_ITERATIONS = 100000000;
+
+struct RegisteredBenchmark
+{
+  const char* name;
+  Function function;
+};
+
+static std::vector<RegisteredBenchmark>& GetBenchmarks()
+{
+  // Function-local so registration from static constructors in other translation units is safe.
+  static std::vector<RegisteredBenchmark> benchmarks;
+  return benchmarks;
+}
+
+} // namespace MicroBenchmark
+
+void MicroBenchmark::Internal::RegisterBenchmark(const char* name, Function function)
+{
+  GetBenchmarks().push_back({name, function});
+}
+
+bool MicroBenchmark::State::KeepRunning()
+{
+  if (m_iterations == 0)
+  {
+    m_start_time = Common::Timer::GetCurrentValue();
+    m_iterations++;
+    return true;
+  }
+
+  const Common::Timer::Value now = Common::Timer::GetCurrentValue();
+  if (m_iterations >= MAX_ITERATIONS ||
+      (m_iterations >= MIN_ITERATIONS &&
+       Common::Timer::ConvertValueToSeconds(now - m_start_time) >= MIN_RUNTIME_SECONDS))
+  {
+    m_end_time = now;
+    return false;
+  }
+
+  m_iterations++;
+  return true;
+}
+
+int MicroBenchmark::RunAll(const char* filter)
+{
+  u32 num_run = 0;
+  std::printf("%-40s %12s %14s %12s %12s\n", "benchmark", "iterations", "ns/op", "MB/s", "Mitems/s");
+
+  for (const RegisteredBenchmark& benchmark : GetBenchmarks())
+  {
+    if (filter && !std::strstr(benchmark.name, filter))
+      continue;
+
+    State state;
+    benchmark.function(state);
+    if (state.m_iterations == 0 || state.m_end_time <= state.m_start_time)
+    {
+      std::printf("%-40s did not run\n", benchmark.name);
+      continue;
+    }
+
+    const double elapsed_ns =
+      Common::Timer::ConvertValueToNanoseconds(state.m_end_time - state.m_start_time);
+    const double ns_per_op = elapsed_ns / static_cast<double>(state.m_iterations);
+
+    std::printf("%-40s %12llu %14.1f", benchmark.name, static_cast<unsigned long long>(state.m_iterations), ns_per_op);
+    if (state.m_bytes_per_iteration > 0)
+      std::printf(" %12.1f", static_cast<double>(state.m_bytes_per_iteration) * 1000.0 / ns_per_op);
+    else
+      std::printf(" %12s", "-");
+    if (state.m_items_per_iteration > 0)
+      std::printf(" %12.3f", static_cast<double>(state.m_items_per_iteration) * 1000.0 / ns_per_op);
+    else
+      std::printf(" %12s", "-");
+    std::printf("\n");
+
+    num_run++;
+  }
+
+  if (num_run == 0)
+  {
+    std::fprintf(stderr, "No benchmarks matched '%s'.\n", filter ? filter : "");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  // Keep warnings visible, but don't let per-iteration logging skew the numbers.
+  Log::SetConsoleOutputParams(true, false);
+  Log::SetLogLevel(LOGLEVEL_WARNING);
+
+  return MicroBenchmark::RunAll((argc > 1) ? argv[1] : nullptr);
+}
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "common/timer.h"
+#include "common/types.h"
+
+//////////////////////////////////////////////////////////////////////////
+// Minimal google-benchmark-style microbenchmark harness. Benchmarks are
+// registered with DEFINE_BENCHMARK() and iterate with KeepRunning();
+// the harness runs each one until enough wall time has accumulated for a
+// stable ns/op figure, and prints one result line per benchmark.
+//
+// The clock is read between iterations, so each iteration should do a
+// meaningful batch of work (a full digest, a frame's worth of commands),
+// not a single nanosecond-scale operation.
+//////////////////////////////////////////////////////////////////////////
+
+namespace MicroBenchmark {
+
+class State
+{
+public:
+  /// Iteration loop, used as: while (state.KeepRunning()) { ... }.
+  bool KeepRunning();
+
+  /// Optional throughput figures for one iteration's worth of work, reported alongside ns/op.
+  ALWAYS_INLINE void SetBytesProcessed(u64 bytes) { m_bytes_per_iteration = bytes; }
+  ALWAYS_INLINE void SetItemsProcessed(u64 items) { m_items_per_iteration = items; }
+
+private:
+  u64 m_iterations = 0;
+  u64 m_bytes_per_iteration = 0;
+  u64 m_items_per_iteration = 0;
+  Common::Timer::Value m_start_time = 0;
+  Common::Timer::Value m_end_time = 0;
+
+  friend int RunAll(const char* filter);
+};
+
+using Function = void (*)(State& state);
+
+namespace Internal {
+void RegisterBenchmark(const char* name, Function function);
+
+struct Registrar
+{
+  Registrar(const char* name, Function function) { RegisterBenchmark(name, function); }
+};
+} // namespace Internal
+
+/// Prevents the compiler from eliminating a computed value as dead.
+template<typename T>
+ALWAYS_INLINE static void DoNotOptimize(const T& value)
+{
+#ifdef _MSC_VER
+  static volatile u8 s_sink;
+  s_sink = *reinterpret_cast<const volatile u8*>(&value);
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/// Runs all registered benchmarks whose name contains filter (all when null), printing one
+/// result line per benchmark to stdout. Returns an exit code for main().
+int RunAll(const char* filter);
+
+#define DEFINE_BENCHMARK(name)                                                                                         \
+  static void Benchmark_##name(MicroBenchmark::State& state);                                                          \
+  static MicroBenchmark::Internal::Registrar s_benchmark_registrar_##name(#name, &Benchmark_##name);                   \
+  static void Benchmark_##name(MicroBenchmark::State& state)
+
+} // namespace MicroBenchmark
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "micro_benchmark.h"
+
+#include "util/state_wrapper.h"
+
+#include "common/fifo_queue.h"
+#include "common/md5_digest.h"
+#include "common/sha1_digest.h"
+
+#include <array>
+#include <vector>
+
+namespace {
+
+constexpr u32 FIFO_BATCH_SIZE = 4096;
+constexpr u32 DIGEST_BUFFER_SIZE = 64 * 1024;
+
+// Deterministic pseudo-random bytes, so runs are comparable across machines and commits.
+std::vector<u8> MakeTestBuffer(u32 size)
+{
+  std::vector<u8> buffer(size);
+  u32 state = 0x12345678;
+  for (u32 i = 0; i < size; i++)
+  {
+    state = (state * 747796405u) + 2891336453u;
+    buffer[i] = static_cast<u8>(state >> 24);
+  }
+  return buffer;
+}
+
+} // namespace
+
+DEFINE_BENCHMARK(FIFOQueue_PushPop)
+{
+  static InlineFIFOQueue<u32, FIFO_BATCH_SIZE> fifo;
+
+  while (state.KeepRunning())
+  {
+    for (u32 i = 0; i < FIFO_BATCH_SIZE; i++)
+      fifo.Push(i);
+    u32 sum = 0;
+    for (u32 i = 0; i < FIFO_BATCH_SIZE; i++)
+      sum += fifo.Pop();
+    MicroBenchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(FIFO_BATCH_SIZE * 2);
+}
+
+DEFINE_BENCHMARK(FIFOQueue_PushPopRange)
+{
+  static InlineFIFOQueue<u32, FIFO_BATCH_SIZE> fifo;
+  static std::array<u32, FIFO_BATCH_SIZE> data = {};
+
+  while (state.KeepRunning())
+  {
+    fifo.PushRange(data.data(), FIFO_BATCH_SIZE);
+    fifo.PopRange(data.data(), FIFO_BATCH_SIZE);
+    MicroBenchmark::DoNotOptimize(data[0]);
+  }
+
+  state.SetBytesProcessed(static_cast<u64>(FIFO_BATCH_SIZE) * sizeof(u32) * 2);
+}
+
+DEFINE_BENCHMARK(MD5Digest_64K)
+{
+  static const std::vector<u8> buffer = MakeTestBuffer(DIGEST_BUFFER_SIZE);
+
+  while (state.KeepRunning())
+  {
+    u8 digest[16];
+    MD5Digest md5;
+    md5.Update(buffer.data(), static_cast<u32>(buffer.size()));
+    md5.Final(digest);
+    MicroBenchmark::DoNotOptimize(digest);
+  }
+
+  state.SetBytesProcessed(DIGEST_BUFFER_SIZE);
+}
+
+DEFINE_BENCHMARK(SHA1Digest_64K)
+{
+  static const std::vector<u8> buffer = MakeTestBuffer(DIGEST_BUFFER_SIZE);
+
+  while (state.KeepRunning())
+  {
+    u8 digest[SHA1Digest::DIGEST_SIZE];
+    SHA1Digest sha1;
+    sha1.Update(buffer.data(), static_cast<u32>(buffer.size()));
+    sha1.Final(digest);
+    MicroBenchmark::DoNotOptimize(digest);
+  }
+
+  state.SetBytesProcessed(DIGEST_BUFFER_SIZE);
+}
+
+DEFINE_BENCHMARK(StateWrapper_RoundTrip)
+{
+  // Shaped like a typical component DoState(): a few scalars and a large POD array, through the
+  // raw-memory fast path that rewind/runahead use.
+  struct TestState
+  {
+    u32 scalar_a;
+    bool flag_b;
+    float scalar_c;
+    std::array<u32, 4096> payload;
+  };
+
+  static TestState test_state = {};
+  static std::vector<u8> buffer(sizeof(TestState) + 128);
+
+  const auto do_state = [](StateWrapper& sw) {
+    sw.Do(&test_state.scalar_a);
+    sw.Do(&test_state.flag_b);
+    sw.Do(&test_state.scalar_c);
+    sw.DoArray(test_state.payload.data(), test_state.payload.size());
+  };
+
+  while (state.KeepRunning())
+  {
+    StateWrapper writer(buffer.data(), buffer.size(), StateWrapper::Mode::Write, 1);
+    do_state(writer);
+    StateWrapper reader(buffer.data(), buffer.size(), StateWrapper::Mode::Read, 1);
+    do_state(reader);
+    MicroBenchmark::DoNotOptimize(test_state.scalar_a);
+  }
+
+  state.SetBytesProcessed(sizeof(TestState) * 2);
+}
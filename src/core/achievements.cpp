@@ -140,6 +140,7 @@ static bool CreateClient(rc_client_t** client, std::unique_ptr<HTTPDownloader>*
 static void DestroyClient(rc_client_t** client, std::unique_ptr<HTTPDownloader>* http);
 static void ClientMessageCallback(const char* message, const rc_client_t* client);
 static uint32_t ClientReadMemory(uint32_t address, uint8_t* buffer, uint32_t num_bytes, rc_client_t* client);
+static void UpdateMemoryPeekSnapshot();
 static void ClientServerCall(const rc_api_request_t* request, rc_client_server_callback_t callback, void* callback_data,
                              rc_client_t* client);
 
@@ -202,6 +203,16 @@ static std::string s_game_icon;
 static rc_client_user_game_summary_t s_game_summary;
 static u32 s_game_id = 0;
 
+// Snapshot of the RAM range the active achievement set actually peeks, refreshed once per frame
+// before rc_client_do_frame() so repeated reads hit a small contiguous buffer instead of going
+// through the bus for every byte. The watched range is learned from the addresses rcheevos asks
+// for, and the snapshot is skipped entirely if the set somehow watches most of RAM.
+static std::vector<u8> s_peek_snapshot;
+static u32 s_peek_snapshot_start = 0;
+static u32 s_peek_snapshot_end = 0;
+static u32 s_watched_range_start = 0;
+static u32 s_watched_range_end = 0;
+
 static bool s_has_achievements = false;
 static bool s_has_leaderboards = false;
 static bool s_has_rich_presence = false;
@@ -592,6 +603,28 @@ void Achievements::ClientMessageCallback(const char* message, const rc_client_t*
 
 uint32_t Achievements::ClientReadMemory(uint32_t address, uint8_t* buffer, uint32_t num_bytes, rc_client_t* client)
 {
+  // Nearly all peeks hit main RAM (or one of its mirrors); service those directly, preferring the
+  // per-frame snapshot so the hot loop in rc_client_do_frame() stays within one small buffer.
+  const PhysicalMemoryAddress phys_addr = address & CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
+  if (phys_addr < Bus::RAM_MIRROR_END && (num_bytes == 1 || num_bytes == 2 || num_bytes == 4))
+  {
+    const u32 offset = phys_addr & Bus::g_ram_mask;
+    if ((offset + num_bytes) <= Bus::g_ram_size)
+    {
+      if (offset >= s_peek_snapshot_start && (offset + num_bytes) <= s_peek_snapshot_end)
+      {
+        std::memcpy(buffer, &s_peek_snapshot[offset - s_peek_snapshot_start], num_bytes);
+        return num_bytes;
+      }
+
+      // Not snapshotted yet - read RAM directly and widen the watched range for the next frame.
+      std::memcpy(buffer, &Bus::g_ram[offset], num_bytes);
+      s_watched_range_start = (s_watched_range_end == 0) ? offset : std::min(s_watched_range_start, offset);
+      s_watched_range_end = std::max(s_watched_range_end, offset + num_bytes);
+      return num_bytes;
+    }
+  }
+
   switch (num_bytes)
   {
     case 1:
@@ -614,6 +647,25 @@ uint32_t Achievements::ClientReadMemory(uint32_t address, uint8_t* buffer, uint3
   }
 }
 
+void Achievements::UpdateMemoryPeekSnapshot()
+{
+  // If the set watches most of RAM, copying it every frame costs more than it saves.
+  static constexpr u32 MAX_SNAPSHOT_SIZE = 512 * 1024;
+
+  const u32 size = s_watched_range_end - s_watched_range_start;
+  if (s_watched_range_end == 0 || size > MAX_SNAPSHOT_SIZE)
+  {
+    s_peek_snapshot_start = 0;
+    s_peek_snapshot_end = 0;
+    return;
+  }
+
+  s_peek_snapshot.resize(size);
+  std::memcpy(s_peek_snapshot.data(), &Bus::g_ram[s_watched_range_start], size);
+  s_peek_snapshot_start = s_watched_range_start;
+  s_peek_snapshot_end = s_watched_range_end;
+}
+
 void Achievements::ClientServerCall(const rc_api_request_t* request, rc_client_server_callback_t callback,
                                     void* callback_data, rc_client_t* client)
 {
@@ -686,6 +738,8 @@ void Achievements::FrameUpdate()
   auto lock = GetLock();
 
   s_http_downloader->PollRequests();
+
+  UpdateMemoryPeekSnapshot();
   rc_client_do_frame(s_client);
 
   UpdateRichPresence(lock);
@@ -985,6 +1039,11 @@ void Achievements::ClearGameInfo()
   s_has_rich_presence = false;
   s_rich_presence_string = {};
   s_game_summary = {};
+  s_peek_snapshot = {};
+  s_peek_snapshot_start = 0;
+  s_peek_snapshot_end = 0;
+  s_watched_range_start = 0;
+  s_watched_range_end = 0;
 
   Host::OnAchievementsRefreshed();
 }
@@ -137,6 +137,9 @@ static std::vector<std::pair<u8*, size_t>> s_fastmem_ram_views;
 
 static u8** s_fastmem_lut = nullptr;
 
+static bool s_ram_write_tracking_enabled = false;
+static std::bitset<RAM_8MB_CODE_PAGE_COUNT> s_ram_dirty_pages{};
+
 static void SetRAMSize(bool enable_8mb_ram);
 
 static std::tuple<TickCount, TickCount, TickCount> CalculateMemoryTiming(MEMDELAY mem_delay, COMDELAY common_delay);
@@ -145,6 +148,7 @@ static void RecalculateMemoryTimings();
 static u8* GetLUTFastmemPointer(u32 address, u8* ram_ptr);
 
 static void SetRAMPageWritable(u32 page_index, bool writable);
+static void RestoreRAMProtection();
 
 static void SetHandlers();
 
@@ -316,6 +320,9 @@ void Bus::SetRAMSize(bool enable_8mb_ram)
 
 void Bus::Shutdown()
 {
+  s_ram_write_tracking_enabled = false;
+  s_ram_dirty_pages.reset();
+
   UpdateFastmemViews(CPUFastmemMode::Disabled);
   CPU::g_state.fastmem_base = nullptr;
 
@@ -375,7 +382,7 @@ void Bus::AddTTYString(const std::string_view& str)
     AddTTYCharacter(ch);
 }
 
-bool Bus::DoState(StateWrapper& sw)
+bool Bus::DoState(StateWrapper& sw, bool skip_ram)
 {
   u32 ram_size = g_ram_size;
   sw.DoEx(&ram_size, 52, static_cast<u32>(RAM_2MB_SIZE));
@@ -392,7 +399,10 @@ bool Bus::DoState(StateWrapper& sw)
   sw.Do(&g_bios_access_time);
   sw.Do(&g_cdrom_access_time);
   sw.Do(&g_spu_access_time);
-  sw.DoBytes(g_ram, g_ram_size);
+
+  // Memory save states with RAM write tracking keep their RAM copy outside the stream.
+  if (!skip_ram)
+    sw.DoBytes(g_ram, g_ram_size);
 
   if (sw.GetVersion() < 58)
   {
@@ -499,6 +509,15 @@ void Bus::UpdateFastmemViews(CPUFastmemMode mode)
   s_fastmem_ram_views.clear();
 #endif
 
+  // The views come back without any write-tracking protection, so consider everything written, and
+  // drop the tracking protection on g_ram to match - a dirty page must never stay read-only, or the
+  // fault handler would spin on it.
+  if (s_ram_write_tracking_enabled)
+  {
+    s_ram_dirty_pages.set();
+    RestoreRAMProtection();
+  }
+
   s_fastmem_mode = mode;
   if (mode == CPUFastmemMode::Disabled)
     return;
@@ -632,6 +651,12 @@ void Bus::ClearRAMCodePage(u32 index)
 
   // unprotect fastmem pages
   g_ram_code_bits[index] = false;
+
+  // The page is being invalidated because it's about to be written, and unprotecting it means write
+  // tracking will never see a fault for it.
+  if (s_ram_write_tracking_enabled)
+    s_ram_dirty_pages[index] = true;
+
   SetRAMPageWritable(index, true);
 }
 
@@ -670,6 +695,10 @@ void Bus::ClearRAMCodePageFlags()
 {
   g_ram_code_bits.reset();
 
+  // Everything loses its protection below, including the write-tracking pages.
+  if (s_ram_write_tracking_enabled)
+    s_ram_dirty_pages.set();
+
   if (!MemMap::MemProtect(g_ram, RAM_8MB_SIZE, PageProtect::ReadWrite))
     Log_ErrorPrint("Failed to restore RAM protection to read-write.");
 
@@ -688,6 +717,92 @@ void Bus::ClearRAMCodePageFlags()
 #endif
 }
 
+void Bus::RestoreRAMProtection()
+{
+  // Same dance as ClearRAMCodePageFlags(), but the code bits survive, so put their protection back.
+  if (!MemMap::MemProtect(g_ram, RAM_8MB_SIZE, PageProtect::ReadWrite))
+    Log_ErrorPrint("Failed to restore RAM protection to read-write.");
+
+#ifdef ENABLE_MMAP_FASTMEM
+  if (s_fastmem_mode == CPUFastmemMode::MMap)
+  {
+    for (const auto& it : s_fastmem_ram_views)
+    {
+      if (!MemMap::MemProtect(it.first, it.second, PageProtect::ReadWrite))
+        Log_ErrorPrintf("Failed to unprotect fastmem view @ %p", it.first);
+    }
+  }
+#endif
+
+  for (u32 i = 0; i < static_cast<u32>(g_ram_code_bits.size()); i++)
+  {
+    if (g_ram_code_bits[i])
+      SetRAMPageWritable(i, false);
+  }
+}
+
+void Bus::EnableRAMWriteTracking(bool enable)
+{
+  if (s_ram_write_tracking_enabled == enable)
+    return;
+
+  s_ram_write_tracking_enabled = enable;
+
+  // No interval has started yet, so everything counts as written. The first call to
+  // ResetRAMDirtyPages() puts the protection in place.
+  s_ram_dirty_pages.set();
+
+  if (!enable)
+    RestoreRAMProtection();
+}
+
+bool Bus::IsRAMWriteTrackingEnabled()
+{
+  return s_ram_write_tracking_enabled;
+}
+
+const std::bitset<Bus::RAM_8MB_CODE_PAGE_COUNT>& Bus::GetRAMDirtyPages()
+{
+  return s_ram_dirty_pages;
+}
+
+void Bus::ResetRAMDirtyPages()
+{
+  if (!s_ram_write_tracking_enabled)
+    return;
+
+  s_ram_dirty_pages.reset();
+
+  // One bulk protect instead of a syscall per page. Anything that must stay writable (e.g.
+  // manually-checked code pages) self-heals with a single fault through the usual handler, which
+  // also marks it dirty again.
+  if (!MemMap::MemProtect(g_ram, g_ram_size, PageProtect::ReadOnly))
+    Log_ErrorPrint("Failed to write-protect RAM for dirty tracking.");
+
+#ifdef ENABLE_MMAP_FASTMEM
+  if (s_fastmem_mode == CPUFastmemMode::MMap)
+  {
+    for (const auto& it : s_fastmem_ram_views)
+    {
+      if (!MemMap::MemProtect(it.first, it.second, PageProtect::ReadOnly))
+        Log_ErrorPrintf("Failed to write-protect fastmem view @ %p", it.first);
+    }
+  }
+#endif
+}
+
+void Bus::MarkRAMPageDirty(u32 page_index)
+{
+  if (!s_ram_write_tracking_enabled || s_ram_dirty_pages[page_index])
+    return;
+
+  s_ram_dirty_pages[page_index] = true;
+
+  // Code pages keep their protection; the code cache decides when those become writable again.
+  if (!g_ram_code_bits[page_index])
+    SetRAMPageWritable(page_index, true);
+}
+
 bool Bus::IsCodePageAddress(PhysicalMemoryAddress address)
 {
   return IsRAMAddress(address) ? g_ram_code_bits[(address & g_ram_mask) / HOST_PAGE_SIZE] : false;
@@ -713,6 +828,34 @@ bool Bus::HasCodePagesInRange(PhysicalMemoryAddress start_address, u32 size)
   return false;
 }
 
+void Bus::ReadWordsFromRAM(PhysicalMemoryAddress address, u32* data, u32 word_count)
+{
+  address &= g_ram_mask & ~UINT32_C(3);
+  while (word_count > 0)
+  {
+    const u32 words_until_mirror = (g_ram_size - address) / sizeof(u32);
+    const u32 copy_count = std::min(word_count, words_until_mirror);
+    std::memcpy(data, &g_ram[address], copy_count * sizeof(u32));
+    data += copy_count;
+    word_count -= copy_count;
+    address = 0;
+  }
+}
+
+void Bus::WriteWordsToRAM(PhysicalMemoryAddress address, const u32* data, u32 word_count)
+{
+  address &= g_ram_mask & ~UINT32_C(3);
+  while (word_count > 0)
+  {
+    const u32 words_until_mirror = (g_ram_size - address) / sizeof(u32);
+    const u32 copy_count = std::min(word_count, words_until_mirror);
+    std::memcpy(&g_ram[address], data, copy_count * sizeof(u32));
+    data += copy_count;
+    word_count -= copy_count;
+    address = 0;
+  }
+}
+
 std::optional<Bus::MemoryRegion> Bus::GetMemoryRegionForAddress(PhysicalMemoryAddress address)
 {
   if (address < RAM_2MB_SIZE)
@@ -1571,19 +1714,6 @@ static constexpr std::array<RT, 256> GetHardwareRegisterHandlerTable()
       ret[i] = UnmappedWriteHandler<size>;
   }
 
-#if 0
-  // Verifies no region has >1 handler, but doesn't compile on older GCC.
-#define SET(raddr, rsize, read_handler, write_handler)                                                                 \
-  static_assert(raddr >= 0x1F801000 && (raddr + rsize) <= 0x1F802000);                                                 \
-  for (u32 taddr = raddr; taddr < (raddr + rsize); taddr += 16)                                                        \
-  {                                                                                                                    \
-    const u32 i = (taddr >> 4) & 0xFFu;                                                                                \
-    if constexpr (type == MemoryAccessType::Read)                                                                      \
-      ret[i] = (ret[i] == UnmappedReadHandler<size>) ? read_handler<size> : (abort(), read_handler<size>);             \
-    else                                                                                                               \
-      ret[i] = (ret[i] == UnmappedWriteHandler<size>) ? write_handler<size> : (abort(), write_handler<size>);          \
-  }
-#else
 #define SET(raddr, rsize, read_handler, write_handler)                                                                 \
   static_assert(raddr >= 0x1F801000 && (raddr + rsize) <= 0x1F802000);                                                 \
   for (u32 taddr = raddr; taddr < (raddr + rsize); taddr += 16)                                                        \
@@ -1594,7 +1724,6 @@ static constexpr std::array<RT, 256> GetHardwareRegisterHandlerTable()
     else                                                                                                               \
       ret[i] = write_handler<size>;                                                                                    \
   }
-#endif
 
   SET(MEMCTRL_BASE, MEMCTRL_SIZE, MemCtrlRead, MemCtrlWrite);
   SET(PAD_BASE, PAD_SIZE, PADRead, PADWrite);
@@ -1612,6 +1741,41 @@ static constexpr std::array<RT, 256> GetHardwareRegisterHandlerTable()
 
   return ret;
 }
+
+// Verifies no 16-byte slot in the table above is claimed by more than one device. Kept separate
+// from the table builder so the failure can be reported through a plain static_assert.
+static constexpr bool VerifyHardwareRegisterHandlerTable()
+{
+  std::array<u32, 256> claims = {};
+
+#define SET(raddr, rsize)                                                                                              \
+  for (u32 taddr = raddr; taddr < (raddr + rsize); taddr += 16)                                                        \
+    claims[(taddr >> 4) & 0xFFu]++;
+
+  SET(MEMCTRL_BASE, MEMCTRL_SIZE)
+  SET(PAD_BASE, PAD_SIZE)
+  SET(SIO_BASE, SIO_SIZE)
+  SET(MEMCTRL2_BASE, MEMCTRL2_SIZE)
+  SET(INTC_BASE, INTC_SIZE)
+  SET(DMA_BASE, DMA_SIZE)
+  SET(TIMERS_BASE, TIMERS_SIZE)
+  SET(CDROM_BASE, CDROM_SIZE)
+  SET(GPU_BASE, GPU_SIZE)
+  SET(MDEC_BASE, MDEC_SIZE)
+  SET(SPU_BASE, SPU_SIZE)
+
+#undef SET
+
+  for (const u32 count : claims)
+  {
+    if (count > 1)
+      return false;
+  }
+
+  return true;
+}
+
+static_assert(VerifyHardwareRegisterHandlerTable(), "Hardware register regions overlap");
 } // namespace Bus::HWHandlers
 
 template<MemoryAccessSize size>
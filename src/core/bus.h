@@ -115,7 +115,7 @@ void ReleaseMemory();
 bool Initialize();
 void Shutdown();
 void Reset();
-bool DoState(StateWrapper& sw);
+bool DoState(StateWrapper& sw, bool skip_ram = false);
 
 using MemoryReadHandler = u32 (*)(VirtualMemoryAddress address);
 using MemoryWriteHandler = void (*)(VirtualMemoryAddress, u32);
@@ -178,6 +178,29 @@ bool IsCodePageAddress(PhysicalMemoryAddress address);
 /// Returns true if the range specified overlaps with a code page.
 bool HasCodePagesInRange(PhysicalMemoryAddress start_address, u32 size);
 
+/// Bulk word access to RAM for block movers (DMA, debugger), splitting the copy into straight
+/// memcpy() segments wherever it crosses a RAM mirror boundary, instead of masking per word.
+void ReadWordsFromRAM(PhysicalMemoryAddress address, u32* data, u32 word_count);
+void WriteWordsToRAM(PhysicalMemoryAddress address, const u32* data, u32 word_count);
+
+/// Copy-on-write style dirty tracking for memory save states. While enabled, RAM is write-protected
+/// and the first write to each page faults once, marking the page dirty, so snapshot consumers only
+/// have to copy the pages the game actually touched instead of all of RAM. Reuses the same
+/// protection/fault-recovery machinery as the code pages; writes through g_unprotected_ram (the
+/// debugger) are the one path that bypasses it.
+void EnableRAMWriteTracking(bool enable);
+bool IsRAMWriteTrackingEnabled();
+
+/// Pages written since the last call to ResetRAMDirtyPages().
+const std::bitset<RAM_8MB_CODE_PAGE_COUNT>& GetRAMDirtyPages();
+
+/// Starts a new tracking interval: clears the dirty set and re-protects RAM.
+void ResetRAMDirtyPages();
+
+/// Marks a page as written and restores write access to it. Called from the page fault handler, and
+/// from writers which go through the unprotected mapping.
+void MarkRAMPageDirty(u32 page_index);
+
 /// Returns the number of cycles stolen by DMA RAM access.
 ALWAYS_INLINE TickCount GetDMARAMTickCount(u32 word_count)
 {
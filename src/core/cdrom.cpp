@@ -24,6 +24,7 @@
 #include "common/heap_array.h"
 #include "common/intrin.h"
 #include "common/log.h"
+#include "common/perf_trace.h"
 
 #include "imgui.h"
 
@@ -53,6 +54,9 @@ enum : u32
   AUDIO_FIFO_SIZE = 44100 * 2,
   AUDIO_FIFO_LOW_WATERMARK = 10,
 
+  // Number of upcoming CDDA sectors to decode into the audio FIFO ahead of their drive events.
+  CDDA_LOOKAHEAD_SECTORS = 4,
+
   INIT_TICKS = 4000000,
   ID_READ_TICKS = 33868,
   MOTOR_ON_RESPONSE_TICKS = 400000,
@@ -226,6 +230,7 @@ static bool CanReadMedia();
 static bool HasPendingCommand();
 static bool HasPendingInterrupt();
 static bool HasPendingAsyncInterrupt();
+static bool IsUsingSectorBufferQueue();
 static void AddCDAudioFrame(s16 left, s16 right);
 
 static s32 ApplyVolume(s16 sample, u8 volume);
@@ -277,7 +282,8 @@ static void DoSectorRead();
 static void ProcessDataSectorHeader(const u8* raw_sector);
 static void ProcessDataSector(const u8* raw_sector, const CDImage::SubChannelQ& subq);
 static void ProcessXAADPCMSector(const u8* raw_sector, const CDImage::SubChannelQ& subq);
-static void ProcessCDDASector(const u8* raw_sector, const CDImage::SubChannelQ& subq);
+static void ProcessCDDASector(const u8* raw_sector, const CDImage::SubChannelQ& subq, bool audio_prequeued);
+static void QueueCDDALookahead();
 static void StopReadingWithDataEnd();
 static void StartMotor();
 static void StopMotor();
@@ -298,6 +304,7 @@ static TinyString LBAToMSFString(CDImage::LBA lba);
 static void CreateFileMap();
 static void CreateFileMap(IsoReader& iso, const std::string_view& dir);
 static const std::string* LookupFileMap(u32 lba, u32* start_lba, u32* end_lba);
+static void UpdateReaderPrefetchHint();
 
 static std::unique_ptr<TimingEvent> s_command_event;
 static std::unique_ptr<TimingEvent> s_command_second_response_event;
@@ -376,6 +383,10 @@ static CDROMAsyncReader s_reader;
 // two 16-bit samples packed in 32-bits
 static HeapFIFOQueue<u32, AUDIO_FIFO_SIZE> s_audio_fifo;
 
+// Number of future CDDA sectors whose frames are already in the audio FIFO. These are skipped
+// for decode when their drive event fires. See QueueCDDALookahead().
+static u32 s_audio_lookahead_sectors = 0;
+
 static std::map<u32, std::pair<u32, std::string>> s_file_map;
 static bool s_file_map_created = false;
 static bool s_show_current_file = false;
@@ -654,6 +665,7 @@ bool CDROM::DoState(StateWrapper& sw)
   }
 
   sw.Do(&s_audio_fifo);
+  sw.DoEx(&s_audio_lookahead_sectors, 63, static_cast<u32>(0));
   sw.Do(&s_requested_lba);
 
   if (sw.IsReading())
@@ -757,8 +769,8 @@ void CDROM::InsertMedia(std::unique_ptr<CDImage> media, DiscRegion region)
   if (s_drive_state != DriveState::ShellOpening)
     StartMotor();
 
-  if (s_show_current_file)
-    CreateFileMap();
+  // always build the file map, the reader uses it to prefetch along file extents
+  CreateFileMap();
 }
 
 std::unique_ptr<CDImage> CDROM::RemoveMedia(bool for_disc_swap)
@@ -774,8 +786,7 @@ std::unique_ptr<CDImage> CDROM::RemoveMedia(bool for_disc_swap)
   Log_InfoPrintf("Removing CD...");
   std::unique_ptr<CDImage> image = s_reader.RemoveMedia();
 
-  if (s_show_current_file)
-    CreateFileMap();
+  CreateFileMap();
 
   s_last_sector_header_valid = false;
 
@@ -1078,6 +1089,11 @@ void CDROM::DMARead(u32* words, u32 word_count)
   s_data_fifo.PopRange(reinterpret_cast<u8*>(words), bytes_to_read);
 }
 
+u32 CDROM::GetDMAReadAvailable()
+{
+  return s_data_fifo.GetSize() / 4;
+}
+
 bool CDROM::HasPendingCommand()
 {
   return s_command != Command::None;
@@ -1093,6 +1109,14 @@ bool CDROM::HasPendingAsyncInterrupt()
   return s_pending_async_interrupt != 0;
 }
 
+bool CDROM::IsUsingSectorBufferQueue()
+{
+  // With read speedup the drive outpaces the game's per-sector INT1/DMA handshake, so instead of
+  // the hardware's latest-sector-wins behaviour, treat the sector buffers as a queue and deliver
+  // them back-to-back as the game drains the data FIFO. Stock speed keeps hardware behaviour.
+  return g_settings.cdrom_read_speedup > 1;
+}
+
 void CDROM::SetInterrupt(Interrupt interrupt)
 {
   s_interrupt_flag_register = static_cast<u8>(interrupt);
@@ -1166,7 +1190,20 @@ void CDROM::DeliverAsyncInterrupt(void*, TickCount ticks, TickCount ticks_late)
     Log_DebugPrintf("Delivering async interrupt %u", s_pending_async_interrupt);
 
     if (s_pending_async_interrupt == static_cast<u8>(Interrupt::DataReady))
-      s_current_read_sector_buffer = s_current_write_sector_buffer;
+    {
+      const u32 next_buffer = (s_current_read_sector_buffer + 1) % NUM_SECTOR_BUFFERS;
+      if (IsUsingSectorBufferQueue() && s_current_read_sector_buffer != s_current_write_sector_buffer &&
+          s_sector_buffers[next_buffer].size > 0)
+      {
+        // Queued burst delivery: consume buffered sectors in order instead of jumping to the
+        // most recently read one.
+        s_current_read_sector_buffer = next_buffer;
+      }
+      else
+      {
+        s_current_read_sector_buffer = s_current_write_sector_buffer;
+      }
+    }
 
     s_response_fifo.Clear();
     s_response_fifo.PushFromQueue(&s_async_response_fifo);
@@ -2776,6 +2813,8 @@ void CDROM::StopMotor()
 
 void CDROM::DoSectorRead()
 {
+  PerfTrace::Scope trace_scope("CDROM::DoSectorRead");
+
   // TODO: Queue the next read here and swap the buffer.
   // TODO: Error handling
   if (!s_reader.WaitForReadToComplete())
@@ -2830,6 +2869,7 @@ void CDROM::DoSectorRead()
   }
 
   u32 next_sector = s_current_lba + 1u;
+  bool is_cdda_sector = false;
   if (is_data_sector && s_drive_state == DriveState::Reading)
   {
     ProcessDataSector(s_reader.GetSectorBuffer().data(), subq);
@@ -2837,7 +2877,19 @@ void CDROM::DoSectorRead()
   else if (!is_data_sector &&
            (s_drive_state == DriveState::Playing || (s_drive_state == DriveState::Reading && s_mode.cdda)))
   {
-    ProcessCDDASector(s_reader.GetSectorBuffer().data(), subq);
+    is_cdda_sector = true;
+
+    // Fast-forwarding skips sectors, so any look-ahead audio is stale.
+    if (s_fast_forward_rate != 0 && s_audio_lookahead_sectors > 0)
+    {
+      s_audio_fifo.Clear();
+      s_audio_lookahead_sectors = 0;
+    }
+
+    const bool audio_prequeued = (s_audio_lookahead_sectors > 0);
+    if (audio_prequeued)
+      s_audio_lookahead_sectors--;
+    ProcessCDDASector(s_reader.GetSectorBuffer().data(), subq, audio_prequeued);
 
     if (s_fast_forward_rate != 0)
       next_sector = s_current_lba + SignExtend32(s_fast_forward_rate);
@@ -2853,7 +2905,11 @@ void CDROM::DoSectorRead()
   }
 
   s_requested_lba = next_sector;
+  UpdateReaderPrefetchHint();
   s_reader.QueueReadSector(s_requested_lba);
+
+  if (is_cdda_sector && s_fast_forward_rate == 0)
+    QueueCDDALookahead();
 }
 
 void CDROM::ProcessDataSectorHeader(const u8* raw_sector)
@@ -2884,7 +2940,8 @@ void CDROM::ProcessDataSector(const u8* raw_sector, const CDImage::SubChannelQ&
 
   // TODO: How does XA relate to this buffering?
   SectorBuffer* sb = &s_sector_buffers[sb_num];
-  if (sb->size > 0)
+  const bool overwrote_unread_sector = (sb->size > 0);
+  if (overwrote_unread_sector)
   {
     Log_DevPrintf("Sector buffer %u was not read, previous sector dropped",
                   (s_current_write_sector_buffer - 1) % NUM_SECTOR_BUFFERS);
@@ -2916,6 +2973,14 @@ void CDROM::ProcessDataSector(const u8* raw_sector, const CDImage::SubChannelQ&
   // Deliver to CPU
   if (HasPendingAsyncInterrupt())
   {
+    if (!overwrote_unread_sector && IsUsingSectorBufferQueue())
+    {
+      // Burst delivery: the announced sector hasn't been picked up yet, so leave its INT1
+      // pending and keep this one queued. LoadDataFIFO() announces it back-to-back once the
+      // game drains the current sector.
+      return;
+    }
+
     Log_WarningPrintf("Data interrupt was not delivered");
     ClearAsyncInterrupt();
   }
@@ -3060,6 +3125,7 @@ void CDROM::ResetAudioDecoder()
     s_xa_resample_sixstep = 6;
   }
   s_audio_fifo.Clear();
+  s_audio_lookahead_sectors = 0;
 }
 
 void CDROM::ProcessXAADPCMSector(const u8* raw_sector, const CDImage::SubChannelQ& subq)
@@ -3183,7 +3249,7 @@ static s16 GetPeakVolume(const u8* raw_sector, u8 channel)
 #endif
 }
 
-void CDROM::ProcessCDDASector(const u8* raw_sector, const CDImage::SubChannelQ& subq)
+void CDROM::ProcessCDDASector(const u8* raw_sector, const CDImage::SubChannelQ& subq, bool audio_prequeued)
 {
   // For CDDA sectors, the whole sector contains the audio data.
   Log_DevPrintf("Read sector %u as CDDA", s_current_lba);
@@ -3229,6 +3295,10 @@ void CDROM::ProcessCDDASector(const u8* raw_sector, const CDImage::SubChannelQ&
     }
   }
 
+  // Look-ahead already queued this sector's frames into the FIFO.
+  if (audio_prequeued)
+    return;
+
   // Apply volume when pushing sectors to SPU.
   if (s_muted || g_settings.cdrom_mute_cd_audio)
     return;
@@ -3255,6 +3325,46 @@ void CDROM::ProcessCDDASector(const u8* raw_sector, const CDImage::SubChannelQ&
   }
 }
 
+void CDROM::QueueCDDALookahead()
+{
+  // Decode upcoming CDDA sectors out of the reader's readahead ring into the audio FIFO ahead of
+  // their drive events. The FIFO is deep enough that this slack lets the SPU ride out a slow
+  // sector read (e.g. an image on network storage) without an audible dropout. Pre-decoded
+  // sectors are skipped for decode when their event fires, so position reports and auto-pause
+  // still run in lockstep with the drive. XA keeps the lockstep path, since its resampler relies
+  // on a nearly-empty FIFO to stay in sync.
+  if (s_muted || g_settings.cdrom_mute_cd_audio)
+    return;
+
+  constexpr u32 frames_per_sector = CDImage::RAW_SECTOR_SIZE / (sizeof(s16) * 2);
+  while (s_audio_lookahead_sectors < CDDA_LOOKAHEAD_SECTORS)
+  {
+    // The next sector to queue follows the already-queued run, which starts at the sector the
+    // drive just requested (the reader's front slot).
+    const CDROMAsyncReader::BufferSlot* slot = s_reader.PeekBufferedSector(s_audio_lookahead_sectors);
+    if (!slot || !slot->result || slot->lba != (s_requested_lba + s_audio_lookahead_sectors) ||
+        !slot->subq.IsCRCValid() || slot->subq.IsData() ||
+        slot->subq.track_number_bcd == CDImage::LEAD_OUT_TRACK_NUMBER ||
+        (s_mode.auto_pause && slot->subq.track_number_bcd != s_play_track_number_bcd) ||
+        s_audio_fifo.GetSpace() < frames_per_sector)
+    {
+      break;
+    }
+
+    const u8* sector_ptr = slot->data.data();
+    for (u32 i = 0; i < frames_per_sector; i++)
+    {
+      s16 samp_left, samp_right;
+      std::memcpy(&samp_left, sector_ptr, sizeof(samp_left));
+      std::memcpy(&samp_right, sector_ptr + sizeof(s16), sizeof(samp_right));
+      sector_ptr += sizeof(s16) * 2;
+      AddCDAudioFrame(samp_left, samp_right);
+    }
+
+    s_audio_lookahead_sectors++;
+  }
+}
+
 void CDROM::LoadDataFIFO()
 {
   if (!s_data_fifo.IsEmpty())
@@ -3278,10 +3388,13 @@ void CDROM::LoadDataFIFO()
 
   Log_DebugPrintf("Loaded %u bytes to data FIFO from buffer %u", s_data_fifo.GetSize(), s_current_read_sector_buffer);
 
-  SectorBuffer& next_sb = s_sector_buffers[s_current_write_sector_buffer];
+  // When bursting, announce the next queued sector rather than the most recently read one.
+  const u32 next_sb_num = IsUsingSectorBufferQueue() ? ((s_current_read_sector_buffer + 1) % NUM_SECTOR_BUFFERS) :
+                                                       s_current_write_sector_buffer;
+  SectorBuffer& next_sb = s_sector_buffers[next_sb_num];
   if (next_sb.size > 0)
   {
-    Log_DevPrintf("Sending additional INT1 for missed sector in buffer %u", s_current_write_sector_buffer);
+    Log_DevPrintf("Sending additional INT1 for missed sector in buffer %u", next_sb_num);
     s_async_response_fifo.Push(s_secondary_status.bits);
     SetAsyncInterrupt(Interrupt::DataReady);
   }
@@ -3360,6 +3473,30 @@ const std::string* CDROM::LookupFileMap(u32 lba, u32* start_lba, u32* end_lba)
   return &iter->second.second;
 }
 
+void CDROM::UpdateReaderPrefetchHint()
+{
+  if (!s_file_map_created || s_file_map.empty())
+  {
+    s_reader.ClearExtentHint();
+    return;
+  }
+
+  // the file map is in track-1-relative LBAs (see CreateFileMap())
+  const CDImage::LBA track_start = s_reader.GetMedia()->GetTrackStartPosition(1);
+  u32 file_start_lba, file_end_lba;
+  if (s_requested_lba < track_start ||
+      !LookupFileMap(s_requested_lba - track_start, &file_start_lba, &file_end_lba))
+  {
+    s_reader.ClearExtentHint();
+    return;
+  }
+
+  // the file which follows this one on disc is usually what a loading sequence requests next
+  const auto next_iter = s_file_map.upper_bound(file_end_lba);
+  const bool next_valid = (next_iter != s_file_map.end());
+  s_reader.SetExtentHint(file_end_lba + track_start, next_valid ? (next_iter->first + track_start) : 0, next_valid);
+}
+
 void CDROM::DrawDebugWindow()
 {
   static const ImVec4 active_color{1.0f, 1.0f, 1.0f, 1.0f};
@@ -36,6 +36,10 @@ u8 ReadRegister(u32 offset);
 void WriteRegister(u32 offset, u8 value);
 void DMARead(u32* words, u32 word_count);
 
+/// Returns the number of words available in the data FIFO. Used to size batched DMA block
+/// transfers.
+u32 GetDMAReadAvailable();
+
 // Render statistics debug window.
 void DrawDebugWindow();
 
@@ -2,11 +2,17 @@
 // SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
 
 #include "cdrom_async_reader.h"
+#include "settings.h"
+
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/timer.h"
 Log_SetChannel(CDROMAsyncReader);
 
+// The ring is allocated larger than the configured readahead so the window can grow during sustained
+// streaming, and so a second interleaved extent can be prefetched alongside the primary one.
+static constexpr u32 MAX_WINDOW_MULTIPLIER = 4;
+
 CDROMAsyncReader::CDROMAsyncReader() = default;
 
 CDROMAsyncReader::~CDROMAsyncReader()
@@ -19,13 +25,22 @@ void CDROMAsyncReader::StartThread(u32 readahead_count)
   if (IsUsingThread())
     StopThread();
 
+  m_base_readahead_count = readahead_count;
+  m_readahead_window.store(readahead_count);
+  m_hit_streak = 0;
+  m_resume_lba_valid = false;
+  m_prefetch_position_set = false;
+  m_extent_hint_valid = false;
+  m_next_extent_valid = false;
+
   m_buffers.clear();
-  m_buffers.resize(readahead_count);
+  m_buffers.resize(readahead_count * MAX_WINDOW_MULTIPLIER);
   EmptyBuffers();
 
   m_shutdown_flag.store(false);
   m_read_thread = std::thread(&CDROMAsyncReader::WorkerThreadEntryPoint, this);
-  Log_InfoPrintf("Read thread started with readahead of %u sectors", readahead_count);
+  Log_InfoPrintf("Read thread started with readahead of %u sectors (window grows up to %u)", readahead_count,
+                 static_cast<u32>(m_buffers.size()) / 2);
 }
 
 void CDROMAsyncReader::StopThread()
@@ -42,6 +57,7 @@ void CDROMAsyncReader::StopThread()
   m_read_thread.join();
   EmptyBuffers();
   m_buffers.clear();
+  m_base_readahead_count = 0;
 }
 
 void CDROMAsyncReader::SetMedia(std::unique_ptr<CDImage> media)
@@ -76,7 +92,8 @@ bool CDROMAsyncReader::Precache(ProgressCallback* callback)
   if (res == CDImage::PrecacheResult::Unsupported)
   {
     // fall back to copy precaching
-    std::unique_ptr<CDImage> memory_image = CDImage::CreateMemoryImage(m_media.get(), callback);
+    std::unique_ptr<CDImage> memory_image =
+      CDImage::CreateMemoryImage(m_media.get(), callback, g_settings.cdrom_precache_compression);
     if (memory_image)
     {
       const CDImage::LBA lba = m_media->GetPositionOnDisc();
@@ -119,14 +136,29 @@ void CDROMAsyncReader::QueueReadSector(CDImage::LBA lba)
       return;
     }
 
-    // did we readahead to the correct sector?
-    const u32 next_buffer = (buffer_front + 1) % static_cast<u32>(m_buffers.size());
-    if (m_buffer_count > 1 && m_buffers[next_buffer].lba == lba)
+    // did we readahead to the correct sector? it's usually the very next slot, but a prefetched second
+    // extent can sit further along the ring, so scan the whole buffered region and discard skipped slots
+    for (u32 offset = 1; offset < buffer_count; offset++)
     {
+      const u32 next_buffer = (buffer_front + offset) % static_cast<u32>(m_buffers.size());
+      if (m_buffers[next_buffer].lba != lba)
+        continue;
+
       // great, don't need a seek, but still kick the thread to start reading ahead again
-      Log_DebugPrintf("Readahead buffer hit for sector %u", lba);
+      Log_DebugPrintf("Readahead buffer hit for sector %u (%u slots in)", lba, offset);
       m_buffer_front.store(next_buffer);
-      m_buffer_count.fetch_sub(1);
+      m_buffer_count.fetch_sub(offset);
+
+      // sustained streaming - keep widening the window so slow storage gets larger sequential runs
+      m_hit_streak++;
+      const u32 window = m_readahead_window.load(std::memory_order_relaxed);
+      if (m_hit_streak >= window && window < (static_cast<u32>(m_buffers.size()) / 2))
+      {
+        Log_DebugPrintf("Growing readahead window to %u sectors", window * 2);
+        m_readahead_window.store(window * 2, std::memory_order_relaxed);
+        m_hit_streak = 0;
+      }
+
       m_can_readahead.store(true);
       m_do_read_cv.notify_one();
       return;
@@ -136,11 +168,60 @@ void CDROMAsyncReader::QueueReadSector(CDImage::LBA lba)
   // we need to toss away our readahead and start fresh
   Log_DebugPrintf("Readahead buffer miss, queueing seek to %u", lba);
   std::unique_lock<std::mutex> lock(m_mutex);
+
+  // If this miss continues the extent the previous miss abandoned, the game is alternating between two
+  // streams, so tell the worker to pull the extent we're abandoning now back in behind the new window.
+  const CDImage::LBA resume_lba = (buffer_count > 0) ? (m_buffers[m_buffer_front.load()].lba + 1) : lba;
+  const u32 window = m_readahead_window.load(std::memory_order_relaxed);
+  const bool alternating = m_resume_lba_valid && lba >= m_resume_lba && (lba - m_resume_lba) < window;
+  if (alternating && buffer_count > 0)
+  {
+    Log_DebugPrintf("Alternating seek pattern detected, prefetching second extent at %u", resume_lba);
+    m_prefetch_position = resume_lba;
+    m_prefetch_position_set = true;
+  }
+  else if (!alternating)
+  {
+    // random access - drop the window back to the configured size
+    m_readahead_window.store(m_base_readahead_count, std::memory_order_relaxed);
+    m_hit_streak = 0;
+    m_prefetch_position_set = false;
+  }
+  m_resume_lba = resume_lba;
+  m_resume_lba_valid = (buffer_count > 0);
+
+  // the filesystem hint was for wherever we were before, so drop it until the consumer re-supplies it
+  m_extent_hint_valid = false;
+  m_next_extent_valid = false;
+
   m_next_position_set.store(true);
   m_next_position = lba;
   m_do_read_cv.notify_one();
 }
 
+void CDROMAsyncReader::SetExtentHint(CDImage::LBA extent_end_lba, CDImage::LBA next_extent_lba,
+                                     bool next_extent_valid)
+{
+  if (!IsUsingThread())
+    return;
+
+  std::unique_lock lock(m_mutex);
+  m_extent_end_lba = extent_end_lba;
+  m_next_extent_lba = next_extent_lba;
+  m_extent_hint_valid = true;
+  m_next_extent_valid = next_extent_valid;
+}
+
+void CDROMAsyncReader::ClearExtentHint()
+{
+  if (!IsUsingThread())
+    return;
+
+  std::unique_lock lock(m_mutex);
+  m_extent_hint_valid = false;
+  m_next_extent_valid = false;
+}
+
 bool CDROMAsyncReader::ReadSectorUncached(CDImage::LBA lba, CDImage::SubChannelQ* subq, SectorBuffer* data)
 {
   if (!IsUsingThread())
@@ -240,7 +321,11 @@ bool CDROMAsyncReader::ReadSectorIntoBuffer(std::unique_lock<std::mutex>& lock)
 
   Log_TracePrintf("Reading LBA %u...", buffer.lba);
 
-  buffer.result = m_media->ReadRawSector(buffer.data.data(), &buffer.subq);
+  // The buffer is published to the consumer on return, so this path needs inline completion.
+  DebugAssert(!m_media->SupportsDeferredAsyncReads());
+  m_media->ReadRawSectorAsync(
+    buffer.data.data(), &buffer.subq,
+    [](void* userdata, bool result) { static_cast<BufferSlot*>(userdata)->result = result; }, &buffer);
   if (buffer.result)
   {
     const double read_time = timer.GetTimeMilliseconds();
@@ -254,11 +339,47 @@ bool CDROMAsyncReader::ReadSectorIntoBuffer(std::unique_lock<std::mutex>& lock)
 
   lock.lock();
   m_is_reading.store(false);
+  m_next_readahead_lba = buffer.lba + 1;
   m_buffer_count.fetch_add(1);
   m_notify_read_complete_cv.notify_all();
   return true;
 }
 
+void CDROMAsyncReader::FillReadahead(std::unique_lock<std::mutex>& lock, u32 limit)
+{
+  while (m_buffer_count.load() < limit)
+  {
+    if (m_next_position_set.load())
+    {
+      // a seek request came in while we're reading, so bail out
+      break;
+    }
+
+    // prefetching the other extent (or a failed read) can leave the media somewhere else
+    if (m_media->GetPositionOnDisc() != m_next_readahead_lba)
+    {
+      const CDImage::LBA seek_location = m_next_readahead_lba;
+      m_is_reading.store(true);
+      lock.unlock();
+      const bool seek_result = m_media->Seek(seek_location);
+      lock.lock();
+      m_is_reading.store(false);
+      if (!seek_result)
+      {
+        Log_WarningPrintf("Readahead seek to LBA %u failed", seek_location);
+        m_notify_read_complete_cv.notify_all();
+        break;
+      }
+
+      continue;
+    }
+
+    // stop reading if we hit the end or get an error
+    if (!ReadSectorIntoBuffer(lock))
+      break;
+  }
+}
+
 void CDROMAsyncReader::ReadSectorNonThreaded(CDImage::LBA lba)
 {
   Common::Timer timer;
@@ -305,6 +426,8 @@ void CDROMAsyncReader::CancelReadahead()
 
   // prevent it from doing any more when it re-acquires the lock
   m_can_readahead.store(false);
+  m_prefetch_position_set = false;
+  m_resume_lba_valid = false;
   EmptyBuffers();
 }
 
@@ -353,25 +476,51 @@ void CDROMAsyncReader::WorkerThreadEntryPoint()
         }
 
         // go go read ahead!
+        m_next_readahead_lba = seek_location;
         m_can_readahead.store(true);
       }
 
       if (!m_can_readahead.load())
         break;
 
-      // readahead time! read as many sectors as we have space for
-      Log_DebugPrintf("Reading ahead %u sectors...", static_cast<u32>(m_buffers.size()) - m_buffer_count.load());
-      while (m_buffer_count.load() < static_cast<u32>(m_buffers.size()))
+      // readahead time! read as many sectors as the current window allows
+      const u32 cap = static_cast<u32>(m_buffers.size()) / 2;
+      const u32 window = std::min(m_readahead_window.load(std::memory_order_relaxed), cap);
+      u32 limit = window;
+      if (m_extent_hint_valid && m_next_readahead_lba <= m_extent_end_lba)
       {
-        if (m_next_position_set.load())
+        // the filesystem told us where the file being read ends, so run the readahead out to the end
+        // of the extent without waiting for the window to grow there. when the next file on disc is
+        // known, stop at the extent end so the gap before it isn't read
+        const u32 extent_limit =
+          std::min(m_buffer_count.load() + ((m_extent_end_lba - m_next_readahead_lba) + 1), cap);
+        limit = m_next_extent_valid ? extent_limit : std::max(window, extent_limit);
+      }
+      Log_DebugPrintf("Reading ahead up to %u sectors...", limit - std::min(limit, m_buffer_count.load()));
+      FillReadahead(lock, limit);
+
+      // if the extent ended short of the window, hop over the gap and carry on at the next file;
+      // loading sequences usually request directory-adjacent files back to back
+      if (m_extent_hint_valid && m_next_extent_valid && !m_next_position_set.load() &&
+          m_next_readahead_lba > m_extent_end_lba && m_next_readahead_lba <= m_next_extent_lba &&
+          m_buffer_count.load() < window)
+      {
+        if (m_next_readahead_lba < m_next_extent_lba)
         {
-          // a seek request came in while we're reading, so bail out
-          break;
+          Log_DebugPrintf("Extent finished, prefetching next file at LBA %u...", m_next_extent_lba);
+          m_next_readahead_lba = m_next_extent_lba;
         }
+        FillReadahead(lock, window);
+      }
 
-        // stop reading if we hit the end or get an error
-        if (!ReadSectorIntoBuffer(lock))
-          break;
+      // interleaved stream? pull the second extent in behind the window, so switching back doesn't
+      // have to wait for a fresh seek and read
+      if (m_prefetch_position_set && !m_next_position_set.load())
+      {
+        m_prefetch_position_set = false;
+        m_next_readahead_lba = m_prefetch_position;
+        Log_DebugPrintf("Prefetching second extent at LBA %u...", m_next_readahead_lba);
+        FillReadahead(lock, window + std::max<u32>(window / 2, 1));
       }
 
       // readahead buffer is full or errored at this point
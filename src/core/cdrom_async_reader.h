@@ -32,7 +32,17 @@ public:
   const CDImage::SubChannelQ& GetSectorSubQ() const { return m_buffers[m_buffer_front.load()].subq; }
   u32 GetBufferedSectorCount() const { return m_buffer_count.load(); }
   bool HasBufferedSectors() const { return (m_buffer_count.load() > 0); }
-  u32 GetReadaheadCount() const { return static_cast<u32>(m_buffers.size()); }
+
+  /// Peeks a completed readahead slot without consuming it. Offset 0 is the front (current)
+  /// sector. Returns nullptr if the offset isn't buffered yet, or while a seek is in flight.
+  /// Slots within the buffered count are stable until the consumer requests past them.
+  const BufferSlot* PeekBufferedSector(u32 offset) const
+  {
+    if (m_next_position_set.load() || offset >= m_buffer_count.load())
+      return nullptr;
+    return &m_buffers[(m_buffer_front.load() + offset) % static_cast<u32>(m_buffers.size())];
+  }
+  u32 GetReadaheadCount() const { return m_base_readahead_count; }
 
   bool HasMedia() const { return static_cast<bool>(m_media); }
   const CDImage* GetMedia() const { return m_media.get(); }
@@ -51,6 +61,12 @@ public:
 
   void QueueReadSector(CDImage::LBA lba);
 
+  /// Supplies filesystem knowledge for readahead: the end of the file extent the current request
+  /// falls in, and the start of the file which follows it on disc. The readahead runs out to the
+  /// end of the extent and then continues at the next file instead of into the gap between them.
+  void SetExtentHint(CDImage::LBA extent_end_lba, CDImage::LBA next_extent_lba, bool next_extent_valid);
+  void ClearExtentHint();
+
   bool WaitForReadToComplete();
   void WaitForIdle();
 
@@ -60,6 +76,7 @@ public:
 private:
   void EmptyBuffers();
   bool ReadSectorIntoBuffer(std::unique_lock<std::mutex>& lock);
+  void FillReadahead(std::unique_lock<std::mutex>& lock, u32 limit);
   void ReadSectorNonThreaded(CDImage::LBA lba);
   bool InternalReadSectorUncached(CDImage::LBA lba, CDImage::SubChannelQ* subq, SectorBuffer* data);
   void CancelReadahead();
@@ -85,4 +102,28 @@ private:
   std::atomic<u32> m_buffer_front{0};
   std::atomic<u32> m_buffer_back{0};
   std::atomic<u32> m_buffer_count{0};
+
+  // Adaptive readahead. The ring is allocated larger than the configured count so the window can grow during
+  // sustained streaming; the window/streak are only written by the consumer thread.
+  u32 m_base_readahead_count = 0;
+  u32 m_hit_streak = 0;
+  std::atomic<u32> m_readahead_window{0};
+
+  // Interleaved-stream detection, guarded by m_mutex. m_resume_lba is where the extent abandoned by the last
+  // seek would have continued; a seek back to it means the game is alternating between two extents.
+  CDImage::LBA m_resume_lba = 0;
+  bool m_resume_lba_valid = false;
+  CDImage::LBA m_prefetch_position = 0;
+  bool m_prefetch_position_set = false;
+
+  // Filesystem prefetch hint, guarded by m_mutex. Invalidated on any readahead miss; the consumer
+  // re-supplies it as the request stream moves between files.
+  CDImage::LBA m_extent_end_lba = 0;
+  CDImage::LBA m_next_extent_lba = 0;
+  bool m_extent_hint_valid = false;
+  bool m_next_extent_valid = false;
+
+  // Next LBA the readahead should append, so prefetching the second extent doesn't derail the first. Only
+  // touched by the worker thread.
+  CDImage::LBA m_next_readahead_lba = 0;
 };
@@ -4,8 +4,10 @@
 #include "cheats.h"
 #include "bus.h"
 #include "common/assert.h"
+#include "common/bitutils.h"
 #include "common/byte_stream.h"
 #include "common/file_system.h"
+#include "common/intrin.h"
 #include "common/log.h"
 #include "common/small_string.h"
 #include "common/string_util.h"
@@ -14,7 +16,9 @@
 #include "cpu_core.h"
 #include "host.h"
 #include "system.h"
+#include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <type_traits>
@@ -311,6 +315,7 @@ bool CheatList::LoadFromPCSXRString(const std::string& str)
     m_codes.push_back(std::move(current_code));
   }
 
+  m_program_dirty = true;
   Log_InfoPrintf("Loaded %zu cheats (PCSXR format)", m_codes.size());
   return !m_codes.empty();
 }
@@ -414,6 +419,7 @@ bool CheatList::LoadFromLibretroString(const std::string& str)
       m_codes.push_back(std::move(cc));
   }
 
+  m_program_dirty = true;
   Log_InfoPrintf("Loaded %zu cheats (libretro format)", m_codes.size());
   return !m_codes.empty();
 }
@@ -501,6 +507,7 @@ bool CheatList::LoadFromEPSXeString(const std::string& str)
   if (current_code.Valid())
     m_codes.push_back(std::move(current_code));
 
+  m_program_dirty = true;
   Log_InfoPrintf("Loaded %zu cheats (EPSXe format)", m_codes.size());
   return !m_codes.empty();
 }
@@ -551,21 +558,219 @@ bool CheatList::ParseLibretroCheat(CheatCode* cc, const char* line)
   return !cc->instructions.empty();
 }
 
+bool CheatList::CompileCode(const CheatCode& cc, std::vector<CompiledOp>* ops)
+{
+  for (const CheatCode::Instruction& inst : cc.instructions)
+  {
+    CompiledOp op;
+    op.address = inst.address;
+    switch (inst.code)
+    {
+      case CheatCode::InstructionCode::Nop:
+        continue;
+
+      case CheatCode::InstructionCode::ConstantWrite8:
+        op.operation = CompiledOp::Operation::Write8;
+        op.value = ZeroExtend32(inst.value8.GetValue());
+        break;
+
+      case CheatCode::InstructionCode::ConstantWrite16:
+        op.operation = CompiledOp::Operation::Write16;
+        op.value = ZeroExtend32(inst.value16.GetValue());
+        break;
+
+      case CheatCode::InstructionCode::ExtConstantWrite32:
+        op.operation = CompiledOp::Operation::Write32;
+        op.value = inst.value32;
+        break;
+
+      case CheatCode::InstructionCode::ScratchpadWrite16:
+        op.operation = CompiledOp::Operation::Write16;
+        op.address = CPU::SCRATCHPAD_ADDR | (inst.address & CPU::SCRATCHPAD_OFFSET_MASK);
+        op.value = ZeroExtend32(inst.value16.GetValue());
+        break;
+
+      case CheatCode::InstructionCode::ExtScratchpadWrite32:
+        op.operation = CompiledOp::Operation::Write32;
+        op.address = CPU::SCRATCHPAD_ADDR | (inst.address & CPU::SCRATCHPAD_OFFSET_MASK);
+        op.value = inst.value32;
+        break;
+
+      case CheatCode::InstructionCode::ExtConstantBitSet8:
+        op.operation = CompiledOp::Operation::BitSet8;
+        op.value = ZeroExtend32(inst.value8.GetValue());
+        break;
+
+      case CheatCode::InstructionCode::ExtConstantBitSet16:
+        op.operation = CompiledOp::Operation::BitSet16;
+        op.value = ZeroExtend32(inst.value16.GetValue());
+        break;
+
+      case CheatCode::InstructionCode::ExtConstantBitSet32:
+        op.operation = CompiledOp::Operation::BitSet32;
+        op.value = inst.value32;
+        break;
+
+      case CheatCode::InstructionCode::ExtConstantBitClear8:
+        op.operation = CompiledOp::Operation::BitClear8;
+        op.value = ZeroExtend32(inst.value8.GetValue());
+        break;
+
+      case CheatCode::InstructionCode::ExtConstantBitClear16:
+        op.operation = CompiledOp::Operation::BitClear16;
+        op.value = ZeroExtend32(inst.value16.GetValue());
+        break;
+
+      case CheatCode::InstructionCode::ExtConstantBitClear32:
+        op.operation = CompiledOp::Operation::BitClear32;
+        op.value = inst.value32;
+        break;
+
+      case CheatCode::InstructionCode::Increment8:
+        op.operation = CompiledOp::Operation::Add8;
+        op.value = ZeroExtend32(inst.value8.GetValue());
+        break;
+
+      case CheatCode::InstructionCode::Increment16:
+        op.operation = CompiledOp::Operation::Add16;
+        op.value = ZeroExtend32(inst.value16.GetValue());
+        break;
+
+      case CheatCode::InstructionCode::ExtIncrement32:
+        op.operation = CompiledOp::Operation::Add32;
+        op.value = inst.value32;
+        break;
+
+      case CheatCode::InstructionCode::Decrement8:
+        op.operation = CompiledOp::Operation::Subtract8;
+        op.value = ZeroExtend32(inst.value8.GetValue());
+        break;
+
+      case CheatCode::InstructionCode::Decrement16:
+        op.operation = CompiledOp::Operation::Subtract16;
+        op.value = ZeroExtend32(inst.value16.GetValue());
+        break;
+
+      case CheatCode::InstructionCode::ExtDecrement32:
+        op.operation = CompiledOp::Operation::Subtract32;
+        op.value = inst.value32;
+        break;
+
+      default:
+        // Conditional or stateful instruction, leave the whole code to the interpreter.
+        return false;
+    }
+
+    ops->push_back(op);
+  }
+
+  return true;
+}
+
+void CheatList::CompileActiveCodes()
+{
+  m_compiled_ops.clear();
+  m_program.clear();
+
+  const u32 count = static_cast<u32>(m_codes.size());
+  for (u32 i = 0; i < count; i++)
+  {
+    const CheatCode& cc = m_codes[i];
+    if (!cc.enabled)
+      continue;
+
+    ProgramEntry entry = {i, static_cast<u32>(m_compiled_ops.size()), 0};
+    if (CompileCode(cc, &m_compiled_ops))
+      entry.num_ops = static_cast<u32>(m_compiled_ops.size()) - entry.first_op;
+    else
+      m_compiled_ops.resize(entry.first_op);
+
+    m_program.push_back(entry);
+  }
+
+  m_program_dirty = false;
+}
+
 void CheatList::Apply()
 {
   if (!m_master_enable)
     return;
 
-  for (const CheatCode& code : m_codes)
+  if (m_program_dirty)
+    CompileActiveCodes();
+
+  for (const ProgramEntry& entry : m_program)
   {
-    if (code.enabled)
-      code.Apply();
+    if (entry.num_ops == 0)
+    {
+      m_codes[entry.code_index].Apply();
+      continue;
+    }
+
+    const CompiledOp* op = m_compiled_ops.data() + entry.first_op;
+    const CompiledOp* const end = op + entry.num_ops;
+    for (; op != end; op++)
+    {
+      switch (op->operation)
+      {
+        case CompiledOp::Operation::Write8:
+          DoMemoryWrite<u8>(op->address, Truncate8(op->value));
+          break;
+        case CompiledOp::Operation::Write16:
+          DoMemoryWrite<u16>(op->address, Truncate16(op->value));
+          break;
+        case CompiledOp::Operation::Write32:
+          DoMemoryWrite<u32>(op->address, op->value);
+          break;
+        case CompiledOp::Operation::BitSet8:
+          DoMemoryWrite<u8>(op->address, DoMemoryRead<u8>(op->address) | Truncate8(op->value));
+          break;
+        case CompiledOp::Operation::BitSet16:
+          DoMemoryWrite<u16>(op->address, DoMemoryRead<u16>(op->address) | Truncate16(op->value));
+          break;
+        case CompiledOp::Operation::BitSet32:
+          DoMemoryWrite<u32>(op->address, DoMemoryRead<u32>(op->address) | op->value);
+          break;
+        case CompiledOp::Operation::BitClear8:
+          DoMemoryWrite<u8>(op->address, DoMemoryRead<u8>(op->address) & ~Truncate8(op->value));
+          break;
+        case CompiledOp::Operation::BitClear16:
+          DoMemoryWrite<u16>(op->address, DoMemoryRead<u16>(op->address) & ~Truncate16(op->value));
+          break;
+        case CompiledOp::Operation::BitClear32:
+          DoMemoryWrite<u32>(op->address, DoMemoryRead<u32>(op->address) & ~op->value);
+          break;
+        case CompiledOp::Operation::Add8:
+          DoMemoryWrite<u8>(op->address, DoMemoryRead<u8>(op->address) + Truncate8(op->value));
+          break;
+        case CompiledOp::Operation::Add16:
+          DoMemoryWrite<u16>(op->address, DoMemoryRead<u16>(op->address) + Truncate16(op->value));
+          break;
+        case CompiledOp::Operation::Add32:
+          DoMemoryWrite<u32>(op->address, DoMemoryRead<u32>(op->address) + op->value);
+          break;
+        case CompiledOp::Operation::Subtract8:
+          DoMemoryWrite<u8>(op->address, DoMemoryRead<u8>(op->address) - Truncate8(op->value));
+          break;
+        case CompiledOp::Operation::Subtract16:
+          DoMemoryWrite<u16>(op->address, DoMemoryRead<u16>(op->address) - Truncate16(op->value));
+          break;
+        case CompiledOp::Operation::Subtract32:
+          DoMemoryWrite<u32>(op->address, DoMemoryRead<u32>(op->address) - op->value);
+          break;
+
+        default:
+          UnreachableCode();
+          break;
+      }
+    }
   }
 }
 
 void CheatList::AddCode(CheatCode cc)
 {
   m_codes.push_back(std::move(cc));
+  m_program_dirty = true;
 }
 
 void CheatList::SetCode(u32 index, CheatCode cc)
@@ -573,6 +778,8 @@ void CheatList::SetCode(u32 index, CheatCode cc)
   if (index > m_codes.size())
     return;
 
+  m_program_dirty = true;
+
   if (index == m_codes.size())
   {
     m_codes.push_back(std::move(cc));
@@ -585,6 +792,7 @@ void CheatList::SetCode(u32 index, CheatCode cc)
 void CheatList::RemoveCode(u32 i)
 {
   m_codes.erase(m_codes.begin() + i);
+  m_program_dirty = true;
 }
 
 std::optional<CheatList::Format> CheatList::DetectFileFormat(const char* filename)
@@ -791,6 +999,7 @@ bool CheatList::LoadFromPackage(const std::string& serial)
     if (current_code.Valid())
       m_codes.push_back(std::move(current_code));
 
+    m_program_dirty = true;
     Log_InfoPrintf("Loaded %zu codes from package for %s", m_codes.size(), serial.c_str());
     return !m_codes.empty();
   }
@@ -831,6 +1040,7 @@ void CheatList::SetCodeEnabled(u32 index, bool state)
     return;
 
   m_codes[index].enabled = state;
+  m_program_dirty = true;
   if (!state)
     m_codes[index].ApplyOnDisable();
 }
@@ -2815,6 +3025,250 @@ std::optional<CheatCode::Activation> CheatCode::ParseActivationName(const char*
   return std::nullopt;
 }
 
+// ------------------------------------------------------------------------
+// Vectorized search kernels
+// ------------------------------------------------------------------------
+// These run directly over RAM, comparing 16 bytes per iteration on SSE2/NEON hosts, and set one
+// bit per matching element in a bitmap. Matches are materialized into Result entries afterwards,
+// so non-matching addresses never construct a Result or go through Filter().
+
+namespace {
+enum class VectorCompareOp : u8
+{
+  Equal,
+  NotEqual,
+  Greater,
+  GreaterEqual,
+  Less,
+  LessEqual,
+};
+} // namespace
+
+template<typename T>
+ALWAYS_INLINE static bool ScalarCompare(T lhs, T rhs, bool is_signed, VectorCompareOp op)
+{
+  using S = std::make_signed_t<T>;
+  switch (op)
+  {
+    case VectorCompareOp::Equal:
+      return (lhs == rhs);
+    case VectorCompareOp::NotEqual:
+      return (lhs != rhs);
+    case VectorCompareOp::Greater:
+      return is_signed ? (static_cast<S>(lhs) > static_cast<S>(rhs)) : (lhs > rhs);
+    case VectorCompareOp::GreaterEqual:
+      return is_signed ? (static_cast<S>(lhs) >= static_cast<S>(rhs)) : (lhs >= rhs);
+    case VectorCompareOp::Less:
+      return is_signed ? (static_cast<S>(lhs) < static_cast<S>(rhs)) : (lhs < rhs);
+    case VectorCompareOp::LessEqual:
+      return is_signed ? (static_cast<S>(lhs) <= static_cast<S>(rhs)) : (lhs <= rhs);
+    default:
+      return false;
+  }
+}
+
+#ifdef CPU_ARCH_SSE
+
+/// Compares (16 / sizeof(T)) elements at mem against value, returning one bit per match.
+template<typename T>
+ALWAYS_INLINE_RELEASE static u32 VectorCompareChunk(const u8* mem, T value, bool is_signed, VectorCompareOp op)
+{
+  __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mem));
+  __m128i rhs;
+  if constexpr (sizeof(T) == 1)
+    rhs = _mm_set1_epi8(static_cast<char>(value));
+  else if constexpr (sizeof(T) == 2)
+    rhs = _mm_set1_epi16(static_cast<short>(value));
+  else
+    rhs = _mm_set1_epi32(static_cast<int>(value));
+
+  // SSE2 only has signed ordering compares; bias both sides for unsigned.
+  const bool is_ordering = (op != VectorCompareOp::Equal && op != VectorCompareOp::NotEqual);
+  if (is_ordering && !is_signed)
+  {
+    __m128i bias;
+    if constexpr (sizeof(T) == 1)
+      bias = _mm_set1_epi8(static_cast<char>(0x80));
+    else if constexpr (sizeof(T) == 2)
+      bias = _mm_set1_epi16(static_cast<short>(0x8000));
+    else
+      bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    lhs = _mm_xor_si128(lhs, bias);
+    rhs = _mm_xor_si128(rhs, bias);
+  }
+
+  const auto compare_equal = [](const __m128i& a, const __m128i& b) {
+    if constexpr (sizeof(T) == 1)
+      return _mm_cmpeq_epi8(a, b);
+    else if constexpr (sizeof(T) == 2)
+      return _mm_cmpeq_epi16(a, b);
+    else
+      return _mm_cmpeq_epi32(a, b);
+  };
+  const auto compare_greater = [](const __m128i& a, const __m128i& b) {
+    if constexpr (sizeof(T) == 1)
+      return _mm_cmpgt_epi8(a, b);
+    else if constexpr (sizeof(T) == 2)
+      return _mm_cmpgt_epi16(a, b);
+    else
+      return _mm_cmpgt_epi32(a, b);
+  };
+
+  // GreaterEqual/LessEqual are computed as the inverse of Less/Greater.
+  __m128i cmp;
+  bool invert = false;
+  switch (op)
+  {
+    case VectorCompareOp::Equal:
+      cmp = compare_equal(lhs, rhs);
+      break;
+    case VectorCompareOp::NotEqual:
+      cmp = compare_equal(lhs, rhs);
+      invert = true;
+      break;
+    case VectorCompareOp::Greater:
+      cmp = compare_greater(lhs, rhs);
+      break;
+    case VectorCompareOp::GreaterEqual:
+      cmp = compare_greater(rhs, lhs);
+      invert = true;
+      break;
+    case VectorCompareOp::Less:
+      cmp = compare_greater(rhs, lhs);
+      break;
+    case VectorCompareOp::LessEqual:
+    default:
+      cmp = compare_greater(lhs, rhs);
+      invert = true;
+      break;
+  }
+
+  u32 mask;
+  if constexpr (sizeof(T) == 1)
+  {
+    mask = static_cast<u32>(_mm_movemask_epi8(cmp));
+  }
+  else if constexpr (sizeof(T) == 2)
+  {
+    mask = static_cast<u32>(_mm_movemask_epi8(_mm_packs_epi16(cmp, _mm_setzero_si128()))) & 0xFFu;
+  }
+  else
+  {
+    mask = static_cast<u32>(
+             _mm_movemask_epi8(_mm_packs_epi16(_mm_packs_epi32(cmp, _mm_setzero_si128()), _mm_setzero_si128()))) &
+           0xFu;
+  }
+
+  if (invert)
+    mask ^= ((1u << (16 / sizeof(T))) - 1u);
+  return mask;
+}
+
+#elif defined(CPU_ARCH_NEON)
+
+/// Compares (16 / sizeof(T)) elements at mem against value, returning one bit per match.
+template<typename T>
+ALWAYS_INLINE_RELEASE static u32 VectorCompareChunk(const u8* mem, T value, bool is_signed, VectorCompareOp op)
+{
+  // GreaterEqual/LessEqual are computed as the inverse of Less/Greater.
+  bool invert = false;
+  VectorCompareOp cop = op;
+  if (op == VectorCompareOp::NotEqual)
+  {
+    cop = VectorCompareOp::Equal;
+    invert = true;
+  }
+  else if (op == VectorCompareOp::GreaterEqual)
+  {
+    cop = VectorCompareOp::Less;
+    invert = true;
+  }
+  else if (op == VectorCompareOp::LessEqual)
+  {
+    cop = VectorCompareOp::Greater;
+    invert = true;
+  }
+
+  u32 mask;
+  if constexpr (sizeof(T) == 1)
+  {
+    const uint8x16_t lhs = vld1q_u8(mem);
+    const uint8x16_t rhs = vdupq_n_u8(value);
+    uint8x16_t cmp;
+    if (cop == VectorCompareOp::Equal)
+      cmp = vceqq_u8(lhs, rhs);
+    else if (cop == VectorCompareOp::Greater)
+      cmp = is_signed ? vcgtq_s8(vreinterpretq_s8_u8(lhs), vreinterpretq_s8_u8(rhs)) : vcgtq_u8(lhs, rhs);
+    else
+      cmp = is_signed ? vcgtq_s8(vreinterpretq_s8_u8(rhs), vreinterpretq_s8_u8(lhs)) : vcgtq_u8(rhs, lhs);
+
+    const uint8x8_t bits = vcreate_u8(UINT64_C(0x8040201008040201));
+    mask = vaddv_u8(vand_u8(vget_low_u8(cmp), bits)) |
+           (static_cast<u32>(vaddv_u8(vand_u8(vget_high_u8(cmp), bits))) << 8);
+  }
+  else if constexpr (sizeof(T) == 2)
+  {
+    const uint16x8_t lhs = vreinterpretq_u16_u8(vld1q_u8(mem));
+    const uint16x8_t rhs = vdupq_n_u16(value);
+    uint16x8_t cmp;
+    if (cop == VectorCompareOp::Equal)
+      cmp = vceqq_u16(lhs, rhs);
+    else if (cop == VectorCompareOp::Greater)
+      cmp = is_signed ? vcgtq_s16(vreinterpretq_s16_u16(lhs), vreinterpretq_s16_u16(rhs)) : vcgtq_u16(lhs, rhs);
+    else
+      cmp = is_signed ? vcgtq_s16(vreinterpretq_s16_u16(rhs), vreinterpretq_s16_u16(lhs)) : vcgtq_u16(rhs, lhs);
+
+    const uint8x8_t bits = vcreate_u8(UINT64_C(0x8040201008040201));
+    mask = vaddv_u8(vand_u8(vmovn_u16(cmp), bits));
+  }
+  else
+  {
+    const uint32x4_t lhs = vreinterpretq_u32_u8(vld1q_u8(mem));
+    const uint32x4_t rhs = vdupq_n_u32(value);
+    uint32x4_t cmp;
+    if (cop == VectorCompareOp::Equal)
+      cmp = vceqq_u32(lhs, rhs);
+    else if (cop == VectorCompareOp::Greater)
+      cmp = is_signed ? vcgtq_s32(vreinterpretq_s32_u32(lhs), vreinterpretq_s32_u32(rhs)) : vcgtq_u32(lhs, rhs);
+    else
+      cmp = is_signed ? vcgtq_s32(vreinterpretq_s32_u32(rhs), vreinterpretq_s32_u32(lhs)) : vcgtq_u32(rhs, lhs);
+
+    const uint16x4_t bits = vcreate_u16(UINT64_C(0x0008000400020001));
+    mask = vaddv_u16(vand_u16(vmovn_u32(cmp), bits));
+  }
+
+  if (invert)
+    mask ^= ((1u << (16 / sizeof(T))) - 1u);
+  return mask;
+}
+
+#endif
+
+/// Compares count elements at mem against value, setting one bit per match in bitmap.
+template<typename T>
+static void VectorCompareRange(const u8* mem, u32 count, T value, bool is_signed, VectorCompareOp op, u64* bitmap)
+{
+  u32 i = 0;
+
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+  // Elements per vector is 16, 8 or 4, so chunks never straddle a bitmap word.
+  constexpr u32 ELEMENTS_PER_VECTOR = 16 / sizeof(T);
+  for (; (i + ELEMENTS_PER_VECTOR) <= count; i += ELEMENTS_PER_VECTOR)
+  {
+    const u32 mask = VectorCompareChunk<T>(mem + (i * sizeof(T)), value, is_signed, op);
+    bitmap[i / 64] |= (static_cast<u64>(mask) << (i % 64));
+  }
+#endif
+
+  for (; i < count; i++)
+  {
+    T mval;
+    std::memcpy(&mval, mem + (i * sizeof(T)), sizeof(mval));
+    if (ScalarCompare(mval, value, is_signed, op))
+      bitmap[i / 64] |= (static_cast<u64>(1) << (i % 64));
+  }
+}
+
 MemoryScan::MemoryScan() = default;
 
 MemoryScan::~MemoryScan() = default;
@@ -2828,6 +3282,9 @@ void MemoryScan::Search()
 {
   m_results.clear();
 
+  if (SearchVectorized())
+    return;
+
   switch (m_size)
   {
     case MemoryAccessSize::Byte:
@@ -2847,6 +3304,136 @@ void MemoryScan::Search()
   }
 }
 
+bool MemoryScan::SearchVectorized()
+{
+  VectorCompareOp op;
+  switch (m_operator)
+  {
+    case Operator::Equal:
+      op = VectorCompareOp::Equal;
+      break;
+    case Operator::NotEqual:
+      op = VectorCompareOp::NotEqual;
+      break;
+    case Operator::GreaterThan:
+      op = VectorCompareOp::Greater;
+      break;
+    case Operator::GreaterEqual:
+      op = VectorCompareOp::GreaterEqual;
+      break;
+    case Operator::LessThan:
+      op = VectorCompareOp::Less;
+      break;
+    case Operator::LessEqual:
+      op = VectorCompareOp::LessEqual;
+      break;
+    case Operator::Any:
+      op = VectorCompareOp::Equal; // unused, every element matches
+      break;
+    default:
+      // Last-value operators are degenerate on the initial search, take the scalar path.
+      return false;
+  }
+
+  if (m_start_address >= m_end_address)
+    return true;
+
+  // The whole range must be plain RAM without crossing a mirror boundary, so the kernel can walk
+  // it with a flat pointer. Scratchpad/BIOS scans take the scalar path.
+  const PhysicalMemoryAddress start_phys = m_start_address & CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
+  const u32 length = m_end_address - m_start_address;
+  if ((start_phys + length) > Bus::RAM_MIRROR_END)
+    return false;
+  const u32 ram_offset = start_phys & Bus::g_ram_mask;
+  if ((ram_offset + length) > Bus::g_ram_size)
+    return false;
+
+  // The kernel compares at the scan width; if the comparison value doesn't fit, results would
+  // differ from Filter(), which compares sign/zero-extended 32-bit values.
+  if (m_operator != Operator::Any)
+  {
+    if (m_size == MemoryAccessSize::Byte &&
+        (m_signed ? (static_cast<s32>(m_value) < -128 || static_cast<s32>(m_value) > 127) : (m_value > 0xFFu)))
+    {
+      return false;
+    }
+    if (m_size == MemoryAccessSize::HalfWord &&
+        (m_signed ? (static_cast<s32>(m_value) < -32768 || static_cast<s32>(m_value) > 32767) : (m_value > 0xFFFFu)))
+    {
+      return false;
+    }
+  }
+
+  const u32 element_size = (m_size == MemoryAccessSize::Byte) ? 1 : ((m_size == MemoryAccessSize::HalfWord) ? 2 : 4);
+  const u8* mem = Bus::g_ram + ram_offset;
+  const u32 count = length / element_size;
+  if (count == 0)
+    return true;
+
+  // One bit per scanned element; matches are materialized into results afterwards.
+  std::vector<u64> bitmap((count + 63) / 64, 0);
+  if (m_operator == Operator::Any)
+  {
+    std::fill(bitmap.begin(), bitmap.end(), ~static_cast<u64>(0));
+  }
+  else
+  {
+    switch (m_size)
+    {
+      case MemoryAccessSize::Byte:
+        VectorCompareRange<u8>(mem, count, Truncate8(m_value), m_signed, op, bitmap.data());
+        break;
+      case MemoryAccessSize::HalfWord:
+        VectorCompareRange<u16>(mem, count, Truncate16(m_value), m_signed, op, bitmap.data());
+        break;
+      case MemoryAccessSize::Word:
+        VectorCompareRange<u32>(mem, count, m_value, m_signed, op, bitmap.data());
+        break;
+      default:
+        return false;
+    }
+  }
+
+  for (u32 word = 0; word < static_cast<u32>(bitmap.size()); word++)
+  {
+    u64 bits = bitmap[word];
+    while (bits != 0)
+    {
+      const u32 index = (word * 64) + CountTrailingZeros(bits);
+      bits &= (bits - 1);
+      if (index >= count)
+        break;
+
+      u32 value;
+      if (m_size == MemoryAccessSize::Byte)
+      {
+        u8 bvalue;
+        std::memcpy(&bvalue, mem + index, sizeof(bvalue));
+        value = m_signed ? SignExtend32(bvalue) : ZeroExtend32(bvalue);
+      }
+      else if (m_size == MemoryAccessSize::HalfWord)
+      {
+        u16 bvalue;
+        std::memcpy(&bvalue, mem + (index * 2), sizeof(bvalue));
+        value = m_signed ? SignExtend32(bvalue) : ZeroExtend32(bvalue);
+      }
+      else
+      {
+        std::memcpy(&value, mem + (index * 4), sizeof(value));
+      }
+
+      Result res;
+      res.address = m_start_address + (index * element_size);
+      res.value = value;
+      res.last_value = value;
+      res.value_changed = false;
+      m_results.push_back(res);
+    }
+  }
+
+  return true;
+}
+
 void MemoryScan::SearchBytes()
 {
   for (PhysicalMemoryAddress address = m_start_address; address < m_end_address; address++)
@@ -151,7 +151,14 @@ public:
   ~CheatList();
 
   ALWAYS_INLINE const CheatCode& GetCode(u32 i) const { return m_codes[i]; }
-  ALWAYS_INLINE CheatCode& GetCode(u32 i) { return m_codes[i]; }
+
+  // The mutable accessor assumes the caller is going to change the code, and forces a rebuild of
+  // the compiled program on the next Apply().
+  ALWAYS_INLINE CheatCode& GetCode(u32 i)
+  {
+    m_program_dirty = true;
+    return m_codes[i];
+  }
   ALWAYS_INLINE u32 GetCodeCount() const { return static_cast<u32>(m_codes.size()); }
   ALWAYS_INLINE bool IsCodeEnabled(u32 index) const { return m_codes[index].enabled; }
 
@@ -195,8 +202,52 @@ public:
   void MergeList(const CheatList& cl);
 
 private:
+  // Codes made up entirely of simple unconditional operations are pre-resolved into a flat list
+  // of CompiledOps once, and re-executed by a tight loop in Apply(). Anything conditional or
+  // stateful keeps using the interpreter. Address and value are already extracted/resolved.
+  struct CompiledOp
+  {
+    enum class Operation : u8
+    {
+      Write8,
+      Write16,
+      Write32,
+      BitSet8,
+      BitSet16,
+      BitSet32,
+      BitClear8,
+      BitClear16,
+      BitClear32,
+      Add8,
+      Add16,
+      Add32,
+      Subtract8,
+      Subtract16,
+      Subtract32,
+    };
+
+    Operation operation;
+    u32 address;
+    u32 value;
+  };
+
+  // One entry per enabled code, in list order, so cross-code ordering is preserved. Entries with
+  // num_ops == 0 are codes the compiler rejected, and are interpreted in place.
+  struct ProgramEntry
+  {
+    u32 code_index;
+    u32 first_op;
+    u32 num_ops;
+  };
+
+  static bool CompileCode(const CheatCode& cc, std::vector<CompiledOp>* ops);
+  void CompileActiveCodes();
+
   std::vector<CheatCode> m_codes;
+  std::vector<CompiledOp> m_compiled_ops;
+  std::vector<ProgramEntry> m_program;
   bool m_master_enable = true;
+  bool m_program_dirty = true;
 };
 
 class MemoryScan
@@ -263,6 +314,11 @@ public:
   void SetResultValue(u32 index, u32 value);
 
 private:
+  /// Fast path for the initial search: vectorized compare kernel directly over RAM, collecting
+  /// matches in a bitmap before materializing results. Returns false when the operator, value or
+  /// address range requires the scalar fallback.
+  bool SearchVectorized();
+
   void SearchBytes();
   void SearchHalfwords();
   void SearchWords();
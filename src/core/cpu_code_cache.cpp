@@ -7,6 +7,7 @@
 #include "cpu_core_private.h"
 #include "cpu_disasm.h"
 #include "cpu_recompiler_types.h"
+#include "perf_stats.h"
 #include "host.h"
 #include "settings.h"
 #include "system.h"
@@ -14,9 +15,16 @@
 
 #include "common/assert.h"
 #include "common/error.h"
+#include "common/file_system.h"
 #include "common/intrin.h"
+#include "common/thirdparty/SmallVector.h"
 #include "common/log.h"
 #include "common/memmap.h"
+#include "common/path.h"
+#include "common/perf_trace.h"
+#include "common/threading.h"
+
+#include "fmt/format.h"
 
 Log_SetChannel(CPU::CodeCache);
 
@@ -28,8 +36,12 @@ Log_SetChannel(CPU::CodeCache);
 #include "cpu_newrec_compiler.h"
 #endif
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <limits>
 #include <map>
-#include <unordered_set>
+#include <mutex>
 #include <zlib.h>
 
 namespace CPU::CodeCache {
@@ -37,7 +49,10 @@ namespace CPU::CodeCache {
 using LUTRangeList = std::array<std::pair<VirtualMemoryAddress, VirtualMemoryAddress>, 9>;
 using PageProtectionArray = std::array<PageProtectionInfo, Bus::RAM_8MB_CODE_PAGE_COUNT>;
 using BlockInstructionInfoPair = std::pair<Instruction, InstructionInfo>;
-using BlockInstructionList = std::vector<BlockInstructionInfoPair>;
+
+// Inline storage covers the common block sizes; only long traces spill to the heap, and the list
+// is a reused static so even those spill at most once.
+using BlockInstructionList = llvm::SmallVector<BlockInstructionInfoPair, 32>;
 
 // Switch to manual protection if we invalidate more than 4 times within 60 frames.
 // Fall blocks back to interpreter if we recompile more than 3 times within 15 frames.
@@ -48,6 +63,13 @@ static constexpr u32 RECOMPILE_FRAMES_FOR_INTERPRETER_FALLBACK = 15;
 static constexpr u32 INVALIDATE_COUNT_FOR_MANUAL_PROTECTION = 4;
 static constexpr u32 INVALIDATE_FRAMES_FOR_MANUAL_PROTECTION = 60;
 
+// Upper bound on trace (superblock) length; traces also end at any conditional or indirect branch.
+static constexpr u32 MAX_TRACE_INSTRUCTIONS = 128;
+
+// With tiered execution, interpret blocks this many times before handing them to the recompiler.
+// One-shot blocks in menus/loaders never make it past the interpreter, keeping code buffer pressure down.
+static constexpr u32 COLD_BLOCK_PROMOTION_THRESHOLD = 16;
+
 static CodeLUT DecodeCodeLUTPointer(u32 slot, CodeLUT ptr);
 static CodeLUT EncodeCodeLUTPointer(u32 slot, CodeLUT ptr);
 static CodeLUT OffsetCodeLUTPointer(CodeLUT fake_ptr, u32 pc);
@@ -66,11 +88,13 @@ static bool RevalidateBlock(Block* block);
 PageProtectionMode GetProtectionModeForPC(u32 pc);
 PageProtectionMode GetProtectionModeForBlock(const Block* block);
 static bool ReadBlockInstructions(u32 start_pc, BlockInstructionList* instructions, BlockMetadata* metadata);
+static bool IsIdleLoopBlock(const BlockInstructionList& instructions, u32 start_pc);
 static void FillBlockRegInfo(Block* block);
 static void CopyRegInfo(InstructionInfo* dst, const InstructionInfo* src);
 static void SetRegAccess(InstructionInfo* inst, Reg reg, bool write);
 static void AddBlockToPageList(Block* block);
 static void RemoveBlockFromPageList(Block* block);
+static u16 GetBlockChunkMask(const Block* block);
 
 static Common::PageFaultHandler::HandlerResult ExceptionHandler(void* exception_pc, void* fault_address, bool is_write);
 
@@ -91,22 +115,83 @@ static std::vector<Block*> s_blocks;
 // for compiling - reuse to avoid allocations
 static BlockInstructionList s_block_instructions;
 
+// Scratch arena for compilation-temporary containers (register-cache bookkeeping, speculative
+// constants, etc.). Reset at the start of each block compile.
+static ScratchArena s_scratch_arena(128 * 1024);
+
 #ifdef ENABLE_RECOMPILER_SUPPORT
 
 static void BacklinkBlocks(u32 pc, const void* dst);
+static void BeginBacklinkBatch();
+static void EndBacklinkBatch();
+static void FlushBacklinkedCode();
 static void UnlinkBlockExits(Block* block);
 
 static void ClearASMFunctions();
 static void CompileASMFunctions();
 static bool CompileBlock(Block* block);
+static void InterpretSingleBlock(Block* block);
+static bool InterpretColdBlock(Block* block);
+static bool ExecuteIdleLoopBlock(Block* block);
+
+static bool IsUsingAsyncCompilation();
+static void StartCompileThread();
+static void StopCompileThread();
+static void CompileThreadEntryPoint();
+static void EnqueueBlockCompilation(Block* block);
+static void CancelBlockCompilation(Block* block);
+static void PublishCompiledBlocks();
+
+static void TouchCodeSegment(const void* host_code);
+static bool EvictColdestCodeSegment();
+
+static u32 GetPersistentCacheCodeGenKey();
+static std::string GetPersistentCacheFilename();
+static void LoadPersistentBlockCache();
+static void SavePersistentBlockCache();
+static bool IsPendingPersistentBlock(u32 pc);
+static void PrecompilePersistentBlocks(u32 requested_pc);
 static Common::PageFaultHandler::HandlerResult HandleFastmemException(void* exception_pc, void* fault_address,
                                                                       bool is_write);
 static void BackpatchLoadStore(void* host_pc, const LoadstoreBackpatchInfo& info);
 static void RemoveBackpatchInfoForRange(const void* host_code, u32 size);
 
 static BlockLinkMap s_block_links;
+
+// Backlinked stubs are rewritten with the flush deferred, and the patched range is flushed from the
+// instruction cache in one go. Mass invalidations open a batch around their block loop, so a storm
+// of repatched exits (overlay loads rewriting half of RAM) costs a single flush instead of one per
+// stub.
+static u32 s_backlink_batch_depth = 0;
+static u8* s_backlink_flush_start = nullptr;
+static u8* s_backlink_flush_end = nullptr;
+
 static std::map<const void*, LoadstoreBackpatchInfo> s_fastmem_backpatch_info;
-static std::unordered_set<u32> s_fastmem_faulting_pcs;
+static FlatHashSet<u32> s_fastmem_faulting_pcs;
+
+// Async compilation. New blocks run through the interpreter while the worker thread produces the
+// native code, so bursts of fresh code don't stall the emulation thread. The mutex serializes the
+// worker against every path which mutates JIT state (compiling, linking, invalidating, backpatching);
+// the worker holds it for the duration of each block compile.
+static Threading::Thread s_compile_thread;
+static std::mutex s_compile_mutex;
+static std::condition_variable s_compile_queue_cv;
+static std::deque<Block*> s_compile_queue;
+static std::vector<Block*> s_compiled_blocks;
+static bool s_compile_thread_shutdown = false;
+
+// Persistent block cache. We can't store host code, since it embeds host addresses (state, handlers),
+// so instead we remember which blocks existed, and batch-compile them as soon as their code reappears.
+struct PersistentBlockEntry
+{
+  u32 pc;
+  u32 instruction_count;
+  u32 instruction_crc;
+};
+static constexpr u32 PERSISTENT_BLOCK_CACHE_MAGIC = 0x43434244; // 'DBCC'
+static constexpr u32 PERSISTENT_BLOCK_CACHE_VERSION = 1;
+static std::vector<PersistentBlockEntry> s_persistent_pending_blocks;
+static bool s_persistent_cache_loaded = false;
 
 NORETURN_FUNCTION_POINTER void (*g_enter_recompiler)();
 const void* g_compile_or_revalidate_block;
@@ -142,6 +227,13 @@ alignas(HOST_PAGE_SIZE) static u8 s_code_storage[RECOMPILER_CODE_CACHE_SIZE + RE
 
 static JitCodeBuffer s_code_buffer;
 
+// Number of segments the near-code space is carved into. On exhaustion, only the least-recently-used
+// segment is discarded and recompiled into, instead of flushing the whole buffer.
+static constexpr u32 CODE_BUFFER_SEGMENTS = 8;
+
+static std::array<u64, CODE_BUFFER_SEGMENTS> s_code_segment_last_use = {};
+static u64 s_code_segment_use_counter = 0;
+
 #ifdef _DEBUG
 static u32 s_total_instructions_compiled = 0;
 static u32 s_total_host_instructions_emitted = 0;
@@ -212,7 +304,13 @@ void CPU::CodeCache::Initialize()
   {
     s_code_buffer.Reset();
     CompileASMFunctions();
+    s_code_buffer.SetupSegments(CODE_BUFFER_SEGMENTS);
+    s_code_segment_last_use.fill(0);
+    s_code_segment_use_counter = 0;
     ResetCodeLUT();
+
+    if (IsUsingAsyncCompilation())
+      StartCompileThread();
   }
 #endif
 
@@ -222,6 +320,15 @@ void CPU::CodeCache::Initialize()
 
 void CPU::CodeCache::Shutdown()
 {
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  StopCompileThread();
+
+  if (g_settings.cpu_persistent_block_cache && s_persistent_cache_loaded && IsUsingAnyRecompiler())
+    SavePersistentBlockCache();
+  s_persistent_pending_blocks = std::vector<PersistentBlockEntry>();
+  s_persistent_cache_loaded = false;
+#endif
+
   ClearBlocks();
 
 #ifdef ENABLE_RECOMPILER_SUPPORT
@@ -234,6 +341,10 @@ void CPU::CodeCache::Shutdown()
 
 void CPU::CodeCache::Reset()
 {
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  StopCompileThread();
+#endif
+
   ClearBlocks();
 
 #ifdef ENABLE_RECOMPILER_SUPPORT
@@ -242,7 +353,13 @@ void CPU::CodeCache::Reset()
     ClearASMFunctions();
     s_code_buffer.Reset();
     CompileASMFunctions();
+    s_code_buffer.SetupSegments(CODE_BUFFER_SEGMENTS);
+    s_code_segment_last_use.fill(0);
+    s_code_segment_use_counter = 0;
     ResetCodeLUT();
+
+    if (IsUsingAsyncCompilation())
+      StartCompileThread();
   }
 #endif
 }
@@ -264,6 +381,18 @@ void CPU::CodeCache::Execute()
 #endif
 }
 
+void CPU::CodeCache::ProcessPendingCompilations()
+{
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  if (!s_compile_thread.Joinable())
+    return;
+
+  std::unique_lock lock(s_compile_mutex);
+  if (!s_compiled_blocks.empty())
+    PublishCompiledBlocks();
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // MARK: - Block Management
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -435,6 +564,8 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
   const u32 frame_number = System::GetFrameNumber();
   u32 recompile_frame = System::GetFrameNumber();
   u8 recompile_count = 0;
+  u16 hot_count = 0;
+  u8 branch_taken_count = 0;
 
   const u32 idx = (pc & 0xFFFF) >> 2;
   Block* block = s_block_lut[table][idx];
@@ -446,6 +577,8 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
     // keep recompile stats before resetting, that way we actually count recompiles
     recompile_frame = block->compile_frame;
     recompile_count = block->compile_count;
+    hot_count = block->hot_count;
+    branch_taken_count = block->branch_taken_count;
 
     // if it has the same number of instructions, we can reuse it
     if (block->size != size)
@@ -464,8 +597,8 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
 
   if (!block)
   {
-    block =
-      static_cast<Block*>(std::malloc(sizeof(Block) + (sizeof(Instruction) * size) + (sizeof(InstructionInfo) * size)));
+    block = static_cast<Block*>(std::malloc(sizeof(Block) + (sizeof(Instruction) * size) +
+                                            (sizeof(InstructionInfo) * size) + (sizeof(InterpreterHandler) * size)));
     Assert(block);
     new (block) Block();
     s_blocks.push_back(block);
@@ -480,10 +613,13 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
   block->flags = metadata.flags;
   block->protection = GetProtectionModeForBlock(block);
   block->uncached_fetch_ticks = metadata.uncached_fetch_ticks;
+  block->icache_fill_ticks = metadata.icache_fill_ticks;
   block->icache_line_count = metadata.icache_line_count;
   block->host_code_size = 0;
   block->compile_frame = recompile_frame;
   block->compile_count = recompile_count + 1;
+  block->hot_count = hot_count;
+  block->branch_taken_count = branch_taken_count;
 
   // copy instructions/info
   {
@@ -526,6 +662,10 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
   if (g_settings.cpu_execution_mode == CPUExecutionMode::NewRec)
     FillBlockRegInfo(block);
 
+  // Pre-decode dispatch for the cached interpreter. Cold blocks get interpreted in the JIT modes
+  // too, so this is always filled.
+  FillBlockInterpreterHandlers(block);
+
   // add it to the tracking list for its page
   AddBlockToPageList(block);
 
@@ -534,6 +674,22 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
 
 bool CPU::CodeCache::IsBlockCodeCurrent(const Block* block)
 {
+  // traces aren't contiguous in memory, each word has to be compared at its own address
+  if (block->HasFlag(BlockFlags::Trace)) [[unlikely]]
+  {
+    const Instruction* insts = block->Instructions();
+    const InstructionInfo* infos = block->InstructionsInfo();
+    for (u32 i = 0; i < block->size; i++)
+    {
+      const PhysicalMemoryAddress inst_phys_addr = VirtualAddressToPhysical(infos[i].pc);
+      DebugAssert(inst_phys_addr < Bus::g_ram_size);
+      if (insts[i].bits != *reinterpret_cast<const u32*>(Bus::g_ram + inst_phys_addr))
+        return false;
+    }
+
+    return true;
+  }
+
   // blocks shouldn't be wrapping..
   const PhysicalMemoryAddress phys_addr = VirtualAddressToPhysical(block->pc);
   DebugAssert((phys_addr + (sizeof(Instruction) * block->size)) <= Bus::g_ram_size);
@@ -566,6 +722,31 @@ bool CPU::CodeCache::RevalidateBlock(Block* block)
   return true;
 }
 
+u16 CPU::CodeCache::GetBlockChunkMask(const Block* block)
+{
+  // Traces aren't contiguous in memory, so each instruction contributes its own chunk. They're kept
+  // within the starting page, so clamping to the page below can't drop any of them.
+  if (block->HasFlag(BlockFlags::Trace)) [[unlikely]]
+  {
+    u16 mask = 0;
+    const InstructionInfo* infos = block->InstructionsInfo();
+    for (u32 i = 0; i < block->size; i++)
+    {
+      mask |= static_cast<u16>(
+        1u << ((VirtualAddressToPhysical(infos[i].pc) & HOST_PAGE_MASK) >> INVALIDATION_CHUNK_SHIFT));
+    }
+    return mask;
+  }
+
+  // Blocks spanning pages are only tracked in their starting page, so clamp the range to it.
+  const u32 start_offset = VirtualAddressToPhysical(block->pc) & HOST_PAGE_MASK;
+  const u32 end_offset =
+    std::min<u32>(start_offset + (block->size * sizeof(Instruction)) - 1, HOST_PAGE_MASK);
+  const u32 first_chunk = start_offset >> INVALIDATION_CHUNK_SHIFT;
+  const u32 last_chunk = end_offset >> INVALIDATION_CHUNK_SHIFT;
+  return static_cast<u16>(((1u << (last_chunk - first_chunk + 1)) - 1u) << first_chunk);
+}
+
 void CPU::CodeCache::AddBlockToPageList(Block* block)
 {
   DebugAssert(block->size > 0);
@@ -575,6 +756,7 @@ void CPU::CodeCache::AddBlockToPageList(Block* block)
   const u32 page_idx = block->StartPageIndex();
   PageProtectionInfo& entry = s_page_protection[page_idx];
   Bus::SetRAMCodePage(page_idx);
+  entry.code_chunk_mask |= GetBlockChunkMask(block);
 
   if (entry.last_block_in_page)
   {
@@ -619,6 +801,11 @@ void CPU::CodeCache::RemoveBlockFromPageList(Block* block)
     cur_block->next_block_in_page = nullptr;
     break;
   }
+
+  // removed blocks may have been the only occupant of their chunks, rebuild from what's left
+  entry.code_chunk_mask = 0;
+  for (const Block* remaining = entry.first_block_in_page; remaining; remaining = remaining->next_block_in_page)
+    entry.code_chunk_mask |= GetBlockChunkMask(remaining);
 }
 
 void CPU::CodeCache::InvalidateBlocksWithPageIndex(u32 index)
@@ -649,7 +836,13 @@ void CPU::CodeCache::InvalidateBlocksWithPageIndex(u32 index)
   if (!ppi.first_block_in_page)
     return;
 
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  std::unique_lock lock(s_compile_mutex);
+#endif
   MemMap::BeginCodeWrite();
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  BeginBacklinkBatch();
+#endif
 
   Block* block = ppi.first_block_in_page;
   while (block)
@@ -660,7 +853,124 @@ void CPU::CodeCache::InvalidateBlocksWithPageIndex(u32 index)
 
   ppi.first_block_in_page = nullptr;
   ppi.last_block_in_page = nullptr;
+  ppi.code_chunk_mask = 0;
+
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  EndBacklinkBatch();
+#endif
+  MemMap::EndCodeWrite();
+}
+
+void CPU::CodeCache::InvalidateBlocksWithWriteAddress(PhysicalMemoryAddress address)
+{
+  const u32 index = address / HOST_PAGE_SIZE;
+  DebugAssert(index < Bus::RAM_8MB_CODE_PAGE_COUNT);
+  PageProtectionInfo& ppi = s_page_protection[index];
+
+  // Manually-checked pages don't track chunks, take the whole-page path.
+  if (ppi.mode != PageProtectionMode::WriteProtected)
+  {
+    InvalidateBlocksWithPageIndex(index);
+    return;
+  }
+
+  const u16 chunk_bit = static_cast<u16>(1u << ((address & HOST_PAGE_MASK) >> INVALIDATION_CHUNK_SHIFT));
+  if (!(ppi.code_chunk_mask & chunk_bit))
+  {
+    // Code segment eviction can leave a page flagged with no blocks at all; unprotect it so we stop
+    // coming back here.
+    if (!ppi.first_block_in_page)
+    {
+      Bus::ClearRAMCodePage(index);
+      return;
+    }
+
+    // Data write landing next to code in the same page. Nothing overlaps, so every block (and the
+    // write protection on the fastmem view) stays intact, and the page isn't penalized in the
+    // manual-protection heuristic for something that isn't self-modifying code.
+    return;
+  }
+
+  BlockState new_block_state = BlockState::Invalidated;
+
+  const u32 frame_number = System::GetFrameNumber();
+  const u32 frame_delta = frame_number - ppi.invalidate_frame;
+  ppi.invalidate_count++;
+
+  if (frame_delta >= INVALIDATE_FRAMES_FOR_MANUAL_PROTECTION)
+  {
+    ppi.invalidate_count = 1;
+    ppi.invalidate_frame = frame_number;
+  }
+  else if (ppi.invalidate_count > INVALIDATE_COUNT_FOR_MANUAL_PROTECTION)
+  {
+    Log_DevFmt("{} invalidations in {} frames to page {} [0x{:08X} -> 0x{:08X}], switching to manual protection",
+               ppi.invalidate_count, frame_delta, index, (index * HOST_PAGE_SIZE), ((index + 1) * HOST_PAGE_SIZE));
+    ppi.mode = PageProtectionMode::ManualCheck;
+    new_block_state = BlockState::NeedsRecompile;
+  }
+
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  std::unique_lock lock(s_compile_mutex);
+#endif
+  MemMap::BeginCodeWrite();
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  BeginBacklinkBatch();
+#endif
+
+  if (new_block_state == BlockState::NeedsRecompile)
+  {
+    // Switching to manual checks drops the whole page, same as the fault-handler path.
+    Bus::ClearRAMCodePage(index);
 
+    Block* block = ppi.first_block_in_page;
+    while (block)
+    {
+      InvalidateBlock(block, new_block_state);
+      block = std::exchange(block->next_block_in_page, nullptr);
+    }
+
+    ppi.first_block_in_page = nullptr;
+    ppi.last_block_in_page = nullptr;
+    ppi.code_chunk_mask = 0;
+  }
+  else
+  {
+    // Drop only the blocks overlapping the written chunk, keeping the rest of the page alive.
+    Block* prev_block = nullptr;
+    Block* block = ppi.first_block_in_page;
+    u16 remaining_mask = 0;
+    while (block)
+    {
+      Block* const next_block = block->next_block_in_page;
+      const u16 block_mask = GetBlockChunkMask(block);
+      if (block_mask & chunk_bit)
+      {
+        InvalidateBlock(block, new_block_state);
+        block->next_block_in_page = nullptr;
+        if (prev_block)
+          prev_block->next_block_in_page = next_block;
+        else
+          ppi.first_block_in_page = next_block;
+      }
+      else
+      {
+        remaining_mask |= block_mask;
+        prev_block = block;
+      }
+
+      block = next_block;
+    }
+
+    ppi.last_block_in_page = prev_block;
+    ppi.code_chunk_mask = remaining_mask;
+    if (!ppi.first_block_in_page)
+      Bus::ClearRAMCodePage(index);
+  }
+
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  EndBacklinkBatch();
+#endif
   MemMap::EndCodeWrite();
 }
 
@@ -688,6 +998,10 @@ void CPU::CodeCache::InvalidateBlock(Block* block, BlockState new_state)
 #ifdef ENABLE_RECOMPILER_SUPPORT
   if (block->state == BlockState::Valid)
   {
+    // drop it from the async queue if the worker hasn't got to it yet, the code is stale now
+    if (!s_compile_queue.empty() || !s_compiled_blocks.empty())
+      CancelBlockCompilation(block);
+
     SetCodeLUT(block->pc, g_compile_or_revalidate_block);
     BacklinkBlocks(block->pc, g_compile_or_revalidate_block);
   }
@@ -698,8 +1012,13 @@ void CPU::CodeCache::InvalidateBlock(Block* block, BlockState new_state)
 
 void CPU::CodeCache::InvalidateAllRAMBlocks()
 {
-  // TODO: maybe combine the backlink into one big instruction flush cache?
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  std::unique_lock lock(s_compile_mutex);
+#endif
   MemMap::BeginCodeWrite();
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  BeginBacklinkBatch();
+#endif
 
   for (Block* block : s_blocks)
   {
@@ -710,10 +1029,15 @@ void CPU::CodeCache::InvalidateAllRAMBlocks()
     }
   }
 
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  EndBacklinkBatch();
+#endif
+
   for (PageProtectionInfo& ppi : s_page_protection)
   {
     ppi.first_block_in_page = nullptr;
     ppi.last_block_in_page = nullptr;
+    ppi.code_chunk_mask = 0;
   }
 
   MemMap::EndCodeWrite();
@@ -732,9 +1056,14 @@ void CPU::CodeCache::ClearBlocks()
   }
 
 #ifdef ENABLE_RECOMPILER_SUPPORT
+  // compile thread is stopped by our callers, anything left in the queue is dead anyway
+  s_compile_queue.clear();
+  s_compiled_blocks.clear();
   s_fastmem_backpatch_info.clear();
-  s_fastmem_faulting_pcs.clear();
-  s_block_links.clear();
+  s_fastmem_faulting_pcs.Clear();
+  s_block_links.Clear();
+  s_backlink_flush_start = nullptr;
+  s_backlink_flush_end = nullptr;
 #endif
 
   for (Block* block : s_blocks)
@@ -753,13 +1082,16 @@ Common::PageFaultHandler::HandlerResult CPU::CodeCache::ExceptionHandler(void* e
   if (static_cast<const u8*>(fault_address) >= Bus::g_ram &&
       static_cast<const u8*>(fault_address) < (Bus::g_ram + Bus::RAM_8MB_SIZE))
   {
-    // Writing to protected RAM.
+    // Writing to protected RAM. Could be a snapshot write-tracking fault rather than (or as well
+    // as) code protection; marking the page dirty restores write access unless it holds code.
     DebugAssert(is_write);
     const u32 guest_address = static_cast<u32>(static_cast<const u8*>(fault_address) - Bus::g_ram);
     const u32 page_index = Bus::GetRAMCodePageIndex(guest_address);
     Log_DevFmt("Page fault on protected RAM @ 0x{:08X} (page #{}), invalidating code cache.", guest_address,
                page_index);
-    InvalidateBlocksWithPageIndex(page_index);
+    Bus::MarkRAMPageDirty(page_index);
+    if (Bus::IsRAMCodePage(page_index))
+      InvalidateBlocksWithPageIndex(page_index);
     return Common::PageFaultHandler::HandlerResult::ContinueExecution;
   }
 
@@ -837,17 +1169,28 @@ template<PGXPMode pgxp_mode>
 
       DebugAssert(!(HasPendingInterrupt()));
       if (g_settings.cpu_recompiler_icache)
-        CheckAndUpdateICacheTags(block->icache_line_count, block->uncached_fetch_ticks);
+        CheckAndUpdateICacheTags(block->icache_line_count, block->uncached_fetch_ticks, block->icache_fill_ticks);
 
-      InterpretCachedBlock<pgxp_mode>(block);
+      InterpretCachedBlock(block);
 
       CHECK_DOWNCOUNT();
 
       // Handle self-looping blocks
       if (g_state.pc == block->pc)
+      {
+        // Nothing an idle loop reads can change until an event runs, so burn the rest of the slice.
+        if (block->HasFlag(BlockFlags::IsIdleLoop))
+        {
+          g_state.pending_ticks = g_state.downcount;
+          break;
+        }
+
         goto reexecute_block;
+      }
       else
+      {
         continue;
+      }
 
     interpret_block:
       InterpretUncachedBlock<pgxp_mode>();
@@ -917,6 +1260,7 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
 
   instructions->clear();
   metadata->icache_line_count = 0;
+  metadata->icache_fill_ticks = 0;
   metadata->uncached_fetch_ticks = 0;
   metadata->flags = BlockFlags::None;
 
@@ -973,6 +1317,7 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
       if (icache_line != last_cache_line)
       {
         metadata->icache_line_count++;
+        metadata->icache_fill_ticks += GetICacheFillTicks(pc & ICACHE_TAG_ADDRESS_MASK);
         last_cache_line = icache_line;
       }
     }
@@ -1009,7 +1354,36 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
     // if we're in a branch delay slot, the block is now done
     // except if this is a branch in a branch delay slot, then we grab the one after that, and so on...
     if (is_branch_delay_slot && !info.is_branch_instruction)
+    {
+      // trace formation: follow unconditional direct jumps and keep decoding at the target, so the
+      // recompiler can compile straight across the jump without flushing its register cache.
+      if (g_settings.cpu_trace_formation && g_settings.cpu_execution_mode == CPUExecutionMode::NewRec &&
+          instructions->size() < MAX_TRACE_INSTRUCTIONS)
+      {
+        const BlockInstructionInfoPair& branch = (*instructions)[instructions->size() - 2];
+        if (branch.first.op == InstructionOp::j || branch.first.op == InstructionOp::jal)
+        {
+          const u32 target = GetDirectBranchTarget(branch.first, branch.second.pc);
+
+          // Keep RAM traces within the starting page, so page-based invalidation still covers the whole
+          // block, and don't let ROM blocks pull in RAM code, since they're never invalidated.
+          const bool target_ok = AddressInRAM(start_pc) ?
+                                   (AddressInRAM(target) &&
+                                    Bus::GetRAMCodePageIndex(target) == Bus::GetRAMCodePageIndex(start_pc)) :
+                                   !AddressInRAM(target);
+          if (target != start_pc && target_ok)
+          {
+            metadata->flags |= BlockFlags::Trace;
+            pc = target;
+            is_branch_delay_slot = false;
+            is_load_delay_slot = info.has_load_delay;
+            continue;
+          }
+        }
+      }
+
       break;
+    }
 
     // if this is a branch, we grab the next instruction (delay slot), and then exit
     is_branch_delay_slot = info.is_branch_instruction;
@@ -1030,6 +1404,12 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
 
   instructions->back().second.is_last_instruction = true;
 
+  if (g_settings.cpu_idle_loop_skip && IsIdleLoopBlock(*instructions, start_pc))
+  {
+    Log_DevFmt("Detected idle loop at 0x{:08X}", start_pc);
+    metadata->flags |= BlockFlags::IsIdleLoop;
+  }
+
 #ifdef _DEBUG
   SmallString disasm;
   Log_DebugPrintf("Block at 0x%08X", start_pc);
@@ -1044,6 +1424,151 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
   return true;
 }
 
+bool CPU::CodeCache::IsIdleLoopBlock(const BlockInstructionList& instructions, u32 start_pc)
+{
+  // Tiny self-loops which poll a memory flag: nothing is stored, and every register read is either
+  // loop-invariant or rederived from a load each iteration. Executing one iteration then produces
+  // the same result as executing N, until an event changes the memory it polls, so the scheduler
+  // can burn the rest of the timeslice after a single interpreted pass.
+  constexpr u32 MAX_IDLE_LOOP_INSTRUCTIONS = 8;
+  const u32 size = static_cast<u32>(instructions.size());
+  if (size < 2 || size > MAX_IDLE_LOOP_INSTRUCTIONS)
+    return false;
+
+  // the branch sits in front of the delay slot, and has to come straight back to us
+  const auto& [branch_inst, branch_info] = instructions[size - 2];
+  if (!branch_info.is_branch_instruction || !branch_info.is_direct_branch_instruction ||
+      GetDirectBranchTarget(branch_inst, branch_info.pc) != start_pc)
+  {
+    return false;
+  }
+
+  // reads[]/writes[] per instruction, bit per GPR
+  const auto classify = [](const Instruction& inst, u32* reads, u32* writes) -> bool {
+    const auto RegBit = [](Reg reg) -> u32 { return (reg == Reg::zero) ? 0 : (1u << static_cast<u8>(reg)); };
+    *reads = 0;
+    *writes = 0;
+
+    switch (inst.op)
+    {
+      case InstructionOp::lui:
+        *writes = RegBit(inst.i.rt);
+        return true;
+
+      case InstructionOp::addi:
+      case InstructionOp::addiu:
+      case InstructionOp::slti:
+      case InstructionOp::sltiu:
+      case InstructionOp::andi:
+      case InstructionOp::ori:
+      case InstructionOp::xori:
+        *reads = RegBit(inst.i.rs);
+        *writes = RegBit(inst.i.rt);
+        return true;
+
+      case InstructionOp::lb:
+      case InstructionOp::lh:
+      case InstructionOp::lw:
+      case InstructionOp::lbu:
+      case InstructionOp::lhu:
+        *reads = RegBit(inst.i.rs);
+        *writes = RegBit(inst.i.rt);
+        return true;
+
+      case InstructionOp::lwl:
+      case InstructionOp::lwr:
+        *reads = RegBit(inst.i.rs) | RegBit(inst.i.rt);
+        *writes = RegBit(inst.i.rt);
+        return true;
+
+      case InstructionOp::beq:
+      case InstructionOp::bne:
+        *reads = RegBit(inst.i.rs) | RegBit(inst.i.rt);
+        return true;
+
+      case InstructionOp::blez:
+      case InstructionOp::bgtz:
+        *reads = RegBit(inst.i.rs);
+        return true;
+
+      case InstructionOp::b:
+        *reads = RegBit(inst.i.rs);
+        if ((static_cast<u8>(inst.i.rt.GetValue()) & u8(0x1E)) == u8(0x10)) // and-link variants
+          *writes = RegBit(Reg::ra);
+        return true;
+
+      case InstructionOp::j:
+        return true;
+
+      case InstructionOp::jal:
+        *writes = RegBit(Reg::ra);
+        return true;
+
+      case InstructionOp::funct:
+      {
+        switch (inst.r.funct)
+        {
+          case InstructionFunct::sll:
+          case InstructionFunct::srl:
+          case InstructionFunct::sra:
+            *reads = RegBit(inst.r.rt);
+            *writes = RegBit(inst.r.rd);
+            return true;
+
+          case InstructionFunct::sllv:
+          case InstructionFunct::srlv:
+          case InstructionFunct::srav:
+          case InstructionFunct::add:
+          case InstructionFunct::addu:
+          case InstructionFunct::sub:
+          case InstructionFunct::subu:
+          case InstructionFunct::and_:
+          case InstructionFunct::or_:
+          case InstructionFunct::xor_:
+          case InstructionFunct::nor:
+          case InstructionFunct::slt:
+          case InstructionFunct::sltu:
+            *reads = RegBit(inst.r.rs) | RegBit(inst.r.rt);
+            *writes = RegBit(inst.r.rd);
+            return true;
+
+          default:
+            // jr/jalr/mult/div/syscall/... - anything indirect, trapping or touching hi/lo
+            return false;
+        }
+      }
+
+      default:
+        // stores, coprocessor accesses, anything with side effects
+        return false;
+    }
+  };
+
+  u32 inst_reads[MAX_IDLE_LOOP_INSTRUCTIONS];
+  u32 inst_writes[MAX_IDLE_LOOP_INSTRUCTIONS];
+  u32 written_anywhere = 0;
+  for (u32 i = 0; i < size; i++)
+  {
+    if (!classify(instructions[i].first, &inst_reads[i], &inst_writes[i]))
+      return false;
+
+    written_anywhere |= inst_writes[i];
+  }
+
+  // A register which is read before the loop writes it, but is written somewhere in the loop,
+  // carries a changing value across iterations (e.g. a counter), so the loop isn't idle.
+  u32 written_so_far = 0;
+  for (u32 i = 0; i < size; i++)
+  {
+    if ((inst_reads[i] & written_anywhere & ~written_so_far) != 0)
+      return false;
+
+    written_so_far |= inst_writes[i];
+  }
+
+  return true;
+}
+
 void CPU::CodeCache::CopyRegInfo(InstructionInfo* dst, const InstructionInfo* src)
 {
   std::memcpy(dst->reg_flags, src->reg_flags, sizeof(dst->reg_flags));
@@ -1305,6 +1830,31 @@ void CPU::CodeCache::FillBlockRegInfo(Block* block)
     inst--;
     iinst--;
   } // end while
+
+  // Backwards GTE FLAG liveness. Every GTE command starts by clearing FLAG, so a command's flag
+  // updates are dead unless a cfc2 of FLAG (reg 63) occurs before the next command. The block end
+  // has to be treated as a read, since the following block isn't known here. Skipped flags could
+  // still become visible if an exception is taken between two commands and the handler inspects
+  // FLAG, but nothing is known to do that.
+  bool gte_flags_live = true;
+  const Instruction* const ibase = block->Instructions();
+  for (u32 i = block->size; i > 0; i--)
+  {
+    const Instruction& ginst = ibase[i - 1];
+    if (ginst.op != InstructionOp::cop2)
+      continue;
+
+    if (ginst.cop.IsCommonInstruction())
+    {
+      if (ginst.cop.CommonOp() == CopCommonInstruction::cfcn && ginst.cop.Cop2Index() == 63)
+        gte_flags_live = true;
+    }
+    else
+    {
+      start[i - 1].gte_flags_dead = !gte_flags_live;
+      gte_flags_live = false;
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1317,6 +1867,36 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
 {
   // TODO: this doesn't currently handle when the cache overflows...
   DebugAssert(IsUsingAnyRecompiler());
+
+  if (g_settings.cpu_persistent_block_cache)
+  {
+    if (!s_persistent_cache_loaded)
+      LoadPersistentBlockCache();
+
+    // If this PC was seen in a previous session, the game has (re)loaded the code containing it, so
+    // chances are the rest of the remembered blocks are sitting in RAM now too. Compile them in one go.
+    if (!s_persistent_pending_blocks.empty() && IsPendingPersistentBlock(start_pc))
+      PrecompilePersistentBlocks(start_pc);
+  }
+
+  // Interpreted fast paths for idle and cold blocks. The pc check keeps the persistent-cache sweep
+  // (which requests other PCs) from executing a block the guest isn't actually at.
+  if (start_pc == g_state.pc)
+  {
+    Block* lookup_block = LookupBlock(start_pc);
+    if (lookup_block)
+    {
+      if (lookup_block->state == BlockState::IdleSkip && ExecuteIdleLoopBlock(lookup_block))
+        return;
+      if (lookup_block->state == BlockState::Cold && InterpretColdBlock(lookup_block))
+        return;
+    }
+  }
+
+  std::unique_lock lock(s_compile_mutex);
+  if (!s_compiled_blocks.empty())
+    PublishCompiledBlocks();
+
   MemMap::BeginCodeWrite();
 
   Block* block = LookupBlock(start_pc);
@@ -1324,9 +1904,12 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
   {
     // we should only be here if the block got invalidated
     DebugAssert(block->state != BlockState::Valid);
-    if (RevalidateBlock(block))
+
+    // no host code yet if it was invalidated before the worker thread got to it
+    if (block->host_code && RevalidateBlock(block))
     {
       DebugAssert(block->host_code);
+      TouchCodeSegment(block->host_code);
       SetCodeLUT(start_pc, block->host_code);
       BacklinkBlocks(start_pc, block->host_code);
       MemMap::EndCodeWrite();
@@ -1357,12 +1940,60 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
   if (s_code_buffer.GetFreeCodeSpace() < (block_size * Recompiler::MAX_NEAR_HOST_BYTES_PER_INSTRUCTION) ||
       s_code_buffer.GetFreeFarCodeSpace() < (block_size * Recompiler::MAX_FAR_HOST_BYTES_PER_INSTRUCTION))
   {
-    Log_ErrorFmt("Out of code space while compiling {:08X}. Resetting code cache.", start_pc);
-    CodeCache::Reset();
+    // Far code is bump-allocated and only reclaimed by a full clear, so segment eviction can't help
+    // it; near-code exhaustion only costs us the least-recently-used segment.
+    if (s_code_buffer.GetFreeFarCodeSpace() < (block_size * Recompiler::MAX_FAR_HOST_BYTES_PER_INSTRUCTION) ||
+        !EvictColdestCodeSegment())
+    {
+      Log_ErrorFmt("Out of code space while compiling {:08X}. Resetting code cache.", start_pc);
+
+      // Reset() restarts the compile thread, so we can't be holding its lock.
+      MemMap::EndCodeWrite();
+      lock.unlock();
+      CodeCache::Reset();
+      lock.lock();
+      MemMap::BeginCodeWrite();
+    }
+  }
+
+  if ((block = CreateBlock(start_pc, s_block_instructions, metadata)) == nullptr || block->size == 0)
+  {
+    Log_ErrorFmt("Failed to compile block at 0x{:08X}, falling back to uncached interpreter", start_pc);
+    SetCodeLUT(start_pc, g_interpret_block);
+    BacklinkBlocks(start_pc, g_interpret_block);
+    MemMap::EndCodeWrite();
+    return;
+  }
+
+  // Idle loops are never worth native code: the LUT keeps pointing at the compile stub, and the fast
+  // path above interprets them once per timeslice and skips ahead.
+  if (block->HasFlag(BlockFlags::IsIdleLoop))
+  {
+    block->state = BlockState::IdleSkip;
+    MemMap::EndCodeWrite();
+    return;
+  }
+
+  // New blocks start cold; the LUT keeps pointing at the compile stub, and every execution comes back
+  // through InterpretColdBlock() until the hotness counter promotes it.
+  if (g_settings.cpu_tiered_execution && block->hot_count < COLD_BLOCK_PROMOTION_THRESHOLD)
+  {
+    block->state = BlockState::Cold;
+    MemMap::EndCodeWrite();
+    return;
+  }
+
+  if (IsUsingAsyncCompilation())
+  {
+    // Interpret it until the worker thread hands the native code back to us.
+    EnqueueBlockCompilation(block);
+    SetCodeLUT(start_pc, g_interpret_block);
+    BacklinkBlocks(start_pc, g_interpret_block);
+    MemMap::EndCodeWrite();
+    return;
   }
 
-  if ((block = CreateBlock(start_pc, s_block_instructions, metadata)) == nullptr || block->size == 0 ||
-      !CompileBlock(block))
+  if (!CompileBlock(block))
   {
     Log_ErrorFmt("Failed to compile block at 0x{:08X}, falling back to uncached interpreter", start_pc);
     SetCodeLUT(start_pc, g_interpret_block);
@@ -1378,15 +2009,19 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
 
 void CPU::CodeCache::DiscardAndRecompileBlock(u32 start_pc)
 {
-  MemMap::BeginCodeWrite();
+  {
+    std::unique_lock lock(s_compile_mutex);
+    MemMap::BeginCodeWrite();
 
-  Log_DevPrintf("Discard block %08X with manual protection", start_pc);
-  Block* block = LookupBlock(start_pc);
-  DebugAssert(block && block->state == BlockState::Valid);
-  InvalidateBlock(block, BlockState::NeedsRecompile);
-  CompileOrRevalidateBlock(start_pc);
+    Log_DevPrintf("Discard block %08X with manual protection", start_pc);
+    Block* block = LookupBlock(start_pc);
+    DebugAssert(block && block->state == BlockState::Valid);
+    InvalidateBlock(block, BlockState::NeedsRecompile);
 
-  MemMap::EndCodeWrite();
+    MemMap::EndCodeWrite();
+  }
+
+  CompileOrRevalidateBlock(start_pc);
 }
 
 const void* CPU::CodeCache::CreateBlockLink(Block* block, void* code, u32 newpc)
@@ -1405,15 +2040,19 @@ const void* CPU::CodeCache::CreateBlockLink(Block* block, void* code, u32 newpc)
               ((next_block->state == BlockState::FallbackToInterpreter) ? g_interpret_block :
                                                                           g_compile_or_revalidate_block);
       DebugAssert(dst);
+
+      // the target is about to be executed, so its segment is warm
+      if (next_block->state == BlockState::Valid)
+        TouchCodeSegment(next_block->host_code);
     }
     else
     {
       dst = g_compile_or_revalidate_block;
     }
 
-    BlockLinkMap::iterator iter = s_block_links.emplace(newpc, code);
+    s_block_links.Insert(newpc, code);
     DebugAssert(block->num_exit_links < MAX_BLOCK_EXIT_LINKS);
-    block->exit_links[block->num_exit_links++] = iter;
+    block->exit_links[block->num_exit_links++] = {newpc, code};
   }
 
   Log_DebugPrintf("Linking %p with dst pc %08X to %p%s", code, newpc, dst,
@@ -1426,20 +2065,49 @@ void CPU::CodeCache::BacklinkBlocks(u32 pc, const void* dst)
   if (!g_settings.cpu_recompiler_block_linking)
     return;
 
-  const auto link_range = s_block_links.equal_range(pc);
-  for (auto it = link_range.first; it != link_range.second; ++it)
-  {
-    Log_DebugPrintf("Backlinking %p with dst pc %08X to %p%s", it->second, pc, dst,
+  s_block_links.ForEachWithKey(pc, [pc, dst](void* code) {
+    Log_DebugPrintf("Backlinking %p with dst pc %08X to %p%s", code, pc, dst,
                     (dst == g_compile_or_revalidate_block) ? "[compiler]" : "");
-    EmitJump(it->second, dst, true);
-  }
+    const u32 size = EmitJump(code, dst, false);
+    u8* const start = static_cast<u8*>(code);
+    if (!s_backlink_flush_start || start < s_backlink_flush_start)
+      s_backlink_flush_start = start;
+    if ((start + size) > s_backlink_flush_end)
+      s_backlink_flush_end = start + size;
+  });
+
+  if (s_backlink_batch_depth == 0)
+    FlushBacklinkedCode();
+}
+
+void CPU::CodeCache::BeginBacklinkBatch()
+{
+  s_backlink_batch_depth++;
+}
+
+void CPU::CodeCache::EndBacklinkBatch()
+{
+  DebugAssert(s_backlink_batch_depth > 0);
+  if ((--s_backlink_batch_depth) == 0)
+    FlushBacklinkedCode();
+}
+
+void CPU::CodeCache::FlushBacklinkedCode()
+{
+  if (!s_backlink_flush_start)
+    return;
+
+  JitCodeBuffer::FlushInstructionCache(s_backlink_flush_start,
+                                       static_cast<u32>(s_backlink_flush_end - s_backlink_flush_start));
+  s_backlink_flush_start = nullptr;
+  s_backlink_flush_end = nullptr;
 }
 
 void CPU::CodeCache::UnlinkBlockExits(Block* block)
 {
   const u32 num_exit_links = block->num_exit_links;
   for (u32 i = 0; i < num_exit_links; i++)
-    s_block_links.erase(block->exit_links[i]);
+    s_block_links.Erase(block->exit_links[i].newpc, block->exit_links[i].code);
   block->num_exit_links = 0;
 }
 
@@ -1448,6 +2116,72 @@ JitCodeBuffer& CPU::CodeCache::GetCodeBuffer()
   return s_code_buffer;
 }
 
+ScratchArena& CPU::CodeCache::GetScratchArena()
+{
+  return s_scratch_arena;
+}
+
+void CPU::CodeCache::TouchCodeSegment(const void* host_code)
+{
+  const u32 segment = s_code_buffer.GetSegmentForPointer(host_code);
+  if (segment < s_code_buffer.GetSegmentCount())
+    s_code_segment_last_use[segment] = ++s_code_segment_use_counter;
+}
+
+bool CPU::CodeCache::EvictColdestCodeSegment()
+{
+  // caller must hold s_compile_mutex and be within BeginCodeWrite()
+  const u32 num_segments = s_code_buffer.GetSegmentCount();
+  if (num_segments == 0)
+    return false;
+
+  // Pick the least-recently-used segment, never the one we're currently filling.
+  const u32 active_segment = s_code_buffer.GetActiveSegment();
+  u32 victim = active_segment;
+  for (u32 i = 0; i < num_segments; i++)
+  {
+    if (i == active_segment)
+      continue;
+    if (victim == active_segment || s_code_segment_last_use[i] < s_code_segment_last_use[victim])
+      victim = i;
+  }
+  if (victim == active_segment)
+    return false;
+
+  // Drop every block whose code lives in the victim segment. They keep their decoded instructions
+  // and stats, but have to recompile if they run again; invalidated blocks also lose their code
+  // here, so revalidation can't hand back a pointer into the reused segment.
+  u32 evicted_blocks = 0;
+  BeginBacklinkBatch();
+  for (Block* block : s_blocks)
+  {
+    if (!block->host_code || s_code_buffer.GetSegmentForPointer(block->host_code) != victim)
+      continue;
+
+    if (block->state == BlockState::Valid)
+      RemoveBlockFromPageList(block);
+
+    // Links out of the victim must be forgotten, or a later invalidation of their target would
+    // patch a jump into whatever the segment gets refilled with.
+    UnlinkBlockExits(block);
+    if (block->HasFlag(BlockFlags::ContainsLoadStoreInstructions))
+      RemoveBackpatchInfoForRange(block->host_code, block->host_code_size);
+
+    InvalidateBlock(block, BlockState::NeedsRecompile);
+    block->host_code = nullptr;
+    block->host_code_size = 0;
+    evicted_blocks++;
+  }
+  EndBacklinkBatch();
+
+  Log_DevFmt("Evicted code segment {} ({} blocks), {} uses behind segment {}", victim, evicted_blocks,
+             s_code_segment_use_counter - s_code_segment_last_use[victim], active_segment);
+
+  s_code_buffer.SwitchToSegment(victim);
+  s_code_segment_last_use[victim] = ++s_code_segment_use_counter;
+  return true;
+}
+
 const void* CPU::CodeCache::GetInterpretUncachedBlockFunction()
 {
   if (g_settings.gpu_pgxp_enable)
@@ -1493,12 +2227,28 @@ void CPU::CodeCache::CompileASMFunctions()
   MemMap::EndCodeWrite();
 }
 
+static u64 s_blocks_compiled = 0;
+
+u64 CPU::CodeCache::GetCompiledBlockCount()
+{
+  return s_blocks_compiled;
+}
+
 bool CPU::CodeCache::CompileBlock(Block* block)
 {
+  PerfStats::StallScope stall_scope(PerfStats::StallSource::BlockCompile);
+
   const void* host_code = nullptr;
   u32 host_code_size = 0;
   u32 host_far_code_size = 0;
 
+  s_blocks_compiled++;
+  if (PerfTrace::IsCapturing())
+    PerfTrace::AddCounter("BlocksCompiled", static_cast<double>(s_blocks_compiled));
+
+  // Everything the compilers allocated for the previous block is dead by now.
+  s_scratch_arena.Reset();
+
 #ifdef ENABLE_RECOMPILER
   if (g_settings.cpu_execution_mode == CPUExecutionMode::Recompiler)
   {
@@ -1548,6 +2298,7 @@ bool CPU::CodeCache::CompileBlock(Block* block)
   MIPSPerfScope.RegisterPC(host_code, host_code_size, block->pc);
 #endif
 
+  TouchCodeSegment(host_code);
   return true;
 }
 
@@ -1617,7 +2368,12 @@ Common::PageFaultHandler::HandlerResult CPU::CodeCache::HandleFastmemException(v
     if (is_write && !g_state.cop0_regs.sr.Isc && AddressInRAM(guest_address))
     {
       Log_DevFmt("Ignoring fault due to RAM write @ 0x{:08X}", guest_address);
-      InvalidateBlocksWithPageIndex(Bus::GetRAMCodePageIndex(guest_address));
+
+      // Snapshot write tracking protects non-code pages too; only invalidate when there's code.
+      const u32 page_index = Bus::GetRAMCodePageIndex(guest_address);
+      Bus::MarkRAMPageDirty(page_index);
+      if (Bus::IsRAMCodePage(page_index))
+        InvalidateBlocksWithPageIndex(page_index);
       return Common::PageFaultHandler::HandlerResult::ContinueExecution;
     }
   }
@@ -1631,6 +2387,9 @@ Common::PageFaultHandler::HandlerResult CPU::CodeCache::HandleFastmemException(v
   Log_DevFmt("Page fault handler invoked at PC={} Address={} {}, fastmem offset {:08X}", exception_pc, fault_address,
              is_write ? "(write)" : "(read)", guest_address);
 
+  // worker thread inserts backpatch entries while compiling
+  std::unique_lock lock(s_compile_mutex);
+
   auto iter = s_fastmem_backpatch_info.find(exception_pc);
   if (iter == s_fastmem_backpatch_info.end())
   {
@@ -1668,14 +2427,14 @@ Common::PageFaultHandler::HandlerResult CPU::CodeCache::HandleFastmemException(v
   MemMap::EndCodeWrite();
 
   // and store the pc in the faulting list, so that we don't emit another fastmem loadstore
-  s_fastmem_faulting_pcs.insert(info.guest_pc);
+  s_fastmem_faulting_pcs.Insert(info.guest_pc);
   s_fastmem_backpatch_info.erase(iter);
   return Common::PageFaultHandler::HandlerResult::ContinueExecution;
 }
 
 bool CPU::CodeCache::HasPreviouslyFaultedOnPC(u32 guest_pc)
 {
-  return (s_fastmem_faulting_pcs.find(guest_pc) != s_fastmem_faulting_pcs.end());
+  return s_fastmem_faulting_pcs.Contains(guest_pc);
 }
 
 void CPU::CodeCache::BackpatchLoadStore(void* host_pc, const LoadstoreBackpatchInfo& info)
@@ -1714,4 +2473,365 @@ void CPU::CodeCache::RemoveBackpatchInfoForRange(const void* host_code, u32 size
   s_fastmem_backpatch_info.erase(start_iter, end_iter);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MARK: - Tiered Execution
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CPU::CodeCache::InterpretSingleBlock(Block* block)
+{
+  if (g_settings.cpu_recompiler_icache)
+    CheckAndUpdateICacheTags(block->icache_line_count, block->uncached_fetch_ticks, block->icache_fill_ticks);
+
+  // the block's pre-decoded handlers already carry the PGXP mode
+  InterpretCachedBlock(block);
+}
+
+bool CPU::CodeCache::InterpretColdBlock(Block* block)
+{
+  DebugAssert(block->state == BlockState::Cold);
+
+  // The dispatcher doesn't run an event test between stub calls, so do it here, otherwise a cold
+  // polling loop could starve pending events.
+  if (g_state.pending_ticks >= g_state.downcount)
+  {
+    TimingEvents::RunEvents();
+
+    // events can redirect execution (interrupts), or invalidate this block (DMA)
+    if (g_state.pc != block->pc || block->state != BlockState::Cold)
+      return true;
+  }
+
+  // SMC on manually-protected pages has to be verified on every run, same as the cached interpreter.
+  if (block->hot_count >= COLD_BLOCK_PROMOTION_THRESHOLD ||
+      (block->protection == PageProtectionMode::ManualCheck && !IsBlockCodeCurrent(block)))
+  {
+    // Hot (or stale): hand it to the normal compile path, which recreates and compiles it.
+    RemoveBlockFromPageList(block);
+    block->state = BlockState::NeedsRecompile;
+    return false;
+  }
+
+  block->hot_count++;
+
+  // Profile the terminal branch while we're still interpreting: any successor other than the
+  // fall-through counts as taken (interrupts redirecting the PC are rare enough not to skew it).
+  // The compiler uses this to lay the hot successor out on the fall-through path.
+  const u32 fall_through_pc = block->pc + (block->size * sizeof(Instruction));
+  InterpretSingleBlock(block);
+  if (g_state.pc != fall_through_pc && block->branch_taken_count < std::numeric_limits<u8>::max())
+    block->branch_taken_count++;
+
+  return true;
+}
+
+bool CPU::CodeCache::ExecuteIdleLoopBlock(Block* block)
+{
+  DebugAssert(block->state == BlockState::IdleSkip);
+
+  // like cold blocks, we're responsible for the event test
+  if (g_state.pending_ticks >= g_state.downcount)
+  {
+    TimingEvents::RunEvents();
+    if (g_state.pc != block->pc || block->state != BlockState::IdleSkip)
+      return true;
+  }
+
+  if (block->protection == PageProtectionMode::ManualCheck && !IsBlockCodeCurrent(block))
+  {
+    RemoveBlockFromPageList(block);
+    block->state = BlockState::NeedsRecompile;
+    return false;
+  }
+
+  InterpretSingleBlock(block);
+
+  // Still spinning? Nothing the loop reads can change until an event runs, so consume the rest of
+  // the timeslice in one go.
+  if (g_state.pc == block->pc && g_state.pending_ticks < g_state.downcount)
+    g_state.pending_ticks = g_state.downcount;
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MARK: - Asynchronous Compilation
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool CPU::CodeCache::IsUsingAsyncCompilation()
+{
+  // Only the newrec compiles through the single global compiler instance, which makes it safe to
+  // drive from one worker thread. The oldrec constructs per-block generators on the caller.
+  return (g_settings.cpu_async_block_compile && g_settings.cpu_execution_mode == CPUExecutionMode::NewRec);
+}
+
+void CPU::CodeCache::StartCompileThread()
+{
+  if (s_compile_thread.Joinable())
+    return;
+
+  s_compile_thread_shutdown = false;
+  s_compile_thread.Start(&CompileThreadEntryPoint);
+}
+
+void CPU::CodeCache::StopCompileThread()
+{
+  if (!s_compile_thread.Joinable())
+    return;
+
+  {
+    std::unique_lock lock(s_compile_mutex);
+    s_compile_thread_shutdown = true;
+    s_compile_queue_cv.notify_one();
+  }
+
+  s_compile_thread.Join();
+  s_compile_queue.clear();
+  s_compiled_blocks.clear();
+}
+
+void CPU::CodeCache::CompileThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("CPU Block Compiler");
+
+  std::unique_lock lock(s_compile_mutex);
+  for (;;)
+  {
+    if (s_compile_thread_shutdown)
+      break;
+
+    if (s_compile_queue.empty())
+    {
+      s_compile_queue_cv.wait(lock);
+      continue;
+    }
+
+    Block* const block = s_compile_queue.front();
+    s_compile_queue.pop_front();
+
+    // Hold the lock over the compile itself; the emulation thread only takes it on compile-related
+    // slow paths, so the worst case is it briefly waits for one block instead of compiling it.
+    MemMap::BeginCodeWrite();
+    const bool okay = CompileBlock(block);
+    MemMap::EndCodeWrite();
+
+    // failed compiles were already flipped to FallbackToInterpreter
+    if (okay)
+      s_compiled_blocks.push_back(block);
+  }
+}
+
+void CPU::CodeCache::EnqueueBlockCompilation(Block* block)
+{
+  DebugAssert(s_compile_thread.Joinable());
+  s_compile_queue.push_back(block);
+  s_compile_queue_cv.notify_one();
+}
+
+void CPU::CodeCache::CancelBlockCompilation(Block* block)
+{
+  // caller holds s_compile_mutex, so the worker can't be mid-compile on this block
+  const auto queue_iter = std::find(s_compile_queue.begin(), s_compile_queue.end(), block);
+  if (queue_iter != s_compile_queue.end())
+    s_compile_queue.erase(queue_iter);
+
+  const auto compiled_iter = std::find(s_compiled_blocks.begin(), s_compiled_blocks.end(), block);
+  if (compiled_iter != s_compiled_blocks.end())
+    s_compiled_blocks.erase(compiled_iter);
+}
+
+void CPU::CodeCache::PublishCompiledBlocks()
+{
+  MemMap::BeginCodeWrite();
+
+  for (Block* block : s_compiled_blocks)
+  {
+    // anything invalidated in the meantime was cancelled, so this should still be current
+    DebugAssert(block->state == BlockState::Valid && block->host_code);
+    SetCodeLUT(block->pc, block->host_code);
+    BacklinkBlocks(block->pc, block->host_code);
+  }
+
+  s_compiled_blocks.clear();
+  MemMap::EndCodeWrite();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MARK: - Persistent Block Cache
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+u32 CPU::CodeCache::GetPersistentCacheCodeGenKey()
+{
+  // Anything which changes the shape of the generated code has to be part of the key, otherwise we
+  // would precompile blocks against stale options after the user toggles them.
+  return (static_cast<u32>(g_settings.cpu_execution_mode) << 0) | (static_cast<u32>(g_settings.cpu_fastmem_mode) << 8) |
+         (static_cast<u32>(g_settings.cpu_recompiler_memory_exceptions) << 16) |
+         (static_cast<u32>(g_settings.cpu_recompiler_block_linking) << 17) |
+         (static_cast<u32>(g_settings.cpu_recompiler_icache) << 18) |
+         (static_cast<u32>(g_settings.gpu_pgxp_enable) << 19) | (static_cast<u32>(g_settings.gpu_pgxp_cpu) << 20);
+}
+
+std::string CPU::CodeCache::GetPersistentCacheFilename()
+{
+  return Path::Combine(EmuFolders::Cache, fmt::format("jit_blocks_{:016X}.bcc", System::GetGameHash()));
+}
+
+void CPU::CodeCache::LoadPersistentBlockCache()
+{
+  s_persistent_cache_loaded = true;
+  s_persistent_pending_blocks.clear();
+
+  if (System::GetGameHash() == 0)
+    return;
+
+  const std::string filename = GetPersistentCacheFilename();
+  auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "rb");
+  if (!fp)
+    return;
+
+  u32 magic, version, codegen_key, entry_count;
+  u64 game_hash;
+  if (std::fread(&magic, sizeof(magic), 1, fp.get()) != 1 || magic != PERSISTENT_BLOCK_CACHE_MAGIC ||
+      std::fread(&version, sizeof(version), 1, fp.get()) != 1 || version != PERSISTENT_BLOCK_CACHE_VERSION ||
+      std::fread(&game_hash, sizeof(game_hash), 1, fp.get()) != 1 || game_hash != System::GetGameHash() ||
+      std::fread(&codegen_key, sizeof(codegen_key), 1, fp.get()) != 1 || codegen_key != GetPersistentCacheCodeGenKey() ||
+      std::fread(&entry_count, sizeof(entry_count), 1, fp.get()) != 1)
+  {
+    Log_WarningFmt("Persistent block cache at '{}' is stale, it will be rewritten.", Path::GetFileName(filename));
+    return;
+  }
+
+  s_persistent_pending_blocks.resize(entry_count);
+  if (entry_count == 0 || std::fread(s_persistent_pending_blocks.data(), sizeof(PersistentBlockEntry), entry_count,
+                                     fp.get()) != entry_count)
+  {
+    Log_WarningFmt("Failed to read {} entries from '{}', corrupt file?", entry_count, Path::GetFileName(filename));
+    s_persistent_pending_blocks.clear();
+    return;
+  }
+
+  // keep sorted for the lookup in the compile path
+  std::sort(s_persistent_pending_blocks.begin(), s_persistent_pending_blocks.end(),
+            [](const PersistentBlockEntry& lhs, const PersistentBlockEntry& rhs) { return lhs.pc < rhs.pc; });
+
+  Log_InfoFmt("Loaded {} blocks from persistent cache.", s_persistent_pending_blocks.size());
+}
+
+bool CPU::CodeCache::IsPendingPersistentBlock(u32 pc)
+{
+  const auto iter =
+    std::lower_bound(s_persistent_pending_blocks.begin(), s_persistent_pending_blocks.end(), pc,
+                     [](const PersistentBlockEntry& lhs, u32 rhs) { return lhs.pc < rhs; });
+  return (iter != s_persistent_pending_blocks.end() && iter->pc == pc);
+}
+
+void CPU::CodeCache::PrecompilePersistentBlocks(u32 requested_pc)
+{
+  std::vector<PersistentBlockEntry> pending = std::move(s_persistent_pending_blocks);
+  s_persistent_pending_blocks = std::vector<PersistentBlockEntry>();
+
+  u32 compiled_count = 0;
+  for (const PersistentBlockEntry& entry : pending)
+  {
+    // The requested PC falls through to the normal compile path in our caller.
+    if (entry.pc == requested_pc)
+      continue;
+
+    const Block* block = LookupBlock(entry.pc);
+    if (block && block->state != BlockState::Invalidated && block->state != BlockState::NeedsRecompile)
+      continue;
+
+    // Only compile it if the same code is actually in memory right now. Anything else is probably
+    // part of an overlay which hasn't been loaded yet, so keep it pending for a later sweep.
+    u32 crc = static_cast<u32>(crc32(0, nullptr, 0));
+    u32 pc = entry.pc;
+    bool code_present = true;
+    for (u32 i = 0; i < entry.instruction_count; i++, pc += sizeof(Instruction))
+    {
+      u32 bits;
+      if (!SafeReadInstruction(pc, &bits))
+      {
+        code_present = false;
+        break;
+      }
+
+      crc = static_cast<u32>(crc32(crc, reinterpret_cast<const Bytef*>(&bits), sizeof(bits)));
+    }
+
+    if (!code_present || crc != entry.instruction_crc)
+    {
+      // appending in iteration order keeps the list sorted
+      s_persistent_pending_blocks.push_back(entry);
+      continue;
+    }
+
+    CompileOrRevalidateBlock(entry.pc);
+    compiled_count++;
+  }
+
+  if (compiled_count > 0)
+  {
+    Log_InfoFmt("Precompiled {} cached blocks ({} still pending).", compiled_count,
+                s_persistent_pending_blocks.size());
+  }
+}
+
+void CPU::CodeCache::SavePersistentBlockCache()
+{
+  if (System::GetGameHash() == 0)
+    return;
+
+  // Keep entries which never showed up this session (e.g. overlays the player didn't reach), otherwise
+  // the cache would decay to whatever the shortest session happened to touch.
+  std::vector<PersistentBlockEntry> entries = std::move(s_persistent_pending_blocks);
+  s_persistent_pending_blocks = std::vector<PersistentBlockEntry>();
+  entries.reserve(entries.size() + s_blocks.size());
+  for (const Block* block : s_blocks)
+  {
+    // The sweep recomputes the CRC from a contiguous fetch, which doesn't hold for traces, so don't
+    // persist them; they'll reform naturally once their head block gets hot again.
+    if (block->size == 0 || block->state == BlockState::FallbackToInterpreter || block->HasFlag(BlockFlags::Trace))
+      continue;
+
+    PersistentBlockEntry entry;
+    entry.pc = block->pc;
+    entry.instruction_count = block->size;
+    entry.instruction_crc =
+      static_cast<u32>(crc32(crc32(0, nullptr, 0), reinterpret_cast<const Bytef*>(block->Instructions()),
+                             block->size * sizeof(Instruction)));
+    entries.push_back(entry);
+  }
+
+  if (entries.empty())
+    return;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const PersistentBlockEntry& lhs, const PersistentBlockEntry& rhs) { return lhs.pc < rhs.pc; });
+
+  const std::string filename = GetPersistentCacheFilename();
+  auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "wb");
+  if (!fp)
+  {
+    Log_ErrorFmt("Failed to open '{}' for writing.", Path::GetFileName(filename));
+    return;
+  }
+
+  const u32 magic = PERSISTENT_BLOCK_CACHE_MAGIC;
+  const u32 version = PERSISTENT_BLOCK_CACHE_VERSION;
+  const u64 game_hash = System::GetGameHash();
+  const u32 codegen_key = GetPersistentCacheCodeGenKey();
+  const u32 entry_count = static_cast<u32>(entries.size());
+  if (std::fwrite(&magic, sizeof(magic), 1, fp.get()) != 1 ||
+      std::fwrite(&version, sizeof(version), 1, fp.get()) != 1 ||
+      std::fwrite(&game_hash, sizeof(game_hash), 1, fp.get()) != 1 ||
+      std::fwrite(&codegen_key, sizeof(codegen_key), 1, fp.get()) != 1 ||
+      std::fwrite(&entry_count, sizeof(entry_count), 1, fp.get()) != 1 ||
+      std::fwrite(entries.data(), sizeof(PersistentBlockEntry), entry_count, fp.get()) != entry_count)
+  {
+    Log_ErrorFmt("Failed to write persistent block cache to '{}'.", Path::GetFileName(filename));
+    return;
+  }
+
+  Log_DevFmt("Saved {} blocks to persistent cache.", entry_count);
+}
+
 #endif // ENABLE_RECOMPILER_SUPPORT
@@ -32,9 +32,20 @@ void Shutdown();
 /// Flushes the code cache, forcing all blocks to be recompiled.
 void Reset();
 
+/// Publishes any blocks finished by the asynchronous compiler thread. Call once per frame.
+void ProcessPendingCompilations();
+
+/// Returns the number of blocks compiled since process startup.
+u64 GetCompiledBlockCount();
+
 /// Invalidates all blocks which are in the range of the specified code page.
 void InvalidateBlocksWithPageIndex(u32 page_index);
 
+/// Invalidates only the blocks overlapping the chunk of the code page containing the written address.
+/// Used by the software write handlers, where the exact address is known; write faults from the
+/// protected fastmem views still invalidate the whole page.
+void InvalidateBlocksWithWriteAddress(PhysicalMemoryAddress address);
+
 /// Invalidates all blocks in the cache.
 void InvalidateAllRAMBlocks();
 
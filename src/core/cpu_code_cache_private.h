@@ -5,7 +5,9 @@
 
 #include "bus.h"
 #include "common/bitfield.h"
+#include "common/flat_hash_map.h"
 #include "common/perf_scope.h"
+#include "common/scratch_arena.h"
 #include "cpu_code_cache.h"
 #include "cpu_core_private.h"
 #include "cpu_types.h"
@@ -16,7 +18,6 @@
 #include <array>
 #include <map>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
 #ifdef ENABLE_RECOMPILER
@@ -36,7 +37,14 @@ enum : u32
 
 using CodeLUT = const void**;
 using CodeLUTArray = std::array<CodeLUT, LUT_TABLE_COUNT>;
-using BlockLinkMap = std::unordered_multimap<u32, void*>; // TODO: try ordered?
+
+// pc of the linked-to block -> location of the jump to patch. Flat so that backlinking/unlinking
+// during block churn doesn't chase node pointers.
+using BlockLinkMap = FlatHashMultiMap<u32, void*>;
+
+// Pre-decoded dispatch target for one guest instruction, reading its operands from
+// g_state.current_instruction like the switch-based interpreter.
+using InterpreterHandler = void (*)();
 
 enum RegInfoFlags : u8
 {
@@ -60,6 +68,10 @@ struct InstructionInfo
   bool has_load_delay : 1;
   bool can_trap : 1;
 
+  // GTE commands fully recompute FLAG, so a command's flag updates are dead when no cfc2 of FLAG
+  // occurs before the next command in the block. Set by FillBlockRegInfo().
+  bool gte_flags_dead : 1;
+
   u8 reg_flags[static_cast<u8>(Reg::count)];
   // Reg write_reg[3];
   Reg read_reg[3];
@@ -91,7 +103,9 @@ enum class BlockState : u8
   Valid,
   Invalidated,
   NeedsRecompile,
-  FallbackToInterpreter
+  FallbackToInterpreter,
+  Cold,    // tiered execution, interpreted until the hotness counter promotes it
+  IdleSkip // detected idle loop, interpreted once per timeslice and skipped ahead
 };
 
 enum class BlockFlags : u8
@@ -100,6 +114,8 @@ enum class BlockFlags : u8
   ContainsLoadStoreInstructions = (1 << 0),
   SpansPages = (1 << 1),
   BranchDelaySpansPages = (1 << 2),
+  IsIdleLoop = (1 << 3),
+  Trace = (1 << 4), // instruction stream crosses followed jumps, i.e. isn't contiguous in memory
 };
 IMPLEMENT_ENUM_CLASS_BITWISE_OPERATORS(BlockFlags);
 
@@ -113,6 +129,7 @@ enum class PageProtectionMode : u8
 struct BlockMetadata
 {
   TickCount uncached_fetch_ticks;
+  TickCount icache_fill_ticks; // cold-case cost of filling every line the block touches
   u32 icache_line_count;
   BlockFlags flags;
 };
@@ -131,7 +148,13 @@ struct alignas(16) Block
   // links to previous/next block within page
   Block* next_block_in_page;
 
-  BlockLinkMap::iterator exit_links[MAX_BLOCK_EXIT_LINKS];
+  // outgoing links, identified by (target pc, jump location) since map slots move on rehash
+  struct ExitLink
+  {
+    u32 newpc;
+    void* code;
+  };
+  ExitLink exit_links[MAX_BLOCK_EXIT_LINKS];
   u8 num_exit_links;
 
   // TODO: Move up so it's part of the same cache line
@@ -140,13 +163,19 @@ struct alignas(16) Block
   PageProtectionMode protection;
 
   TickCount uncached_fetch_ticks;
+  TickCount icache_fill_ticks;
   u32 icache_line_count;
 
   u32 host_code_size;
   u32 compile_frame;
   u8 compile_count;
+  u16 hot_count;
 
-  // followed by Instruction * size, InstructionRegInfo * size
+  // number of warm-up tier executions which left via the terminal branch rather than falling
+  // through, used for profile-guided successor ordering when the block compiles
+  u8 branch_taken_count;
+
+  // followed by Instruction * size, InstructionRegInfo * size, InterpreterHandler * size
   ALWAYS_INLINE const Instruction* Instructions() const { return reinterpret_cast<const Instruction*>(this + 1); }
   ALWAYS_INLINE Instruction* Instructions() { return reinterpret_cast<Instruction*>(this + 1); }
 
@@ -159,6 +188,15 @@ struct alignas(16) Block
     return reinterpret_cast<InstructionInfo*>(Instructions() + size);
   }
 
+  ALWAYS_INLINE const InterpreterHandler* Handlers() const
+  {
+    return reinterpret_cast<const InterpreterHandler*>(InstructionsInfo() + size);
+  }
+  ALWAYS_INLINE InterpreterHandler* Handlers()
+  {
+    return reinterpret_cast<InterpreterHandler*>(InstructionsInfo() + size);
+  }
+
   // returns true if the block has a given flag
   ALWAYS_INLINE bool HasFlag(BlockFlags flag) const { return ((flags & flag) != BlockFlags::None); }
 
@@ -214,18 +252,31 @@ static inline bool AddressInRAM(VirtualMemoryAddress pc)
   return VirtualAddressToPhysical(pc) < Bus::g_ram_size;
 }
 
+// Sub-page dirty granularity for write-protected pages. Each page is divided into a fixed number of
+// chunks (256 bytes with 4K host pages), and the page tracks which chunks actually contain code, so
+// software writes to data sitting next to code in the same page don't invalidate anything.
+enum : u32
+{
+  INVALIDATION_CHUNKS_PER_PAGE = 16,
+  INVALIDATION_CHUNK_SHIFT = HOST_PAGE_SHIFT - 4,
+};
+
 struct PageProtectionInfo
 {
   Block* first_block_in_page;
   Block* last_block_in_page;
 
   PageProtectionMode mode;
+  u16 code_chunk_mask;
   u16 invalidate_count;
   u32 invalidate_frame;
 };
-static_assert(sizeof(PageProtectionInfo) == (sizeof(Block*) * 2 + 8));
+static_assert(sizeof(PageProtectionInfo) <= (sizeof(Block*) * 2 + 16));
+
+/// Pre-decodes the block's instructions into handler pointers for the active PGXP mode.
+/// Blocks never outlive a PGXP mode change, the whole cache is flushed instead.
+void FillBlockInterpreterHandlers(Block* block);
 
-template<PGXPMode pgxp_mode>
 void InterpretCachedBlock(const Block* block);
 
 template<PGXPMode pgxp_mode>
@@ -241,14 +292,19 @@ void LogCurrentState();
 #define ENABLE_HOST_DISASSEMBLY 1
 #endif
 
-#if false
-// Enable profiling of JIT blocks.
+#ifdef __linux__
+// Enable profiling of JIT blocks. Only emits anything when DUCKSTATION_PERF_DUMP is set in the
+// environment, so it is cheap enough to leave enabled in shipping Linux builds.
 #define ENABLE_RECOMPILER_PROFILING 1
 #endif
 
 JitCodeBuffer& GetCodeBuffer();
 const void* GetInterpretUncachedBlockFunction();
 
+/// Arena for compilation-temporary data structures. Reset before each block compile, so anything
+/// allocated from it must not outlive the block being compiled.
+ScratchArena& GetScratchArena();
+
 void CompileOrRevalidateBlock(u32 start_pc);
 void DiscardAndRecompileBlock(u32 start_pc);
 const void* CreateBlockLink(Block* from_block, void* code, u32 newpc);
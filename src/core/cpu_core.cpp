@@ -68,9 +68,17 @@ static void HandlePutcSyscall();
 static void HandlePutsSyscall();
 static void ExecuteDebug();
 
-template<PGXPMode pgxp_mode, bool debug>
+template<PGXPMode pgxp_mode, bool debug, InstructionOp static_op = InstructionOp::count>
 static void ExecuteInstruction();
 
+template<PGXPMode pgxp_mode>
+static CodeCache::InterpreterHandler GetCachedInterpreterHandler(InstructionOp op);
+
+template<bool debug>
+static bool BeginInstruction();
+template<bool debug>
+static void FinishInstruction();
+
 template<PGXPMode pgxp_mode, bool debug>
 [[noreturn]] static void ExecuteImpl();
 
@@ -938,7 +946,7 @@ void CPU::DisassembleAndPrint(u32 addr, u32 instructions_before /* = 0 */, u32 i
   }
 }
 
-template<PGXPMode pgxp_mode, bool debug>
+template<PGXPMode pgxp_mode, bool debug, CPU::InstructionOp static_op>
 ALWAYS_INLINE_RELEASE void CPU::ExecuteInstruction()
 {
 restart_instruction:
@@ -961,7 +969,8 @@ restart_instruction:
   if (inst.bits == 0)
     return;
 
-  switch (inst.op)
+  // when instantiated for a known opcode by the threaded dispatcher, this folds to a single arm
+  switch ((static_op != InstructionOp::count) ? static_op : inst.op.GetValue())
   {
     case InstructionOp::funct:
     {
@@ -1939,7 +1948,16 @@ restart_instruction:
         Log_ErrorPrintf("Stale icache at 0x%08X - ICache: %08X RAM: %08X", g_state.current_instruction_pc,
                         g_state.current_instruction.bits, ram_value);
         g_state.current_instruction.bits = ram_value;
-        goto restart_instruction;
+        if constexpr (static_op == InstructionOp::count)
+        {
+          goto restart_instruction;
+        }
+        else
+        {
+          // the refetched instruction can be anything, so redispatch dynamically
+          ExecuteInstruction<pgxp_mode, debug>();
+          return;
+        }
       }
 
       RaiseException(Exception::RI);
@@ -2282,74 +2300,170 @@ ALWAYS_INLINE_RELEASE void CPU::MemoryBreakpointCheck(VirtualMemoryAddress addre
     s_break_after_instruction = true;
 }
 
+template<bool debug>
+ALWAYS_INLINE_RELEASE bool CPU::BeginInstruction()
+{
+  if constexpr (debug)
+  {
+    Cop0ExecutionBreakpointCheck();
+    ExecutionBreakpointCheck();
+  }
+
+  g_state.pending_ticks++;
+
+  // now executing the instruction we previously fetched
+  g_state.current_instruction.bits = g_state.next_instruction.bits;
+  g_state.current_instruction_pc = g_state.pc;
+  g_state.current_instruction_in_branch_delay_slot = g_state.next_instruction_is_branch_delay_slot;
+  g_state.current_instruction_was_branch_taken = g_state.branch_was_taken;
+  g_state.next_instruction_is_branch_delay_slot = false;
+  g_state.branch_was_taken = false;
+  g_state.exception_raised = false;
+
+  // fetch the next instruction - even if this fails, it'll still refetch on the flush so we can continue
+  if (!FetchInstruction())
+    return false;
+
+  // trace functionality
+  if constexpr (debug)
+  {
+    if (s_trace_to_log)
+      LogInstruction(g_state.current_instruction.bits, g_state.current_instruction_pc, true);
+
+    if (g_state.current_instruction_pc == 0xA0) [[unlikely]]
+      HandleA0Syscall();
+    else if (g_state.current_instruction_pc == 0xB0) [[unlikely]]
+      HandleB0Syscall();
+  }
+
+  return true;
+}
+
+template<bool debug>
+ALWAYS_INLINE_RELEASE void CPU::FinishInstruction()
+{
+  // next load delay
+  UpdateLoadDelay();
+
+  if constexpr (debug)
+  {
+    if (s_break_after_instruction)
+    {
+      s_break_after_instruction = false;
+      System::PauseSystem(true);
+      UpdateDebugDispatcherFlag();
+      ExitExecution();
+    }
+  }
+}
+
 template<PGXPMode pgxp_mode, bool debug>
 [[noreturn]] void CPU::ExecuteImpl()
 {
+#ifndef ENABLE_THREADED_INTERPRETER
+
   for (;;)
   {
     TimingEvents::RunEvents();
 
     while (g_state.pending_ticks < g_state.downcount)
     {
-      if constexpr (debug)
-      {
-        Cop0ExecutionBreakpointCheck();
-        ExecutionBreakpointCheck();
-      }
-
-      g_state.pending_ticks++;
-
-      // now executing the instruction we previously fetched
-      g_state.current_instruction.bits = g_state.next_instruction.bits;
-      g_state.current_instruction_pc = g_state.pc;
-      g_state.current_instruction_in_branch_delay_slot = g_state.next_instruction_is_branch_delay_slot;
-      g_state.current_instruction_was_branch_taken = g_state.branch_was_taken;
-      g_state.next_instruction_is_branch_delay_slot = false;
-      g_state.branch_was_taken = false;
-      g_state.exception_raised = false;
-
-      // fetch the next instruction - even if this fails, it'll still refetch on the flush so we can continue
-      if (!FetchInstruction())
+      if (!BeginInstruction<debug>())
         continue;
 
-      // trace functionality
-      if constexpr (debug)
-      {
-        if (s_trace_to_log)
-          LogInstruction(g_state.current_instruction.bits, g_state.current_instruction_pc, true);
-
-        if (g_state.current_instruction_pc == 0xA0) [[unlikely]]
-          HandleA0Syscall();
-        else if (g_state.current_instruction_pc == 0xB0) [[unlikely]]
-          HandleB0Syscall();
-      }
-
-#if 0 // GTE flag test debugging
-      if (g_state.m_current_instruction_pc == 0x8002cdf4)
-      {
-        if (g_state.m_regs.v1 != g_state.m_regs.v0)
-          printf("Got %08X Expected? %08X\n", g_state.m_regs.v1, g_state.m_regs.v0);
-      }
-#endif
-
       // execute the instruction we previously fetched
       ExecuteInstruction<pgxp_mode, debug>();
 
-      // next load delay
-      UpdateLoadDelay();
-
-      if constexpr (debug)
-      {
-        if (s_break_after_instruction)
-        {
-          s_break_after_instruction = false;
-          System::PauseSystem(true);
-          UpdateDebugDispatcherFlag();
-          ExitExecution();
-        }
-      }
+      FinishInstruction<debug>();
     }
   }
+
+#else
+
+  // Threaded dispatch: every opcode handler ends with its own indirect jump to the next handler,
+  // so the host branch predictor can track per-opcode successor patterns instead of funneling
+  // every instruction through a single dispatch branch. Unassigned encodings share the invalid
+  // handler, which also covers the stale-icache redispatch.
+  static const void* const dispatch_table[64] = {
+    &&op_funct,   &&op_b,       &&op_j,       &&op_jal,     // 0x00
+    &&op_beq,     &&op_bne,     &&op_blez,    &&op_bgtz,    // 0x04
+    &&op_addi,    &&op_addiu,   &&op_slti,    &&op_sltiu,   // 0x08
+    &&op_andi,    &&op_ori,     &&op_xori,    &&op_lui,     // 0x0C
+    &&op_cop0,    &&op_nop,     &&op_cop2,    &&op_nop,     // 0x10
+    &&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid, // 0x14
+    &&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid, // 0x18
+    &&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid, // 0x1C
+    &&op_lb,      &&op_lh,      &&op_lwl,     &&op_lw,      // 0x20
+    &&op_lbu,     &&op_lhu,     &&op_lwr,     &&op_invalid, // 0x24
+    &&op_sb,      &&op_sh,      &&op_swl,     &&op_sw,      // 0x28
+    &&op_invalid, &&op_invalid, &&op_swr,     &&op_invalid, // 0x2C
+    &&op_nop,     &&op_nop,     &&op_lwc2,    &&op_nop,     // 0x30
+    &&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid, // 0x34
+    &&op_nop,     &&op_nop,     &&op_swc2,    &&op_nop,     // 0x38
+    &&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid, // 0x3C
+  };
+
+run_events:
+  TimingEvents::RunEvents();
+
+dispatch:
+  if (g_state.pending_ticks >= g_state.downcount)
+    goto run_events;
+  if (!BeginInstruction<debug>()) [[unlikely]]
+    goto dispatch;
+  goto* dispatch_table[static_cast<u8>(g_state.current_instruction.op.GetValue())];
+
+#define OP_HANDLER(name, static_op)                                                                                    \
+  op_##name:                                                                                                           \
+  {                                                                                                                    \
+    ExecuteInstruction<pgxp_mode, debug, static_op>();                                                                 \
+    FinishInstruction<debug>();                                                                                        \
+    if (g_state.pending_ticks >= g_state.downcount) [[unlikely]]                                                       \
+      goto run_events;                                                                                                 \
+    if (!BeginInstruction<debug>()) [[unlikely]]                                                                       \
+      goto dispatch;                                                                                                   \
+    goto* dispatch_table[static_cast<u8>(g_state.current_instruction.op.GetValue())];                                  \
+  }
+
+  OP_HANDLER(funct, InstructionOp::funct)
+  OP_HANDLER(b, InstructionOp::b)
+  OP_HANDLER(j, InstructionOp::j)
+  OP_HANDLER(jal, InstructionOp::jal)
+  OP_HANDLER(beq, InstructionOp::beq)
+  OP_HANDLER(bne, InstructionOp::bne)
+  OP_HANDLER(blez, InstructionOp::blez)
+  OP_HANDLER(bgtz, InstructionOp::bgtz)
+  OP_HANDLER(addi, InstructionOp::addi)
+  OP_HANDLER(addiu, InstructionOp::addiu)
+  OP_HANDLER(slti, InstructionOp::slti)
+  OP_HANDLER(sltiu, InstructionOp::sltiu)
+  OP_HANDLER(andi, InstructionOp::andi)
+  OP_HANDLER(ori, InstructionOp::ori)
+  OP_HANDLER(xori, InstructionOp::xori)
+  OP_HANDLER(lui, InstructionOp::lui)
+  OP_HANDLER(cop0, InstructionOp::cop0)
+  OP_HANDLER(cop2, InstructionOp::cop2)
+  OP_HANDLER(lb, InstructionOp::lb)
+  OP_HANDLER(lh, InstructionOp::lh)
+  OP_HANDLER(lwl, InstructionOp::lwl)
+  OP_HANDLER(lw, InstructionOp::lw)
+  OP_HANDLER(lbu, InstructionOp::lbu)
+  OP_HANDLER(lhu, InstructionOp::lhu)
+  OP_HANDLER(lwr, InstructionOp::lwr)
+  OP_HANDLER(sb, InstructionOp::sb)
+  OP_HANDLER(sh, InstructionOp::sh)
+  OP_HANDLER(swl, InstructionOp::swl)
+  OP_HANDLER(sw, InstructionOp::sw)
+  OP_HANDLER(swr, InstructionOp::swr)
+  OP_HANDLER(lwc2, InstructionOp::lwc2)
+  OP_HANDLER(swc2, InstructionOp::swc2)
+  // cop1/cop3/lwc0/lwc1/lwc3/swc0/swc1/swc3 are all the same no-op arm
+  OP_HANDLER(nop, InstructionOp::cop1)
+  OP_HANDLER(invalid, static_cast<InstructionOp>(0x3F))
+
+#undef OP_HANDLER
+
+#endif // ENABLE_THREADED_INTERPRETER
 }
 
 void CPU::ExecuteDebug()
@@ -2430,6 +2544,55 @@ void CPU::SetSingleStepFlag()
 }
 
 template<PGXPMode pgxp_mode>
+CPU::CodeCache::InterpreterHandler CPU::GetCachedInterpreterHandler(InstructionOp op)
+{
+  // Mirrors the dispatch switch in ExecuteInstruction; unassigned encodings share the invalid
+  // handler, which performs the stale-icache check and raises the exception the same way the
+  // dynamic path does.
+  static constexpr InstructionOp invalid = static_cast<InstructionOp>(0x3F);
+#define OP(name) (&ExecuteInstruction<pgxp_mode, false, InstructionOp::name>)
+#define OP_INVALID (&ExecuteInstruction<pgxp_mode, false, invalid>)
+  static constexpr CodeCache::InterpreterHandler handlers[64] = {
+    OP(funct),  OP(b),      OP(j),      OP(jal),    OP(beq),    OP(bne),    OP(blez),   OP(bgtz),   // 0x00
+    OP(addi),   OP(addiu),  OP(slti),   OP(sltiu),  OP(andi),   OP(ori),    OP(xori),   OP(lui),    // 0x08
+    OP(cop0),   OP(cop1),   OP(cop2),   OP(cop3),   OP_INVALID, OP_INVALID, OP_INVALID, OP_INVALID, // 0x10
+    OP_INVALID, OP_INVALID, OP_INVALID, OP_INVALID, OP_INVALID, OP_INVALID, OP_INVALID, OP_INVALID, // 0x18
+    OP(lb),     OP(lh),     OP(lwl),    OP(lw),     OP(lbu),    OP(lhu),    OP(lwr),    OP_INVALID, // 0x20
+    OP(sb),     OP(sh),     OP(swl),    OP(sw),     OP_INVALID, OP_INVALID, OP(swr),    OP_INVALID, // 0x28
+    OP(lwc0),   OP(lwc1),   OP(lwc2),   OP(lwc3),   OP_INVALID, OP_INVALID, OP_INVALID, OP_INVALID, // 0x30
+    OP(swc0),   OP(swc1),   OP(swc2),   OP(swc3),   OP_INVALID, OP_INVALID, OP_INVALID, OP_INVALID, // 0x38
+  };
+#undef OP_INVALID
+#undef OP
+
+  return handlers[static_cast<u8>(op)];
+}
+
+void CPU::CodeCache::FillBlockInterpreterHandlers(Block* block)
+{
+  const Instruction* instruction = block->Instructions();
+  InterpreterHandler* handler = block->Handlers();
+
+  if (g_settings.gpu_pgxp_enable)
+  {
+    if (g_settings.gpu_pgxp_cpu)
+    {
+      for (u32 i = 0; i < block->size; i++)
+        handler[i] = GetCachedInterpreterHandler<PGXPMode::CPU>(instruction[i].op);
+    }
+    else
+    {
+      for (u32 i = 0; i < block->size; i++)
+        handler[i] = GetCachedInterpreterHandler<PGXPMode::Memory>(instruction[i].op);
+    }
+  }
+  else
+  {
+    for (u32 i = 0; i < block->size; i++)
+      handler[i] = GetCachedInterpreterHandler<PGXPMode::Disabled>(instruction[i].op);
+  }
+}
+
 void CPU::CodeCache::InterpretCachedBlock(const Block* block)
 {
   // set up the state so we've already fetched the instruction
@@ -2439,6 +2602,7 @@ void CPU::CodeCache::InterpretCachedBlock(const Block* block)
   const Instruction* instruction = block->Instructions();
   const Instruction* end_instruction = instruction + block->size;
   const CodeCache::InstructionInfo* info = block->InstructionsInfo();
+  const CodeCache::InterpreterHandler* handler = block->Handlers();
 
   do
   {
@@ -2456,8 +2620,8 @@ void CPU::CodeCache::InterpretCachedBlock(const Block* block)
     g_state.pc = g_state.npc;
     g_state.npc += 4;
 
-    // execute the instruction we previously fetched
-    ExecuteInstruction<pgxp_mode, false>();
+    // execute the pre-decoded handler for the instruction we previously fetched
+    (*handler)();
 
     // next load delay
     UpdateLoadDelay();
@@ -2467,16 +2631,13 @@ void CPU::CodeCache::InterpretCachedBlock(const Block* block)
 
     instruction++;
     info++;
+    handler++;
   } while (instruction != end_instruction);
 
   // cleanup so the interpreter can kick in if needed
   g_state.next_instruction_is_branch_delay_slot = false;
 }
 
-template void CPU::CodeCache::InterpretCachedBlock<PGXPMode::Disabled>(const Block* block);
-template void CPU::CodeCache::InterpretCachedBlock<PGXPMode::Memory>(const Block* block);
-template void CPU::CodeCache::InterpretCachedBlock<PGXPMode::CPU>(const Block* block);
-
 template<PGXPMode pgxp_mode>
 void CPU::CodeCache::InterpretUncachedBlock()
 {
@@ -2653,29 +2814,47 @@ TickCount CPU::GetICacheFillTicks(VirtualMemoryAddress address)
   }
 }
 
-void CPU::CheckAndUpdateICacheTags(u32 line_count, TickCount uncached_ticks)
+void CPU::CheckAndUpdateICacheTags(u32 line_count, TickCount uncached_ticks, TickCount fill_ticks)
 {
   VirtualMemoryAddress current_pc = g_state.pc & ICACHE_TAG_ADDRESS_MASK;
-  if (IsCachedAddress(current_pc))
+  if (!IsCachedAddress(current_pc))
+  {
+    g_state.pending_ticks += uncached_ticks;
+    return;
+  }
+
+  // Almost every execution is either all-hit (hot loop) or all-miss (first run, post-flush), so
+  // check the tags branchlessly first and charge those two cases with the block's precomputed
+  // totals instead of accumulating per line.
+  u32 misses = 0;
+  VirtualMemoryAddress check_pc = current_pc;
+  for (u32 i = 0; i < line_count; i++, check_pc += ICACHE_LINE_SIZE)
+    misses += BoolToUInt32(g_state.icache_tags[GetICacheLine(check_pc)] != check_pc);
+  if (misses == 0)
+    return;
+
+  if (misses == line_count)
   {
-    TickCount ticks = 0;
-    TickCount cached_ticks_per_line = GetICacheFillTicks(current_pc);
     for (u32 i = 0; i < line_count; i++, current_pc += ICACHE_LINE_SIZE)
-    {
-      const u32 line = GetICacheLine(current_pc);
-      if (g_state.icache_tags[line] != current_pc)
-      {
-        g_state.icache_tags[line] = current_pc;
-        ticks += cached_ticks_per_line;
-      }
-    }
+      g_state.icache_tags[GetICacheLine(current_pc)] = current_pc;
 
-    g_state.pending_ticks += ticks;
+    g_state.pending_ticks += fill_ticks;
+    return;
   }
-  else
+
+  TickCount ticks = 0;
+  const TickCount cached_ticks_per_line = GetICacheFillTicks(current_pc);
+  for (u32 i = 0; i < line_count; i++, current_pc += ICACHE_LINE_SIZE)
   {
-    g_state.pending_ticks += uncached_ticks;
+    const u32 line = GetICacheLine(current_pc);
+    if (g_state.icache_tags[line] != current_pc)
+    {
+      g_state.icache_tags[line] = current_pc;
+      ticks += cached_ticks_per_line;
+    }
   }
+
+  g_state.pending_ticks += ticks;
 }
 
 u32 CPU::FillICache(VirtualMemoryAddress address)
@@ -2938,8 +3117,9 @@ ALWAYS_INLINE bool CPU::DoSafeMemoryAccess(VirtualMemoryAddress address, u32& va
         if (g_unprotected_ram[offset] != Truncate8(value))
         {
           g_unprotected_ram[offset] = Truncate8(value);
+          MarkRAMPageDirty(page_index);
           if (g_ram_code_bits[page_index])
-            CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
+            CPU::CodeCache::InvalidateBlocksWithWriteAddress(offset);
         }
       }
       else if constexpr (size == MemoryAccessSize::HalfWord)
@@ -2950,8 +3130,9 @@ ALWAYS_INLINE bool CPU::DoSafeMemoryAccess(VirtualMemoryAddress address, u32& va
         if (old_value != new_value)
         {
           std::memcpy(&g_unprotected_ram[offset], &new_value, sizeof(u16));
+          MarkRAMPageDirty(page_index);
           if (g_ram_code_bits[page_index])
-            CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
+            CPU::CodeCache::InvalidateBlocksWithWriteAddress(offset);
         }
       }
       else if constexpr (size == MemoryAccessSize::Word)
@@ -2961,8 +3142,9 @@ ALWAYS_INLINE bool CPU::DoSafeMemoryAccess(VirtualMemoryAddress address, u32& va
         if (old_value != value)
         {
           std::memcpy(&g_unprotected_ram[offset], &value, sizeof(u32));
+          MarkRAMPageDirty(page_index);
           if (g_ram_code_bits[page_index])
-            CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
+            CPU::CodeCache::InvalidateBlocksWithWriteAddress(offset);
         }
       }
     }
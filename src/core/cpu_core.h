@@ -50,7 +50,9 @@ union CacheControl
   BitField<u32, bool, 11, 1> icache_enable;
 };
 
-struct PGXP_value
+// Aligned so the x/y/z/value block never straddles a cache line and can be moved as a single
+// aligned vector by the recompiler's inlined copies.
+struct alignas(16) PGXP_value
 {
   float x;
   float y;
@@ -60,6 +60,11 @@ void CPU::NewRec::Compiler::Reset(CodeCache::Block* block, u8* code_buffer, u32
   m_load_delay_register = Reg::count;
   m_load_delay_value_register = NUM_HOST_REGS;
 
+  // The scratch arena was reset since the last block, so anything the old map held is gone.
+  // It was cleared at the end of the previous compile, and re-creating it here drops the stale
+  // bucket array before the arena starts handing its memory out again.
+  m_speculative_constants.memory = SpecMemoryMap(SpecMemoryMap::allocator_type(CodeCache::GetScratchArena()));
+
   InitSpeculativeRegs();
 }
 
@@ -124,8 +129,10 @@ const void* CPU::NewRec::Compiler::CompileBlock(CodeCache::Block* block, u32* ho
 
     inst++;
     iinfo++;
-    m_current_instruction_pc += sizeof(Instruction);
-    m_compiler_pc += sizeof(Instruction);
+
+    // Not necessarily contiguous - the decoder follows unconditional jumps when forming traces.
+    m_current_instruction_pc = iinfo->pc;
+    m_compiler_pc = iinfo->pc + sizeof(Instruction);
     m_dirty_pc = true;
     m_dirty_instruction_bits = true;
   }
@@ -339,6 +346,35 @@ u32 CPU::NewRec::Compiler::GetBranchReturnAddress(CompileFlags cf) const
   return m_compiler_pc + (cf.delay_slot_swapped ? 0 : sizeof(Instruction));
 }
 
+CPU::NewRec::Compiler::BranchCondition CPU::NewRec::Compiler::InvertBranchCondition(BranchCondition cond)
+{
+  switch (cond)
+  {
+    case BranchCondition::Equal:
+      return BranchCondition::NotEqual;
+    case BranchCondition::NotEqual:
+      return BranchCondition::Equal;
+    case BranchCondition::GreaterThanZero:
+      return BranchCondition::LessEqualZero;
+    case BranchCondition::GreaterEqualZero:
+      return BranchCondition::LessThanZero;
+    case BranchCondition::LessThanZero:
+      return BranchCondition::GreaterEqualZero;
+    case BranchCondition::LessEqualZero:
+      return BranchCondition::GreaterThanZero;
+    default:
+      return cond;
+  }
+}
+
+bool CPU::NewRec::Compiler::IsBranchProfiledTaken() const
+{
+  // Outcomes are only recorded while the block runs in the interpreter warm-up tier; blocks
+  // compiled without a warm-up keep the static not-taken-first layout.
+  const u32 executions = m_block->hot_count;
+  return (executions > 0 && (static_cast<u32>(m_block->branch_taken_count) * 2) > executions);
+}
+
 bool CPU::NewRec::Compiler::TrySwapDelaySlot(Reg rs, Reg rt, Reg rd)
 {
   if constexpr (!SWAP_BRANCH_DELAY_SLOTS)
@@ -872,6 +908,45 @@ void CPU::NewRec::Compiler::FlushHostReg(u32 reg)
   }
 }
 
+void CPU::NewRec::Compiler::StoreHostRegPairToCPUPointer(u32 reg1, u32 reg2, const void* ptr)
+{
+  StoreHostRegToCPUPointer(reg1, ptr);
+  StoreHostRegToCPUPointer(reg2, static_cast<const u8*>(ptr) + sizeof(u32));
+}
+
+void CPU::NewRec::Compiler::FlushAdjacentDirtyGuestRegPairs(u32 req_mask, u32 req_flags)
+{
+  // Map out which guest registers the caller is about to write back, so adjacent state slots can
+  // go out as a single paired store. MIPS code works on neighbouring registers (a0/a1, s0/s1, ...)
+  // often enough for this to fire at most block boundaries.
+  u8 guest_to_host[static_cast<u8>(Reg::count)];
+  std::memset(guest_to_host, 0xFF, sizeof(guest_to_host));
+  for (u32 i = 0; i < NUM_HOST_REGS; i++)
+  {
+    const HostRegAlloc& ra = m_host_regs[i];
+    if ((ra.flags & req_mask) == req_flags && (ra.flags & HR_MODE_WRITE) && ra.type == HR_TYPE_CPU_REG)
+      guest_to_host[static_cast<u8>(ra.reg)] = static_cast<u8>(i);
+  }
+
+  for (u32 i = 1; i < (static_cast<u32>(Reg::count) - 1); i++)
+  {
+    const u8 h1 = guest_to_host[i];
+    const u8 h2 = guest_to_host[i + 1];
+    if (h1 == 0xFF || h2 == 0xFF)
+      continue;
+
+    Log_DebugPrintf("Flushing register pair %s/%s in host registers %s/%s to state",
+                    GetRegName(static_cast<Reg>(i)), GetRegName(static_cast<Reg>(i + 1)), GetHostRegName(h1),
+                    GetHostRegName(h2));
+    StoreHostRegPairToCPUPointer(h1, h2, &g_state.regs.r[i]);
+    m_host_regs[h1].flags = (m_host_regs[h1].flags & ~HR_MODE_WRITE) | HR_MODE_READ;
+    m_host_regs[h2].flags = (m_host_regs[h2].flags & ~HR_MODE_WRITE) | HR_MODE_READ;
+
+    // both registers are clean now, skip over the second
+    i++;
+  }
+}
+
 void CPU::NewRec::Compiler::FreeHostReg(u32 reg)
 {
   DebugAssert(IsHostRegAllocated(reg));
@@ -1058,6 +1133,8 @@ void CPU::NewRec::Compiler::Flush(u32 flags)
                                                                           (HR_ALLOCATED | HR_CALLEE_SAVED | HR_NEEDED));
     constexpr u32 req_flags = HR_ALLOCATED;
 
+    FlushAdjacentDirtyGuestRegPairs(req_mask, req_flags);
+
     for (u32 i = 0; i < NUM_HOST_REGS; i++)
     {
       HostRegAlloc& ra = m_host_regs[i];
@@ -1068,6 +1145,8 @@ void CPU::NewRec::Compiler::Flush(u32 flags)
 
   if (flags & FLUSH_INVALIDATE_MIPS_REGISTERS)
   {
+    FlushAdjacentDirtyGuestRegPairs(HR_ALLOCATED, HR_ALLOCATED);
+
     for (u32 i = 0; i < NUM_HOST_REGS; i++)
     {
       HostRegAlloc& ra = m_host_regs[i];
@@ -1081,6 +1160,8 @@ void CPU::NewRec::Compiler::Flush(u32 flags)
   {
     if (flags & FLUSH_FLUSH_MIPS_REGISTERS)
     {
+      FlushAdjacentDirtyGuestRegPairs(HR_ALLOCATED | HR_MODE_WRITE, HR_ALLOCATED | HR_MODE_WRITE);
+
       for (u32 i = 0; i < NUM_HOST_REGS; i++)
       {
         HostRegAlloc& ra = m_host_regs[i];
@@ -1727,6 +1808,23 @@ void CPU::NewRec::Compiler::FlushForLoadStore(const std::optional<VirtualMemoryA
   Flush(FLUSH_FOR_C_CALL | FLUSH_FOR_LOADSTORE);
 }
 
+std::optional<u32> CPU::NewRec::Compiler::GetScratchpadOffsetForAddress(
+  const std::optional<VirtualMemoryAddress>& address, MemoryAccessSize size)
+{
+  // Same rules as the old recompiler's direct-pointer path: the address has to be known at compile
+  // time and the cache can't be speculatively isolated, since isolation reroutes scratchpad
+  // accesses through the cache handlers. Misaligned accesses would fault, so they also take the
+  // generic path, which means the direct access can never raise an exception. Stores need no SMC
+  // checks, the scratchpad never holds code.
+  if (!address.has_value() || (address.value() & SCRATCHPAD_ADDR_MASK) != SCRATCHPAD_ADDR ||
+      (address.value() & ((1u << static_cast<u32>(size)) - 1u)) != 0 || SpecIsCacheIsolated())
+  {
+    return std::nullopt;
+  }
+
+  return address.value() & SCRATCHPAD_OFFSET_MASK;
+}
+
 void CPU::NewRec::Compiler::CompileMoveRegTemplate(Reg dst, Reg src, bool pgxp_move)
 {
   if (dst == src || dst == Reg::zero)
@@ -1750,11 +1848,14 @@ void CPU::NewRec::Compiler::CompileMoveRegTemplate(Reg dst, Reg src, bool pgxp_m
 
   // TODO: This could be made better if we only did it for registers where there was a previous MFC2.
   if (g_settings.gpu_pgxp_enable && pgxp_move)
-  {
-    // might've been renamed, so use dst here
-    GeneratePGXPCallWithMIPSRegs(reinterpret_cast<const void*>(&PGXP::CPU_MOVE_Packed), PGXP::PackMoveArgs(dst, src),
-                                 dst);
-  }
+    GeneratePGXPMove(dst, src);
+}
+
+void CPU::NewRec::Compiler::GeneratePGXPMove(Reg dst, Reg src)
+{
+  // might've been renamed, so use dst here
+  GeneratePGXPCallWithMIPSRegs(reinterpret_cast<const void*>(&PGXP::CPU_MOVE_Packed), PGXP::PackMoveArgs(dst, src),
+                               dst);
 }
 
 void CPU::NewRec::Compiler::Compile_j()
@@ -1764,6 +1865,12 @@ void CPU::NewRec::Compiler::Compile_j()
   // TODO: Delay slot swap.
   // We could also move the cycle commit back.
   CompileBranchDelaySlot();
+
+  // If the decoder followed this jump to form a trace, the target is simply the next instruction in
+  // the block, so keep compiling with the register cache intact instead of ending here.
+  if (!iinfo->is_last_instruction && iinfo[1].pc == newpc)
+    return;
+
   EndBlock(newpc, true);
 }
 
@@ -1786,6 +1893,11 @@ void CPU::NewRec::Compiler::Compile_jal()
   const u32 newpc = (m_compiler_pc & UINT32_C(0xF0000000)) | (inst->j.target << 2);
   SetConstantReg(Reg::ra, GetBranchReturnAddress({}));
   CompileBranchDelaySlot();
+
+  // Trace continuation, same as Compile_j().
+  if (!iinfo->is_last_instruction && iinfo[1].pc == newpc)
+    return;
+
   EndBlock(newpc, true);
 }
 
@@ -8,6 +8,7 @@
 #include <array>
 #include <bitset>
 #include <optional>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -197,6 +198,8 @@ protected:
   Reg MipsD() const;
   u32 GetConditionalBranchTarget(CompileFlags cf) const;
   u32 GetBranchReturnAddress(CompileFlags cf) const;
+  static BranchCondition InvertBranchCondition(BranchCondition cond);
+  bool IsBranchProfiledTaken() const;
   bool TrySwapDelaySlot(Reg rs = Reg::zero, Reg rt = Reg::zero, Reg rd = Reg::zero);
   void SetCompilerPC(u32 newpc);
   void TruncateBlock();
@@ -222,6 +225,7 @@ protected:
   u32 AllocateTempHostReg(u32 flags = 0);
   void SwapHostRegAlloc(u32 lhs, u32 rhs);
   void FlushHostReg(u32 reg);
+  void FlushAdjacentDirtyGuestRegPairs(u32 req_mask, u32 req_flags);
   void FreeHostReg(u32 reg);
   void ClearHostReg(u32 reg);
   void MarkRegsNeeded(HostRegAllocType type, Reg reg);
@@ -236,6 +240,11 @@ protected:
   virtual void LoadHostRegFromCPUPointer(u32 reg, const void* ptr) = 0;
   virtual void StoreConstantToCPUPointer(u32 val, const void* ptr) = 0;
   virtual void StoreHostRegToCPUPointer(u32 reg, const void* ptr) = 0;
+
+  /// Stores two host registers to consecutive u32 state slots starting at ptr. Backends with
+  /// paired stores override this; the default emits two single stores.
+  virtual void StoreHostRegPairToCPUPointer(u32 reg1, u32 reg2, const void* ptr);
+
   virtual void CopyHostReg(u32 dst, u32 src) = 0;
   virtual void Flush(u32 flags);
 
@@ -273,11 +282,20 @@ protected:
                                                        const std::optional<VirtualMemoryAddress>&),
                                 MemoryAccessSize size, bool store, bool sign, u32 tflags);
   void FlushForLoadStore(const std::optional<VirtualMemoryAddress>& address, bool store, bool use_fastmem);
+
+  /// Returns the byte offset into the scratchpad when a compile-time-known address can be turned into
+  /// a direct host access against g_state.scratchpad, or nullopt to use the generic memory path.
+  std::optional<u32> GetScratchpadOffsetForAddress(const std::optional<VirtualMemoryAddress>& address,
+                                                   MemoryAccessSize size);
   void CompileMoveRegTemplate(Reg dst, Reg src, bool pgxp_move);
 
   virtual void GeneratePGXPCallWithMIPSRegs(const void* func, u32 arg1val, Reg arg2reg = Reg::count,
                                             Reg arg3reg = Reg::count) = 0;
 
+  /// Propagates the PGXP state for a register move. The default goes through
+  /// PGXP::CPU_MOVE_Packed(), backends can override it with an inline copy.
+  virtual void GeneratePGXPMove(Reg dst, Reg src);
+
   virtual void Compile_Fallback() = 0;
 
   void Compile_j();
@@ -463,10 +481,17 @@ protected:
   // Speculative Constants
   //////////////////////////////////////////////////////////////////////////
   using SpecValue = std::optional<u32>;
+
+  // Backed by the compile scratch arena; re-created in Reset() since the arena is reset between
+  // blocks while the compiler object persists.
+  using SpecMemoryMap = std::unordered_map<PhysicalMemoryAddress, SpecValue, std::hash<PhysicalMemoryAddress>,
+                                           std::equal_to<PhysicalMemoryAddress>,
+                                           ScratchAllocator<std::pair<const PhysicalMemoryAddress, SpecValue>>>;
+
   struct SpeculativeConstants
   {
     std::array<SpecValue, static_cast<u8>(Reg::count)> regs;
-    std::unordered_map<PhysicalMemoryAddress, SpecValue> memory;
+    SpecMemoryMap memory{SpecMemoryMap::allocator_type(CodeCache::GetScratchArena())};
     SpecValue cop0_sr;
   };
 
@@ -6,6 +6,7 @@
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/string_util.h"
+#include "common/thirdparty/SmallVector.h"
 #include "cpu_core_private.h"
 #include "cpu_pgxp.h"
 #include "cpu_recompiler_thunks.h"
@@ -308,39 +309,79 @@ void CPU::NewRec::AArch32Compiler::GenerateICacheCheckAndUpdate()
     armAsm->add(RARG1, RARG1, armCheckAddSubConstant(static_cast<u32>(m_block->uncached_fetch_ticks)));
     armAsm->str(RARG1, PTR(&g_state.pending_ticks));
   }
-  else
+  else if (m_block->icache_line_count > 0)
   {
-    const auto& ticks_reg = RARG1;
-    const auto& current_tag_reg = RARG2;
-    const auto& existing_tag_reg = RARG3;
-
+    // Gather the lines with a fill cost up front, so the hot path is nothing but a compare chain.
+    struct LineInfo
+    {
+      u32 offset;
+      u32 tag;
+      TickCount fill_ticks;
+    };
+    llvm::SmallVector<LineInfo, 16> lines;
     VirtualMemoryAddress current_pc = m_block->pc & ICACHE_TAG_ADDRESS_MASK;
-    armAsm->ldr(ticks_reg, PTR(&g_state.pending_ticks));
-    armEmitMov(armAsm, current_tag_reg, current_pc);
-
     for (u32 i = 0; i < m_block->icache_line_count; i++, current_pc += ICACHE_LINE_SIZE)
     {
       const TickCount fill_ticks = GetICacheFillTicks(current_pc);
       if (fill_ticks <= 0)
         continue;
 
-      const u32 line = GetICacheLine(current_pc);
-      const u32 offset = offsetof(State, icache_tags) + (line * sizeof(u32));
+      lines.push_back(
+        {static_cast<u32>(offsetof(State, icache_tags) + (GetICacheLine(current_pc) * sizeof(u32))),
+         GetICacheTagForAddress(current_pc), fill_ticks});
+    }
+    if (lines.empty())
+      return;
+
+    // All-hit is the overwhelmingly common case, so compare all tags and fall through with zero
+    // cost; any mismatch takes the far path, which does the precise per-line update and jumps back.
+    const void* const slowpath = m_far_emitter.GetCursorAddress<const void*>();
+    armEmitMov(armAsm, RARG1, lines.front().tag);
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+      const LineInfo& line = lines[i];
+      armAsm->ldr(RARG2, MemOperand(RSTATE, line.offset));
+      armAsm->cmp(RARG2, RARG1);
+
+      const s32 disp = armGetPCDisplacement(GetCurrentCodePointer(), slowpath);
+      if (armIsPCDisplacementInImmediateRange(disp))
+      {
+        Label ldisp(armAsm->GetCursorOffset() + disp);
+        armAsm->b(ne, &ldisp);
+      }
+      else
+      {
+        Label skip;
+        armAsm->b(eq, &skip);
+        armEmitJmp(armAsm, slowpath, true);
+        armAsm->bind(&skip);
+      }
+
+      if (i != (lines.size() - 1))
+        armAsm->add(RARG1, RARG1, armCheckAddSubConstant(static_cast<s32>(lines[i + 1].tag - line.tag)));
+    }
+
+    SwitchToFarCode(false);
+    armEmitMov(armAsm, RARG1, lines.front().tag);
+    armAsm->ldr(RARG2, PTR(&g_state.pending_ticks));
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+      const LineInfo& line = lines[i];
 
       Label cache_hit;
-      armAsm->ldr(existing_tag_reg, MemOperand(RSTATE, offset));
-      armAsm->cmp(existing_tag_reg, current_tag_reg);
+      armAsm->ldr(RARG3, MemOperand(RSTATE, line.offset));
+      armAsm->cmp(RARG3, RARG1);
       armAsm->b(eq, &cache_hit);
 
-      armAsm->str(current_tag_reg, MemOperand(RSTATE, offset));
-      armAsm->add(ticks_reg, ticks_reg, armCheckAddSubConstant(static_cast<u32>(fill_ticks)));
+      armAsm->str(RARG1, MemOperand(RSTATE, line.offset));
+      armAsm->add(RARG2, RARG2, armCheckAddSubConstant(static_cast<u32>(line.fill_ticks)));
       armAsm->bind(&cache_hit);
 
-      if (i != (m_block->icache_line_count - 1))
-        armAsm->add(current_tag_reg, current_tag_reg, armCheckAddSubConstant(ICACHE_LINE_SIZE));
+      if (i != (lines.size() - 1))
+        armAsm->add(RARG1, RARG1, armCheckAddSubConstant(static_cast<s32>(lines[i + 1].tag - line.tag)));
     }
-
-    armAsm->str(ticks_reg, PTR(&g_state.pending_ticks));
+    armAsm->str(RARG2, PTR(&g_state.pending_ticks));
+    SwitchToNearCode(true);
   }
 }
 
@@ -406,23 +447,38 @@ void CPU::NewRec::AArch32Compiler::EndAndLinkBlock(const std::optional<u32>& new
 
   // pending_ticks += cycles
   // if (pending_ticks >= downcount) { dispatch_event(); }
-  if (do_event_test || m_gte_done_cycle > cycles || cycles > 0)
-    armAsm->ldr(RARG1, PTR(&g_state.pending_ticks));
   if (do_event_test)
-    armAsm->ldr(RARG2, PTR(&g_state.downcount));
-  if (cycles > 0)
-    armAsm->add(RARG1, RARG1, armCheckAddSubConstant(cycles));
-  if (m_gte_done_cycle > cycles)
   {
-    armAsm->add(RARG2, RARG1, armCheckAddSubConstant(m_gte_done_cycle - cycles));
-    armAsm->str(RARG2, PTR(&g_state.gte_completion_tick));
-  }
-  if (do_event_test)
-    armAsm->cmp(RARG1, RARG2);
-  if (cycles > 0)
-    armAsm->str(RARG1, PTR(&g_state.pending_ticks));
-  if (do_event_test)
+    // downcount/pending_ticks are the first two fields of State, so a single ldrd grabs both.
+    // Note the swapped roles compared to the single-load path below: RARG1 holds downcount here.
+    static_assert(offsetof(State, pending_ticks) == (offsetof(State, downcount) + sizeof(u32)));
+    armAsm->ldrd(RARG1, RARG2, PTR(&g_state.downcount));
+    if (cycles > 0)
+      armAsm->add(RARG2, RARG2, armCheckAddSubConstant(cycles));
+    if (m_gte_done_cycle > cycles)
+    {
+      armAsm->add(RARG1, RARG2, armCheckAddSubConstant(m_gte_done_cycle - cycles));
+      armAsm->str(RARG1, PTR(&g_state.gte_completion_tick));
+    }
+    armAsm->cmp(RARG2, RARG1);
+    if (cycles > 0)
+      armAsm->str(RARG2, PTR(&g_state.pending_ticks));
     armEmitCondBranch(armAsm, ge, CodeCache::g_run_events_and_dispatch);
+  }
+  else
+  {
+    if (m_gte_done_cycle > cycles || cycles > 0)
+      armAsm->ldr(RARG1, PTR(&g_state.pending_ticks));
+    if (cycles > 0)
+      armAsm->add(RARG1, RARG1, armCheckAddSubConstant(cycles));
+    if (m_gte_done_cycle > cycles)
+    {
+      armAsm->add(RARG2, RARG1, armCheckAddSubConstant(m_gte_done_cycle - cycles));
+      armAsm->str(RARG2, PTR(&g_state.gte_completion_tick));
+    }
+    if (cycles > 0)
+      armAsm->str(RARG1, PTR(&g_state.pending_ticks));
+  }
 
   // jump to dispatcher or next block
   if (force_run_events)
@@ -489,6 +545,21 @@ void CPU::NewRec::AArch32Compiler::StoreHostRegToCPUPointer(u32 reg, const void*
   armAsm->str(Register(reg), PTR(ptr));
 }
 
+void CPU::NewRec::AArch32Compiler::StoreHostRegPairToCPUPointer(u32 reg1, u32 reg2, const void* ptr)
+{
+  // strd only encodes an even/odd consecutive register pair and a +-255 byte offset, but when the
+  // allocator happens to hand out such a pair this halves the stores on the flush path. Anything
+  // else takes the generic two-store fallback.
+  const s32 offset = static_cast<s32>(reinterpret_cast<const u8*>(ptr) - reinterpret_cast<const u8*>(&g_state));
+  if ((reg1 & 1u) != 0 || reg2 != (reg1 + 1) || offset < -255 || offset > 251 || (offset & 3) != 0)
+  {
+    Compiler::StoreHostRegPairToCPUPointer(reg1, reg2, ptr);
+    return;
+  }
+
+  armAsm->strd(Register(reg1), Register(reg2), MemOperand(RSTATE, offset));
+}
+
 void CPU::NewRec::AArch32Compiler::StoreConstantToCPUPointer(u32 val, const void* ptr)
 {
   EmitMov(RSCRATCH, val);
@@ -677,8 +748,9 @@ void CPU::NewRec::AArch32Compiler::Flush(u32 flags)
   {
     // May as well flush cycles while we're here.
     // GTE spanning blocks is very rare, we _could_ disable this for speed.
-    armAsm->ldr(RARG1, PTR(&g_state.pending_ticks));
-    armAsm->ldr(RARG2, PTR(&g_state.gte_completion_tick));
+    // pending_ticks/gte_completion_tick are adjacent in State, grab both with one ldrd.
+    static_assert(offsetof(State, gte_completion_tick) == (offsetof(State, pending_ticks) + sizeof(u32)));
+    armAsm->ldrd(RARG1, RARG2, PTR(&g_state.pending_ticks));
     if (m_cycles > 0)
     {
       armAsm->add(RARG1, RARG1, armCheckAddSubConstant(m_cycles));
@@ -794,6 +866,12 @@ void CPU::NewRec::AArch32Compiler::Compile_bxx(CompileFlags cf, BranchCondition
   // MipsT() here should equal zero for zero branches.
   DebugAssert(cond == BranchCondition::Equal || cond == BranchCondition::NotEqual || cf.MipsT() == Reg::zero);
 
+  // If the warm-up tier saw this branch mostly taken, flip the host condition so the taken
+  // successor is emitted on the fall-through path.
+  const bool swap_successors = IsBranchProfiledTaken();
+  if (swap_successors)
+    cond = InvertBranchCondition(cond);
+
   Label taken;
   const Register rs = CFGetRegS(cf);
   switch (cond)
@@ -844,7 +922,7 @@ void CPU::NewRec::AArch32Compiler::Compile_bxx(CompileFlags cf, BranchCondition
   if (!cf.delay_slot_swapped)
     CompileBranchDelaySlot();
 
-  EndBlock(m_compiler_pc, true);
+  EndBlock(swap_successors ? taken_pc : m_compiler_pc, true);
 
   armAsm->bind(&taken);
 
@@ -852,7 +930,7 @@ void CPU::NewRec::AArch32Compiler::Compile_bxx(CompileFlags cf, BranchCondition
   if (!cf.delay_slot_swapped)
     CompileBranchDelaySlot();
 
-  EndBlock(taken_pc, true);
+  EndBlock(swap_successors ? m_compiler_pc : taken_pc, true);
 }
 
 void CPU::NewRec::AArch32Compiler::Compile_addi(CompileFlags cf, bool overflow)
@@ -2130,7 +2208,7 @@ void CPU::NewRec::AArch32Compiler::Compile_mtc2(CompileFlags cf)
 void CPU::NewRec::AArch32Compiler::Compile_cop2(CompileFlags cf)
 {
   TickCount func_ticks;
-  GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks);
+  GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks, !iinfo->gte_flags_dead);
 
   Flush(FLUSH_FOR_C_CALL);
   EmitMov(RARG1, inst->bits & GTE::Instruction::REQUIRED_BITS_MASK);
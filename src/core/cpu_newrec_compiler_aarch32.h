@@ -28,6 +28,7 @@ protected:
   void LoadHostRegFromCPUPointer(u32 reg, const void* ptr) override;
   void StoreConstantToCPUPointer(u32 val, const void* ptr) override;
   void StoreHostRegToCPUPointer(u32 reg, const void* ptr) override;
+  void StoreHostRegPairToCPUPointer(u32 reg1, u32 reg2, const void* ptr) override;
   void CopyHostReg(u32 dst, u32 src) override;
 
   void Reset(CodeCache::Block* block, u8* code_buffer, u32 code_buffer_space, u8* far_code_buffer,
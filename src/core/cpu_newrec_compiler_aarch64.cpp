@@ -6,6 +6,7 @@
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/string_util.h"
+#include "common/thirdparty/SmallVector.h"
 #include "cpu_core_private.h"
 #include "cpu_pgxp.h"
 #include "cpu_recompiler_thunks.h"
@@ -280,39 +281,78 @@ void CPU::NewRec::AArch64Compiler::GenerateICacheCheckAndUpdate()
     armAsm->add(RWARG1, RWARG1, armCheckAddSubConstant(static_cast<u32>(m_block->uncached_fetch_ticks)));
     armAsm->str(RWARG1, PTR(&g_state.pending_ticks));
   }
-  else
+  else if (m_block->icache_line_count > 0)
   {
-    const auto& ticks_reg = RWARG1;
-    const auto& current_tag_reg = RWARG2;
-    const auto& existing_tag_reg = RWARG3;
-
+    // Gather the lines with a fill cost up front, so the hot path is nothing but a compare chain.
+    struct LineInfo
+    {
+      u32 offset;
+      u32 tag;
+      TickCount fill_ticks;
+    };
+    llvm::SmallVector<LineInfo, 16> lines;
     VirtualMemoryAddress current_pc = m_block->pc & ICACHE_TAG_ADDRESS_MASK;
-    armAsm->ldr(ticks_reg, PTR(&g_state.pending_ticks));
-    armEmitMov(armAsm, current_tag_reg, current_pc);
-
     for (u32 i = 0; i < m_block->icache_line_count; i++, current_pc += ICACHE_LINE_SIZE)
     {
       const TickCount fill_ticks = GetICacheFillTicks(current_pc);
       if (fill_ticks <= 0)
         continue;
 
-      const u32 line = GetICacheLine(current_pc);
-      const u32 offset = offsetof(State, icache_tags) + (line * sizeof(u32));
+      lines.push_back(
+        {static_cast<u32>(offsetof(State, icache_tags) + (GetICacheLine(current_pc) * sizeof(u32))),
+         GetICacheTagForAddress(current_pc), fill_ticks});
+    }
+    if (lines.empty())
+      return;
+
+    // All-hit is the overwhelmingly common case, so compare all tags and fall through with zero
+    // cost; any mismatch takes the far path, which does the precise per-line update and jumps back.
+    const void* const slowpath = m_far_emitter.GetCursorAddress<const void*>();
+    armEmitMov(armAsm, RWARG1, lines.front().tag);
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+      const LineInfo& line = lines[i];
+      armAsm->ldr(RWARG2, MemOperand(RSTATE, line.offset));
+      armAsm->cmp(RWARG2, RWARG1);
+
+      const s64 disp = armGetPCDisplacement(GetCurrentCodePointer(), slowpath);
+      if (vixl::IsInt19(disp))
+      {
+        armAsm->b(disp, ne);
+      }
+      else
+      {
+        Label skip;
+        armAsm->b(&skip, eq);
+        armAsm->b(armGetPCDisplacement(GetCurrentCodePointer(), slowpath));
+        armAsm->bind(&skip);
+      }
+
+      if (i != (lines.size() - 1))
+        armAsm->add(RWARG1, RWARG1, armCheckAddSubConstant(static_cast<s32>(lines[i + 1].tag - line.tag)));
+    }
+
+    SwitchToFarCode(false);
+    armEmitMov(armAsm, RWARG1, lines.front().tag);
+    armAsm->ldr(RWARG2, PTR(&g_state.pending_ticks));
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+      const LineInfo& line = lines[i];
 
       Label cache_hit;
-      armAsm->ldr(existing_tag_reg, MemOperand(RSTATE, offset));
-      armAsm->cmp(existing_tag_reg, current_tag_reg);
+      armAsm->ldr(RWARG3, MemOperand(RSTATE, line.offset));
+      armAsm->cmp(RWARG3, RWARG1);
       armAsm->b(&cache_hit, eq);
 
-      armAsm->str(current_tag_reg, MemOperand(RSTATE, offset));
-      armAsm->add(ticks_reg, ticks_reg, armCheckAddSubConstant(static_cast<u32>(fill_ticks)));
+      armAsm->str(RWARG1, MemOperand(RSTATE, line.offset));
+      armAsm->add(RWARG2, RWARG2, armCheckAddSubConstant(static_cast<u32>(line.fill_ticks)));
       armAsm->bind(&cache_hit);
 
-      if (i != (m_block->icache_line_count - 1))
-        armAsm->add(current_tag_reg, current_tag_reg, armCheckAddSubConstant(ICACHE_LINE_SIZE));
+      if (i != (lines.size() - 1))
+        armAsm->add(RWARG1, RWARG1, armCheckAddSubConstant(static_cast<s32>(lines[i + 1].tag - line.tag)));
     }
-
-    armAsm->str(ticks_reg, PTR(&g_state.pending_ticks));
+    armAsm->str(RWARG2, PTR(&g_state.pending_ticks));
+    SwitchToNearCode(true);
   }
 }
 
@@ -461,6 +501,20 @@ void CPU::NewRec::AArch64Compiler::StoreHostRegToCPUPointer(u32 reg, const void*
   armAsm->str(WRegister(reg), PTR(ptr));
 }
 
+void CPU::NewRec::AArch64Compiler::StoreHostRegPairToCPUPointer(u32 reg1, u32 reg2, const void* ptr)
+{
+  // stp's scaled-immediate range is only +-256 bytes, but everything we pair on (guest registers,
+  // load delay values) sits at the front of State. Fall back to single stores if that changes.
+  const s64 offset = static_cast<s64>(reinterpret_cast<const u8*>(ptr) - reinterpret_cast<const u8*>(&g_state));
+  if (offset < -256 || offset > 252 || (offset & 3) != 0) [[unlikely]]
+  {
+    Compiler::StoreHostRegPairToCPUPointer(reg1, reg2, ptr);
+    return;
+  }
+
+  armAsm->stp(WRegister(reg1), WRegister(reg2), MemOperand(RSTATE, offset));
+}
+
 void CPU::NewRec::AArch64Compiler::StoreConstantToCPUPointer(u32 val, const void* ptr)
 {
   if (val == 0)
@@ -764,6 +818,12 @@ void CPU::NewRec::AArch64Compiler::Compile_bxx(CompileFlags cf, BranchCondition
   // MipsT() here should equal zero for zero branches.
   DebugAssert(cond == BranchCondition::Equal || cond == BranchCondition::NotEqual || cf.MipsT() == Reg::zero);
 
+  // If the warm-up tier saw this branch mostly taken, flip the host condition so the taken
+  // successor is emitted on the fall-through path.
+  const bool swap_successors = IsBranchProfiledTaken();
+  if (swap_successors)
+    cond = InvertBranchCondition(cond);
+
   Label taken;
   const WRegister rs = CFGetRegS(cf);
   switch (cond)
@@ -821,7 +881,7 @@ void CPU::NewRec::AArch64Compiler::Compile_bxx(CompileFlags cf, BranchCondition
   if (!cf.delay_slot_swapped)
     CompileBranchDelaySlot();
 
-  EndBlock(m_compiler_pc, true);
+  EndBlock(swap_successors ? taken_pc : m_compiler_pc, true);
 
   armAsm->bind(&taken);
 
@@ -829,7 +889,7 @@ void CPU::NewRec::AArch64Compiler::Compile_bxx(CompileFlags cf, BranchCondition
   if (!cf.delay_slot_swapped)
     CompileBranchDelaySlot();
 
-  EndBlock(taken_pc, true);
+  EndBlock(swap_successors ? m_compiler_pc : taken_pc, true);
 }
 
 void CPU::NewRec::AArch64Compiler::Compile_addi(CompileFlags cf, bool overflow)
@@ -2103,7 +2163,7 @@ void CPU::NewRec::AArch64Compiler::Compile_mtc2(CompileFlags cf)
 void CPU::NewRec::AArch64Compiler::Compile_cop2(CompileFlags cf)
 {
   TickCount func_ticks;
-  GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks);
+  GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks, !iinfo->gte_flags_dead);
 
   Flush(FLUSH_FOR_C_CALL);
   EmitMov(RWARG1, inst->bits & GTE::Instruction::REQUIRED_BITS_MASK);
@@ -6,6 +6,7 @@
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/string_util.h"
+#include "common/thirdparty/SmallVector.h"
 #include "cpu_code_cache_private.h"
 #include "cpu_core_private.h"
 #include "cpu_pgxp.h"
@@ -224,9 +225,8 @@ u32 CPU::CodeCache::EmitASMFunctions(void* code, u32 code_size)
       rvAsm->LD(RMEMBASE, PTR(&g_state.fastmem_base));
 
     // Downcount isn't set on entry, so we need to initialize it
-    rvMoveAddressToReg(rvAsm, RARG1, TimingEvents::GetHeadEventPtr());
-    rvAsm->LD(RARG1, 0, RARG1);
-    rvAsm->LW(RARG1, offsetof(TimingEvent, m_downcount), RARG1);
+    rvMoveAddressToReg(rvAsm, RARG1, TimingEvents::GetNextEventDowncountPtr());
+    rvAsm->LW(RARG1, 0, RARG1);
     rvAsm->SW(RARG1, PTR(&g_state.downcount));
 
     // Fall through to event dispatcher
@@ -528,39 +528,69 @@ void CPU::NewRec::RISCV64Compiler::GenerateICacheCheckAndUpdate()
     SafeADDIW(RARG1, RARG1, static_cast<u32>(m_block->uncached_fetch_ticks));
     rvAsm->SW(RARG1, PTR(&g_state.pending_ticks));
   }
-  else
+  else if (m_block->icache_line_count > 0)
   {
-    const auto& ticks_reg = RARG1;
-    const auto& current_tag_reg = RARG2;
-    const auto& existing_tag_reg = RARG3;
-
+    // Gather the lines with a fill cost up front, so the hot path is nothing but a compare chain.
+    struct LineInfo
+    {
+      u32 offset;
+      u32 tag;
+      TickCount fill_ticks;
+    };
+    llvm::SmallVector<LineInfo, 16> lines;
     VirtualMemoryAddress current_pc = m_block->pc & ICACHE_TAG_ADDRESS_MASK;
-    rvAsm->LW(ticks_reg, PTR(&g_state.pending_ticks));
-    rvEmitMov(rvAsm, current_tag_reg, current_pc);
-
     for (u32 i = 0; i < m_block->icache_line_count; i++, current_pc += ICACHE_LINE_SIZE)
     {
       const TickCount fill_ticks = GetICacheFillTicks(current_pc);
       if (fill_ticks <= 0)
         continue;
 
-      const u32 line = GetICacheLine(current_pc);
-      const u32 offset = offsetof(State, icache_tags) + (line * sizeof(u32));
+      lines.push_back(
+        {static_cast<u32>(offsetof(State, icache_tags) + (GetICacheLine(current_pc) * sizeof(u32))),
+         GetICacheTagForAddress(current_pc), fill_ticks});
+    }
+    if (lines.empty())
+      return;
+
+    // All-hit is the overwhelmingly common case, so compare all tags and fall through with zero
+    // cost; any mismatch takes the far path, which does the precise per-line update and jumps back.
+    const void* const slowpath = m_far_emitter->GetCursorPointer();
+    rvEmitMov(rvAsm, RARG1, lines.front().tag);
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+      const LineInfo& line = lines[i];
 
       // TODO: Verify sign extension here...
       Label cache_hit;
-      rvAsm->LW(existing_tag_reg, offset, RSTATE);
-      rvAsm->BEQ(existing_tag_reg, current_tag_reg, &cache_hit);
-
-      rvAsm->SW(current_tag_reg, offset, RSTATE);
-      SafeADDIW(ticks_reg, ticks_reg, static_cast<u32>(fill_ticks));
+      rvAsm->LW(RARG2, line.offset, RSTATE);
+      rvAsm->BEQ(RARG2, RARG1, &cache_hit);
+      rvEmitJmp(rvAsm, slowpath);
       rvAsm->Bind(&cache_hit);
 
-      if (i != (m_block->icache_line_count - 1))
-        SafeADDIW(current_tag_reg, current_tag_reg, ICACHE_LINE_SIZE);
+      if (i != (lines.size() - 1))
+        SafeADDIW(RARG1, RARG1, lines[i + 1].tag - line.tag);
     }
 
-    rvAsm->SW(ticks_reg, PTR(&g_state.pending_ticks));
+    SwitchToFarCode(false);
+    rvEmitMov(rvAsm, RARG1, lines.front().tag);
+    rvAsm->LW(RARG2, PTR(&g_state.pending_ticks));
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+      const LineInfo& line = lines[i];
+
+      Label cache_hit;
+      rvAsm->LW(RARG3, line.offset, RSTATE);
+      rvAsm->BEQ(RARG3, RARG1, &cache_hit);
+
+      rvAsm->SW(RARG1, line.offset, RSTATE);
+      SafeADDIW(RARG2, RARG2, static_cast<u32>(line.fill_ticks));
+      rvAsm->Bind(&cache_hit);
+
+      if (i != (lines.size() - 1))
+        SafeADDIW(RARG1, RARG1, lines[i + 1].tag - line.tag);
+    }
+    rvAsm->SW(RARG2, PTR(&g_state.pending_ticks));
+    SwitchToNearCode(true);
   }
 }
 
@@ -1044,6 +1074,12 @@ void CPU::NewRec::RISCV64Compiler::Compile_bxx(CompileFlags cf, BranchCondition
   // MipsT() here should equal zero for zero branches.
   DebugAssert(cond == BranchCondition::Equal || cond == BranchCondition::NotEqual || cf.MipsT() == Reg::zero);
 
+  // If the warm-up tier saw this branch mostly taken, flip the host condition so the taken
+  // successor is emitted on the fall-through path.
+  const bool swap_successors = IsBranchProfiledTaken();
+  if (swap_successors)
+    cond = InvertBranchCondition(cond);
+
   Label taken;
   const GPR rs = CFGetRegS(cf);
   switch (cond)
@@ -1098,7 +1134,7 @@ void CPU::NewRec::RISCV64Compiler::Compile_bxx(CompileFlags cf, BranchCondition
   if (!cf.delay_slot_swapped)
     CompileBranchDelaySlot();
 
-  EndBlock(m_compiler_pc, true);
+  EndBlock(swap_successors ? taken_pc : m_compiler_pc, true);
 
   rvAsm->Bind(&taken);
 
@@ -1106,7 +1142,7 @@ void CPU::NewRec::RISCV64Compiler::Compile_bxx(CompileFlags cf, BranchCondition
   if (!cf.delay_slot_swapped)
     CompileBranchDelaySlot();
 
-  EndBlock(taken_pc, true);
+  EndBlock(swap_successors ? m_compiler_pc : taken_pc, true);
 }
 
 void CPU::NewRec::RISCV64Compiler::Compile_addi(CompileFlags cf, bool overflow)
@@ -2420,7 +2456,7 @@ void CPU::NewRec::RISCV64Compiler::Compile_mtc2(CompileFlags cf)
 void CPU::NewRec::RISCV64Compiler::Compile_cop2(CompileFlags cf)
 {
   TickCount func_ticks;
-  GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks);
+  GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks, !iinfo->gte_flags_dead);
 
   Flush(FLUSH_FOR_C_CALL);
   EmitMov(RARG1, inst->bits & GTE::Instruction::REQUIRED_BITS_MASK);
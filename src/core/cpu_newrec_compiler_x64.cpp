@@ -6,6 +6,7 @@
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/string_util.h"
+#include "common/thirdparty/SmallVector.h"
 #include "cpu_code_cache_private.h"
 #include "cpu_core_private.h"
 #include "cpu_pgxp.h"
@@ -185,27 +186,48 @@ void CPU::NewRec::X64Compiler::GenerateICacheCheckAndUpdate()
   }
   else if (m_block->icache_line_count > 0)
   {
-    cg->lea(RXARG1, cg->dword[PTR(&g_state.icache_tags)]);
-
-    // TODO: Vectorize this...
+    // Gather the lines with a fill cost up front, so the hot path is nothing but a compare chain.
+    struct LineInfo
+    {
+      u32 offset;
+      u32 tag;
+      TickCount fill_ticks;
+    };
+    llvm::SmallVector<LineInfo, 16> lines;
     VirtualMemoryAddress current_pc = m_block->pc & ICACHE_TAG_ADDRESS_MASK;
     for (u32 i = 0; i < m_block->icache_line_count; i++, current_pc += ICACHE_LINE_SIZE)
     {
-      const VirtualMemoryAddress tag = GetICacheTagForAddress(current_pc);
       const TickCount fill_ticks = GetICacheFillTicks(current_pc);
       if (fill_ticks <= 0)
         continue;
 
-      const u32 line = GetICacheLine(current_pc);
-      const u32 offset = (line * sizeof(u32));
-      Xbyak::Label cache_hit;
+      lines.push_back({GetICacheLine(current_pc) * static_cast<u32>(sizeof(u32)),
+                       GetICacheTagForAddress(current_pc), fill_ticks});
+    }
+    if (lines.empty())
+      return;
+
+    // All-hit is the overwhelmingly common case, so compare all tags and fall through with zero
+    // cost; any mismatch takes the far path, which does the precise per-line update and jumps back.
+    cg->lea(RXARG1, cg->dword[PTR(&g_state.icache_tags)]);
+    const void* const slowpath = m_far_emitter->getCurr<const void*>();
+    for (const LineInfo& line : lines)
+    {
+      cg->cmp(cg->dword[RXARG1 + line.offset], line.tag);
+      cg->jne(slowpath);
+    }
 
-      cg->cmp(cg->dword[RXARG1 + offset], tag);
-      cg->je(cache_hit);
-      cg->mov(cg->dword[RXARG1 + offset], tag);
-      cg->add(cg->dword[PTR(&g_state.pending_ticks)], static_cast<u32>(fill_ticks));
-      cg->L(cache_hit);
+    const void* const resume = cg->getCurr<const void*>();
+    for (const LineInfo& line : lines)
+    {
+      Xbyak::Label cache_hit;
+      m_far_emitter->cmp(m_far_emitter->dword[RXARG1 + line.offset], line.tag);
+      m_far_emitter->je(cache_hit);
+      m_far_emitter->mov(m_far_emitter->dword[RXARG1 + line.offset], line.tag);
+      m_far_emitter->add(m_far_emitter->dword[PTR(&g_state.pending_ticks)], static_cast<u32>(line.fill_ticks));
+      m_far_emitter->L(cache_hit);
     }
+    m_far_emitter->jmp(resume);
   }
 }
 
@@ -525,6 +547,29 @@ void CPU::NewRec::X64Compiler::GeneratePGXPCallWithMIPSRegs(const void* func, u3
   cg->call(func);
 }
 
+void CPU::NewRec::X64Compiler::GeneratePGXPMove(Reg dst, Reg src)
+{
+  DebugAssert(g_settings.gpu_pgxp_enable && dst != src);
+
+  // PGXP::CPU_MOVE() is just a validate of the source against the current register value plus a
+  // record copy, which doesn't need a flush or a call. Only the reserved scratch registers and
+  // xmm0 get clobbered here.
+  const PGXP_value* const src_val = &g_state.pgxp_gpr[static_cast<u8>(src)];
+  PGXP_value* const dst_val = &g_state.pgxp_gpr[static_cast<u8>(dst)];
+
+  MoveMIPSRegToReg(RWARG1, src);
+  cg->cmp(cg->dword[PTR(&src_val->value)], RWARG1);
+  Xbyak::Label still_valid;
+  cg->je(still_valid);
+  cg->and_(cg->dword[PTR(&src_val->flags)], 0xFEFEFEFEu); // ~VALID_ALL
+  cg->L(still_valid);
+
+  cg->movaps(cg->xmm0, cg->xword[PTR(src_val)]);
+  cg->movaps(cg->xword[PTR(dst_val)], cg->xmm0);
+  cg->mov(RWARG1, cg->dword[PTR(&src_val->flags)]);
+  cg->mov(cg->dword[PTR(&dst_val->flags)], RWARG1);
+}
+
 void CPU::NewRec::X64Compiler::Flush(u32 flags)
 {
   Compiler::Flush(flags);
@@ -687,6 +732,12 @@ void CPU::NewRec::X64Compiler::Compile_bxx(CompileFlags cf, BranchCondition cond
   // MipsT() here should equal zero for zero branches.
   DebugAssert(cond == BranchCondition::Equal || cond == BranchCondition::NotEqual || cf.MipsT() == Reg::zero);
 
+  // If the warm-up tier saw this branch mostly taken, flip the host condition so the taken
+  // successor is emitted on the fall-through path.
+  const bool swap_successors = IsBranchProfiledTaken();
+  if (swap_successors)
+    cond = InvertBranchCondition(cond);
+
   // TODO: Swap this back to near once instructions don't blow up
   constexpr CodeGenerator::LabelType type = CodeGenerator::T_NEAR;
   Label taken;
@@ -741,7 +792,7 @@ void CPU::NewRec::X64Compiler::Compile_bxx(CompileFlags cf, BranchCondition cond
   if (!cf.delay_slot_swapped)
     CompileBranchDelaySlot();
 
-  EndBlock(m_compiler_pc, true);
+  EndBlock(swap_successors ? taken_pc : m_compiler_pc, true);
 
   cg->L(taken);
 
@@ -749,7 +800,7 @@ void CPU::NewRec::X64Compiler::Compile_bxx(CompileFlags cf, BranchCondition cond
   if (!cf.delay_slot_swapped)
     CompileBranchDelaySlot();
 
-  EndBlock(taken_pc, true);
+  EndBlock(swap_successors ? m_compiler_pc : taken_pc, true);
 }
 
 void CPU::NewRec::X64Compiler::Compile_addi(CompileFlags cf)
@@ -1254,9 +1305,35 @@ CPU::NewRec::X64Compiler::ComputeLoadStoreAddressArg(CompileFlags cf,
 }
 
 template<typename RegAllocFn>
-Xbyak::Reg32 CPU::NewRec::X64Compiler::GenerateLoad(const Xbyak::Reg32& addr_reg, MemoryAccessSize size, bool sign,
-                                                    bool use_fastmem, const RegAllocFn& dst_reg_alloc)
+Xbyak::Reg32 CPU::NewRec::X64Compiler::GenerateLoad(const Xbyak::Reg32& addr_reg,
+                                                    const std::optional<VirtualMemoryAddress>& address,
+                                                    MemoryAccessSize size, bool sign, bool use_fastmem,
+                                                    const RegAllocFn& dst_reg_alloc)
 {
+  // Scratchpad never uses fastmem, so known-constant scratchpad addresses read straight out of
+  // g_state. No backpatch record or cycle penalty, scratchpad reads are zero-wait-state.
+  if (const std::optional<u32> spoff = GetScratchpadOffsetForAddress(address, size); spoff.has_value())
+  {
+    const Reg32 dst = dst_reg_alloc();
+    const u8* ptr = &g_state.scratchpad[spoff.value()];
+    switch (size)
+    {
+      case MemoryAccessSize::Byte:
+        sign ? cg->movsx(dst, cg->byte[PTR(ptr)]) : cg->movzx(dst, cg->byte[PTR(ptr)]);
+        break;
+
+      case MemoryAccessSize::HalfWord:
+        sign ? cg->movsx(dst, cg->word[PTR(ptr)]) : cg->movzx(dst, cg->word[PTR(ptr)]);
+        break;
+
+      case MemoryAccessSize::Word:
+        cg->mov(dst, cg->dword[PTR(ptr)]);
+        break;
+    }
+
+    return dst;
+  }
+
   if (use_fastmem)
   {
     m_cycles += Bus::RAM_READ_TICKS;
@@ -1386,8 +1463,30 @@ Xbyak::Reg32 CPU::NewRec::X64Compiler::GenerateLoad(const Xbyak::Reg32& addr_reg
 }
 
 void CPU::NewRec::X64Compiler::GenerateStore(const Xbyak::Reg32& addr_reg, const Xbyak::Reg32& value_reg,
-                                             MemoryAccessSize size, bool use_fastmem)
+                                             const std::optional<VirtualMemoryAddress>& address, MemoryAccessSize size,
+                                             bool use_fastmem)
 {
+  if (const std::optional<u32> spoff = GetScratchpadOffsetForAddress(address, size); spoff.has_value())
+  {
+    const u8* ptr = &g_state.scratchpad[spoff.value()];
+    switch (size)
+    {
+      case MemoryAccessSize::Byte:
+        cg->mov(cg->byte[PTR(ptr)], value_reg.cvt8());
+        break;
+
+      case MemoryAccessSize::HalfWord:
+        cg->mov(cg->word[PTR(ptr)], value_reg.cvt16());
+        break;
+
+      case MemoryAccessSize::Word:
+        cg->mov(cg->dword[PTR(ptr)], value_reg.cvt32());
+        break;
+    }
+
+    return;
+  }
+
   if (use_fastmem)
   {
     if (g_settings.cpu_fastmem_mode == CPUFastmemMode::LUT)
@@ -1488,10 +1587,10 @@ void CPU::NewRec::X64Compiler::Compile_lxx(CompileFlags cf, MemoryAccessSize siz
   const std::optional<Reg32> addr_reg = g_settings.gpu_pgxp_enable ?
                                           std::optional<Reg32>(Reg32(AllocateTempHostReg(HR_CALLEE_SAVED))) :
                                           std::optional<Reg32>();
-  FlushForLoadStore(address, false, use_fastmem);
+  FlushForLoadStore(address, false, use_fastmem || GetScratchpadOffsetForAddress(address, size).has_value());
   const Reg32 addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
 
-  const Reg32 data = GenerateLoad(addr, size, sign, use_fastmem, [this, cf]() {
+  const Reg32 data = GenerateLoad(addr, address, size, sign, use_fastmem, [this, cf]() {
     if (cf.MipsT() == Reg::zero)
       return RWRET;
 
@@ -1526,10 +1625,12 @@ void CPU::NewRec::X64Compiler::Compile_lwx(CompileFlags cf, MemoryAccessSize siz
     UpdateLoadDelay();
 
   // We'd need to be careful here if we weren't overwriting it..
+  const std::optional<VirtualMemoryAddress> aligned_address =
+    address.has_value() ? std::optional<VirtualMemoryAddress>(address.value() & ~0x3u) : address;
   ComputeLoadStoreAddressArg(cf, address, addr);
   cg->mov(RWARG1, addr);
   cg->and_(RWARG1, ~0x3u);
-  GenerateLoad(RWARG1, MemoryAccessSize::Word, false, use_fastmem, []() { return RWRET; });
+  GenerateLoad(RWARG1, aligned_address, MemoryAccessSize::Word, false, use_fastmem, []() { return RWRET; });
 
   if (inst->r.rt == Reg::zero)
   {
@@ -1609,9 +1710,10 @@ void CPU::NewRec::X64Compiler::Compile_lwc2(CompileFlags cf, MemoryAccessSize si
   const std::optional<Reg32> addr_reg = g_settings.gpu_pgxp_enable ?
                                           std::optional<Reg32>(Reg32(AllocateTempHostReg(HR_CALLEE_SAVED))) :
                                           std::optional<Reg32>();
-  FlushForLoadStore(address, false, use_fastmem);
+  FlushForLoadStore(address, false,
+                    use_fastmem || GetScratchpadOffsetForAddress(address, MemoryAccessSize::Word).has_value());
   const Reg32 addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
-  GenerateLoad(addr, MemoryAccessSize::Word, false, use_fastmem, []() { return RWRET; });
+  GenerateLoad(addr, address, MemoryAccessSize::Word, false, use_fastmem, []() { return RWRET; });
 
   const u32 index = static_cast<u32>(inst->r.rt.GetValue());
   const auto [ptr, action] = GetGTERegisterPointer(index, true);
@@ -1689,13 +1791,13 @@ void CPU::NewRec::X64Compiler::Compile_sxx(CompileFlags cf, MemoryAccessSize siz
   const std::optional<Reg32> addr_reg = g_settings.gpu_pgxp_enable ?
                                           std::optional<Reg32>(Reg32(AllocateTempHostReg(HR_CALLEE_SAVED))) :
                                           std::optional<Reg32>();
-  FlushForLoadStore(address, true, use_fastmem);
+  FlushForLoadStore(address, true, use_fastmem || GetScratchpadOffsetForAddress(address, size).has_value());
   const Reg32 addr = ComputeLoadStoreAddressArg(cf, address, addr_reg);
   const Reg32 data = cf.valid_host_t ? CFGetRegT(cf) : RWARG2;
   if (!cf.valid_host_t)
     MoveTToReg(RWARG2, cf);
 
-  GenerateStore(addr, data, size, use_fastmem);
+  GenerateStore(addr, data, address, size, use_fastmem);
 
   if (g_settings.gpu_pgxp_enable)
   {
@@ -1718,10 +1820,12 @@ void CPU::NewRec::X64Compiler::Compile_swx(CompileFlags cf, MemoryAccessSize siz
 
   // TODO: if address is constant, this can be simplified..
   // We'd need to be careful here if we weren't overwriting it..
+  const std::optional<VirtualMemoryAddress> aligned_address =
+    address.has_value() ? std::optional<VirtualMemoryAddress>(address.value() & ~0x3u) : address;
   ComputeLoadStoreAddressArg(cf, address, addr);
   cg->mov(RWARG1, addr);
   cg->and_(RWARG1, ~0x3u);
-  GenerateLoad(RWARG1, MemoryAccessSize::Word, false, use_fastmem, []() { return RWRET; });
+  GenerateLoad(RWARG1, aligned_address, MemoryAccessSize::Word, false, use_fastmem, []() { return RWRET; });
 
   // TODO: this can take over rt's value if it's no longer needed
   // NOTE: can't trust T in cf because of the flush
@@ -1773,7 +1877,7 @@ void CPU::NewRec::X64Compiler::Compile_swx(CompileFlags cf, MemoryAccessSize siz
 
   cg->mov(RWARG1, addr);
   cg->and_(RWARG1, ~0x3u);
-  GenerateStore(RWARG1, value, MemoryAccessSize::Word, use_fastmem);
+  GenerateStore(RWARG1, value, aligned_address, MemoryAccessSize::Word, use_fastmem);
 }
 
 void CPU::NewRec::X64Compiler::Compile_swc2(CompileFlags cf, MemoryAccessSize size, bool sign, bool use_fastmem,
@@ -1809,19 +1913,19 @@ void CPU::NewRec::X64Compiler::Compile_swc2(CompileFlags cf, MemoryAccessSize si
   // PGXP makes this a giant pain.
   if (!g_settings.gpu_pgxp_enable)
   {
-    FlushForLoadStore(address, true, use_fastmem);
+    FlushForLoadStore(address, true, use_fastmem || GetScratchpadOffsetForAddress(address, size).has_value());
     const Reg32 addr = ComputeLoadStoreAddressArg(cf, address);
-    GenerateStore(addr, RWARG2, size, use_fastmem);
+    GenerateStore(addr, RWARG2, address, size, use_fastmem);
     return;
   }
 
   // TODO: This can be simplified because we don't need to validate in PGXP..
   const Reg32 addr_reg = Reg32(AllocateTempHostReg(HR_CALLEE_SAVED));
   const Reg32 data_backup = Reg32(AllocateTempHostReg(HR_CALLEE_SAVED));
-  FlushForLoadStore(address, true, use_fastmem);
+  FlushForLoadStore(address, true, use_fastmem || GetScratchpadOffsetForAddress(address, size).has_value());
   ComputeLoadStoreAddressArg(cf, address, addr_reg);
   cg->mov(data_backup, RWARG2);
-  GenerateStore(addr_reg, RWARG2, size, use_fastmem);
+  GenerateStore(addr_reg, RWARG2, address, size, use_fastmem);
 
   Flush(FLUSH_FOR_C_CALL);
   cg->mov(RWARG3, data_backup);
@@ -2013,10 +2117,22 @@ void CPU::NewRec::X64Compiler::Compile_mfc2(CompileFlags cf)
 
   if (g_settings.gpu_pgxp_enable)
   {
-    Flush(FLUSH_FOR_C_CALL);
-    cg->mov(RWARG1, inst->bits);
-    cg->mov(RWARG2, Reg32(hreg));
-    cg->call(reinterpret_cast<const void*>(&PGXP::CPU_MFC2));
+    // PGXP::CPU_MFC2() is a validate plus a record copy, do it inline instead of flushing for a
+    // call. Direct reads always have index < 32, so this matches cop2idx() in cpu_pgxp.cpp.
+    const PGXP_value* const gte_val = &g_state.pgxp_gte[index];
+    PGXP_value* const gpr_val = &g_state.pgxp_gpr[static_cast<u8>(rt)];
+
+    cg->cmp(cg->dword[PTR(&gte_val->value)], Reg32(hreg));
+    Xbyak::Label still_valid;
+    cg->je(still_valid);
+    cg->and_(cg->dword[PTR(&gte_val->flags)], 0xFEFEFEFEu); // ~VALID_ALL
+    cg->L(still_valid);
+
+    cg->movaps(cg->xmm0, cg->xword[PTR(gte_val)]);
+    cg->movaps(cg->xword[PTR(gpr_val)], cg->xmm0);
+    cg->mov(RWARG1, cg->dword[PTR(&gte_val->flags)]);
+    cg->mov(cg->dword[PTR(&gpr_val->flags)], RWARG1);
+    cg->mov(cg->dword[PTR(&gpr_val->value)], Reg32(hreg));
   }
 }
 
@@ -2097,7 +2213,60 @@ void CPU::NewRec::X64Compiler::Compile_mtc2(CompileFlags cf)
 void CPU::NewRec::X64Compiler::Compile_cop2(CompileFlags cf)
 {
   TickCount func_ticks;
-  GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks);
+  GTE::InstructionImpl func = GTE::GetInstructionImpl(inst->bits, &func_ticks, !iinfo->gte_flags_dead);
+
+  // NCLIP is a single cross product, cheap enough to do inline instead of going through a call.
+  // Condition mirrors the selection in GTE::GetInstructionImpl(), PGXP culling needs the handler.
+  if (GTE::Instruction{inst->bits}.command == 0x06 && !(g_settings.gpu_pgxp_enable && g_settings.gpu_pgxp_culling))
+  {
+    Flush(FLUSH_FOR_C_CALL);
+
+    // MAC0 = SX0*(SY1-SY2) + SX1*(SY2-SY0) + SX2*(SY0-SY1)
+    cg->movsx(RWARG1, cg->word[PTR(&g_state.gte_regs.SXY0[1])]);
+    cg->movsx(RWARG2, cg->word[PTR(&g_state.gte_regs.SXY1[1])]);
+    cg->movsx(RWARG3, cg->word[PTR(&g_state.gte_regs.SXY2[1])]);
+
+    cg->mov(RWRET, RWARG2);
+    cg->sub(RWRET, RWARG3);
+    cg->movsxd(RXRET, RWRET);
+    cg->movsx(RXARG4, cg->word[PTR(&g_state.gte_regs.SXY0[0])]);
+    cg->imul(RXARG4, RXRET);
+
+    cg->mov(RWRET, RWARG3);
+    cg->sub(RWRET, RWARG1);
+    cg->movsxd(RXRET, RWRET);
+    cg->movsx(RXARG3, cg->word[PTR(&g_state.gte_regs.SXY1[0])]);
+    cg->imul(RXARG3, RXRET);
+    cg->add(RXARG4, RXARG3);
+
+    cg->mov(RWRET, RWARG1);
+    cg->sub(RWRET, RWARG2);
+    cg->movsxd(RXRET, RWRET);
+    cg->movsx(RXARG1, cg->word[PTR(&g_state.gte_regs.SXY2[0])]);
+    cg->imul(RXARG1, RXRET);
+    cg->add(RXARG4, RXARG1);
+
+    // MAC0 gets the truncated result, FLAG the MAC0 overflow/underflow and error bits if the
+    // full result didn't fit in 32 bits.
+    cg->mov(cg->dword[PTR(&g_state.gte_regs.MAC0)], RWARG4);
+    if (!iinfo->gte_flags_dead)
+    {
+      cg->movsxd(RXRET, RWARG4);
+      cg->xor_(RWARG1, RWARG1);
+      cg->cmp(RXRET, RXARG4);
+      Xbyak::Label no_overflow;
+      cg->je(no_overflow);
+      cg->mov(RWARG1, 0x80010000u); // mac0_overflow | error
+      cg->mov(RWARG2, 0x80008000u); // mac0_underflow | error
+      cg->test(RXARG4, RXARG4);
+      cg->cmovs(RWARG1, RWARG2);
+      cg->L(no_overflow);
+      cg->mov(cg->dword[PTR(&g_state.gte_regs.FLAG.bits)], RWARG1);
+    }
+
+    AddGTETicks(func_ticks);
+    return;
+  }
 
   Flush(FLUSH_FOR_C_CALL);
   cg->mov(RWARG1, inst->bits & GTE::Instruction::REQUIRED_BITS_MASK);
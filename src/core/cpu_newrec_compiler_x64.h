@@ -88,10 +88,10 @@ protected:
   Xbyak::Reg32 ComputeLoadStoreAddressArg(CompileFlags cf, const std::optional<VirtualMemoryAddress>& address,
                                           const std::optional<const Xbyak::Reg32>& reg = std::nullopt);
   template<typename RegAllocFn>
-  Xbyak::Reg32 GenerateLoad(const Xbyak::Reg32& addr_reg, MemoryAccessSize size, bool sign, bool use_fastmem,
-                            const RegAllocFn& dst_reg_alloc);
-  void GenerateStore(const Xbyak::Reg32& addr_reg, const Xbyak::Reg32& value_reg, MemoryAccessSize size,
-                     bool use_fastmem);
+  Xbyak::Reg32 GenerateLoad(const Xbyak::Reg32& addr_reg, const std::optional<VirtualMemoryAddress>& address,
+                            MemoryAccessSize size, bool sign, bool use_fastmem, const RegAllocFn& dst_reg_alloc);
+  void GenerateStore(const Xbyak::Reg32& addr_reg, const Xbyak::Reg32& value_reg,
+                     const std::optional<VirtualMemoryAddress>& address, MemoryAccessSize size, bool use_fastmem);
   void Compile_lxx(CompileFlags cf, MemoryAccessSize size, bool sign, bool use_fastmem,
                    const std::optional<VirtualMemoryAddress>& address) override;
   void Compile_lwx(CompileFlags cf, MemoryAccessSize size, bool sign, bool use_fastmem,
@@ -115,6 +115,7 @@ protected:
 
   void GeneratePGXPCallWithMIPSRegs(const void* func, u32 arg1val, Reg arg2reg = Reg::count,
                                     Reg arg3reg = Reg::count) override;
+  void GeneratePGXPMove(Reg dst, Reg src) override;
 
 private:
   void SwitchToFarCode(bool emit_jump, void (Xbyak::CodeGenerator::*jump_op)(const void*) = nullptr);
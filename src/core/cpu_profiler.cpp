@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "cpu_profiler.h"
+#include "cpu_core.h"
+#include "host.h"
+#include "settings.h"
+#include "system.h"
+#include "timing_event.h"
+
+#include "util/imgui_manager.h"
+
+#include "common/error.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/path.h"
+#include "common/string_util.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+
+Log_SetChannel(CPU);
+
+namespace CPU::Profiler {
+// Roughly 1000 samples per emulated second. Cheap enough to leave running for long captures,
+// while still resolving hotspots down to individual loops within a few seconds.
+static constexpr TickCount SAMPLE_INTERVAL_TICKS = System::MASTER_CLOCK / 1000;
+
+static void SampleEventCallback(void* param, TickCount ticks, TickCount ticks_late);
+static std::string GetExportBasePath();
+
+static std::unique_ptr<TimingEvent> s_sample_event;
+static std::unordered_map<u32, u32> s_samples;
+static u64 s_sample_count = 0;
+} // namespace CPU::Profiler
+
+bool CPU::Profiler::IsActive()
+{
+  return static_cast<bool>(s_sample_event);
+}
+
+void CPU::Profiler::SampleEventCallback(void* param, TickCount ticks, TickCount ticks_late)
+{
+  s_samples[g_state.pc]++;
+  s_sample_count++;
+}
+
+void CPU::Profiler::StartSampling()
+{
+  if (!System::IsValid())
+    return;
+
+  s_samples.clear();
+  s_sample_count = 0;
+
+  if (!s_sample_event)
+  {
+    s_sample_event = TimingEvents::CreateTimingEvent("CPU Profiler Sample", SAMPLE_INTERVAL_TICKS,
+                                                     SAMPLE_INTERVAL_TICKS, &SampleEventCallback, nullptr, true);
+  }
+
+  Host::AddKeyedOSDMessage("CPUProfiler", TRANSLATE_STR("OSDMessage", "CPU profiler started."), 5.0f);
+}
+
+void CPU::Profiler::StopSampling()
+{
+  if (!s_sample_event)
+    return;
+
+  s_sample_event.reset();
+
+  if (s_sample_count == 0)
+  {
+    Host::AddKeyedOSDMessage("CPUProfiler", TRANSLATE_STR("OSDMessage", "CPU profiler stopped, no samples collected."),
+                             5.0f);
+    return;
+  }
+
+  const std::string base_path = GetExportBasePath();
+  bool result = true;
+  for (const char* extension : {".csv", ".json"})
+  {
+    const std::string path = fmt::format("{}{}", base_path, extension);
+    Error error;
+    if (!Export(path.c_str(), &error))
+    {
+      Log_ErrorFmt("Failed to export CPU profile to '{}': {}", path, error.GetDescription());
+      result = false;
+    }
+  }
+
+  if (result)
+  {
+    Host::AddKeyedOSDMessage(
+      "CPUProfiler",
+      fmt::format(TRANSLATE_FS("OSDMessage", "CPU profiler stopped, {} samples saved to '{}.csv/.json'."),
+                  s_sample_count, Path::GetFileName(base_path)),
+      10.0f);
+  }
+  else
+  {
+    Host::AddKeyedOSDMessage("CPUProfiler", TRANSLATE_STR("OSDMessage", "Failed to save CPU profile."), 10.0f);
+  }
+}
+
+void CPU::Profiler::ToggleSampling()
+{
+  if (IsActive())
+    StopSampling();
+  else
+    StartSampling();
+}
+
+void CPU::Profiler::Shutdown()
+{
+  StopSampling();
+  s_samples.clear();
+  s_sample_count = 0;
+}
+
+u64 CPU::Profiler::GetSampleCount()
+{
+  return s_sample_count;
+}
+
+std::vector<CPU::Profiler::SampleEntry> CPU::Profiler::GetTopSamples(u32 max_entries)
+{
+  std::vector<SampleEntry> entries;
+  entries.reserve(s_samples.size());
+  for (const auto& [pc, count] : s_samples)
+    entries.push_back({pc, count});
+
+  const auto order = [](const SampleEntry& lhs, const SampleEntry& rhs) {
+    return (lhs.count > rhs.count || (lhs.count == rhs.count && lhs.pc < rhs.pc));
+  };
+  if (max_entries < entries.size())
+  {
+    std::partial_sort(entries.begin(), entries.begin() + max_entries, entries.end(), order);
+    entries.resize(max_entries);
+  }
+  else
+  {
+    std::sort(entries.begin(), entries.end(), order);
+  }
+
+  return entries;
+}
+
+std::string CPU::Profiler::GetExportBasePath()
+{
+  const std::string& serial = System::GetGameSerial();
+  return Path::Combine(EmuFolders::Dumps, fmt::format("cpuprofile-{}-{}", serial.empty() ? "unknown" : serial,
+                                                      static_cast<u64>(std::time(nullptr))));
+}
+
+bool CPU::Profiler::Export(const char* path, Error* error)
+{
+  auto fp = FileSystem::OpenManagedCFile(path, "wb", error);
+  if (!fp)
+    return false;
+
+  const std::vector<SampleEntry> entries = GetTopSamples(std::numeric_limits<u32>::max());
+  if (StringUtil::EndsWithNoCase(path, ".json"))
+  {
+    std::fprintf(fp.get(),
+                 "{\n"
+                 "  \"serial\": \"%s\",\n"
+                 "  \"sample_interval_ticks\": %d,\n"
+                 "  \"total_samples\": %" PRIu64 ",\n"
+                 "  \"samples\": [\n",
+                 System::GetGameSerial().c_str(), static_cast<int>(SAMPLE_INTERVAL_TICKS), s_sample_count);
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+      std::fprintf(fp.get(), "    {\"pc\": \"0x%08X\", \"count\": %u}%s\n", entries[i].pc, entries[i].count,
+                   (i + 1) < entries.size() ? "," : "");
+    }
+    std::fprintf(fp.get(), "  ]\n}\n");
+  }
+  else
+  {
+    std::fprintf(fp.get(), "pc,count,percent\n");
+    for (const SampleEntry& entry : entries)
+    {
+      std::fprintf(fp.get(), "0x%08X,%u,%.4f\n", entry.pc, entry.count,
+                   (static_cast<double>(entry.count) * 100.0) / static_cast<double>(s_sample_count));
+    }
+  }
+
+  if (std::ferror(fp.get()))
+  {
+    Error::SetErrno(error, "fwrite failed: ", errno);
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "types.h"
+
+#include <vector>
+
+class Error;
+
+namespace CPU::Profiler {
+
+struct SampleEntry
+{
+  u32 pc;
+  u32 count;
+};
+
+/// Returns true if the sampling profiler is currently collecting data.
+bool IsActive();
+
+/// Starts collecting samples, discarding any previously-collected data.
+void StartSampling();
+
+/// Stops collecting samples and writes the aggregated data to the dumps directory.
+void StopSampling();
+
+/// Convenience wrapper for the hotkey.
+void ToggleSampling();
+
+/// Tears down the sample event on system shutdown, exporting any collected data first.
+void Shutdown();
+
+/// Returns the number of samples collected since sampling started.
+u64 GetSampleCount();
+
+/// Returns up to max_entries of the most-sampled PCs, sorted by descending count.
+std::vector<SampleEntry> GetTopSamples(u32 max_entries);
+
+/// Writes the aggregated samples to the given path, as JSON or CSV depending on the extension.
+bool Export(const char* path, Error* error);
+
+} // namespace CPU::Profiler
@@ -29,6 +29,11 @@ const void* CodeGenerator::CompileBlock(CodeCache::Block* block, u32* out_host_c
   m_pc_valid = true;
 
   EmitBeginBlock(true);
+
+  // The loop header label has to outlive compilation of the whole block, so it lives here.
+  LabelType loop_header_label;
+  BlockLoopPrologue(&loop_header_label);
+
   BlockPrologue();
 
   m_current_instruction = m_block_start;
@@ -36,6 +41,9 @@ const void* CodeGenerator::CompileBlock(CodeCache::Block* block, u32* out_host_c
   {
     if (!CompileInstruction(*m_current_instruction.instruction, *m_current_instruction.info))
     {
+      m_register_cache.UnpinAllGuestRegisters();
+      m_loop_pinned_registers.clear();
+      m_loop_header_label = nullptr;
       m_current_instruction = {};
       m_block_end = {};
       m_block_start = {};
@@ -70,6 +78,9 @@ const void* CodeGenerator::CompileBlock(CodeCache::Block* block, u32* out_host_c
   const void* code = FinalizeBlock(out_host_code_size, out_host_far_code_size);
   DebugAssert(m_register_cache.GetUsedHostRegisters() == 0);
 
+  m_register_cache.UnpinAllGuestRegisters();
+  m_loop_pinned_registers.clear();
+  m_loop_header_label = nullptr;
   m_current_instruction = {};
   m_block_end = {};
   m_block_start = {};
@@ -1021,6 +1032,97 @@ void CodeGenerator::BlockEpilogue()
   AddPendingCycles(true);
 }
 
+void CodeGenerator::BlockLoopPrologue(LabelType* loop_header_label)
+{
+  // The manual protection check jumps straight out on mismatch, which would leave pinned values
+  // unflushed, so don't pin in manually-checked blocks.
+  if (!g_settings.cpu_recompiler_block_linking || m_block->size < 2 ||
+      m_block->protection == CodeCache::PageProtectionMode::ManualCheck)
+  {
+    return;
+  }
+
+  // Only for blocks which branch directly back to their own start, i.e. self-contained loops.
+  const Instruction branch_instruction = m_block->Instructions()[m_block->size - 2];
+  const CodeCache::InstructionInfo& branch_info = m_block->InstructionsInfo()[m_block->size - 2];
+  if (!branch_info.is_branch_instruction || !branch_info.is_direct_branch_instruction ||
+      GetDirectBranchTarget(branch_instruction, branch_info.pc) != m_block->pc)
+  {
+    return;
+  }
+
+  // Rank guest registers by how often the loop body reads them. Every read of an unpinned register
+  // turns into a load from the CPU struct on each iteration, so pin the most-read ones.
+  std::array<u8, static_cast<u8>(Reg::count)> read_counts = {};
+  for (u32 i = 0; i < m_block->size; i++)
+  {
+    const CodeCache::InstructionInfo& info = m_block->InstructionsInfo()[i];
+    for (const Reg read_reg : info.read_reg)
+    {
+      if (read_reg != Reg::zero)
+        read_counts[static_cast<u8>(read_reg)]++;
+    }
+  }
+
+  constexpr u32 MAX_PINNED_REGISTERS = 4;
+  for (u32 i = 0; i < MAX_PINNED_REGISTERS; i++)
+  {
+    Reg best_reg = Reg::count;
+    u8 best_count = 1;
+    for (u8 j = 0; j < static_cast<u8>(Reg::count); j++)
+    {
+      if (read_counts[j] > best_count)
+      {
+        best_reg = static_cast<Reg>(j);
+        best_count = read_counts[j];
+      }
+    }
+    if (best_reg == Reg::count)
+      break;
+
+    read_counts[static_cast<u8>(best_reg)] = 0;
+
+    // Pinned registers have to live in callee-saved host registers, so they survive function calls.
+    const HostReg host_reg = m_register_cache.GetFreeCalleeSavedHostRegister();
+    if (host_reg == HostReg_Invalid)
+      break;
+
+    const Value value = m_register_cache.ReadGuestRegister(best_reg, true, true, host_reg);
+    m_register_cache.PinGuestRegister(best_reg);
+    m_loop_pinned_registers.emplace_back(best_reg, host_reg);
+
+    Log_DebugPrintf("Pinning guest register %s in host register %s for loop at 0x%08X", GetRegName(best_reg),
+                    GetHostRegName(host_reg, RegSize_32), m_block->pc);
+  }
+
+  if (m_loop_pinned_registers.empty())
+    return;
+
+  EmitBindLabel(loop_header_label);
+  m_loop_header_label = loop_header_label;
+}
+
+void CodeGenerator::BlockLoopBackEdge()
+{
+  // Restore the state the loop header was compiled with: every pinned register sitting clean in
+  // its own host register. Dirty values get written back here, displaced values (e.g. renamed by
+  // a write) get reloaded. Two passes, because a displaced value can be sitting in another pinned
+  // register's home.
+  for (const auto& [guest_reg, host_reg] : m_loop_pinned_registers)
+  {
+    const std::optional<HostReg> current_reg = m_register_cache.GetHostRegisterForGuestRegister(guest_reg);
+    const bool in_place = (current_reg.has_value() && current_reg.value() == host_reg);
+    m_register_cache.FlushGuestRegister(guest_reg, !in_place, true);
+  }
+  for (const auto& [guest_reg, host_reg] : m_loop_pinned_registers)
+  {
+    if (!m_register_cache.IsGuestRegisterInHostRegister(guest_reg))
+      EmitLoadGuestRegister(host_reg, guest_reg);
+  }
+
+  EmitBranch(m_loop_header_label);
+}
+
 void CodeGenerator::InstructionPrologue(Instruction instruction, const CodeCache::InstructionInfo& info,
                                         TickCount cycles, bool force_sync /* = false */)
 {
@@ -1080,7 +1182,34 @@ void CodeGenerator::InstructionEpilogue(Instruction instruction, const CodeCache
   {
     // we have to invalidate the register cache, since the load delayed register might've been cached
     Log_DebugPrint("Emitting delay slot flush");
-    EmitFlushInterpreterLoadDelay();
+    if (!m_loop_pinned_registers.empty())
+    {
+      // A delayed load landing on a pinned register updates the CPU struct behind its host copy,
+      // so compare against the delayed register index and refresh any clean pin it hits. Dirty
+      // pins keep their value, matching the interpreter's write-over-load behaviour.
+      Value delay_reg = m_register_cache.AllocateScratch(RegSize_8);
+      EmitLoadCPUStructField(delay_reg.GetHostRegister(), RegSize_8, offsetof(State, load_delay_reg));
+      EmitFlushInterpreterLoadDelay();
+      for (const auto& [guest_reg, host_reg] : m_loop_pinned_registers)
+      {
+        const std::optional<HostReg> current_reg = m_register_cache.GetHostRegisterForGuestRegister(guest_reg);
+        if (!current_reg.has_value() || current_reg.value() != host_reg ||
+            m_register_cache.IsGuestRegisterDirty(guest_reg))
+        {
+          continue;
+        }
+
+        LabelType not_delayed;
+        EmitConditionalBranch(Condition::NotEqual, false, delay_reg.GetHostRegister(),
+                              Value::FromConstantU8(static_cast<u8>(guest_reg)), &not_delayed);
+        EmitLoadGuestRegister(host_reg, guest_reg);
+        EmitBindLabel(&not_delayed);
+      }
+    }
+    else
+    {
+      EmitFlushInterpreterLoadDelay();
+    }
     m_register_cache.InvalidateAllNonDirtyGuestRegisters();
     m_load_delay_dirty = false;
   }
@@ -2427,7 +2556,21 @@ bool CodeGenerator::Compile_Branch(Instruction instruction, const CodeCache::Ins
         return false;
 
       // flush all regs since we're at the end of the block now
-      BlockEpilogue();
+      const bool is_loop_backedge = (m_loop_header_label && branch_target.IsConstant() &&
+                                     static_cast<u32>(branch_target.constant_value) == m_block->pc);
+      if (is_loop_backedge)
+      {
+        // Pinned registers stay resident across the back-edge, everything else gets flushed as in
+        // the normal epilogue.
+        m_register_cache.FlushUnpinnedGuestRegisters(true, true);
+        if (m_register_cache.HasLoadDelay())
+          m_register_cache.WriteLoadDelayToCPU(true);
+        AddPendingCycles(true);
+      }
+      else
+      {
+        BlockEpilogue();
+      }
       m_block_linked = true;
 
       // check downcount
@@ -2449,16 +2592,21 @@ bool CodeGenerator::Compile_Branch(Instruction instruction, const CodeCache::Ins
                                 &return_to_dispatcher);
 
           // we're committed at this point :D
-          EmitEndBlock(true, nullptr);
-
           DebugAssert(branch_target.IsConstant());
-          if (static_cast<u32>(branch_target.constant_value) == m_block->pc)
+          if (is_loop_backedge)
+          {
+            // jump back inside the block, keeping the pinned registers live
+            BlockLoopBackEdge();
+          }
+          else if (static_cast<u32>(branch_target.constant_value) == m_block->pc)
           {
             // self-link
+            EmitEndBlock(true, nullptr);
             EmitBranch(GetStartNearCodePointer());
           }
           else
           {
+            EmitEndBlock(true, nullptr);
             const void* host_target = CPU::CodeCache::CreateBlockLink(m_block, GetCurrentCodePointer(),
                                                                       static_cast<u32>(branch_target.constant_value));
             EmitBranch(host_target);
@@ -2474,6 +2622,10 @@ bool CodeGenerator::Compile_Branch(Instruction instruction, const CodeCache::Ins
 
       if (condition != Condition::Always)
       {
+        // leaving the loop, so the pinned registers have to be written back
+        if (is_loop_backedge)
+          m_register_cache.FlushAllGuestRegisters(true, true);
+
         WriteNewPC(next_pc, true);
       }
       else
@@ -2484,25 +2636,35 @@ bool CodeGenerator::Compile_Branch(Instruction instruction, const CodeCache::Ins
       EmitConditionalBranch(Condition::GreaterEqual, false, pending_ticks.GetHostRegister(), downcount,
                             &return_to_dispatcher);
 
-      EmitEndBlock(true, nullptr);
-
-      const Value& jump_target = (condition != Condition::Always) ? constant_next_pc : branch_target;
-      DebugAssert(jump_target.IsConstant());
-      if (static_cast<u32>(jump_target.constant_value) == m_block->pc)
+      if (is_loop_backedge && condition == Condition::Always)
       {
-        // self-link
-        EmitBranch(GetStartNearCodePointer());
+        // jump back inside the block, keeping the pinned registers live
+        BlockLoopBackEdge();
       }
       else
       {
-        const void* host_target = CPU::CodeCache::CreateBlockLink(m_block, GetCurrentCodePointer(),
-                                                                  static_cast<u32>(jump_target.constant_value));
-        EmitBranch(host_target);
+        EmitEndBlock(true, nullptr);
+
+        const Value& jump_target = (condition != Condition::Always) ? constant_next_pc : branch_target;
+        DebugAssert(jump_target.IsConstant());
+        if (static_cast<u32>(jump_target.constant_value) == m_block->pc)
+        {
+          // self-link
+          EmitBranch(GetStartNearCodePointer());
+        }
+        else
+        {
+          const void* host_target = CPU::CodeCache::CreateBlockLink(m_block, GetCurrentCodePointer(),
+                                                                    static_cast<u32>(jump_target.constant_value));
+          EmitBranch(host_target);
+        }
       }
 
       m_register_cache.PopState();
 
       EmitBindLabel(&return_to_dispatcher);
+      if (is_loop_backedge)
+        m_register_cache.FlushAllGuestRegisters(true, true);
       EmitEndBlock(true, CodeCache::g_run_events_and_dispatch);
     }
     else
@@ -3121,7 +3283,7 @@ bool CodeGenerator::Compile_cop2(Instruction instruction, const CodeCache::Instr
   else
   {
     TickCount func_ticks;
-    GTE::InstructionImpl func = GTE::GetInstructionImpl(instruction.bits, &func_ticks);
+    GTE::InstructionImpl func = GTE::GetInstructionImpl(instruction.bits, &func_ticks, !info.gte_flags_dead);
 
     // forward everything to the GTE.
     StallUntilGTEComplete();
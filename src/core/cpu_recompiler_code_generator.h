@@ -4,6 +4,7 @@
 #pragma once
 #include <array>
 #include <initializer_list>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -228,6 +229,8 @@ private:
   // branch target, memory address, etc
   void BlockPrologue();
   void BlockEpilogue();
+  void BlockLoopPrologue(LabelType* loop_header_label);
+  void BlockLoopBackEdge();
   void InstructionPrologue(Instruction instruction, const CodeCache::InstructionInfo& info, TickCount cycles,
                            bool force_sync = false);
   void InstructionEpilogue(Instruction instruction, const CodeCache::InstructionInfo& info);
@@ -285,6 +288,12 @@ private:
   bool m_pc_valid = false;
   bool m_block_linked = false;
 
+  // Loop-aware register allocation for blocks which branch back to their own start. The header
+  // label sits after the pinned register loads, and the back-edge jumps to it directly.
+  LabelType* m_loop_header_label = nullptr;
+  std::vector<std::pair<Reg, HostReg>, ScratchAllocator<std::pair<Reg, HostReg>>> m_loop_pinned_registers{
+    ScratchAllocator<std::pair<Reg, HostReg>>(CodeCache::GetScratchArena())};
+
   // whether various flags need to be reset.
   bool m_current_instruction_in_branch_delay_slot_dirty = false;
   bool m_branch_was_taken_dirty = false;
@@ -297,10 +306,16 @@ private:
   //////////////////////////////////////////////////////////////////////////
   // Speculative Constants
   //////////////////////////////////////////////////////////////////////////
+  // Scratch-arena backed, since a CodeGenerator only lives for a single block compile.
+  using SpeculativeMemoryMap =
+    std::unordered_map<PhysicalMemoryAddress, SpeculativeValue, std::hash<PhysicalMemoryAddress>,
+                       std::equal_to<PhysicalMemoryAddress>,
+                       ScratchAllocator<std::pair<const PhysicalMemoryAddress, SpeculativeValue>>>;
+
   struct SpeculativeConstants
   {
     std::array<SpeculativeValue, static_cast<u8>(Reg::count)> regs;
-    std::unordered_map<PhysicalMemoryAddress, SpeculativeValue> memory;
+    SpeculativeMemoryMap memory{SpeculativeMemoryMap::allocator_type(CodeCache::GetScratchArena())};
     SpeculativeValue cop0_sr;
   };
 
@@ -12,6 +12,7 @@
 #include "common/align.h"
 #include "common/assert.h"
 #include "common/log.h"
+#include "common/thirdparty/SmallVector.h"
 
 #ifdef CPU_ARCH_X64
 
@@ -2800,24 +2801,50 @@ void CodeGenerator::EmitICacheCheckAndUpdate()
   }
   else
   {
+    // Gather the lines with a fill cost up front, so the hot path is nothing but a compare chain.
+    struct LineInfo
+    {
+      u32 offset;
+      u32 tag;
+      TickCount fill_ticks;
+    };
+    llvm::SmallVector<LineInfo, 16> lines;
     VirtualMemoryAddress current_pc = m_pc & ICACHE_TAG_ADDRESS_MASK;
     for (u32 i = 0; i < m_block->icache_line_count; i++, current_pc += ICACHE_LINE_SIZE)
     {
-      const VirtualMemoryAddress tag = GetICacheTagForAddress(current_pc);
       const TickCount fill_ticks = GetICacheFillTicks(current_pc);
       if (fill_ticks <= 0)
         continue;
 
-      const u32 line = GetICacheLine(current_pc);
-      const u32 offset = offsetof(State, icache_tags) + (line * sizeof(u32));
-      Xbyak::Label cache_hit;
+      lines.push_back(
+        {static_cast<u32>(offsetof(State, icache_tags) + (GetICacheLine(current_pc) * sizeof(u32))),
+         GetICacheTagForAddress(current_pc), fill_ticks});
+    }
+    if (lines.empty())
+      return;
 
-      m_emit->cmp(m_emit->dword[GetCPUPtrReg() + offset], tag);
+    // All-hit is the overwhelmingly common case, so compare all tags and fall through with zero
+    // cost; any mismatch takes the far path, which does the precise per-line update and jumps back.
+    const void* const slowpath = GetCurrentFarCodePointer();
+    for (const LineInfo& line : lines)
+    {
+      m_emit->cmp(m_emit->dword[GetCPUPtrReg() + line.offset], line.tag);
+      m_emit->jne(slowpath);
+    }
+
+    const void* const resume = m_emit->getCurr<const void*>();
+    SwitchToFarCode();
+    for (const LineInfo& line : lines)
+    {
+      Xbyak::Label cache_hit;
+      m_emit->cmp(m_emit->dword[GetCPUPtrReg() + line.offset], line.tag);
       m_emit->je(cache_hit);
-      m_emit->mov(m_emit->dword[GetCPUPtrReg() + offset], tag);
-      m_emit->add(m_emit->dword[GetCPUPtrReg() + offsetof(State, pending_ticks)], static_cast<u32>(fill_ticks));
+      m_emit->mov(m_emit->dword[GetCPUPtrReg() + line.offset], line.tag);
+      m_emit->add(m_emit->dword[GetCPUPtrReg() + offsetof(State, pending_ticks)], static_cast<u32>(line.fill_ticks));
       m_emit->L(cache_hit);
     }
+    m_emit->jmp(resume);
+    SwitchToNearCode();
   }
 }
 
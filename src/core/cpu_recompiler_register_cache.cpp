@@ -839,10 +839,12 @@ void RegisterCache::InvalidateGuestRegister(Reg guest_reg)
 
 void RegisterCache::InvalidateAllNonDirtyGuestRegisters()
 {
+  // Pinned registers are kept; the code generator refreshes them if the interpreter load delay
+  // lands on one.
   for (u8 reg = 0; reg < static_cast<u8>(Reg::count); reg++)
   {
     Value& cache_value = m_state.guest_reg_state[reg];
-    if (cache_value.IsValid() && !cache_value.IsDirty())
+    if (cache_value.IsValid() && !cache_value.IsDirty() && !m_guest_reg_pinned[reg])
       InvalidateGuestRegister(static_cast<Reg>(reg));
   }
 }
@@ -868,13 +870,47 @@ void RegisterCache::FlushCallerSavedGuestRegisters(bool invalidate, bool clear_d
   }
 }
 
+void RegisterCache::FlushUnpinnedGuestRegisters(bool invalidate, bool clear_dirty)
+{
+  for (u8 reg = 0; reg < static_cast<u8>(Reg::count); reg++)
+  {
+    if (!m_guest_reg_pinned[reg])
+      FlushGuestRegister(static_cast<Reg>(reg), invalidate, clear_dirty);
+  }
+}
+
+HostReg RegisterCache::GetFreeCalleeSavedHostRegister() const
+{
+  for (u32 i = 0; i < m_state.available_count; i++)
+  {
+    const HostReg reg = m_host_register_allocation_order[i];
+    if ((m_state.host_reg_state[reg] & (HostRegState::Usable | HostRegState::InUse | HostRegState::CallerSaved)) ==
+        HostRegState::Usable)
+    {
+      return reg;
+    }
+  }
+
+  return HostReg_Invalid;
+}
+
 bool RegisterCache::EvictOneGuestRegister()
 {
   if (m_state.guest_reg_order_count == 0)
     return false;
 
-  // evict the register used the longest time ago
-  Reg evict_reg = m_state.guest_reg_order[m_state.guest_reg_order_count - 1];
+  // evict the register used the longest time ago, preferring those which aren't pinned to a loop
+  Reg evict_reg = Reg::count;
+  for (u32 i = m_state.guest_reg_order_count; i > 0; i--)
+  {
+    if (!m_guest_reg_pinned[static_cast<u8>(m_state.guest_reg_order[i - 1])])
+    {
+      evict_reg = m_state.guest_reg_order[i - 1];
+      break;
+    }
+  }
+  if (evict_reg == Reg::count)
+    evict_reg = m_state.guest_reg_order[m_state.guest_reg_order_count - 1];
   Log_ProfilePrintf("Evicting guest register %s", GetRegName(evict_reg));
   FlushGuestRegister(evict_reg, true, true);
 
@@ -3,6 +3,7 @@
 
 #pragma once
 #include "common/assert.h"
+#include "cpu_code_cache_private.h"
 #include "cpu_recompiler_types.h"
 #include "cpu_types.h"
 
@@ -13,6 +14,7 @@
 #endif
 
 #include <array>
+#include <deque>
 #include <optional>
 #include <stack>
 #include <tuple>
@@ -407,6 +409,24 @@ public:
   void FlushCallerSavedGuestRegisters(bool invalidate, bool clear_dirty);
   bool EvictOneGuestRegister();
 
+  /// Returns true if the cached guest register has been modified since the last flush.
+  bool IsGuestRegisterDirty(Reg guest_reg) const
+  {
+    return m_state.guest_reg_state[static_cast<u8>(guest_reg)].IsDirty();
+  }
+
+  /// Pins a guest register for loop-aware allocation. Pinned registers are only evicted as a last resort.
+  void PinGuestRegister(Reg guest_reg) { m_guest_reg_pinned[static_cast<u8>(guest_reg)] = true; }
+  void UnpinAllGuestRegisters() { m_guest_reg_pinned.fill(false); }
+  bool IsGuestRegisterPinned(Reg guest_reg) const { return m_guest_reg_pinned[static_cast<u8>(guest_reg)]; }
+
+  /// Flushes all guest registers which aren't pinned. Used at loop back-edges, where the pinned
+  /// registers stay resident in host registers across iterations.
+  void FlushUnpinnedGuestRegisters(bool invalidate, bool clear_dirty);
+
+  /// Returns a usable callee-saved host register which is currently unallocated, or HostReg_Invalid.
+  HostReg GetFreeCalleeSavedHostRegister() const;
+
   /// Temporarily prevents register allocation.
   void InhibitAllocation();
   void UninhibitAllocation();
@@ -441,7 +461,14 @@ private:
     Value next_load_delay_value{};
   } m_state;
 
-  std::stack<RegAllocState> m_state_stack;
+  // Deque-backed and RegAllocState is large, so put it on the compile scratch arena instead of
+  // paying a heap allocation on the first push of every block.
+  std::stack<RegAllocState, std::deque<RegAllocState, ScratchAllocator<RegAllocState>>> m_state_stack{
+    std::deque<RegAllocState, ScratchAllocator<RegAllocState>>(
+      ScratchAllocator<RegAllocState>(CPU::CodeCache::GetScratchArena()))};
+
+  // Not part of the push/pop state, pins last for the whole block.
+  std::array<bool, static_cast<u8>(Reg::count)> m_guest_reg_pinned{};
 };
 
 } // namespace CPU::Recompiler
\ No newline at end of file
@@ -111,6 +111,9 @@ enum class InstructionOp : u8
   swc1 = 57,
   swc2 = 58,
   swc3 = 59,
+
+  // not a real opcode, used as "not known at compile time" by the interpreter dispatch
+  count = 64,
 };
 constexpr u8 INSTRUCTION_COP_BITS = 0x10;
 constexpr u8 INSTRUCTION_COP_MASK = 0x3C;
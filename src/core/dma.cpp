@@ -22,6 +22,7 @@
 #include "common/log.h"
 #include "common/string_util.h"
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <vector>
@@ -181,6 +182,14 @@ static TickCount TransferDeviceToMemory(u32 address, u32 increment, u32 word_cou
 template<Channel channel>
 static TickCount TransferMemoryToDevice(u32 address, u32 increment, u32 word_count);
 
+// number of words the device can accept (writes) or supply (reads) right now, used to size
+// batched block transfers. Channels without a cheap capacity query return 0, limiting them to
+// one block per device call.
+template<Channel channel>
+static u32 GetDeviceWriteCapacity();
+template<Channel channel>
+static u32 GetDeviceReadCapacity();
+
 // configuration
 static TickCount s_max_slice_ticks = 1000;
 static TickCount s_halt_ticks = 100;
@@ -528,11 +537,18 @@ bool DMA::TransferChannel()
 
       u8* ram_pointer = Bus::g_ram;
       TickCount remaining_ticks = GetTransferSliceTicks();
+      TickCount used_ticks = 0;
+
+      // The GPU FIFO push is inlined here so command execution (EndDMAWrite()) can be deferred to
+      // once per slice instead of once per linked list node, and cycles are charged in aggregate.
+      [[maybe_unused]] bool gpu_words_pushed = false;
+      [[maybe_unused]] const bool gpu_write_ok = (channel != Channel::GPU) || g_gpu->BeginDMAWrite();
+
       while (cs.request && remaining_ticks > 0)
       {
         u32 header;
         std::memcpy(&header, &ram_pointer[current_address & mask], sizeof(header));
-        CPU::AddPendingTicks(10);
+        used_ticks += 10;
         remaining_ticks -= 10;
 
         const u32 word_count = header >> 24;
@@ -541,12 +557,34 @@ bool DMA::TransferChannel()
                         word_count * UINT32_C(4), word_count, next_address);
         if (word_count > 0)
         {
-          CPU::AddPendingTicks(5);
+          used_ticks += 5;
           remaining_ticks -= 5;
 
-          const TickCount block_ticks =
-            TransferMemoryToDevice<channel>((current_address + sizeof(header)) & mask, 4, word_count);
-          CPU::AddPendingTicks(block_ticks);
+          TickCount block_ticks;
+          if constexpr (channel == Channel::GPU)
+          {
+            if (gpu_write_ok) [[likely]]
+            {
+              u32 word_address = (current_address + sizeof(header)) & mask;
+              for (u32 i = 0; i < word_count; i++)
+              {
+                u32 value;
+                std::memcpy(&value, &ram_pointer[word_address], sizeof(u32));
+                g_gpu->DMAWrite(word_address, value);
+                word_address = (word_address + 4) & mask;
+              }
+
+              gpu_words_pushed = true;
+            }
+
+            block_ticks = Bus::GetDMARAMTickCount(word_count);
+          }
+          else
+          {
+            block_ticks = TransferMemoryToDevice<channel>((current_address + sizeof(header)) & mask, 4, word_count);
+          }
+
+          used_ticks += block_ticks;
           remaining_ticks -= block_ticks;
         }
 
@@ -555,6 +593,14 @@ bool DMA::TransferChannel()
           break;
       }
 
+      if constexpr (channel == Channel::GPU)
+      {
+        if (gpu_words_pushed)
+          g_gpu->EndDMAWrite();
+      }
+
+      CPU::AddPendingTicks(used_ticks);
+
       cs.base_address = current_address;
 
       if (current_address & UINT32_C(0x800000))
@@ -585,30 +631,50 @@ bool DMA::TransferChannel()
       u32 blocks_remaining = cs.block_control.request.GetBlockCount();
       TickCount ticks_remaining = GetTransferSliceTicks();
 
+      // Each batch moves as many whole blocks as the device FIFO can accept and the tick budget
+      // covers with a single bulk transfer, instead of one device call per block. Ticks are still
+      // charged per block row rather than for the combined length, so batching does not change
+      // timing; GetDMARAMTickCount() includes per-row overhead.
+      const TickCount ticks_per_block = Bus::GetDMARAMTickCount(block_size);
+
       if (copy_to_device)
       {
         do
         {
-          blocks_remaining--;
+          const u32 capacity_blocks = GetDeviceWriteCapacity<channel>() / block_size;
+          const u32 budget_blocks =
+            static_cast<u32>((ticks_remaining + (ticks_per_block - 1)) / ticks_per_block);
+          const u32 batch_blocks = std::clamp(std::min(capacity_blocks, budget_blocks), 1u, blocks_remaining);
+
+          blocks_remaining -= batch_blocks;
 
-          const TickCount ticks = TransferMemoryToDevice<channel>(current_address & mask, increment, block_size);
+          TransferMemoryToDevice<channel>(current_address & mask, increment, block_size * batch_blocks);
+
+          const TickCount ticks = ticks_per_block * static_cast<TickCount>(batch_blocks);
           CPU::AddPendingTicks(ticks);
           ticks_remaining -= ticks;
 
-          current_address = (current_address + (increment * block_size));
+          current_address = (current_address + (increment * block_size * batch_blocks));
         } while (cs.request && blocks_remaining > 0 && ticks_remaining > 0);
       }
       else
       {
         do
         {
-          blocks_remaining--;
+          const u32 capacity_blocks = GetDeviceReadCapacity<channel>() / block_size;
+          const u32 budget_blocks =
+            static_cast<u32>((ticks_remaining + (ticks_per_block - 1)) / ticks_per_block);
+          const u32 batch_blocks = std::clamp(std::min(capacity_blocks, budget_blocks), 1u, blocks_remaining);
+
+          blocks_remaining -= batch_blocks;
 
-          const TickCount ticks = TransferDeviceToMemory<channel>(current_address & mask, increment, block_size);
+          TransferDeviceToMemory<channel>(current_address & mask, increment, block_size * batch_blocks);
+
+          const TickCount ticks = ticks_per_block * static_cast<TickCount>(batch_blocks);
           CPU::AddPendingTicks(ticks);
           ticks_remaining -= ticks;
 
-          current_address = (current_address + (increment * block_size));
+          current_address = (current_address + (increment * block_size * batch_blocks));
         } while (cs.request && blocks_remaining > 0 && ticks_remaining > 0);
       }
 
@@ -681,6 +747,41 @@ void DMA::UnhaltTransfer(void*, TickCount ticks, TickCount ticks_late)
   s_halt_ticks_remaining = 0;
 }
 
+template<DMA::Channel channel>
+u32 DMA::GetDeviceWriteCapacity()
+{
+  switch (channel)
+  {
+    case Channel::GPU:
+      return g_gpu->GetDMAWriteSpace();
+
+    case Channel::SPU:
+      return SPU::GetDMAWriteSpace();
+
+    case Channel::MDECin:
+      return MDEC::GetDMAWriteSpace();
+
+    default:
+      return 0;
+  }
+}
+
+template<DMA::Channel channel>
+u32 DMA::GetDeviceReadCapacity()
+{
+  switch (channel)
+  {
+    case Channel::CDROM:
+      return CDROM::GetDMAReadAvailable();
+
+    case Channel::MDECout:
+      return MDEC::GetDMAReadAvailable();
+
+    default:
+      return 0;
+  }
+}
+
 template<DMA::Channel channel>
 TickCount DMA::TransferMemoryToDevice(u32 address, u32 increment, u32 word_count)
 {
@@ -695,11 +796,19 @@ TickCount DMA::TransferMemoryToDevice(u32 address, u32 increment, u32 word_count
         s_transfer_buffer.resize(word_count);
       src_pointer = s_transfer_buffer.data();
 
-      u8* ram_pointer = Bus::g_ram;
-      for (u32 i = 0; i < word_count; i++)
+      if (static_cast<s32>(increment) > 0)
       {
-        std::memcpy(&s_transfer_buffer[i], &ram_pointer[address], sizeof(u32));
-        address = (address + increment) & mask;
+        // Forward transfer wrapping through a RAM mirror: bulk copy split at the boundary.
+        Bus::ReadWordsFromRAM(address, s_transfer_buffer.data(), word_count);
+      }
+      else
+      {
+        u8* ram_pointer = Bus::g_ram;
+        for (u32 i = 0; i < word_count; i++)
+        {
+          std::memcpy(&s_transfer_buffer[i], &ram_pointer[address], sizeof(u32));
+          address = (address + increment) & mask;
+        }
       }
     }
   }
@@ -752,15 +861,32 @@ TickCount DMA::TransferDeviceToMemory(u32 address, u32 increment, u32 word_count
     // clear ordering table
     u8* ram_pointer = Bus::g_ram;
     const u32 word_count_less_1 = word_count - 1;
-    for (u32 i = 0; i < word_count_less_1; i++)
+    if (address >= (word_count_less_1 * 4)) [[likely]]
     {
-      u32 value = ((address - 4) & mask);
-      std::memcpy(&ram_pointer[address], &value, sizeof(value));
-      address = (address - 4) & mask;
+      // Not wrapping around the mirror, so fill the table in ascending order without per-word
+      // masking. This lets the compiler vectorize the loop.
+      const u32 terminator_address = address - (word_count_less_1 * 4);
+      u32 value = UINT32_C(0xFFFFFF);
+      std::memcpy(&ram_pointer[terminator_address], &value, sizeof(value));
+      for (u32 i = 1; i <= word_count_less_1; i++)
+      {
+        value = terminator_address + ((i - 1) * 4);
+        std::memcpy(&ram_pointer[terminator_address + (i * 4)], &value, sizeof(value));
+      }
+    }
+    else
+    {
+      for (u32 i = 0; i < word_count_less_1; i++)
+      {
+        u32 value = ((address - 4) & mask);
+        std::memcpy(&ram_pointer[address], &value, sizeof(value));
+        address = (address - 4) & mask;
+      }
+
+      const u32 terminator = UINT32_C(0xFFFFFF);
+      std::memcpy(&ram_pointer[address], &terminator, sizeof(terminator));
     }
 
-    const u32 terminator = UINT32_C(0xFFFFFF);
-    std::memcpy(&ram_pointer[address], &terminator, sizeof(terminator));
     return Bus::GetDMARAMTickCount(word_count);
   }
 
@@ -800,11 +926,19 @@ TickCount DMA::TransferDeviceToMemory(u32 address, u32 increment, u32 word_count
 
   if (dest_pointer == s_transfer_buffer.data()) [[unlikely]]
   {
-    u8* ram_pointer = Bus::g_ram;
-    for (u32 i = 0; i < word_count; i++)
+    if (static_cast<s32>(increment) > 0)
     {
-      std::memcpy(&ram_pointer[address], &s_transfer_buffer[i], sizeof(u32));
-      address = (address + increment) & mask;
+      // Forward transfer wrapping through a RAM mirror: bulk copy split at the boundary.
+      Bus::WriteWordsToRAM(address, s_transfer_buffer.data(), word_count);
+    }
+    else
+    {
+      u8* ram_pointer = Bus::g_ram;
+      for (u32 i = 0; i < word_count; i++)
+      {
+        std::memcpy(&ram_pointer[address], &s_transfer_buffer[i], sizeof(u32));
+        address = (address + increment) & mask;
+      }
     }
   }
 
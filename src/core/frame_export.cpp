@@ -0,0 +1,247 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "frame_export.h"
+#include "settings.h"
+
+#include "common/log.h"
+#include "common/small_string.h"
+#include "common/string_util.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include "common/windows_headers.h"
+#else
+#include <fcntl.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+Log_SetChannel(FrameExport);
+
+namespace FrameExport {
+static u8* MapChannel(size_t size);
+static void UnmapChannel();
+
+static constexpr u32 BUFFER_SIZE = MAX_FRAME_WIDTH * MAX_FRAME_HEIGHT * sizeof(u32);
+static constexpr size_t CHANNEL_SIZE =
+  sizeof(ChannelHeader) + static_cast<size_t>(NUM_BUFFERS) * (sizeof(FrameHeader) + BUFFER_SIZE);
+
+static u8* s_channel = nullptr;
+static u32 s_next_buffer = 0;
+static bool s_size_warning_shown = false;
+
+#ifdef _WIN32
+static HANDLE s_mapping = nullptr;
+static HANDLE s_signal = nullptr;
+#else
+static int s_fd = -1;
+static sem_t* s_signal = SEM_FAILED;
+#endif
+} // namespace FrameExport
+
+#ifdef _WIN32
+
+u8* FrameExport::MapChannel(size_t size)
+{
+  const std::wstring name = StringUtil::UTF8StringToWideString(TinyString::from_format("Local\\{}", CHANNEL_NAME));
+  s_mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+                                 static_cast<DWORD>(size), name.c_str());
+  if (!s_mapping)
+  {
+    Log_ErrorFmt("CreateFileMappingW() failed: {}", GetLastError());
+    return nullptr;
+  }
+
+  u8* ptr = static_cast<u8*>(MapViewOfFile(s_mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, size));
+  if (!ptr)
+  {
+    Log_ErrorFmt("MapViewOfFile() failed: {}", GetLastError());
+    CloseHandle(s_mapping);
+    s_mapping = nullptr;
+    return nullptr;
+  }
+
+  const std::wstring signal_name = StringUtil::UTF8StringToWideString(TinyString::from_format("Local\\{}", SIGNAL_NAME));
+  s_signal = CreateEventW(nullptr, FALSE, FALSE, signal_name.c_str());
+  if (!s_signal)
+  {
+    Log_ErrorFmt("CreateEventW() failed: {}", GetLastError());
+    UnmapViewOfFile(ptr);
+    CloseHandle(s_mapping);
+    s_mapping = nullptr;
+    return nullptr;
+  }
+
+  return ptr;
+}
+
+void FrameExport::UnmapChannel()
+{
+  UnmapViewOfFile(s_channel);
+  CloseHandle(s_mapping);
+  CloseHandle(s_signal);
+  s_mapping = nullptr;
+  s_signal = nullptr;
+}
+
+#else
+
+u8* FrameExport::MapChannel(size_t size)
+{
+  const TinyString name = TinyString::from_format("/{}", CHANNEL_NAME);
+
+  // no O_EXCL, a stale object from a previous unclean exit just gets reused
+  s_fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+  if (s_fd < 0)
+  {
+    Log_ErrorFmt("shm_open() failed: {}", errno);
+    return nullptr;
+  }
+
+  if (ftruncate(s_fd, static_cast<off_t>(size)) < 0)
+  {
+    Log_ErrorFmt("ftruncate({}) failed: {}", size, errno);
+    close(s_fd);
+    s_fd = -1;
+    return nullptr;
+  }
+
+  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, s_fd, 0);
+  if (ptr == MAP_FAILED)
+  {
+    Log_ErrorFmt("mmap({}) failed: {}", size, errno);
+    close(s_fd);
+    s_fd = -1;
+    return nullptr;
+  }
+
+  const TinyString signal_name = TinyString::from_format("/{}", SIGNAL_NAME);
+  s_signal = sem_open(signal_name.c_str(), O_CREAT, 0600, 0);
+  if (s_signal == SEM_FAILED)
+  {
+    Log_ErrorFmt("sem_open() failed: {}", errno);
+    munmap(ptr, size);
+    close(s_fd);
+    s_fd = -1;
+    return nullptr;
+  }
+
+  return static_cast<u8*>(ptr);
+}
+
+void FrameExport::UnmapChannel()
+{
+  munmap(s_channel, CHANNEL_SIZE);
+  close(s_fd);
+  s_fd = -1;
+  shm_unlink(TinyString::from_format("/{}", CHANNEL_NAME).c_str());
+  sem_close(s_signal);
+  sem_unlink(TinyString::from_format("/{}", SIGNAL_NAME).c_str());
+  s_signal = SEM_FAILED;
+}
+
+#endif
+
+void FrameExport::Initialize()
+{
+  if (!g_settings.debugging.export_frames || s_channel)
+    return;
+
+  s_channel = MapChannel(CHANNEL_SIZE);
+  if (!s_channel)
+  {
+    Log_ErrorPrint("Failed to create frame export channel.");
+    return;
+  }
+
+  // The header and sequence words are re-initialized even if the OS handed back an existing
+  // mapping, so readers never see leftovers from a previous run as a fresh frame.
+  ChannelHeader* ch = reinterpret_cast<ChannelHeader*>(s_channel);
+  ch->magic = CHANNEL_MAGIC;
+  ch->version = CHANNEL_VERSION;
+  ch->buffer_count = NUM_BUFFERS;
+  ch->buffer_size = BUFFER_SIZE;
+  ch->max_width = MAX_FRAME_WIDTH;
+  ch->max_height = MAX_FRAME_HEIGHT;
+  ch->write_index = ~0u;
+  ch->unused = 0;
+  for (u32 i = 0; i < NUM_BUFFERS; i++)
+  {
+    std::memset(s_channel + sizeof(ChannelHeader) + i * (sizeof(FrameHeader) + BUFFER_SIZE), 0, sizeof(FrameHeader));
+  }
+
+  s_next_buffer = 0;
+  s_size_warning_shown = false;
+  Log_InfoFmt("Frame export channel '{}' active ({} {}x{} buffers).", CHANNEL_NAME, NUM_BUFFERS, MAX_FRAME_WIDTH,
+              MAX_FRAME_HEIGHT);
+}
+
+void FrameExport::Shutdown()
+{
+  if (!s_channel)
+    return;
+
+  UnmapChannel();
+  s_channel = nullptr;
+}
+
+bool FrameExport::IsActive()
+{
+  return (s_channel != nullptr);
+}
+
+void FrameExport::PublishFrame(const u32* pixels, u32 width, u32 height, u32 frame_number, u32 internal_frame_number,
+                               u64 timestamp_ns)
+{
+  if (!s_channel)
+    return;
+
+  const u32 stride = width * sizeof(u32);
+  if (width > MAX_FRAME_WIDTH || height > MAX_FRAME_HEIGHT)
+  {
+    if (!s_size_warning_shown)
+    {
+      Log_WarningFmt("{}x{} frame exceeds export channel capacity of {}x{}, frames will not be published.", width,
+                     height, MAX_FRAME_WIDTH, MAX_FRAME_HEIGHT);
+      s_size_warning_shown = true;
+    }
+    return;
+  }
+
+  ChannelHeader* ch = reinterpret_cast<ChannelHeader*>(s_channel);
+  const u32 index = s_next_buffer;
+  s_next_buffer = (index + 1) % NUM_BUFFERS;
+
+  u8* buffer = s_channel + sizeof(ChannelHeader) + index * (sizeof(FrameHeader) + BUFFER_SIZE);
+  FrameHeader* fh = reinterpret_cast<FrameHeader*>(buffer);
+
+  // Seqlock write: odd sequence while the copy is in progress, even once the buffer is
+  // consistent, write_index last so readers only ever chase completed buffers. A release store
+  // only orders the writes preceding it, so the fence is what stops the data writes below from
+  // being hoisted above the odd sequence on weakly-ordered hosts.
+  std::atomic_ref<u32> sequence(fh->sequence);
+  sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  fh->frame_number = frame_number;
+  fh->internal_frame_number = internal_frame_number;
+  fh->width = width;
+  fh->height = height;
+  fh->stride = stride;
+  fh->timestamp_ns = timestamp_ns;
+  std::memcpy(buffer + sizeof(FrameHeader), pixels, static_cast<size_t>(stride) * height);
+
+  sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  std::atomic_ref<u32>(ch->write_index).store(index, std::memory_order_release);
+
+#ifdef _WIN32
+  SetEvent(s_signal);
+#else
+  sem_post(s_signal);
+#endif
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+#include "types.h"
+
+//////////////////////////////////////////////////////////////////////////
+// Shared-memory frame export for external capture tools. When enabled,
+// each presented frame is rendered a second time without the OSD, read
+// back asynchronously, and published into a small shared-memory ring
+// that another process can map directly, instead of that process having
+// to grab the screen through the OS.
+//////////////////////////////////////////////////////////////////////////
+
+namespace FrameExport {
+
+// Shared memory object and per-frame signal names. The mapping is opened as "Local\<name>" on
+// Windows and "/<name>" via shm_open() elsewhere; the signal is an auto-reset event on Windows
+// and a POSIX semaphore of the same form elsewhere, posted once per published frame.
+static constexpr char CHANNEL_NAME[] = "duckstation-frames";
+static constexpr char SIGNAL_NAME[] = "duckstation-frames-ready";
+
+static constexpr u32 CHANNEL_MAGIC = 0x58465344; // 'DSFX'
+static constexpr u32 CHANNEL_VERSION = 1;
+static constexpr u32 NUM_BUFFERS = 3;
+
+// Frames larger than this are not published. The mapping is sized for the maximum up front, but
+// pages are only committed as they are written, so the common case stays small.
+static constexpr u32 MAX_FRAME_WIDTH = 4096;
+static constexpr u32 MAX_FRAME_HEIGHT = 2304;
+
+// Layout of the shared memory object: a ChannelHeader, followed by NUM_BUFFERS buffers, each a
+// FrameHeader followed by buffer_size bytes of tightly-packed RGBA8 pixel data. The writer bumps
+// FrameHeader::sequence to an odd value before copying into a buffer and back to even afterwards;
+// readers should map the most recent buffer via write_index and retry if they observe an odd
+// sequence, or a sequence that changed across the read.
+struct ChannelHeader
+{
+  u32 magic;
+  u32 version;
+  u32 buffer_count;
+  u32 buffer_size; // pixel bytes per buffer, excluding the FrameHeader
+  u32 max_width;
+  u32 max_height;
+  u32 write_index; // most recently published buffer, ~0u until the first frame lands
+  u32 unused;
+};
+
+struct FrameHeader
+{
+  u32 sequence;
+  u32 frame_number;          // value of System::GetFrameNumber() when the frame was rendered
+  u32 internal_frame_number; // value of System::GetInternalFrameNumber() ditto
+  u32 width;
+  u32 height;
+  u32 stride;       // bytes per row
+  u64 timestamp_ns; // host monotonic time the readback was enqueued
+};
+
+/// Creates the shared memory channel and signal. No-op if frame export is disabled in settings,
+/// or the channel is already open.
+void Initialize();
+
+/// Tears the channel down again. Safe to call when inactive.
+void Shutdown();
+
+/// Returns true if the channel is open and frames should be exported.
+bool IsActive();
+
+/// Copies one completed frame readback into the ring and signals the consumer. pixels must be
+/// tightly-packed RGBA8. Frames exceeding MAX_FRAME_WIDTH/HEIGHT are dropped with a warning.
+void PublishFrame(const u32* pixels, u32 width, u32 height, u32 frame_number, u32 internal_frame_number,
+                  u64 timestamp_ns);
+
+} // namespace FrameExport
@@ -5879,11 +5879,11 @@ void FullscreenUI::DrawGameList(const ImVec2& heading_size)
       if (!selected_entry->developer.empty())
       {
         text_width =
-          ImGui::CalcTextSize(selected_entry->developer.c_str(),
-                              selected_entry->developer.c_str() + selected_entry->developer.length(), false, work_width)
+          ImGui::CalcTextSize(selected_entry->developer.data(),
+                              selected_entry->developer.data() + selected_entry->developer.length(), false, work_width)
             .x;
         ImGui::SetCursorPosX((work_width - text_width) / 2.0f);
-        ImGui::TextWrapped("%s", selected_entry->developer.c_str());
+        ImGui::TextWrapped("%s", selected_entry->developer.data());
       }
 
       // code
@@ -5904,7 +5904,7 @@ void FullscreenUI::DrawGameList(const ImVec2& heading_size)
       }
 
       // genre
-      ImGui::Text(FSUI_CSTR("Genre: %s"), selected_entry->genre.c_str());
+      ImGui::Text(FSUI_CSTR("Genre: %s"), selected_entry->genre.data());
 
       // release date
       char release_date_str[64];
@@ -9,15 +9,17 @@
 #include "util/imgui_manager.h"
 
 #include "common/assert.h"
-#include "common/byte_stream.h"
+#include "common/file_system.h"
 #include "common/heterogeneous_containers.h"
 #include "common/log.h"
 #include "common/path.h"
+#include "common/string_intern.h"
 #include "common/string_util.h"
 #include "common/timer.h"
 
 #include "ryml.hpp"
 
+#include <cstring>
 #include <iomanip>
 #include <memory>
 #include <optional>
@@ -33,7 +35,7 @@ namespace GameDatabase {
 enum : u32
 {
   GAME_DATABASE_CACHE_SIGNATURE = 0x45434C48,
-  GAME_DATABASE_CACHE_VERSION = 7,
+  GAME_DATABASE_CACHE_VERSION = 8,
 };
 
 static Entry* GetMutableEntry(const std::string_view& serial);
@@ -128,6 +130,22 @@ static bool GetStringFromObject(const ryml::ConstNodeRef& object, std::string_vi
   return true;
 }
 
+// Variant for the interned metadata fields which repeat across many entries.
+static bool GetStringFromObject(const ryml::ConstNodeRef& object, std::string_view key, std::string_view* dest)
+{
+  *dest = "";
+
+  const ryml::ConstNodeRef member = object.find_child(to_csubstr(key));
+  if (!member.valid())
+    return false;
+
+  const c4::csubstr val = member.val();
+  if (!val.empty())
+    *dest = StringIntern::Intern(std::string_view(val.data(), val.size()));
+
+  return true;
+}
+
 template<typename T>
 static bool GetUIntFromObject(const ryml::ConstNodeRef& object, std::string_view key, T* dest)
 {
@@ -647,37 +665,147 @@ void GameDatabase::Entry::ApplySettings(Settings& settings, bool display_osd_mes
 #undef BIT_FOR
 }
 
+// The cache is a flat, offset-based blob: a header, fixed-size entry records, a table of
+// disc set serial references, fixed-size code records, and an interned string table. It is
+// read with a single file read and decoded with straight pointer arithmetic, instead of
+// thousands of small stream reads.
+#pragma pack(push, 1)
+
+struct CacheStringRef
+{
+  u32 offset;
+  u32 length;
+};
+
+struct CacheHeader
+{
+  u32 signature;
+  u32 version;
+  u64 gamedb_ts;
+  u32 num_entries;
+  u32 num_codes;
+  u32 num_disc_set_serial_refs;
+  u32 string_table_size;
+};
+
+struct CacheEntryRecord
+{
+  CacheStringRef serial;
+  CacheStringRef title;
+  CacheStringRef genre;
+  CacheStringRef developer;
+  CacheStringRef publisher;
+  CacheStringRef disc_set_name;
+  u64 release_date;
+  u8 min_players;
+  u8 max_players;
+  u8 min_blocks;
+  u8 max_blocks;
+  u16 supported_controllers;
+  u8 compatibility;
+  u8 gpu_line_detect_mode;
+  u32 traits;
+  u16 optional_present_mask;
+  s16 display_active_start_offset;
+  s16 display_active_end_offset;
+  s8 display_line_start_offset;
+  s8 display_line_end_offset;
+  u32 dma_max_slice_ticks;
+  u32 dma_halt_ticks;
+  u32 gpu_fifo_size;
+  u32 gpu_max_run_ahead;
+  float gpu_pgxp_tolerance;
+  float gpu_pgxp_depth_threshold;
+  u32 first_disc_set_serial_ref;
+  u32 num_disc_set_serials;
+};
+
+struct CacheCodeRecord
+{
+  CacheStringRef code;
+  u32 entry_index;
+};
+
+#pragma pack(pop)
+
+static_assert(static_cast<u32>(GameDatabase::Trait::Count) <= 32, "traits fit in u32 record field");
+
+// Bit positions in CacheEntryRecord::optional_present_mask, in Entry declaration order.
+enum : u32
+{
+  CACHE_OPT_DISPLAY_ACTIVE_START_OFFSET,
+  CACHE_OPT_DISPLAY_ACTIVE_END_OFFSET,
+  CACHE_OPT_DISPLAY_LINE_START_OFFSET,
+  CACHE_OPT_DISPLAY_LINE_END_OFFSET,
+  CACHE_OPT_DMA_MAX_SLICE_TICKS,
+  CACHE_OPT_DMA_HALT_TICKS,
+  CACHE_OPT_GPU_FIFO_SIZE,
+  CACHE_OPT_GPU_MAX_RUN_AHEAD,
+  CACHE_OPT_GPU_PGXP_TOLERANCE,
+  CACHE_OPT_GPU_PGXP_DEPTH_THRESHOLD,
+  CACHE_OPT_GPU_LINE_DETECT_MODE,
+};
+
 template<typename T>
-bool ReadOptionalFromStream(ByteStream* stream, std::optional<T>* dest)
+static void PackOptionalToRecord(const std::optional<T>& src, T* dest, u16* present_mask, u32 bit)
 {
-  bool has_value;
-  if (!stream->Read2(&has_value, sizeof(has_value)))
-    return false;
+  if (!src.has_value())
+  {
+    *dest = T();
+    return;
+  }
 
-  if (!has_value)
-    return true;
+  *dest = src.value();
+  *present_mask |= static_cast<u16>(1u << bit);
+}
 
-  T value;
-  if (!stream->Read2(&value, sizeof(T)))
+template<typename T>
+static void UnpackOptionalFromRecord(std::optional<T>* dest, T value, u16 present_mask, u32 bit)
+{
+  if (present_mask & (1u << bit))
+    *dest = value;
+}
+
+static bool ResolveCacheString(std::string* dest, const CacheStringRef& ref, const std::string_view& string_table)
+{
+  if (ref.offset > string_table.size() || ref.length > (string_table.size() - ref.offset))
     return false;
 
-  *dest = value;
+  dest->assign(string_table.data() + ref.offset, ref.length);
   return true;
 }
 
-template<typename T>
-bool WriteOptionalToStream(ByteStream* stream, const std::optional<T>& src)
+static bool ResolveCacheString(std::string_view* dest, const CacheStringRef& ref, const std::string_view& string_table)
 {
-  const bool has_value = src.has_value();
-  if (!stream->Write2(&has_value, sizeof(has_value)))
+  if (ref.offset > string_table.size() || ref.length > (string_table.size() - ref.offset))
     return false;
 
-  if (!has_value)
-    return true;
-
-  return stream->Write2(&src.value(), sizeof(T));
+  *dest = StringIntern::Intern(string_table.substr(ref.offset, ref.length));
+  return true;
 }
 
+namespace {
+// Interns strings while building the cache blob, so the thousands of repeated publishers,
+// developers and genres are stored once each.
+struct CacheStringTableBuilder
+{
+  std::string buffer;
+  PreferUnorderedStringMap<u32> lookup;
+
+  CacheStringRef Add(const std::string_view& str)
+  {
+    const auto iter = lookup.find(str);
+    if (iter != lookup.end())
+      return {iter->second, static_cast<u32>(str.length())};
+
+    const u32 offset = static_cast<u32>(buffer.length());
+    buffer.append(str);
+    lookup.emplace(str, offset);
+    return {offset, static_cast<u32>(str.length())};
+  }
+};
+} // namespace
+
 static std::string GetCacheFile()
 {
   return Path::Combine(EmuFolders::Cache, "gamedb.cache");
@@ -685,102 +813,144 @@ static std::string GetCacheFile()
 
 bool GameDatabase::LoadFromCache()
 {
-  std::unique_ptr<ByteStream> stream(
-    ByteStream::OpenFile(GetCacheFile().c_str(), BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED));
-  if (!stream)
+  const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(GetCacheFile().c_str());
+  if (!data.has_value())
   {
     Log_DevPrintf("Cache does not exist, loading full database.");
     return false;
   }
 
-  const u64 gamedb_ts = Host::GetResourceFileTimestamp("gamedb.yaml", false).value_or(0);
+  CacheHeader header;
+  if (data->size() < sizeof(header))
+  {
+    Log_DevPrintf("Cache header is corrupted or version mismatch.");
+    return false;
+  }
 
-  u32 signature, version, num_entries, num_codes;
-  u64 file_gamedb_ts;
-  if (!stream->ReadU32(&signature) || !stream->ReadU32(&version) || !stream->ReadU64(&file_gamedb_ts) ||
-      !stream->ReadU32(&num_entries) || !stream->ReadU32(&num_codes) || signature != GAME_DATABASE_CACHE_SIGNATURE ||
-      version != GAME_DATABASE_CACHE_VERSION)
+  std::memcpy(&header, data->data(), sizeof(header));
+  if (header.signature != GAME_DATABASE_CACHE_SIGNATURE || header.version != GAME_DATABASE_CACHE_VERSION)
   {
     Log_DevPrintf("Cache header is corrupted or version mismatch.");
     return false;
   }
 
-  if (gamedb_ts != file_gamedb_ts)
+  const u64 gamedb_ts = Host::GetResourceFileTimestamp("gamedb.yaml", false).value_or(0);
+  if (gamedb_ts != header.gamedb_ts)
   {
     Log_DevPrintf("Cache is out of date, recreating.");
     return false;
   }
 
-  s_entries.reserve(num_entries);
+  const u64 expected_size = sizeof(CacheHeader) + (static_cast<u64>(header.num_entries) * sizeof(CacheEntryRecord)) +
+                            (static_cast<u64>(header.num_disc_set_serial_refs) * sizeof(CacheStringRef)) +
+                            (static_cast<u64>(header.num_codes) * sizeof(CacheCodeRecord)) + header.string_table_size;
+  if (data->size() != expected_size)
+  {
+    Log_DevPrintf("Cache size mismatch, recreating.");
+    return false;
+  }
 
-  for (u32 i = 0; i < num_entries; i++)
+  const u8* const entry_records = data->data() + sizeof(CacheHeader);
+  const u8* const serial_refs = entry_records + (static_cast<u64>(header.num_entries) * sizeof(CacheEntryRecord));
+  const u8* const code_records = serial_refs + (static_cast<u64>(header.num_disc_set_serial_refs) * sizeof(CacheStringRef));
+  const std::string_view string_table(
+    reinterpret_cast<const char*>(code_records + (static_cast<u64>(header.num_codes) * sizeof(CacheCodeRecord))),
+    header.string_table_size);
+
+  s_entries.reserve(header.num_entries);
+
+  for (u32 i = 0; i < header.num_entries; i++)
   {
+    // Records are packed, so pull them out with memcpy rather than aliasing unaligned fields.
+    CacheEntryRecord rec;
+    std::memcpy(&rec, entry_records + (static_cast<u64>(i) * sizeof(rec)), sizeof(rec));
+
     Entry& entry = s_entries.emplace_back();
 
-    constexpr u32 num_bytes = (static_cast<u32>(Trait::Count) + 7) / 8;
-    std::array<u8, num_bytes> bits;
-    u8 compatibility;
-    u32 num_disc_set_serials;
-
-    if (!stream->ReadSizePrefixedString(&entry.serial) || !stream->ReadSizePrefixedString(&entry.title) ||
-        !stream->ReadSizePrefixedString(&entry.genre) || !stream->ReadSizePrefixedString(&entry.developer) ||
-        !stream->ReadSizePrefixedString(&entry.publisher) || !stream->ReadU64(&entry.release_date) ||
-        !stream->ReadU8(&entry.min_players) || !stream->ReadU8(&entry.max_players) ||
-        !stream->ReadU8(&entry.min_blocks) || !stream->ReadU8(&entry.max_blocks) ||
-        !stream->ReadU16(&entry.supported_controllers) || !stream->ReadU8(&compatibility) ||
-        compatibility >= static_cast<u8>(GameDatabase::CompatibilityRating::Count) ||
-        !stream->Read2(bits.data(), num_bytes) ||
-        !ReadOptionalFromStream(stream.get(), &entry.display_active_start_offset) ||
-        !ReadOptionalFromStream(stream.get(), &entry.display_active_end_offset) ||
-        !ReadOptionalFromStream(stream.get(), &entry.display_line_start_offset) ||
-        !ReadOptionalFromStream(stream.get(), &entry.display_line_end_offset) ||
-        !ReadOptionalFromStream(stream.get(), &entry.dma_max_slice_ticks) ||
-        !ReadOptionalFromStream(stream.get(), &entry.dma_halt_ticks) ||
-        !ReadOptionalFromStream(stream.get(), &entry.gpu_fifo_size) ||
-        !ReadOptionalFromStream(stream.get(), &entry.gpu_max_run_ahead) ||
-        !ReadOptionalFromStream(stream.get(), &entry.gpu_pgxp_tolerance) ||
-        !ReadOptionalFromStream(stream.get(), &entry.gpu_pgxp_depth_threshold) ||
-        !ReadOptionalFromStream(stream.get(), &entry.gpu_line_detect_mode) ||
-        !stream->ReadSizePrefixedString(&entry.disc_set_name) || !stream->ReadU32(&num_disc_set_serials))
+    if (!ResolveCacheString(&entry.serial, rec.serial, string_table) ||
+        !ResolveCacheString(&entry.title, rec.title, string_table) ||
+        !ResolveCacheString(&entry.genre, rec.genre, string_table) ||
+        !ResolveCacheString(&entry.developer, rec.developer, string_table) ||
+        !ResolveCacheString(&entry.publisher, rec.publisher, string_table) ||
+        !ResolveCacheString(&entry.disc_set_name, rec.disc_set_name, string_table) ||
+        rec.compatibility >= static_cast<u8>(GameDatabase::CompatibilityRating::Count) ||
+        rec.num_disc_set_serials > header.num_disc_set_serial_refs ||
+        rec.first_disc_set_serial_ref > (header.num_disc_set_serial_refs - rec.num_disc_set_serials))
     {
       Log_DevPrintf("Cache entry is corrupted.");
       return false;
     }
 
-    if (num_disc_set_serials > 0)
+    entry.release_date = rec.release_date;
+    entry.min_players = rec.min_players;
+    entry.max_players = rec.max_players;
+    entry.min_blocks = rec.min_blocks;
+    entry.max_blocks = rec.max_blocks;
+    entry.supported_controllers = rec.supported_controllers;
+    entry.compatibility = static_cast<GameDatabase::CompatibilityRating>(rec.compatibility);
+
+    entry.traits.reset();
+    for (u32 j = 0; j < static_cast<u32>(Trait::Count); j++)
+    {
+      if (rec.traits & (1u << j))
+        entry.traits[j] = true;
+    }
+
+    UnpackOptionalFromRecord(&entry.display_active_start_offset, rec.display_active_start_offset,
+                             rec.optional_present_mask, CACHE_OPT_DISPLAY_ACTIVE_START_OFFSET);
+    UnpackOptionalFromRecord(&entry.display_active_end_offset, rec.display_active_end_offset,
+                             rec.optional_present_mask, CACHE_OPT_DISPLAY_ACTIVE_END_OFFSET);
+    UnpackOptionalFromRecord(&entry.display_line_start_offset, rec.display_line_start_offset,
+                             rec.optional_present_mask, CACHE_OPT_DISPLAY_LINE_START_OFFSET);
+    UnpackOptionalFromRecord(&entry.display_line_end_offset, rec.display_line_end_offset, rec.optional_present_mask,
+                             CACHE_OPT_DISPLAY_LINE_END_OFFSET);
+    UnpackOptionalFromRecord(&entry.dma_max_slice_ticks, rec.dma_max_slice_ticks, rec.optional_present_mask,
+                             CACHE_OPT_DMA_MAX_SLICE_TICKS);
+    UnpackOptionalFromRecord(&entry.dma_halt_ticks, rec.dma_halt_ticks, rec.optional_present_mask,
+                             CACHE_OPT_DMA_HALT_TICKS);
+    UnpackOptionalFromRecord(&entry.gpu_fifo_size, rec.gpu_fifo_size, rec.optional_present_mask,
+                             CACHE_OPT_GPU_FIFO_SIZE);
+    UnpackOptionalFromRecord(&entry.gpu_max_run_ahead, rec.gpu_max_run_ahead, rec.optional_present_mask,
+                             CACHE_OPT_GPU_MAX_RUN_AHEAD);
+    UnpackOptionalFromRecord(&entry.gpu_pgxp_tolerance, rec.gpu_pgxp_tolerance, rec.optional_present_mask,
+                             CACHE_OPT_GPU_PGXP_TOLERANCE);
+    UnpackOptionalFromRecord(&entry.gpu_pgxp_depth_threshold, rec.gpu_pgxp_depth_threshold, rec.optional_present_mask,
+                             CACHE_OPT_GPU_PGXP_DEPTH_THRESHOLD);
+    UnpackOptionalFromRecord(&entry.gpu_line_detect_mode, static_cast<GPULineDetectMode>(rec.gpu_line_detect_mode),
+                             rec.optional_present_mask, CACHE_OPT_GPU_LINE_DETECT_MODE);
+
+    if (rec.num_disc_set_serials > 0)
     {
-      entry.disc_set_serials.reserve(num_disc_set_serials);
-      for (u32 j = 0; j < num_disc_set_serials; j++)
+      entry.disc_set_serials.reserve(rec.num_disc_set_serials);
+      for (u32 j = 0; j < rec.num_disc_set_serials; j++)
       {
-        if (!stream->ReadSizePrefixedString(&entry.disc_set_serials.emplace_back()))
+        CacheStringRef ref;
+        std::memcpy(&ref, serial_refs + (static_cast<u64>(rec.first_disc_set_serial_ref + j) * sizeof(ref)),
+                    sizeof(ref));
+        if (!ResolveCacheString(&entry.disc_set_serials.emplace_back(), ref, string_table))
         {
           Log_DevPrintf("Cache entry is corrupted.");
           return false;
         }
       }
     }
-
-    entry.compatibility = static_cast<GameDatabase::CompatibilityRating>(compatibility);
-    entry.traits.reset();
-    for (u32 j = 0; j < static_cast<int>(Trait::Count); j++)
-    {
-      if ((bits[j / 8] & (1u << (j % 8))) != 0)
-        entry.traits[j] = true;
-    }
   }
 
-  for (u32 i = 0; i < num_codes; i++)
+  s_code_lookup.reserve(header.num_codes);
+
+  for (u32 i = 0; i < header.num_codes; i++)
   {
+    CacheCodeRecord rec;
+    std::memcpy(&rec, code_records + (static_cast<u64>(i) * sizeof(rec)), sizeof(rec));
+
     std::string code;
-    u32 index;
-    if (!stream->ReadSizePrefixedString(&code) || !stream->ReadU32(&index) ||
-        index >= static_cast<u32>(s_entries.size()))
+    if (!ResolveCacheString(&code, rec.code, string_table) || rec.entry_index >= static_cast<u32>(s_entries.size()))
     {
       Log_DevPrintf("Cache code entry is corrupted.");
       return false;
     }
 
-    s_code_lookup.emplace(std::move(code), index);
+    s_code_lookup.emplace(std::move(code), rec.entry_index);
   }
 
   return true;
@@ -790,71 +960,97 @@ bool GameDatabase::SaveToCache()
 {
   const u64 gamedb_ts = Host::GetResourceFileTimestamp("gamedb.yaml", false).value_or(0);
 
-  std::unique_ptr<ByteStream> stream(
-    ByteStream::OpenFile(GetCacheFile().c_str(), BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE |
-                                                   BYTESTREAM_OPEN_TRUNCATE | BYTESTREAM_OPEN_STREAMED));
-  if (!stream)
-    return false;
-
-  bool result = stream->WriteU32(GAME_DATABASE_CACHE_SIGNATURE);
-  result = result && stream->WriteU32(GAME_DATABASE_CACHE_VERSION);
-  result = result && stream->WriteU64(static_cast<u64>(gamedb_ts));
-
-  result = result && stream->WriteU32(static_cast<u32>(s_entries.size()));
-  result = result && stream->WriteU32(static_cast<u32>(s_code_lookup.size()));
+  CacheStringTableBuilder strings;
+  std::vector<CacheEntryRecord> entry_records;
+  std::vector<CacheStringRef> serial_refs;
+  std::vector<CacheCodeRecord> code_records;
+  entry_records.reserve(s_entries.size());
+  code_records.reserve(s_code_lookup.size());
 
   for (const Entry& entry : s_entries)
   {
-    result = result && stream->WriteSizePrefixedString(entry.serial);
-    result = result && stream->WriteSizePrefixedString(entry.title);
-    result = result && stream->WriteSizePrefixedString(entry.genre);
-    result = result && stream->WriteSizePrefixedString(entry.developer);
-    result = result && stream->WriteSizePrefixedString(entry.publisher);
-    result = result && stream->WriteU64(entry.release_date);
-    result = result && stream->WriteU8(entry.min_players);
-    result = result && stream->WriteU8(entry.max_players);
-    result = result && stream->WriteU8(entry.min_blocks);
-    result = result && stream->WriteU8(entry.max_blocks);
-    result = result && stream->WriteU16(entry.supported_controllers);
-    result = result && stream->WriteU8(static_cast<u8>(entry.compatibility));
-
-    constexpr u32 num_bytes = (static_cast<u32>(Trait::Count) + 7) / 8;
-    std::array<u8, num_bytes> bits;
-    bits.fill(0);
-    for (u32 j = 0; j < static_cast<int>(Trait::Count); j++)
+    CacheEntryRecord rec = {};
+    rec.serial = strings.Add(entry.serial);
+    rec.title = strings.Add(entry.title);
+    rec.genre = strings.Add(entry.genre);
+    rec.developer = strings.Add(entry.developer);
+    rec.publisher = strings.Add(entry.publisher);
+    rec.disc_set_name = strings.Add(entry.disc_set_name);
+    rec.release_date = entry.release_date;
+    rec.min_players = entry.min_players;
+    rec.max_players = entry.max_players;
+    rec.min_blocks = entry.min_blocks;
+    rec.max_blocks = entry.max_blocks;
+    rec.supported_controllers = entry.supported_controllers;
+    rec.compatibility = static_cast<u8>(entry.compatibility);
+
+    for (u32 j = 0; j < static_cast<u32>(Trait::Count); j++)
     {
       if (entry.traits[j])
-        bits[j / 8] |= (1u << (j % 8));
+        rec.traits |= (1u << j);
+    }
+
+    PackOptionalToRecord(entry.display_active_start_offset, &rec.display_active_start_offset,
+                         &rec.optional_present_mask, CACHE_OPT_DISPLAY_ACTIVE_START_OFFSET);
+    PackOptionalToRecord(entry.display_active_end_offset, &rec.display_active_end_offset, &rec.optional_present_mask,
+                         CACHE_OPT_DISPLAY_ACTIVE_END_OFFSET);
+    PackOptionalToRecord(entry.display_line_start_offset, &rec.display_line_start_offset, &rec.optional_present_mask,
+                         CACHE_OPT_DISPLAY_LINE_START_OFFSET);
+    PackOptionalToRecord(entry.display_line_end_offset, &rec.display_line_end_offset, &rec.optional_present_mask,
+                         CACHE_OPT_DISPLAY_LINE_END_OFFSET);
+    PackOptionalToRecord(entry.dma_max_slice_ticks, &rec.dma_max_slice_ticks, &rec.optional_present_mask,
+                         CACHE_OPT_DMA_MAX_SLICE_TICKS);
+    PackOptionalToRecord(entry.dma_halt_ticks, &rec.dma_halt_ticks, &rec.optional_present_mask,
+                         CACHE_OPT_DMA_HALT_TICKS);
+    PackOptionalToRecord(entry.gpu_fifo_size, &rec.gpu_fifo_size, &rec.optional_present_mask, CACHE_OPT_GPU_FIFO_SIZE);
+    PackOptionalToRecord(entry.gpu_max_run_ahead, &rec.gpu_max_run_ahead, &rec.optional_present_mask,
+                         CACHE_OPT_GPU_MAX_RUN_AHEAD);
+    PackOptionalToRecord(entry.gpu_pgxp_tolerance, &rec.gpu_pgxp_tolerance, &rec.optional_present_mask,
+                         CACHE_OPT_GPU_PGXP_TOLERANCE);
+    PackOptionalToRecord(entry.gpu_pgxp_depth_threshold, &rec.gpu_pgxp_depth_threshold, &rec.optional_present_mask,
+                         CACHE_OPT_GPU_PGXP_DEPTH_THRESHOLD);
+    if (entry.gpu_line_detect_mode.has_value())
+    {
+      rec.gpu_line_detect_mode = static_cast<u8>(entry.gpu_line_detect_mode.value());
+      rec.optional_present_mask |= static_cast<u16>(1u << CACHE_OPT_GPU_LINE_DETECT_MODE);
     }
 
-    result = result && stream->Write2(bits.data(), num_bytes);
-
-    result = result && WriteOptionalToStream(stream.get(), entry.display_active_start_offset);
-    result = result && WriteOptionalToStream(stream.get(), entry.display_active_end_offset);
-    result = result && WriteOptionalToStream(stream.get(), entry.display_line_start_offset);
-    result = result && WriteOptionalToStream(stream.get(), entry.display_line_end_offset);
-    result = result && WriteOptionalToStream(stream.get(), entry.dma_max_slice_ticks);
-    result = result && WriteOptionalToStream(stream.get(), entry.dma_halt_ticks);
-    result = result && WriteOptionalToStream(stream.get(), entry.gpu_fifo_size);
-    result = result && WriteOptionalToStream(stream.get(), entry.gpu_max_run_ahead);
-    result = result && WriteOptionalToStream(stream.get(), entry.gpu_pgxp_tolerance);
-    result = result && WriteOptionalToStream(stream.get(), entry.gpu_pgxp_depth_threshold);
-    result = result && WriteOptionalToStream(stream.get(), entry.gpu_line_detect_mode);
-
-    result = result && stream->WriteSizePrefixedString(entry.disc_set_name);
-    result = result && stream->WriteU32(static_cast<u32>(entry.disc_set_serials.size()));
+    rec.first_disc_set_serial_ref = static_cast<u32>(serial_refs.size());
+    rec.num_disc_set_serials = static_cast<u32>(entry.disc_set_serials.size());
     for (const std::string& serial : entry.disc_set_serials)
-      result = result && stream->WriteSizePrefixedString(serial);
+      serial_refs.push_back(strings.Add(serial));
+
+    entry_records.push_back(rec);
   }
 
   for (const auto& it : s_code_lookup)
-  {
-    result = result && stream->WriteSizePrefixedString(it.first);
-    result = result && stream->WriteU32(it.second);
-  }
+    code_records.push_back({strings.Add(it.first), it.second});
+
+  CacheHeader header = {};
+  header.signature = GAME_DATABASE_CACHE_SIGNATURE;
+  header.version = GAME_DATABASE_CACHE_VERSION;
+  header.gamedb_ts = gamedb_ts;
+  header.num_entries = static_cast<u32>(entry_records.size());
+  header.num_codes = static_cast<u32>(code_records.size());
+  header.num_disc_set_serial_refs = static_cast<u32>(serial_refs.size());
+  header.string_table_size = static_cast<u32>(strings.buffer.size());
+
+  std::vector<u8> data;
+  data.reserve(sizeof(header) + (entry_records.size() * sizeof(CacheEntryRecord)) +
+               (serial_refs.size() * sizeof(CacheStringRef)) + (code_records.size() * sizeof(CacheCodeRecord)) +
+               strings.buffer.size());
+
+  const auto append = [&data](const void* ptr, size_t size) {
+    const u8* bytes = static_cast<const u8*>(ptr);
+    data.insert(data.end(), bytes, bytes + size);
+  };
+  append(&header, sizeof(header));
+  append(entry_records.data(), entry_records.size() * sizeof(CacheEntryRecord));
+  append(serial_refs.data(), serial_refs.size() * sizeof(CacheStringRef));
+  append(code_records.data(), code_records.size() * sizeof(CacheCodeRecord));
+  append(strings.buffer.data(), strings.buffer.size());
 
-  result = result && stream->Flush();
-  return true;
+  return FileSystem::WriteBinaryFile(GetCacheFile().c_str(), data.data(), data.size());
 }
 
 void GameDatabase::SetRymlCallbacks()
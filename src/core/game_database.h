@@ -55,12 +55,14 @@ enum class Trait : u32
 
 struct Entry
 {
-  // TODO: Make string_view.
+  // serial/title are unique per entry and stay owned. The remaining metadata strings repeat
+  // across many entries, so they are shared with the game list through StringIntern; the views
+  // are null-terminated and remain valid after Unload().
   std::string serial;
   std::string title;
-  std::string genre;
-  std::string developer;
-  std::string publisher;
+  std::string_view genre = "";
+  std::string_view developer = "";
+  std::string_view publisher = "";
   u64 release_date;
   u8 min_players;
   u8 max_players;
@@ -82,7 +84,7 @@ struct Entry
   std::optional<float> gpu_pgxp_depth_threshold;
   std::optional<GPULineDetectMode> gpu_line_detect_mode;
 
-  std::string disc_set_name;
+  std::string_view disc_set_name = "";
   std::vector<std::string> disc_set_serials;
 
   ALWAYS_INLINE bool HasTrait(Trait trait) const { return traits[static_cast<int>(trait)]; }
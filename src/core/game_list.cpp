@@ -18,13 +18,19 @@
 #include "common/log.h"
 #include "common/path.h"
 #include "common/progress_callback.h"
+#include "common/string_intern.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <chrono>
 #include <ctime>
+#include <optional>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -72,8 +78,6 @@ static void ScanDirectory(const char* path, bool recursive, bool only_cache,
                           const std::vector<std::string>& excluded_paths, const PlayedTimeMap& played_time_map,
                           ProgressCallback* progress);
 static bool AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map);
-static bool ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
-                     const PlayedTimeMap& played_time_map);
 
 static std::string GetCacheFilename();
 static void LoadCache();
@@ -326,6 +330,7 @@ bool GameList::LoadEntriesFromCache(ByteStream* stream)
   while (stream->GetPosition() != stream->GetSize())
   {
     std::string path;
+    std::string genre, publisher, developer;
     Entry ge;
 
     u8 type;
@@ -334,8 +339,8 @@ bool GameList::LoadEntriesFromCache(ByteStream* stream)
 
     if (!stream->ReadU8(&type) || !stream->ReadU8(&region) || !stream->ReadSizePrefixedString(&path) ||
         !stream->ReadSizePrefixedString(&ge.serial) || !stream->ReadSizePrefixedString(&ge.title) ||
-        !stream->ReadSizePrefixedString(&ge.disc_set_name) || !stream->ReadSizePrefixedString(&ge.genre) ||
-        !stream->ReadSizePrefixedString(&ge.publisher) || !stream->ReadSizePrefixedString(&ge.developer) ||
+        !stream->ReadSizePrefixedString(&ge.disc_set_name) || !stream->ReadSizePrefixedString(&genre) ||
+        !stream->ReadSizePrefixedString(&publisher) || !stream->ReadSizePrefixedString(&developer) ||
         !stream->ReadU64(&ge.hash) || !stream->ReadS64(&ge.file_size) || !stream->ReadU64(&ge.uncompressed_size) ||
         !stream->ReadU64(reinterpret_cast<u64*>(&ge.last_modified_time)) || !stream->ReadU64(&ge.release_date) ||
         !stream->ReadU16(&ge.supported_controllers) || !stream->ReadU8(&ge.min_players) ||
@@ -349,6 +354,9 @@ bool GameList::LoadEntriesFromCache(ByteStream* stream)
     }
 
     ge.path = path;
+    ge.genre = StringIntern::Intern(genre);
+    ge.publisher = StringIntern::Intern(publisher);
+    ge.developer = StringIntern::Intern(developer);
     ge.region = static_cast<DiscRegion>(region);
     ge.type = static_cast<EntryType>(type);
     ge.compatibility = static_cast<GameDatabase::CompatibilityRating>(compatibility_rating);
@@ -502,11 +510,11 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
   progress->SetProgressRange(static_cast<u32>(files.size()));
   progress->SetProgressValue(0);
 
-  u32 files_scanned = 0;
+  // First pass: serve everything we can out of the cache, and collect the files which need a full
+  // scan. The scans themselves are independent of each other, so they fan out across the pool.
+  std::vector<std::pair<std::string, std::time_t>> files_to_scan;
   for (FILESYSTEM_FIND_DATA& ffd : files)
   {
-    files_scanned++;
-
     if (progress->IsCancelled() || !GameList::IsScannableFilename(ffd.FileName) ||
         IsPathExcluded(excluded_paths, ffd.FileName))
     {
@@ -520,53 +528,101 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
       continue;
     }
 
-    progress->SetFormattedStatusText("Scanning '%s'...", FileSystem::GetDisplayNameFromPath(ffd.FileName).c_str());
-    ScanFile(std::move(ffd.FileName), ffd.ModificationTime, lock, played_time_map);
-    progress->SetProgressValue(files_scanned);
+    files_to_scan.emplace_back(std::move(ffd.FileName), ffd.ModificationTime);
   }
 
-  progress->SetProgressValue(files_scanned);
-  progress->PopState();
-}
-
-bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map)
-{
-  Entry entry;
-  if (!GetGameListEntryFromCache(path, &entry) || entry.last_modified_time != timestamp)
-    return false;
+  const u32 num_cached_files = static_cast<u32>(files.size() - files_to_scan.size());
+  progress->SetProgressValue(num_cached_files);
 
-  auto iter = played_time_map.find(entry.serial);
-  if (iter != played_time_map.end())
+  if (!files_to_scan.empty() && !progress->IsCancelled())
   {
-    entry.last_played_time = iter->second.last_played_time;
-    entry.total_played_time = iter->second.total_played_time;
-  }
+    progress->SetFormattedStatusText("Scanning %u file(s)...", static_cast<u32>(files_to_scan.size()));
 
-  s_entries.push_back(std::move(entry));
-  return true;
-}
+    // The database load is lazy, make sure it doesn't race between the workers.
+    GameDatabase::EnsureLoaded();
 
-bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
-                        const PlayedTimeMap& played_time_map)
-{
-  // don't block UI while scanning
-  lock.unlock();
+    // Each scan populates its own slot, so the workers never contend on anything.
+    std::vector<std::optional<Entry>> scanned_entries(files_to_scan.size());
+    std::atomic<u32> next_file{0};
+    std::atomic<u32> completed_files{0};
+    std::atomic<u32> finished_workers{0};
+    std::atomic<bool> cancelled{false};
 
-  Log_DevPrintf("Scanning '%s'...", path.c_str());
+    const auto worker_func = [&files_to_scan, &scanned_entries, &next_file, &completed_files, &finished_workers,
+                              &cancelled]() {
+      for (;;)
+      {
+        const u32 index = next_file.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= files_to_scan.size() || cancelled.load(std::memory_order_relaxed))
+          break;
 
-  Entry entry;
-  if (!PopulateEntryFromPath(path, &entry))
-    return false;
+        Log_DevPrintf("Scanning '%s'...", files_to_scan[index].first.c_str());
 
-  entry.path = std::move(path);
-  entry.last_modified_time = timestamp;
+        Entry entry;
+        if (PopulateEntryFromPath(files_to_scan[index].first, &entry))
+        {
+          entry.path = std::move(files_to_scan[index].first);
+          entry.last_modified_time = files_to_scan[index].second;
+          scanned_entries[index] = std::move(entry);
+        }
 
-  if (s_cache_write_stream || OpenCacheForWriting())
-  {
-    if (!WriteEntryToCache(&entry))
-      Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
+        completed_files.fetch_add(1, std::memory_order_acq_rel);
+      }
+
+      finished_workers.fetch_add(1, std::memory_order_acq_rel);
+    };
+
+    const u32 worker_count =
+      std::min(Threading::ThreadPool::GetWorkerCount(), static_cast<u32>(files_to_scan.size()));
+    for (u32 i = 0; i < worker_count; i++)
+      Threading::ThreadPool::QueueWork(worker_func);
+
+    // This thread owns the progress callback, so pump it here while the pool works.
+    while (finished_workers.load(std::memory_order_acquire) < worker_count)
+    {
+      if (progress->IsCancelled())
+        cancelled.store(true, std::memory_order_release);
+
+      progress->SetProgressValue(num_cached_files + completed_files.load(std::memory_order_acquire));
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // Cache writes are batched up here instead of happening per-file; the stream isn't
+    // thread-safe, and one sequential append is kinder to the disk anyway.
+    std::unique_lock lock(s_mutex);
+    for (std::optional<Entry>& scanned_entry : scanned_entries)
+    {
+      if (!scanned_entry.has_value())
+        continue;
+
+      Entry& entry = scanned_entry.value();
+      if (s_cache_write_stream || OpenCacheForWriting())
+      {
+        if (!WriteEntryToCache(&entry))
+          Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
+      }
+
+      const auto iter = played_time_map.find(entry.serial);
+      if (iter != played_time_map.end())
+      {
+        entry.last_played_time = iter->second.last_played_time;
+        entry.total_played_time = iter->second.total_played_time;
+      }
+
+      s_entries.push_back(std::move(entry));
+    }
   }
 
+  progress->SetProgressValue(static_cast<u32>(files.size()));
+  progress->PopState();
+}
+
+bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map)
+{
+  Entry entry;
+  if (!GetGameListEntryFromCache(path, &entry) || entry.last_modified_time != timestamp)
+    return false;
+
   auto iter = played_time_map.find(entry.serial);
   if (iter != played_time_map.end())
   {
@@ -574,7 +630,6 @@ bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_loc
     entry.total_played_time = iter->second.total_played_time;
   }
 
-  lock.lock();
   s_entries.push_back(std::move(entry));
   return true;
 }
@@ -601,6 +656,19 @@ const GameList::Entry* GameList::GetEntryForPath(const char* path)
   return nullptr;
 }
 
+std::optional<u32> GameList::GetEntryIndexForPath(const char* path)
+{
+  const size_t path_length = std::strlen(path);
+  for (u32 i = 0; i < static_cast<u32>(s_entries.size()); i++)
+  {
+    const Entry& entry = s_entries[i];
+    if (entry.path.size() == path_length && StringUtil::Strcasecmp(entry.path.c_str(), path) == 0)
+      return i;
+  }
+
+  return std::nullopt;
+}
+
 const GameList::Entry* GameList::GetEntryBySerial(std::string_view serial)
 {
   for (const Entry& entry : s_entries)
@@ -702,6 +770,76 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
   s_cache_map.clear();
 }
 
+GameList::FileScanResult GameList::ScanFile(std::string path, u32* out_entry_index /* = nullptr */)
+{
+  if (!IsScannableFilename(path))
+    return FileScanResult::Failed;
+
+  FILESYSTEM_STAT_DATA sd;
+  if (!FileSystem::StatFile(path.c_str(), &sd))
+    return FileScanResult::Failed;
+
+  {
+    std::unique_lock lock(s_mutex);
+    const Entry* existing_entry = GetEntryForPath(path.c_str());
+    if (existing_entry && existing_entry->last_modified_time == sd.ModificationTime)
+      return FileScanResult::Unchanged;
+  }
+
+  Log_DevPrintf("Scanning '%s'...", path.c_str());
+
+  GameDatabase::EnsureLoaded();
+
+  Entry entry;
+  if (!PopulateEntryFromPath(path, &entry))
+    return FileScanResult::Failed;
+
+  entry.path = std::move(path);
+  entry.last_modified_time = sd.ModificationTime;
+
+  const PlayedTimeMap played_time_map(LoadPlayedTimeMap(GetPlayedTimeFile()));
+  const auto played_time_iter = played_time_map.find(entry.serial);
+  if (played_time_iter != played_time_map.end())
+  {
+    entry.last_played_time = played_time_iter->second.last_played_time;
+    entry.total_played_time = played_time_iter->second.total_played_time;
+  }
+
+  std::unique_lock lock(s_mutex);
+
+  // The cache loader takes the last record for a given path, so updates can just append.
+  if (s_cache_write_stream || OpenCacheForWriting())
+  {
+    if (!WriteEntryToCache(&entry))
+      Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
+    CloseCacheFileStream();
+  }
+
+  const std::optional<u32> existing_index = GetEntryIndexForPath(entry.path.c_str());
+  if (existing_index.has_value())
+  {
+    s_entries[existing_index.value()] = std::move(entry);
+    if (out_entry_index)
+      *out_entry_index = existing_index.value();
+    return FileScanResult::Updated;
+  }
+
+  if (out_entry_index)
+    *out_entry_index = static_cast<u32>(s_entries.size());
+  s_entries.push_back(std::move(entry));
+  return FileScanResult::Added;
+}
+
+bool GameList::RemoveEntryByIndex(u32 index)
+{
+  std::unique_lock lock(s_mutex);
+  if (index >= static_cast<u32>(s_entries.size()))
+    return false;
+
+  s_entries.erase(s_entries.begin() + index);
+  return true;
+}
+
 std::string GameList::GetCoverImagePathForEntry(const Entry* entry)
 {
   return GetCoverImagePath(entry->path, entry->serial, entry->title);
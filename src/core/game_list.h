@@ -13,8 +13,10 @@
 #include <ctime>
 #include <functional>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <string>
+#include <string_view>
 
 class ByteStream;
 class ProgressCallback;
@@ -40,9 +42,11 @@ struct Entry
   std::string serial;
   std::string title;
   std::string disc_set_name;
-  std::string genre;
-  std::string publisher;
-  std::string developer;
+
+  // Shared with the game database via StringIntern; views are null-terminated.
+  std::string_view genre = "";
+  std::string_view publisher = "";
+  std::string_view developer = "";
   u64 hash = 0;
   s64 file_size = 0;
   u64 uncompressed_size = 0;
@@ -83,6 +87,9 @@ const Entry* GetEntryBySerialAndHash(std::string_view serial, u64 hash);
 std::vector<const Entry*> GetDiscSetMembers(std::string_view disc_set_name);
 u32 GetEntryCount();
 
+/// Returns the index of the entry with the specified path, if one exists.
+std::optional<u32> GetEntryIndexForPath(const char* path);
+
 bool IsGameListLoaded();
 
 /// Populates the game list with files in the configured directories.
@@ -90,6 +97,24 @@ bool IsGameListLoaded();
 /// If only_cache is set, no new files will be scanned, only those present in the cache.
 void Refresh(bool invalidate_cache, bool only_cache = false, ProgressCallback* progress = nullptr);
 
+enum class FileScanResult : u32
+{
+  Unchanged,
+  Added,
+  Updated,
+  Failed,
+};
+
+/// Rescans a single file, adding or updating its entry in the list and the cache. Intended for
+/// incremental refreshes driven by a filesystem watcher; changes to one file do not require a full
+/// Refresh(). Returns the index of the affected entry in out_entry_index.
+FileScanResult ScanFile(std::string path, u32* out_entry_index = nullptr);
+
+/// Removes the entry at the specified index, e.g. when its file has been deleted. Callers
+/// displaying the list must bracket this with their own row-removal notifications, since all
+/// following entries shift down by one.
+bool RemoveEntryByIndex(u32 index);
+
 /// Add played time for the specified serial.
 void AddPlayedTimeForSerial(const std::string& serial, std::time_t last_time, std::time_t add_time);
 void ClearPlayedTimeForSerial(const std::string& serial);
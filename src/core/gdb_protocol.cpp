@@ -11,12 +11,10 @@
 #include "common/small_string.h"
 #include "common/string_util.h"
 
-#include <functional>
-#include <iomanip>
-#include <map>
+#include <array>
 #include <optional>
-#include <sstream>
 #include <string>
+#include <utility>
 
 Log_SetChannel(GDBProtocol);
 
@@ -45,6 +43,16 @@ static u8 ComputeChecksum(const std::string_view& str)
   return checksum;
 }
 
+/// Appends the hex encoding of [data, data+length) to dest without intermediate allocations.
+static void AppendHex(std::string& dest, const u8* data, u32 length)
+{
+  static constexpr char hex[] = "0123456789abcdef";
+  for (u32 i = 0; i < length; i++) {
+    dest.push_back(hex[data[i] >> 4]);
+    dest.push_back(hex[data[i] & 0xF]);
+  }
+}
+
 static std::optional<std::string_view> DeserializePacket(const std::string_view& in)
 {
   if ((in.size() < 4) || (in[0] != '$') || (in[in.size()-3] != '#')) {
@@ -65,9 +73,14 @@ static std::optional<std::string_view> DeserializePacket(const std::string_view&
 
 static std::string SerializePacket(const std::string_view& in)
 {
-  std::stringstream ss;
-  ss << '$' << in << '#' << TinyString::from_format("{:02x}", ComputeChecksum(in));
-  return ss.str();
+  const u8 checksum = ComputeChecksum(in);
+  std::string ret;
+  ret.reserve(in.size() + 4);
+  ret.push_back('$');
+  ret.append(in);
+  ret.push_back('#');
+  AppendHex(ret, &checksum, 1);
+  return ret;
 }
 
 /// List of GDB remote protocol registers for MIPS III (excluding FP).
@@ -122,22 +135,24 @@ static std::optional<std::string> Cmd$_questionMark(const std::string_view& data
   return { "S02" };
 }
 
-/// Get general registers.
+/// Get general registers. Encodes the whole register file into one reply so steppers don't need
+/// a round-trip per register.
 static std::optional<std::string> Cmd$g(const std::string_view& data)
 {
-  std::stringstream ss;
+  std::string ret;
+  ret.reserve(NUM_GDB_REGISTERS * 8);
 
   for (u32* reg : REGISTERS) {
     // Data is in host order (little endian).
-    ss << StringUtil::EncodeHex(reinterpret_cast<u8*>(reg), 4);
+    AppendHex(ret, reinterpret_cast<u8*>(reg), 4);
   }
 
   // Pad with dummy data (FP registers stuff).
   for (int i = 0; i < NUM_GDB_REGISTERS - static_cast<int>(REGISTERS.size()); i++) {
-    ss << "00000000";
+    ret.append("00000000");
   }
 
-  return { ss.str() };
+  return { ret };
 }
 
 /// Set general registers.
@@ -162,25 +177,42 @@ static std::optional<std::string> Cmd$G(const std::string_view& data)
   return { "" };
 }
 
-/// Get memory.
+/// Get memory. Block transfers encode straight out of the backing memory; ranges which don't map
+/// to a single region (mirrors, MMIO) fall back to bytewise bus reads.
 static std::optional<std::string> Cmd$m(const std::string_view& data)
 {
-  std::stringstream ss{std::string{data}};
-  std::string dataAddress, dataLength;
-
-  std::getline(ss, dataAddress, ',');
-  std::getline(ss, dataLength, '\0');
+  const std::string_view::size_type comma_pos = data.find(',');
+  if (comma_pos == std::string_view::npos) {
+    return { "E00" };
+  }
 
-  auto address = StringUtil::FromChars<VirtualMemoryAddress>(dataAddress, 16);
-  auto length = StringUtil::FromChars<u32>(dataLength, 16);
+  auto address = StringUtil::FromChars<VirtualMemoryAddress>(data.substr(0, comma_pos), 16);
+  auto length = StringUtil::FromChars<u32>(data.substr(comma_pos + 1), 16);
 
   if (address && length) {
     PhysicalMemoryAddress phys_addr = *address & CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
     u32 phys_length = *length;
 
+    std::string ret;
+    ret.reserve(phys_length * 2);
+
     u8* ptr_data = GetMemoryPointer(phys_addr, phys_length);
     if (ptr_data) {
-      return { StringUtil::EncodeHex(ptr_data, phys_length) };
+      AppendHex(ret, ptr_data, phys_length);
+      return { ret };
+    }
+
+    bool okay = true;
+    for (u32 i = 0; i < phys_length; i++) {
+      u8 value;
+      if (!CPU::SafeReadMemoryByte(*address + i, &value)) {
+        okay = false;
+        break;
+      }
+      AppendHex(ret, &value, 1);
+    }
+    if (okay) {
+      return { ret };
     }
   }
   return { "E00" };
@@ -189,16 +221,15 @@ static std::optional<std::string> Cmd$m(const std::string_view& data)
 /// Set memory.
 static std::optional<std::string> Cmd$M(const std::string_view& data)
 {
-  std::stringstream ss{std::string{data}};
-  std::string dataAddress, dataLength, dataPayload;
-
-  std::getline(ss, dataAddress, ',');
-  std::getline(ss, dataLength, ':');
-  std::getline(ss, dataPayload, '\0');
+  const std::string_view::size_type comma_pos = data.find(',');
+  const std::string_view::size_type colon_pos = data.find(':');
+  if (comma_pos == std::string_view::npos || colon_pos == std::string_view::npos || colon_pos < comma_pos) {
+    return { "E00" };
+  }
 
-  auto address = StringUtil::FromChars<VirtualMemoryAddress>(dataAddress, 16);
-  auto length = StringUtil::FromChars<u32>(dataLength, 16);
-  auto payload = StringUtil::DecodeHex(dataPayload);
+  auto address = StringUtil::FromChars<VirtualMemoryAddress>(data.substr(0, comma_pos), 16);
+  auto length = StringUtil::FromChars<u32>(data.substr(comma_pos + 1, colon_pos - comma_pos - 1), 16);
+  auto payload = StringUtil::DecodeHex(data.substr(colon_pos + 1));
 
   if (address && length && payload && (payload->size() == *length)) {
     u32 phys_addr = *address & CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
@@ -209,6 +240,17 @@ static std::optional<std::string> Cmd$M(const std::string_view& data)
       memcpy(ptr_data, payload->data(), phys_length);
       return { "OK" };
     }
+
+    bool okay = true;
+    for (u32 i = 0; i < phys_length; i++) {
+      if (!CPU::SafeWriteMemoryByte(*address + i, (*payload)[i])) {
+        okay = false;
+        break;
+      }
+    }
+    if (okay) {
+      return { "OK" };
+    }
   }
 
   return { "E00" };
@@ -250,9 +292,10 @@ static std::optional<std::string> Cmd$qSupported(const std::string_view& data)
   return { "" };
 }
 
-/// List of all GDB remote protocol packets supported by us.
-static const std::map<const char*, std::function<std::optional<std::string>(const std::string_view&)>> COMMANDS
-{
+/// List of all GDB remote protocol packets supported by us. Matched in order by prefix; a flat
+/// table rather than a map, since dispatch happens for every packet.
+using CommandHandler = std::optional<std::string> (*)(const std::string_view&);
+static constexpr std::array<std::pair<const char*, CommandHandler>, 11> COMMANDS = {{
   { "?", Cmd$_questionMark },
   { "g", Cmd$g },
   { "G", Cmd$G },
@@ -264,7 +307,7 @@ static const std::map<const char*, std::function<std::optional<std::string>(cons
   { "Z1,", Cmd$Z1 },
   { "vMustReplyEmpty", Cmd$vMustReplyEmpty },
   { "qSupported", Cmd$qSupported },
-};
+}};
 
 bool IsPacketInterrupt(const std::string_view& data)
 {
@@ -3,6 +3,7 @@
 
 #include "gpu.h"
 #include "dma.h"
+#include "frame_export.h"
 #include "gpu_shadergen.h"
 #include "host.h"
 #include "imgui.h"
@@ -24,12 +25,20 @@
 #include "common/log.h"
 #include "common/small_string.h"
 #include "common/string_util.h"
+#include "common/timer.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <deque>
 #include <thread>
 
 Log_SetChannel(GPU);
 
+static void CompletePendingScreenshots(bool wait);
+static void CompletePendingFrameExports(bool wait);
+static void DestroyPendingFrameExports();
+
 std::unique_ptr<GPU> g_gpu;
 alignas(HOST_PAGE_SIZE) u16 g_vram[VRAM_SIZE / sizeof(u16)];
 
@@ -42,6 +51,10 @@ GPU::GPU()
 
 GPU::~GPU()
 {
+  CompletePendingScreenshots(true);
+  DestroyPendingFrameExports();
+  StopRecordingGPUDump();
+
   if (g_gpu_device)
     g_gpu_device->SetGPUTimingEnabled(false);
 }
@@ -69,7 +82,8 @@ bool GPU::Initialize()
     return false;
   }
 
-  g_gpu_device->SetGPUTimingEnabled(g_settings.display_show_gpu_usage);
+  g_gpu_device->SetGPUTimingEnabled(g_settings.display_show_gpu_usage ||
+                                    (g_settings.gpu_dynamic_resolution_scale && IsHardwareRenderer()));
 
   return true;
 }
@@ -98,7 +112,8 @@ void GPU::UpdateSettings(const Settings& old_settings)
       Panic("Failed to compile display pipeline on settings change.");
   }
 
-  g_gpu_device->SetGPUTimingEnabled(g_settings.display_show_gpu_usage);
+  g_gpu_device->SetGPUTimingEnabled(g_settings.display_show_gpu_usage ||
+                                    (g_settings.gpu_dynamic_resolution_scale && IsHardwareRenderer()));
 }
 
 void GPU::CPUClockChanged()
@@ -110,6 +125,10 @@ void GPU::UpdateResolutionScale()
 {
 }
 
+void GPU::UpdateDynamicResolutionScale(float average_gpu_time)
+{
+}
+
 std::tuple<u32, u32> GPU::GetEffectiveDisplayResolution(bool scaled /* = true */)
 {
   return std::tie(m_crtc_state.display_vram_width, m_crtc_state.display_vram_height);
@@ -122,6 +141,9 @@ std::tuple<u32, u32> GPU::GetFullDisplayResolution(bool scaled /* = true */)
 
 void GPU::Reset(bool clear_vram)
 {
+  // A dump which spans a reset would be missing the register changes made by SoftReset().
+  StopRecordingGPUDump();
+
   m_GPUSTAT.bits = 0x14802000;
   m_set_texture_disable_mask = false;
   m_GPUREAD_latch = 0;
@@ -305,6 +327,7 @@ bool GPU::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_displ
     else
     {
       ReadVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+      FinishVRAMReadback();
       sw.DoBytes(g_vram, VRAM_WIDTH * VRAM_HEIGHT * sizeof(u16));
     }
   }
@@ -438,12 +461,18 @@ void GPU::WriteRegister(u32 offset, u32 value)
   switch (offset)
   {
     case 0x00:
+      if (m_dump_recorder) [[unlikely]]
+        m_dump_recorder->PushGP0Word(value);
+
       m_fifo.Push(value);
       ExecuteCommands();
       UpdateCommandTickEvent();
       return;
 
     case 0x04:
+      if (m_dump_recorder) [[unlikely]]
+        m_dump_recorder->WriteGP1Command(value);
+
       WriteGP1(value);
       return;
 
@@ -949,9 +978,13 @@ void GPU::CRTCTickEvent(TickCount ticks)
         // flush any pending draws and "scan out" the image
         // TODO: move present in here I guess
         FlushRender();
-        UpdateDisplay();
+        if (!System::ShouldSkipRenderingFrame())
+          UpdateDisplay();
         TimingEvents::SetFrameDone();
 
+        if (m_dump_recorder) [[unlikely]]
+          m_dump_recorder->WriteVSync();
+
         // switch fields early. this is needed so we draw to the correct one.
         if (m_GPUSTAT.InInterleaved480iMode())
           m_crtc_state.interlaced_display_field = m_crtc_state.interlaced_field ^ 1u;
@@ -1072,6 +1105,10 @@ u32 GPU::ReadGPUREAD()
   if (m_blitter_state != BlitterState::ReadingVRAM)
     return m_GPUREAD_latch;
 
+  // The backend may have queued the readback asynchronously, wait for it before touching the shadow copy.
+  if (m_vram_transfer.col == 0 && m_vram_transfer.row == 0)
+    FinishVRAMReadback();
+
   // Read two pixels out of VRAM and combine them. Zero fill odd pixel counts.
   u32 value = 0;
   for (u32 i = 0; i < 2; i++)
@@ -1354,6 +1391,25 @@ void GPU::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
 }
 
+void GPU::FinishVRAMReadback()
+{
+}
+
+// Fills a possibly-wrapping span within a single VRAM row as one or two bulk fills, instead of
+// computing the wrap per pixel.
+static void FillVRAMRow(u16* row_ptr, u32 x, u32 width, u16 color16)
+{
+  if ((x + width) <= VRAM_WIDTH)
+  {
+    std::fill_n(&row_ptr[x], width, color16);
+    return;
+  }
+
+  const u32 columns_before_wrap = VRAM_WIDTH - x;
+  std::fill_n(&row_ptr[x], columns_before_wrap, color16);
+  std::fill_n(row_ptr, std::min<u32>(width - columns_before_wrap, VRAM_WIDTH), color16);
+}
+
 void GPU::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
 {
   const u16 color16 = VRAMRGBA8888ToRGBA5551(color);
@@ -1378,12 +1434,7 @@ void GPU::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
       if ((row & u32(1)) == active_field)
         continue;
 
-      u16* row_ptr = &g_vram[row * VRAM_WIDTH];
-      for (u32 xoffs = 0; xoffs < width; xoffs++)
-      {
-        const u32 col = (x + xoffs) % VRAM_WIDTH;
-        row_ptr[col] = color16;
-      }
+      FillVRAMRow(&g_vram[row * VRAM_WIDTH], x, width, color16);
     }
   }
   else
@@ -1391,12 +1442,7 @@ void GPU::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
     for (u32 yoffs = 0; yoffs < height; yoffs++)
     {
       const u32 row = (y + yoffs) % VRAM_HEIGHT;
-      u16* row_ptr = &g_vram[row * VRAM_WIDTH];
-      for (u32 xoffs = 0; xoffs < width; xoffs++)
-      {
-        const u32 col = (x + xoffs) % VRAM_WIDTH;
-        row_ptr[col] = color16;
-      }
+      FillVRAMRow(&g_vram[row * VRAM_WIDTH], x, width, color16);
     }
   }
 }
@@ -1471,10 +1517,23 @@ void GPU::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 he
     return;
   }
 
-  // This doesn't have a fast path, but do we really need one? It's not common.
   const u16 mask_and = m_GPUSTAT.GetMaskAND();
   const u16 mask_or = m_GPUSTAT.GetMaskOR();
 
+  // Without masking each row is a straight copy, and memmove's handling of overlap within a row
+  // matches the reverse copy direction the hardware uses when the ranges overlap.
+  if (mask_and == 0 && mask_or == 0)
+  {
+    for (u32 row = 0; row < height; row++)
+    {
+      const u16* src_row_ptr = &g_vram[((src_y + row) % VRAM_HEIGHT) * VRAM_WIDTH + src_x];
+      u16* dst_row_ptr = &g_vram[((dst_y + row) % VRAM_HEIGHT) * VRAM_WIDTH + dst_x];
+      std::memmove(dst_row_ptr, src_row_ptr, width * sizeof(u16));
+    }
+
+    return;
+  }
+
   // Copy in reverse when src_x < dst_x, this is verified on console.
   if (src_x < dst_x || ((src_x + width - 1) % VRAM_WIDTH) < ((dst_x + width - 1) % VRAM_WIDTH))
   {
@@ -1514,6 +1573,10 @@ void GPU::DispatchRenderCommand()
 {
 }
 
+void GPU::FlushBackendCommands()
+{
+}
+
 void GPU::FlushRender()
 {
 }
@@ -1667,6 +1730,11 @@ void GPU::SetDisplayParameters(s32 display_width, s32 display_height, s32 active
 
 bool GPU::PresentDisplay()
 {
+  // Hand any screenshot readbacks whose fences have signalled over to the encoder, and completed
+  // frame export readbacks over to the shared-memory channel.
+  CompletePendingScreenshots(false);
+  CompletePendingFrameExports(false);
+
   FlushRender();
 
   if (!HasDisplayTexture())
@@ -1674,6 +1742,10 @@ bool GPU::PresentDisplay()
 
   const Common::Rectangle<s32> draw_rect =
     CalculateDrawRect(g_gpu_device->GetWindowWidth(), g_gpu_device->GetWindowHeight());
+
+  if (FrameExport::IsActive())
+    ExportDisplayFrame(draw_rect);
+
   return RenderDisplay(nullptr, draw_rect, true);
 }
 
@@ -1942,6 +2014,183 @@ static bool CompressAndWriteTextureToFile(u32 width, u32 height, std::string fil
   return true;
 }
 
+namespace {
+
+struct PendingScreenshot
+{
+  std::unique_ptr<GPUDownloadTexture> texture;
+  std::string filename;
+  FileSystem::ManagedCFilePtr fp;
+  std::vector<u32> pixels;
+  u32 width;
+  u32 height;
+  u32 stride;
+  GPUTexture::Format format;
+  u8 quality;
+  bool flip_y;
+};
+
+} // namespace
+
+// Screenshots in flight between readback enqueue and GPU completion. Bounded so a stalled GPU
+// can't pile up staging memory; the oldest entry is completed synchronously when it fills up.
+static constexpr u32 MAX_PENDING_SCREENSHOTS = 4;
+static std::deque<PendingScreenshot> s_pending_screenshots;
+
+void CompletePendingScreenshots(bool wait)
+{
+  while (!s_pending_screenshots.empty())
+  {
+    PendingScreenshot& ps = s_pending_screenshots.front();
+    if (!wait && !ps.texture->IsDataReady())
+      break;
+
+    if (ps.texture->ReadTexels(0, 0, ps.width, ps.height, ps.pixels.data(), ps.stride))
+    {
+      std::thread compress_thread(CompressAndWriteTextureToFile, ps.width, ps.height, std::move(ps.filename),
+                                  std::move(ps.fp), ps.quality, true, ps.flip_y, std::move(ps.pixels), ps.stride,
+                                  ps.format);
+      compress_thread.detach();
+    }
+    else
+    {
+      Log_ErrorFmt("Failed to read back {}x{} screenshot for '{}'", ps.width, ps.height, ps.filename);
+    }
+
+    s_pending_screenshots.pop_front();
+  }
+}
+
+namespace {
+
+struct ExportFrameReadback
+{
+  std::unique_ptr<GPUDownloadTexture> texture;
+  std::vector<u32> pixels;
+  u32 width;
+  u32 height;
+  u32 stride;
+  GPUTexture::Format format;
+  bool flip_y;
+  u32 frame_number;
+  u32 internal_frame_number;
+  u64 timestamp_ns;
+};
+
+} // namespace
+
+// Export readbacks in flight between enqueue and fence completion, plus a free list so the
+// download textures are reused from frame to frame instead of recreated. Bounded the same way as
+// screenshots; the oldest entry is completed synchronously if the GPU falls too far behind.
+static constexpr u32 MAX_PENDING_EXPORT_FRAMES = 3;
+static std::deque<ExportFrameReadback> s_pending_export_frames;
+static std::vector<ExportFrameReadback> s_export_readback_pool;
+
+void CompletePendingFrameExports(bool wait)
+{
+  if (!FrameExport::IsActive() && !s_pending_export_frames.empty())
+  {
+    s_pending_export_frames.clear();
+    s_export_readback_pool.clear();
+    return;
+  }
+
+  while (!s_pending_export_frames.empty())
+  {
+    ExportFrameReadback& ef = s_pending_export_frames.front();
+    if (!wait && !ef.texture->IsDataReady())
+      break;
+
+    u32 stride = ef.stride;
+    if (ef.texture->ReadTexels(0, 0, ef.width, ef.height, ef.pixels.data(), stride) &&
+        GPUTexture::ConvertTextureDataToRGBA8(ef.width, ef.height, ef.pixels, stride, ef.format))
+    {
+      if (ef.flip_y)
+        GPUTexture::FlipTextureDataRGBA8(ef.width, ef.height, reinterpret_cast<u8*>(ef.pixels.data()), stride);
+
+      FrameExport::PublishFrame(ef.pixels.data(), ef.width, ef.height, ef.frame_number, ef.internal_frame_number,
+                                ef.timestamp_ns);
+    }
+    else
+    {
+      Log_ErrorFmt("Failed to read back {}x{} export frame", ef.width, ef.height);
+    }
+
+    // Conversion from a 16-bit format reallocates the pixel buffer, which an imported-memory
+    // download texture is tied to, so only 32bpp readbacks are safe to recycle.
+    if (GPUTexture::GetPixelSize(ef.format) == sizeof(u32))
+      s_export_readback_pool.push_back(std::move(ef));
+
+    s_pending_export_frames.pop_front();
+  }
+}
+
+void DestroyPendingFrameExports()
+{
+  CompletePendingFrameExports(true);
+  s_pending_export_frames.clear();
+  s_export_readback_pool.clear();
+}
+
+void GPU::ExportDisplayFrame(const Common::Rectangle<s32>& draw_rect)
+{
+  const u32 width = g_gpu_device->GetWindowWidth();
+  const u32 height = g_gpu_device->GetWindowHeight();
+  if (width == 0 || height == 0)
+    return;
+
+  const GPUTexture::Format hdformat =
+    g_gpu_device->HasSurface() ? g_gpu_device->GetWindowFormat() : GPUTexture::Format::RGBA8;
+  auto render_texture =
+    g_gpu_device->FetchAutoRecycleTexture(width, height, 1, 1, 1, GPUTexture::Type::RenderTarget, hdformat);
+  if (!render_texture)
+    return;
+
+  g_gpu_device->ClearRenderTarget(render_texture.get(), 0);
+  RenderDisplay(render_texture.get(), draw_rect, true);
+
+  ExportFrameReadback ef;
+  if (!s_export_readback_pool.empty() && s_export_readback_pool.back().width == width &&
+      s_export_readback_pool.back().height == height && s_export_readback_pool.back().format == hdformat)
+  {
+    ef = std::move(s_export_readback_pool.back());
+    s_export_readback_pool.pop_back();
+  }
+  else
+  {
+    s_export_readback_pool.clear();
+    ef.width = width;
+    ef.height = height;
+    ef.format = hdformat;
+    ef.stride = Common::AlignUpPow2(GPUTexture::GetPixelSize(hdformat) * width, sizeof(u32));
+    ef.pixels.resize((static_cast<size_t>(height) * ef.stride) / sizeof(u32));
+    if (g_gpu_device->GetFeatures().memory_import)
+    {
+      ef.texture = g_gpu_device->CreateDownloadTexture(width, height, hdformat, ef.pixels.data(),
+                                                       ef.pixels.size() * sizeof(u32), ef.stride);
+    }
+    if (!ef.texture && !(ef.texture = g_gpu_device->CreateDownloadTexture(width, height, hdformat)))
+    {
+      Log_ErrorFmt("Failed to create {}x{} export download texture", width, height);
+      RestoreDeviceContext();
+      return;
+    }
+  }
+
+  ef.flip_y = g_gpu_device->UsesLowerLeftOrigin();
+  ef.frame_number = System::GetFrameNumber();
+  ef.internal_frame_number = System::GetInternalFrameNumber();
+  ef.timestamp_ns = static_cast<u64>(Common::Timer::ConvertValueToNanoseconds(Common::Timer::GetCurrentValue()));
+
+  ef.texture->CopyFromTexture(0, 0, render_texture.get(), 0, 0, width, height, 0, 0, false);
+  RestoreDeviceContext();
+
+  if (s_pending_export_frames.size() >= MAX_PENDING_EXPORT_FRAMES)
+    CompletePendingFrameExports(true);
+
+  s_pending_export_frames.push_back(std::move(ef));
+}
+
 bool GPU::WriteDisplayTextureToFile(std::string filename, bool compress_on_thread /* = false */)
 {
   if (!m_display_texture)
@@ -1974,18 +2223,12 @@ bool GPU::WriteDisplayTextureToFile(std::string filename, bool compress_on_threa
   }
 
   dltex->CopyFromTexture(0, 0, m_display_texture, read_x, read_y, read_width, read_height, 0, 0, !dltex->IsImported());
-  if (!dltex->ReadTexels(0, 0, read_width, read_height, texture_data.data(), texture_data_stride))
-  {
-    RestoreDeviceContext();
-    return false;
-  }
-
-  RestoreDeviceContext();
 
   auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "wb");
   if (!fp)
   {
     Log_ErrorPrintf("Can't open file '%s': errno %d", filename.c_str(), errno);
+    RestoreDeviceContext();
     return false;
   }
 
@@ -1994,15 +2237,30 @@ bool GPU::WriteDisplayTextureToFile(std::string filename, bool compress_on_threa
 
   if (!compress_on_thread)
   {
+    if (!dltex->ReadTexels(0, 0, read_width, read_height, texture_data.data(), texture_data_stride))
+    {
+      RestoreDeviceContext();
+      return false;
+    }
+
+    RestoreDeviceContext();
     return CompressAndWriteTextureToFile(read_width, read_height, std::move(filename), std::move(fp),
                                          g_settings.display_screenshot_quality, clear_alpha, flip_y,
                                          std::move(texture_data), texture_data_stride, m_display_texture->GetFormat());
   }
 
-  std::thread compress_thread(CompressAndWriteTextureToFile, read_width, read_height, std::move(filename),
-                              std::move(fp), g_settings.display_screenshot_quality, clear_alpha, flip_y,
-                              std::move(texture_data), texture_data_stride, m_display_texture->GetFormat());
-  compress_thread.detach();
+  // Asynchronous path: don't wait for the copy here, poll the fence from PresentDisplay() and
+  // hand the encode/file write to a worker thread once it signals. Keeps a bounded number of
+  // frames in flight so a dump-every-frame run never stalls the emulation thread on the GPU.
+  RestoreDeviceContext();
+
+  if (s_pending_screenshots.size() >= MAX_PENDING_SCREENSHOTS)
+    CompletePendingScreenshots(true);
+
+  s_pending_screenshots.push_back(PendingScreenshot{std::move(dltex), std::move(filename), std::move(fp),
+                                                    std::move(texture_data), read_width, read_height,
+                                                    texture_data_stride, m_display_texture->GetFormat(),
+                                                    g_settings.display_screenshot_quality, flip_y});
   return true;
 }
 
@@ -2114,16 +2372,6 @@ bool GPU::RenderScreenshotToFile(std::string filename, DisplayScreenshotMode mod
   if (width == 0 || height == 0)
     return false;
 
-  std::vector<u32> pixels;
-  u32 pixels_stride;
-  GPUTexture::Format pixels_format;
-  if (!RenderScreenshotToBuffer(width, height, draw_rect, !internal_resolution, &pixels, &pixels_stride,
-                                &pixels_format))
-  {
-    Log_ErrorPrintf("Failed to render %ux%u screenshot", width, height);
-    return false;
-  }
-
   auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "wb");
   if (!fp)
   {
@@ -2133,21 +2381,71 @@ bool GPU::RenderScreenshotToFile(std::string filename, DisplayScreenshotMode mod
 
   if (!compress_on_thread)
   {
+    std::vector<u32> pixels;
+    u32 pixels_stride;
+    GPUTexture::Format pixels_format;
+    if (!RenderScreenshotToBuffer(width, height, draw_rect, !internal_resolution, &pixels, &pixels_stride,
+                                  &pixels_format))
+    {
+      Log_ErrorPrintf("Failed to render %ux%u screenshot", width, height);
+      return false;
+    }
+
     return CompressAndWriteTextureToFile(width, height, std::move(filename), std::move(fp), quality, true,
                                          g_gpu_device->UsesLowerLeftOrigin(), std::move(pixels), pixels_stride,
                                          pixels_format);
   }
 
-  std::thread compress_thread(CompressAndWriteTextureToFile, width, height, std::move(filename), std::move(fp), quality,
-                              true, g_gpu_device->UsesLowerLeftOrigin(), std::move(pixels), pixels_stride,
-                              pixels_format);
-  compress_thread.detach();
+  // Asynchronous path: only the render and copy to the download texture happen now, the fence is
+  // polled from PresentDisplay() and the encode/file write run on a worker thread once it signals.
+  const GPUTexture::Format hdformat =
+    g_gpu_device->HasSurface() ? g_gpu_device->GetWindowFormat() : GPUTexture::Format::RGBA8;
+  auto render_texture =
+    g_gpu_device->FetchAutoRecycleTexture(width, height, 1, 1, 1, GPUTexture::Type::RenderTarget, hdformat);
+  if (!render_texture)
+  {
+    Log_ErrorPrintf("Failed to render %ux%u screenshot", width, height);
+    return false;
+  }
+
+  g_gpu_device->ClearRenderTarget(render_texture.get(), 0);
+  RenderDisplay(render_texture.get(), draw_rect, !internal_resolution);
+
+  const u32 stride = Common::AlignUpPow2(GPUTexture::GetPixelSize(hdformat) * width, sizeof(u32));
+  std::vector<u32> pixels((height * stride) / sizeof(u32));
+
+  std::unique_ptr<GPUDownloadTexture> dltex;
+  if (g_gpu_device->GetFeatures().memory_import)
+  {
+    dltex =
+      g_gpu_device->CreateDownloadTexture(width, height, hdformat, pixels.data(), pixels.size() * sizeof(u32), stride);
+  }
+  if (!dltex)
+  {
+    if (!(dltex = g_gpu_device->CreateDownloadTexture(width, height, hdformat)))
+    {
+      Log_ErrorFmt("Failed to create {}x{} download texture", width, height);
+      RestoreDeviceContext();
+      return false;
+    }
+  }
+
+  dltex->CopyFromTexture(0, 0, render_texture.get(), 0, 0, width, height, 0, 0, false);
+  RestoreDeviceContext();
+
+  if (s_pending_screenshots.size() >= MAX_PENDING_SCREENSHOTS)
+    CompletePendingScreenshots(true);
+
+  s_pending_screenshots.push_back(PendingScreenshot{std::move(dltex), std::move(filename), std::move(fp),
+                                                    std::move(pixels), width, height, stride, hdformat, quality,
+                                                    g_gpu_device->UsesLowerLeftOrigin()});
   return true;
 }
 
 bool GPU::DumpVRAMToFile(const char* filename)
 {
   ReadVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+  FinishVRAMReadback();
 
   const char* extension = std::strrchr(filename, '.');
   if (extension && StringUtil::Strcasecmp(extension, ".png") == 0)
@@ -2189,6 +2487,93 @@ bool GPU::DumpVRAMToFile(const char* filename, u32 width, u32 height, u32 stride
   return image.SaveToFile(filename);
 }
 
+bool GPU::StartRecordingGPUDump(const char* filename)
+{
+  std::unique_ptr<GPUDump::Recorder> recorder = GPUDump::Recorder::Create(filename);
+  if (!recorder)
+    return false;
+
+  // Synthesize a command prefix which restores the current register state and VRAM contents, so
+  // the dump replays identically regardless of where in a game recording was started.
+  recorder->WriteGP1Command((UINT32_C(0x09) << 24) | BoolToUInt32(m_set_texture_disable_mask));
+
+  u32 display_mode = ZeroExtend32(m_GPUSTAT.horizontal_resolution_1.GetValue());
+  display_mode |= BoolToUInt32(m_GPUSTAT.vertical_resolution) << 2;
+  display_mode |= BoolToUInt32(m_GPUSTAT.pal_mode) << 3;
+  display_mode |= BoolToUInt32(m_GPUSTAT.display_area_color_depth_24) << 4;
+  display_mode |= BoolToUInt32(m_GPUSTAT.vertical_interlace) << 5;
+  display_mode |= ZeroExtend32(m_GPUSTAT.horizontal_resolution_2.GetValue()) << 6;
+  display_mode |= BoolToUInt32(m_GPUSTAT.reverse_flag) << 7;
+  recorder->WriteGP1Command((UINT32_C(0x08) << 24) | display_mode);
+
+  recorder->WriteGP1Command((UINT32_C(0x05) << 24) | m_crtc_state.regs.display_address_start);
+  recorder->WriteGP1Command((UINT32_C(0x06) << 24) | m_crtc_state.regs.horizontal_display_range);
+  recorder->WriteGP1Command((UINT32_C(0x07) << 24) | m_crtc_state.regs.vertical_display_range);
+  recorder->WriteGP1Command((UINT32_C(0x04) << 24) | static_cast<u32>(m_GPUSTAT.dma_direction.GetValue()));
+
+  // Upload a snapshot of the whole of VRAM, with mask checking disabled so every pixel is written.
+  FlushRender();
+  ReadVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+  FinishVRAMReadback();
+
+  const u32 mask_disable = UINT32_C(0xE6) << 24;
+  recorder->WriteGP0Packet(&mask_disable, 1);
+
+  const u32 upload_words[3] = {UINT32_C(0xA0) << 24, 0u, (VRAM_HEIGHT << 16) | VRAM_WIDTH};
+  recorder->WriteGP0Packet(upload_words, static_cast<u32>(std::size(upload_words)));
+  recorder->WriteGP0Packet(reinterpret_cast<const u32*>(g_vram), (VRAM_WIDTH * VRAM_HEIGHT) / 2);
+
+  const u32 draw_state[6] = {
+    (UINT32_C(0xE1) << 24) | ZeroExtend32(m_draw_mode.mode_reg.bits),
+    (UINT32_C(0xE2) << 24) | (m_draw_mode.texture_window_value & DrawMode::TEXTURE_WINDOW_MASK),
+    (UINT32_C(0xE3) << 24) | m_drawing_area.left | (m_drawing_area.top << 10),
+    (UINT32_C(0xE4) << 24) | std::min<u32>(m_drawing_area.right, VRAM_WIDTH_MASK) |
+      (std::min<u32>(m_drawing_area.bottom, VRAM_HEIGHT_MASK) << 10),
+    (UINT32_C(0xE5) << 24) | (static_cast<u32>(m_drawing_offset.x) & 0x7FFu) |
+      ((static_cast<u32>(m_drawing_offset.y) & 0x7FFu) << 11),
+    (UINT32_C(0xE6) << 24) | BoolToUInt32(m_GPUSTAT.set_mask_while_drawing) |
+      (BoolToUInt32(m_GPUSTAT.check_mask_before_draw) << 1),
+  };
+  recorder->WriteGP0Packet(draw_state, static_cast<u32>(std::size(draw_state)));
+
+  recorder->WriteGP1Command((UINT32_C(0x03) << 24) | BoolToUInt32(m_GPUSTAT.display_disable));
+
+  Log_InfoPrintf("Recording GPU dump to '%s'", recorder->GetFilename().c_str());
+  m_dump_recorder = std::move(recorder);
+  return true;
+}
+
+void GPU::StopRecordingGPUDump()
+{
+  if (!m_dump_recorder)
+    return;
+
+  if (m_dump_recorder->Close())
+    Log_InfoPrintf("Finished recording GPU dump to '%s'", m_dump_recorder->GetFilename().c_str());
+  else
+    Log_ErrorPrintf("Failed to write GPU dump to '%s'", m_dump_recorder->GetFilename().c_str());
+
+  m_dump_recorder.reset();
+}
+
+void GPU::ProcessGPUDumpPacket(const u32* words, u32 num_words)
+{
+  u32 position = 0;
+  while (position < num_words)
+  {
+    while (position < num_words && !m_fifo.IsFull())
+      m_fifo.Push(ZeroExtend64(words[position++]));
+
+    // Replay runs as fast as the backend allows, so don't accumulate any command time.
+    m_pending_command_ticks = 0;
+    ExecuteCommands();
+
+    // Nothing consumes GPUREAD during replay, so drain any VRAM reads ourselves.
+    while (m_blitter_state == BlitterState::ReadingVRAM)
+      ReadGPUREAD();
+  }
+}
+
 void GPU::DrawDebugStateWindow()
 {
   const float framebuffer_scale = Host::GetOSDScale();
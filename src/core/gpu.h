@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
 
 #pragma once
+#include "gpu_dump.h"
 #include "gpu_types.h"
 #include "timers.h"
 #include "types.h"
@@ -119,10 +120,20 @@ public:
   ALWAYS_INLINE bool BeginDMAWrite() const { return (m_GPUSTAT.dma_direction == DMADirection::CPUtoGP0); }
   ALWAYS_INLINE void DMAWrite(u32 address, u32 value)
   {
+    if (m_dump_recorder) [[unlikely]]
+      m_dump_recorder->PushGP0Word(value);
+
     m_fifo.Push((ZeroExtend64(address) << 32) | ZeroExtend64(value));
   }
   void EndDMAWrite();
 
+  /// Returns the number of words the FIFO can accept from DMA without overflowing its backing
+  /// storage. Used to size batched block transfers.
+  ALWAYS_INLINE u32 GetDMAWriteSpace() const
+  {
+    return (m_fifo.GetSize() >= m_fifo_size) ? 0 : (static_cast<u32>(MAX_FIFO_SIZE) - m_fifo.GetSize());
+  }
+
   /// Returns true if no data is being sent from VRAM to the DAC or that no portion of VRAM would be visible on screen.
   ALWAYS_INLINE bool IsDisplayDisabled() const
   {
@@ -163,6 +174,10 @@ public:
   /// Updates the resolution scale when it's set to automatic.
   virtual void UpdateResolutionScale();
 
+  /// Steps the dynamic resolution scale up/down based on the average GPU time per frame over the
+  /// last performance counter interval. Only does anything for the hardware renderers.
+  virtual void UpdateDynamicResolutionScale(float average_gpu_time);
+
   /// Returns the effective display resolution of the GPU.
   virtual std::tuple<u32, u32> GetEffectiveDisplayResolution(bool scaled = true);
 
@@ -188,6 +203,15 @@ public:
   // Dumps raw VRAM to a file.
   bool DumpVRAMToFile(const char* filename);
 
+  // Records the GP0/GP1 command stream to a file for later replay (see gpu_dump.h). The dump is
+  // prefixed with the current register state and VRAM contents, so recording can start at any time.
+  ALWAYS_INLINE bool IsRecordingGPUDump() const { return static_cast<bool>(m_dump_recorder); }
+  bool StartRecordingGPUDump(const char* filename);
+  void StopRecordingGPUDump();
+
+  /// Executes a packet of GP0 words from a dump, synchronously and ignoring command timing.
+  void ProcessGPUDumpPacket(const u32* words, u32 num_words);
+
   // Ensures all buffered vertices are drawn.
   virtual void FlushRender();
 
@@ -308,10 +332,19 @@ protected:
 
   // Rendering in the backend
   virtual void ReadVRAM(u32 x, u32 y, u32 width, u32 height);
+
+  /// Completes any readback queued by ReadVRAM(). The shadow copy in g_vram is only guaranteed to be
+  /// up to date after this returns, since backends may defer the GPU->CPU transfer behind a fence.
+  virtual void FinishVRAMReadback();
   virtual void FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color);
   virtual void UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, bool set_mask, bool check_mask);
   virtual void CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height);
   virtual void DispatchRenderCommand();
+
+  /// Called when the GP0 command stream pauses, so renderers which queue work for another thread
+  /// can submit whatever the burst produced.
+  virtual void FlushBackendCommands();
+
   virtual void ClearDisplay();
   virtual void UpdateDisplay();
   virtual void DrawRendererStats();
@@ -565,6 +598,8 @@ protected:
   TickCount m_max_run_ahead = 128;
   u32 m_fifo_size = 128;
 
+  std::unique_ptr<GPUDump::Recorder> m_dump_recorder;
+
   void ClearDisplayTexture();
   void SetDisplayTexture(GPUTexture* texture, s32 view_x, s32 view_y, s32 view_width, s32 view_height);
   void SetDisplayTextureRect(s32 view_x, s32 view_y, s32 view_width, s32 view_height);
@@ -577,6 +612,10 @@ protected:
 
   bool RenderDisplay(GPUTexture* target, const Common::Rectangle<s32>& draw_rect, bool postfx);
 
+  /// Renders the display without the OSD into an offscreen target and queues a readback for the
+  /// shared-memory frame export channel. Completed readbacks publish from PresentDisplay().
+  void ExportDisplayFrame(const Common::Rectangle<s32>& draw_rect);
+
   s32 m_display_width = 0;
   s32 m_display_height = 0;
   s32 m_display_active_left = 0;
@@ -7,6 +7,7 @@
 #include "common/timer.h"
 #include "settings.h"
 #include "util/state_wrapper.h"
+#include <algorithm>
 Log_SetChannel(GPUBackend);
 
 std::unique_ptr<GPUBackend> g_gpu_backend;
@@ -105,13 +106,14 @@ void* GPUBackend::AllocateCommand(GPUBackendCommandType command, u32 size)
   for (;;)
   {
     u32 read_ptr = m_command_fifo_read_ptr.load();
-    u32 write_ptr = m_command_fifo_write_ptr.load();
+    const u32 write_ptr = m_command_fifo_write_offset;
     if (read_ptr > write_ptr)
     {
       u32 available_size = read_ptr - write_ptr;
       while (available_size < (size + sizeof(GPUBackendCommandType)))
       {
-        WakeGPUThread();
+        // Give the GPU thread everything we have queued, otherwise it can't free up any space.
+        FlushQueuedCommands();
         read_ptr = m_command_fifo_read_ptr.load();
         available_size = (read_ptr > write_ptr) ? (read_ptr - write_ptr) : (COMMAND_QUEUE_SIZE - write_ptr);
       }
@@ -126,7 +128,12 @@ void* GPUBackend::AllocateCommand(GPUBackendCommandType command, u32 size)
         dummy_cmd->type = GPUBackendCommandType::Wraparound;
         dummy_cmd->size = available_size;
         dummy_cmd->params.bits = 0;
+
+        // The wraparound marker is the last command in this lap, so everything staged before it is
+        // complete and can be published along with it.
+        m_command_fifo_write_offset = 0;
         m_command_fifo_write_ptr.store(0);
+        WakeGPUThread();
         continue;
       }
     }
@@ -155,16 +162,37 @@ void GPUBackend::PushCommand(GPUBackendCommand* cmd)
   }
   else
   {
-    const u32 new_write_ptr = m_command_fifo_write_ptr.fetch_add(cmd->size) + cmd->size;
-    DebugAssert(new_write_ptr <= COMMAND_QUEUE_SIZE);
-    UNREFERENCED_VARIABLE(new_write_ptr);
-    if (GetPendingCommandSize() >= THRESHOLD_TO_WAKE_GPU)
-      WakeGPUThread();
+    const u32 new_write_offset = m_command_fifo_write_offset + cmd->size;
+    DebugAssert(new_write_offset <= COMMAND_QUEUE_SIZE);
+    m_command_fifo_write_offset = new_write_offset;
+
+    // Batch publishes so the GPU thread isn't poked for every primitive; long bursts still get
+    // flushed periodically so it can start chewing through them while we keep queueing.
+    if ((new_write_offset - m_command_fifo_write_ptr.load(std::memory_order_relaxed)) >= COMMAND_PUBLISH_THRESHOLD)
+      FlushQueuedCommands();
   }
 }
 
+void GPUBackend::FlushQueuedCommands()
+{
+  if (!m_use_gpu_thread)
+    return;
+
+  const u32 write_offset = m_command_fifo_write_offset;
+  if (m_command_fifo_write_ptr.load(std::memory_order_relaxed) == write_offset)
+    return;
+
+  m_command_fifo_write_ptr.store(write_offset);
+  WakeGPUThread();
+}
+
 void GPUBackend::WakeGPUThread()
 {
+  // The sequentially-consistent publish in FlushQueuedCommands() orders against the sleep flag, so
+  // when the GPU thread is awake (the common case) we can skip the mutex entirely.
+  if (!m_gpu_thread_sleeping.load())
+    return;
+
   std::unique_lock<std::mutex> lock(m_sync_mutex);
   if (!m_gpu_thread_sleeping.load())
     return;
@@ -195,21 +223,30 @@ void GPUBackend::StopGPUThread()
 void GPUBackend::Sync(bool allow_sleep)
 {
   if (!m_use_gpu_thread)
+  {
+    // Commands were executed as they were pushed, but rendering may still be in flight.
+    FlushRender();
     return;
+  }
 
   GPUBackendSyncCommand* cmd =
     static_cast<GPUBackendSyncCommand*>(AllocateCommand(GPUBackendCommandType::Sync, sizeof(GPUBackendSyncCommand)));
   cmd->allow_sleep = allow_sleep;
   PushCommand(cmd);
-  WakeGPUThread();
+  FlushQueuedCommands();
 
   m_sync_semaphore.Wait();
 }
 
 void GPUBackend::RunGPULoop()
 {
-  static constexpr double SPIN_TIME_NS = 1 * 1000000;
+  Threading::SetPerformanceHintForCurrentThread();
+
+  static constexpr double MIN_SPIN_TIME_NS = 100 * 1000;
+  static constexpr double MAX_SPIN_TIME_NS = 1 * 1000000;
   Common::Timer::Value last_command_time = 0;
+  double spin_time_ns = MIN_SPIN_TIME_NS;
+  bool was_spinning = false;
 
   for (;;)
   {
@@ -218,8 +255,15 @@ void GPUBackend::RunGPULoop()
     if (read_ptr == write_ptr)
     {
       const Common::Timer::Value current_time = Common::Timer::GetCurrentValue();
-      if (Common::Timer::ConvertValueToNanoseconds(current_time - last_command_time) < SPIN_TIME_NS)
+      if (Common::Timer::ConvertValueToNanoseconds(current_time - last_command_time) < spin_time_ns)
+      {
+        was_spinning = true;
         continue;
+      }
+
+      // Spinning didn't pay off, back off towards the futex and shorten the next spin.
+      spin_time_ns = std::max(spin_time_ns * 0.5, MIN_SPIN_TIME_NS);
+      was_spinning = false;
 
       std::unique_lock<std::mutex> lock(m_sync_mutex);
       m_gpu_thread_sleeping.store(true);
@@ -232,6 +276,13 @@ void GPUBackend::RunGPULoop()
         continue;
     }
 
+    // If work arrived while we were spinning, it saved a wakeup, so spin for longer next time.
+    if (was_spinning)
+    {
+      spin_time_ns = std::min(spin_time_ns * 2.0, MAX_SPIN_TIME_NS);
+      was_spinning = false;
+    }
+
     if (write_ptr < read_ptr)
       write_ptr = COMMAND_QUEUE_SIZE;
 
@@ -254,6 +305,7 @@ void GPUBackend::RunGPULoop()
         case GPUBackendCommandType::Sync:
         {
           DebugAssert(read_ptr == write_ptr);
+          FlushRender();
           m_sync_semaphore.Post();
           allow_sleep = static_cast<const GPUBackendSyncCommand*>(cmd)->allow_sleep;
         }
@@ -40,6 +40,10 @@ public:
   void PushCommand(GPUBackendCommand* cmd);
   void Sync(bool allow_sleep);
 
+  /// Publishes any queued commands to the GPU thread and wakes it if necessary. Called at the end
+  /// of a command burst; pushes between bursts are batched to amortize the cross-thread traffic.
+  void FlushQueuedCommands();
+
   /// Processes all pending GPU commands.
   void RunGPULoop();
 
@@ -78,13 +82,23 @@ protected:
 
   enum : u32
   {
-    COMMAND_QUEUE_SIZE = 4 * 1024 * 1024,
-    THRESHOLD_TO_WAKE_GPU = 256
+    COMMAND_QUEUE_SIZE = 8 * 1024 * 1024,
+
+    // Number of staged bytes which forces a publish mid-burst, so the GPU thread can overlap with
+    // long bursts instead of waiting for FlushQueuedCommands().
+    COMMAND_PUBLISH_THRESHOLD = 16 * 1024
   };
 
   FixedHeapArray<u8, COMMAND_QUEUE_SIZE> m_command_fifo_data;
+
+  // Consumer-owned. Kept on its own cache line so the producer's polling doesn't contend with it.
   alignas(64) std::atomic<u32> m_command_fifo_read_ptr{0};
+
+  // Publish pointer, written by the producer and polled by the consumer.
   alignas(64) std::atomic<u32> m_command_fifo_write_ptr{0};
+
+  // Producer-owned staging offset; runs ahead of the publish pointer until the batch is flushed.
+  alignas(64) u32 m_command_fifo_write_offset = 0;
 };
 
 #ifdef _MSC_VER
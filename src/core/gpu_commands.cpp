@@ -112,6 +112,7 @@ void GPU::ExecuteCommands()
   }
 
   UpdateGPUIdle();
+  FlushBackendCommands();
   m_syncing = false;
 }
 
@@ -580,6 +581,7 @@ bool GPU::HandleCopyRectangleVRAMToCPUCommand()
 
   if (g_settings.debugging.dump_vram_to_cpu_copies)
   {
+    FinishVRAMReadback();
     DumpVRAMToFile(TinyString::from_format("vram_to_cpu_copy_{}.png", s_vram_to_cpu_dump_id++), m_vram_transfer.width,
                    m_vram_transfer.height, sizeof(u16) * VRAM_WIDTH,
                    &g_vram[m_vram_transfer.y * VRAM_WIDTH + m_vram_transfer.x], true);
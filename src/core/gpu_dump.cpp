@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "gpu_dump.h"
+#include "gpu.h"
+
+#include "common/assert.h"
+#include "common/file_system.h"
+#include "common/log.h"
+
+#include <cstring>
+#include <optional>
+
+Log_SetChannel(GPUDump);
+
+namespace GPUDump {
+
+Recorder::Recorder(std::FILE* fp, std::string filename) : m_fp(fp), m_filename(std::move(filename))
+{
+}
+
+Recorder::~Recorder()
+{
+  if (m_fp)
+    Close();
+}
+
+std::unique_ptr<Recorder> Recorder::Create(std::string filename)
+{
+  std::FILE* fp = FileSystem::OpenCFile(filename.c_str(), "wb");
+  if (!fp)
+  {
+    Log_ErrorPrintf("Failed to open '%s' for GPU dump recording", filename.c_str());
+    return {};
+  }
+
+  std::unique_ptr<Recorder> recorder(new Recorder(fp, std::move(filename)));
+
+  const u32 header[2] = {FILE_SIGNATURE, FILE_VERSION};
+  if (!recorder->WriteWords(header, static_cast<u32>(std::size(header))))
+    return {};
+
+  return recorder;
+}
+
+bool Recorder::WritePacketHeader(PacketType type, u32 num_words)
+{
+  DebugAssert(num_words <= MAX_PACKET_WORDS);
+  const u32 header = static_cast<u32>(type) | (num_words << 8);
+  return WriteWords(&header, 1);
+}
+
+bool Recorder::WriteWords(const u32* words, u32 num_words)
+{
+  if (m_write_error) [[unlikely]]
+    return false;
+
+  if (std::fwrite(words, sizeof(u32), num_words, m_fp) != num_words) [[unlikely]]
+  {
+    Log_ErrorPrintf("Write to '%s' failed, stopping GPU dump", m_filename.c_str());
+    m_write_error = true;
+    return false;
+  }
+
+  return true;
+}
+
+void Recorder::PushGP0Word(u32 value)
+{
+  m_pending_gp0_words.push_back(value);
+  if (m_pending_gp0_words.size() >= MAX_PACKET_WORDS)
+    FlushGP0Words();
+}
+
+void Recorder::FlushGP0Words()
+{
+  if (m_pending_gp0_words.empty())
+    return;
+
+  if (WritePacketHeader(PacketType::GP0Data, static_cast<u32>(m_pending_gp0_words.size())))
+    WriteWords(m_pending_gp0_words.data(), static_cast<u32>(m_pending_gp0_words.size()));
+
+  m_pending_gp0_words.clear();
+}
+
+void Recorder::WriteGP0Packet(const u32* words, u32 num_words)
+{
+  FlushGP0Words();
+  if (WritePacketHeader(PacketType::GP0Data, num_words))
+    WriteWords(words, num_words);
+}
+
+void Recorder::WriteGP1Command(u32 value)
+{
+  FlushGP0Words();
+  if (WritePacketHeader(PacketType::GP1Command, 1))
+    WriteWords(&value, 1);
+}
+
+void Recorder::WriteVSync()
+{
+  FlushGP0Words();
+  WritePacketHeader(PacketType::VSync, 0);
+}
+
+bool Recorder::Close()
+{
+  FlushGP0Words();
+
+  if (std::fflush(m_fp) != 0)
+    m_write_error = true;
+
+  std::fclose(m_fp);
+  m_fp = nullptr;
+  return !m_write_error;
+}
+
+Player::Player(std::vector<u32> packets, u32 frame_count)
+  : m_packets(std::move(packets)), m_frame_count(frame_count)
+{
+}
+
+std::unique_ptr<Player> Player::Open(const char* filename)
+{
+  std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(filename);
+  if (!data.has_value() || data->size() < (sizeof(u32) * 2) || (data->size() % sizeof(u32)) != 0)
+  {
+    Log_ErrorPrintf("Failed to read GPU dump '%s'", filename);
+    return {};
+  }
+
+  const u32 num_words = static_cast<u32>(data->size() / sizeof(u32)) - 2;
+  u32 header[2];
+  std::memcpy(header, data->data(), sizeof(header));
+  if (header[0] != FILE_SIGNATURE || header[1] != FILE_VERSION)
+  {
+    Log_ErrorPrintf("'%s' is not a GPU dump, or is an unsupported version", filename);
+    return {};
+  }
+
+  std::vector<u32> packets(num_words);
+  std::memcpy(packets.data(), data->data() + sizeof(header), num_words * sizeof(u32));
+
+  // Validate packet sizes up front, and count frames while we're at it.
+  u32 frame_count = 0;
+  for (size_t pos = 0; pos < packets.size();)
+  {
+    const u32 packet_header = packets[pos++];
+    const u32 packet_words = packet_header >> 8;
+    if ((packets.size() - pos) < packet_words)
+    {
+      Log_ErrorPrintf("Truncated packet at word %zu in '%s'", pos - 1, filename);
+      return {};
+    }
+
+    frame_count += BoolToUInt32(static_cast<PacketType>(packet_header & 0xFFu) == PacketType::VSync);
+    pos += packet_words;
+  }
+
+  Log_InfoPrintf("Loaded %u frame GPU dump from '%s'", frame_count, filename);
+  return std::unique_ptr<Player>(new Player(std::move(packets), frame_count));
+}
+
+bool Player::RunFrame()
+{
+  Assert(g_gpu);
+
+  while (m_position < m_packets.size())
+  {
+    const u32 packet_header = m_packets[m_position++];
+    const u32 packet_words = packet_header >> 8;
+    const PacketType type = static_cast<PacketType>(packet_header & 0xFFu);
+    switch (type)
+    {
+      case PacketType::GP0Data:
+        g_gpu->ProcessGPUDumpPacket(&m_packets[m_position], packet_words);
+        break;
+
+      case PacketType::GP1Command:
+        g_gpu->WriteRegister(0x04, m_packets[m_position]);
+        break;
+
+      case PacketType::VSync:
+        return true;
+
+      default:
+        Log_ErrorPrintf("Unknown packet type %u, stopping replay", static_cast<u32>(type));
+        m_position = m_packets.size();
+        return false;
+    }
+
+    m_position += packet_words;
+  }
+
+  return false;
+}
+
+} // namespace GPUDump
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "types.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Capture and replay of the raw GP0/GP1 command stream, so renderer backends can be benchmarked
+// and compared on identical workloads (see duckstation-gpubench). A dump starts with a
+// synthesized prefix of commands which recreates the GPU register state and VRAM contents at the
+// point recording began, so playback can start mid-game.
+namespace GPUDump {
+
+// Byte stream is a header followed by a sequence of packets. Each packet is a 32-bit word with
+// the type in the low 8 bits and the number of following payload words in the upper 24 bits.
+// GP0 data packets are runs of words as they were written to GP0/fed via DMA; consecutive GP0
+// packets form one continuous stream, so a command may span packet boundaries.
+static constexpr u32 FILE_SIGNATURE = 0x50444753; // 'SGDP'
+static constexpr u32 FILE_VERSION = 1;
+static constexpr u32 MAX_PACKET_WORDS = 0xFFFFFF;
+
+enum class PacketType : u8
+{
+  GP0Data = 0,
+  GP1Command = 1,
+  VSync = 2,
+};
+
+class Recorder
+{
+public:
+  ~Recorder();
+
+  static std::unique_ptr<Recorder> Create(std::string filename);
+
+  ALWAYS_INLINE const std::string& GetFilename() const { return m_filename; }
+
+  /// Appends a single GP0 word. Words are buffered and written out as one packet.
+  void PushGP0Word(u32 value);
+
+  /// Writes a run of GP0 words as a single packet.
+  void WriteGP0Packet(const u32* words, u32 num_words);
+
+  void WriteGP1Command(u32 value);
+  void WriteVSync();
+
+  /// Flushes buffered data to disk. Returns false if any write failed.
+  bool Close();
+
+private:
+  Recorder(std::FILE* fp, std::string filename);
+
+  bool WritePacketHeader(PacketType type, u32 num_words);
+  bool WriteWords(const u32* words, u32 num_words);
+  void FlushGP0Words();
+
+  std::FILE* m_fp;
+  std::string m_filename;
+  std::vector<u32> m_pending_gp0_words;
+  bool m_write_error = false;
+};
+
+class Player
+{
+public:
+  static std::unique_ptr<Player> Open(const char* filename);
+
+  /// Number of vsyncs (i.e. frames) in the stream.
+  ALWAYS_INLINE u32 GetFrameCount() const { return m_frame_count; }
+
+  ALWAYS_INLINE bool IsAtEnd() const { return (m_position >= m_packets.size()); }
+
+  /// Restarts playback from the beginning of the stream.
+  ALWAYS_INLINE void Rewind() { m_position = 0; }
+
+  /// Feeds packets to g_gpu until the next vsync. Returns false if the end of the stream was
+  /// reached without hitting a vsync packet.
+  bool RunFrame();
+
+private:
+  Player(std::vector<u32> packets, u32 frame_count);
+
+  std::vector<u32> m_packets;
+  size_t m_position = 0;
+  u32 m_frame_count = 0;
+};
+
+} // namespace GPUDump
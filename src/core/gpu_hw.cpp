@@ -7,6 +7,7 @@
 #include "gpu_hw_shadergen.h"
 #include "gpu_sw_backend.h"
 #include "host.h"
+#include "perf_stats.h"
 #include "settings.h"
 #include "system.h"
 
@@ -15,15 +16,23 @@
 
 #include "common/align.h"
 #include "common/assert.h"
+#include "common/file_system.h"
 #include "common/log.h"
+#include "common/path.h"
 #include "common/scoped_guard.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 
 #include "IconsFontAwesome5.h"
 #include "imgui.h"
+#include "xxhash.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <sstream>
+#include <thread>
 #include <tuple>
 
 Log_SetChannel(GPU_HW);
@@ -126,8 +135,89 @@ private:
   u32 m_progress;
   u32 m_total;
 };
+
+struct BatchPipelineJob
+{
+  GPUPipeline::GraphicsConfig config;
+  std::unique_ptr<GPUPipeline>* destination;
+};
 } // namespace
 
+static bool CompileBatchPipelineJobs(std::vector<BatchPipelineJob>& jobs, ShaderCompileProgressTracker& progress)
+{
+  static constexpr u32 MAX_COMPILE_THREADS = 8;
+
+  if (jobs.empty())
+    return true;
+
+  const u32 num_threads =
+    g_gpu_device->GetFeatures().threaded_pipeline_creation ?
+      std::min(std::thread::hardware_concurrency(), std::min<u32>(static_cast<u32>(jobs.size()), MAX_COMPILE_THREADS)) :
+      1;
+  if (num_threads <= 1)
+  {
+    for (BatchPipelineJob& job : jobs)
+    {
+      if (!(*job.destination = g_gpu_device->CreatePipeline(job.config)))
+        return false;
+
+      progress.Increment();
+    }
+
+    return true;
+  }
+
+  // All batch pipelines share the same layout and target formats, so one serial compile warms any
+  // per-config caches in the device (e.g. Vulkan render passes), leaving the workers on read-only
+  // or internally-synchronized paths.
+  if (!(*jobs[0].destination = g_gpu_device->CreatePipeline(jobs[0].config)))
+    return false;
+
+  progress.Increment();
+
+  std::atomic<u32> next_job{1};
+  std::atomic<u32> completed_jobs{0};
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads);
+  for (u32 i = 0; i < num_threads; i++)
+  {
+    workers.emplace_back([&jobs, &next_job, &completed_jobs, &failed]() {
+      for (;;)
+      {
+        const u32 index = next_job.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= static_cast<u32>(jobs.size()) || failed.load(std::memory_order_relaxed))
+          break;
+
+        if (!(*jobs[index].destination = g_gpu_device->CreatePipeline(jobs[index].config)))
+          failed.store(true, std::memory_order_release);
+
+        completed_jobs.fetch_add(1, std::memory_order_acq_rel);
+      }
+    });
+  }
+
+  // The loading screen belongs to this thread, so pump progress here instead of from the workers.
+  const u32 total_jobs = static_cast<u32>(jobs.size()) - 1;
+  u32 reported_jobs = 0;
+  while (completed_jobs.load(std::memory_order_acquire) < total_jobs && !failed.load(std::memory_order_acquire))
+  {
+    const u32 done = completed_jobs.load(std::memory_order_acquire);
+    progress.Increment(done - reported_jobs);
+    reported_jobs = done;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  for (std::thread& thread : workers)
+    thread.join();
+
+  if (failed.load(std::memory_order_acquire))
+    return false;
+
+  progress.Increment(total_jobs - reported_jobs);
+  return true;
+}
+
 GPU_HW::GPU_HW() : GPU()
 {
 #ifdef _DEBUG
@@ -137,6 +227,8 @@ GPU_HW::GPU_HW() : GPU()
 
 GPU_HW::~GPU_HW()
 {
+  SavePipelinePrewarmManifest();
+
   if (m_sw_renderer)
   {
     m_sw_renderer->Shutdown();
@@ -242,6 +334,11 @@ void GPU_HW::Reset(bool clear_vram)
     m_sw_renderer->Reset();
 
   m_batch = {};
+  m_batch_spans.clear();
+  m_batch_span_start_index = 0;
+  m_batch_span_rect.SetInvalid();
+  m_batch_span_opaque_rect.SetInvalid();
+  m_vram_upload_cache.clear();
   m_batch_ubo_data = {};
   m_batch_ubo_dirty = true;
   m_current_depth = 1;
@@ -315,6 +412,10 @@ void GPU_HW::UpdateSettings(const Settings& old_settings)
 {
   GPU::UpdateSettings(old_settings);
 
+  // Settings changes can alter what an upload produces (e.g. replacements), so start over.
+  m_vram_upload_cache.clear();
+  ClearVRAMReplacementTextureCache();
+
   const GPUDevice::Features features = g_gpu_device->GetFeatures();
 
   const u8 resolution_scale = Truncate8(CalculateResolutionScale());
@@ -537,6 +638,14 @@ u32 GPU_HW::CalculateResolutionScale() const
     scale = static_cast<u32>(std::clamp<s32>(preferred_scale, 1, max_resolution_scale));
   }
 
+  // Dynamic resolution scaling caps the configured scale. It only applies on top of a fixed
+  // scale, since automatic scaling already tracks the window size.
+  if (g_settings.gpu_dynamic_resolution_scale && g_settings.gpu_resolution_scale != 0 &&
+      m_dynamic_resolution_scale != 0)
+  {
+    scale = std::min<u32>(scale, m_dynamic_resolution_scale);
+  }
+
   if (g_settings.gpu_downsample_mode == GPUDownsampleMode::Adaptive && scale > 1 && !Common::IsPow2(scale))
   {
     const u32 new_scale = Common::PreviousPow2(scale);
@@ -566,6 +675,55 @@ void GPU_HW::UpdateResolutionScale()
     UpdateSettings(g_settings);
 }
 
+void GPU_HW::UpdateDynamicResolutionScale(float average_gpu_time)
+{
+  // Automatic scaling already tracks the window size, dynamic scaling only applies on top of a
+  // fixed scale.
+  if (!g_settings.gpu_dynamic_resolution_scale || g_settings.gpu_resolution_scale == 0)
+    return;
+
+  const u32 max_scale = std::min<u32>(g_settings.gpu_resolution_scale, GetMaxResolutionScale());
+  const u32 min_scale = std::clamp<u32>(g_settings.gpu_dynamic_resolution_min_scale, 1, max_scale);
+  const u32 current = (m_dynamic_resolution_scale != 0) ?
+                        std::clamp<u32>(m_dynamic_resolution_scale, min_scale, max_scale) :
+                        max_scale;
+  const float budget_ms = 1000.0f / ComputeVerticalFrequency();
+
+  u32 new_scale = current;
+  if (average_gpu_time > (budget_ms * 0.85f))
+  {
+    // over budget, step down immediately so we stop dropping frames
+    new_scale = std::max<u32>(current - 1, min_scale);
+    m_dynamic_resolution_streak = 0;
+  }
+  else if (current < max_scale &&
+           (average_gpu_time * (static_cast<float>((current + 1) * (current + 1)) /
+                                static_cast<float>(current * current))) <= (budget_ms * 0.75f))
+  {
+    // fill rate grows with the square of the scale, so only step up when the next scale is
+    // predicted to still fit the budget, and only after a few consecutive quiet intervals
+    if (++m_dynamic_resolution_streak >= 3)
+    {
+      new_scale = current + 1;
+      m_dynamic_resolution_streak = 0;
+    }
+  }
+  else
+  {
+    m_dynamic_resolution_streak = 0;
+  }
+
+  if (new_scale == current && m_dynamic_resolution_scale != 0)
+    return;
+
+  m_dynamic_resolution_scale = Truncate8(new_scale);
+
+  // Same deferred rebuild as UpdateResolutionScale(). This runs from the performance counter
+  // update between frames, so the render targets are rebuilt at a safe point.
+  if (CalculateResolutionScale() != m_resolution_scale)
+    UpdateSettings(g_settings);
+}
+
 GPUDownsampleMode GPU_HW::GetDownsampleMode(u32 resolution_scale) const
 {
   return (resolution_scale == 1) ? GPUDownsampleMode::Disabled : g_settings.gpu_downsample_mode;
@@ -656,22 +814,29 @@ bool GPU_HW::CreateBuffers()
   if (g_gpu_device->GetFeatures().memory_import)
   {
     Log_DevPrint("Trying to import guest VRAM buffer for downloads...");
-    m_vram_readback_download_texture = g_gpu_device->CreateDownloadTexture(
+    m_vram_readback_download_textures[0] = g_gpu_device->CreateDownloadTexture(
       m_vram_readback_texture->GetWidth(), m_vram_readback_texture->GetHeight(), m_vram_readback_texture->GetFormat(),
       g_vram, sizeof(g_vram), VRAM_WIDTH * sizeof(u16));
-    if (!m_vram_readback_download_texture)
+    if (!m_vram_readback_download_textures[0])
       Log_ErrorPrint("Failed to create imported readback buffer");
   }
-  if (!m_vram_readback_download_texture)
+  if (!m_vram_readback_download_textures[0])
   {
-    m_vram_readback_download_texture = g_gpu_device->CreateDownloadTexture(
-      m_vram_readback_texture->GetWidth(), m_vram_readback_texture->GetHeight(), m_vram_readback_texture->GetFormat());
-    if (!m_vram_readback_download_texture)
+    // Double-buffered staging, so back-to-back readbacks don't have to wait on the first fence.
+    for (u32 i = 0; i < NUM_VRAM_READBACK_BUFFERS; i++)
     {
-      Log_ErrorPrint("Failed to create readback download texture");
-      return false;
+      m_vram_readback_download_textures[i] = g_gpu_device->CreateDownloadTexture(
+        m_vram_readback_texture->GetWidth(), m_vram_readback_texture->GetHeight(), m_vram_readback_texture->GetFormat());
+      if (!m_vram_readback_download_textures[i])
+      {
+        Log_ErrorPrint("Failed to create readback download texture");
+        return false;
+      }
     }
   }
+  for (Common::Rectangle<u32>& rect : m_pending_vram_readback_rects)
+    rect.SetInvalid();
+  m_vram_readback_buffer_index = 0;
 
   if (g_gpu_device->GetFeatures().supports_texture_buffers)
   {
@@ -701,6 +866,7 @@ void GPU_HW::ClearFramebuffer()
   g_gpu_device->ClearRenderTarget(m_vram_texture.get(), 0);
   g_gpu_device->ClearDepth(m_vram_depth_texture.get(), m_pgxp_depth_buffer ? 1.0f : 0.0f);
   ClearVRAMDirtyRectangle();
+  m_vram_upload_cache.clear();
 
   if (m_display_private_texture)
     g_gpu_device->ClearRenderTarget(m_display_private_texture.get(), 0);
@@ -716,8 +882,13 @@ void GPU_HW::DestroyBuffers()
   if (m_batch_vertex_ptr)
     UnmapGPUBuffer(0, 0);
 
+  // Complete any in-flight readback first, otherwise the VRAM backup taken by our callers would be stale.
+  FinishVRAMReadback();
+
   m_vram_upload_buffer.reset();
-  m_vram_readback_download_texture.reset();
+  for (std::unique_ptr<GPUDownloadTexture>& tex : m_vram_readback_download_textures)
+    tex.reset();
+  ClearVRAMReplacementTextureCache();
   g_gpu_device->RecycleTexture(std::move(m_downsample_texture));
   g_gpu_device->RecycleTexture(std::move(m_vram_read_texture));
   g_gpu_device->RecycleTexture(std::move(m_vram_depth_texture));
@@ -728,6 +899,12 @@ void GPU_HW::DestroyBuffers()
 
 bool GPU_HW::CompilePipelines()
 {
+  PerfStats::StallScope stall_scope(PerfStats::StallSource::ShaderCompile);
+
+  // Permutations used this session get compiled eagerly on a settings-change recompile too.
+  LoadPipelinePrewarmManifest();
+  m_prewarm_manifest_pipelines |= m_used_batch_pipelines;
+
   const GPUDevice::Features features = g_gpu_device->GetFeatures();
   GPU_HW_ShaderGen shadergen(g_gpu_device->GetRenderAPI(), m_resolution_scale, m_multisamples, m_per_sample_shading,
                              m_true_color, m_scaled_dithering, m_texture_filtering, m_clamp_uvs, m_pgxp_depth_buffer,
@@ -756,6 +933,9 @@ bool GPU_HW::CompilePipelines()
     progress.Increment();
   }
 
+  std::vector<std::pair<std::string, std::unique_ptr<GPUShader>*>> batch_fragment_shader_jobs;
+  batch_fragment_shader_jobs.reserve(4 * 5 * 9 * 2 * 2);
+
   for (u8 render_mode = 0; render_mode < 4; render_mode++)
   {
     for (u8 transparency_mode = 0; transparency_mode < 5; transparency_mode++)
@@ -786,39 +966,45 @@ bool GPU_HW::CompilePipelines()
         {
           for (u8 interlacing = 0; interlacing < 2; interlacing++)
           {
-            const std::string fs = shadergen.GenerateBatchFragmentShader(
-              static_cast<BatchRenderMode>(render_mode), static_cast<GPUTransparencyMode>(transparency_mode),
-              static_cast<GPUTextureMode>(texture_mode), ConvertToBoolUnchecked(dithering),
-              ConvertToBoolUnchecked(interlacing));
-
-            if (!(batch_fragment_shaders[render_mode][transparency_mode][texture_mode][dithering][interlacing] =
-                    g_gpu_device->CreateShader(GPUShaderStage::Fragment, fs)))
-            {
-              return false;
-            }
-
-            progress.Increment();
+            batch_fragment_shader_jobs.emplace_back(
+              shadergen.GenerateBatchFragmentShader(
+                static_cast<BatchRenderMode>(render_mode), static_cast<GPUTransparencyMode>(transparency_mode),
+                static_cast<GPUTextureMode>(texture_mode), ConvertToBoolUnchecked(dithering),
+                ConvertToBoolUnchecked(interlacing)),
+              &batch_fragment_shaders[render_mode][transparency_mode][texture_mode][dithering][interlacing]);
           }
         }
       }
     }
   }
 
-  static constexpr GPUPipeline::VertexAttribute vertex_attributes[] = {
-    GPUPipeline::VertexAttribute::Make(0, GPUPipeline::VertexAttribute::Semantic::Position, 0,
-                                       GPUPipeline::VertexAttribute::Type::Float, 4, offsetof(BatchVertex, x)),
-    GPUPipeline::VertexAttribute::Make(1, GPUPipeline::VertexAttribute::Semantic::Color, 0,
-                                       GPUPipeline::VertexAttribute::Type::UNorm8, 4, offsetof(BatchVertex, color)),
-    GPUPipeline::VertexAttribute::Make(2, GPUPipeline::VertexAttribute::Semantic::TexCoord, 0,
-                                       GPUPipeline::VertexAttribute::Type::UInt32, 1, offsetof(BatchVertex, u)),
-    GPUPipeline::VertexAttribute::Make(3, GPUPipeline::VertexAttribute::Semantic::TexCoord, 1,
-                                       GPUPipeline::VertexAttribute::Type::UInt32, 1, offsetof(BatchVertex, texpage)),
-    GPUPipeline::VertexAttribute::Make(4, GPUPipeline::VertexAttribute::Semantic::TexCoord, 2,
-                                       GPUPipeline::VertexAttribute::Type::UNorm8, 4, offsetof(BatchVertex, uv_limits)),
-  };
-  static constexpr u32 NUM_BATCH_VERTEX_ATTRIBUTES = 2;
-  static constexpr u32 NUM_BATCH_TEXTURED_VERTEX_ATTRIBUTES = 4;
-  static constexpr u32 NUM_BATCH_TEXTURED_LIMITS_VERTEX_ATTRIBUTES = 5;
+  // The variants are independent, so translate them on the worker pool when the backend can
+  // create shaders from multiple threads. The shared shader cache and glslang are both safe
+  // for concurrent use.
+  if (g_gpu_device->GetFeatures().threaded_pipeline_creation && batch_fragment_shader_jobs.size() > 1)
+  {
+    std::atomic<bool> failed{false};
+    Threading::ThreadPool::ParallelFor(
+      static_cast<u32>(batch_fragment_shader_jobs.size()), [&batch_fragment_shader_jobs, &failed](u32 index) {
+        auto& [source, destination] = batch_fragment_shader_jobs[index];
+        if (!(*destination = g_gpu_device->CreateShader(GPUShaderStage::Fragment, source)))
+          failed.store(true, std::memory_order_release);
+      });
+    if (failed.load(std::memory_order_acquire))
+      return false;
+
+    progress.Increment(static_cast<u32>(batch_fragment_shader_jobs.size()));
+  }
+  else
+  {
+    for (auto& [source, destination] : batch_fragment_shader_jobs)
+    {
+      if (!(*destination = g_gpu_device->CreateShader(GPUShaderStage::Fragment, source)))
+        return false;
+
+      progress.Increment();
+    }
+  }
 
   GPUPipeline::GraphicsConfig plconfig = {};
   plconfig.layout = GPUPipeline::Layout::SingleTextureAndUBO;
@@ -830,6 +1016,11 @@ bool GPU_HW::CompilePipelines()
   plconfig.per_sample_shading = m_per_sample_shading;
   plconfig.geometry_shader = nullptr;
 
+  // Batch pipeline configs are collected up front and compiled in one go at the end, so the work
+  // can be spread across threads on devices which support it.
+  std::vector<BatchPipelineJob> batch_pipeline_jobs;
+  batch_pipeline_jobs.reserve(3 * 4 * 5 * 9 * 2 * 2);
+
   // [depth_test][render_mode][texture_mode][transparency_mode][dithering][interlacing]
   for (u8 depth_test = 0; depth_test < 3; depth_test++)
   {
@@ -854,87 +1045,32 @@ bool GPU_HW::CompilePipelines()
           {
             for (u8 interlacing = 0; interlacing < 2; interlacing++)
             {
-              static constexpr std::array<GPUPipeline::DepthFunc, 3> depth_test_values = {
-                GPUPipeline::DepthFunc::Always, GPUPipeline::DepthFunc::GreaterEqual,
-                GPUPipeline::DepthFunc::LessEqual};
+              if (m_prewarm_manifest_valid &&
+                  !m_prewarm_manifest_pipelines[GetBatchPipelinePermutationIndex(
+                    depth_test, render_mode, texture_mode, transparency_mode, dithering, interlacing)])
+              {
+                // Not in the manifest, compiled on demand if the game ever uses it.
+                progress.Increment();
+                continue;
+              }
+
               const bool textured = (static_cast<GPUTextureMode>(texture_mode) != GPUTextureMode::Disabled);
               const bool use_shader_blending =
                 (textured && NeedsShaderBlending(static_cast<GPUTransparencyMode>(transparency_mode)));
 
-              plconfig.input_layout.vertex_attributes =
-                textured ?
-                  (m_clamp_uvs ? std::span<const GPUPipeline::VertexAttribute>(
-                                   vertex_attributes, NUM_BATCH_TEXTURED_LIMITS_VERTEX_ATTRIBUTES) :
-                                 std::span<const GPUPipeline::VertexAttribute>(vertex_attributes,
-                                                                               NUM_BATCH_TEXTURED_VERTEX_ATTRIBUTES)) :
-                  std::span<const GPUPipeline::VertexAttribute>(vertex_attributes, NUM_BATCH_VERTEX_ATTRIBUTES);
-
-              plconfig.vertex_shader = batch_vertex_shaders[BoolToUInt8(textured)].get();
-              plconfig.fragment_shader =
+              GPUShader* fragment_shader =
                 batch_fragment_shaders[render_mode]
                                       [use_shader_blending ? transparency_mode :
                                                              static_cast<u8>(GPUTransparencyMode::Disabled)]
                                       [texture_mode][dithering][interlacing]
                                         .get();
 
-              plconfig.depth.depth_test = depth_test_values[depth_test];
-              plconfig.depth.depth_write = !m_pgxp_depth_buffer || depth_test != 0;
-              plconfig.blend = GPUPipeline::BlendState::GetNoBlendingState();
-
-              if (!use_shader_blending &&
-                  ((static_cast<GPUTransparencyMode>(transparency_mode) != GPUTransparencyMode::Disabled &&
-                    (static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::TransparencyDisabled &&
-                     static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::OnlyOpaque)) ||
-                   (textured && IsBlendedTextureFiltering(m_texture_filtering))))
-              {
-                plconfig.blend.enable = true;
-                plconfig.blend.src_alpha_blend = GPUPipeline::BlendFunc::One;
-                plconfig.blend.dst_alpha_blend = GPUPipeline::BlendFunc::Zero;
-                plconfig.blend.alpha_blend_op = GPUPipeline::BlendOp::Add;
-
-                if (m_supports_dual_source_blend)
-                {
-                  plconfig.blend.src_blend = GPUPipeline::BlendFunc::One;
-                  plconfig.blend.dst_blend = GPUPipeline::BlendFunc::SrcAlpha1;
-                  plconfig.blend.blend_op =
-                    (static_cast<GPUTransparencyMode>(transparency_mode) ==
-                       GPUTransparencyMode::BackgroundMinusForeground &&
-                     static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::TransparencyDisabled &&
-                     static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::OnlyOpaque) ?
-                      GPUPipeline::BlendOp::ReverseSubtract :
-                      GPUPipeline::BlendOp::Add;
-                }
-                else
-                {
-                  // TODO: This isn't entirely accurate, 127.5 versus 128.
-                  // But if we use fbfetch on Mali, it doesn't matter.
-                  plconfig.blend.src_blend = GPUPipeline::BlendFunc::One;
-                  plconfig.blend.dst_blend = GPUPipeline::BlendFunc::One;
-                  if (static_cast<GPUTransparencyMode>(transparency_mode) ==
-                      GPUTransparencyMode::HalfBackgroundPlusHalfForeground)
-                  {
-                    plconfig.blend.dst_blend = GPUPipeline::BlendFunc::ConstantColor;
-                    plconfig.blend.dst_alpha_blend = GPUPipeline::BlendFunc::ConstantColor;
-                    plconfig.blend.constant = 0x00808080u;
-                  }
-
-                  plconfig.blend.blend_op =
-                    (static_cast<GPUTransparencyMode>(transparency_mode) ==
-                       GPUTransparencyMode::BackgroundMinusForeground &&
-                     static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::TransparencyDisabled &&
-                     static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::OnlyOpaque) ?
-                      GPUPipeline::BlendOp::ReverseSubtract :
-                      GPUPipeline::BlendOp::Add;
-                }
-              }
-
-              if (!(m_batch_pipelines[depth_test][render_mode][texture_mode][transparency_mode][dithering]
-                                     [interlacing] = g_gpu_device->CreatePipeline(plconfig)))
-              {
-                return false;
-              }
-
-              progress.Increment();
+              batch_pipeline_jobs.push_back(
+                BatchPipelineJob{GetBatchPipelineConfig(batch_vertex_shaders[BoolToUInt8(textured)].get(),
+                                                        fragment_shader, depth_test, render_mode, texture_mode,
+                                                        transparency_mode),
+                                 &m_batch_pipelines[depth_test][render_mode][texture_mode][transparency_mode][dithering]
+                                                   [interlacing]});
             }
           }
         }
@@ -942,6 +1078,9 @@ bool GPU_HW::CompilePipelines()
     }
   }
 
+  if (!CompileBatchPipelineJobs(batch_pipeline_jobs, progress))
+    return false;
+
   if (m_wireframe_mode != GPUWireframeMode::Disabled)
   {
     std::unique_ptr<GPUShader> gs =
@@ -955,7 +1094,7 @@ bool GPU_HW::CompilePipelines()
     GL_OBJECT_NAME(fs, "Batch Wireframe Fragment Shader");
 
     plconfig.input_layout.vertex_attributes =
-      std::span<const GPUPipeline::VertexAttribute>(vertex_attributes, NUM_BATCH_VERTEX_ATTRIBUTES);
+      std::span<const GPUPipeline::VertexAttribute>(BATCH_VERTEX_ATTRIBUTES, NUM_BATCH_VERTEX_ATTRIBUTES);
     plconfig.blend = (m_wireframe_mode == GPUWireframeMode::OverlayWireframe) ?
                        GPUPipeline::BlendState::GetAlphaBlendingState() :
                        GPUPipeline::BlendState::GetNoBlendingState();
@@ -1255,12 +1394,209 @@ void GPU_HW::DestroyPipelines()
   m_display_pipelines.enumerate(destroy);
 }
 
+GPUPipeline::GraphicsConfig GPU_HW::GetBatchPipelineConfig(GPUShader* vertex_shader, GPUShader* fragment_shader,
+                                                           u8 depth_test, u8 render_mode, u8 texture_mode,
+                                                           u8 transparency_mode) const
+{
+  static constexpr std::array<GPUPipeline::DepthFunc, 3> depth_test_values = {
+    GPUPipeline::DepthFunc::Always, GPUPipeline::DepthFunc::GreaterEqual, GPUPipeline::DepthFunc::LessEqual};
+
+  const bool textured = (static_cast<GPUTextureMode>(texture_mode) != GPUTextureMode::Disabled);
+  const bool use_shader_blending =
+    (textured && NeedsShaderBlending(static_cast<GPUTransparencyMode>(transparency_mode)));
+
+  GPUPipeline::GraphicsConfig plconfig = {};
+  plconfig.layout = GPUPipeline::Layout::SingleTextureAndUBO;
+  plconfig.input_layout.vertex_stride = sizeof(BatchVertex);
+  plconfig.rasterization = GPUPipeline::RasterizationState::GetNoCullState();
+  plconfig.primitive = GPUPipeline::Primitive::Triangles;
+  plconfig.SetTargetFormats(VRAM_RT_FORMAT, VRAM_DS_FORMAT);
+  plconfig.samples = m_multisamples;
+  plconfig.per_sample_shading = m_per_sample_shading;
+  plconfig.geometry_shader = nullptr;
+
+  plconfig.input_layout.vertex_attributes =
+    textured ? (m_clamp_uvs ? std::span<const GPUPipeline::VertexAttribute>(
+                                BATCH_VERTEX_ATTRIBUTES, NUM_BATCH_TEXTURED_LIMITS_VERTEX_ATTRIBUTES) :
+                              std::span<const GPUPipeline::VertexAttribute>(BATCH_VERTEX_ATTRIBUTES,
+                                                                            NUM_BATCH_TEXTURED_VERTEX_ATTRIBUTES)) :
+               std::span<const GPUPipeline::VertexAttribute>(BATCH_VERTEX_ATTRIBUTES, NUM_BATCH_VERTEX_ATTRIBUTES);
+
+  plconfig.vertex_shader = vertex_shader;
+  plconfig.fragment_shader = fragment_shader;
+
+  plconfig.depth.depth_test = depth_test_values[depth_test];
+  plconfig.depth.depth_write = !m_pgxp_depth_buffer || depth_test != 0;
+  plconfig.blend = GPUPipeline::BlendState::GetNoBlendingState();
+
+  if (!use_shader_blending &&
+      ((static_cast<GPUTransparencyMode>(transparency_mode) != GPUTransparencyMode::Disabled &&
+        (static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::TransparencyDisabled &&
+         static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::OnlyOpaque)) ||
+       (textured && IsBlendedTextureFiltering(m_texture_filtering))))
+  {
+    plconfig.blend.enable = true;
+    plconfig.blend.src_alpha_blend = GPUPipeline::BlendFunc::One;
+    plconfig.blend.dst_alpha_blend = GPUPipeline::BlendFunc::Zero;
+    plconfig.blend.alpha_blend_op = GPUPipeline::BlendOp::Add;
+
+    if (m_supports_dual_source_blend)
+    {
+      plconfig.blend.src_blend = GPUPipeline::BlendFunc::One;
+      plconfig.blend.dst_blend = GPUPipeline::BlendFunc::SrcAlpha1;
+      plconfig.blend.blend_op =
+        (static_cast<GPUTransparencyMode>(transparency_mode) == GPUTransparencyMode::BackgroundMinusForeground &&
+         static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::TransparencyDisabled &&
+         static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::OnlyOpaque) ?
+          GPUPipeline::BlendOp::ReverseSubtract :
+          GPUPipeline::BlendOp::Add;
+    }
+    else
+    {
+      // TODO: This isn't entirely accurate, 127.5 versus 128.
+      // But if we use fbfetch on Mali, it doesn't matter.
+      plconfig.blend.src_blend = GPUPipeline::BlendFunc::One;
+      plconfig.blend.dst_blend = GPUPipeline::BlendFunc::One;
+      if (static_cast<GPUTransparencyMode>(transparency_mode) == GPUTransparencyMode::HalfBackgroundPlusHalfForeground)
+      {
+        plconfig.blend.dst_blend = GPUPipeline::BlendFunc::ConstantColor;
+        plconfig.blend.dst_alpha_blend = GPUPipeline::BlendFunc::ConstantColor;
+        plconfig.blend.constant = 0x00808080u;
+      }
+
+      plconfig.blend.blend_op =
+        (static_cast<GPUTransparencyMode>(transparency_mode) == GPUTransparencyMode::BackgroundMinusForeground &&
+         static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::TransparencyDisabled &&
+         static_cast<BatchRenderMode>(render_mode) != BatchRenderMode::OnlyOpaque) ?
+          GPUPipeline::BlendOp::ReverseSubtract :
+          GPUPipeline::BlendOp::Add;
+    }
+  }
+
+  return plconfig;
+}
+
+bool GPU_HW::CompileMissingBatchPipeline(u8 depth_test, u8 render_mode, u8 texture_mode, u8 transparency_mode,
+                                         u8 dithering, u8 interlacing)
+{
+  GPU_HW_ShaderGen shadergen(g_gpu_device->GetRenderAPI(), m_resolution_scale, m_multisamples, m_per_sample_shading,
+                             m_true_color, m_scaled_dithering, m_texture_filtering, m_clamp_uvs, m_pgxp_depth_buffer,
+                             m_disable_color_perspective, m_supports_dual_source_blend, m_supports_framebuffer_fetch,
+                             m_debanding);
+
+  const bool textured = (static_cast<GPUTextureMode>(texture_mode) != GPUTextureMode::Disabled);
+  const bool use_shader_blending =
+    (textured && NeedsShaderBlending(static_cast<GPUTransparencyMode>(transparency_mode)));
+  const u8 shader_transparency_mode =
+    use_shader_blending ? transparency_mode : static_cast<u8>(GPUTransparencyMode::Disabled);
+
+  std::unique_ptr<GPUShader> vs =
+    g_gpu_device->CreateShader(GPUShaderStage::Vertex, shadergen.GenerateBatchVertexShader(textured));
+  std::unique_ptr<GPUShader> fs = g_gpu_device->CreateShader(
+    GPUShaderStage::Fragment,
+    shadergen.GenerateBatchFragmentShader(
+      static_cast<BatchRenderMode>(render_mode), static_cast<GPUTransparencyMode>(shader_transparency_mode),
+      static_cast<GPUTextureMode>(texture_mode), ConvertToBoolUnchecked(dithering),
+      ConvertToBoolUnchecked(interlacing)));
+  if (!vs || !fs)
+    return false;
+
+  std::unique_ptr<GPUPipeline>& pipeline =
+    m_batch_pipelines[depth_test][render_mode][texture_mode][transparency_mode][dithering][interlacing];
+  if (!(pipeline = g_gpu_device->CreatePipeline(
+          GetBatchPipelineConfig(vs.get(), fs.get(), depth_test, render_mode, texture_mode, transparency_mode))))
+  {
+    Log_ErrorPrintf("Failed to compile batch pipeline [%u][%u][%u][%u][%u][%u]", depth_test, render_mode, texture_mode,
+                    transparency_mode, dithering, interlacing);
+    return false;
+  }
+
+  Log_DevPrintf("Compiled batch pipeline [%u][%u][%u][%u][%u][%u] missing from prewarm manifest", depth_test,
+                render_mode, texture_mode, transparency_mode, dithering, interlacing);
+  return true;
+}
+
+std::string GPU_HW::GetPipelinePrewarmManifestPath(const std::string& serial)
+{
+  return Path::Combine(EmuFolders::Cache, fmt::format("prewarm" FS_OSPATH_SEPARATOR_STR "{}.txt", serial));
+}
+
+void GPU_HW::LoadPipelinePrewarmManifest()
+{
+  m_prewarm_manifest_pipelines.reset();
+  m_prewarm_manifest_valid = false;
+
+  const std::string& serial = System::GetGameSerial();
+  if (serial.empty())
+    return;
+
+  const std::string path = GetPipelinePrewarmManifestPath(serial);
+  const std::optional<std::string> data = FileSystem::ReadFileToString(path.c_str());
+  if (!data.has_value())
+    return;
+
+  u32 count = 0;
+  for (const std::string_view& line : StringUtil::SplitString(data.value(), '\n', true))
+  {
+    const std::optional<u32> index = StringUtil::FromChars<u32>(StringUtil::StripWhitespace(line));
+    if (!index.has_value() || index.value() >= NUM_BATCH_PIPELINE_PERMUTATIONS)
+    {
+      Log_ErrorPrintf("Invalid entry in pipeline prewarm manifest '%s', ignoring it", path.c_str());
+      m_prewarm_manifest_pipelines.reset();
+      return;
+    }
+
+    m_prewarm_manifest_pipelines.set(index.value());
+    count++;
+  }
+
+  if (count == 0)
+    return;
+
+  Log_InfoPrintf("Prewarming %u batch pipeline permutations from '%s'", count, path.c_str());
+  m_prewarm_manifest_valid = true;
+}
+
+void GPU_HW::SavePipelinePrewarmManifest()
+{
+  const std::string& serial = System::GetGameSerial();
+  if (serial.empty() || m_used_batch_pipelines.none())
+    return;
+
+  // Merge into whatever was loaded, and skip the write when nothing new was used.
+  const auto merged = m_prewarm_manifest_pipelines | m_used_batch_pipelines;
+  if (m_prewarm_manifest_valid && merged == m_prewarm_manifest_pipelines)
+    return;
+
+  std::string data;
+  for (u32 i = 0; i < NUM_BATCH_PIPELINE_PERMUTATIONS; i++)
+  {
+    if (merged[i])
+      data += fmt::format("{}\n", i);
+  }
+
+  const std::string path = GetPipelinePrewarmManifestPath(serial);
+  if (!FileSystem::WriteStringToFile(path.c_str(), data))
+    Log_ErrorPrintf("Failed to write pipeline prewarm manifest '%s'", path.c_str());
+  else
+    Log_InfoPrintf("Saved pipeline prewarm manifest '%s' with %zu permutations", path.c_str(), merged.count());
+}
+
 GPU_HW::BatchRenderMode GPU_HW::BatchConfig::GetRenderMode() const
 {
   return transparency_mode == GPUTransparencyMode::Disabled ? BatchRenderMode::TransparencyDisabled :
                                                               BatchRenderMode::TransparentAndOpaque;
 }
 
+bool GPU_HW::BatchConfig::UsesSamePipelines(const BatchConfig& rhs) const
+{
+  // set_mask_while_drawing is UBO state rather than part of the pipeline key, and is guaranteed
+  // constant across a batch by CanDeferBatchStateChange().
+  return (texture_mode == rhs.texture_mode && transparency_mode == rhs.transparency_mode &&
+          dithering == rhs.dithering && interlacing == rhs.interlacing &&
+          check_mask_before_draw == rhs.check_mask_before_draw && use_depth_buffer == rhs.use_depth_buffer);
+}
+
 void GPU_HW::UpdateVRAMReadTexture(bool drawn, bool written)
 {
   GL_SCOPE("UpdateVRAMReadTexture()");
@@ -1393,17 +1729,33 @@ void GPU_HW::UnmapGPUBuffer(u32 used_vertices, u32 used_indices)
   m_batch_index_ptr = nullptr;
   m_batch_index_count = 0;
   m_batch_index_space = 0;
+  m_batch_span_start_index = 0;
 }
 
-ALWAYS_INLINE_RELEASE void GPU_HW::DrawBatchVertices(BatchRenderMode render_mode, u32 num_indices, u32 base_index,
-                                                     u32 base_vertex)
+ALWAYS_INLINE_RELEASE void GPU_HW::DrawBatchVertices(const BatchConfig& config, BatchRenderMode render_mode,
+                                                     u32 num_indices, u32 base_index, u32 base_vertex)
 {
   // [depth_test][render_mode][texture_mode][transparency_mode][dithering][interlacing]
-  const u8 depth_test = m_batch.use_depth_buffer ? static_cast<u8>(2) : BoolToUInt8(m_batch.check_mask_before_draw);
-  g_gpu_device->SetPipeline(
-    m_batch_pipelines[depth_test][static_cast<u8>(render_mode)][static_cast<u8>(m_batch.texture_mode)][static_cast<u8>(
-      m_batch.transparency_mode)][BoolToUInt8(m_batch.dithering)][BoolToUInt8(m_batch.interlacing)]
-      .get());
+  const u8 depth_test = config.use_depth_buffer ? static_cast<u8>(2) : BoolToUInt8(config.check_mask_before_draw);
+  const u8 texture_mode = static_cast<u8>(config.texture_mode);
+  const u8 transparency_mode = static_cast<u8>(config.transparency_mode);
+  const u8 dithering = BoolToUInt8(config.dithering);
+  const u8 interlacing = BoolToUInt8(config.interlacing);
+  m_used_batch_pipelines.set(GetBatchPipelinePermutationIndex(depth_test, static_cast<u8>(render_mode), texture_mode,
+                                                              transparency_mode, dithering, interlacing));
+
+  std::unique_ptr<GPUPipeline>& pipeline =
+    m_batch_pipelines[depth_test][static_cast<u8>(render_mode)][texture_mode][transparency_mode][dithering]
+                     [interlacing];
+  if (!pipeline) [[unlikely]]
+  {
+    // Permutation wasn't in the prewarm manifest, it'll be in there next boot.
+    if (!CompileMissingBatchPipeline(depth_test, static_cast<u8>(render_mode), texture_mode, transparency_mode,
+                                     dithering, interlacing))
+      return;
+  }
+
+  g_gpu_device->SetPipeline(pipeline.get());
   g_gpu_device->DrawIndexed(num_indices, base_index, base_vertex);
 }
 
@@ -1697,8 +2049,16 @@ void GPU_HW::SetBatchDepthBuffer(bool enabled)
 
   if (m_batch_index_count > 0)
   {
-    FlushRender();
-    EnsureVertexBufferSpaceForCurrentCommand();
+    // The depth test is part of the pipeline key, so this can usually be deferred to a span.
+    if (CanDeferBatchStateChange())
+    {
+      CloseBatchSpan();
+    }
+    else
+    {
+      FlushRender();
+      EnsureVertexBufferSpaceForCurrentCommand();
+    }
   }
 
   m_batch.use_depth_buffer = enabled;
@@ -1950,6 +2310,7 @@ void GPU_HW::LoadVertices()
           static_cast<u32>(std::clamp<s32>(max_y, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
         m_vram_dirty_draw_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+        m_batch_span_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
         AddDrawTriangleTicks(native_vertex_positions[0][0], native_vertex_positions[0][1],
                              native_vertex_positions[1][0], native_vertex_positions[1][1],
                              native_vertex_positions[2][0], native_vertex_positions[2][1], rc.shading_enable,
@@ -1988,6 +2349,7 @@ void GPU_HW::LoadVertices()
             static_cast<u32>(std::clamp<s32>(max_y_123, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
           m_vram_dirty_draw_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+          m_batch_span_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
           AddDrawTriangleTicks(native_vertex_positions[2][0], native_vertex_positions[2][1],
                                native_vertex_positions[1][0], native_vertex_positions[1][1],
                                native_vertex_positions[3][0], native_vertex_positions[3][1], rc.shading_enable,
@@ -2134,8 +2496,28 @@ void GPU_HW::LoadVertices()
         static_cast<u32>(std::clamp<s32>(pos_y + rectangle_height, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
       m_vram_dirty_draw_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+      m_batch_span_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
       AddDrawRectangleTicks(clip_right - clip_left, clip_bottom - clip_top, rc.texture_enable, rc.transparency_enable);
 
+      // A solid opaque rectangle covers its clipped rect entirely, which makes it an occlusion
+      // candidate for CullOccludedBatchSpans(). Textured rectangles never qualify, since any texel
+      // can be transparent. The intersection test guards against primitives outside the drawing
+      // area, where the clamped rect above names pixels that are never written.
+      if (!rc.texture_enable && !rc.transparency_enable && !m_batch.check_mask_before_draw &&
+          !m_batch.use_depth_buffer && !m_batch.interlacing && pos_x <= static_cast<s32>(m_drawing_area.right) &&
+          (pos_x + rectangle_width) > static_cast<s32>(m_drawing_area.left) &&
+          pos_y <= static_cast<s32>(m_drawing_area.bottom) &&
+          (pos_y + rectangle_height) > static_cast<s32>(m_drawing_area.top))
+      {
+        const Common::Rectangle<u32> rect(clip_left, clip_top, clip_right, clip_bottom);
+        if (!m_batch_span_opaque_rect.Valid() ||
+            (rect.GetWidth() * rect.GetHeight()) >
+              (m_batch_span_opaque_rect.GetWidth() * m_batch_span_opaque_rect.GetHeight()))
+        {
+          m_batch_span_opaque_rect = rect;
+        }
+      }
+
       if (m_sw_renderer)
       {
         GPUBackendDrawRectangleCommand* cmd = m_sw_renderer->NewDrawRectangleCommand();
@@ -2197,6 +2579,7 @@ void GPU_HW::LoadVertices()
           static_cast<u32>(std::clamp<s32>(max_y, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
         m_vram_dirty_draw_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+        m_batch_span_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
         AddDrawLineTicks(clip_right - clip_left, clip_bottom - clip_top, rc.shading_enable);
 
         // TODO: Should we do a PGXP lookup here? Most lines are 2D.
@@ -2264,6 +2647,7 @@ void GPU_HW::LoadVertices()
               static_cast<u32>(std::clamp<s32>(max_y, m_drawing_area.top, m_drawing_area.bottom)) + 1u;
 
             m_vram_dirty_draw_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
+            m_batch_span_rect.Include(clip_left, clip_right, clip_top, clip_bottom);
             AddDrawLineTicks(clip_right - clip_left, clip_bottom - clip_top, rc.shading_enable);
 
             // TODO: Should we do a PGXP lookup here? Most lines are 2D.
@@ -2291,39 +2675,65 @@ void GPU_HW::LoadVertices()
   }
 }
 
-bool GPU_HW::BlitVRAMReplacementTexture(const TextureReplacementTexture* tex, u32 dst_x, u32 dst_y, u32 width,
-                                        u32 height)
+GPUTexture* GPU_HW::GetVRAMReplacementTexture(const TextureReplacementHash& hash, const TextureReplacementTexture* tex)
 {
-  if (!m_vram_replacement_texture || m_vram_replacement_texture->GetWidth() < tex->GetWidth() ||
-      m_vram_replacement_texture->GetHeight() < tex->GetHeight() || g_gpu_device->GetFeatures().prefer_unused_textures)
+  const auto it = m_vram_replacement_texture_cache.find(hash);
+  if (it != m_vram_replacement_texture_cache.end())
   {
-    g_gpu_device->RecycleTexture(std::move(m_vram_replacement_texture));
-
-    if (!(m_vram_replacement_texture =
-            g_gpu_device->FetchTexture(tex->GetWidth(), tex->GetHeight(), 1, 1, 1, GPUTexture::Type::DynamicTexture,
-                                       GPUTexture::Format::RGBA8, tex->GetPixels(), tex->GetPitch())))
-    {
-      return false;
-    }
+    it->second.last_used_frame = System::GetFrameNumber();
+    return it->second.texture.get();
   }
-  else
+
+  std::unique_ptr<GPUTexture> texture =
+    g_gpu_device->FetchTexture(tex->GetWidth(), tex->GetHeight(), 1, 1, 1, GPUTexture::Type::Texture,
+                               GPUTexture::Format::RGBA8, tex->GetPixels(), tex->GetPitch());
+  if (!texture)
+    return nullptr;
+
+  // Evict the least recently blitted entry once we're at the limit. The budget is generous since
+  // these are typically small UI/sprite textures, but bounds worst-case packs.
+  static constexpr size_t MAX_CACHE_SIZE = 128;
+  if (m_vram_replacement_texture_cache.size() >= MAX_CACHE_SIZE)
   {
-    if (!m_vram_replacement_texture->Update(0, 0, tex->GetWidth(), tex->GetHeight(), tex->GetPixels(), tex->GetPitch()))
+    auto lru = m_vram_replacement_texture_cache.begin();
+    for (auto eit = m_vram_replacement_texture_cache.begin(); eit != m_vram_replacement_texture_cache.end(); ++eit)
     {
-      Log_ErrorFmt("Update {}x{} texture failed.", width, height);
-      return false;
+      if (eit->second.last_used_frame < lru->second.last_used_frame)
+        lru = eit;
     }
+
+    g_gpu_device->RecycleTexture(std::move(lru->second.texture));
+    m_vram_replacement_texture_cache.erase(lru);
   }
 
+  GPUTexture* const ret = texture.get();
+  m_vram_replacement_texture_cache.emplace(
+    hash, VRAMReplacementTextureCacheEntry{std::move(texture), System::GetFrameNumber()});
+  return ret;
+}
+
+void GPU_HW::ClearVRAMReplacementTextureCache()
+{
+  for (auto& it : m_vram_replacement_texture_cache)
+    g_gpu_device->RecycleTexture(std::move(it.second.texture));
+  m_vram_replacement_texture_cache.clear();
+}
+
+bool GPU_HW::BlitVRAMReplacementTexture(const TextureReplacementTexture* tex, const TextureReplacementHash& hash,
+                                        u32 dst_x, u32 dst_y, u32 width, u32 height)
+{
+  GPUTexture* const texture = GetVRAMReplacementTexture(hash, tex);
+  if (!texture)
+    return false;
+
   GL_SCOPE_FMT("BlitVRAMReplacementTexture() {}x{} to {},{} => {},{} ({}x{})", tex->GetWidth(), tex->GetHeight(), dst_x,
                dst_y, dst_x + width, dst_y + height, width, height);
 
-  const float src_rect[4] = {
-    0.0f, 0.0f, static_cast<float>(tex->GetWidth()) / static_cast<float>(m_vram_replacement_texture->GetWidth()),
-    static_cast<float>(tex->GetHeight()) / static_cast<float>(m_vram_replacement_texture->GetHeight())};
+  // cached textures are exactly the replacement's size, so the source rect is always the full texture
+  const float src_rect[4] = {0.0f, 0.0f, 1.0f, 1.0f};
 
   g_gpu_device->PushUniformBuffer(src_rect, sizeof(src_rect));
-  g_gpu_device->SetTextureSampler(0, m_vram_replacement_texture.get(), g_gpu_device->GetLinearSampler());
+  g_gpu_device->SetTextureSampler(0, texture, g_gpu_device->GetLinearSampler());
   g_gpu_device->SetPipeline(m_vram_write_replacement_pipeline.get());
   g_gpu_device->SetViewportAndScissor(dst_x, dst_y, width, height);
   g_gpu_device->Draw(3, 0);
@@ -2347,6 +2757,41 @@ void GPU_HW::IncludeVRAMDirtyRectangle(Common::Rectangle<u32>& rect, const Commo
   }
 }
 
+bool GPU_HW::LookupVRAMUploadCache(u32 x, u32 y, u32 width, u32 height, bool set_mask, u64 hash) const
+{
+  for (const VRAMUploadCacheEntry& entry : m_vram_upload_cache)
+  {
+    if (entry.x == x && entry.y == y && entry.width == width && entry.height == height &&
+        entry.set_mask == set_mask && entry.hash == hash)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void GPU_HW::AddVRAMUploadCacheEntry(const Common::Rectangle<u32>& bounds, u32 x, u32 y, u32 width, u32 height,
+                                     bool set_mask, u64 hash)
+{
+  static constexpr size_t MAX_VRAM_UPLOAD_CACHE_ENTRIES = 32;
+  if (m_vram_upload_cache.size() >= MAX_VRAM_UPLOAD_CACHE_ENTRIES)
+    m_vram_upload_cache.erase(m_vram_upload_cache.begin());
+
+  m_vram_upload_cache.push_back(VRAMUploadCacheEntry{bounds, hash, x, y, width, height, set_mask});
+}
+
+void GPU_HW::InvalidateVRAMUploadCache(const Common::Rectangle<u32>& rect)
+{
+  for (size_t i = 0; i < m_vram_upload_cache.size();)
+  {
+    if (m_vram_upload_cache[i].bounds.Intersects(rect))
+      m_vram_upload_cache.erase(m_vram_upload_cache.begin() + i);
+    else
+      i++;
+  }
+}
+
 ALWAYS_INLINE_RELEASE void GPU_HW::CheckForTexPageOverlap(u32 texpage, u32 min_u, u32 min_v, u32 max_u, u32 max_v)
 {
   if (!m_texpage_dirty)
@@ -2430,14 +2875,14 @@ GPU_HW::InterlacedRenderMode GPU_HW::GetInterlacedRenderMode() const
   }
 }
 
-ALWAYS_INLINE_RELEASE bool GPU_HW::NeedsTwoPassRendering() const
+ALWAYS_INLINE_RELEASE bool GPU_HW::NeedsTwoPassRendering(const BatchConfig& config) const
 {
   // We need two-pass rendering when using BG-FG blending and texturing, as the transparency can be enabled
   // on a per-pixel basis, and the opaque pixels shouldn't be blended at all.
 
-  return (m_batch.texture_mode != GPUTextureMode::Disabled && !m_supports_framebuffer_fetch &&
-          (m_batch.transparency_mode == GPUTransparencyMode::BackgroundMinusForeground ||
-           (!m_supports_dual_source_blend && m_batch.transparency_mode != GPUTransparencyMode::Disabled)));
+  return (config.texture_mode != GPUTextureMode::Disabled && !m_supports_framebuffer_fetch &&
+          (config.transparency_mode == GPUTransparencyMode::BackgroundMinusForeground ||
+           (!m_supports_dual_source_blend && config.transparency_mode != GPUTransparencyMode::Disabled)));
 }
 
 ALWAYS_INLINE_RELEASE bool GPU_HW::NeedsShaderBlending(GPUTransparencyMode transparency) const
@@ -2540,6 +2985,7 @@ void GPU_HW::UpdateSoftwareRenderer(bool copy_vram_from_hw)
   {
     FlushRender();
     ReadVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+    FinishVRAMReadback();
 
     // Sync the drawing area.
     GPUBackendSetDrawingAreaCommand* cmd = sw_renderer->NewSetDrawingAreaCommand();
@@ -2601,6 +3047,7 @@ void GPU_HW::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
     m_vram_fill_pipelines[BoolToUInt8(is_oversized)][BoolToUInt8(IsInterlacedRenderingEnabled())].get());
 
   const Common::Rectangle<u32> bounds(GetVRAMTransferBounds(x, y, width, height));
+  InvalidateVRAMUploadCache(bounds);
   g_gpu_device->SetViewportAndScissor(bounds.left * m_resolution_scale, bounds.top * m_resolution_scale,
                                       bounds.GetWidth() * m_resolution_scale, bounds.GetHeight() * m_resolution_scale);
 
@@ -2632,6 +3079,8 @@ void GPU_HW::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
   GL_PUSH_FMT("ReadVRAM({},{} => {},{} ({}x{})", x, y, x + width, y + height, width, height);
 
+  PerfStats::StallScope stall_scope(PerfStats::StallSource::VRAMReadback);
+
   if (m_sw_renderer)
   {
     m_sw_renderer->Sync(false);
@@ -2665,27 +3114,64 @@ void GPU_HW::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
   m_vram_readback_texture->MakeReadyForSampling();
   GL_POP();
 
-  // Stage the readback and copy it into our shadow buffer.
-  if (m_vram_readback_download_texture->IsImported())
+  // Stage the readback. The fence wait and copy into the shadow buffer are deferred until the data is
+  // actually consumed (FinishVRAMReadback()), so the CPU doesn't serialize against the GPU here.
+  if (m_vram_readback_download_textures[0]->IsImported())
   {
-    // Fast path, read directly.
-    m_vram_readback_download_texture->CopyFromTexture(encoded_left, encoded_top, m_vram_readback_texture.get(), 0, 0,
-                                                      encoded_width, encoded_height, 0, 0, false);
-    m_vram_readback_download_texture->Flush();
+    // Fast path, the buffer is imported over the guest VRAM, so the copy lands there directly.
+    m_vram_readback_download_textures[0]->CopyFromTexture(encoded_left, encoded_top, m_vram_readback_texture.get(), 0,
+                                                          0, encoded_width, encoded_height, 0, 0, false);
   }
   else
   {
-    // Copy to staging buffer, then to VRAM.
-    m_vram_readback_download_texture->CopyFromTexture(0, 0, m_vram_readback_texture.get(), 0, 0, encoded_width,
-                                                      encoded_height, 0, 0, true);
-    m_vram_readback_download_texture->ReadTexels(0, 0, encoded_width, encoded_height,
-                                                 &g_vram[copy_rect.top * VRAM_WIDTH + copy_rect.left],
-                                                 VRAM_WIDTH * sizeof(u16));
+    // Copy to a staging buffer. If the one we're cycling to still has an outstanding readback, that's the
+    // oldest, so complete it before reusing the buffer.
+    const u32 buffer_index = m_vram_readback_buffer_index;
+    m_vram_readback_buffer_index = (buffer_index + 1) % NUM_VRAM_READBACK_BUFFERS;
+    if (m_pending_vram_readback_rects[buffer_index].Valid())
+      CompleteVRAMReadback(buffer_index);
+
+    m_vram_readback_download_textures[buffer_index]->CopyFromTexture(0, 0, m_vram_readback_texture.get(), 0, 0,
+                                                                     encoded_width, encoded_height, 0, 0, true);
+    m_pending_vram_readback_rects[buffer_index] = copy_rect;
   }
 
   RestoreDeviceContext();
 }
 
+void GPU_HW::FinishVRAMReadback()
+{
+  GPUDownloadTexture* const imported_tex = m_vram_readback_download_textures[0].get();
+  if (!imported_tex)
+    return;
+
+  if (imported_tex->IsImported())
+  {
+    // Everything already landed in g_vram, we just need to wait for the GPU.
+    if (imported_tex->NeedsFlush())
+      imported_tex->Flush();
+
+    return;
+  }
+
+  // Complete in submission order, in case the rectangles overlap.
+  for (u32 i = 0; i < NUM_VRAM_READBACK_BUFFERS; i++)
+  {
+    const u32 buffer_index = (m_vram_readback_buffer_index + i) % NUM_VRAM_READBACK_BUFFERS;
+    if (m_pending_vram_readback_rects[buffer_index].Valid())
+      CompleteVRAMReadback(buffer_index);
+  }
+}
+
+void GPU_HW::CompleteVRAMReadback(u32 buffer_index)
+{
+  const Common::Rectangle<u32>& copy_rect = m_pending_vram_readback_rects[buffer_index];
+  m_vram_readback_download_textures[buffer_index]->ReadTexels(0, 0, copy_rect.GetWidth() / 2, copy_rect.GetHeight(),
+                                                              &g_vram[copy_rect.top * VRAM_WIDTH + copy_rect.left],
+                                                              VRAM_WIDTH * sizeof(u16));
+  m_pending_vram_readback_rects[buffer_index].SetInvalid();
+}
+
 void GPU_HW::UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, bool set_mask, bool check_mask)
 {
   GL_SCOPE_FMT("UpdateVRAM({},{} => {},{} ({}x{})", x, y, x + width, y + height, width, height);
@@ -2711,17 +3197,36 @@ void GPU_HW::UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, b
 
   if (check_mask)
   {
+    // Result depends on the pixels already in VRAM, so we can't skip or cache it.
+    InvalidateVRAMUploadCache(bounds);
+
     // set new vertex counter since we want this to take into consideration previous masked pixels
     m_current_depth++;
   }
   else
   {
-    const TextureReplacementTexture* rtex = g_texture_replacements.GetVRAMWriteReplacement(width, height, data);
-    if (rtex && BlitVRAMReplacementTexture(rtex, x * m_resolution_scale, y * m_resolution_scale,
+    TextureReplacementHash rtex_hash;
+    const TextureReplacementTexture* rtex = g_texture_replacements.GetVRAMWriteReplacement(width, height, data, &rtex_hash);
+    if (rtex && BlitVRAMReplacementTexture(rtex, rtex_hash, x * m_resolution_scale, y * m_resolution_scale,
                                            width * m_resolution_scale, height * m_resolution_scale))
     {
+      InvalidateVRAMUploadCache(bounds);
       return;
     }
+
+    // Games often re-upload identical data (e.g. static UI textures) every frame. If the content and destination
+    // match the last upload to this rectangle, and nothing has touched it since, the texture already holds the
+    // correct data and we can skip the draw entirely. The SW renderer mirror was already updated above, and any
+    // readbacks will fetch the same data from the (unchanged) texture via the dirty rectangle.
+    const u64 hash = XXH3_64bits(data, sizeof(u16) * width * height);
+    if (LookupVRAMUploadCache(x, y, width, height, set_mask, hash))
+    {
+      GL_INS("Skipping VRAM write, content matches last upload");
+      return;
+    }
+
+    InvalidateVRAMUploadCache(bounds);
+    AddVRAMUploadCacheEntry(bounds, x, y, width, height, set_mask, hash);
   }
 
   std::unique_ptr<GPUTexture> upload_texture;
@@ -2807,6 +3312,7 @@ void GPU_HW::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32
      ((dst_y % VRAM_HEIGHT) + height) > VRAM_HEIGHT);
   const Common::Rectangle<u32> src_bounds = GetVRAMTransferBounds(src_x, src_y, width, height);
   const Common::Rectangle<u32> dst_bounds = GetVRAMTransferBounds(dst_x, dst_y, width, height);
+  InvalidateVRAMUploadCache(dst_bounds);
   const bool intersect_with_draw = m_vram_dirty_draw_rect.Intersects(src_bounds);
   const bool intersect_with_write = m_vram_dirty_write_rect.Intersects(src_bounds);
 
@@ -2974,23 +3480,36 @@ void GPU_HW::DispatchRenderCommand()
   const GPUTransparencyMode transparency_mode =
     rc.transparency_enable ? m_draw_mode.mode_reg.transparency_mode : GPUTransparencyMode::Disabled;
   const bool dithering_enable = (!m_true_color && rc.IsDitheringEnabled()) ? m_GPUSTAT.dither_enable : false;
+  static constexpr float transparent_alpha[4][2] = {{0.5f, 0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f}, {0.25f, 1.0f}};
   if (texture_mode != m_batch.texture_mode || transparency_mode != m_batch.transparency_mode ||
       (transparency_mode == GPUTransparencyMode::BackgroundMinusForeground && !m_supports_framebuffer_fetch) ||
       dithering_enable != m_batch.dithering)
   {
-    FlushRender();
+    // Pipeline-only changes close off a span which gets regrouped at submit time. Transparency
+    // modes bake their blend factors into the shared UBO, so a factor change still has to break
+    // the batch.
+    bool defer = CanDeferBatchStateChange();
+    if (defer && transparency_mode != GPUTransparencyMode::Disabled &&
+        (texture_mode == GPUTextureMode::Disabled || !NeedsShaderBlending(transparency_mode)))
+    {
+      defer = (m_batch_ubo_data.u_src_alpha_factor == transparent_alpha[static_cast<u32>(transparency_mode)][0] &&
+               m_batch_ubo_data.u_dst_alpha_factor == transparent_alpha[static_cast<u32>(transparency_mode)][1]);
+    }
+
+    if (defer)
+      CloseBatchSpan();
+    else
+      FlushRender();
   }
 
   EnsureVertexBufferSpaceForCurrentCommand();
 
-  if (m_batch_index_count == 0)
+  if (m_batch_index_count == m_batch_span_start_index)
   {
     // transparency mode change
     if (transparency_mode != GPUTransparencyMode::Disabled &&
         (texture_mode == GPUTextureMode::Disabled || !NeedsShaderBlending(transparency_mode)))
     {
-      static constexpr float transparent_alpha[4][2] = {{0.5f, 0.5f}, {1.0f, 1.0f}, {1.0f, 1.0f}, {0.25f, 1.0f}};
-
       const float src_alpha_factor = transparent_alpha[static_cast<u32>(transparency_mode)][0];
       const float dst_alpha_factor = transparent_alpha[static_cast<u32>(transparency_mode)][1];
       m_batch_ubo_dirty |= (m_batch_ubo_data.u_src_alpha_factor != src_alpha_factor ||
@@ -3054,8 +3573,104 @@ void GPU_HW::DispatchRenderCommand()
   LoadVertices();
 }
 
+bool GPU_HW::CanDeferBatchStateChange() const
+{
+  // Spans within one batch share a single UBO upload, scissor rect, and wireframe pass, so only
+  // state which is fully captured by the pipeline key can be deferred to a span boundary.
+  return (m_wireframe_mode == GPUWireframeMode::Disabled && !m_drawing_area_changed &&
+          !m_draw_mode.IsTextureWindowChanged() &&
+          m_batch_ubo_data.u_set_mask_while_drawing == BoolToUInt32(m_GPUSTAT.set_mask_while_drawing) &&
+          (!IsInterlacedRenderingEnabled() || m_batch_ubo_data.u_interlaced_displayed_field == GetActiveLineLSB()));
+}
+
+void GPU_HW::CloseBatchSpan()
+{
+  const u32 span_indices = static_cast<u32>(m_batch_index_count) - m_batch_span_start_index;
+  if (span_indices == 0)
+    return;
+
+  m_batch_spans.push_back(
+    BatchSpan{m_batch, m_batch_span_rect, m_batch_span_opaque_rect, m_batch_span_start_index, span_indices});
+  m_batch_span_start_index = m_batch_index_count;
+  m_batch_span_rect.SetInvalid();
+  m_batch_span_opaque_rect.SetInvalid();
+}
+
+void GPU_HW::ReorderBatchSpans()
+{
+  // Order-preserving regrouping: a span can only move ahead of spans whose draw rects it does not
+  // overlap, since draws to disjoint VRAM regions commute. The backwards scan is capped to keep
+  // the worst case linear in the number of spans.
+  static constexpr size_t MAX_REORDER_DISTANCE = 32;
+
+  for (size_t i = 1; i < m_batch_spans.size(); i++)
+  {
+    const BatchSpan& span = m_batch_spans[i];
+    if (!span.draw_rect.Valid() || m_batch_spans[i - 1].config.UsesSamePipelines(span.config))
+      continue;
+
+    size_t target = i;
+    const size_t min_j = (i > MAX_REORDER_DISTANCE) ? (i - MAX_REORDER_DISTANCE) : 0;
+    for (size_t j = i; j > min_j; j--)
+    {
+      const BatchSpan& prev = m_batch_spans[j - 1];
+      if (prev.config.UsesSamePipelines(span.config))
+      {
+        target = j;
+        break;
+      }
+
+      if (!prev.draw_rect.Valid() || prev.draw_rect.Intersects(span.draw_rect))
+        break;
+    }
+
+    if (target != i)
+      std::rotate(m_batch_spans.begin() + target, m_batch_spans.begin() + i, m_batch_spans.begin() + i + 1);
+  }
+}
+
+void GPU_HW::CullOccludedBatchSpans()
+{
+  // 2D titles repaint the whole screen back-to-front several times per frame. A span entirely
+  // inside a later span's opaque rectangle can be dropped: every pixel it writes, mask bit
+  // included, is overwritten before anything can observe it, since texture page changes and VRAM
+  // reads always flush the batch first. Spans which write the mask bit or depth buffer are kept,
+  // as check-masked or depth-tested draws in later batches could observe those side effects.
+  bool any_culled = false;
+  for (size_t i = m_batch_spans.size(); i-- > 1;)
+  {
+    const Common::Rectangle<u32>& occluder = m_batch_spans[i].opaque_rect;
+    if (!occluder.Valid())
+      continue;
+
+    for (size_t j = i; j-- > 0;)
+    {
+      BatchSpan& span = m_batch_spans[j];
+      if (span.index_count == 0 || !span.draw_rect.Valid() || !occluder.Contains(span.draw_rect) ||
+          span.config.set_mask_while_drawing || span.config.check_mask_before_draw || span.config.use_depth_buffer)
+      {
+        continue;
+      }
+
+      GL_INS_FMT("Culling fully-occluded span at index {} ({} indices)", span.start_index, span.index_count);
+      span.index_count = 0;
+      any_culled = true;
+    }
+  }
+
+  if (any_culled)
+  {
+    m_batch_spans.erase(
+      std::remove_if(m_batch_spans.begin(), m_batch_spans.end(),
+                     [](const BatchSpan& span) { return (span.index_count == 0); }),
+      m_batch_spans.end());
+  }
+}
+
 void GPU_HW::FlushRender()
 {
+  CloseBatchSpan();
+
   const u32 base_vertex = m_batch_base_vertex;
   const u32 base_index = m_batch_base_index;
   const u32 index_count = m_batch_index_count;
@@ -3082,14 +3697,37 @@ void GPU_HW::FlushRender()
 
   if (m_wireframe_mode != GPUWireframeMode::OnlyWireframe)
   {
-    if (NeedsTwoPassRendering())
+    if (m_batch_spans.size() > 1)
     {
-      DrawBatchVertices(BatchRenderMode::OnlyOpaque, index_count, base_index, base_vertex);
-      DrawBatchVertices(BatchRenderMode::OnlyTransparent, index_count, base_index, base_vertex);
+      CullOccludedBatchSpans();
+      if (m_batch_spans.size() > 1)
+        ReorderBatchSpans();
     }
-    else
+
+    size_t i = 0;
+    while (i < m_batch_spans.size())
     {
-      DrawBatchVertices(m_batch.GetRenderMode(), index_count, base_index, base_vertex);
+      BatchSpan span = m_batch_spans[i++];
+
+      // Contiguous spans which ended up adjacent with the same pipelines collapse into one draw.
+      while (i < m_batch_spans.size() && m_batch_spans[i].config.UsesSamePipelines(span.config) &&
+             m_batch_spans[i].start_index == (span.start_index + span.index_count))
+      {
+        span.index_count += m_batch_spans[i++].index_count;
+      }
+
+      if (NeedsTwoPassRendering(span.config))
+      {
+        DrawBatchVertices(span.config, BatchRenderMode::OnlyOpaque, span.index_count, base_index + span.start_index,
+                          base_vertex);
+        DrawBatchVertices(span.config, BatchRenderMode::OnlyTransparent, span.index_count,
+                          base_index + span.start_index, base_vertex);
+      }
+      else
+      {
+        DrawBatchVertices(span.config, span.config.GetRenderMode(), span.index_count, base_index + span.start_index,
+                          base_vertex);
+      }
     }
   }
 
@@ -3098,6 +3736,14 @@ void GPU_HW::FlushRender()
     g_gpu_device->SetPipeline(m_wireframe_pipeline.get());
     g_gpu_device->DrawIndexed(index_count, base_index, base_vertex);
   }
+
+  for (const BatchSpan& span : m_batch_spans)
+  {
+    if (span.draw_rect.Valid())
+      InvalidateVRAMUploadCache(span.draw_rect);
+  }
+
+  m_batch_spans.clear();
 }
 
 void GPU_HW::UpdateDisplay()
@@ -3355,13 +4001,24 @@ void GPU_HW::DownsampleFramebufferBoxFilter(GPUTexture* source, u32 left, u32 to
 
   source->MakeReadyForSampling();
 
-  const u32 uniforms[4] = {left, top, 0u, 0u};
-  g_gpu_device->PushUniformBuffer(uniforms, sizeof(uniforms));
+  struct BoxUBOData
+  {
+    u32 base_coords[2];
+    float rcp_source_size[2];
+  };
+  const BoxUBOData uniforms = {{left, top},
+                               {1.0f / static_cast<float>(source->GetWidth()),
+                                1.0f / static_cast<float>(source->GetHeight())}};
+  g_gpu_device->PushUniformBuffer(&uniforms, sizeof(uniforms));
+
+  // The even-factor shader reduces with bilinear taps, odd factors fall back to point loads.
+  GPUSampler* sampler = ((m_downsample_scale_or_levels % 2u) == 0u) ? g_gpu_device->GetLinearSampler() :
+                                                                      g_gpu_device->GetNearestSampler();
 
   g_gpu_device->InvalidateRenderTarget(m_downsample_texture.get());
   g_gpu_device->SetRenderTarget(m_downsample_texture.get());
   g_gpu_device->SetPipeline(m_downsample_first_pass_pipeline.get());
-  g_gpu_device->SetTextureSampler(0, source, g_gpu_device->GetNearestSampler());
+  g_gpu_device->SetTextureSampler(0, source, sampler);
   g_gpu_device->SetViewportAndScissor(0, 0, ds_width, ds_height);
   g_gpu_device->Draw(3, 0);
 
@@ -10,10 +10,14 @@
 
 #include "common/dimensional_array.h"
 #include "common/heap_array.h"
+#include "common/thirdparty/SmallVector.h"
 
+#include <array>
+#include <bitset>
 #include <sstream>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -53,6 +57,7 @@ public:
 
   void UpdateSettings(const Settings& old_settings) override;
   void UpdateResolutionScale() override final;
+  void UpdateDynamicResolutionScale(float average_gpu_time) override final;
   std::tuple<u32, u32> GetEffectiveDisplayResolution(bool scaled = true) override final;
   std::tuple<u32, u32> GetFullDisplayResolution(bool scaled = true) override final;
 
@@ -63,6 +68,7 @@ private:
   enum : u32
   {
     MAX_BATCH_VERTEX_COUNTER_IDS = 65536 - 2,
+    NUM_VRAM_READBACK_BUFFERS = 2,
     MAX_VERTICES_FOR_RECTANGLE = 6 * (((MAX_PRIMITIVE_WIDTH + (TEXTURE_PAGE_WIDTH - 1)) / TEXTURE_PAGE_WIDTH) + 1u) *
                                  (((MAX_PRIMITIVE_HEIGHT + (TEXTURE_PAGE_HEIGHT - 1)) / TEXTURE_PAGE_HEIGHT) + 1u)
   };
@@ -104,6 +110,34 @@ private:
 
     // Returns the render mode for this batch.
     BatchRenderMode GetRenderMode() const;
+
+    // Returns true if both configs select the same set of pipelines.
+    bool UsesSamePipelines(const BatchConfig& rhs) const;
+  };
+
+  // A sub-range of the current batch drawn with its own config. Spans whose draw rects do not
+  // overlap can be reordered at submit time to group pipeline-compatible work.
+  struct BatchSpan
+  {
+    BatchConfig config;
+    Common::Rectangle<u32> draw_rect;
+
+    // Largest rect known to be entirely covered with opaque, unmasked pixels by a single draw in
+    // this span. Later spans use it to cull fully-occluded earlier spans at submit time.
+    Common::Rectangle<u32> opaque_rect;
+
+    u32 start_index;
+    u32 index_count;
+  };
+
+  // Tracks the content hash of recent VRAM write destinations, so byte-identical re-uploads
+  // (static HUDs, repeated DMA of the same tiles) can be dropped without touching the GPU.
+  struct VRAMUploadCacheEntry
+  {
+    Common::Rectangle<u32> bounds;
+    u64 hash;
+    u32 x, y, width, height;
+    bool set_mask;
   };
 
   struct BatchUBOData
@@ -130,6 +164,47 @@ private:
   bool CompilePipelines();
   void DestroyPipelines();
 
+  static constexpr GPUPipeline::VertexAttribute BATCH_VERTEX_ATTRIBUTES[] = {
+    GPUPipeline::VertexAttribute::Make(0, GPUPipeline::VertexAttribute::Semantic::Position, 0,
+                                       GPUPipeline::VertexAttribute::Type::Float, 4, offsetof(BatchVertex, x)),
+    GPUPipeline::VertexAttribute::Make(1, GPUPipeline::VertexAttribute::Semantic::Color, 0,
+                                       GPUPipeline::VertexAttribute::Type::UNorm8, 4, offsetof(BatchVertex, color)),
+    GPUPipeline::VertexAttribute::Make(2, GPUPipeline::VertexAttribute::Semantic::TexCoord, 0,
+                                       GPUPipeline::VertexAttribute::Type::UInt32, 1, offsetof(BatchVertex, u)),
+    GPUPipeline::VertexAttribute::Make(3, GPUPipeline::VertexAttribute::Semantic::TexCoord, 1,
+                                       GPUPipeline::VertexAttribute::Type::UInt32, 1, offsetof(BatchVertex, texpage)),
+    GPUPipeline::VertexAttribute::Make(4, GPUPipeline::VertexAttribute::Semantic::TexCoord, 2,
+                                       GPUPipeline::VertexAttribute::Type::UNorm8, 4, offsetof(BatchVertex, uv_limits)),
+  };
+  static constexpr u32 NUM_BATCH_VERTEX_ATTRIBUTES = 2;
+  static constexpr u32 NUM_BATCH_TEXTURED_VERTEX_ATTRIBUTES = 4;
+  static constexpr u32 NUM_BATCH_TEXTURED_LIMITS_VERTEX_ATTRIBUTES = 5;
+
+  /// Builds the pipeline config for a batch permutation, minus the dithering/interlacing-only shader variation.
+  GPUPipeline::GraphicsConfig GetBatchPipelineConfig(GPUShader* vertex_shader, GPUShader* fragment_shader,
+                                                     u8 depth_test, u8 render_mode, u8 texture_mode,
+                                                     u8 transparency_mode) const;
+
+  /// Compiles a single batch pipeline permutation which was absent from the prewarm manifest.
+  bool CompileMissingBatchPipeline(u8 depth_test, u8 render_mode, u8 texture_mode, u8 transparency_mode, u8 dithering,
+                                   u8 interlacing);
+
+  /// Flattens a batch pipeline permutation into a stable index for the prewarm manifest.
+  ALWAYS_INLINE static constexpr u32 GetBatchPipelinePermutationIndex(u8 depth_test, u8 render_mode, u8 texture_mode,
+                                                                      u8 transparency_mode, u8 dithering,
+                                                                      u8 interlacing)
+  {
+    return ((((((ZeroExtend32(depth_test) * 4u) + render_mode) * 9u + texture_mode) * 5u + transparency_mode) * 2u +
+             dithering) *
+              2u +
+            interlacing);
+  }
+
+  /// Per-game manifest of batch permutations the game has used, so boot only compiles that set.
+  static std::string GetPipelinePrewarmManifestPath(const std::string& serial);
+  void LoadPipelinePrewarmManifest();
+  void SavePipelinePrewarmManifest();
+
   void LoadVertices();
 
   void PrintSettingsToLog();
@@ -141,7 +216,8 @@ private:
   void SetScissor();
   void MapGPUBuffer(u32 required_vertices, u32 required_indices);
   void UnmapGPUBuffer(u32 used_vertices, u32 used_indices);
-  void DrawBatchVertices(BatchRenderMode render_mode, u32 num_indices, u32 base_index, u32 base_vertex);
+  void DrawBatchVertices(const BatchConfig& config, BatchRenderMode render_mode, u32 num_indices, u32 base_index,
+                         u32 base_vertex);
 
   u32 CalculateResolutionScale() const;
   GPUDownsampleMode GetDownsampleMode(u32 resolution_scale) const;
@@ -154,11 +230,30 @@ private:
   void IncludeVRAMDirtyRectangle(Common::Rectangle<u32>& rect, const Common::Rectangle<u32>& new_rect);
   void CheckForTexPageOverlap(u32 texpage, u32 min_u, u32 min_v, u32 max_u, u32 max_v);
 
+  bool LookupVRAMUploadCache(u32 x, u32 y, u32 width, u32 height, bool set_mask, u64 hash) const;
+  void AddVRAMUploadCacheEntry(const Common::Rectangle<u32>& bounds, u32 x, u32 y, u32 width, u32 height, bool set_mask,
+                               u64 hash);
+  void InvalidateVRAMUploadCache(const Common::Rectangle<u32>& rect);
+
   bool IsFlushed() const;
   void EnsureVertexBufferSpace(u32 required_vertices, u32 required_indices);
   void EnsureVertexBufferSpaceForCurrentCommand();
   void ResetBatchVertexDepth();
 
+  /// Returns true if a batch state change only affects the pipeline key, and can therefore be
+  /// deferred to a span boundary instead of submitting the batch.
+  bool CanDeferBatchStateChange() const;
+
+  /// Closes off the current span of the batch, if it has any indices.
+  void CloseBatchSpan();
+
+  /// Moves spans with matching pipelines next to each other, where their draw rects allow it.
+  void ReorderBatchSpans();
+
+  /// Drops spans which are completely covered by a later span's opaque rectangle. Everything they
+  /// would write, mask bit included, is overwritten before the batch ends.
+  void CullOccludedBatchSpans();
+
   /// Returns the value to be written to the depth buffer for the current operation for mask bit emulation.
   float GetCurrentNormalizedVertexDepth() const;
 
@@ -166,7 +261,7 @@ private:
   InterlacedRenderMode GetInterlacedRenderMode() const;
 
   /// Returns if the draw needs to be broken into opaque/transparent passes.
-  bool NeedsTwoPassRendering() const;
+  bool NeedsTwoPassRendering(const BatchConfig& config) const;
 
   /// Returns true if the draw is going to use shader blending/framebuffer fetch.
   bool NeedsShaderBlending(GPUTransparencyMode transparency) const;
@@ -177,13 +272,23 @@ private:
 
   void FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color) override;
   void ReadVRAM(u32 x, u32 y, u32 width, u32 height) override;
+  void FinishVRAMReadback() override;
   void UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, bool set_mask, bool check_mask) override;
   void CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height) override;
   void DispatchRenderCommand() override;
   void FlushRender() override;
   void DrawRendererStats() override;
 
-  bool BlitVRAMReplacementTexture(const TextureReplacementTexture* tex, u32 dst_x, u32 dst_y, u32 width, u32 height);
+  bool BlitVRAMReplacementTexture(const TextureReplacementTexture* tex, const TextureReplacementHash& hash, u32 dst_x,
+                                  u32 dst_y, u32 width, u32 height);
+
+  /// Returns the GPU copy of a decoded replacement texture, uploading it on first use. Entries are
+  /// keyed by the VRAM write's content hash and reused across repeated uploads of the same data.
+  GPUTexture* GetVRAMReplacementTexture(const TextureReplacementHash& hash, const TextureReplacementTexture* tex);
+  void ClearVRAMReplacementTextureCache();
+
+  /// Copies the contents of a completed readback staging buffer into the guest VRAM shadow.
+  void CompleteVRAMReadback(u32 buffer_index);
 
   /// Expands a line into two triangles.
   void DrawLine(float x0, float y0, u32 col0, float x1, float y1, u32 col1, float depth);
@@ -210,8 +315,9 @@ private:
   std::unique_ptr<GPUTexture> m_vram_depth_texture;
   std::unique_ptr<GPUTexture> m_vram_read_texture;
   std::unique_ptr<GPUTexture> m_vram_readback_texture;
-  std::unique_ptr<GPUDownloadTexture> m_vram_readback_download_texture;
-  std::unique_ptr<GPUTexture> m_vram_replacement_texture;
+  std::array<std::unique_ptr<GPUDownloadTexture>, NUM_VRAM_READBACK_BUFFERS> m_vram_readback_download_textures;
+  std::array<Common::Rectangle<u32>, NUM_VRAM_READBACK_BUFFERS> m_pending_vram_readback_rects;
+  u32 m_vram_readback_buffer_index = 0;
   std::unique_ptr<GPUTexture> m_display_private_texture; // TODO: Move to base.
 
   std::unique_ptr<GPUTextureBuffer> m_vram_upload_buffer;
@@ -227,12 +333,18 @@ private:
   u16 m_batch_index_count = 0;
   u16 m_batch_vertex_space = 0;
   u16 m_batch_index_space = 0;
+  u16 m_batch_span_start_index = 0;
   s32 m_current_depth = 0;
   float m_last_depth_z = 1.0f;
 
   u8 m_resolution_scale = 1;
   u8 m_multisamples = 1;
 
+  // Current dynamic resolution scale, 0 when dynamic scaling is inactive. Caps the configured
+  // scale in CalculateResolutionScale(), stepped by UpdateDynamicResolutionScale().
+  u8 m_dynamic_resolution_scale = 0;
+  u8 m_dynamic_resolution_streak = 0;
+
   bool m_supports_dual_source_blend : 1 = false;
   bool m_supports_framebuffer_fetch : 1 = false;
   bool m_per_sample_shading : 1 = false;
@@ -253,6 +365,25 @@ private:
 
   BatchConfig m_batch;
 
+  // Closed-off spans of the current batch, and the draw bounds of the span being built.
+  // Inline storage covers typical batches; span counts above this only show up in heavy scenes.
+  llvm::SmallVector<BatchSpan, 8> m_batch_spans;
+  Common::Rectangle<u32> m_batch_span_rect;
+  Common::Rectangle<u32> m_batch_span_opaque_rect;
+
+  // Destination rects of recent VRAM writes, for redundant upload elimination.
+  std::vector<VRAMUploadCacheEntry> m_vram_upload_cache;
+
+  // GPU copies of decoded VRAM write replacements, keyed by content hash. Games re-upload the same
+  // textures constantly (animation cycles, menu redraws), so the decode and upload only happen the
+  // first time; subsequent writes of the same data just re-blit the cached texture.
+  struct VRAMReplacementTextureCacheEntry
+  {
+    std::unique_ptr<GPUTexture> texture;
+    u32 last_used_frame;
+  };
+  std::unordered_map<TextureReplacementHash, VRAMReplacementTextureCacheEntry> m_vram_replacement_texture_cache;
+
   // Changed state
   bool m_batch_ubo_dirty = true;
   BatchUBOData m_batch_ubo_data = {};
@@ -266,6 +397,12 @@ private:
   DimensionalArray<std::unique_ptr<GPUPipeline>, 2, 2, 5, 9, 4, 3> m_batch_pipelines{};
   std::unique_ptr<GPUPipeline> m_wireframe_pipeline;
 
+  // Batch permutations named in the per-game prewarm manifest, and those used this session.
+  static constexpr u32 NUM_BATCH_PIPELINE_PERMUTATIONS = 3 * 4 * 9 * 5 * 2 * 2;
+  std::bitset<NUM_BATCH_PIPELINE_PERMUTATIONS> m_prewarm_manifest_pipelines{};
+  std::bitset<NUM_BATCH_PIPELINE_PERMUTATIONS> m_used_batch_pipelines{};
+  bool m_prewarm_manifest_valid = false;
+
   // [wrapped][interlaced]
   DimensionalArray<std::unique_ptr<GPUPipeline>, 2, 2> m_vram_fill_pipelines{};
 
@@ -74,6 +74,8 @@ bool GPU_SW::Initialize()
 bool GPU_SW::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_display)
 {
   // ignore the host texture for software mode, since we want to save vram here
+  // VRAM is restored behind the backend's back, so any retained display rows are stale.
+  InvalidateDisplayCopyState();
   return GPU::DoState(sw, nullptr, update_display);
 }
 
@@ -81,6 +83,7 @@ void GPU_SW::Reset(bool clear_vram)
 {
   GPU::Reset(clear_vram);
 
+  InvalidateDisplayCopyState();
   m_backend.Reset();
 }
 
@@ -145,6 +148,58 @@ ALWAYS_INLINE u32 VRAM16ToOutput<GPUTexture::Format::BGRA8, u32>(u16 value)
   return ZeroExtend32(b) | (ZeroExtend32(g) << 8) | (ZeroExtend32(r) << 16) | (0xFF000000u);
 }
 
+#if defined(CPU_ARCH_SSE)
+
+/// Converts four zero-extended VRAM16 values in 32-bit lanes to the given 32-bit output format.
+template<GPUTexture::Format out_format>
+ALWAYS_INLINE static __m128i VRAM16ToOutput32(__m128i value)
+{
+  static_assert(out_format == GPUTexture::Format::RGBA8 || out_format == GPUTexture::Format::BGRA8);
+
+  const __m128i g = _mm_slli_epi32(_mm_and_si128(value, _mm_set1_epi32(0x3E0)), 6);
+  if constexpr (out_format == GPUTexture::Format::RGBA8)
+  {
+    const __m128i r = _mm_slli_epi32(_mm_and_si128(value, _mm_set1_epi32(0x1F)), 3);
+    const __m128i b = _mm_slli_epi32(_mm_and_si128(value, _mm_set1_epi32(0x7C00)), 9);
+    const __m128i a = _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(value, _mm_set1_epi32(0x8000)),
+                                                    _mm_set1_epi32(0x8000)),
+                                    _mm_set1_epi32(static_cast<s32>(0xFF000000u)));
+    return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+  }
+  else
+  {
+    const __m128i b = _mm_srli_epi32(_mm_and_si128(value, _mm_set1_epi32(0x7C00)), 7);
+    const __m128i r = _mm_slli_epi32(_mm_and_si128(value, _mm_set1_epi32(0x1F)), 19);
+    return _mm_or_si128(_mm_or_si128(b, g), _mm_or_si128(r, _mm_set1_epi32(static_cast<s32>(0xFF000000u))));
+  }
+}
+
+#elif defined(CPU_ARCH_NEON)
+
+/// Converts four zero-extended VRAM16 values in 32-bit lanes to the given 32-bit output format.
+template<GPUTexture::Format out_format>
+ALWAYS_INLINE static uint32x4_t VRAM16ToOutput32(uint32x4_t value)
+{
+  static_assert(out_format == GPUTexture::Format::RGBA8 || out_format == GPUTexture::Format::BGRA8);
+
+  const uint32x4_t g = vshlq_n_u32(vandq_u32(value, vdupq_n_u32(0x3E0)), 6);
+  if constexpr (out_format == GPUTexture::Format::RGBA8)
+  {
+    const uint32x4_t r = vshlq_n_u32(vandq_u32(value, vdupq_n_u32(0x1F)), 3);
+    const uint32x4_t b = vshlq_n_u32(vandq_u32(value, vdupq_n_u32(0x7C00)), 9);
+    const uint32x4_t a = vandq_u32(vtstq_u32(value, vdupq_n_u32(0x8000)), vdupq_n_u32(0xFF000000u));
+    return vorrq_u32(vorrq_u32(r, g), vorrq_u32(b, a));
+  }
+  else
+  {
+    const uint32x4_t b = vshrq_n_u32(vandq_u32(value, vdupq_n_u32(0x7C00)), 7);
+    const uint32x4_t r = vshlq_n_u32(vandq_u32(value, vdupq_n_u32(0x1F)), 19);
+    return vorrq_u32(vorrq_u32(b, g), vorrq_u32(r, vdupq_n_u32(0xFF000000u)));
+  }
+}
+
+#endif
+
 template<>
 ALWAYS_INLINE void CopyOutRow16<GPUTexture::Format::RGBA5551, u16>(const u16* src_ptr, u16* dst_ptr, u32 width)
 {
@@ -228,25 +283,78 @@ ALWAYS_INLINE void CopyOutRow16<GPUTexture::Format::RGB565, u16>(const u16* src_
 template<>
 ALWAYS_INLINE void CopyOutRow16<GPUTexture::Format::RGBA8, u32>(const u16* src_ptr, u32* dst_ptr, u32 width)
 {
-  for (u32 col = 0; col < width; col++)
+  u32 col = 0;
+
+#if defined(CPU_ARCH_SSE)
+  const u32 aligned_width = Common::AlignDownPow2(width, 8);
+  for (; col < aligned_width; col += 8)
+  {
+    const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_ptr));
+    src_ptr += 8;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_ptr),
+                     VRAM16ToOutput32<GPUTexture::Format::RGBA8>(_mm_unpacklo_epi16(value, _mm_setzero_si128())));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_ptr + 4),
+                     VRAM16ToOutput32<GPUTexture::Format::RGBA8>(_mm_unpackhi_epi16(value, _mm_setzero_si128())));
+    dst_ptr += 8;
+  }
+#elif defined(CPU_ARCH_NEON)
+  const u32 aligned_width = Common::AlignDownPow2(width, 8);
+  for (; col < aligned_width; col += 8)
+  {
+    const uint16x8_t value = vld1q_u16(src_ptr);
+    src_ptr += 8;
+    vst1q_u32(dst_ptr, VRAM16ToOutput32<GPUTexture::Format::RGBA8>(vmovl_u16(vget_low_u16(value))));
+    vst1q_u32(dst_ptr + 4, VRAM16ToOutput32<GPUTexture::Format::RGBA8>(vmovl_u16(vget_high_u16(value))));
+    dst_ptr += 8;
+  }
+#endif
+
+  for (; col < width; col++)
     *(dst_ptr++) = VRAM16ToOutput<GPUTexture::Format::RGBA8, u32>(*(src_ptr++));
 }
 
 template<>
 ALWAYS_INLINE void CopyOutRow16<GPUTexture::Format::BGRA8, u32>(const u16* src_ptr, u32* dst_ptr, u32 width)
 {
-  for (u32 col = 0; col < width; col++)
+  u32 col = 0;
+
+#if defined(CPU_ARCH_SSE)
+  const u32 aligned_width = Common::AlignDownPow2(width, 8);
+  for (; col < aligned_width; col += 8)
+  {
+    const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_ptr));
+    src_ptr += 8;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_ptr),
+                     VRAM16ToOutput32<GPUTexture::Format::BGRA8>(_mm_unpacklo_epi16(value, _mm_setzero_si128())));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_ptr + 4),
+                     VRAM16ToOutput32<GPUTexture::Format::BGRA8>(_mm_unpackhi_epi16(value, _mm_setzero_si128())));
+    dst_ptr += 8;
+  }
+#elif defined(CPU_ARCH_NEON)
+  const u32 aligned_width = Common::AlignDownPow2(width, 8);
+  for (; col < aligned_width; col += 8)
+  {
+    const uint16x8_t value = vld1q_u16(src_ptr);
+    src_ptr += 8;
+    vst1q_u32(dst_ptr, VRAM16ToOutput32<GPUTexture::Format::BGRA8>(vmovl_u16(vget_low_u16(value))));
+    vst1q_u32(dst_ptr + 4, VRAM16ToOutput32<GPUTexture::Format::BGRA8>(vmovl_u16(vget_high_u16(value))));
+    dst_ptr += 8;
+  }
+#endif
+
+  for (; col < width; col++)
     *(dst_ptr++) = VRAM16ToOutput<GPUTexture::Format::BGRA8, u32>(*(src_ptr++));
 }
 
 template<GPUTexture::Format display_format>
-void GPU_SW::CopyOut15Bit(u32 src_x, u32 src_y, u32 width, u32 height, u32 field, bool interlaced, bool interleaved)
+void GPU_SW::CopyOut15Bit(u32 src_x, u32 src_y, u32 width, u32 height, u32 dst_y, u32 display_height, u32 field,
+                          bool interlaced, bool interleaved)
 {
   using OutputPixelType =
     std::conditional_t<display_format == GPUTexture::Format::RGBA8 || display_format == GPUTexture::Format::BGRA8, u32,
                        u16>;
 
-  GPUTexture* texture = GetDisplayTexture(width, height, display_format);
+  GPUTexture* texture = GetDisplayTexture(width, display_height, display_format);
   if (!texture)
     return;
 
@@ -254,7 +362,7 @@ void GPU_SW::CopyOut15Bit(u32 src_x, u32 src_y, u32 width, u32 height, u32 field
   u8* dst_ptr = m_display_texture_buffer.data() + (interlaced ? (field != 0 ? dst_stride : 0) : 0);
 
   const bool mapped =
-    (!interlaced && texture->Map(reinterpret_cast<void**>(&dst_ptr), &dst_stride, 0, 0, width, height));
+    (!interlaced && texture->Map(reinterpret_cast<void**>(&dst_ptr), &dst_stride, 0, dst_y, width, height));
 
   const u32 output_stride = dst_stride;
   const u8 interlaced_shift = BoolToUInt8(interlaced);
@@ -297,27 +405,31 @@ void GPU_SW::CopyOut15Bit(u32 src_x, u32 src_y, u32 width, u32 height, u32 field
   if (mapped)
     texture->Unmap();
   else
-    texture->Update(0, 0, width, height, m_display_texture_buffer.data(), output_stride);
+    texture->Update(0, dst_y, width, height, m_display_texture_buffer.data(), output_stride);
 
-  SetDisplayTexture(texture, 0, 0, width, height);
+  SetDisplayTexture(texture, 0, 0, width, display_height);
 }
 
-void GPU_SW::CopyOut15Bit(GPUTexture::Format display_format, u32 src_x, u32 src_y, u32 width, u32 height, u32 field,
-                          bool interlaced, bool interleaved)
+void GPU_SW::CopyOut15Bit(GPUTexture::Format display_format, u32 src_x, u32 src_y, u32 width, u32 height, u32 dst_y,
+                          u32 display_height, u32 field, bool interlaced, bool interleaved)
 {
   switch (display_format)
   {
     case GPUTexture::Format::RGBA5551:
-      CopyOut15Bit<GPUTexture::Format::RGBA5551>(src_x, src_y, width, height, field, interlaced, interleaved);
+      CopyOut15Bit<GPUTexture::Format::RGBA5551>(src_x, src_y, width, height, dst_y, display_height, field, interlaced,
+                                                 interleaved);
       break;
     case GPUTexture::Format::RGB565:
-      CopyOut15Bit<GPUTexture::Format::RGB565>(src_x, src_y, width, height, field, interlaced, interleaved);
+      CopyOut15Bit<GPUTexture::Format::RGB565>(src_x, src_y, width, height, dst_y, display_height, field, interlaced,
+                                                 interleaved);
       break;
     case GPUTexture::Format::RGBA8:
-      CopyOut15Bit<GPUTexture::Format::RGBA8>(src_x, src_y, width, height, field, interlaced, interleaved);
+      CopyOut15Bit<GPUTexture::Format::RGBA8>(src_x, src_y, width, height, dst_y, display_height, field, interlaced,
+                                                 interleaved);
       break;
     case GPUTexture::Format::BGRA8:
-      CopyOut15Bit<GPUTexture::Format::BGRA8>(src_x, src_y, width, height, field, interlaced, interleaved);
+      CopyOut15Bit<GPUTexture::Format::BGRA8>(src_x, src_y, width, height, dst_y, display_height, field, interlaced,
+                                                 interleaved);
       break;
     default:
       break;
@@ -325,21 +437,21 @@ void GPU_SW::CopyOut15Bit(GPUTexture::Format display_format, u32 src_x, u32 src_
 }
 
 template<GPUTexture::Format display_format>
-void GPU_SW::CopyOut24Bit(u32 src_x, u32 src_y, u32 skip_x, u32 width, u32 height, u32 field, bool interlaced,
-                          bool interleaved)
+void GPU_SW::CopyOut24Bit(u32 src_x, u32 src_y, u32 skip_x, u32 width, u32 height, u32 dst_y, u32 display_height,
+                          u32 field, bool interlaced, bool interleaved)
 {
   using OutputPixelType =
     std::conditional_t<display_format == GPUTexture::Format::RGBA8 || display_format == GPUTexture::Format::BGRA8, u32,
                        u16>;
 
-  GPUTexture* texture = GetDisplayTexture(width, height, display_format);
+  GPUTexture* texture = GetDisplayTexture(width, display_height, display_format);
   if (!texture)
     return;
 
   u32 dst_stride = Common::AlignUpPow2<u32>(width * sizeof(OutputPixelType), 4);
   u8* dst_ptr = m_display_texture_buffer.data() + (interlaced ? (field != 0 ? dst_stride : 0) : 0);
   const bool mapped =
-    (!interlaced && texture->Map(reinterpret_cast<void**>(&dst_ptr), &dst_stride, 0, 0, width, height));
+    (!interlaced && texture->Map(reinterpret_cast<void**>(&dst_ptr), &dst_stride, 0, dst_y, width, height));
 
   const u32 output_stride = dst_stride;
   const u8 interlaced_shift = BoolToUInt8(interlaced);
@@ -357,7 +469,36 @@ void GPU_SW::CopyOut24Bit(u32 src_x, u32 src_y, u32 skip_x, u32 width, u32 heigh
       {
         const u8* src_row_ptr = src_ptr;
         u8* dst_row_ptr = reinterpret_cast<u8*>(dst_ptr);
-        for (u32 col = 0; col < width; col++)
+        u32 col = 0;
+
+#if defined(CPU_ARCH_SSE)
+        // Each iteration loads 16 bytes but only consumes 12 (four pixels); the (col + 6) bound
+        // keeps the tail of the load within the row's 3*width source bytes.
+        const __m128i rgb_mask = _mm_set1_epi32(0x00FFFFFF);
+        const __m128i alpha = _mm_set1_epi32(static_cast<s32>(0xFF000000u));
+        for (; (col + 6) <= width; col += 4)
+        {
+          const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_row_ptr));
+          src_row_ptr += 12;
+          const __m128i lo = _mm_unpacklo_epi32(value, _mm_srli_si128(value, 3));
+          const __m128i hi = _mm_unpacklo_epi32(_mm_srli_si128(value, 6), _mm_srli_si128(value, 9));
+          const __m128i rgbx = _mm_unpacklo_epi64(lo, hi);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_row_ptr),
+                           _mm_or_si128(_mm_and_si128(rgbx, rgb_mask), alpha));
+          dst_row_ptr += 16;
+        }
+#elif defined(CPU_ARCH_NEON)
+        for (; (col + 16) <= width; col += 16)
+        {
+          const uint8x16x3_t rgb = vld3q_u8(src_row_ptr);
+          src_row_ptr += 48;
+          const uint8x16x4_t rgba = {{rgb.val[0], rgb.val[1], rgb.val[2], vdupq_n_u8(0xFF)}};
+          vst4q_u8(dst_row_ptr, rgba);
+          dst_row_ptr += 64;
+        }
+#endif
+
+        for (; col < width; col++)
         {
           *(dst_row_ptr++) = *(src_row_ptr++);
           *(dst_row_ptr++) = *(src_row_ptr++);
@@ -369,7 +510,37 @@ void GPU_SW::CopyOut24Bit(u32 src_x, u32 src_y, u32 skip_x, u32 width, u32 heigh
       {
         const u8* src_row_ptr = src_ptr;
         u8* dst_row_ptr = reinterpret_cast<u8*>(dst_ptr);
-        for (u32 col = 0; col < width; col++)
+        u32 col = 0;
+
+#if defined(CPU_ARCH_SSE)
+        // Same over-read bound as the RGBA8 path, with the red/blue channels swapped afterwards.
+        const __m128i alpha = _mm_set1_epi32(static_cast<s32>(0xFF000000u));
+        for (; (col + 6) <= width; col += 4)
+        {
+          const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_row_ptr));
+          src_row_ptr += 12;
+          const __m128i lo = _mm_unpacklo_epi32(value, _mm_srli_si128(value, 3));
+          const __m128i hi = _mm_unpacklo_epi32(_mm_srli_si128(value, 6), _mm_srli_si128(value, 9));
+          const __m128i rgbx = _mm_unpacklo_epi64(lo, hi);
+          const __m128i r = _mm_slli_epi32(_mm_and_si128(rgbx, _mm_set1_epi32(0xFF)), 16);
+          const __m128i g = _mm_and_si128(rgbx, _mm_set1_epi32(0xFF00));
+          const __m128i b = _mm_and_si128(_mm_srli_epi32(rgbx, 16), _mm_set1_epi32(0xFF));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_row_ptr),
+                           _mm_or_si128(_mm_or_si128(b, g), _mm_or_si128(r, alpha)));
+          dst_row_ptr += 16;
+        }
+#elif defined(CPU_ARCH_NEON)
+        for (; (col + 16) <= width; col += 16)
+        {
+          const uint8x16x3_t rgb = vld3q_u8(src_row_ptr);
+          src_row_ptr += 48;
+          const uint8x16x4_t bgra = {{rgb.val[2], rgb.val[1], rgb.val[0], vdupq_n_u8(0xFF)}};
+          vst4q_u8(dst_row_ptr, bgra);
+          dst_row_ptr += 64;
+        }
+#endif
+
+        for (; col < width; col++)
         {
           *(dst_row_ptr++) = src_row_ptr[2];
           *(dst_row_ptr++) = src_row_ptr[1];
@@ -446,27 +617,31 @@ void GPU_SW::CopyOut24Bit(u32 src_x, u32 src_y, u32 skip_x, u32 width, u32 heigh
   if (mapped)
     texture->Unmap();
   else
-    texture->Update(0, 0, width, height, m_display_texture_buffer.data(), output_stride);
+    texture->Update(0, dst_y, width, height, m_display_texture_buffer.data(), output_stride);
 
-  SetDisplayTexture(texture, 0, 0, width, height);
+  SetDisplayTexture(texture, 0, 0, width, display_height);
 }
 
 void GPU_SW::CopyOut24Bit(GPUTexture::Format display_format, u32 src_x, u32 src_y, u32 skip_x, u32 width, u32 height,
-                          u32 field, bool interlaced, bool interleaved)
+                          u32 dst_y, u32 display_height, u32 field, bool interlaced, bool interleaved)
 {
   switch (display_format)
   {
     case GPUTexture::Format::RGBA5551:
-      CopyOut24Bit<GPUTexture::Format::RGBA5551>(src_x, src_y, skip_x, width, height, field, interlaced, interleaved);
+      CopyOut24Bit<GPUTexture::Format::RGBA5551>(src_x, src_y, skip_x, width, height, dst_y, display_height, field,
+                                                 interlaced, interleaved);
       break;
     case GPUTexture::Format::RGB565:
-      CopyOut24Bit<GPUTexture::Format::RGB565>(src_x, src_y, skip_x, width, height, field, interlaced, interleaved);
+      CopyOut24Bit<GPUTexture::Format::RGB565>(src_x, src_y, skip_x, width, height, dst_y, display_height, field,
+                                                 interlaced, interleaved);
       break;
     case GPUTexture::Format::RGBA8:
-      CopyOut24Bit<GPUTexture::Format::RGBA8>(src_x, src_y, skip_x, width, height, field, interlaced, interleaved);
+      CopyOut24Bit<GPUTexture::Format::RGBA8>(src_x, src_y, skip_x, width, height, dst_y, display_height, field,
+                                                 interlaced, interleaved);
       break;
     case GPUTexture::Format::BGRA8:
-      CopyOut24Bit<GPUTexture::Format::BGRA8>(src_x, src_y, skip_x, width, height, field, interlaced, interleaved);
+      CopyOut24Bit<GPUTexture::Format::BGRA8>(src_x, src_y, skip_x, width, height, dst_y, display_height, field,
+                                                 interlaced, interleaved);
       break;
     default:
       break;
@@ -476,6 +651,7 @@ void GPU_SW::CopyOut24Bit(GPUTexture::Format display_format, u32 src_x, u32 src_
 void GPU_SW::ClearDisplay()
 {
   std::memset(m_display_texture_buffer.data(), 0, m_display_texture_buffer.size());
+  InvalidateDisplayCopyState();
 }
 
 void GPU_SW::UpdateDisplay()
@@ -501,37 +677,88 @@ void GPU_SW::UpdateDisplay()
 
     if (IsInterlacedDisplayEnabled())
     {
+      // The interleaved paths retain rows from both fields in the intermediate buffer, so partial
+      // updates aren't applicable here.
+      InvalidateDisplayCopyState();
+
       const u32 field = GetInterlacedDisplayField();
       if (m_GPUSTAT.display_area_color_depth_24)
       {
         CopyOut24Bit(m_24bit_display_format, m_crtc_state.regs.X, vram_offset_y + field,
-                     m_crtc_state.display_vram_left - m_crtc_state.regs.X, display_width, display_height, field, true,
-                     m_GPUSTAT.vertical_resolution);
+                     m_crtc_state.display_vram_left - m_crtc_state.regs.X, display_width, display_height, 0,
+                     display_height, field, true, m_GPUSTAT.vertical_resolution);
       }
       else
       {
         CopyOut15Bit(m_16bit_display_format, m_crtc_state.display_vram_left, vram_offset_y + field, display_width,
-                     display_height, field, true, m_GPUSTAT.vertical_resolution);
+                     display_height, 0, display_height, field, true, m_GPUSTAT.vertical_resolution);
       }
     }
     else
     {
-      if (m_GPUSTAT.display_area_color_depth_24)
+      const bool is_24bit = m_GPUSTAT.display_area_color_depth_24;
+      const u32 src_x = is_24bit ? m_crtc_state.regs.X : m_crtc_state.display_vram_left;
+      const u32 skip_x = is_24bit ? (m_crtc_state.display_vram_left - m_crtc_state.regs.X) : 0;
+      const GPUTexture::Format format = is_24bit ? m_24bit_display_format : m_16bit_display_format;
+
+      // Only reconvert/upload the rows which the backend has touched since the last copy-out. The
+      // retained rows in the display texture are only usable if the source parameters are unchanged
+      // and the display area doesn't wrap around the bottom of VRAM.
+      m_display_dirty_rect.Include(m_backend.GetAndClearVRAMDirtyRect());
+
+      const DisplayCopyState state = {src_x, vram_offset_y, skip_x, display_width, display_height, format, is_24bit,
+                                      true};
+      const bool can_partial_copy = (m_display_copy_state.src_x == state.src_x &&
+                                     m_display_copy_state.src_y == state.src_y &&
+                                     m_display_copy_state.skip_x == state.skip_x &&
+                                     m_display_copy_state.width == state.width &&
+                                     m_display_copy_state.height == state.height &&
+                                     m_display_copy_state.format == state.format &&
+                                     m_display_copy_state.is_24bit == state.is_24bit && m_display_copy_state.valid &&
+                                     ((vram_offset_y + display_height) <= VRAM_HEIGHT));
+      u32 dst_y = 0;
+      u32 copy_height = display_height;
+      if (can_partial_copy)
       {
-        CopyOut24Bit(m_24bit_display_format, m_crtc_state.regs.X, vram_offset_y,
-                     m_crtc_state.display_vram_left - m_crtc_state.regs.X, display_width, display_height, 0, false,
-                     false);
+        if (!m_display_dirty_rect.Valid() ||
+            !m_display_dirty_rect.Intersects(
+              Common::Rectangle<u32>(0, vram_offset_y, VRAM_WIDTH, vram_offset_y + display_height)))
+        {
+          // Nothing visible changed; keep displaying the retained texture. Leave the dirty rect
+          // accumulated in case the display area moves back over it later.
+          GPUTexture* texture = GetDisplayTexture(display_width, display_height, format);
+          if (texture)
+          {
+            SetDisplayTexture(texture, 0, 0, display_width, display_height);
+            return;
+          }
+        }
+        else
+        {
+          dst_y = std::max(m_display_dirty_rect.top, vram_offset_y) - vram_offset_y;
+          copy_height = std::min(m_display_dirty_rect.bottom, vram_offset_y + display_height) - vram_offset_y - dst_y;
+        }
+      }
+
+      if (is_24bit)
+      {
+        CopyOut24Bit(format, src_x, vram_offset_y + dst_y, skip_x, display_width, copy_height, dst_y, display_height, 0,
+                     false, false);
       }
       else
       {
-        CopyOut15Bit(m_16bit_display_format, m_crtc_state.display_vram_left, vram_offset_y, display_width,
-                     display_height, 0, false, false);
+        CopyOut15Bit(format, src_x, vram_offset_y + dst_y, display_width, copy_height, dst_y, display_height, 0, false,
+                     false);
       }
+
+      m_display_copy_state = state;
+      m_display_dirty_rect.SetInvalid();
     }
   }
   else
   {
-    CopyOut15Bit(m_16bit_display_format, 0, 0, VRAM_WIDTH, VRAM_HEIGHT, 0, false, false);
+    InvalidateDisplayCopyState();
+    CopyOut15Bit(m_16bit_display_format, 0, 0, VRAM_WIDTH, VRAM_HEIGHT, 0, VRAM_HEIGHT, 0, false, false);
     SetDisplayParameters(VRAM_WIDTH, VRAM_HEIGHT, 0, 0, VRAM_WIDTH, VRAM_HEIGHT,
                          static_cast<float>(VRAM_WIDTH) / static_cast<float>(VRAM_HEIGHT));
   }
@@ -555,6 +782,11 @@ void GPU_SW::FillDrawCommand(GPUBackendDrawCommand* cmd, GPURenderCommand rc) co
   cmd->window = m_draw_mode.texture_window;
 }
 
+void GPU_SW::FlushBackendCommands()
+{
+  m_backend.FlushQueuedCommands();
+}
+
 void GPU_SW::DispatchRenderCommand()
 {
   if (m_drawing_area_changed)
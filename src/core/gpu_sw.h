@@ -42,27 +42,52 @@ protected:
   void CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height) override;
 
   template<GPUTexture::Format display_format>
-  void CopyOut15Bit(u32 src_x, u32 src_y, u32 width, u32 height, u32 field, bool interlaced, bool interleaved);
-  void CopyOut15Bit(GPUTexture::Format display_format, u32 src_x, u32 src_y, u32 width, u32 height, u32 field,
+  void CopyOut15Bit(u32 src_x, u32 src_y, u32 width, u32 height, u32 dst_y, u32 display_height, u32 field,
                     bool interlaced, bool interleaved);
+  void CopyOut15Bit(GPUTexture::Format display_format, u32 src_x, u32 src_y, u32 width, u32 height, u32 dst_y,
+                    u32 display_height, u32 field, bool interlaced, bool interleaved);
 
   template<GPUTexture::Format display_format>
-  void CopyOut24Bit(u32 src_x, u32 src_y, u32 skip_x, u32 width, u32 height, u32 field, bool interlaced,
-                    bool interleaved);
+  void CopyOut24Bit(u32 src_x, u32 src_y, u32 skip_x, u32 width, u32 height, u32 dst_y, u32 display_height, u32 field,
+                    bool interlaced, bool interleaved);
   void CopyOut24Bit(GPUTexture::Format display_format, u32 src_x, u32 src_y, u32 skip_x, u32 width, u32 height,
-                    u32 field, bool interlaced, bool interleaved);
+                    u32 dst_y, u32 display_height, u32 field, bool interlaced, bool interleaved);
 
   void ClearDisplay() override;
   void UpdateDisplay() override;
 
   void DispatchRenderCommand() override;
+  void FlushBackendCommands() override;
 
   void FillBackendCommandParameters(GPUBackendCommand* cmd) const;
   void FillDrawCommand(GPUBackendDrawCommand* cmd, GPURenderCommand rc) const;
 
   GPUTexture* GetDisplayTexture(u32 width, u32 height, GPUTexture::Format format);
 
+  /// Forces the next progressive copy-out to reconvert/upload the whole display area.
+  ALWAYS_INLINE void InvalidateDisplayCopyState()
+  {
+    m_display_copy_state.valid = false;
+    m_display_dirty_rect.Set(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+  }
+
+  /// Source parameters of the last progressive copy-out; partial updates are only valid while
+  /// they remain unchanged, since the retained texture rows were produced with them.
+  struct DisplayCopyState
+  {
+    u32 src_x;
+    u32 src_y;
+    u32 skip_x;
+    u32 width;
+    u32 height;
+    GPUTexture::Format format;
+    bool is_24bit;
+    bool valid;
+  };
+
   FixedHeapArray<u8, GPU_MAX_DISPLAY_WIDTH * GPU_MAX_DISPLAY_HEIGHT * sizeof(u32)> m_display_texture_buffer;
+  DisplayCopyState m_display_copy_state = {};
+  Common::Rectangle<u32> m_display_dirty_rect{0, 0, VRAM_WIDTH, VRAM_HEIGHT};
   GPUTexture::Format m_16bit_display_format = GPUTexture::Format::RGB565;
   GPUTexture::Format m_24bit_display_format = GPUTexture::Format::RGBA8;
   std::unique_ptr<GPUTexture> m_private_display_texture; // TODO: Move to base.
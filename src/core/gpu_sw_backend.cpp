@@ -3,28 +3,148 @@
 
 #include "gpu.h"
 #include "gpu_sw_backend.h"
+#include "settings.h"
 #include "system.h"
 
+#include "common/intrin.h"
+#include "common/log.h"
+#include "common/small_string.h"
+#include "common/timer.h"
+
 #include "util/gpu_device.h"
 
 #include <algorithm>
+#include <cstring>
+#include <thread>
+
+Log_SetChannel(GPU_SW_Backend);
+
+// The full DrawTriangle specialization cross-product is around twenty instantiations with
+// ShadePixel inlined into each of them, which thrashes L1i on cache-constrained cores. The pruned
+// mode keeps only the hot combinations fully specialized and folds the rest into a single generic
+// variant that reads the draw flags from the command at runtime. Defaults to on for arm32; define
+// to 0/1 to override.
+#if !defined(GPU_SW_PRUNE_RARE_DRAW_SPECIALIZATIONS) && defined(CPU_ARCH_ARM32)
+#define GPU_SW_PRUNE_RARE_DRAW_SPECIALIZATIONS 1
+#endif
+
+// Counts triangles per draw key and logs the totals at shutdown, for re-deriving the hot set above.
+#ifndef GPU_SW_DRAW_KEY_STATS
+#define GPU_SW_DRAW_KEY_STATS 0
+#endif
+
+thread_local s32 GPU_SW_Backend::s_rasterizer_thread_index = -1;
+
+#if GPU_SW_DRAW_KEY_STATS
+// Only bumped on the submitting thread, so no atomics needed.
+static u64 s_draw_key_counts[32];
+#endif
+
+// Beyond this point the bands get too thin for the dispatch overhead to pay off.
+static constexpr u32 MAX_RASTERIZER_THREADS = 8;
+
+static u32 GetRequestedRasterizerThreadCount()
+{
+  // A pool of one is pointless; treat it as a request to rasterize on the backend thread.
+  if (g_settings.gpu_sw_thread_count > 0)
+  {
+    return (g_settings.gpu_sw_thread_count > 1) ?
+             std::min<u32>(ZeroExtend32(g_settings.gpu_sw_thread_count), MAX_RASTERIZER_THREADS) :
+             0;
+  }
+
+  // Leave a core each for the CPU emulation thread and the GPU backend thread.
+  const u32 cpu_count = std::thread::hardware_concurrency();
+  return (cpu_count >= 3) ? std::min(cpu_count - 2, MAX_RASTERIZER_THREADS) : 0;
+}
 
 GPU_SW_Backend::GPU_SW_Backend() = default;
 
-GPU_SW_Backend::~GPU_SW_Backend() = default;
+GPU_SW_Backend::~GPU_SW_Backend()
+{
+  StopRasterizerThreads();
+}
 
 bool GPU_SW_Backend::Initialize(bool force_thread)
 {
-  return GPUBackend::Initialize(force_thread);
+  if (!GPUBackend::Initialize(force_thread))
+    return false;
+
+  StartRasterizerThreads();
+  return true;
+}
+
+void GPU_SW_Backend::UpdateSettings()
+{
+  GPUBackend::UpdateSettings();
+
+  if (m_num_rasterizer_threads != GetRequestedRasterizerThreadCount())
+  {
+    StopRasterizerThreads();
+    StartRasterizerThreads();
+  }
 }
 
 void GPU_SW_Backend::Reset()
 {
   GPUBackend::Reset();
+  m_vram_dirty_rect.Set(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+}
+
+Common::Rectangle<u32> GPU_SW_Backend::GetAndClearVRAMDirtyRect()
+{
+  const Common::Rectangle<u32> ret(m_vram_dirty_rect);
+  m_vram_dirty_rect.SetInvalid();
+  return ret;
+}
+
+void GPU_SW_Backend::AddVRAMDirtyRect(u32 x, u32 y, u32 width, u32 height)
+{
+  if ((x + width) > VRAM_WIDTH || (y + height) > VRAM_HEIGHT)
+  {
+    // Wrapped access - just consider everything dirty.
+    m_vram_dirty_rect.Include(0, VRAM_WIDTH, 0, VRAM_HEIGHT);
+  }
+  else
+  {
+    m_vram_dirty_rect.Include(x, x + width, y, y + height);
+  }
+}
+
+void GPU_SW_Backend::Shutdown()
+{
+  GPUBackend::Shutdown();
+  StopRasterizerThreads();
+
+#if GPU_SW_DRAW_KEY_STATS
+  for (u32 key = 0; key < 32; key++)
+  {
+    if (s_draw_key_counts[key] == 0)
+      continue;
+
+    Log_InfoPrintf("Draw key %c%c%c%c%c: %" PRIu64 " triangles", (key & 16) ? 'S' : '-', (key & 8) ? 'T' : '-',
+                   (key & 4) ? 'R' : '-', (key & 2) ? 'B' : '-', (key & 1) ? 'D' : '-', s_draw_key_counts[key]);
+  }
+#endif
 }
 
 void GPU_SW_Backend::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
 {
+#if GPU_SW_DRAW_KEY_STATS
+  if (s_rasterizer_thread_index < 0)
+  {
+    const GPURenderCommand stats_rc{cmd->rc.bits};
+    s_draw_key_counts[(u8(bool(stats_rc.shading_enable)) << 4) | (u8(bool(stats_rc.texture_enable)) << 3) |
+                      (u8(bool(stats_rc.raw_texture_enable)) << 2) | (u8(bool(stats_rc.transparency_enable)) << 1) |
+                      u8(cmd->IsDitheringEnabled())] += cmd->rc.quad_polygon ? 2 : 1;
+  }
+#endif
+
+  if (s_rasterizer_thread_index < 0)
+    AddDrawingAreaDirtyRect();
+  if (DispatchDrawCommand(cmd))
+    return;
+
   const GPURenderCommand rc{cmd->rc.bits};
   const bool dithering_enable = rc.IsDitheringEnabled() && cmd->draw_mode.dither_enable;
 
@@ -38,6 +158,11 @@ void GPU_SW_Backend::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
 
 void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
 {
+  if (s_rasterizer_thread_index < 0)
+    AddDrawingAreaDirtyRect();
+  if (DispatchDrawCommand(cmd))
+    return;
+
   const GPURenderCommand rc{cmd->rc.bits};
 
   const DrawRectangleFunction DrawFunction =
@@ -48,6 +173,11 @@ void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
 
 void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd)
 {
+  if (s_rasterizer_thread_index < 0)
+    AddDrawingAreaDirtyRect();
+  if (DispatchDrawCommand(cmd))
+    return;
+
   const DrawLineFunction DrawFunction =
     GetDrawLineFunction(cmd->rc.shading_enable, cmd->rc.transparency_enable, cmd->IsDitheringEnabled());
 
@@ -74,12 +204,28 @@ constexpr GPU_SW_Backend::DitherLUT GPU_SW_Backend::ComputeDitherLUT()
 
 static constexpr GPU_SW_Backend::DitherLUT s_dither_lut = GPU_SW_Backend::ComputeDitherLUT();
 
-template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
+template<bool texture_enable_, bool raw_texture_enable_, bool transparency_enable_, bool dithering_enable_,
+         bool generic>
 void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u8 color_r,
                                                       u8 color_g, u8 color_b, u8 texcoord_x, u8 texcoord_y)
 {
+  // The generic variant reads the flags from the command; otherwise these fold back to the template
+  // parameters and the branches below compile out as before.
+  bool texture_enable = texture_enable_;
+  bool raw_texture_enable = raw_texture_enable_;
+  bool transparency_enable = transparency_enable_;
+  bool dithering_enable = dithering_enable_;
+  if constexpr (generic)
+  {
+    const GPURenderCommand rc{cmd->rc.bits};
+    texture_enable = rc.texture_enable;
+    raw_texture_enable = rc.raw_texture_enable;
+    transparency_enable = rc.transparency_enable;
+    dithering_enable = cmd->IsDitheringEnabled();
+  }
+
   VRAMPixel color;
-  if constexpr (texture_enable)
+  if (texture_enable)
   {
     // Apply texture window
     texcoord_x = (texcoord_x & cmd->window.and_x) | cmd->window.or_x;
@@ -122,7 +268,7 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawComman
     if (texture_color.bits == 0)
       return;
 
-    if constexpr (raw_texture_enable)
+    if (raw_texture_enable)
     {
       color.bits = texture_color.bits;
     }
@@ -149,7 +295,7 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawComman
   }
 
   const VRAMPixel bg_color{GetPixel(static_cast<u32>(x), static_cast<u32>(y))};
-  if constexpr (transparency_enable)
+  if (transparency_enable)
   {
     if (color.bits & 0x8000u || !texture_enable)
     {
@@ -205,7 +351,7 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawComman
       }
 
       // See above.
-      if constexpr (!texture_enable)
+      if (!texture_enable)
         color.bits &= ~0x8000u;
     }
   }
@@ -217,6 +363,52 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawComman
   SetPixel(static_cast<u32>(x), static_cast<u32>(y), color.bits | cmd->params.GetMaskOR());
 }
 
+void GPU_SW_Backend::ShadeFlatSpan(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u32 width, u16 color)
+{
+  const u16 mask_and = cmd->params.GetMaskAND();
+  const u16 out_color = color | cmd->params.GetMaskOR();
+  u16* row = GetPixelPtr(x, y);
+  u32 remaining = width;
+
+  if (mask_and == 0)
+  {
+    std::fill_n(row, remaining, out_color);
+    return;
+  }
+
+#if defined(CPU_ARCH_SSE)
+  const __m128i vmask = _mm_set1_epi16(static_cast<s16>(mask_and));
+  const __m128i vcolor = _mm_set1_epi16(static_cast<s16>(out_color));
+  const __m128i vzero = _mm_setzero_si128();
+  while (remaining >= 8)
+  {
+    const __m128i bg = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row));
+    const __m128i writable = _mm_cmpeq_epi16(_mm_and_si128(bg, vmask), vzero);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(row),
+                     _mm_or_si128(_mm_and_si128(writable, vcolor), _mm_andnot_si128(writable, bg)));
+    row += 8;
+    remaining -= 8;
+  }
+#elif defined(CPU_ARCH_NEON)
+  const uint16x8_t vmask = vdupq_n_u16(mask_and);
+  const uint16x8_t vcolor = vdupq_n_u16(out_color);
+  while (remaining >= 8)
+  {
+    const uint16x8_t bg = vld1q_u16(row);
+    const uint16x8_t writable = vceqq_u16(vandq_u16(bg, vmask), vdupq_n_u16(0));
+    vst1q_u16(row, vbslq_u16(writable, vcolor, bg));
+    row += 8;
+    remaining -= 8;
+  }
+#endif
+
+  for (; remaining > 0; remaining--, row++)
+  {
+    if ((*row & mask_and) == 0)
+      *row = out_color;
+  }
+}
+
 template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
 void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
 {
@@ -229,11 +421,26 @@ void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
   {
     const s32 y = origin_y + static_cast<s32>(offset_y);
     if (y < static_cast<s32>(m_drawing_area.top) || y > static_cast<s32>(m_drawing_area.bottom) ||
-        (cmd->params.interlaced_rendering && cmd->params.active_line_lsb == (Truncate8(static_cast<u32>(y)) & 1u)))
+        (cmd->params.interlaced_rendering && cmd->params.active_line_lsb == (Truncate8(static_cast<u32>(y)) & 1u)) ||
+        !IsScanlineOwnedByCurrentThread(y))
     {
       continue;
     }
 
+    if constexpr (!texture_enable && !transparency_enable)
+    {
+      const s32 start_x = std::max(origin_x, static_cast<s32>(m_drawing_area.left));
+      const s32 end_x = std::min(origin_x + static_cast<s32>(cmd->width) - 1, static_cast<s32>(m_drawing_area.right));
+      if (end_x >= start_x)
+      {
+        const u16 color = (ZeroExtend16(s_dither_lut[2][3][r]) << 0) | (ZeroExtend16(s_dither_lut[2][3][g]) << 5) |
+                          (ZeroExtend16(s_dither_lut[2][3][b]) << 10);
+        ShadeFlatSpan(cmd, static_cast<u32>(start_x), static_cast<u32>(y), static_cast<u32>(end_x - start_x + 1),
+                      color);
+      }
+      continue;
+    }
+
     const u8 texcoord_y = Truncate8(ZeroExtend32(origin_texcoord_y) + offset_y);
 
     for (u32 offset_x = 0; offset_x < cmd->width; offset_x++)
@@ -357,12 +564,15 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::AddIDeltas_DY(i_group& ig, const i_de
 }
 
 template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
-         bool dithering_enable>
+         bool dithering_enable, bool generic>
 void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s32 x_start, s32 x_bound, i_group ig,
                               const i_deltas& idl)
 {
-  if (cmd->params.interlaced_rendering && cmd->params.active_line_lsb == (Truncate8(static_cast<u32>(y)) & 1u))
+  if ((cmd->params.interlaced_rendering && cmd->params.active_line_lsb == (Truncate8(static_cast<u32>(y)) & 1u)) ||
+      !IsScanlineOwnedByCurrentThread(y))
+  {
     return;
+  }
 
   s32 x_ig_adjust = x_start;
   s32 w = x_bound - x_start;
@@ -385,6 +595,17 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
   AddIDeltas_DX<shading_enable, texture_enable>(ig, idl, x_ig_adjust);
   AddIDeltas_DY<shading_enable, texture_enable>(ig, idl, y);
 
+  if constexpr (!shading_enable && !texture_enable && !transparency_enable && !dithering_enable)
+  {
+    // Flat opaque span - every pixel shades to the same value, so it vectorizes trivially.
+    const u16 color =
+      (ZeroExtend16(s_dither_lut[2][3][Truncate8(ig.r >> (COORD_FBS + COORD_POST_PADDING))]) << 0) |
+      (ZeroExtend16(s_dither_lut[2][3][Truncate8(ig.g >> (COORD_FBS + COORD_POST_PADDING))]) << 5) |
+      (ZeroExtend16(s_dither_lut[2][3][Truncate8(ig.b >> (COORD_FBS + COORD_POST_PADDING))]) << 10);
+    ShadeFlatSpan(cmd, static_cast<u32>(x), static_cast<u32>(y), static_cast<u32>(w), color);
+    return;
+  }
+
   do
   {
     const u32 r = ig.r >> (COORD_FBS + COORD_POST_PADDING);
@@ -393,7 +614,7 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
     const u32 u = ig.u >> (COORD_FBS + COORD_POST_PADDING);
     const u32 v = ig.v >> (COORD_FBS + COORD_POST_PADDING);
 
-    ShadePixel<texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
+    ShadePixel<texture_enable, raw_texture_enable, transparency_enable, dithering_enable, generic>(
       cmd, static_cast<u32>(x), static_cast<u32>(y), Truncate8(r), Truncate8(g), Truncate8(b), Truncate8(u),
       Truncate8(v));
 
@@ -403,7 +624,7 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
 }
 
 template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
-         bool dithering_enable>
+         bool dithering_enable, bool generic>
 void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
                                   const GPUBackendDrawPolygonCommand::Vertex* v0,
                                   const GPUBackendDrawPolygonCommand::Vertex* v1,
@@ -568,7 +789,7 @@ void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
         if (y > static_cast<s32>(m_drawing_area.bottom))
           continue;
 
-        DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
+        DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable, dithering_enable, generic>(
           cmd, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
       }
     }
@@ -584,7 +805,7 @@ void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
         if (y >= static_cast<s32>(m_drawing_area.top))
         {
 
-          DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
+          DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable, dithering_enable, generic>(
             cmd, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
         }
 
@@ -691,8 +912,9 @@ void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const GPUBac
     const s32 y = (cur_point.y >> Line_XY_FractBits) & 2047;
 
     if ((!cmd->params.interlaced_rendering || cmd->params.active_line_lsb != (Truncate8(static_cast<u32>(y)) & 1u)) &&
-        x >= static_cast<s32>(m_drawing_area.left) && x <= static_cast<s32>(m_drawing_area.right) &&
-        y >= static_cast<s32>(m_drawing_area.top) && y <= static_cast<s32>(m_drawing_area.bottom))
+        IsScanlineOwnedByCurrentThread(y) && x >= static_cast<s32>(m_drawing_area.left) &&
+        x <= static_cast<s32>(m_drawing_area.right) && y >= static_cast<s32>(m_drawing_area.top) &&
+        y <= static_cast<s32>(m_drawing_area.bottom))
     {
       const u8 r = shading_enable ? static_cast<u8>(cur_point.r >> Line_RGB_FractBits) : p0->r;
       const u8 g = shading_enable ? static_cast<u8>(cur_point.g >> Line_RGB_FractBits) : p0->g;
@@ -714,8 +936,25 @@ void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const GPUBac
   }
 }
 
+// Fills a possibly-wrapping span within a single VRAM row as one or two bulk fills, instead of
+// computing the wrap per pixel.
+static void FillVRAMRow(u16* row_ptr, u32 x, u32 width, u16 color16)
+{
+  if ((x + width) <= VRAM_WIDTH)
+  {
+    std::fill_n(&row_ptr[x], width, color16);
+    return;
+  }
+
+  const u32 columns_before_wrap = VRAM_WIDTH - x;
+  std::fill_n(&row_ptr[x], columns_before_wrap, color16);
+  std::fill_n(row_ptr, std::min<u32>(width - columns_before_wrap, VRAM_WIDTH), color16);
+}
+
 void GPU_SW_Backend::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color, GPUBackendCommandParameters params)
 {
+  AddVRAMDirtyRect(x, y, width, height);
+
   const u16 color16 = VRAMRGBA8888ToRGBA5551(color);
   if ((x + width) <= VRAM_WIDTH && !params.interlaced_rendering)
   {
@@ -735,12 +974,7 @@ void GPU_SW_Backend::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color, GP
       if ((row & u32(1)) == active_field)
         continue;
 
-      u16* row_ptr = &g_vram[row * VRAM_WIDTH];
-      for (u32 xoffs = 0; xoffs < width; xoffs++)
-      {
-        const u32 col = (x + xoffs) % VRAM_WIDTH;
-        row_ptr[col] = color16;
-      }
+      FillVRAMRow(&g_vram[row * VRAM_WIDTH], x, width, color16);
     }
   }
   else
@@ -748,12 +982,7 @@ void GPU_SW_Backend::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color, GP
     for (u32 yoffs = 0; yoffs < height; yoffs++)
     {
       const u32 row = (y + yoffs) % VRAM_HEIGHT;
-      u16* row_ptr = &g_vram[row * VRAM_WIDTH];
-      for (u32 xoffs = 0; xoffs < width; xoffs++)
-      {
-        const u32 col = (x + xoffs) % VRAM_WIDTH;
-        row_ptr[col] = color16;
-      }
+      FillVRAMRow(&g_vram[row * VRAM_WIDTH], x, width, color16);
     }
   }
 }
@@ -761,6 +990,8 @@ void GPU_SW_Backend::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color, GP
 void GPU_SW_Backend::UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data,
                                 GPUBackendCommandParameters params)
 {
+  AddVRAMDirtyRect(x, y, width, height);
+
   // Fast path when the copy is not oversized.
   if ((x + width) <= VRAM_WIDTH && (y + height) <= VRAM_HEIGHT && !params.IsMaskingEnabled())
   {
@@ -797,6 +1028,8 @@ void GPU_SW_Backend::UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void*
 void GPU_SW_Backend::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height,
                               GPUBackendCommandParameters params)
 {
+  AddVRAMDirtyRect(dst_x, dst_y, width, height);
+
   // Break up oversized copies. This behavior has not been verified on console.
   if ((src_x + width) > VRAM_WIDTH || (dst_x + width) > VRAM_WIDTH)
   {
@@ -829,10 +1062,23 @@ void GPU_SW_Backend::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 wi
     return;
   }
 
-  // This doesn't have a fast path, but do we really need one? It's not common.
   const u16 mask_and = params.GetMaskAND();
   const u16 mask_or = params.GetMaskOR();
 
+  // Without masking each row is a straight copy, and memmove's handling of overlap within a row
+  // matches the reverse copy direction the hardware uses when the ranges overlap.
+  if (mask_and == 0 && mask_or == 0)
+  {
+    for (u32 row = 0; row < height; row++)
+    {
+      const u16* src_row_ptr = &g_vram[((src_y + row) % VRAM_HEIGHT) * VRAM_WIDTH + src_x];
+      u16* dst_row_ptr = &g_vram[((dst_y + row) % VRAM_HEIGHT) * VRAM_WIDTH + dst_x];
+      std::memmove(dst_row_ptr, src_row_ptr, width * sizeof(u16));
+    }
+
+    return;
+  }
+
   // Copy in reverse when src_x < dst_x, this is verified on console.
   if (src_x < dst_x || ((src_x + width - 1) % VRAM_WIDTH) < ((dst_x + width - 1) % VRAM_WIDTH))
   {
@@ -868,10 +1114,252 @@ void GPU_SW_Backend::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 wi
   }
 }
 
-void GPU_SW_Backend::FlushRender() {}
+void GPU_SW_Backend::FlushRender()
+{
+  JoinRasterizerThreads();
+}
 
 void GPU_SW_Backend::DrawingAreaChanged() {}
 
+void GPU_SW_Backend::StartRasterizerThreads()
+{
+  const u32 thread_count = GetRequestedRasterizerThreadCount();
+  if (thread_count == 0)
+    return;
+
+  m_num_rasterizer_threads = thread_count;
+  m_rasterizer_threads.reserve(thread_count);
+  for (u32 i = 0; i < thread_count; i++)
+  {
+    std::unique_ptr<RasterizerThread> state = std::make_unique<RasterizerThread>();
+    state->read_ptr.store(m_rasterizer_queue_write_ptr.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_rasterizer_threads.push_back(std::move(state));
+  }
+  for (u32 i = 0; i < thread_count; i++)
+    m_rasterizer_threads[i]->thread.Start([this, i]() { RasterizerThreadEntryPoint(i); });
+
+  Log_InfoPrintf("Started %u rasterizer threads (%u scanline bands).", thread_count,
+                 static_cast<u32>(VRAM_HEIGHT) / static_cast<u32>(RASTERIZER_BAND_HEIGHT));
+}
+
+void GPU_SW_Backend::StopRasterizerThreads()
+{
+  if (m_num_rasterizer_threads == 0)
+    return;
+
+  JoinRasterizerThreads();
+
+  {
+    std::unique_lock<std::mutex> lock(m_rasterizer_mutex);
+    m_rasterizer_shutdown = true;
+    m_rasterizer_wake_cv.notify_all();
+  }
+
+  for (std::unique_ptr<RasterizerThread>& state : m_rasterizer_threads)
+    state->thread.Join();
+
+  m_rasterizer_threads.clear();
+  m_num_rasterizer_threads = 0;
+  m_rasterizer_shutdown = false;
+  Log_InfoPrint("Rasterizer threads stopped.");
+}
+
+u32 GPU_SW_Backend::GetRasterizerQueueDepth(u32 write_ptr) const
+{
+  // Number of bytes the slowest thread has yet to process. Pointers are monotonic, so wrapping
+  // subtraction does the right thing when they overflow.
+  u32 depth = 0;
+  for (const std::unique_ptr<RasterizerThread>& state : m_rasterizer_threads)
+    depth = std::max(depth, write_ptr - state->read_ptr.load(std::memory_order_acquire));
+  return depth;
+}
+
+void GPU_SW_Backend::WakeRasterizerThreads()
+{
+  std::unique_lock<std::mutex> lock(m_rasterizer_mutex);
+  if (m_num_sleeping_rasterizer_threads == 0)
+    return;
+
+  m_rasterizer_wake_cv.notify_all();
+}
+
+void GPU_SW_Backend::JoinRasterizerThreads()
+{
+  if (m_num_rasterizer_threads == 0 || s_rasterizer_thread_index >= 0)
+    return;
+
+  // Nothing is in flight once we return, so later draws cannot hazard against this burst.
+  m_rasterizer_pending_rect.SetInvalid();
+
+  const u32 write_ptr = m_rasterizer_queue_write_ptr.load(std::memory_order_relaxed);
+  if (GetRasterizerQueueDepth(write_ptr) == 0)
+    return;
+
+  std::unique_lock<std::mutex> lock(m_rasterizer_mutex);
+  m_rasterizer_wake_cv.notify_all();
+  m_rasterizer_idle_cv.wait(lock, [this, write_ptr]() { return GetRasterizerQueueDepth(write_ptr) == 0; });
+}
+
+bool GPU_SW_Backend::DispatchDrawCommand(const GPUBackendCommand* cmd)
+{
+  if (m_num_rasterizer_threads == 0 || s_rasterizer_thread_index >= 0)
+    return false;
+
+  // Oversized commands (e.g. very long polylines) get rasterized inline after draining the pool.
+  if ((cmd->size + sizeof(GPUBackendCommand)) > RASTERIZER_QUEUE_SIZE)
+  {
+    JoinRasterizerThreads();
+    return false;
+  }
+
+  // Every draw command type derives from GPUBackendDrawCommand.
+  SyncForTextureFetchHazard(static_cast<const GPUBackendDrawCommand*>(cmd));
+
+  u32 write_ptr = m_rasterizer_queue_write_ptr.load(std::memory_order_relaxed);
+  u32 offset = write_ptr % RASTERIZER_QUEUE_SIZE;
+
+  // Pad out to the end of the buffer with a dummy command when the real command would straddle it.
+  const u32 wrap_size = ((RASTERIZER_QUEUE_SIZE - offset) < cmd->size) ? (RASTERIZER_QUEUE_SIZE - offset) : 0;
+  const u32 required_size = cmd->size + wrap_size;
+
+  if ((GetRasterizerQueueDepth(write_ptr) + required_size) > RASTERIZER_QUEUE_SIZE)
+  {
+    std::unique_lock<std::mutex> lock(m_rasterizer_mutex);
+    m_rasterizer_wake_cv.notify_all();
+    m_rasterizer_idle_cv.wait(lock, [this, write_ptr, required_size]() {
+      return (GetRasterizerQueueDepth(write_ptr) + required_size) <= RASTERIZER_QUEUE_SIZE;
+    });
+  }
+
+  if (wrap_size > 0)
+  {
+    GPUBackendCommand* dummy_cmd = reinterpret_cast<GPUBackendCommand*>(&m_rasterizer_queue_data[offset]);
+    dummy_cmd->size = wrap_size;
+    dummy_cmd->type = GPUBackendCommandType::Wraparound;
+    dummy_cmd->params.bits = 0;
+    write_ptr += wrap_size;
+    offset = 0;
+  }
+
+  // The FIFO slot the command lives in is recycled as soon as HandleCommand() returns, so it has
+  // to be copied rather than referenced.
+  std::memcpy(&m_rasterizer_queue_data[offset], cmd, cmd->size);
+  m_rasterizer_queue_write_ptr.store(write_ptr + cmd->size, std::memory_order_release);
+  WakeRasterizerThreads();
+
+  // Whatever this draw writes is clipped to the drawing area; remember it for hazard checks
+  // against the texture fetches of later draws in the burst.
+  if (m_drawing_area.Valid())
+  {
+    m_rasterizer_pending_rect.Include(m_drawing_area.left, m_drawing_area.right + 1, m_drawing_area.top,
+                                      m_drawing_area.bottom + 1);
+  }
+
+  return true;
+}
+
+void GPU_SW_Backend::SyncForTextureFetchHazard(const GPUBackendDrawCommand* cmd)
+{
+  if (!m_rasterizer_pending_rect.Valid() || !cmd->rc.texture_enable)
+    return;
+
+  // Compare against the page/palette footprint rather than the exact texels sampled; draws which
+  // texture from VRAM the pool is still writing are rare enough that precision does not pay.
+  // Fetches wrap at the VRAM edges, so a footprint poking past them degrades to an unconditional
+  // join rather than trying to split the rectangle.
+  const Common::Rectangle<u32> page_rect = cmd->draw_mode.GetTexturePageRectangle();
+  bool hazard = (page_rect.right > VRAM_WIDTH || page_rect.bottom > VRAM_HEIGHT) ||
+                m_rasterizer_pending_rect.Intersects(page_rect);
+  if (!hazard && cmd->draw_mode.IsUsingPalette())
+  {
+    const Common::Rectangle<u32> palette_rect = cmd->palette.GetRectangle(cmd->draw_mode.texture_mode);
+    hazard = (palette_rect.right > VRAM_WIDTH) || m_rasterizer_pending_rect.Intersects(palette_rect);
+  }
+
+  if (hazard)
+    JoinRasterizerThreads();
+}
+
+void GPU_SW_Backend::ExecuteDrawCommand(const GPUBackendCommand* cmd)
+{
+  switch (cmd->type)
+  {
+    case GPUBackendCommandType::DrawPolygon:
+      DrawPolygon(static_cast<const GPUBackendDrawPolygonCommand*>(cmd));
+      break;
+
+    case GPUBackendCommandType::DrawRectangle:
+      DrawRectangle(static_cast<const GPUBackendDrawRectangleCommand*>(cmd));
+      break;
+
+    case GPUBackendCommandType::DrawLine:
+      DrawLine(static_cast<const GPUBackendDrawLineCommand*>(cmd));
+      break;
+
+    default:
+      break;
+  }
+}
+
+void GPU_SW_Backend::RasterizerThreadEntryPoint(u32 thread_index)
+{
+  Threading::SetNameOfCurrentThread(TinyString::from_format("SW Rasterizer {}", thread_index).c_str());
+  s_rasterizer_thread_index = static_cast<s32>(thread_index);
+
+  static constexpr double SPIN_TIME_NS = 1 * 1000000;
+  RasterizerThread& state = *m_rasterizer_threads[thread_index];
+  Common::Timer::Value last_command_time = 0;
+
+  for (;;)
+  {
+    u32 read_ptr = state.read_ptr.load(std::memory_order_relaxed);
+    const u32 write_ptr = m_rasterizer_queue_write_ptr.load(std::memory_order_acquire);
+    if (read_ptr == write_ptr)
+    {
+      const Common::Timer::Value current_time = Common::Timer::GetCurrentValue();
+      if (Common::Timer::ConvertValueToNanoseconds(current_time - last_command_time) < SPIN_TIME_NS)
+        continue;
+
+      std::unique_lock<std::mutex> lock(m_rasterizer_mutex);
+      if (m_rasterizer_shutdown)
+        break;
+
+      m_num_sleeping_rasterizer_threads++;
+      m_rasterizer_wake_cv.wait(lock, [this, &state]() {
+        return m_rasterizer_shutdown || (m_rasterizer_queue_write_ptr.load(std::memory_order_acquire) !=
+                                         state.read_ptr.load(std::memory_order_relaxed));
+      });
+      m_num_sleeping_rasterizer_threads--;
+
+      if (m_rasterizer_shutdown)
+        break;
+
+      last_command_time = 0;
+      continue;
+    }
+
+    while (read_ptr != write_ptr)
+    {
+      const GPUBackendCommand* cmd =
+        reinterpret_cast<const GPUBackendCommand*>(&m_rasterizer_queue_data[read_ptr % RASTERIZER_QUEUE_SIZE]);
+      if (cmd->type != GPUBackendCommandType::Wraparound)
+        ExecuteDrawCommand(cmd);
+
+      read_ptr += cmd->size;
+      state.read_ptr.store(read_ptr, std::memory_order_release);
+    }
+
+    // The backend thread may be waiting in JoinRasterizerThreads()/DispatchDrawCommand(); the
+    // notify has to happen under the lock so it cannot slip between its idle check and wait.
+    {
+      std::unique_lock<std::mutex> lock(m_rasterizer_mutex);
+      m_rasterizer_idle_cv.notify_all();
+    }
+
+    last_command_time = Common::Timer::GetCurrentValue();
+  }
+}
+
 GPU_SW_Backend::DrawLineFunction GPU_SW_Backend::GetDrawLineFunction(bool shading_enable, bool transparency_enable,
                                                                      bool dithering_enable)
 {
@@ -901,6 +1389,35 @@ GPU_SW_Backend::DrawTriangleFunction GPU_SW_Backend::GetDrawTriangleFunction(boo
                                                                              bool transparency_enable,
                                                                              bool dithering_enable)
 {
+#if GPU_SW_PRUNE_RARE_DRAW_SPECIALIZATIONS
+  // Fold the impossible bits the same way the full table does.
+  dithering_enable &= !raw_texture_enable;
+  raw_texture_enable &= texture_enable;
+
+  // The hot set below came from GPU_SW_DRAW_KEY_STATS captures across a spread of games; anything
+  // else goes through the generic variant, which resolves the per-pixel flags at runtime. The
+  // generic variant always interpolates colour and texcoords, which is harmless: flat commands
+  // carry identical vertex colours, so the deltas work out to zero.
+  switch ((u8(shading_enable) << 4) | (u8(texture_enable) << 3) | (u8(raw_texture_enable) << 2) |
+          (u8(transparency_enable) << 1) | u8(dithering_enable))
+  {
+    case 0b00000: return &GPU_SW_Backend::DrawTriangle<false, false, false, false, false>;
+    case 0b00010: return &GPU_SW_Backend::DrawTriangle<false, false, false, true, false>;
+    case 0b01000: return &GPU_SW_Backend::DrawTriangle<false, true, false, false, false>;
+    case 0b01010: return &GPU_SW_Backend::DrawTriangle<false, true, false, true, false>;
+    case 0b01100: return &GPU_SW_Backend::DrawTriangle<false, true, true, false, false>;
+    case 0b01110: return &GPU_SW_Backend::DrawTriangle<false, true, true, true, false>;
+    case 0b10000: return &GPU_SW_Backend::DrawTriangle<true, false, false, false, false>;
+    case 0b10001: return &GPU_SW_Backend::DrawTriangle<true, false, false, false, true>;
+    case 0b10011: return &GPU_SW_Backend::DrawTriangle<true, false, false, true, true>;
+    case 0b11000: return &GPU_SW_Backend::DrawTriangle<true, true, false, false, false>;
+    case 0b11001: return &GPU_SW_Backend::DrawTriangle<true, true, false, false, true>;
+    case 0b11010: return &GPU_SW_Backend::DrawTriangle<true, true, false, true, false>;
+
+    default:
+      return &GPU_SW_Backend::DrawTriangle<true, true, false, false, false, true>;
+  }
+#else
   static constexpr DrawTriangleFunction funcs[2][2][2][2][2] = {
     {{{{&GPU_SW_Backend::DrawTriangle<false, false, false, false, false>,
         &GPU_SW_Backend::DrawTriangle<false, false, false, false, true>},
@@ -937,4 +1454,5 @@ GPU_SW_Backend::DrawTriangleFunction GPU_SW_Backend::GetDrawTriangleFunction(boo
 
   return funcs[u8(shading_enable)][u8(texture_enable)][u8(raw_texture_enable)][u8(transparency_enable)]
               [u8(dithering_enable)];
+#endif
 }
\ No newline at end of file
@@ -4,7 +4,10 @@
 #pragma once
 #include "gpu_backend.h"
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class GPU_SW_Backend final : public GPUBackend
@@ -14,7 +17,13 @@ public:
   ~GPU_SW_Backend() override;
 
   bool Initialize(bool force_thread) override;
+  void UpdateSettings() override;
   void Reset() override;
+  void Shutdown() override;
+
+  /// Returns the VRAM area modified by the backend since the last call, in VRAM coordinates.
+  /// Call after Sync() so that in-flight rasterization is included.
+  Common::Rectangle<u32> GetAndClearVRAMDirtyRect();
 
   ALWAYS_INLINE_RELEASE u16 GetPixel(const u32 x, const u32 y) const { return g_vram[VRAM_WIDTH * y + x]; }
   ALWAYS_INLINE_RELEASE const u16* GetPixelPtr(const u32 x, const u32 y) const { return &g_vram[VRAM_WIDTH * y + x]; }
@@ -87,6 +96,56 @@ protected:
     return std::make_tuple(static_cast<u8>(rgb24), static_cast<u8>(rgb24 >> 8), static_cast<u8>(rgb24 >> 16));
   }
 
+  //////////////////////////////////////////////////////////////////////////
+  // Scanline-parallel rasterization
+  //////////////////////////////////////////////////////////////////////////
+  enum : u32
+  {
+    RASTERIZER_QUEUE_SIZE = 512 * 1024,
+    RASTERIZER_BAND_HEIGHT = 8,
+  };
+
+  /// Returns true if the specified scanline falls within a band owned by the calling thread.
+  /// Threads outside the rasterizer pool (i.e. when it is inactive) own every scanline.
+  ALWAYS_INLINE_RELEASE bool IsScanlineOwnedByCurrentThread(s32 y) const
+  {
+    return (s_rasterizer_thread_index < 0) ||
+           (((static_cast<u32>(y) / RASTERIZER_BAND_HEIGHT) % m_num_rasterizer_threads) ==
+            static_cast<u32>(s_rasterizer_thread_index));
+  }
+
+  void AddVRAMDirtyRect(u32 x, u32 y, u32 width, u32 height);
+
+  /// Draw commands are clipped to the drawing area, so it bounds whatever they touch.
+  ALWAYS_INLINE void AddDrawingAreaDirtyRect()
+  {
+    if (m_drawing_area.Valid())
+    {
+      m_vram_dirty_rect.Include(m_drawing_area.left, m_drawing_area.right + 1, m_drawing_area.top,
+                                m_drawing_area.bottom + 1);
+    }
+  }
+
+  void StartRasterizerThreads();
+  void StopRasterizerThreads();
+
+  /// Waits for all queued draw commands to finish rasterizing. Must be called on the thread which
+  /// feeds the backend before anything outside the pool touches VRAM.
+  void JoinRasterizerThreads();
+
+  /// Copies a draw command into the rasterizer queue. Returns false if the pool is inactive, or we
+  /// are already on a rasterizer thread, in which case the caller rasterizes it inline.
+  bool DispatchDrawCommand(const GPUBackendCommand* cmd);
+
+  /// Joins the pool before dispatching a draw whose texture page or palette overlaps VRAM written
+  /// by draws still in flight, so feedback effects never sample partially rasterized texels.
+  void SyncForTextureFetchHazard(const GPUBackendDrawCommand* cmd);
+
+  void ExecuteDrawCommand(const GPUBackendCommand* cmd);
+  void WakeRasterizerThreads();
+  u32 GetRasterizerQueueDepth(u32 write_ptr) const;
+  void RasterizerThreadEntryPoint(u32 thread_index);
+
   void FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color, GPUBackendCommandParameters params) override;
   void UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, GPUBackendCommandParameters params) override;
   void CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height,
@@ -101,10 +160,18 @@ protected:
   //////////////////////////////////////////////////////////////////////////
   // Rasterization
   //////////////////////////////////////////////////////////////////////////
-  template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
+  /// When generic is set the draw flags are read from the command at runtime and the remaining
+  /// template parameters are ignored; this is the fallback used by the pruned-specialization mode.
+  template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable,
+           bool generic = false>
   void ShadePixel(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u8 color_r, u8 color_g, u8 color_b, u8 texcoord_x,
                   u8 texcoord_y);
 
+  /// Shades a clipped horizontal run with a constant colour, eight pixels per iteration where the
+  /// host supports it. Only valid for untextured, opaque, undithered draws; colour is the final
+  /// 5:5:5:1 value without the mask OR applied.
+  void ShadeFlatSpan(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u32 width, u16 color);
+
   template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
   void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd);
 
@@ -141,12 +208,12 @@ protected:
   void AddIDeltas_DY(i_group& ig, const i_deltas& idl, u32 count = 1);
 
   template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
-           bool dithering_enable>
+           bool dithering_enable, bool generic = false>
   void DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s32 x_start, s32 x_bound, i_group ig,
                 const i_deltas& idl);
 
   template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
-           bool dithering_enable>
+           bool dithering_enable, bool generic = false>
   void DrawTriangle(const GPUBackendDrawPolygonCommand* cmd, const GPUBackendDrawPolygonCommand::Vertex* v0,
                     const GPUBackendDrawPolygonCommand::Vertex* v1, const GPUBackendDrawPolygonCommand::Vertex* v2);
 
@@ -165,4 +232,31 @@ protected:
                                                     const GPUBackendDrawLineCommand::Vertex* p0,
                                                     const GPUBackendDrawLineCommand::Vertex* p1);
   DrawLineFunction GetDrawLineFunction(bool shading_enable, bool transparency_enable, bool dithering_enable);
+
+  struct RasterizerThread
+  {
+    Threading::Thread thread;
+    alignas(64) std::atomic<u32> read_ptr{0};
+  };
+
+  FixedHeapArray<u8, RASTERIZER_QUEUE_SIZE> m_rasterizer_queue_data;
+  alignas(64) std::atomic<u32> m_rasterizer_queue_write_ptr{0};
+
+  std::vector<std::unique_ptr<RasterizerThread>> m_rasterizer_threads;
+  u32 m_num_rasterizer_threads = 0;
+
+  std::mutex m_rasterizer_mutex;
+  std::condition_variable m_rasterizer_wake_cv;
+  std::condition_variable m_rasterizer_idle_cv;
+  u32 m_num_sleeping_rasterizer_threads = 0;
+  bool m_rasterizer_shutdown = false;
+
+  Common::Rectangle<u32> m_vram_dirty_rect{0, 0, VRAM_WIDTH, VRAM_HEIGHT};
+
+  /// Union of the drawing areas of all draws dispatched since the pool was last joined. Only
+  /// touched by the thread feeding the pool, so it needs no synchronization.
+  Common::Rectangle<u32> m_rasterizer_pending_rect;
+
+  /// Index of the calling thread within the rasterizer pool, or -1 outside of it.
+  static thread_local s32 s_rasterizer_thread_index;
 };
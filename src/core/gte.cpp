@@ -14,11 +14,24 @@
 
 #include "common/assert.h"
 #include "common/bitutils.h"
+#include "common/intrin.h"
 
 #include <algorithm>
 #include <array>
 #include <numeric>
 
+// The SIMD fast paths need 128-bit integer operations. SSE2 is baseline on x86, but the RISC-V
+// vector extension is optional, so it needs compiler support and a runtime probe of the kernel's
+// hwcap bits before the vector kernels can be selected.
+#if defined(CPU_ARCH_SSE)
+#define GTE_HAVE_SIMD 1
+#elif defined(CPU_ARCH_RISCV64) && defined(__riscv_vector) && defined(__linux__)
+#include <riscv_vector.h>
+#include <sys/auxv.h>
+#define GTE_HAVE_SIMD 1
+#define GTE_SIMD_RUNTIME_DETECT 1
+#endif
+
 namespace GTE {
 
 static constexpr s64 MAC0_MIN_VALUE = -(INT64_C(1) << 31);
@@ -46,9 +59,15 @@ ALWAYS_INLINE static u32 CountLeadingBits(u32 value)
   return (value == 0u) ? 32 : CountLeadingZeros(value);
 }
 
-template<u32 index>
+// The FLAGS parameter on the helpers and command implementations below compiles out all FLAG
+// register updates when the code cache has proven the flags dead. Saturation and truncation of
+// the result values is unaffected, only the bookkeeping of which saturations happened goes away.
+template<u32 index, bool FLAGS = true>
 ALWAYS_INLINE static void CheckMACOverflow(s64 value)
 {
+  if constexpr (!FLAGS)
+    return;
+
   constexpr s64 MIN_VALUE = (index == 0) ? MAC0_MIN_VALUE : MAC123_MIN_VALUE;
   constexpr s64 MAX_VALUE = (index == 0) ? MAC0_MAX_VALUE : MAC123_MAX_VALUE;
   if (value < MIN_VALUE)
@@ -75,17 +94,17 @@ ALWAYS_INLINE static void CheckMACOverflow(s64 value)
   }
 }
 
-template<u32 index>
+template<u32 index, bool FLAGS = true>
 ALWAYS_INLINE static s64 SignExtendMACResult(s64 value)
 {
-  CheckMACOverflow<index>(value);
+  CheckMACOverflow<index, FLAGS>(value);
   return SignExtendN < index == 0 ? 31 : 44 > (value);
 }
 
-template<u32 index>
+template<u32 index, bool FLAGS = true>
 ALWAYS_INLINE static void TruncateAndSetMAC(s64 value, u8 shift)
 {
-  CheckMACOverflow<index>(value);
+  CheckMACOverflow<index, FLAGS>(value);
 
   // shift should be done before storing to avoid losing precision
   value >>= shift;
@@ -93,7 +112,7 @@ ALWAYS_INLINE static void TruncateAndSetMAC(s64 value, u8 shift)
   REGS.dr32[24 + index] = Truncate32(static_cast<u64>(value));
 }
 
-template<u32 index>
+template<u32 index, bool FLAGS = true>
 ALWAYS_INLINE static void TruncateAndSetIR(s32 value, bool lm)
 {
   constexpr s32 MIN_VALUE = (index == 0) ? IR0_MIN_VALUE : IR123_MIN_VALUE;
@@ -102,7 +121,9 @@ ALWAYS_INLINE static void TruncateAndSetIR(s32 value, bool lm)
   if (value < actual_min_value)
   {
     value = actual_min_value;
-    if constexpr (index == 0)
+    if constexpr (!FLAGS)
+      ;
+    else if constexpr (index == 0)
       REGS.FLAG.ir0_saturated = true;
     else if constexpr (index == 1)
       REGS.FLAG.ir1_saturated = true;
@@ -114,7 +135,9 @@ ALWAYS_INLINE static void TruncateAndSetIR(s32 value, bool lm)
   else if (value > MAX_VALUE)
   {
     value = MAX_VALUE;
-    if constexpr (index == 0)
+    if constexpr (!FLAGS)
+      ;
+    else if constexpr (index == 0)
       REGS.FLAG.ir0_saturated = true;
     else if constexpr (index == 1)
       REGS.FLAG.ir1_saturated = true;
@@ -128,10 +151,10 @@ ALWAYS_INLINE static void TruncateAndSetIR(s32 value, bool lm)
   REGS.dr32[8 + index] = value;
 }
 
-template<u32 index>
+template<u32 index, bool FLAGS = true>
 ALWAYS_INLINE static void TruncateAndSetMACAndIR(s64 value, u8 shift, bool lm)
 {
-  CheckMACOverflow<index>(value);
+  CheckMACOverflow<index, FLAGS>(value);
 
   // shift should be done before storing to avoid losing precision
   value >>= shift;
@@ -141,15 +164,17 @@ ALWAYS_INLINE static void TruncateAndSetMACAndIR(s64 value, u8 shift, bool lm)
   REGS.dr32[24 + index] = value32;
 
   // set IR
-  TruncateAndSetIR<index>(value32, lm);
+  TruncateAndSetIR<index, FLAGS>(value32, lm);
 }
 
-template<u32 index>
+template<u32 index, bool FLAGS = true>
 ALWAYS_INLINE static u32 TruncateRGB(s32 value)
 {
   if (value < 0 || value > 0xFF)
   {
-    if constexpr (index == 0)
+    if constexpr (!FLAGS)
+      ;
+    else if constexpr (index == 0)
       REGS.FLAG.color_r_saturated = true;
     else if constexpr (index == 1)
       REGS.FLAG.color_g_saturated = true;
@@ -162,45 +187,116 @@ ALWAYS_INLINE static u32 TruncateRGB(s32 value)
   return static_cast<u32>(value);
 }
 
+template<bool FLAGS>
 static void SetOTZ(s32 value);
+template<bool FLAGS>
 static void PushSXY(s32 x, s32 y);
+template<bool FLAGS>
 static void PushSZ(s32 value);
+template<bool FLAGS>
 static void PushRGBFromMAC();
+template<bool FLAGS>
 static u32 UNRDivide(u32 lhs, u32 rhs);
+static s64 ComputeAspectCorrectedSX(s64 result);
 
+template<bool FLAGS>
 static void MulMatVec(const s16* M_, const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm);
+template<bool FLAGS>
 static void MulMatVec(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm);
+template<bool FLAGS>
 static void MulMatVecBuggy(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm);
 
+template<bool FLAGS>
 static void InterpolateColor(s64 in_MAC1, s64 in_MAC2, s64 in_MAC3, u8 shift, bool lm);
+template<bool FLAGS>
 static void RTPS(const s16 V[3], u8 shift, bool lm, bool last);
+
+#ifdef GTE_HAVE_SIMD
+static bool UseSIMDPath();
+static bool MulMatVecFast(const s16* M_, const s32 T[3], s16 Vx, s16 Vy, s16 Vz, s64 dots[3]);
+template<bool FLAGS>
+static void RTPS_SIMD(const s16 V[3], u8 shift, bool lm, bool last);
+template<bool FLAGS>
+static void NCMatVecs_SIMD(const s16 V[3], u8 shift, bool lm);
+template<bool FLAGS>
+static void NCS_SIMD(const s16 V[3], u8 shift, bool lm);
+template<bool FLAGS>
+static void NCCS_SIMD(const s16 V[3], u8 shift, bool lm);
+template<bool FLAGS>
+static void NCDS_SIMD(const s16 V[3], u8 shift, bool lm);
+template<bool FLAGS>
+static void Execute_MVMVA_SIMD(Instruction inst);
+template<bool FLAGS>
+static void Execute_RTPS_SIMD(Instruction inst);
+template<bool FLAGS>
+static void Execute_RTPT_SIMD(Instruction inst);
+template<bool FLAGS>
+static void Execute_NCS_SIMD(Instruction inst);
+template<bool FLAGS>
+static void Execute_NCT_SIMD(Instruction inst);
+template<bool FLAGS>
+static void Execute_NCCS_SIMD(Instruction inst);
+template<bool FLAGS>
+static void Execute_NCCT_SIMD(Instruction inst);
+template<bool FLAGS>
+static void Execute_NCDS_SIMD(Instruction inst);
+template<bool FLAGS>
+static void Execute_NCDT_SIMD(Instruction inst);
+#endif
+template<bool FLAGS>
 static void NCS(const s16 V[3], u8 shift, bool lm);
+template<bool FLAGS>
 static void NCCS(const s16 V[3], u8 shift, bool lm);
+template<bool FLAGS>
 static void NCDS(const s16 V[3], u8 shift, bool lm);
+template<bool FLAGS>
 static void DPCS(const u8 color[3], u8 shift, bool lm);
 
+template<bool FLAGS>
 static void Execute_MVMVA(Instruction inst);
+template<bool FLAGS>
 static void Execute_SQR(Instruction inst);
+template<bool FLAGS>
 static void Execute_OP(Instruction inst);
+template<bool FLAGS>
 static void Execute_RTPS(Instruction inst);
+template<bool FLAGS>
 static void Execute_RTPT(Instruction inst);
+template<bool FLAGS>
 static void Execute_NCLIP(Instruction inst);
+template<bool FLAGS>
 static void Execute_NCLIP_PGXP(Instruction inst);
+template<bool FLAGS>
 static void Execute_AVSZ3(Instruction inst);
+template<bool FLAGS>
 static void Execute_AVSZ4(Instruction inst);
+template<bool FLAGS>
 static void Execute_NCS(Instruction inst);
+template<bool FLAGS>
 static void Execute_NCT(Instruction inst);
+template<bool FLAGS>
 static void Execute_NCCS(Instruction inst);
+template<bool FLAGS>
 static void Execute_NCCT(Instruction inst);
+template<bool FLAGS>
 static void Execute_NCDS(Instruction inst);
+template<bool FLAGS>
 static void Execute_NCDT(Instruction inst);
+template<bool FLAGS>
 static void Execute_CC(Instruction inst);
+template<bool FLAGS>
 static void Execute_CDP(Instruction inst);
+template<bool FLAGS>
 static void Execute_DPCS(Instruction inst);
+template<bool FLAGS>
 static void Execute_DPCT(Instruction inst);
+template<bool FLAGS>
 static void Execute_DCPL(Instruction inst);
+template<bool FLAGS>
 static void Execute_INTPL(Instruction inst);
+template<bool FLAGS>
 static void Execute_GPL(Instruction inst);
+template<bool FLAGS>
 static void Execute_GPF(Instruction inst);
 
 } // namespace GTE
@@ -397,43 +493,51 @@ u32* GTE::GetRegisterPtr(u32 index)
   return &REGS.r32[index];
 }
 
+template<bool FLAGS>
 ALWAYS_INLINE void GTE::SetOTZ(s32 value)
 {
   if (value < 0)
   {
-    REGS.FLAG.sz1_otz_saturated = true;
+    if constexpr (FLAGS)
+      REGS.FLAG.sz1_otz_saturated = true;
     value = 0;
   }
   else if (value > 0xFFFF)
   {
-    REGS.FLAG.sz1_otz_saturated = true;
+    if constexpr (FLAGS)
+      REGS.FLAG.sz1_otz_saturated = true;
     value = 0xFFFF;
   }
 
   REGS.dr32[7] = static_cast<u32>(value);
 }
 
+template<bool FLAGS>
 ALWAYS_INLINE void GTE::PushSXY(s32 x, s32 y)
 {
   if (x < -1024)
   {
-    REGS.FLAG.sx2_saturated = true;
+    if constexpr (FLAGS)
+      REGS.FLAG.sx2_saturated = true;
     x = -1024;
   }
   else if (x > 1023)
   {
-    REGS.FLAG.sx2_saturated = true;
+    if constexpr (FLAGS)
+      REGS.FLAG.sx2_saturated = true;
     x = 1023;
   }
 
   if (y < -1024)
   {
-    REGS.FLAG.sy2_saturated = true;
+    if constexpr (FLAGS)
+      REGS.FLAG.sy2_saturated = true;
     y = -1024;
   }
   else if (y > 1023)
   {
-    REGS.FLAG.sy2_saturated = true;
+    if constexpr (FLAGS)
+      REGS.FLAG.sy2_saturated = true;
     y = 1023;
   }
 
@@ -442,16 +546,19 @@ ALWAYS_INLINE void GTE::PushSXY(s32 x, s32 y)
   REGS.dr32[14] = (static_cast<u32>(x) & 0xFFFFu) | (static_cast<u32>(y) << 16);
 }
 
+template<bool FLAGS>
 ALWAYS_INLINE void GTE::PushSZ(s32 value)
 {
   if (value < 0)
   {
-    REGS.FLAG.sz1_otz_saturated = true;
+    if constexpr (FLAGS)
+      REGS.FLAG.sz1_otz_saturated = true;
     value = 0;
   }
   else if (value > 0xFFFF)
   {
-    REGS.FLAG.sz1_otz_saturated = true;
+    if constexpr (FLAGS)
+      REGS.FLAG.sz1_otz_saturated = true;
     value = 0xFFFF;
   }
 
@@ -461,12 +568,13 @@ ALWAYS_INLINE void GTE::PushSZ(s32 value)
   REGS.dr32[19] = static_cast<u32>(value); // SZ3 <- value
 }
 
+template<bool FLAGS>
 ALWAYS_INLINE void GTE::PushRGBFromMAC()
 {
   // Note: SHR 4 used instead of /16 as the results are different.
-  const u32 r = TruncateRGB<0>(static_cast<u32>(REGS.MAC1 >> 4));
-  const u32 g = TruncateRGB<1>(static_cast<u32>(REGS.MAC2 >> 4));
-  const u32 b = TruncateRGB<2>(static_cast<u32>(REGS.MAC3 >> 4));
+  const u32 r = TruncateRGB<0, FLAGS>(static_cast<u32>(REGS.MAC1 >> 4));
+  const u32 g = TruncateRGB<1, FLAGS>(static_cast<u32>(REGS.MAC2 >> 4));
+  const u32 b = TruncateRGB<2, FLAGS>(static_cast<u32>(REGS.MAC3 >> 4));
   const u32 c = ZeroExtend32(REGS.RGBC[3]);
 
   REGS.dr32[20] = REGS.dr32[21];                        // RGB0 <- RGB1
@@ -474,11 +582,13 @@ ALWAYS_INLINE void GTE::PushRGBFromMAC()
   REGS.dr32[22] = r | (g << 8) | (b << 16) | (c << 24); // RGB2 <- Value
 }
 
+template<bool FLAGS>
 ALWAYS_INLINE u32 GTE::UNRDivide(u32 lhs, u32 rhs)
 {
   if (rhs * 2 <= lhs)
   {
-    REGS.FLAG.divide_overflow = true;
+    if constexpr (FLAGS)
+      REGS.FLAG.divide_overflow = true;
     return 0x1FFFF;
   }
 
@@ -518,13 +628,15 @@ ALWAYS_INLINE u32 GTE::UNRDivide(u32 lhs, u32 rhs)
   return std::min<u32>(0x1FFFF, result);
 }
 
+template<bool FLAGS>
 void GTE::MulMatVec(const s16* M_, const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm)
 {
 #define M(i, j) M_[((i)*3) + (j)]
 #define dot3(i)                                                                                                        \
-  TruncateAndSetMACAndIR<i + 1>(SignExtendMACResult<i + 1>((s64(M(i, 0)) * s64(Vx)) + (s64(M(i, 1)) * s64(Vy))) +      \
-                                  (s64(M(i, 2)) * s64(Vz)),                                                            \
-                                shift, lm)
+  TruncateAndSetMACAndIR<i + 1, FLAGS>(                                                                                \
+    SignExtendMACResult<i + 1, FLAGS>((s64(M(i, 0)) * s64(Vx)) + (s64(M(i, 1)) * s64(Vy))) +                           \
+      (s64(M(i, 2)) * s64(Vz)),                                                                                        \
+    shift, lm)
 
   dot3(0);
   dot3(1);
@@ -534,13 +646,14 @@ void GTE::MulMatVec(const s16* M_, const s16 Vx, const s16 Vy, const s16 Vz, u8
 #undef M
 }
 
+template<bool FLAGS>
 void GTE::MulMatVec(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm)
 {
 #define M(i, j) M_[((i)*3) + (j)]
 #define dot3(i)                                                                                                        \
-  TruncateAndSetMACAndIR<i + 1>(                                                                                       \
-    SignExtendMACResult<i + 1>(SignExtendMACResult<i + 1>((s64(T[i]) << 12) + (s64(M(i, 0)) * s64(Vx))) +              \
-                               (s64(M(i, 1)) * s64(Vy))) +                                                             \
+  TruncateAndSetMACAndIR<i + 1, FLAGS>(                                                                                \
+    SignExtendMACResult<i + 1, FLAGS>(                                                                                 \
+      SignExtendMACResult<i + 1, FLAGS>((s64(T[i]) << 12) + (s64(M(i, 0)) * s64(Vx))) + (s64(M(i, 1)) * s64(Vy))) +    \
       (s64(M(i, 2)) * s64(Vz)),                                                                                        \
     shift, lm)
 
@@ -552,18 +665,20 @@ void GTE::MulMatVec(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, c
 #undef M
 }
 
+template<bool FLAGS>
 void GTE::MulMatVecBuggy(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm)
 {
 #define M(i, j) M_[((i)*3) + (j)]
 #define dot3(i)                                                                                                        \
   do                                                                                                                   \
   {                                                                                                                    \
-    TruncateAndSetIR<i + 1>(static_cast<s32>(SignExtendMACResult<i + 1>(SignExtendMACResult<i + 1>(                    \
-                                               (s64(T[i]) << 12) + (s64(M(i, 0)) * s64(Vx)))) >>                       \
-                                             shift),                                                                   \
-                            false);                                                                                    \
-    TruncateAndSetMACAndIR<i + 1>(SignExtendMACResult<i + 1>((s64(M(i, 1)) * s64(Vy))) + (s64(M(i, 2)) * s64(Vz)),     \
-                                  shift, lm);                                                                          \
+    TruncateAndSetIR<i + 1, FLAGS>(static_cast<s32>(SignExtendMACResult<i + 1, FLAGS>(SignExtendMACResult<i + 1, FLAGS>( \
+                                                      (s64(T[i]) << 12) + (s64(M(i, 0)) * s64(Vx)))) >>                \
+                                                    shift),                                                            \
+                                   false);                                                                             \
+    TruncateAndSetMACAndIR<i + 1, FLAGS>(SignExtendMACResult<i + 1, FLAGS>((s64(M(i, 1)) * s64(Vy))) +                 \
+                                           (s64(M(i, 2)) * s64(Vz)),                                                   \
+                                         shift, lm);                                                                   \
   } while (0)
 
   dot3(0);
@@ -574,9 +689,11 @@ void GTE::MulMatVecBuggy(const s16* M_, const s32 T[3], const s16 Vx, const s16
 #undef M
 }
 
+template<bool FLAGS>
 void GTE::Execute_MVMVA(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   static constexpr const s16* M_lookup[4] = {&REGS.RT[0][0], &REGS.LLM[0][0], &REGS.LCM[0][0], nullptr};
   static constexpr const s16* V_lookup[4][3] = {
@@ -612,16 +729,19 @@ void GTE::Execute_MVMVA(Instruction inst)
   const s16 Vy = *V[1];
   const s16 Vz = *V[2];
   if (inst.mvmva_translation_vector != 2)
-    MulMatVec(M, T, Vx, Vy, Vz, inst.GetShift(), inst.lm);
+    MulMatVec<FLAGS>(M, T, Vx, Vy, Vz, inst.GetShift(), inst.lm);
   else
-    MulMatVecBuggy(M, T, Vx, Vy, Vz, inst.GetShift(), inst.lm);
+    MulMatVecBuggy<FLAGS>(M, T, Vx, Vy, Vz, inst.GetShift(), inst.lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_SQR(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   // 32-bit multiply for speed - 16x16 isn't >32bit, and we know it won't overflow/underflow.
   const u8 shift = inst.GetShift();
@@ -630,16 +750,19 @@ void GTE::Execute_SQR(Instruction inst)
   REGS.MAC3 = (s32(REGS.IR3) * s32(REGS.IR3)) >> shift;
 
   const bool lm = inst.lm;
-  TruncateAndSetIR<1>(REGS.MAC1, lm);
-  TruncateAndSetIR<2>(REGS.MAC2, lm);
-  TruncateAndSetIR<3>(REGS.MAC3, lm);
+  TruncateAndSetIR<1, FLAGS>(REGS.MAC1, lm);
+  TruncateAndSetIR<2, FLAGS>(REGS.MAC2, lm);
+  TruncateAndSetIR<3, FLAGS>(REGS.MAC3, lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_OP(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   // Take copies since we overwrite them in each step.
   const u8 shift = inst.GetShift();
@@ -653,18 +776,48 @@ void GTE::Execute_OP(Instruction inst)
 
   // [MAC1,MAC2,MAC3] = [IR3*D2-IR2*D3, IR1*D3-IR3*D1, IR2*D1-IR1*D2] SAR (sf*12)
   // [IR1, IR2, IR3] = [MAC1, MAC2, MAC3]; copy result
-  TruncateAndSetMACAndIR<1>(s64(IR3 * D2) - s64(IR2 * D3), shift, lm);
-  TruncateAndSetMACAndIR<2>(s64(IR1 * D3) - s64(IR3 * D1), shift, lm);
-  TruncateAndSetMACAndIR<3>(s64(IR2 * D1) - s64(IR1 * D2), shift, lm);
+  TruncateAndSetMACAndIR<1, FLAGS>(s64(IR3 * D2) - s64(IR2 * D3), shift, lm);
+  TruncateAndSetMACAndIR<2, FLAGS>(s64(IR1 * D3) - s64(IR3 * D1), shift, lm);
+  TruncateAndSetMACAndIR<3, FLAGS>(s64(IR2 * D1) - s64(IR1 * D2), shift, lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+ALWAYS_INLINE s64 GTE::ComputeAspectCorrectedSX(s64 result)
+{
+  switch (s_aspect_ratio)
+  {
+    case DisplayAspectRatio::R16_9:
+      return ((((s64(result) * s64(REGS.IR1)) * s64(3)) / s64(4)) + s64(REGS.OFX));
+
+    case DisplayAspectRatio::R19_9:
+      return ((((s64(result) * s64(REGS.IR1)) * s64(12)) / s64(19)) + s64(REGS.OFX));
+
+    case DisplayAspectRatio::R20_9:
+      return ((((s64(result) * s64(REGS.IR1)) * s64(3)) / s64(5)) + s64(REGS.OFX));
+
+    case DisplayAspectRatio::Custom:
+    case DisplayAspectRatio::MatchWindow:
+      return ((((s64(result) * s64(REGS.IR1)) * s64(s_custom_aspect_ratio_numerator)) /
+               s64(s_custom_aspect_ratio_denominator)) +
+              s64(REGS.OFX));
+
+    case DisplayAspectRatio::Auto:
+    case DisplayAspectRatio::R4_3:
+    case DisplayAspectRatio::PAR1_1:
+    default:
+      return (s64(result) * s64(REGS.IR1) + s64(REGS.OFX));
+  }
+}
+
+template<bool FLAGS>
 void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
 {
 #define dot3(i)                                                                                                        \
-  SignExtendMACResult<i + 1>(SignExtendMACResult<i + 1>((s64(REGS.TR[i]) << 12) + (s64(REGS.RT[i][0]) * s64(V[0]))) +  \
-                             (s64(REGS.RT[i][1]) * s64(V[1]))) +                                                       \
+  SignExtendMACResult<i + 1, FLAGS>(                                                                                   \
+    SignExtendMACResult<i + 1, FLAGS>((s64(REGS.TR[i]) << 12) + (s64(REGS.RT[i][0]) * s64(V[0]))) +                    \
+    (s64(REGS.RT[i][1]) * s64(V[1]))) +                                                                                \
     (s64(REGS.RT[i][2]) * s64(V[2]))
 
   // IR1 = MAC1 = (TRX*1000h + RT11*VX0 + RT12*VY0 + RT13*VZ0) SAR (sf*12)
@@ -673,60 +826,31 @@ void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
   const s64 x = dot3(0);
   const s64 y = dot3(1);
   const s64 z = dot3(2);
-  TruncateAndSetMAC<1>(x, shift);
-  TruncateAndSetMAC<2>(y, shift);
-  TruncateAndSetMAC<3>(z, shift);
-  TruncateAndSetIR<1>(REGS.MAC1, lm);
-  TruncateAndSetIR<2>(REGS.MAC2, lm);
+  TruncateAndSetMAC<1, FLAGS>(x, shift);
+  TruncateAndSetMAC<2, FLAGS>(y, shift);
+  TruncateAndSetMAC<3, FLAGS>(z, shift);
+  TruncateAndSetIR<1, FLAGS>(REGS.MAC1, lm);
+  TruncateAndSetIR<2, FLAGS>(REGS.MAC2, lm);
 
   // The command does saturate IR1,IR2,IR3 to -8000h..+7FFFh (regardless of lm bit). When using RTP with sf=0, then the
   // IR3 saturation flag (FLAG.22) gets set <only> if "MAC3 SAR 12" exceeds -8000h..+7FFFh (although IR3 is saturated
   // when "MAC3" exceeds -8000h..+7FFFh).
-  TruncateAndSetIR<3>(s32(z >> 12), false);
+  TruncateAndSetIR<3, FLAGS>(s32(z >> 12), false);
   REGS.dr32[11] = std::clamp(REGS.MAC3, lm ? 0 : IR123_MIN_VALUE, IR123_MAX_VALUE);
 #undef dot3
 
   // SZ3 = MAC3 SAR ((1-sf)*12)                           ;ScreenZ FIFO 0..+FFFFh
-  PushSZ(s32(z >> 12));
+  PushSZ<FLAGS>(s32(z >> 12));
 
   // MAC0=(((H*20000h/SZ3)+1)/2)*IR1+OFX, SX2=MAC0/10000h ;ScrX FIFO -400h..+3FFh
   // MAC0=(((H*20000h/SZ3)+1)/2)*IR2+OFY, SY2=MAC0/10000h ;ScrY FIFO -400h..+3FFh
-  const s64 result = static_cast<s64>(ZeroExtend64(UNRDivide(REGS.H, REGS.SZ3)));
-
-  s64 Sx;
-  switch (s_aspect_ratio)
-  {
-    case DisplayAspectRatio::R16_9:
-      Sx = ((((s64(result) * s64(REGS.IR1)) * s64(3)) / s64(4)) + s64(REGS.OFX));
-      break;
-
-    case DisplayAspectRatio::R19_9:
-      Sx = ((((s64(result) * s64(REGS.IR1)) * s64(12)) / s64(19)) + s64(REGS.OFX));
-      break;
-
-    case DisplayAspectRatio::R20_9:
-      Sx = ((((s64(result) * s64(REGS.IR1)) * s64(3)) / s64(5)) + s64(REGS.OFX));
-      break;
-
-    case DisplayAspectRatio::Custom:
-    case DisplayAspectRatio::MatchWindow:
-      Sx = ((((s64(result) * s64(REGS.IR1)) * s64(s_custom_aspect_ratio_numerator)) /
-             s64(s_custom_aspect_ratio_denominator)) +
-            s64(REGS.OFX));
-      break;
-
-    case DisplayAspectRatio::Auto:
-    case DisplayAspectRatio::R4_3:
-    case DisplayAspectRatio::PAR1_1:
-    default:
-      Sx = (s64(result) * s64(REGS.IR1) + s64(REGS.OFX));
-      break;
-  }
+  const s64 result = static_cast<s64>(ZeroExtend64(UNRDivide<FLAGS>(REGS.H, REGS.SZ3)));
 
+  const s64 Sx = ComputeAspectCorrectedSX(result);
   const s64 Sy = s64(result) * s64(REGS.IR2) + s64(REGS.OFY);
-  CheckMACOverflow<0>(Sx);
-  CheckMACOverflow<0>(Sy);
-  PushSXY(s32(Sx >> 16), s32(Sy >> 16));
+  CheckMACOverflow<0, FLAGS>(Sx);
+  CheckMACOverflow<0, FLAGS>(Sy);
+  PushSXY<FLAGS>(s32(Sx >> 16), s32(Sy >> 16));
 
   if (g_settings.gpu_pgxp_enable)
   {
@@ -801,178 +925,566 @@ void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
   {
     // MAC0=(((H*20000h/SZ3)+1)/2)*DQA+DQB, IR0=MAC0/1000h  ;Depth cueing 0..+1000h
     const s64 Sz = s64(result) * s64(REGS.DQA) + s64(REGS.DQB);
-    TruncateAndSetMAC<0>(Sz, 0);
-    TruncateAndSetIR<0>(s32(Sz >> 12), true);
+    TruncateAndSetMAC<0, FLAGS>(Sz, 0);
+    TruncateAndSetIR<0, FLAGS>(s32(Sz >> 12), true);
   }
 }
 
+template<bool FLAGS>
 void GTE::Execute_RTPS(Instruction inst)
 {
-  REGS.FLAG.Clear();
-  RTPS(REGS.V0, inst.GetShift(), inst.lm, true);
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
+  RTPS<FLAGS>(REGS.V0, inst.GetShift(), inst.lm, true);
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_RTPT(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
+
+  const u8 shift = inst.GetShift();
+  const bool lm = inst.lm;
+
+  RTPS<FLAGS>(REGS.V0, shift, lm, false);
+  RTPS<FLAGS>(REGS.V1, shift, lm, false);
+  RTPS<FLAGS>(REGS.V2, shift, lm, true);
+
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
+}
+
+#ifdef GTE_HAVE_SIMD
+
+ALWAYS_INLINE bool GTE::UseSIMDPath()
+{
+#ifdef GTE_SIMD_RUNTIME_DETECT
+  // RVA20 cores ship without the vector extension, so the kernel's hwcap has to be probed instead
+  // of trusting whatever -march the binary was built with.
+  static const bool supported = ((getauxval(AT_HWCAP) & (1ul << ('V' - 'A'))) != 0);
+  return supported;
+#else
+  return true;
+#endif
+}
+
+// Conservative window around the 44-bit MAC limits. The product of two s16s is below 2^30, so as
+// long as the running sum stays this far inside the limits, no intermediate step can have
+// overflowed either, the nested sign-extensions are the identity, and no MAC1-3 flags get set.
+static constexpr s64 MAC123_FAST_MIN_VALUE = GTE::MAC123_MIN_VALUE + (INT64_C(1) << 31);
+static constexpr s64 MAC123_FAST_MAX_VALUE = GTE::MAC123_MAX_VALUE - (INT64_C(1) << 31);
+
+#if defined(CPU_ARCH_SSE)
+
+ALWAYS_INLINE bool GTE::MulMatVecFast(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz,
+                                      s64 dots[3])
+{
+  // pmaddwd against [Vx, Vy, Vz, 0] yields (M0*Vx + M1*Vy) and (M2*Vz + junk*0) per row. The row
+  // loads read one element past the row, which is multiplied by zero and stays inside the
+  // register file.
+  const __m128i vvec = _mm_setr_epi16(Vx, Vy, Vz, 0, 0, 0, 0, 0);
+  const __m128i row0 = _mm_madd_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(M_)), vvec);
+  const __m128i row1 = _mm_madd_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(M_ + 3)), vvec);
+  const __m128i row2 = _mm_madd_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(M_ + 6)), vvec);
+
+  bool fast = true;
+  const auto sum = [&fast](const __m128i row, const s32 t) {
+    // (T << 12) + M0*Vx + M1*Vy is the last point the hardware checks before adding the final
+    // product, so both it and the total have to stay inside the window.
+    const s64 partial = (s64(t) << 12) + s64(_mm_cvtsi128_si32(row));
+    const s64 total = partial + s64(_mm_cvtsi128_si32(_mm_srli_si128(row, 4)));
+    fast &= (partial >= MAC123_FAST_MIN_VALUE && partial <= MAC123_FAST_MAX_VALUE &&
+             total >= MAC123_FAST_MIN_VALUE && total <= MAC123_FAST_MAX_VALUE);
+    return total;
+  };
+
+  dots[0] = sum(row0, T[0]);
+  dots[1] = sum(row1, T[1]);
+  dots[2] = sum(row2, T[2]);
+  return fast;
+}
+
+#elif defined(CPU_ARCH_RISCV64)
+
+ALWAYS_INLINE bool GTE::MulMatVecFast(const s16* M_, const s32 T[3], const s16 Vx, const s16 Vy, const s16 Vz,
+                                      s64 dots[3])
+{
+  // Widening multiply + reduction per row, with vl=3 so the loads never leave the row. The s32
+  // products get reduced straight into an s64 scalar, since three products of up to 2^30 can
+  // overflow 32 bits.
+  const s16 vbuf[3] = {Vx, Vy, Vz};
+  const vint16mf2_t vvec = __riscv_vle16_v_i16mf2(vbuf, 3);
+  const vint64m1_t vzero = __riscv_vmv_s_x_i64m1(0, 1);
+
+  bool fast = true;
+  const auto dot = [&](const s16* row, const s32 t) {
+    const vint32m1_t prod = __riscv_vwmul_vv_i32m1(__riscv_vle16_v_i16mf2(row, 3), vvec, 3);
+    const s64 total = (s64(t) << 12) + __riscv_vmv_x_s_i64m1_i64(__riscv_vwredsum_vs_i32m1_i64m1(prod, vzero, 3));
+
+    // Every running sum the hardware checks lies within two products (2^31) of the total, which is
+    // exactly the window margin, so checking the total alone covers the intermediates too.
+    fast &= (total >= MAC123_FAST_MIN_VALUE && total <= MAC123_FAST_MAX_VALUE);
+    return total;
+  };
+
+  dots[0] = dot(M_, T[0]);
+  dots[1] = dot(M_ + 3, T[1]);
+  dots[2] = dot(M_ + 6, T[2]);
+  return fast;
+}
+
+#endif
+
+template<bool FLAGS>
+ALWAYS_INLINE_RELEASE void GTE::RTPS_SIMD(const s16 V[3], u8 shift, bool lm, bool last)
+{
+  s64 dots[3];
+  if (!MulMatVecFast(&REGS.RT[0][0], REGS.TR, V[0], V[1], V[2], dots))
+  {
+    // Too close to the MAC limits, the flag-exact scalar path has to run.
+    RTPS<FLAGS>(V, shift, lm, last);
+    return;
+  }
+
+  const s64 z = dots[2];
+  TruncateAndSetMAC<1, FLAGS>(dots[0], shift);
+  TruncateAndSetMAC<2, FLAGS>(dots[1], shift);
+  TruncateAndSetMAC<3, FLAGS>(z, shift);
+  TruncateAndSetIR<1, FLAGS>(REGS.MAC1, lm);
+  TruncateAndSetIR<2, FLAGS>(REGS.MAC2, lm);
+  TruncateAndSetIR<3, FLAGS>(s32(z >> 12), false);
+  REGS.dr32[11] = std::clamp(REGS.MAC3, lm ? 0 : IR123_MIN_VALUE, IR123_MAX_VALUE);
+
+  PushSZ<FLAGS>(s32(z >> 12));
+
+  const s64 result = static_cast<s64>(ZeroExtend64(UNRDivide<FLAGS>(REGS.H, REGS.SZ3)));
+  const s64 Sx = ComputeAspectCorrectedSX(result);
+  const s64 Sy = s64(result) * s64(REGS.IR2) + s64(REGS.OFY);
+  CheckMACOverflow<0, FLAGS>(Sx);
+  CheckMACOverflow<0, FLAGS>(Sy);
+  PushSXY<FLAGS>(s32(Sx >> 16), s32(Sy >> 16));
+
+  if (last)
+  {
+    const s64 Sz = s64(result) * s64(REGS.DQA) + s64(REGS.DQB);
+    TruncateAndSetMAC<0, FLAGS>(Sz, 0);
+    TruncateAndSetIR<0, FLAGS>(s32(Sz >> 12), true);
+  }
+}
+
+template<bool FLAGS>
+void GTE::Execute_RTPS_SIMD(Instruction inst)
+{
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
+  RTPS_SIMD<FLAGS>(REGS.V0, inst.GetShift(), inst.lm, true);
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
+}
+
+template<bool FLAGS>
+void GTE::Execute_RTPT_SIMD(Instruction inst)
+{
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
+
+  const u8 shift = inst.GetShift();
+  const bool lm = inst.lm;
+
+  RTPS_SIMD<FLAGS>(REGS.V0, shift, lm, false);
+  RTPS_SIMD<FLAGS>(REGS.V1, shift, lm, false);
+  RTPS_SIMD<FLAGS>(REGS.V2, shift, lm, true);
+
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
+}
+
+template<bool FLAGS>
+void GTE::Execute_MVMVA_SIMD(Instruction inst)
+{
+  // The garbage matrix and the buggy FC translation path are rare and tangled up with the flag
+  // order, leave those to the scalar implementation.
+  if (inst.mvmva_multiply_matrix == 3 || inst.mvmva_translation_vector == 2)
+  {
+    Execute_MVMVA<FLAGS>(inst);
+    return;
+  }
+
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
+
+  static constexpr const s16* M_lookup[3] = {&REGS.RT[0][0], &REGS.LLM[0][0], &REGS.LCM[0][0]};
+  static constexpr const s16* V_lookup[4][3] = {
+    {&REGS.V0[0], &REGS.V0[1], &REGS.V0[2]},
+    {&REGS.V1[0], &REGS.V1[1], &REGS.V1[2]},
+    {&REGS.V2[0], &REGS.V2[1], &REGS.V2[2]},
+    {&REGS.IR1, &REGS.IR2, &REGS.IR3},
+  };
+  static constexpr const s32 zero_T[3] = {};
+  static constexpr const s32* T_lookup[4] = {REGS.TR, REGS.BK, REGS.FC, zero_T};
+
+  const s16* M = M_lookup[inst.mvmva_multiply_matrix];
+  const s16* const* const V = V_lookup[inst.mvmva_multiply_vector];
+  const s32* const T = T_lookup[inst.mvmva_translation_vector];
+
+  s64 dots[3];
+  if (MulMatVecFast(M, T, *V[0], *V[1], *V[2], dots))
+  {
+    const u8 shift = inst.GetShift();
+    const bool lm = inst.lm;
+    TruncateAndSetMACAndIR<1, FLAGS>(dots[0], shift, lm);
+    TruncateAndSetMACAndIR<2, FLAGS>(dots[1], shift, lm);
+    TruncateAndSetMACAndIR<3, FLAGS>(dots[2], shift, lm);
+  }
+  else
+  {
+    // Too close to the MAC limits, the flag-exact scalar path has to run.
+    MulMatVec<FLAGS>(M, T, *V[0], *V[1], *V[2], inst.GetShift(), inst.lm);
+  }
+
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
+}
+
+// The shared front half of the NCx family: [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (LLM*V) SAR (sf*12),
+// then (BK*1000h + LCM*IR) SAR (sf*12). Each mat-vec independently drops to the flag-exact scalar
+// path when it gets too close to the MAC limits.
+template<bool FLAGS>
+ALWAYS_INLINE_RELEASE void GTE::NCMatVecs_SIMD(const s16 V[3], u8 shift, bool lm)
+{
+  static constexpr s32 zero_T[3] = {};
+
+  s64 dots[3];
+  if (MulMatVecFast(&REGS.LLM[0][0], zero_T, V[0], V[1], V[2], dots))
+  {
+    TruncateAndSetMACAndIR<1, FLAGS>(dots[0], shift, lm);
+    TruncateAndSetMACAndIR<2, FLAGS>(dots[1], shift, lm);
+    TruncateAndSetMACAndIR<3, FLAGS>(dots[2], shift, lm);
+  }
+  else
+  {
+    MulMatVec<FLAGS>(&REGS.LLM[0][0], V[0], V[1], V[2], shift, lm);
+  }
+
+  if (MulMatVecFast(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, dots))
+  {
+    TruncateAndSetMACAndIR<1, FLAGS>(dots[0], shift, lm);
+    TruncateAndSetMACAndIR<2, FLAGS>(dots[1], shift, lm);
+    TruncateAndSetMACAndIR<3, FLAGS>(dots[2], shift, lm);
+  }
+  else
+  {
+    MulMatVec<FLAGS>(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
+  }
+}
+
+template<bool FLAGS>
+ALWAYS_INLINE_RELEASE void GTE::NCS_SIMD(const s16 V[3], u8 shift, bool lm)
+{
+  NCMatVecs_SIMD<FLAGS>(V, shift, lm);
+
+  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
+  PushRGBFromMAC<FLAGS>();
+}
+
+template<bool FLAGS>
+ALWAYS_INLINE_RELEASE void GTE::NCCS_SIMD(const s16 V[3], u8 shift, bool lm)
+{
+  NCMatVecs_SIMD<FLAGS>(V, shift, lm);
+
+  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4          ;<--- for NCDx/NCCx
+  // [MAC1,MAC2,MAC3] = [MAC1,MAC2,MAC3] SAR (sf*12)       ;<--- for NCDx/NCCx
+  TruncateAndSetMACAndIR<1, FLAGS>(s64(s32(ZeroExtend32(REGS.RGBC[0])) * s32(REGS.IR1)) << 4, shift, lm);
+  TruncateAndSetMACAndIR<2, FLAGS>(s64(s32(ZeroExtend32(REGS.RGBC[1])) * s32(REGS.IR2)) << 4, shift, lm);
+  TruncateAndSetMACAndIR<3, FLAGS>(s64(s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4, shift, lm);
+
+  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
+  PushRGBFromMAC<FLAGS>();
+}
+
+template<bool FLAGS>
+ALWAYS_INLINE_RELEASE void GTE::NCDS_SIMD(const s16 V[3], u8 shift, bool lm)
+{
+  NCMatVecs_SIMD<FLAGS>(V, shift, lm);
+
+  // No need to assign these to MAC[1-3], as it'll never overflow.
+  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4          ;<--- for NCDx/NCCx
+  const s32 in_MAC1 = (s32(ZeroExtend32(REGS.RGBC[0])) * s32(REGS.IR1)) << 4;
+  const s32 in_MAC2 = (s32(ZeroExtend32(REGS.RGBC[1])) * s32(REGS.IR2)) << 4;
+  const s32 in_MAC3 = (s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4;
+
+  // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0                   ;<--- for NCDx only
+  InterpolateColor<FLAGS>(in_MAC1, in_MAC2, in_MAC3, shift, lm);
+
+  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
+  PushRGBFromMAC<FLAGS>();
+}
+
+template<bool FLAGS>
+void GTE::Execute_NCS_SIMD(Instruction inst)
+{
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
+
+  NCS_SIMD<FLAGS>(REGS.V0, inst.GetShift(), inst.lm);
+
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
+}
+
+template<bool FLAGS>
+void GTE::Execute_NCT_SIMD(Instruction inst)
+{
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
+
+  const u8 shift = inst.GetShift();
+  const bool lm = inst.lm;
+
+  NCS_SIMD<FLAGS>(REGS.V0, shift, lm);
+  NCS_SIMD<FLAGS>(REGS.V1, shift, lm);
+  NCS_SIMD<FLAGS>(REGS.V2, shift, lm);
+
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
+}
+
+template<bool FLAGS>
+void GTE::Execute_NCCS_SIMD(Instruction inst)
+{
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
+
+  NCCS_SIMD<FLAGS>(REGS.V0, inst.GetShift(), inst.lm);
+
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
+}
+
+template<bool FLAGS>
+void GTE::Execute_NCCT_SIMD(Instruction inst)
+{
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
-  RTPS(REGS.V0, shift, lm, false);
-  RTPS(REGS.V1, shift, lm, false);
-  RTPS(REGS.V2, shift, lm, true);
+  NCCS_SIMD<FLAGS>(REGS.V0, shift, lm);
+  NCCS_SIMD<FLAGS>(REGS.V1, shift, lm);
+  NCCS_SIMD<FLAGS>(REGS.V2, shift, lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
+void GTE::Execute_NCDS_SIMD(Instruction inst)
+{
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
+
+  NCDS_SIMD<FLAGS>(REGS.V0, inst.GetShift(), inst.lm);
+
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
+}
+
+template<bool FLAGS>
+void GTE::Execute_NCDT_SIMD(Instruction inst)
+{
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
+
+  const u8 shift = inst.GetShift();
+  const bool lm = inst.lm;
+
+  NCDS_SIMD<FLAGS>(REGS.V0, shift, lm);
+  NCDS_SIMD<FLAGS>(REGS.V1, shift, lm);
+  NCDS_SIMD<FLAGS>(REGS.V2, shift, lm);
+
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
+}
+
+#endif // GTE_HAVE_SIMD
+
+template<bool FLAGS>
 void GTE::Execute_NCLIP(Instruction inst)
 {
   // MAC0 =   SX0*SY1 + SX1*SY2 + SX2*SY0 - SX0*SY2 - SX1*SY0 - SX2*SY1
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
-  TruncateAndSetMAC<0>(s64(REGS.SXY0[0]) * s64(REGS.SXY1[1]) + s64(REGS.SXY1[0]) * s64(REGS.SXY2[1]) +
-                         s64(REGS.SXY2[0]) * s64(REGS.SXY0[1]) - s64(REGS.SXY0[0]) * s64(REGS.SXY2[1]) -
-                         s64(REGS.SXY1[0]) * s64(REGS.SXY0[1]) - s64(REGS.SXY2[0]) * s64(REGS.SXY1[1]),
-                       0);
+  TruncateAndSetMAC<0, FLAGS>(s64(REGS.SXY0[0]) * s64(REGS.SXY1[1]) + s64(REGS.SXY1[0]) * s64(REGS.SXY2[1]) +
+                                s64(REGS.SXY2[0]) * s64(REGS.SXY0[1]) - s64(REGS.SXY0[0]) * s64(REGS.SXY2[1]) -
+                                s64(REGS.SXY1[0]) * s64(REGS.SXY0[1]) - s64(REGS.SXY2[0]) * s64(REGS.SXY1[1]),
+                              0);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_NCLIP_PGXP(Instruction inst)
 {
   if (CPU::PGXP::GTE_NCLIP_valid(REGS.dr32[12], REGS.dr32[13], REGS.dr32[14]))
   {
-    REGS.FLAG.Clear();
+    if constexpr (FLAGS)
+      REGS.FLAG.Clear();
     REGS.MAC0 = static_cast<s32>(CPU::PGXP::GTE_NCLIP());
   }
   else
   {
-    Execute_NCLIP(inst);
+    Execute_NCLIP<FLAGS>(inst);
   }
 }
 
+template<bool FLAGS>
 void GTE::Execute_AVSZ3(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const s64 result = s64(REGS.ZSF3) * s32(u32(REGS.SZ1) + u32(REGS.SZ2) + u32(REGS.SZ3));
-  TruncateAndSetMAC<0>(result, 0);
-  SetOTZ(s32(result >> 12));
+  TruncateAndSetMAC<0, FLAGS>(result, 0);
+  SetOTZ<FLAGS>(s32(result >> 12));
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_AVSZ4(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const s64 result = s64(REGS.ZSF4) * s32(u32(REGS.SZ0) + u32(REGS.SZ1) + u32(REGS.SZ2) + u32(REGS.SZ3));
-  TruncateAndSetMAC<0>(result, 0);
-  SetOTZ(s32(result >> 12));
+  TruncateAndSetMAC<0, FLAGS>(result, 0);
+  SetOTZ<FLAGS>(s32(result >> 12));
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 ALWAYS_INLINE void GTE::InterpolateColor(s64 in_MAC1, s64 in_MAC2, s64 in_MAC3, u8 shift, bool lm)
 {
   // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
   //   [IR1,IR2,IR3] = (([RFC,GFC,BFC] SHL 12) - [MAC1,MAC2,MAC3]) SAR (sf*12)
-  TruncateAndSetMACAndIR<1>((s64(REGS.FC[0]) << 12) - in_MAC1, shift, false);
-  TruncateAndSetMACAndIR<2>((s64(REGS.FC[1]) << 12) - in_MAC2, shift, false);
-  TruncateAndSetMACAndIR<3>((s64(REGS.FC[2]) << 12) - in_MAC3, shift, false);
+  TruncateAndSetMACAndIR<1, FLAGS>((s64(REGS.FC[0]) << 12) - in_MAC1, shift, false);
+  TruncateAndSetMACAndIR<2, FLAGS>((s64(REGS.FC[1]) << 12) - in_MAC2, shift, false);
+  TruncateAndSetMACAndIR<3, FLAGS>((s64(REGS.FC[2]) << 12) - in_MAC3, shift, false);
 
   //   [MAC1,MAC2,MAC3] = (([IR1,IR2,IR3] * IR0) + [MAC1,MAC2,MAC3])
   // [MAC1,MAC2,MAC3] = [MAC1,MAC2,MAC3] SAR (sf*12)
-  TruncateAndSetMACAndIR<1>(s64(s32(REGS.IR1) * s32(REGS.IR0)) + in_MAC1, shift, lm);
-  TruncateAndSetMACAndIR<2>(s64(s32(REGS.IR2) * s32(REGS.IR0)) + in_MAC2, shift, lm);
-  TruncateAndSetMACAndIR<3>(s64(s32(REGS.IR3) * s32(REGS.IR0)) + in_MAC3, shift, lm);
+  TruncateAndSetMACAndIR<1, FLAGS>(s64(s32(REGS.IR1) * s32(REGS.IR0)) + in_MAC1, shift, lm);
+  TruncateAndSetMACAndIR<2, FLAGS>(s64(s32(REGS.IR2) * s32(REGS.IR0)) + in_MAC2, shift, lm);
+  TruncateAndSetMACAndIR<3, FLAGS>(s64(s32(REGS.IR3) * s32(REGS.IR0)) + in_MAC3, shift, lm);
 }
 
+template<bool FLAGS>
 void GTE::NCS(const s16 V[3], u8 shift, bool lm)
 {
   // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (LLM*V0) SAR (sf*12)
-  MulMatVec(&REGS.LLM[0][0], V[0], V[1], V[2], shift, lm);
+  MulMatVec<FLAGS>(&REGS.LLM[0][0], V[0], V[1], V[2], shift, lm);
 
   // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
-  MulMatVec(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
+  MulMatVec<FLAGS>(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
 
   // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  PushRGBFromMAC<FLAGS>();
 }
 
+template<bool FLAGS>
 void GTE::Execute_NCS(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
-  NCS(REGS.V0, inst.GetShift(), inst.lm);
+  NCS<FLAGS>(REGS.V0, inst.GetShift(), inst.lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_NCT(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
-  NCS(REGS.V0, shift, lm);
-  NCS(REGS.V1, shift, lm);
-  NCS(REGS.V2, shift, lm);
+  NCS<FLAGS>(REGS.V0, shift, lm);
+  NCS<FLAGS>(REGS.V1, shift, lm);
+  NCS<FLAGS>(REGS.V2, shift, lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::NCCS(const s16 V[3], u8 shift, bool lm)
 {
   // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (LLM*V0) SAR (sf*12)
-  MulMatVec(&REGS.LLM[0][0], V[0], V[1], V[2], shift, lm);
+  MulMatVec<FLAGS>(&REGS.LLM[0][0], V[0], V[1], V[2], shift, lm);
 
   // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
-  MulMatVec(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
+  MulMatVec<FLAGS>(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
 
   // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4          ;<--- for NCDx/NCCx
   // [MAC1,MAC2,MAC3] = [MAC1,MAC2,MAC3] SAR (sf*12)       ;<--- for NCDx/NCCx
-  TruncateAndSetMACAndIR<1>(s64(s32(ZeroExtend32(REGS.RGBC[0])) * s32(REGS.IR1)) << 4, shift, lm);
-  TruncateAndSetMACAndIR<2>(s64(s32(ZeroExtend32(REGS.RGBC[1])) * s32(REGS.IR2)) << 4, shift, lm);
-  TruncateAndSetMACAndIR<3>(s64(s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4, shift, lm);
+  TruncateAndSetMACAndIR<1, FLAGS>(s64(s32(ZeroExtend32(REGS.RGBC[0])) * s32(REGS.IR1)) << 4, shift, lm);
+  TruncateAndSetMACAndIR<2, FLAGS>(s64(s32(ZeroExtend32(REGS.RGBC[1])) * s32(REGS.IR2)) << 4, shift, lm);
+  TruncateAndSetMACAndIR<3, FLAGS>(s64(s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4, shift, lm);
 
   // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  PushRGBFromMAC<FLAGS>();
 }
 
+template<bool FLAGS>
 void GTE::Execute_NCCS(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
-  NCCS(REGS.V0, inst.GetShift(), inst.lm);
+  NCCS<FLAGS>(REGS.V0, inst.GetShift(), inst.lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_NCCT(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
-  NCCS(REGS.V0, shift, lm);
-  NCCS(REGS.V1, shift, lm);
-  NCCS(REGS.V2, shift, lm);
+  NCCS<FLAGS>(REGS.V0, shift, lm);
+  NCCS<FLAGS>(REGS.V1, shift, lm);
+  NCCS<FLAGS>(REGS.V2, shift, lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::NCDS(const s16 V[3], u8 shift, bool lm)
 {
   // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (LLM*V0) SAR (sf*12)
-  MulMatVec(&REGS.LLM[0][0], V[0], V[1], V[2], shift, lm);
+  MulMatVec<FLAGS>(&REGS.LLM[0][0], V[0], V[1], V[2], shift, lm);
 
   // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
-  MulMatVec(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
+  MulMatVec<FLAGS>(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
 
   // No need to assign these to MAC[1-3], as it'll never overflow.
   // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4          ;<--- for NCDx/NCCx
@@ -981,66 +1493,77 @@ void GTE::NCDS(const s16 V[3], u8 shift, bool lm)
   const s32 in_MAC3 = (s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4;
 
   // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0                   ;<--- for NCDx only
-  InterpolateColor(in_MAC1, in_MAC2, in_MAC3, shift, lm);
+  InterpolateColor<FLAGS>(in_MAC1, in_MAC2, in_MAC3, shift, lm);
 
   // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  PushRGBFromMAC<FLAGS>();
 }
 
+template<bool FLAGS>
 void GTE::Execute_NCDS(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
-  NCDS(REGS.V0, inst.GetShift(), inst.lm);
+  NCDS<FLAGS>(REGS.V0, inst.GetShift(), inst.lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_NCDT(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
-  NCDS(REGS.V0, shift, lm);
-  NCDS(REGS.V1, shift, lm);
-  NCDS(REGS.V2, shift, lm);
+  NCDS<FLAGS>(REGS.V0, shift, lm);
+  NCDS<FLAGS>(REGS.V1, shift, lm);
+  NCDS<FLAGS>(REGS.V2, shift, lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_CC(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
   // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
-  MulMatVec(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
+  MulMatVec<FLAGS>(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
 
   // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4
   // [MAC1,MAC2,MAC3] = [MAC1,MAC2,MAC3] SAR (sf*12)
-  TruncateAndSetMACAndIR<1>(s64(s32(ZeroExtend32(REGS.RGBC[0])) * s32(REGS.IR1)) << 4, shift, lm);
-  TruncateAndSetMACAndIR<2>(s64(s32(ZeroExtend32(REGS.RGBC[1])) * s32(REGS.IR2)) << 4, shift, lm);
-  TruncateAndSetMACAndIR<3>(s64(s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4, shift, lm);
+  TruncateAndSetMACAndIR<1, FLAGS>(s64(s32(ZeroExtend32(REGS.RGBC[0])) * s32(REGS.IR1)) << 4, shift, lm);
+  TruncateAndSetMACAndIR<2, FLAGS>(s64(s32(ZeroExtend32(REGS.RGBC[1])) * s32(REGS.IR2)) << 4, shift, lm);
+  TruncateAndSetMACAndIR<3, FLAGS>(s64(s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4, shift, lm);
 
   // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  PushRGBFromMAC<FLAGS>();
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_CDP(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
   // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
-  MulMatVec(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
+  MulMatVec<FLAGS>(&REGS.LCM[0][0], REGS.BK, REGS.IR1, REGS.IR2, REGS.IR3, shift, lm);
 
   // No need to assign these to MAC[1-3], as it'll never overflow.
   // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4
@@ -1050,54 +1573,64 @@ void GTE::Execute_CDP(Instruction inst)
 
   // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0                   ;<--- for CDP only
   // [MAC1, MAC2, MAC3] = [MAC1, MAC2, MAC3] SAR(sf * 12)
-  InterpolateColor(in_MAC1, in_MAC2, in_MAC3, shift, lm);
+  InterpolateColor<FLAGS>(in_MAC1, in_MAC2, in_MAC3, shift, lm);
 
   // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  PushRGBFromMAC<FLAGS>();
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::DPCS(const u8 color[3], u8 shift, bool lm)
 {
   // In: [IR1,IR2,IR3]=Vector, FC=Far Color, IR0=Interpolation value, CODE=MSB of RGBC
   // [MAC1,MAC2,MAC3] = [R,G,B] SHL 16                     ;<--- for DPCS/DPCT
-  TruncateAndSetMAC<1>((s64(ZeroExtend64(color[0])) << 16), 0);
-  TruncateAndSetMAC<2>((s64(ZeroExtend64(color[1])) << 16), 0);
-  TruncateAndSetMAC<3>((s64(ZeroExtend64(color[2])) << 16), 0);
+  TruncateAndSetMAC<1, FLAGS>((s64(ZeroExtend64(color[0])) << 16), 0);
+  TruncateAndSetMAC<2, FLAGS>((s64(ZeroExtend64(color[1])) << 16), 0);
+  TruncateAndSetMAC<3, FLAGS>((s64(ZeroExtend64(color[2])) << 16), 0);
 
   // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
-  InterpolateColor(REGS.MAC1, REGS.MAC2, REGS.MAC3, shift, lm);
+  InterpolateColor<FLAGS>(REGS.MAC1, REGS.MAC2, REGS.MAC3, shift, lm);
 
   // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  PushRGBFromMAC<FLAGS>();
 }
 
+template<bool FLAGS>
 void GTE::Execute_DPCS(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
-  DPCS(REGS.RGBC, inst.GetShift(), inst.lm);
+  DPCS<FLAGS>(REGS.RGBC, inst.GetShift(), inst.lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_DPCT(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
   for (u32 i = 0; i < 3; i++)
-    DPCS(REGS.RGB0, shift, lm);
+    DPCS<FLAGS>(REGS.RGB0, shift, lm);
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_DCPL(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
@@ -1109,17 +1642,20 @@ void GTE::Execute_DCPL(Instruction inst)
   const s32 in_MAC3 = (s32(ZeroExtend32(REGS.RGBC[2])) * s32(REGS.IR3)) << 4;
 
   // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
-  InterpolateColor(in_MAC1, in_MAC2, in_MAC3, shift, lm);
+  InterpolateColor<FLAGS>(in_MAC1, in_MAC2, in_MAC3, shift, lm);
 
   // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  PushRGBFromMAC<FLAGS>();
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_INTPL(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
@@ -1127,50 +1663,57 @@ void GTE::Execute_INTPL(Instruction inst)
   // No need to assign these to MAC[1-3], as it'll never overflow.
   // [MAC1,MAC2,MAC3] = [IR1,IR2,IR3] SHL 12               ;<--- for INTPL only
   // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0
-  InterpolateColor(s32(REGS.IR1) << 12, s32(REGS.IR2) << 12, s32(REGS.IR3) << 12, shift, lm);
+  InterpolateColor<FLAGS>(s32(REGS.IR1) << 12, s32(REGS.IR2) << 12, s32(REGS.IR3) << 12, shift, lm);
 
   // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  PushRGBFromMAC<FLAGS>();
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_GPL(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
   // [MAC1,MAC2,MAC3] = [MAC1,MAC2,MAC3] SHL (sf*12)       ;<--- for GPL only
   // [MAC1,MAC2,MAC3] = (([IR1,IR2,IR3] * IR0) + [MAC1,MAC2,MAC3]) SAR (sf*12)
-  TruncateAndSetMACAndIR<1>((s64(s32(REGS.IR1) * s32(REGS.IR0)) + (s64(REGS.MAC1) << shift)), shift, lm);
-  TruncateAndSetMACAndIR<2>((s64(s32(REGS.IR2) * s32(REGS.IR0)) + (s64(REGS.MAC2) << shift)), shift, lm);
-  TruncateAndSetMACAndIR<3>((s64(s32(REGS.IR3) * s32(REGS.IR0)) + (s64(REGS.MAC3) << shift)), shift, lm);
+  TruncateAndSetMACAndIR<1, FLAGS>((s64(s32(REGS.IR1) * s32(REGS.IR0)) + (s64(REGS.MAC1) << shift)), shift, lm);
+  TruncateAndSetMACAndIR<2, FLAGS>((s64(s32(REGS.IR2) * s32(REGS.IR0)) + (s64(REGS.MAC2) << shift)), shift, lm);
+  TruncateAndSetMACAndIR<3, FLAGS>((s64(s32(REGS.IR3) * s32(REGS.IR0)) + (s64(REGS.MAC3) << shift)), shift, lm);
 
   // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  PushRGBFromMAC<FLAGS>();
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
+template<bool FLAGS>
 void GTE::Execute_GPF(Instruction inst)
 {
-  REGS.FLAG.Clear();
+  if constexpr (FLAGS)
+    REGS.FLAG.Clear();
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
   // [MAC1,MAC2,MAC3] = [0,0,0]                            ;<--- for GPF only
   // [MAC1,MAC2,MAC3] = (([IR1,IR2,IR3] * IR0) + [MAC1,MAC2,MAC3]) SAR (sf*12)
-  TruncateAndSetMACAndIR<1>(s64(s32(REGS.IR1) * s32(REGS.IR0)), shift, lm);
-  TruncateAndSetMACAndIR<2>(s64(s32(REGS.IR2) * s32(REGS.IR0)), shift, lm);
-  TruncateAndSetMACAndIR<3>(s64(s32(REGS.IR3) * s32(REGS.IR0)), shift, lm);
+  TruncateAndSetMACAndIR<1, FLAGS>(s64(s32(REGS.IR1) * s32(REGS.IR0)), shift, lm);
+  TruncateAndSetMACAndIR<2, FLAGS>(s64(s32(REGS.IR2) * s32(REGS.IR0)), shift, lm);
+  TruncateAndSetMACAndIR<3, FLAGS>(s64(s32(REGS.IR3) * s32(REGS.IR0)), shift, lm);
 
   // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE], [IR1,IR2,IR3] = [MAC1,MAC2,MAC3]
-  PushRGBFromMAC();
+  PushRGBFromMAC<FLAGS>();
 
-  REGS.FLAG.UpdateError();
+  if constexpr (FLAGS)
+    REGS.FLAG.UpdateError();
 }
 
 void GTE::ExecuteInstruction(u32 inst_bits)
@@ -1180,117 +1723,117 @@ void GTE::ExecuteInstruction(u32 inst_bits)
   {
     case 0x01:
       CPU::AddGTETicks(15);
-      Execute_RTPS(inst);
+      Execute_RTPS<true>(inst);
       break;
 
     case 0x06:
     {
       CPU::AddGTETicks(8);
       if (g_settings.gpu_pgxp_enable && g_settings.gpu_pgxp_culling)
-        Execute_NCLIP_PGXP(inst);
+        Execute_NCLIP_PGXP<true>(inst);
       else
-        Execute_NCLIP(inst);
+        Execute_NCLIP<true>(inst);
     }
     break;
 
     case 0x0C:
       CPU::AddGTETicks(6);
-      Execute_OP(inst);
+      Execute_OP<true>(inst);
       break;
 
     case 0x10:
       CPU::AddGTETicks(8);
-      Execute_DPCS(inst);
+      Execute_DPCS<true>(inst);
       break;
 
     case 0x11:
       CPU::AddGTETicks(7);
-      Execute_INTPL(inst);
+      Execute_INTPL<true>(inst);
       break;
 
     case 0x12:
       CPU::AddGTETicks(8);
-      Execute_MVMVA(inst);
+      Execute_MVMVA<true>(inst);
       break;
 
     case 0x13:
       CPU::AddGTETicks(19);
-      Execute_NCDS(inst);
+      Execute_NCDS<true>(inst);
       break;
 
     case 0x14:
       CPU::AddGTETicks(13);
-      Execute_CDP(inst);
+      Execute_CDP<true>(inst);
       break;
 
     case 0x16:
       CPU::AddGTETicks(44);
-      Execute_NCDT(inst);
+      Execute_NCDT<true>(inst);
       break;
 
     case 0x1B:
       CPU::AddGTETicks(17);
-      Execute_NCCS(inst);
+      Execute_NCCS<true>(inst);
       break;
 
     case 0x1C:
       CPU::AddGTETicks(11);
-      Execute_CC(inst);
+      Execute_CC<true>(inst);
       break;
 
     case 0x1E:
       CPU::AddGTETicks(14);
-      Execute_NCS(inst);
+      Execute_NCS<true>(inst);
       break;
 
     case 0x20:
       CPU::AddGTETicks(30);
-      Execute_NCT(inst);
+      Execute_NCT<true>(inst);
       break;
 
     case 0x28:
       CPU::AddGTETicks(5);
-      Execute_SQR(inst);
+      Execute_SQR<true>(inst);
       break;
 
     case 0x29:
       CPU::AddGTETicks(8);
-      Execute_DCPL(inst);
+      Execute_DCPL<true>(inst);
       break;
 
     case 0x2A:
       CPU::AddGTETicks(17);
-      Execute_DPCT(inst);
+      Execute_DPCT<true>(inst);
       break;
 
     case 0x2D:
       CPU::AddGTETicks(5);
-      Execute_AVSZ3(inst);
+      Execute_AVSZ3<true>(inst);
       break;
 
     case 0x2E:
       CPU::AddGTETicks(6);
-      Execute_AVSZ4(inst);
+      Execute_AVSZ4<true>(inst);
       break;
 
     case 0x30:
       CPU::AddGTETicks(23);
-      Execute_RTPT(inst);
+      Execute_RTPT<true>(inst);
       break;
 
     case 0x3D:
       CPU::AddGTETicks(5);
-      Execute_GPF(inst);
+      Execute_GPF<true>(inst);
       break;
 
     case 0x3E:
       CPU::AddGTETicks(5);
-      Execute_GPL(inst);
+      Execute_GPL<true>(inst);
       break;
 
     case 0x3F:
       CPU::AddGTETicks(39);
-      Execute_NCCT(inst);
+      Execute_NCCT<true>(inst);
       break;
 
     default:
@@ -1299,103 +1842,144 @@ void GTE::ExecuteInstruction(u32 inst_bits)
   }
 }
 
-GTE::InstructionImpl GTE::GetInstructionImpl(u32 inst_bits, TickCount* ticks)
+GTE::InstructionImpl GTE::GetInstructionImpl(u32 inst_bits, TickCount* ticks, bool flags_live)
 {
   const Instruction inst{inst_bits};
   switch (inst.command)
   {
     case 0x01:
+    {
       *ticks = 15;
-      return &Execute_RTPS;
+#ifdef GTE_HAVE_SIMD
+      // The SIMD path skips the precise PGXP bookkeeping, so only use it when PGXP is off.
+      if (!g_settings.gpu_pgxp_enable && UseSIMDPath())
+        return flags_live ? &Execute_RTPS_SIMD<true> : &Execute_RTPS_SIMD<false>;
+#endif
+      return flags_live ? &Execute_RTPS<true> : &Execute_RTPS<false>;
+    }
 
     case 0x06:
     {
       *ticks = 8;
       if (g_settings.gpu_pgxp_enable && g_settings.gpu_pgxp_culling)
-        return &Execute_NCLIP_PGXP;
+        return flags_live ? &Execute_NCLIP_PGXP<true> : &Execute_NCLIP_PGXP<false>;
       else
-        return &Execute_NCLIP;
+        return flags_live ? &Execute_NCLIP<true> : &Execute_NCLIP<false>;
     }
 
     case 0x0C:
       *ticks = 6;
-      return &Execute_OP;
+      return flags_live ? &Execute_OP<true> : &Execute_OP<false>;
 
     case 0x10:
       *ticks = 8;
-      return &Execute_DPCS;
+      return flags_live ? &Execute_DPCS<true> : &Execute_DPCS<false>;
 
     case 0x11:
       *ticks = 7;
-      return &Execute_INTPL;
+      return flags_live ? &Execute_INTPL<true> : &Execute_INTPL<false>;
 
     case 0x12:
       *ticks = 8;
-      return &Execute_MVMVA;
+#ifdef GTE_HAVE_SIMD
+      if (UseSIMDPath())
+        return flags_live ? &Execute_MVMVA_SIMD<true> : &Execute_MVMVA_SIMD<false>;
+#endif
+      return flags_live ? &Execute_MVMVA<true> : &Execute_MVMVA<false>;
 
     case 0x13:
       *ticks = 19;
-      return &Execute_NCDS;
+#ifdef GTE_HAVE_SIMD
+      if (UseSIMDPath())
+        return flags_live ? &Execute_NCDS_SIMD<true> : &Execute_NCDS_SIMD<false>;
+#endif
+      return flags_live ? &Execute_NCDS<true> : &Execute_NCDS<false>;
 
     case 0x14:
       *ticks = 13;
-      return &Execute_CDP;
+      return flags_live ? &Execute_CDP<true> : &Execute_CDP<false>;
 
     case 0x16:
       *ticks = 44;
-      return &Execute_NCDT;
+#ifdef GTE_HAVE_SIMD
+      if (UseSIMDPath())
+        return flags_live ? &Execute_NCDT_SIMD<true> : &Execute_NCDT_SIMD<false>;
+#endif
+      return flags_live ? &Execute_NCDT<true> : &Execute_NCDT<false>;
 
     case 0x1B:
       *ticks = 17;
-      return &Execute_NCCS;
+#ifdef GTE_HAVE_SIMD
+      if (UseSIMDPath())
+        return flags_live ? &Execute_NCCS_SIMD<true> : &Execute_NCCS_SIMD<false>;
+#endif
+      return flags_live ? &Execute_NCCS<true> : &Execute_NCCS<false>;
 
     case 0x1C:
       *ticks = 11;
-      return &Execute_CC;
+      return flags_live ? &Execute_CC<true> : &Execute_CC<false>;
 
     case 0x1E:
       *ticks = 14;
-      return &Execute_NCS;
+#ifdef GTE_HAVE_SIMD
+      if (UseSIMDPath())
+        return flags_live ? &Execute_NCS_SIMD<true> : &Execute_NCS_SIMD<false>;
+#endif
+      return flags_live ? &Execute_NCS<true> : &Execute_NCS<false>;
 
     case 0x20:
       *ticks = 30;
-      return &Execute_NCT;
+#ifdef GTE_HAVE_SIMD
+      if (UseSIMDPath())
+        return flags_live ? &Execute_NCT_SIMD<true> : &Execute_NCT_SIMD<false>;
+#endif
+      return flags_live ? &Execute_NCT<true> : &Execute_NCT<false>;
 
     case 0x28:
       *ticks = 5;
-      return &Execute_SQR;
+      return flags_live ? &Execute_SQR<true> : &Execute_SQR<false>;
 
     case 0x29:
       *ticks = 8;
-      return &Execute_DCPL;
+      return flags_live ? &Execute_DCPL<true> : &Execute_DCPL<false>;
 
     case 0x2A:
       *ticks = 17;
-      return &Execute_DPCT;
+      return flags_live ? &Execute_DPCT<true> : &Execute_DPCT<false>;
 
     case 0x2D:
       *ticks = 5;
-      return &Execute_AVSZ3;
+      return flags_live ? &Execute_AVSZ3<true> : &Execute_AVSZ3<false>;
 
     case 0x2E:
       *ticks = 6;
-      return &Execute_AVSZ4;
+      return flags_live ? &Execute_AVSZ4<true> : &Execute_AVSZ4<false>;
 
     case 0x30:
+    {
       *ticks = 23;
-      return &Execute_RTPT;
+#ifdef GTE_HAVE_SIMD
+      if (!g_settings.gpu_pgxp_enable && UseSIMDPath())
+        return flags_live ? &Execute_RTPT_SIMD<true> : &Execute_RTPT_SIMD<false>;
+#endif
+      return flags_live ? &Execute_RTPT<true> : &Execute_RTPT<false>;
+    }
 
     case 0x3D:
       *ticks = 5;
-      return &Execute_GPF;
+      return flags_live ? &Execute_GPF<true> : &Execute_GPF<false>;
 
     case 0x3E:
       *ticks = 5;
-      return &Execute_GPL;
+      return flags_live ? &Execute_GPL<true> : &Execute_GPL<false>;
 
     case 0x3F:
       *ticks = 39;
-      return &Execute_NCCT;
+#ifdef GTE_HAVE_SIMD
+      if (UseSIMDPath())
+        return flags_live ? &Execute_NCCT_SIMD<true> : &Execute_NCCT_SIMD<false>;
+#endif
+      return flags_live ? &Execute_NCCT<true> : &Execute_NCCT<false>;
 
     default:
       Panic("Missing handler");
@@ -22,7 +22,9 @@ u32* GetRegisterPtr(u32 index);
 
 void ExecuteInstruction(u32 inst_bits);
 
+// flags_live should be false only when the caller can prove FLAG is not read before the next GTE
+// command overwrites it; the returned implementation then skips the flag bookkeeping entirely.
 using InstructionImpl = void (*)(Instruction);
-InstructionImpl GetInstructionImpl(u32 inst_bits, TickCount* ticks);
+InstructionImpl GetInstructionImpl(u32 inst_bits, TickCount* ticks, bool flags_live);
 
 } // namespace GTE
@@ -5,10 +5,12 @@
 #include "cpu_code_cache.h"
 #include "cpu_core.h"
 #include "cpu_pgxp.h"
+#include "cpu_profiler.h"
 #include "fullscreen_ui.h"
 #include "gpu.h"
 #include "host.h"
 #include "imgui_overlays.h"
+#include "perf_stats.h"
 #include "settings.h"
 #include "spu.h"
 #include "system.h"
@@ -19,6 +21,8 @@
 #include "util/postprocessing.h"
 
 #include "common/file_system.h"
+#include "common/path.h"
+#include "common/perf_trace.h"
 
 #include "IconsFontAwesome5.h"
 
@@ -192,6 +196,48 @@ DEFINE_HOTKEY("Screenshot", TRANSLATE_NOOP("Hotkeys", "General"), TRANSLATE_NOOP
                   System::SaveScreenshot();
               })
 
+DEFINE_HOTKEY("TogglePerfTrace", TRANSLATE_NOOP("Hotkeys", "General"),
+              TRANSLATE_NOOP("Hotkeys", "Toggle Performance Trace Capture"), [](s32 pressed) {
+                if (!pressed)
+                {
+                  if (PerfTrace::IsCapturing())
+                  {
+                    const std::string path = Path::Combine(EmuFolders::DataRoot, "perftrace.json");
+                    if (PerfTrace::StopAndDump(path.c_str()))
+                    {
+                      Host::AddKeyedOSDMessage(
+                        "PerfTrace",
+                        fmt::format(TRANSLATE_FS("OSDMessage", "Performance trace saved to '{}'."),
+                                    Path::GetFileName(path)),
+                        Host::OSD_INFO_DURATION);
+                    }
+                  }
+                  else
+                  {
+                    PerfTrace::Start();
+                    Host::AddKeyedOSDMessage("PerfTrace",
+                                             TRANSLATE_STR("OSDMessage", "Performance trace capture started."),
+                                             Host::OSD_INFO_DURATION);
+                  }
+                }
+              })
+
+DEFINE_HOTKEY("DumpPerfStats", TRANSLATE_NOOP("Hotkeys", "General"),
+              TRANSLATE_NOOP("Hotkeys", "Dump Performance Statistics"), [](s32 pressed) {
+                if (!pressed)
+                {
+                  const std::string path = Path::Combine(EmuFolders::DataRoot, "perfstats.json");
+                  if (PerfStats::DumpToFile(path.c_str()))
+                  {
+                    Host::AddKeyedOSDMessage(
+                      "PerfStats",
+                      fmt::format(TRANSLATE_FS("OSDMessage", "Performance statistics saved to '{}'."),
+                                  Path::GetFileName(path)),
+                      Host::OSD_INFO_DURATION);
+                  }
+                }
+              })
+
 #ifndef __ANDROID__
 DEFINE_HOTKEY("OpenAchievements", TRANSLATE_NOOP("Hotkeys", "General"),
               TRANSLATE_NOOP("Hotkeys", "Open Achievement List"), [](s32 pressed) {
@@ -320,12 +366,29 @@ DEFINE_HOTKEY("ResetEmulationSpeed", TRANSLATE_NOOP("Hotkeys", "System"),
                 }
               })
 
+DEFINE_HOTKEY("ToggleCPUProfiler", TRANSLATE_NOOP("Hotkeys", "System"), TRANSLATE_NOOP("Hotkeys", "Toggle CPU Profiler"),
+              [](s32 pressed) {
+                if (!pressed && System::IsValid())
+                  CPU::Profiler::ToggleSampling();
+              })
+
 DEFINE_HOTKEY("ToggleSoftwareRendering", TRANSLATE_NOOP("Hotkeys", "Graphics"),
               TRANSLATE_NOOP("Hotkeys", "Toggle Software Rendering"), [](s32 pressed) {
                 if (!pressed && System::IsValid())
                   System::ToggleSoftwareRendering();
               })
 
+DEFINE_HOTKEY("ToggleGPUDump", TRANSLATE_NOOP("Hotkeys", "Graphics"),
+              TRANSLATE_NOOP("Hotkeys", "Toggle GPU Dump Recording"), [](s32 pressed) {
+                if (!pressed && System::IsValid())
+                {
+                  if (!System::IsRecordingGPUDump())
+                    System::StartRecordingGPUDump();
+                  else
+                    System::StopRecordingGPUDump();
+                }
+              })
+
 DEFINE_HOTKEY("TogglePGXP", TRANSLATE_NOOP("Hotkeys", "Graphics"), TRANSLATE_NOOP("Hotkeys", "Toggle PGXP"),
               [](s32 pressed) {
                 if (!pressed && System::IsValid())
@@ -388,6 +451,25 @@ DEFINE_HOTKEY("ReloadTextureReplacements", TRANSLATE_NOOP("Hotkeys", "Graphics")
                 }
               })
 
+DEFINE_HOTKEY("CompileTextureReplacementPack", TRANSLATE_NOOP("Hotkeys", "Graphics"),
+              TRANSLATE_NOOP("Hotkeys", "Compile Texture Replacement Pack"), [](s32 pressed) {
+                if (!pressed && System::IsValid())
+                {
+                  if (g_texture_replacements.CompileReplacementPack())
+                  {
+                    Host::AddKeyedOSDMessage("CompileTextureReplacementPack",
+                                             TRANSLATE_STR("OSDMessage", "Texture replacement pack compiled."), 10.0f);
+                    g_texture_replacements.Reload();
+                  }
+                  else
+                  {
+                    Host::AddKeyedOSDMessage(
+                      "CompileTextureReplacementPack",
+                      TRANSLATE_STR("OSDMessage", "Failed to compile texture replacement pack."), 10.0f);
+                  }
+                }
+              })
+
 DEFINE_HOTKEY("ToggleWidescreen", TRANSLATE_NOOP("Hotkeys", "Graphics"), TRANSLATE_NOOP("Hotkeys", "Toggle Widescreen"),
               [](s32 pressed) {
                 if (!pressed)
@@ -6,11 +6,13 @@
 #include "imgui_overlays.h"
 #include "cdrom.h"
 #include "controller.h"
+#include "cpu_profiler.h"
 #include "dma.h"
 #include "fullscreen_ui.h"
 #include "gpu.h"
 #include "host.h"
 #include "mdec.h"
+#include "perf_stats.h"
 #include "resources.h"
 #include "settings.h"
 #include "spu.h"
@@ -27,6 +29,7 @@
 #include "common/assert.h"
 #include "common/easing.h"
 #include "common/file_system.h"
+#include "common/hash_combine.h"
 #include "common/intrin.h"
 #include "common/log.h"
 #include "common/path.h"
@@ -47,13 +50,30 @@
 #include <mutex>
 #include <span>
 #include <unordered_map>
+#include <vector>
 
 Log_SetChannel(ImGuiManager);
 
 namespace ImGuiManager {
+namespace {
+
+struct OverlayTextLine
+{
+  ImFont* font;
+  ImU32 color;
+  SmallString text;
+};
+
+} // namespace
+
+// ids for the overlay draw lists retained by BeginCachedDrawList()
+static constexpr u32 PERFORMANCE_OVERLAY_CACHE_ID = 1;
+static constexpr u32 ENHANCEMENTS_OVERLAY_CACHE_ID = 2;
+
 static void FormatProcessorStat(SmallStringBase& text, double usage, double time);
 static void DrawPerformanceOverlay();
 static void DrawEnhancementsOverlay();
+static void DrawCPUProfilerOverlay();
 static void DrawInputsOverlay();
 } // namespace ImGuiManager
 
@@ -241,6 +261,9 @@ void ImGuiManager::RenderTextOverlays()
     if (g_settings.display_show_enhancements && state != System::State::Paused)
       DrawEnhancementsOverlay();
 
+    if (CPU::Profiler::IsActive())
+      DrawCPUProfilerOverlay();
+
     if (g_settings.display_show_inputs && state != System::State::Paused)
       DrawInputsOverlay();
   }
@@ -275,23 +298,23 @@ void ImGuiManager::DrawPerformanceOverlay()
   ImFont* standard_font = ImGuiManager::GetStandardFont();
   float position_y = margin;
 
-  ImDrawList* dl = ImGui::GetBackgroundDrawList();
   SmallString text;
   ImVec2 text_size;
   bool first = true;
 
+  // Lines are gathered and hashed first, so that unchanged frames can re-submit the previous
+  // frame's vertices instead of shaping and right-aligning every glyph again.
+  static std::vector<OverlayTextLine> lines;
+  lines.clear();
+  size_t version = 0;
+  hash_combine(version, scale, ImGui::GetIO().DisplaySize.x);
+
 #define DRAW_LINE(font, text, color)                                                                                   \
   do                                                                                                                   \
   {                                                                                                                    \
-    text_size =                                                                                                        \
-      font->CalcTextSizeA(font->FontSize, std::numeric_limits<float>::max(), -1.0f, (text), nullptr, nullptr);         \
-    dl->AddText(                                                                                                       \
-      font, font->FontSize,                                                                                            \
-      ImVec2(ImGui::GetIO().DisplaySize.x - margin - text_size.x + shadow_offset, position_y + shadow_offset),         \
-      IM_COL32(0, 0, 0, 100), text.c_str(), text.end_ptr());                                                           \
-    dl->AddText(font, font->FontSize, ImVec2(ImGui::GetIO().DisplaySize.x - margin - text_size.x, position_y), color,  \
-                (text));                                                                                               \
-    position_y += text_size.y + spacing;                                                                               \
+    hash_combine(version, std::string_view(text), static_cast<ImU32>(color), static_cast<void*>(font));                \
+    lines.push_back(OverlayTextLine{(font), (color), (text)});                                                         \
+    position_y += (font)->FontSize + spacing;                                                                          \
   } while (0)
 
   const System::State state = System::GetState();
@@ -439,6 +462,27 @@ void ImGuiManager::DrawPerformanceOverlay()
 
     if (g_settings.display_show_frame_times)
     {
+      // The history plot shows the last few seconds; the percentiles cover the whole session, so
+      // the tail survives long after the spike has scrolled off the plot.
+      text.format("FT: {:.1f}/{:.1f}/{:.1f}ms (p95/p99/p99.9)",
+                  PerfStats::GetPercentile(PerfStats::Metric::FrameTime, 95.0f),
+                  PerfStats::GetPercentile(PerfStats::Metric::FrameTime, 99.0f),
+                  PerfStats::GetPercentile(PerfStats::Metric::FrameTime, 99.9f));
+      DRAW_LINE(fixed_font, text, IM_COL32(255, 255, 255, 255));
+
+      u32 total_stalls = 0;
+      for (u32 i = 0; i < static_cast<u32>(PerfStats::StallSource::MaxCount); i++)
+        total_stalls += PerfStats::GetStallCount(static_cast<PerfStats::StallSource>(i));
+      if (total_stalls > 0)
+      {
+        text.format("STALL: C{} S{} SS{} RB{}",
+                    PerfStats::GetStallCount(PerfStats::StallSource::BlockCompile),
+                    PerfStats::GetStallCount(PerfStats::StallSource::ShaderCompile),
+                    PerfStats::GetStallCount(PerfStats::StallSource::SaveState),
+                    PerfStats::GetStallCount(PerfStats::StallSource::VRAMReadback));
+        DRAW_LINE(fixed_font, text, IM_COL32(255, 255, 255, 255));
+      }
+
       const ImVec2 history_size(200.0f * scale, 50.0f * scale);
       ImGui::SetNextWindowSize(ImVec2(history_size.x, history_size.y));
       ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - margin - history_size.x, position_y));
@@ -506,6 +550,27 @@ void ImGuiManager::DrawPerformanceOverlay()
   }
 
 #undef DRAW_LINE
+
+  if (!lines.empty())
+  {
+    if (ImDrawList* dl = BeginCachedDrawList(PERFORMANCE_OVERLAY_CACHE_ID, version))
+    {
+      float draw_y = margin;
+      for (const OverlayTextLine& line : lines)
+      {
+        text_size = line.font->CalcTextSizeA(line.font->FontSize, std::numeric_limits<float>::max(), -1.0f,
+                                             line.text.c_str(), line.text.end_ptr(), nullptr);
+        dl->AddText(line.font, line.font->FontSize,
+                    ImVec2(ImGui::GetIO().DisplaySize.x - margin - text_size.x + shadow_offset, draw_y + shadow_offset),
+                    IM_COL32(0, 0, 0, 100), line.text.c_str(), line.text.end_ptr());
+        dl->AddText(line.font, line.font->FontSize,
+                    ImVec2(ImGui::GetIO().DisplaySize.x - margin - text_size.x, draw_y), line.color, line.text.c_str(),
+                    line.text.end_ptr());
+        draw_y += line.font->FontSize + spacing;
+      }
+      EndCachedDrawList(PERFORMANCE_OVERLAY_CACHE_ID);
+    }
+  }
 }
 
 void ImGuiManager::DrawEnhancementsOverlay()
@@ -581,14 +646,56 @@ void ImGuiManager::DrawEnhancementsOverlay()
   ImFont* font = ImGuiManager::GetFixedFont();
   const float position_y = ImGui::GetIO().DisplaySize.y - margin - font->FontSize;
 
+  // Only changes when settings change, so draw out of the retained list almost every frame.
+  size_t version = 0;
+  hash_combine(version, scale, ImGui::GetIO().DisplaySize.x, ImGui::GetIO().DisplaySize.y, std::string_view(text));
+
+  if (ImDrawList* dl = BeginCachedDrawList(ENHANCEMENTS_OVERLAY_CACHE_ID, version))
+  {
+    const ImVec2 text_size = font->CalcTextSizeA(font->FontSize, std::numeric_limits<float>::max(), -1.0f,
+                                                 text.c_str(), text.end_ptr(), nullptr);
+    dl->AddText(font, font->FontSize,
+                ImVec2(ImGui::GetIO().DisplaySize.x - margin - text_size.x + shadow_offset, position_y + shadow_offset),
+                IM_COL32(0, 0, 0, 100), text.c_str(), text.end_ptr());
+    dl->AddText(font, font->FontSize, ImVec2(ImGui::GetIO().DisplaySize.x - margin - text_size.x, position_y),
+                IM_COL32(255, 255, 255, 255), text.c_str(), text.end_ptr());
+    EndCachedDrawList(ENHANCEMENTS_OVERLAY_CACHE_ID);
+  }
+}
+
+void ImGuiManager::DrawCPUProfilerOverlay()
+{
+  static constexpr u32 MAX_ENTRIES = 15;
+
+  const float scale = ImGuiManager::GetGlobalScale();
+  const float shadow_offset = 1.0f * scale;
+  const float margin = 10.0f * scale;
+  ImFont* font = ImGuiManager::GetFixedFont();
   ImDrawList* dl = ImGui::GetBackgroundDrawList();
-  ImVec2 text_size = font->CalcTextSizeA(font->FontSize, std::numeric_limits<float>::max(), -1.0f, text.c_str(),
-                                         text.end_ptr(), nullptr);
-  dl->AddText(font, font->FontSize,
-              ImVec2(ImGui::GetIO().DisplaySize.x - margin - text_size.x + shadow_offset, position_y + shadow_offset),
-              IM_COL32(0, 0, 0, 100), text.c_str(), text.end_ptr());
-  dl->AddText(font, font->FontSize, ImVec2(ImGui::GetIO().DisplaySize.x - margin - text_size.x, position_y),
-              IM_COL32(255, 255, 255, 255), text.c_str(), text.end_ptr());
+  float position_y = margin;
+
+  const auto draw_line = [&](const SmallStringBase& text, u32 color) {
+    dl->AddText(font, font->FontSize, ImVec2(margin + shadow_offset, position_y + shadow_offset),
+                IM_COL32(0, 0, 0, 100), text.c_str(), text.end_ptr());
+    dl->AddText(font, font->FontSize, ImVec2(margin, position_y), color, text.c_str(), text.end_ptr());
+    position_y += font->FontSize + (2.0f * scale);
+  };
+
+  const u64 total_samples = CPU::Profiler::GetSampleCount();
+
+  TinyString text;
+  text.format("CPU Profiler [{} samples]", total_samples);
+  draw_line(text, IM_COL32(255, 255, 255, 255));
+
+  if (total_samples == 0)
+    return;
+
+  for (const CPU::Profiler::SampleEntry& entry : CPU::Profiler::GetTopSamples(MAX_ENTRIES))
+  {
+    const double percent = (static_cast<double>(entry.count) * 100.0) / static_cast<double>(total_samples);
+    text.format("{:08X} {:6.2f}% ({})", entry.pc, percent, entry.count);
+    draw_line(text, IM_COL32(255, 255, 255, 200));
+  }
 }
 
 void ImGuiManager::DrawInputsOverlay()
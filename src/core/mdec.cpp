@@ -13,12 +13,16 @@
 
 #include "common/bitfield.h"
 #include "common/fifo_queue.h"
+#include "common/intrin.h"
 #include "common/log.h"
+#include "common/threading.h"
 
 #include "imgui.h"
 
 #include <array>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 Log_SetChannel(MDEC);
 
@@ -30,6 +34,14 @@ static constexpr u32 DATA_OUT_FIFO_SIZE = 768;
 static constexpr u32 NUM_BLOCKS = 6;
 static constexpr TickCount TICKS_PER_BLOCK = 448;
 
+// Jobs handed to the asynchronous decode thread. Values below NUM_BLOCKS run the IDCT on that
+// block in place; the convert jobs produce s_block_rgb from the IDCT results.
+enum : u8
+{
+  ASYNC_JOB_COLOR_CONVERT = NUM_BLOCKS,
+  ASYNC_JOB_MONO_CONVERT = NUM_BLOCKS + 1
+};
+
 enum DataOutputDepth : u8
 {
   DataOutputDepth_4Bit = 0,
@@ -118,9 +130,15 @@ static void IDCT(s16* blk);
 static void IDCT_New(s16* blk);
 static void IDCT_Old(s16* blk);
 static void yuv_to_rgb(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk,
-                       const std::array<s16, 64>& Yblk);
+                       const std::array<s16, 64>& Yblk, s16 addval);
 static void y_to_mono(const std::array<s16, 64>& Yblk);
 
+static void StartDecodeThread();
+static void StopDecodeThread();
+static void SubmitAsyncDecodeJob(u8 job);
+static void WaitForAsyncDecode();
+static void DecodeThreadEntryPoint();
+
 static StatusRegister s_status = {};
 static bool s_enable_dma_in = false;
 static bool s_enable_dma_out = false;
@@ -146,6 +164,28 @@ alignas(16) static std::array<u32, 256> s_block_rgb{};
 static std::unique_ptr<TimingEvent> s_block_copy_out_event;
 
 static u32 s_total_blocks_decoded = 0;
+
+// Asynchronous decode thread. The emu thread only submits jobs for a macroblock once its input is
+// fully RL-decoded, and the state machine doesn't touch s_blocks/s_block_rgb again until the copy
+// out event fires, which waits for the queue to drain. At most one macroblock is ever in flight.
+//
+// Decoding on the host GPU instead has been considered and rejected: decoded macroblocks are
+// drained from the data-out FIFO into main RAM by DMA, where games are free to read or repack them
+// before uploading to VRAM themselves, so the output must exist CPU-side and a compute path would
+// still have to read it back. GPUDevice also only abstracts graphics pipelines.
+static Threading::Thread s_decode_thread;
+static std::mutex s_decode_thread_mutex;
+static std::condition_variable s_decode_thread_wake_cv;
+static std::condition_variable s_decode_thread_idle_cv;
+static std::array<u8, 16> s_decode_thread_jobs;
+static u32 s_decode_thread_job_head = 0;
+static u32 s_decode_thread_job_count = 0;
+static bool s_decode_thread_shutdown = false;
+static bool s_decode_thread_started = false;
+
+// Captured at submission time, so the decode thread never reads mutable emu-thread state.
+static bool s_async_use_old_routines = false;
+static s16 s_async_addval = 0;
 } // namespace MDEC
 
 void MDEC::Initialize()
@@ -153,14 +193,30 @@ void MDEC::Initialize()
   s_block_copy_out_event =
     TimingEvents::CreateTimingEvent("MDEC Block Copy Out", 1, 1, &MDEC::CopyOutBlock, nullptr, false);
   s_total_blocks_decoded = 0;
+
+  if (g_settings.mdec_async_decode)
+    StartDecodeThread();
+
   Reset();
 }
 
 void MDEC::Shutdown()
 {
+  StopDecodeThread();
   s_block_copy_out_event.reset();
 }
 
+void MDEC::UpdateSettings()
+{
+  if (g_settings.mdec_async_decode == s_decode_thread_started)
+    return;
+
+  if (g_settings.mdec_async_decode)
+    StartDecodeThread();
+  else
+    StopDecodeThread();
+}
+
 void MDEC::Reset()
 {
   s_block_copy_out_event->Deactivate();
@@ -169,6 +225,10 @@ void MDEC::Reset()
 
 bool MDEC::DoState(StateWrapper& sw)
 {
+  // Both s_blocks and s_block_rgb may belong to the decode thread right now; draining it here
+  // makes the saved state identical to what synchronous decoding would have produced.
+  WaitForAsyncDecode();
+
   sw.Do(&s_status.bits);
   sw.Do(&s_enable_dma_in);
   sw.Do(&s_enable_dma_out);
@@ -279,6 +339,16 @@ void MDEC::DMAWrite(const u32* words, u32 word_count)
   Execute();
 }
 
+u32 MDEC::GetDMAWriteSpace()
+{
+  return (s_data_in_fifo.GetSpace() & ~u32(2)) / 2;
+}
+
+u32 MDEC::GetDMAReadAvailable()
+{
+  return s_data_out_fifo.GetSize();
+}
+
 bool MDEC::HasPendingBlockCopyOut()
 {
   return s_block_copy_out_event->IsActive();
@@ -286,6 +356,8 @@ bool MDEC::HasPendingBlockCopyOut()
 
 void MDEC::SoftReset()
 {
+  WaitForAsyncDecode();
+
   s_status.bits = 0;
   s_enable_dma_in = false;
   s_enable_dma_out = false;
@@ -508,13 +580,24 @@ bool MDEC::DecodeMonoMacroblock()
   if (!rl_decode_block(s_blocks[0].data(), s_iq_y.data()))
     return false;
 
-  IDCT(s_blocks[0].data());
+  if (s_decode_thread_started)
+  {
+    s_async_use_old_routines = g_settings.use_old_mdec_routines;
+    SubmitAsyncDecodeJob(0);
+  }
+  else
+  {
+    IDCT(s_blocks[0].data());
+  }
 
   Log_DebugPrintf("Decoded mono macroblock, %u words remaining", s_remaining_halfwords / 2);
   ResetDecoder();
   s_state = State::WritingMacroblock;
 
-  y_to_mono(s_blocks[0]);
+  if (s_decode_thread_started)
+    SubmitAsyncDecodeJob(ASYNC_JOB_MONO_CONVERT);
+  else
+    y_to_mono(s_blocks[0]);
 
   ScheduleBlockCopyOut(TICKS_PER_BLOCK * 6);
 
@@ -529,7 +612,18 @@ bool MDEC::DecodeColoredMacroblock()
     if (!rl_decode_block(s_blocks[s_current_block].data(), (s_current_block >= 2) ? s_iq_y.data() : s_iq_uv.data()))
       return false;
 
-    IDCT(s_blocks[s_current_block].data());
+    // Pipelined mode transforms the block on the decode thread while we RL-decode the next one;
+    // the thread is guaranteed idle when the first block is submitted.
+    if (s_decode_thread_started)
+    {
+      if (s_current_block == 0)
+        s_async_use_old_routines = g_settings.use_old_mdec_routines;
+      SubmitAsyncDecodeJob(Truncate8(s_current_block));
+    }
+    else
+    {
+      IDCT(s_blocks[s_current_block].data());
+    }
   }
 
   if (!s_data_out_fifo.IsEmpty())
@@ -540,10 +634,19 @@ bool MDEC::DecodeColoredMacroblock()
   ResetDecoder();
   s_state = State::WritingMacroblock;
 
-  yuv_to_rgb(0, 0, s_blocks[0], s_blocks[1], s_blocks[2]);
-  yuv_to_rgb(8, 0, s_blocks[0], s_blocks[1], s_blocks[3]);
-  yuv_to_rgb(0, 8, s_blocks[0], s_blocks[1], s_blocks[4]);
-  yuv_to_rgb(8, 8, s_blocks[0], s_blocks[1], s_blocks[5]);
+  const s16 addval = s_status.data_output_signed ? 0 : 0x80;
+  if (s_decode_thread_started)
+  {
+    s_async_addval = addval;
+    SubmitAsyncDecodeJob(ASYNC_JOB_COLOR_CONVERT);
+  }
+  else
+  {
+    yuv_to_rgb(0, 0, s_blocks[0], s_blocks[1], s_blocks[2], addval);
+    yuv_to_rgb(8, 0, s_blocks[0], s_blocks[1], s_blocks[3], addval);
+    yuv_to_rgb(0, 8, s_blocks[0], s_blocks[1], s_blocks[4], addval);
+    yuv_to_rgb(8, 8, s_blocks[0], s_blocks[1], s_blocks[5], addval);
+  }
   s_total_blocks_decoded += 4;
 
   ScheduleBlockCopyOut(TICKS_PER_BLOCK * 6);
@@ -563,6 +666,10 @@ void MDEC::CopyOutBlock(void* param, TickCount ticks, TickCount ticks_late)
   Assert(s_state == State::WritingMacroblock);
   s_block_copy_out_event->Deactivate();
 
+  // The macroblock's transform may still be in flight; this is the point where it becomes visible
+  // to the guest, so wait for it here rather than at decode time.
+  WaitForAsyncDecode();
+
   switch (s_status.data_output_depth)
   {
     case DataOutputDepth_4Bit:
@@ -781,13 +888,118 @@ void MDEC::IDCT(s16* blk)
 
 void MDEC::IDCT_New(s16* blk)
 {
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+  // The butterfly only ever uses the scale table divided by 8, so hoist that out of the loops.
+  alignas(VECTOR_ALIGNMENT) std::array<s16, 64> scale;
+  for (u32 i = 0; i < 64; i++)
+    scale[i] = static_cast<s16>(s_scale_table[i] / 8);
+
+  // Both passes compute row x of the output from a scalar coefficient and row x of the scale
+  // table, so each output row is eight multiply-accumulates of broadcast * scale row. The
+  // 0xfff rounding bias seeds the accumulator, and the /0x2000 is done as a truncating (not
+  // arithmetic) shift to match the scalar division.
+  alignas(VECTOR_ALIGNMENT) std::array<s16, 64> temp;
+
+#if defined(CPU_ARCH_SSE)
+  const auto TruncDiv8K = [](__m128i sum) {
+    const __m128i bias = _mm_and_si128(_mm_srai_epi32(sum, 31), _mm_set1_epi32(0x1FFF));
+    return _mm_srai_epi32(_mm_add_epi32(sum, bias), 13);
+  };
+
+  for (u32 y = 0; y < 8; y++)
+  {
+    __m128i acc_lo = _mm_set1_epi32(0xfff);
+    __m128i acc_hi = acc_lo;
+    for (u32 z = 0; z < 8; z++)
+    {
+      const s16 coeff = blk[y + z * 8];
+      if (coeff == 0)
+        continue;
+
+      const __m128i mult = _mm_set1_epi16(coeff);
+      const __m128i row = _mm_load_si128(reinterpret_cast<const __m128i*>(&scale[z * 8]));
+      const __m128i plo = _mm_mullo_epi16(mult, row);
+      const __m128i phi = _mm_mulhi_epi16(mult, row);
+      acc_lo = _mm_add_epi32(acc_lo, _mm_unpacklo_epi16(plo, phi));
+      acc_hi = _mm_add_epi32(acc_hi, _mm_unpackhi_epi16(plo, phi));
+    }
+
+    _mm_store_si128(reinterpret_cast<__m128i*>(&temp[y * 8]),
+                    _mm_packs_epi32(TruncDiv8K(acc_lo), TruncDiv8K(acc_hi)));
+  }
+
+  for (u32 y = 0; y < 8; y++)
+  {
+    __m128i acc_lo = _mm_set1_epi32(0xfff);
+    __m128i acc_hi = acc_lo;
+    for (u32 z = 0; z < 8; z++)
+    {
+      const s16 coeff = temp[y + z * 8];
+      if (coeff == 0)
+        continue;
+
+      const __m128i mult = _mm_set1_epi16(coeff);
+      const __m128i row = _mm_load_si128(reinterpret_cast<const __m128i*>(&scale[z * 8]));
+      const __m128i plo = _mm_mullo_epi16(mult, row);
+      const __m128i phi = _mm_mulhi_epi16(mult, row);
+      acc_lo = _mm_add_epi32(acc_lo, _mm_unpacklo_epi16(plo, phi));
+      acc_hi = _mm_add_epi32(acc_hi, _mm_unpackhi_epi16(plo, phi));
+    }
+
+    __m128i result = _mm_packs_epi32(TruncDiv8K(acc_lo), TruncDiv8K(acc_hi));
+    result = _mm_max_epi16(_mm_min_epi16(result, _mm_set1_epi16(127)), _mm_set1_epi16(-128));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&blk[y * 8]), result);
+  }
+#elif defined(CPU_ARCH_NEON)
+  const auto TruncDiv8K = [](int32x4_t sum) {
+    const int32x4_t bias = vandq_s32(vshrq_n_s32(sum, 31), vdupq_n_s32(0x1FFF));
+    return vshrq_n_s32(vaddq_s32(sum, bias), 13);
+  };
+
+  for (u32 y = 0; y < 8; y++)
+  {
+    int32x4_t acc_lo = vdupq_n_s32(0xfff);
+    int32x4_t acc_hi = acc_lo;
+    for (u32 z = 0; z < 8; z++)
+    {
+      const s16 coeff = blk[y + z * 8];
+      if (coeff == 0)
+        continue;
+
+      const int16x8_t row = vld1q_s16(&scale[z * 8]);
+      acc_lo = vmlal_n_s16(acc_lo, vget_low_s16(row), coeff);
+      acc_hi = vmlal_n_s16(acc_hi, vget_high_s16(row), coeff);
+    }
+
+    vst1q_s16(&temp[y * 8], vcombine_s16(vqmovn_s32(TruncDiv8K(acc_lo)), vqmovn_s32(TruncDiv8K(acc_hi))));
+  }
+
+  for (u32 y = 0; y < 8; y++)
+  {
+    int32x4_t acc_lo = vdupq_n_s32(0xfff);
+    int32x4_t acc_hi = acc_lo;
+    for (u32 z = 0; z < 8; z++)
+    {
+      const s16 coeff = temp[y + z * 8];
+      if (coeff == 0)
+        continue;
+
+      const int16x8_t row = vld1q_s16(&scale[z * 8]);
+      acc_lo = vmlal_n_s16(acc_lo, vget_low_s16(row), coeff);
+      acc_hi = vmlal_n_s16(acc_hi, vget_high_s16(row), coeff);
+    }
+
+    int16x8_t result = vcombine_s16(vqmovn_s32(TruncDiv8K(acc_lo)), vqmovn_s32(TruncDiv8K(acc_hi)));
+    result = vmaxq_s16(vminq_s16(result, vdupq_n_s16(127)), vdupq_n_s16(-128));
+    vst1q_s16(&blk[y * 8], result);
+  }
+#endif
+#else
   std::array<s32, 64> temp;
   for (u32 x = 0; x < 8; x++)
   {
     for (u32 y = 0; y < 8; y++)
     {
-      // TODO: We could alter zigzag and invert scale_table to get these in row-major order,
-      // in which case we could do optimize this to a vector multiply.
       s32 sum = 0;
       for (u32 z = 0; z < 8; z++)
         sum += s32(blk[y + z * 8]) * s32(s_scale_table[x + z * 8] / 8);
@@ -804,6 +1016,7 @@ void MDEC::IDCT_New(s16* blk)
       blk[x + y * 8] = static_cast<s16>(std::clamp<s32>((sum + 0xfff) / 0x2000, -128, 127));
     }
   }
+#endif
 }
 
 void MDEC::IDCT_Old(s16* blk)
@@ -834,9 +1047,118 @@ void MDEC::IDCT_Old(s16* blk)
 }
 
 void MDEC::yuv_to_rgb(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk,
-                      const std::array<s16, 64>& Yblk)
+                      const std::array<s16, 64>& Yblk, s16 addval)
 {
-  const s16 addval = s_status.data_output_signed ? 0 : 0x80;
+#if defined(CPU_ARCH_SSE)
+  // Each row converts eight pixels at once; every conversion step mirrors a scalar step exactly,
+  // including the truncating float-to-int casts and the 16-bit component assembly.
+  const __m128 cr_mult = _mm_set1_ps(1.402f);
+  const __m128 cb_mult = _mm_set1_ps(1.772f);
+  const __m128 g_cb_mult = _mm_set1_ps(-0.3437f);
+  const __m128 g_cr_mult = _mm_set1_ps(-0.7143f);
+  const __m128i vaddval = _mm_set1_epi16(addval);
+  const __m128i vmin = _mm_set1_epi16(-128);
+  const __m128i vmax = _mm_set1_epi16(127);
+  const __m128i zero = _mm_setzero_si128();
+
+  for (u32 y = 0; y < 8; y++)
+  {
+    const __m128i cr_row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Crblk[((y + yy) / 2) * 8]));
+    const __m128i cb_row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Cbblk[((y + yy) / 2) * 8]));
+
+    // Each chroma sample covers two pixels horizontally, so duplicate the four relevant samples
+    // into eight sign-extended 32-bit lanes.
+    const __m128i cr16 = (xx != 0) ? _mm_unpackhi_epi16(cr_row, cr_row) : _mm_unpacklo_epi16(cr_row, cr_row);
+    const __m128i cb16 = (xx != 0) ? _mm_unpackhi_epi16(cb_row, cb_row) : _mm_unpacklo_epi16(cb_row, cb_row);
+    const __m128 cr_lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(cr16, cr16), 16));
+    const __m128 cr_hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(cr16, cr16), 16));
+    const __m128 cb_lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(cb16, cb16), 16));
+    const __m128 cb_hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(cb16, cb16), 16));
+
+    const __m128i r_lo = _mm_cvttps_epi32(_mm_mul_ps(cr_lo, cr_mult));
+    const __m128i r_hi = _mm_cvttps_epi32(_mm_mul_ps(cr_hi, cr_mult));
+    const __m128i g_lo = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(cb_lo, g_cb_mult), _mm_mul_ps(cr_lo, g_cr_mult)));
+    const __m128i g_hi = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(cb_hi, g_cb_mult), _mm_mul_ps(cr_hi, g_cr_mult)));
+    const __m128i b_lo = _mm_cvttps_epi32(_mm_mul_ps(cb_lo, cb_mult));
+    const __m128i b_hi = _mm_cvttps_epi32(_mm_mul_ps(cb_hi, cb_mult));
+
+    const __m128i y_row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Yblk[y * 8]));
+    const __m128i y_lo = _mm_srai_epi32(_mm_unpacklo_epi16(y_row, y_row), 16);
+    const __m128i y_hi = _mm_srai_epi32(_mm_unpackhi_epi16(y_row, y_row), 16);
+
+    // Luma plus chroma fits comfortably in 16 bits, and the clamp range is inside the pack's
+    // saturation range, so packing before clamping matches the scalar result.
+    __m128i r16 = _mm_packs_epi32(_mm_add_epi32(y_lo, r_lo), _mm_add_epi32(y_hi, r_hi));
+    __m128i g16 = _mm_packs_epi32(_mm_add_epi32(y_lo, g_lo), _mm_add_epi32(y_hi, g_hi));
+    __m128i b16 = _mm_packs_epi32(_mm_add_epi32(y_lo, b_lo), _mm_add_epi32(y_hi, b_hi));
+    r16 = _mm_add_epi16(_mm_max_epi16(_mm_min_epi16(r16, vmax), vmin), vaddval);
+    g16 = _mm_add_epi16(_mm_max_epi16(_mm_min_epi16(g16, vmax), vmin), vaddval);
+    b16 = _mm_add_epi16(_mm_max_epi16(_mm_min_epi16(b16, vmax), vmin), vaddval);
+
+    u32* out_ptr = &s_block_rgb[xx + ((y + yy) * 16)];
+    _mm_store_si128(reinterpret_cast<__m128i*>(out_ptr),
+                    _mm_or_si128(_mm_or_si128(_mm_unpacklo_epi16(r16, zero),
+                                              _mm_slli_epi32(_mm_unpacklo_epi16(g16, zero), 8)),
+                                 _mm_slli_epi32(_mm_unpacklo_epi16(b16, zero), 16)));
+    _mm_store_si128(reinterpret_cast<__m128i*>(out_ptr + 4),
+                    _mm_or_si128(_mm_or_si128(_mm_unpackhi_epi16(r16, zero),
+                                              _mm_slli_epi32(_mm_unpackhi_epi16(g16, zero), 8)),
+                                 _mm_slli_epi32(_mm_unpackhi_epi16(b16, zero), 16)));
+  }
+#elif defined(CPU_ARCH_NEON)
+  const int16x8_t vaddval = vdupq_n_s16(addval);
+  const int16x8_t vmin = vdupq_n_s16(-128);
+  const int16x8_t vmax = vdupq_n_s16(127);
+
+  for (u32 y = 0; y < 8; y++)
+  {
+    const int16x8_t cr_row = vld1q_s16(&Crblk[((y + yy) / 2) * 8]);
+    const int16x8_t cb_row = vld1q_s16(&Cbblk[((y + yy) / 2) * 8]);
+
+    // Each chroma sample covers two pixels horizontally, so duplicate the four relevant samples
+    // into eight 32-bit lanes.
+    const int16x4_t cr_half = (xx != 0) ? vget_high_s16(cr_row) : vget_low_s16(cr_row);
+    const int16x4_t cb_half = (xx != 0) ? vget_high_s16(cb_row) : vget_low_s16(cb_row);
+    const int16x4x2_t cr_dup = vzip_s16(cr_half, cr_half);
+    const int16x4x2_t cb_dup = vzip_s16(cb_half, cb_half);
+    const float32x4_t cr_lo = vcvtq_f32_s32(vmovl_s16(cr_dup.val[0]));
+    const float32x4_t cr_hi = vcvtq_f32_s32(vmovl_s16(cr_dup.val[1]));
+    const float32x4_t cb_lo = vcvtq_f32_s32(vmovl_s16(cb_dup.val[0]));
+    const float32x4_t cb_hi = vcvtq_f32_s32(vmovl_s16(cb_dup.val[1]));
+
+    // Separate multiply and add, to match the scalar code's intermediate rounding (vmlaq could
+    // fuse and produce off-by-one results).
+    const int32x4_t r_lo = vcvtq_s32_f32(vmulq_n_f32(cr_lo, 1.402f));
+    const int32x4_t r_hi = vcvtq_s32_f32(vmulq_n_f32(cr_hi, 1.402f));
+    const int32x4_t g_lo = vcvtq_s32_f32(vaddq_f32(vmulq_n_f32(cb_lo, -0.3437f), vmulq_n_f32(cr_lo, -0.7143f)));
+    const int32x4_t g_hi = vcvtq_s32_f32(vaddq_f32(vmulq_n_f32(cb_hi, -0.3437f), vmulq_n_f32(cr_hi, -0.7143f)));
+    const int32x4_t b_lo = vcvtq_s32_f32(vmulq_n_f32(cb_lo, 1.772f));
+    const int32x4_t b_hi = vcvtq_s32_f32(vmulq_n_f32(cb_hi, 1.772f));
+
+    const int16x8_t y_row = vld1q_s16(&Yblk[y * 8]);
+    const int32x4_t y_lo = vmovl_s16(vget_low_s16(y_row));
+    const int32x4_t y_hi = vmovl_s16(vget_high_s16(y_row));
+
+    int16x8_t r16 = vcombine_s16(vqmovn_s32(vaddq_s32(y_lo, r_lo)), vqmovn_s32(vaddq_s32(y_hi, r_hi)));
+    int16x8_t g16 = vcombine_s16(vqmovn_s32(vaddq_s32(y_lo, g_lo)), vqmovn_s32(vaddq_s32(y_hi, g_hi)));
+    int16x8_t b16 = vcombine_s16(vqmovn_s32(vaddq_s32(y_lo, b_lo)), vqmovn_s32(vaddq_s32(y_hi, b_hi)));
+    r16 = vaddq_s16(vmaxq_s16(vminq_s16(r16, vmax), vmin), vaddval);
+    g16 = vaddq_s16(vmaxq_s16(vminq_s16(g16, vmax), vmin), vaddval);
+    b16 = vaddq_s16(vmaxq_s16(vminq_s16(b16, vmax), vmin), vaddval);
+
+    const uint16x8_t r16u = vreinterpretq_u16_s16(r16);
+    const uint16x8_t g16u = vreinterpretq_u16_s16(g16);
+    const uint16x8_t b16u = vreinterpretq_u16_s16(b16);
+
+    u32* out_ptr = &s_block_rgb[xx + ((y + yy) * 16)];
+    vst1q_u32(out_ptr, vorrq_u32(vorrq_u32(vmovl_u16(vget_low_u16(r16u)),
+                                           vshlq_n_u32(vmovl_u16(vget_low_u16(g16u)), 8)),
+                                 vshlq_n_u32(vmovl_u16(vget_low_u16(b16u)), 16)));
+    vst1q_u32(out_ptr + 4, vorrq_u32(vorrq_u32(vmovl_u16(vget_high_u16(r16u)),
+                                               vshlq_n_u32(vmovl_u16(vget_high_u16(g16u)), 8)),
+                                     vshlq_n_u32(vmovl_u16(vget_high_u16(b16u)), 16)));
+  }
+#else
   for (u32 y = 0; y < 8; y++)
   {
     for (u32 x = 0; x < 8; x++)
@@ -858,6 +1180,7 @@ void MDEC::yuv_to_rgb(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const st
                                                 (ZeroExtend32(static_cast<u16>(B)) << 16);
     }
   }
+#endif
 }
 
 void MDEC::y_to_mono(const std::array<s16, 64>& Yblk)
@@ -872,6 +1195,100 @@ void MDEC::y_to_mono(const std::array<s16, 64>& Yblk)
   }
 }
 
+void MDEC::StartDecodeThread()
+{
+  DebugAssert(!s_decode_thread_started);
+  s_decode_thread_shutdown = false;
+  s_decode_thread_started = true;
+  s_decode_thread.Start([]() { DecodeThreadEntryPoint(); });
+  Log_InfoPrint("MDEC decode thread started.");
+}
+
+void MDEC::StopDecodeThread()
+{
+  if (!s_decode_thread_started)
+    return;
+
+  WaitForAsyncDecode();
+
+  {
+    std::unique_lock<std::mutex> lock(s_decode_thread_mutex);
+    s_decode_thread_shutdown = true;
+    s_decode_thread_wake_cv.notify_one();
+  }
+
+  s_decode_thread.Join();
+  s_decode_thread_started = false;
+  Log_InfoPrint("MDEC decode thread stopped.");
+}
+
+void MDEC::SubmitAsyncDecodeJob(u8 job)
+{
+  std::unique_lock<std::mutex> lock(s_decode_thread_mutex);
+  DebugAssert(s_decode_thread_job_count < static_cast<u32>(s_decode_thread_jobs.size()));
+  s_decode_thread_jobs[(s_decode_thread_job_head + s_decode_thread_job_count) %
+                       static_cast<u32>(s_decode_thread_jobs.size())] = job;
+  s_decode_thread_job_count++;
+  s_decode_thread_wake_cv.notify_one();
+}
+
+void MDEC::WaitForAsyncDecode()
+{
+  if (!s_decode_thread_started)
+    return;
+
+  std::unique_lock<std::mutex> lock(s_decode_thread_mutex);
+  s_decode_thread_idle_cv.wait(lock, []() { return (s_decode_thread_job_count == 0); });
+}
+
+void MDEC::DecodeThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("MDEC Decode");
+
+  std::unique_lock<std::mutex> lock(s_decode_thread_mutex);
+  for (;;)
+  {
+    if (s_decode_thread_job_count == 0)
+    {
+      s_decode_thread_wake_cv.wait(
+        lock, []() { return (s_decode_thread_shutdown || s_decode_thread_job_count > 0); });
+      if (s_decode_thread_shutdown)
+        break;
+
+      continue;
+    }
+
+    // The job stays in the queue while it runs, so the idle wait covers it.
+    const u8 job = s_decode_thread_jobs[s_decode_thread_job_head];
+    lock.unlock();
+
+    if (job < NUM_BLOCKS)
+    {
+      if (s_async_use_old_routines) [[unlikely]]
+        IDCT_Old(s_blocks[job].data());
+      else
+        IDCT_New(s_blocks[job].data());
+    }
+    else if (job == ASYNC_JOB_COLOR_CONVERT)
+    {
+      yuv_to_rgb(0, 0, s_blocks[0], s_blocks[1], s_blocks[2], s_async_addval);
+      yuv_to_rgb(8, 0, s_blocks[0], s_blocks[1], s_blocks[3], s_async_addval);
+      yuv_to_rgb(0, 8, s_blocks[0], s_blocks[1], s_blocks[4], s_async_addval);
+      yuv_to_rgb(8, 8, s_blocks[0], s_blocks[1], s_blocks[5], s_async_addval);
+    }
+    else
+    {
+      y_to_mono(s_blocks[0]);
+    }
+
+    lock.lock();
+    s_decode_thread_job_head = (s_decode_thread_job_head + 1) % static_cast<u32>(s_decode_thread_jobs.size());
+    s_decode_thread_job_count--;
+    if (s_decode_thread_job_count == 0)
+      s_decode_thread_idle_cv.notify_all();
+  }
+}
+
 void MDEC::HandleSetQuantTableCommand()
 {
   DebugAssert(s_remaining_halfwords >= 32);
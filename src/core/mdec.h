@@ -10,6 +10,7 @@ namespace MDEC {
 
 void Initialize();
 void Shutdown();
+void UpdateSettings();
 void Reset();
 bool DoState(StateWrapper& sw);
 
@@ -20,6 +21,11 @@ void WriteRegister(u32 offset, u32 value);
 void DMARead(u32* words, u32 word_count);
 void DMAWrite(const u32* words, u32 word_count);
 
+/// Returns the number of words the input FIFO can currently accept, and the number of words
+/// available in the output FIFO. Used to size batched DMA block transfers.
+u32 GetDMAWriteSpace();
+u32 GetDMAReadAvailable();
+
 void DrawDebugStateWindow();
 
 } // namespace MDEC
@@ -14,6 +14,7 @@
 #include "common/log.h"
 #include "common/path.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 
 #include "IconsFontAwesome5.h"
 
@@ -33,7 +34,10 @@ MemoryCard::MemoryCard()
 
 MemoryCard::~MemoryCard()
 {
+  // Wait for any in-flight flush first, otherwise SaveIfChanged() would defer to it.
+  WaitForSaveCompletion();
   SaveIfChanged(false);
+  WaitForSaveCompletion();
 }
 
 std::string MemoryCard::SanitizeGameTitleForFileName(const std::string_view& name)
@@ -76,6 +80,10 @@ bool MemoryCard::DoState(StateWrapper& sw)
   sw.Do(&m_data);
   sw.Do(&m_changed);
 
+  // The whole image was replaced, so any pending flush has to write everything.
+  if (sw.IsReading() && m_changed)
+    m_dirty_frames.set();
+
   return !sw.HasError();
 }
 
@@ -188,7 +196,11 @@ bool MemoryCard::Transfer(const u8 data_in, u8* data_out)
       }
 
       const u32 offset = ZeroExtend32(m_address) * MemoryCardImage::FRAME_SIZE + m_sector_offset;
-      m_changed |= (m_data[offset] != data_in);
+      if (m_data[offset] != data_in)
+      {
+        m_changed = true;
+        m_dirty_frames.set(m_address);
+      }
       m_data[offset] = data_in;
 
       *data_out = m_last_byte;
@@ -298,6 +310,7 @@ void MemoryCard::Format()
 {
   MemoryCardImage::Format(&m_data);
   m_changed = true;
+  m_dirty_frames.set();
 }
 
 bool MemoryCard::LoadFromFile()
@@ -312,42 +325,65 @@ bool MemoryCard::SaveIfChanged(bool display_osd_message)
   if (!m_changed)
     return true;
 
-  m_changed = false;
-
   if (m_filename.empty())
-    return false;
-
-  std::string osd_key;
-  std::string display_name;
-  if (display_osd_message)
   {
-    osd_key = fmt::format("memory_card_save_{}", m_filename);
-    display_name = FileSystem::GetDisplayNameFromPath(m_filename);
+    m_changed = false;
+    return false;
   }
 
-  if (!MemoryCardImage::SaveToFile(m_data, m_filename.c_str()))
+  // If the previous flush is still in flight, try again in a few seconds rather than stalling.
   {
-    if (display_osd_message)
+    std::unique_lock<std::mutex> lock(m_save_mutex);
+    if (m_save_in_flight)
     {
-      Host::AddIconOSDMessage(
-        std::move(osd_key), ICON_FA_SD_CARD,
-        fmt::format(TRANSLATE_FS("OSDMessage", "Failed to save memory card to '{}'."), Path::GetFileName(display_name)),
-        20.0f);
+      m_save_event->Schedule(GetSaveDelayInTicks());
+      return true;
     }
 
-    return false;
+    m_save_in_flight = true;
   }
 
-  if (display_osd_message)
-  {
-    Host::AddIconOSDMessage(
-      std::move(osd_key), ICON_FA_SD_CARD,
-      fmt::format(TRANSLATE_FS("OSDMessage", "Saved memory card to '{}'."), Path::GetFileName(display_name)), 5.0f);
-  }
+  // Snapshot the image and dirty set so the worker doesn't race writes from the sio thread, then
+  // do the file I/O on the thread pool - flash-backed filesystems can stall for tens of ms.
+  m_changed = false;
+  Threading::ThreadPool::QueueWork(
+    [this, data = m_data, dirty_frames = m_dirty_frames, filename = m_filename, display_osd_message]() {
+      const bool result = MemoryCardImage::SaveUpdatedFrames(data, dirty_frames, filename.c_str());
+      if (display_osd_message)
+      {
+        std::string osd_key = fmt::format("memory_card_save_{}", filename);
+        const std::string display_name = FileSystem::GetDisplayNameFromPath(filename);
+        if (result)
+        {
+          Host::AddIconOSDMessage(
+            std::move(osd_key), ICON_FA_SD_CARD,
+            fmt::format(TRANSLATE_FS("OSDMessage", "Saved memory card to '{}'."), Path::GetFileName(display_name)),
+            5.0f);
+        }
+        else
+        {
+          Host::AddIconOSDMessage(std::move(osd_key), ICON_FA_SD_CARD,
+                                  fmt::format(TRANSLATE_FS("OSDMessage", "Failed to save memory card to '{}'."),
+                                              Path::GetFileName(display_name)),
+                                  20.0f);
+        }
+      }
+
+      std::unique_lock<std::mutex> lock(m_save_mutex);
+      m_save_in_flight = false;
+      m_save_cv.notify_all();
+    });
+  m_dirty_frames.reset();
 
   return true;
 }
 
+void MemoryCard::WaitForSaveCompletion()
+{
+  std::unique_lock<std::mutex> lock(m_save_mutex);
+  m_save_cv.wait(lock, [this]() { return !m_save_in_flight; });
+}
+
 void MemoryCard::QueueFileSave()
 {
   // skip if the event is already pending, or we don't have a backing file
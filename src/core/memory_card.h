@@ -6,7 +6,9 @@
 #include "controller.h"
 #include "memory_card_image.h"
 #include <array>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 
@@ -86,6 +88,7 @@ private:
   bool LoadFromFile();
   bool SaveIfChanged(bool display_osd_message);
   void QueueFileSave();
+  void WaitForSaveCompletion();
 
   std::unique_ptr<TimingEvent> m_save_event;
 
@@ -98,6 +101,12 @@ private:
   bool m_changed = false;
 
   MemoryCardImage::DataArray m_data{};
+  MemoryCardImage::FrameBitset m_dirty_frames{};
 
   std::string m_filename;
+
+  // Flushes run on the thread pool; only one is in flight per card at a time.
+  std::mutex m_save_mutex;
+  std::condition_variable m_save_cv;
+  bool m_save_in_flight = false;
 };
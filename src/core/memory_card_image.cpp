@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <optional>
 
 Log_SetChannel(MemoryCard);
@@ -86,6 +87,32 @@ const T* GetFramePtr(const DataArray& data, u32 block, u32 frame)
   return reinterpret_cast<const T*>(&data[(block * BLOCK_SIZE) + (frame * FRAME_SIZE)]);
 }
 
+#pragma pack(push, 1)
+
+// Prepended to the sectors of an incremental flush. The footer magic is only written once all
+// entries are on disk, so a truncated journal is detected and discarded on replay.
+struct JournalHeader
+{
+  u32 magic;
+  u32 num_frames;
+};
+
+struct JournalEntry
+{
+  u32 frame_index;
+  u8 data[FRAME_SIZE];
+};
+
+#pragma pack(pop)
+
+enum : u32
+{
+  JOURNAL_MAGIC = 0x314A434D,  // "MCJ1"
+  JOURNAL_COMMIT_MAGIC = 0x544D4D43, // "CMMT"
+};
+
+static std::string GetJournalFilename(const char* filename);
+static void ReplayJournal(DataArray* data, const char* filename);
 static std::optional<u32> GetNextFreeBlock(const DataArray& data);
 static bool ImportCardMCD(DataArray* data, const char* filename, std::vector<u8> file_data);
 static bool ImportCardGME(DataArray* data, const char* filename, std::vector<u8> file_data);
@@ -112,10 +139,151 @@ bool MemoryCardImage::LoadFromFile(DataArray* data, const char* filename)
     return false;
   }
 
+  stream.reset();
+
+  // Pick up any sectors from an incremental flush that didn't make it into the image.
+  ReplayJournal(data, filename);
+
   Log_VerboseFmt("Loaded memory card from {}", filename);
   return true;
 }
 
+std::string MemoryCardImage::GetJournalFilename(const char* filename)
+{
+  return std::string(filename) + ".journal";
+}
+
+void MemoryCardImage::ReplayJournal(DataArray* data, const char* filename)
+{
+  const std::string journal_filename = GetJournalFilename(filename);
+  if (!FileSystem::FileExists(journal_filename.c_str()))
+    return;
+
+  const std::optional<std::vector<u8>> journal = FileSystem::ReadBinaryFile(journal_filename.c_str());
+  JournalHeader header;
+  if (!journal.has_value() || journal->size() < (sizeof(JournalHeader) + sizeof(u32)))
+  {
+    Log_WarningFmt("Discarding unreadable journal '{}'.", journal_filename);
+    FileSystem::DeleteFile(journal_filename.c_str());
+    return;
+  }
+
+  std::memcpy(&header, journal->data(), sizeof(header));
+
+  u32 commit_magic = 0;
+  const size_t expected_size = sizeof(JournalHeader) + (header.num_frames * sizeof(JournalEntry)) + sizeof(u32);
+  if (journal->size() >= expected_size)
+    std::memcpy(&commit_magic, journal->data() + expected_size - sizeof(u32), sizeof(u32));
+
+  // An uncommitted journal means we crashed before touching the image, so the image is still
+  // consistent and the journal can be thrown away.
+  if (header.magic != JOURNAL_MAGIC || header.num_frames == 0 || header.num_frames > NUM_FRAMES ||
+      journal->size() != expected_size || commit_magic != JOURNAL_COMMIT_MAGIC)
+  {
+    Log_WarningFmt("Discarding incomplete journal '{}'.", journal_filename);
+    FileSystem::DeleteFile(journal_filename.c_str());
+    return;
+  }
+
+  JournalEntry entry;
+  for (u32 i = 0; i < header.num_frames; i++)
+  {
+    std::memcpy(&entry, journal->data() + sizeof(JournalHeader) + (i * sizeof(JournalEntry)), sizeof(entry));
+    if (entry.frame_index >= NUM_FRAMES)
+    {
+      Log_WarningFmt("Journal '{}' contains out-of-range sector {}.", journal_filename, entry.frame_index);
+      continue;
+    }
+
+    std::memcpy(data->data() + (entry.frame_index * FRAME_SIZE), entry.data, FRAME_SIZE);
+  }
+
+  Log_WarningFmt("Replayed {} sectors from journal '{}'.", header.num_frames, journal_filename);
+
+  // Make the image itself consistent again before dropping the journal.
+  if (SaveToFile(*data, filename))
+    FileSystem::DeleteFile(journal_filename.c_str());
+}
+
+bool MemoryCardImage::SaveUpdatedFrames(const DataArray& data, const FrameBitset& dirty_frames, const char* filename)
+{
+  // A full rewrite is cheaper when most of the card changed, and files which aren't plain images
+  // of the expected size can't be patched in place.
+  FILESYSTEM_STAT_DATA sd;
+  const u32 num_dirty = static_cast<u32>(dirty_frames.count());
+  if (num_dirty == 0)
+    return true;
+  if (num_dirty >= (NUM_FRAMES / 2) || !FileSystem::StatFile(filename, &sd) || sd.Size != DATA_SIZE)
+    return SaveToFile(data, filename);
+
+  // Journal the sectors first, so that a crash mid-update leaves either an untouched image (no
+  // commit magic yet) or a complete journal which LoadFromFile() replays.
+  const std::string journal_filename = GetJournalFilename(filename);
+  {
+    auto fp = FileSystem::OpenManagedCFile(journal_filename.c_str(), "wb");
+    if (!fp)
+      return SaveToFile(data, filename);
+
+    const JournalHeader header = {JOURNAL_MAGIC, num_dirty};
+    constexpr u32 commit_magic = JOURNAL_COMMIT_MAGIC;
+    bool journal_ok = (std::fwrite(&header, sizeof(header), 1, fp.get()) == 1);
+    JournalEntry entry;
+    for (u32 i = 0; journal_ok && i < NUM_FRAMES; i++)
+    {
+      if (!dirty_frames.test(i))
+        continue;
+
+      entry.frame_index = i;
+      std::memcpy(entry.data, &data[i * FRAME_SIZE], FRAME_SIZE);
+      journal_ok = (std::fwrite(&entry, sizeof(entry), 1, fp.get()) == 1);
+    }
+
+    journal_ok = journal_ok && (std::fwrite(&commit_magic, sizeof(commit_magic), 1, fp.get()) == 1) &&
+                 (std::fflush(fp.get()) == 0);
+    if (!journal_ok)
+    {
+      Log_ErrorFmt("Failed to write journal '{}'.", journal_filename);
+      fp.reset();
+      FileSystem::DeleteFile(journal_filename.c_str());
+      return SaveToFile(data, filename);
+    }
+  }
+
+  // Patch the changed sectors into the image. If this fails part-way, the journal stays behind
+  // and the next load finishes the job.
+  auto fp = FileSystem::OpenManagedCFile(filename, "r+b");
+  if (!fp)
+  {
+    Log_ErrorFmt("Failed to open '{}' for updating.", filename);
+    return false;
+  }
+
+  for (u32 i = 0; i < NUM_FRAMES; i++)
+  {
+    if (!dirty_frames.test(i))
+      continue;
+
+    if (FileSystem::FSeek64(fp.get(), static_cast<s64>(i) * FRAME_SIZE, SEEK_SET) != 0 ||
+        std::fwrite(&data[i * FRAME_SIZE], FRAME_SIZE, 1, fp.get()) != 1)
+    {
+      Log_ErrorFmt("Failed to write sector {} to '{}'.", i, filename);
+      return false;
+    }
+  }
+
+  if (std::fflush(fp.get()) != 0)
+  {
+    Log_ErrorFmt("Failed to flush '{}'.", filename);
+    return false;
+  }
+
+  fp.reset();
+  FileSystem::DeleteFile(journal_filename.c_str());
+
+  Log_VerboseFmt("Flushed {} changed sectors to '{}'.", num_dirty, filename);
+  return true;
+}
+
 bool MemoryCardImage::SaveToFile(const DataArray& data, const char* filename)
 {
   std::unique_ptr<ByteStream> stream =
@@ -5,6 +5,7 @@
 #include "common/bitfield.h"
 #include "controller.h"
 #include <array>
+#include <bitset>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -24,10 +25,16 @@ enum : u32
 };
 
 using DataArray = std::array<u8, DATA_SIZE>;
+using FrameBitset = std::bitset<NUM_FRAMES>;
 
 bool LoadFromFile(DataArray* data, const char* filename);
 bool SaveToFile(const DataArray& data, const char* filename);
 
+/// Writes only the given frames to an existing image, journaling them first so that an interrupted
+/// update can be replayed by the next LoadFromFile(). Falls back to a full rewrite when the image
+/// cannot be patched in place (missing, non-raw, or mostly dirty).
+bool SaveUpdatedFrames(const DataArray& data, const FrameBitset& dirty_frames, const char* filename);
+
 void Format(DataArray* data);
 
 struct IconFrame
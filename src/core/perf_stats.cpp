@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "perf_stats.h"
+
+#include "common/bitutils.h"
+#include "common/file_system.h"
+#include "common/log.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+
+Log_SetChannel(PerfStats);
+
+namespace PerfStats {
+
+// HDR-style log-linear bucketing over values stored in 1/1000ths of the metric's unit
+// (microseconds for the time metrics). Values below SUB_BUCKET_COUNT are recorded exactly; above
+// that, each power of two is split into SUB_BUCKET_COUNT linear sub-buckets, bounding the relative
+// error at 1/SUB_BUCKET_COUNT. 184 buckets span everything up to a ~29 second ceiling.
+static constexpr u32 SUB_BUCKET_SHIFT = 3;
+static constexpr u32 SUB_BUCKET_COUNT = 1u << SUB_BUCKET_SHIFT;
+static constexpr u32 NUM_BUCKETS = 184;
+static constexpr float VALUE_SCALE = 1000.0f;
+
+struct Histogram
+{
+  std::array<std::atomic<u32>, NUM_BUCKETS> buckets;
+};
+
+struct StallCounter
+{
+  std::atomic<u32> count;
+  std::atomic<u64> ticks;
+};
+
+static u32 GetBucketForValue(u32 value);
+static u32 GetBucketLowerBound(u32 bucket);
+
+static std::array<Histogram, static_cast<size_t>(Metric::MaxCount)> s_histograms;
+static std::array<StallCounter, static_cast<size_t>(StallSource::MaxCount)> s_stalls;
+
+} // namespace PerfStats
+
+const char* PerfStats::GetMetricName(Metric metric)
+{
+  static constexpr std::array<const char*, static_cast<size_t>(Metric::MaxCount)> names = {
+    {"FrameTime", "EmuSlice", "Present", "AudioFill"}};
+  return names[static_cast<size_t>(metric)];
+}
+
+const char* PerfStats::GetStallSourceName(StallSource source)
+{
+  static constexpr std::array<const char*, static_cast<size_t>(StallSource::MaxCount)> names = {
+    {"BlockCompile", "ShaderCompile", "SaveState", "VRAMReadback"}};
+  return names[static_cast<size_t>(source)];
+}
+
+u32 PerfStats::GetBucketForValue(u32 value)
+{
+  if (value < SUB_BUCKET_COUNT)
+    return value;
+
+  const u32 log2v = 31 - CountLeadingZeros(value);
+  const u32 sub_bucket = (value >> (log2v - SUB_BUCKET_SHIFT)) & (SUB_BUCKET_COUNT - 1);
+  return std::min(((log2v - SUB_BUCKET_SHIFT + 1) << SUB_BUCKET_SHIFT) + sub_bucket, NUM_BUCKETS - 1);
+}
+
+u32 PerfStats::GetBucketLowerBound(u32 bucket)
+{
+  if (bucket < SUB_BUCKET_COUNT)
+    return bucket;
+
+  const u32 log2v = (bucket >> SUB_BUCKET_SHIFT) + SUB_BUCKET_SHIFT - 1;
+  const u32 sub_bucket = bucket & (SUB_BUCKET_COUNT - 1);
+  return (1u << log2v) | (sub_bucket << (log2v - SUB_BUCKET_SHIFT));
+}
+
+void PerfStats::AddSample(Metric metric, float value)
+{
+  const u32 scaled = static_cast<u32>(std::clamp(value * VALUE_SCALE, 0.0f, 4.0e9f));
+  s_histograms[static_cast<size_t>(metric)].buckets[GetBucketForValue(scaled)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerfStats::AddStall(StallSource source, Common::Timer::Value start_time)
+{
+  StallCounter& counter = s_stalls[static_cast<size_t>(source)];
+  counter.count.fetch_add(1, std::memory_order_relaxed);
+  counter.ticks.fetch_add(Common::Timer::GetCurrentValue() - start_time, std::memory_order_relaxed);
+}
+
+u32 PerfStats::GetSampleCount(Metric metric)
+{
+  const Histogram& hist = s_histograms[static_cast<size_t>(metric)];
+  u32 total = 0;
+  for (const std::atomic<u32>& bucket : hist.buckets)
+    total += bucket.load(std::memory_order_relaxed);
+  return total;
+}
+
+float PerfStats::GetPercentile(Metric metric, float percentile)
+{
+  const Histogram& hist = s_histograms[static_cast<size_t>(metric)];
+
+  // Samples recorded while we walk simply shift the rank by a frame or two; this is a monitoring
+  // facility, so that's an acceptable trade for keeping the recording path lock-free.
+  std::array<u32, NUM_BUCKETS> counts;
+  u64 total = 0;
+  for (u32 i = 0; i < NUM_BUCKETS; i++)
+  {
+    counts[i] = hist.buckets[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0)
+    return 0.0f;
+
+  const u64 rank = std::max<u64>(
+    1, static_cast<u64>(std::ceil(static_cast<double>(total) * static_cast<double>(percentile) / 100.0)));
+  u64 cumulative = 0;
+  u32 bucket = 0;
+  for (; bucket < NUM_BUCKETS; bucket++)
+  {
+    cumulative += counts[bucket];
+    if (cumulative >= rank)
+      break;
+  }
+
+  // Report the upper edge of the bucket, so the returned value is an "at most" bound.
+  return static_cast<float>(GetBucketLowerBound(std::min(bucket + 1, NUM_BUCKETS - 1))) / VALUE_SCALE;
+}
+
+u32 PerfStats::GetStallCount(StallSource source)
+{
+  return s_stalls[static_cast<size_t>(source)].count.load(std::memory_order_relaxed);
+}
+
+float PerfStats::GetStallTimeMS(StallSource source)
+{
+  return static_cast<float>(
+    Common::Timer::ConvertValueToMilliseconds(s_stalls[static_cast<size_t>(source)].ticks.load(std::memory_order_relaxed)));
+}
+
+void PerfStats::Reset()
+{
+  for (Histogram& hist : s_histograms)
+  {
+    for (std::atomic<u32>& bucket : hist.buckets)
+      bucket.store(0, std::memory_order_relaxed);
+  }
+  for (StallCounter& counter : s_stalls)
+  {
+    counter.count.store(0, std::memory_order_relaxed);
+    counter.ticks.store(0, std::memory_order_relaxed);
+  }
+}
+
+bool PerfStats::DumpToFile(const char* path)
+{
+  auto fp = FileSystem::OpenManagedCFile(path, "wb");
+  if (!fp)
+  {
+    Log_ErrorPrintf("Failed to open '%s' for statistics dump.", path);
+    return false;
+  }
+
+  std::fputs("{\"metrics\":[", fp.get());
+  for (u32 i = 0; i < static_cast<u32>(Metric::MaxCount); i++)
+  {
+    const Metric metric = static_cast<Metric>(i);
+    std::fprintf(fp.get(), "%s{\"name\":\"%s\",\"count\":%u,\"p50\":%f,\"p95\":%f,\"p99\":%f,\"p99_9\":%f,\"buckets\":[",
+                 (i > 0) ? "," : "", GetMetricName(metric), GetSampleCount(metric), GetPercentile(metric, 50.0f),
+                 GetPercentile(metric, 95.0f), GetPercentile(metric, 99.0f), GetPercentile(metric, 99.9f));
+
+    // Buckets are dumped as [upper_edge, count] pairs, empty buckets omitted.
+    bool first = true;
+    for (u32 bucket = 0; bucket < NUM_BUCKETS; bucket++)
+    {
+      const u32 count = s_histograms[i].buckets[bucket].load(std::memory_order_relaxed);
+      if (count == 0)
+        continue;
+
+      std::fprintf(fp.get(), "%s[%f,%u]", first ? "" : ",",
+                   static_cast<float>(GetBucketLowerBound(std::min(bucket + 1, NUM_BUCKETS - 1))) / VALUE_SCALE, count);
+      first = false;
+    }
+
+    std::fputs("]}", fp.get());
+  }
+
+  std::fputs("],\"stalls\":[", fp.get());
+  for (u32 i = 0; i < static_cast<u32>(StallSource::MaxCount); i++)
+  {
+    const StallSource source = static_cast<StallSource>(i);
+    std::fprintf(fp.get(), "%s{\"name\":\"%s\",\"count\":%u,\"total_ms\":%f}", (i > 0) ? "," : "",
+                 GetStallSourceName(source), GetStallCount(source), GetStallTimeMS(source));
+  }
+  std::fputs("]}", fp.get());
+
+  return (std::fflush(fp.get()) == 0 && std::ferror(fp.get()) == 0);
+}
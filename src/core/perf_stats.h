@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+#include "types.h"
+
+#include "common/timer.h"
+
+//////////////////////////////////////////////////////////////////////////
+// Always-on histograms for frame pacing metrics, plus attribution
+// counters for the known one-off stall sources. The averages kept by the
+// performance counters smooth exactly the spikes that cause visible
+// hitches; the histograms make tail percentiles (p99/p99.9) queryable at
+// any time, at the cost of one relaxed increment per sample.
+//////////////////////////////////////////////////////////////////////////
+
+namespace PerfStats {
+
+enum class Metric : u8
+{
+  FrameTime, // start-of-frame to start-of-frame, in milliseconds
+  EmuSlice,  // emulation work within the frame, excluding present/throttle, in milliseconds
+  Present,   // time spent in PresentDisplay(), in milliseconds
+  AudioFill, // output stream fill level when the frame completed, in percent
+  MaxCount
+};
+
+enum class StallSource : u8
+{
+  BlockCompile,  // recompiling code blocks on the CPU thread
+  ShaderCompile, // (re)compiling the hardware renderer pipelines
+  SaveState,     // serializing system state, including rewind/runahead saves
+  VRAMReadback,  // synchronous VRAM downloads in the hardware renderer
+  MaxCount
+};
+
+/// Records one sample into the metric's histogram. Thread-safe and always active.
+void AddSample(Metric metric, float value);
+
+/// Attributes the time between start_time and now to the given stall source.
+void AddStall(StallSource source, Common::Timer::Value start_time);
+
+/// Returns the sample value at the given percentile (0-100), in the metric's unit. The value is
+/// the upper edge of the bucket the percentile falls in, i.e. slightly conservative. Returns zero
+/// when no samples have been recorded.
+float GetPercentile(Metric metric, float percentile);
+
+/// Returns the number of samples recorded for the metric.
+u32 GetSampleCount(Metric metric);
+
+/// Returns the number of stalls attributed to the source, and their accumulated duration.
+u32 GetStallCount(StallSource source);
+float GetStallTimeMS(StallSource source);
+
+/// Clears all histograms and counters. Called when a system boots.
+void Reset();
+
+/// Writes the histograms, percentiles and stall counters to the given file as JSON.
+bool DumpToFile(const char* path);
+
+const char* GetMetricName(Metric metric);
+const char* GetStallSourceName(StallSource source);
+
+/// Times a region and attributes it to a stall source on scope exit.
+class StallScope
+{
+public:
+  ALWAYS_INLINE StallScope(StallSource source) : m_source(source), m_start(Common::Timer::GetCurrentValue()) {}
+  ALWAYS_INLINE ~StallScope() { AddStall(m_source, m_start); }
+
+private:
+  StallSource m_source;
+  Common::Timer::Value m_start;
+};
+
+} // namespace PerfStats
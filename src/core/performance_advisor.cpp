@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "performance_advisor.h"
+#include "IconsFontAwesome5.h"
+#include "host.h"
+#include "settings.h"
+#include "system.h"
+
+#include "util/gpu_device.h"
+#include "util/imgui_manager.h"
+#include "util/ini_settings_interface.h"
+
+#include "common/log.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <array>
+
+Log_SetChannel(PerformanceAdvisor);
+
+namespace PerformanceAdvisor {
+
+static constexpr char CONFIG_SECTION[] = "PerformanceAdvisor";
+
+// ~10 seconds of full-speed gameplay before a session contributes statistics.
+static constexpr u32 MIN_SESSION_SAMPLES = 10;
+
+// An interval counts as slow below this emulation speed, and a thread/GPU counts as the
+// bottleneck when its utilization is above the busy threshold during a slow interval.
+static constexpr float SLOW_SPEED_THRESHOLD = 95.0f;
+static constexpr float BUSY_USAGE_THRESHOLD = 85.0f;
+
+// Fraction of slow intervals, over the recorded history, before anything is suggested/applied.
+static constexpr float SLOW_FRACTION_FOR_ACTION = 0.25f;
+
+static const char* GetBottleneckName(Bottleneck bottleneck);
+static Bottleneck GetBottleneckForCounts(u32 slow_samples, const std::array<u32, 3>& bound_samples);
+
+static u32 s_sample_count = 0;
+static u32 s_slow_samples = 0;
+static std::array<u32, 3> s_bound_samples = {}; // CPU, GPU, IO
+static float s_peak_frame_time = 0.0f;
+
+} // namespace PerformanceAdvisor
+
+const char* PerformanceAdvisor::GetBottleneckName(Bottleneck bottleneck)
+{
+  static constexpr std::array<const char*, static_cast<size_t>(Bottleneck::MaxCount)> names = {
+    {"None", "CPU", "GPU", "IO"}};
+  return names[static_cast<size_t>(bottleneck)];
+}
+
+PerformanceAdvisor::Bottleneck PerformanceAdvisor::GetBottleneckForCounts(u32 slow_samples,
+                                                                          const std::array<u32, 3>& bound_samples)
+{
+  const u32 max_count = std::max(bound_samples[0], std::max(bound_samples[1], bound_samples[2]));
+  if (max_count == 0 || slow_samples == 0)
+    return Bottleneck::None;
+  else if (max_count == bound_samples[1])
+    return Bottleneck::GPU;
+  else if (max_count == bound_samples[0])
+    return Bottleneck::CPU;
+  else
+    return Bottleneck::IO;
+}
+
+void PerformanceAdvisor::OnGameChanged()
+{
+  s_sample_count = 0;
+  s_slow_samples = 0;
+  s_bound_samples = {};
+  s_peak_frame_time = 0.0f;
+
+  if (!g_settings.perf_advisor_enable || !g_settings.apply_game_settings || System::GetGameSerial().empty())
+    return;
+
+  INISettingsInterface ini(System::GetGameSettingsPath(System::GetGameSerial()));
+  if (!ini.Load())
+    return;
+
+  const std::string bottleneck_name = ini.GetStringValue(CONFIG_SECTION, "Bottleneck", "None");
+  if (bottleneck_name == GetBottleneckName(Bottleneck::None))
+    return;
+
+  if (ini.GetBoolValue(CONFIG_SECTION, "AutoApplied", false))
+  {
+    Host::AddIconOSDMessage(
+      "PerformanceAdvisor", ICON_FA_TACHOMETER_ALT,
+      TRANSLATE_STR("OSDMessage", "Performance advisor has applied known-good settings for this game."),
+      Host::OSD_INFO_DURATION);
+    return;
+  }
+
+  std::string suggestion;
+  if (bottleneck_name == GetBottleneckName(Bottleneck::GPU))
+  {
+    suggestion = TRANSLATE_STR("OSDMessage", "Previous sessions were GPU-bound. Consider lowering the resolution "
+                                             "scale or enabling dynamic resolution scaling.");
+  }
+  else if (bottleneck_name == GetBottleneckName(Bottleneck::CPU))
+  {
+    suggestion = TRANSLATE_STR("OSDMessage", "Previous sessions were CPU-bound. Consider disabling PGXP or using "
+                                             "the recompiler execution mode.");
+  }
+  else
+  {
+    suggestion = TRANSLATE_STR("OSDMessage", "Previous sessions were I/O-bound. Consider increasing CD-ROM "
+                                             "readahead or preloading the image to RAM.");
+  }
+
+  Host::AddIconOSDMessage("PerformanceAdvisor", ICON_FA_TACHOMETER_ALT, std::move(suggestion),
+                          Host::OSD_WARNING_DURATION);
+}
+
+void PerformanceAdvisor::AddSample()
+{
+  if (!g_settings.perf_advisor_enable)
+    return;
+
+  // Intervals at non-standard speeds say nothing about whether the title holds full speed.
+  if (System::GetTargetSpeed() != 1.0f)
+    return;
+
+  s_sample_count++;
+  s_peak_frame_time = std::max(s_peak_frame_time, System::GetMaximumFrameTime());
+
+  if (System::GetEmulationSpeed() >= SLOW_SPEED_THRESHOLD)
+    return;
+
+  s_slow_samples++;
+
+  // GPU usage is only populated when GPU timing is active; a busy render thread still shows up
+  // as neither, which lands in the I/O/sync bucket together with readahead misses.
+  const float cpu_usage = System::GetCPUThreadUsage();
+  const float gpu_usage = g_gpu_device->IsGPUTimingEnabled() ? System::GetGPUUsage() : 0.0f;
+  if (gpu_usage >= BUSY_USAGE_THRESHOLD)
+    s_bound_samples[1]++;
+  else if (cpu_usage >= BUSY_USAGE_THRESHOLD)
+    s_bound_samples[0]++;
+  else
+    s_bound_samples[2]++;
+}
+
+void PerformanceAdvisor::OnSystemShutdown()
+{
+  if (!g_settings.perf_advisor_enable || !g_settings.apply_game_settings || System::GetGameSerial().empty() ||
+      s_sample_count < MIN_SESSION_SAMPLES)
+  {
+    return;
+  }
+
+  INISettingsInterface ini(System::GetGameSettingsPath(System::GetGameSerial()));
+  ini.Load();
+
+  // Merge this session into the recorded history, so the classification stabilizes over many
+  // short sessions instead of flapping with whatever the user last played.
+  const u32 sample_count = static_cast<u32>(ini.GetIntValue(CONFIG_SECTION, "SampleCount", 0)) + s_sample_count;
+  const u32 slow_samples = static_cast<u32>(ini.GetIntValue(CONFIG_SECTION, "SlowSamples", 0)) + s_slow_samples;
+  const std::array<u32, 3> bound_samples = {
+    {static_cast<u32>(ini.GetIntValue(CONFIG_SECTION, "CPUBoundSamples", 0)) + s_bound_samples[0],
+     static_cast<u32>(ini.GetIntValue(CONFIG_SECTION, "GPUBoundSamples", 0)) + s_bound_samples[1],
+     static_cast<u32>(ini.GetIntValue(CONFIG_SECTION, "IOBoundSamples", 0)) + s_bound_samples[2]}};
+  const float peak_frame_time =
+    std::max(ini.GetFloatValue(CONFIG_SECTION, "PeakFrameTime", 0.0f), s_peak_frame_time);
+
+  const float slow_fraction = static_cast<float>(slow_samples) / static_cast<float>(sample_count);
+  const Bottleneck bottleneck = (slow_fraction >= SLOW_FRACTION_FOR_ACTION) ?
+                                  GetBottleneckForCounts(slow_samples, bound_samples) :
+                                  Bottleneck::None;
+
+  ini.SetIntValue(CONFIG_SECTION, "SampleCount", static_cast<s32>(sample_count));
+  ini.SetIntValue(CONFIG_SECTION, "SlowSamples", static_cast<s32>(slow_samples));
+  ini.SetIntValue(CONFIG_SECTION, "CPUBoundSamples", static_cast<s32>(bound_samples[0]));
+  ini.SetIntValue(CONFIG_SECTION, "GPUBoundSamples", static_cast<s32>(bound_samples[1]));
+  ini.SetIntValue(CONFIG_SECTION, "IOBoundSamples", static_cast<s32>(bound_samples[2]));
+  ini.SetFloatValue(CONFIG_SECTION, "PeakFrameTime", peak_frame_time);
+  ini.SetStringValue(CONFIG_SECTION, "Bottleneck", GetBottleneckName(bottleneck));
+
+  if (g_settings.perf_advisor_auto_apply && !ini.GetBoolValue(CONFIG_SECTION, "AutoApplied", false))
+  {
+    // Only apply remedies that trade nothing the user chose explicitly: dynamic resolution keeps
+    // the configured scale as the ceiling, and readahead only costs memory. CPU-bound titles stay
+    // suggestion-only, since the effective fixes (PGXP, execution mode) change accuracy.
+    if (bottleneck == Bottleneck::GPU)
+    {
+      ini.SetBoolValue("GPU", "DynamicResolutionScale", true);
+      ini.SetBoolValue(CONFIG_SECTION, "AutoApplied", true);
+      Log_InfoFmt("Enabled dynamic resolution scaling for '{}'.", System::GetGameSerial());
+    }
+    else if (bottleneck == Bottleneck::IO && g_settings.cdrom_readahead_sectors < 16)
+    {
+      ini.SetIntValue("CDROM", "ReadaheadSectors", 16);
+      ini.SetBoolValue(CONFIG_SECTION, "AutoApplied", true);
+      Log_InfoFmt("Increased CD-ROM readahead for '{}'.", System::GetGameSerial());
+    }
+  }
+
+  if (!ini.Save())
+    Log_ErrorFmt("Failed to save performance statistics for '{}'.", System::GetGameSerial());
+  else
+    Log_DevFmt("Recorded {} samples ({} slow, {}) for '{}'.", s_sample_count, s_slow_samples,
+               GetBottleneckName(bottleneck), System::GetGameSerial());
+}
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+#include "types.h"
+
+//////////////////////////////////////////////////////////////////////////
+// Records per-title frame time and bottleneck statistics from the
+// existing performance counters, persists them to the game settings
+// layer, and either suggests or auto-applies known-good settings for
+// titles which consistently fail to hold full speed.
+//////////////////////////////////////////////////////////////////////////
+
+namespace PerformanceAdvisor {
+
+enum class Bottleneck : u8
+{
+  None,
+  CPU,
+  GPU,
+  IO,
+  MaxCount
+};
+
+/// Resets the accumulated statistics and surfaces any suggestion recorded by previous sessions.
+/// Called whenever the running game changes, including at boot.
+void OnGameChanged();
+
+/// Classifies the session and persists the statistics to the per-serial game settings file,
+/// applying known-good settings when auto-apply is enabled. Called on system shutdown.
+void OnSystemShutdown();
+
+/// Accumulates one performance counter interval. Called from UpdatePerformanceCounters().
+void AddSample();
+
+} // namespace PerformanceAdvisor
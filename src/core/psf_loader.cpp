@@ -4,6 +4,7 @@
 #include "psf_loader.h"
 #include "bios.h"
 #include "common/assert.h"
+#include "common/byte_stream.h"
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/path.h"
@@ -63,16 +64,36 @@ float File::GetTagFloat(const char* tag_name, float default_value) const
 
 bool File::Load(const char* path)
 {
-  std::optional<std::vector<u8>> file_data(FileSystem::ReadBinaryFile(path));
-  if (!file_data.has_value() || file_data->empty())
+  // Parse in-place out of a memory-mapped view where possible; PSF libraries pull in a chain of
+  // these files, and nothing here needs a mutable copy.
+  std::optional<std::vector<u8>> file_data;
+  const u8* file_pointer;
+  u32 file_size;
+  const std::unique_ptr<MemoryMappedFileByteStream> stream = ByteStream::OpenMemoryMappedFile(path);
+  if (stream)
   {
-    Log_ErrorPrintf("Failed to open/read PSF file '%s'", path);
-    return false;
+    file_pointer = stream->GetMemoryPointer();
+    file_size = static_cast<u32>(stream->GetMemorySize());
+  }
+  else
+  {
+    file_data = FileSystem::ReadBinaryFile(path);
+    if (!file_data.has_value() || file_data->empty())
+    {
+      Log_ErrorPrintf("Failed to open/read PSF file '%s'", path);
+      return false;
+    }
+
+    file_pointer = file_data->data();
+    file_size = static_cast<u32>(file_data->size());
   }
 
-  const u8* file_pointer = file_data->data();
-  const u8* file_pointer_end = file_data->data() + file_data->size();
-  const u32 file_size = static_cast<u32>(file_data->size());
+  const u8* file_pointer_end = file_pointer + file_size;
+  if (file_size < sizeof(PSFHeader))
+  {
+    Log_ErrorPrintf("PSF file '%s' is too small (%u bytes)", path, file_size);
+    return false;
+  }
 
   PSFHeader header;
   std::memcpy(&header, file_pointer, sizeof(header));
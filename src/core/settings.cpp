@@ -151,6 +151,8 @@ void Settings::Load(SettingsInterface& si)
   load_devices_from_save_states = si.GetBoolValue("Main", "LoadDevicesFromSaveStates", false);
   apply_compatibility_settings = si.GetBoolValue("Main", "ApplyCompatibilitySettings", true);
   apply_game_settings = si.GetBoolValue("Main", "ApplyGameSettings", true);
+  perf_advisor_enable = si.GetBoolValue("PerformanceAdvisor", "Enabled", false);
+  perf_advisor_auto_apply = si.GetBoolValue("PerformanceAdvisor", "AutoApply", false);
   enable_cheats = si.GetBoolValue("Console", "EnableCheats", false);
   disable_all_enhancements = si.GetBoolValue("Main", "DisableAllEnhancements", false);
   enable_discord_presence = si.GetBoolValue("Main", "EnableDiscordPresence", false);
@@ -158,6 +160,7 @@ void Settings::Load(SettingsInterface& si)
   rewind_save_frequency = si.GetFloatValue("Main", "RewindFrequency", 10.0f);
   rewind_save_slots = static_cast<u32>(si.GetIntValue("Main", "RewindSaveSlots", 10));
   runahead_frames = static_cast<u32>(si.GetIntValue("Main", "RunaheadFrameCount", 0));
+  memory_budget_mb = si.GetUIntValue("Main", "MemoryBudgetMB", 0u);
 
   cpu_execution_mode =
     ParseCPUExecutionMode(
@@ -170,6 +173,11 @@ void Settings::Load(SettingsInterface& si)
   cpu_recompiler_memory_exceptions = si.GetBoolValue("CPU", "RecompilerMemoryExceptions", false);
   cpu_recompiler_block_linking = si.GetBoolValue("CPU", "RecompilerBlockLinking", true);
   cpu_recompiler_icache = si.GetBoolValue("CPU", "RecompilerICache", false);
+  cpu_persistent_block_cache = si.GetBoolValue("CPU", "PersistentBlockCache", false);
+  cpu_async_block_compile = si.GetBoolValue("CPU", "AsyncBlockCompile", false);
+  cpu_tiered_execution = si.GetBoolValue("CPU", "TieredExecution", false);
+  cpu_idle_loop_skip = si.GetBoolValue("CPU", "IdleLoopSkip", false);
+  cpu_trace_formation = si.GetBoolValue("CPU", "TraceFormation", false);
   cpu_fastmem_mode = ParseCPUFastmemMode(
                        si.GetStringValue("CPU", "FastmemMode", GetCPUFastmemModeName(DEFAULT_CPU_FASTMEM_MODE)).c_str())
                        .value_or(DEFAULT_CPU_FASTMEM_MODE);
@@ -178,6 +186,8 @@ void Settings::Load(SettingsInterface& si)
                    .value_or(DEFAULT_GPU_RENDERER);
   gpu_adapter = si.GetStringValue("GPU", "Adapter", "");
   gpu_resolution_scale = static_cast<u8>(si.GetIntValue("GPU", "ResolutionScale", 1));
+  gpu_dynamic_resolution_scale = si.GetBoolValue("GPU", "DynamicResolutionScale", false);
+  gpu_dynamic_resolution_min_scale = static_cast<u8>(si.GetIntValue("GPU", "DynamicResolutionMinScale", 1));
   gpu_multisamples = static_cast<u8>(si.GetIntValue("GPU", "Multisamples", 1));
   gpu_use_debug_device = si.GetBoolValue("GPU", "UseDebugDevice", false);
   gpu_disable_shader_cache = si.GetBoolValue("GPU", "DisableShaderCache", false);
@@ -187,6 +197,7 @@ void Settings::Load(SettingsInterface& si)
   gpu_disable_texture_copy_to_self = si.GetBoolValue("GPU", "DisableTextureCopyToSelf", false);
   gpu_per_sample_shading = si.GetBoolValue("GPU", "PerSampleShading", false);
   gpu_use_thread = si.GetBoolValue("GPU", "UseThread", true);
+  gpu_sw_thread_count = static_cast<u8>(si.GetIntValue("GPU", "SWThreadCount", 0));
   gpu_use_software_renderer_for_readbacks = si.GetBoolValue("GPU", "UseSoftwareRendererForReadbacks", false);
   gpu_threaded_presentation = si.GetBoolValue("GPU", "ThreadedPresentation", true);
   gpu_true_color = si.GetBoolValue("GPU", "TrueColor", true);
@@ -282,18 +293,24 @@ void Settings::Load(SettingsInterface& si)
   display_show_inputs = si.GetBoolValue("Display", "ShowInputs", false);
   display_show_enhancements = si.GetBoolValue("Display", "ShowEnhancements", false);
   display_all_frames = si.GetBoolValue("Display", "DisplayAllFrames", false);
+  display_skip_rendering_when_unthrottled = si.GetBoolValue("Display", "SkipRenderingWhenUnthrottled", false);
   display_stretch_vertically = si.GetBoolValue("Display", "StretchVertically", false);
   display_max_fps = si.GetFloatValue("Display", "MaxFPS", DEFAULT_DISPLAY_MAX_FPS);
+  display_max_queued_frames = static_cast<u8>(
+    std::clamp<u32>(si.GetUIntValue("Display", "MaxQueuedFrames", DEFAULT_DISPLAY_MAX_QUEUED_FRAMES), 1, 16));
   display_osd_scale = si.GetFloatValue("Display", "OSDScale", DEFAULT_OSD_SCALE);
 
   cdrom_readahead_sectors =
     static_cast<u8>(si.GetIntValue("CDROM", "ReadaheadSectors", DEFAULT_CDROM_READAHEAD_SECTORS));
+  cdrom_chd_hunk_cache_size_mb =
+    si.GetUIntValue("CDROM", "CHDHunkCacheSizeMB", DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE_MB);
   cdrom_mechacon_version =
     ParseCDROMMechVersionName(
       si.GetStringValue("CDROM", "MechaconVersion", GetCDROMMechVersionName(DEFAULT_CDROM_MECHACON_VERSION)).c_str())
       .value_or(DEFAULT_CDROM_MECHACON_VERSION);
   cdrom_region_check = si.GetBoolValue("CDROM", "RegionCheck", false);
   cdrom_load_image_to_ram = si.GetBoolValue("CDROM", "LoadImageToRAM", false);
+  cdrom_precache_compression = si.GetBoolValue("CDROM", "PrecacheCompression", false);
   cdrom_load_image_patches = si.GetBoolValue("CDROM", "LoadImagePatches", false);
   cdrom_mute_cd_audio = si.GetBoolValue("CDROM", "MuteCDAudio", false);
   cdrom_read_speedup = si.GetIntValue("CDROM", "ReadSpeedup", 1);
@@ -317,6 +334,7 @@ void Settings::Load(SettingsInterface& si)
   audio_dump_on_boot = si.GetBoolValue("Audio", "DumpOnBoot", false);
 
   use_old_mdec_routines = si.GetBoolValue("Hacks", "UseOldMDECRoutines", false);
+  mdec_async_decode = si.GetBoolValue("MDEC", "AsyncDecode", false);
   pcdrv_enable = si.GetBoolValue("PCDrv", "Enabled", false);
   pcdrv_enable_writes = si.GetBoolValue("PCDrv", "EnableWrites", false);
   pcdrv_root = si.GetStringValue("PCDrv", "Root");
@@ -388,6 +406,7 @@ void Settings::Load(SettingsInterface& si)
                 .value_or(DEFAULT_LOG_LEVEL);
   log_filter = si.GetStringValue("Logging", "LogFilter", "");
   log_timestamps = si.GetBoolValue("Logging", "LogTimestamps", true);
+  log_async = si.GetBoolValue("Logging", "LogAsync", false);
   log_to_console = si.GetBoolValue("Logging", "LogToConsole", DEFAULT_LOG_TO_CONSOLE);
   log_to_debug = si.GetBoolValue("Logging", "LogToDebug", false);
   log_to_window = si.GetBoolValue("Logging", "LogToWindow", false);
@@ -398,6 +417,7 @@ void Settings::Load(SettingsInterface& si)
   debugging.dump_vram_to_cpu_copies = si.GetBoolValue("Debug", "DumpVRAMToCPUCopies");
   debugging.enable_gdb_server = si.GetBoolValue("Debug", "EnableGDBServer");
   debugging.gdb_server_port = static_cast<u16>(si.GetIntValue("Debug", "GDBServerPort"));
+  debugging.export_frames = si.GetBoolValue("Debug", "ExportFrames");
   debugging.show_gpu_state = si.GetBoolValue("Debug", "ShowGPUState");
   debugging.show_cdrom_state = si.GetBoolValue("Debug", "ShowCDROMState");
   debugging.show_spu_state = si.GetBoolValue("Debug", "ShowSPUState");
@@ -408,6 +428,8 @@ void Settings::Load(SettingsInterface& si)
   texture_replacements.enable_vram_write_replacements =
     si.GetBoolValue("TextureReplacements", "EnableVRAMWriteReplacements", false);
   texture_replacements.preload_textures = si.GetBoolValue("TextureReplacements", "PreloadTextures", false);
+  texture_replacements.replacement_cache_size_mb =
+    si.GetIntValue("TextureReplacements", "ReplacementCacheSizeMB", 512);
   texture_replacements.dump_vram_writes = si.GetBoolValue("TextureReplacements", "DumpVRAMWrites", false);
   texture_replacements.dump_vram_write_force_alpha_channel =
     si.GetBoolValue("TextureReplacements", "DumpVRAMWriteForceAlphaChannel", true);
@@ -444,6 +466,8 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("Main", "LoadDevicesFromSaveStates", load_devices_from_save_states);
   si.SetBoolValue("Main", "ApplyCompatibilitySettings", apply_compatibility_settings);
   si.SetBoolValue("Main", "ApplyGameSettings", apply_game_settings);
+  si.SetBoolValue("PerformanceAdvisor", "Enabled", perf_advisor_enable);
+  si.SetBoolValue("PerformanceAdvisor", "AutoApply", perf_advisor_auto_apply);
   si.SetBoolValue("Console", "EnableCheats", enable_cheats);
   si.SetBoolValue("Main", "DisableAllEnhancements", disable_all_enhancements);
   si.SetBoolValue("Main", "EnableDiscordPresence", enable_discord_presence);
@@ -451,6 +475,7 @@ void Settings::Save(SettingsInterface& si) const
   si.SetFloatValue("Main", "RewindFrequency", rewind_save_frequency);
   si.SetIntValue("Main", "RewindSaveSlots", rewind_save_slots);
   si.SetIntValue("Main", "RunaheadFrameCount", runahead_frames);
+  si.SetUIntValue("Main", "MemoryBudgetMB", memory_budget_mb);
 
   si.SetStringValue("CPU", "ExecutionMode", GetCPUExecutionModeName(cpu_execution_mode));
   si.SetBoolValue("CPU", "OverclockEnable", cpu_overclock_enable);
@@ -459,11 +484,18 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("CPU", "RecompilerMemoryExceptions", cpu_recompiler_memory_exceptions);
   si.SetBoolValue("CPU", "RecompilerBlockLinking", cpu_recompiler_block_linking);
   si.SetBoolValue("CPU", "RecompilerICache", cpu_recompiler_icache);
+  si.SetBoolValue("CPU", "PersistentBlockCache", cpu_persistent_block_cache);
+  si.SetBoolValue("CPU", "AsyncBlockCompile", cpu_async_block_compile);
+  si.SetBoolValue("CPU", "TieredExecution", cpu_tiered_execution);
+  si.SetBoolValue("CPU", "IdleLoopSkip", cpu_idle_loop_skip);
+  si.SetBoolValue("CPU", "TraceFormation", cpu_trace_formation);
   si.SetStringValue("CPU", "FastmemMode", GetCPUFastmemModeName(cpu_fastmem_mode));
 
   si.SetStringValue("GPU", "Renderer", GetRendererName(gpu_renderer));
   si.SetStringValue("GPU", "Adapter", gpu_adapter.c_str());
   si.SetIntValue("GPU", "ResolutionScale", static_cast<long>(gpu_resolution_scale));
+  si.SetBoolValue("GPU", "DynamicResolutionScale", gpu_dynamic_resolution_scale);
+  si.SetIntValue("GPU", "DynamicResolutionMinScale", static_cast<long>(gpu_dynamic_resolution_min_scale));
   si.SetIntValue("GPU", "Multisamples", static_cast<long>(gpu_multisamples));
   si.SetBoolValue("GPU", "UseDebugDevice", gpu_use_debug_device);
   si.SetBoolValue("GPU", "DisableShaderCache", gpu_disable_shader_cache);
@@ -473,6 +505,7 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("GPU", "DisableTextureCopyToSelf", gpu_disable_texture_copy_to_self);
   si.SetBoolValue("GPU", "PerSampleShading", gpu_per_sample_shading);
   si.SetBoolValue("GPU", "UseThread", gpu_use_thread);
+  si.SetIntValue("GPU", "SWThreadCount", gpu_sw_thread_count);
   si.SetBoolValue("GPU", "ThreadedPresentation", gpu_threaded_presentation);
   si.SetBoolValue("GPU", "UseSoftwareRendererForReadbacks", gpu_use_software_renderer_for_readbacks);
   si.SetBoolValue("GPU", "TrueColor", gpu_true_color);
@@ -527,14 +560,18 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("Display", "ShowInputs", display_show_inputs);
   si.SetBoolValue("Display", "ShowEnhancements", display_show_enhancements);
   si.SetBoolValue("Display", "DisplayAllFrames", display_all_frames);
+  si.SetBoolValue("Display", "SkipRenderingWhenUnthrottled", display_skip_rendering_when_unthrottled);
   si.SetBoolValue("Display", "StretchVertically", display_stretch_vertically);
   si.SetFloatValue("Display", "MaxFPS", display_max_fps);
+  si.SetUIntValue("Display", "MaxQueuedFrames", display_max_queued_frames);
   si.SetFloatValue("Display", "OSDScale", display_osd_scale);
 
   si.SetIntValue("CDROM", "ReadaheadSectors", cdrom_readahead_sectors);
+  si.SetUIntValue("CDROM", "CHDHunkCacheSizeMB", cdrom_chd_hunk_cache_size_mb);
   si.SetStringValue("CDROM", "MechaconVersion", GetCDROMMechVersionName(cdrom_mechacon_version));
   si.SetBoolValue("CDROM", "RegionCheck", cdrom_region_check);
   si.SetBoolValue("CDROM", "LoadImageToRAM", cdrom_load_image_to_ram);
+  si.SetBoolValue("CDROM", "PrecacheCompression", cdrom_precache_compression);
   si.SetBoolValue("CDROM", "LoadImagePatches", cdrom_load_image_patches);
   si.SetBoolValue("CDROM", "MuteCDAudio", cdrom_mute_cd_audio);
   si.SetIntValue("CDROM", "ReadSpeedup", cdrom_read_speedup);
@@ -552,6 +589,7 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("Audio", "DumpOnBoot", audio_dump_on_boot);
 
   si.SetBoolValue("Hacks", "UseOldMDECRoutines", use_old_mdec_routines);
+  si.SetBoolValue("MDEC", "AsyncDecode", mdec_async_decode);
   si.SetIntValue("Hacks", "DMAMaxSliceTicks", dma_max_slice_ticks);
   si.SetIntValue("Hacks", "DMAHaltTicks", dma_halt_ticks);
   si.SetIntValue("Hacks", "GPUFIFOSize", gpu_fifo_size);
@@ -600,6 +638,7 @@ void Settings::Save(SettingsInterface& si) const
   si.SetStringValue("Logging", "LogLevel", GetLogLevelName(log_level));
   si.SetStringValue("Logging", "LogFilter", log_filter.c_str());
   si.SetBoolValue("Logging", "LogTimestamps", log_timestamps);
+  si.SetBoolValue("Logging", "LogAsync", log_async);
   si.SetBoolValue("Logging", "LogToConsole", log_to_console);
   si.SetBoolValue("Logging", "LogToDebug", log_to_debug);
   si.SetBoolValue("Logging", "LogToWindow", log_to_window);
@@ -618,6 +657,7 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("TextureReplacements", "EnableVRAMWriteReplacements",
                   texture_replacements.enable_vram_write_replacements);
   si.SetBoolValue("TextureReplacements", "PreloadTextures", texture_replacements.preload_textures);
+  si.SetIntValue("TextureReplacements", "ReplacementCacheSizeMB", texture_replacements.replacement_cache_size_mb);
   si.SetBoolValue("TextureReplacements", "DumpVRAMWrites", texture_replacements.dump_vram_writes);
   si.SetBoolValue("TextureReplacements", "DumpVRAMWriteForceAlphaChannel",
                   texture_replacements.dump_vram_write_force_alpha_channel);
@@ -763,6 +803,8 @@ void Settings::UpdateLogSettings()
   {
     Log::SetFileOutputParams(false, nullptr);
   }
+
+  Log::SetAsyncOutputEnabled(log_async);
 }
 
 void Settings::SetDefaultControllerConfig(SettingsInterface& si)
@@ -1364,12 +1406,14 @@ static constexpr const std::array s_display_sync_mode_names = {
   "Disabled",
   "VSync",
   "VSyncRelaxed",
+  "Mailbox",
   "VRR",
 };
 static constexpr const std::array s_display_sync_mode_display_names = {
   TRANSLATE_NOOP("Settings", "Disabled"),
   TRANSLATE_NOOP("Settings", "VSync"),
   TRANSLATE_NOOP("Settings", "Relaxed VSync"),
+  TRANSLATE_NOOP("Settings", "Mailbox (Tear-Free, No Wait)"),
   TRANSLATE_NOOP("Settings", "VRR/FreeSync/GSync"),
 };
 
@@ -1834,10 +1878,12 @@ bool EmuFolders::EnsureFoldersExist()
   result = FileSystem::EnsureDirectoryExists(Cache.c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Path::Combine(Cache, "achievement_badge").c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Path::Combine(Cache, "achievement_gameicon").c_str(), false) && result;
+  result = FileSystem::EnsureDirectoryExists(Path::Combine(Cache, "prewarm").c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Cheats.c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Covers.c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Dumps.c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Path::Combine(Dumps, "audio").c_str(), false) && result;
+  result = FileSystem::EnsureDirectoryExists(Path::Combine(Dumps, "gpu").c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Path::Combine(Dumps, "textures").c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(GameSettings.c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(InputProfiles.c_str(), false) && result;
@@ -69,6 +69,11 @@ struct Settings
   bool cpu_recompiler_memory_exceptions : 1 = false;
   bool cpu_recompiler_block_linking : 1 = true;
   bool cpu_recompiler_icache : 1 = false;
+  bool cpu_persistent_block_cache : 1 = false;
+  bool cpu_async_block_compile : 1 = false;
+  bool cpu_tiered_execution : 1 = false;
+  bool cpu_idle_loop_skip : 1 = false;
+  bool cpu_trace_formation : 1 = false;
   CPUFastmemMode cpu_fastmem_mode = DEFAULT_CPU_FASTMEM_MODE;
 
   float emulation_speed = 1.0f;
@@ -87,6 +92,8 @@ struct Settings
   bool load_devices_from_save_states : 1 = false;
   bool apply_compatibility_settings : 1 = true;
   bool apply_game_settings : 1 = true;
+  bool perf_advisor_enable : 1 = false;
+  bool perf_advisor_auto_apply : 1 = false;
   bool enable_cheats : 1 = true;
   bool disable_all_enhancements : 1 = false;
   bool enable_discord_presence : 1 = false;
@@ -95,11 +102,14 @@ struct Settings
   float rewind_save_frequency = 10.0f;
   u32 rewind_save_slots = 10;
   u32 runahead_frames = 0;
+  u32 memory_budget_mb = 0;
 
   GPURenderer gpu_renderer = DEFAULT_GPU_RENDERER;
   std::string gpu_adapter;
   u8 gpu_resolution_scale = 1;
+  u8 gpu_dynamic_resolution_min_scale = 1;
   u8 gpu_multisamples = 1;
+  u8 gpu_sw_thread_count = 0; // 0 = automatic, 1 = disabled
   bool gpu_use_thread : 1 = true;
   bool gpu_use_software_renderer_for_readbacks : 1 = false;
   bool gpu_threaded_presentation : 1 = true;
@@ -110,6 +120,7 @@ struct Settings
   bool gpu_disable_texture_buffers : 1 = false;
   bool gpu_disable_texture_copy_to_self : 1 = false;
   bool gpu_per_sample_shading : 1 = false;
+  bool gpu_dynamic_resolution_scale : 1 = false;
   bool gpu_true_color : 1 = true;
   bool gpu_debanding : 1 = false;
   bool gpu_scaled_dithering : 1 = true;
@@ -158,16 +169,20 @@ struct Settings
   bool display_show_inputs : 1 = false;
   bool display_show_enhancements : 1 = false;
   bool display_all_frames : 1 = false;
+  bool display_skip_rendering_when_unthrottled : 1 = false;
   bool display_stretch_vertically : 1 = false;
+  u8 display_max_queued_frames = DEFAULT_DISPLAY_MAX_QUEUED_FRAMES;
   float display_osd_scale = 100.0f;
   float display_max_fps = DEFAULT_DISPLAY_MAX_FPS;
   float gpu_pgxp_tolerance = -1.0f;
   float gpu_pgxp_depth_clear_threshold = DEFAULT_GPU_PGXP_DEPTH_THRESHOLD / GPU_PGXP_DEPTH_THRESHOLD_SCALE;
 
   u8 cdrom_readahead_sectors = DEFAULT_CDROM_READAHEAD_SECTORS;
+  u32 cdrom_chd_hunk_cache_size_mb = DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE_MB;
   CDROMMechaconVersion cdrom_mechacon_version = DEFAULT_CDROM_MECHACON_VERSION;
   bool cdrom_region_check : 1 = false;
   bool cdrom_load_image_to_ram : 1 = false;
+  bool cdrom_precache_compression : 1 = false;
   bool cdrom_load_image_patches : 1 = false;
   bool cdrom_mute_cd_audio : 1 = false;
   u32 cdrom_read_speedup = 1;
@@ -185,6 +200,7 @@ struct Settings
   bool audio_dump_on_boot : 1 = false;
 
   bool use_old_mdec_routines : 1 = false;
+  bool mdec_async_decode : 1 = false;
   bool pcdrv_enable : 1 = false;
 
   // timing hacks section
@@ -217,6 +233,8 @@ struct Settings
     bool enable_gdb_server : 1 = false;
     u16 gdb_server_port = 1234;
 
+    bool export_frames : 1 = false;
+
     // Mutable because the imgui window can close itself.
     mutable bool show_gpu_state = false;
     mutable bool show_cdrom_state = false;
@@ -231,6 +249,7 @@ struct Settings
   {
     bool enable_vram_write_replacements : 1 = false;
     bool preload_textures : 1 = false;
+    u32 replacement_cache_size_mb = 512;
 
     bool dump_vram_writes : 1 = false;
     bool dump_vram_write_force_alpha_channel : 1 = true;
@@ -264,6 +283,7 @@ struct Settings
   LOGLEVEL log_level = DEFAULT_LOG_LEVEL;
   std::string log_filter;
   bool log_timestamps : 1 = true;
+  bool log_async : 1 = false;
   bool log_to_console : 1 = DEFAULT_LOG_TO_CONSOLE;
   bool log_to_debug : 1 = false;
   bool log_to_window : 1 = false;
@@ -493,9 +513,11 @@ struct Settings
   static constexpr DisplayScreenshotMode DEFAULT_DISPLAY_SCREENSHOT_MODE = DisplayScreenshotMode::ScreenResolution;
   static constexpr DisplayScreenshotFormat DEFAULT_DISPLAY_SCREENSHOT_FORMAT = DisplayScreenshotFormat::PNG;
   static constexpr u8 DEFAULT_DISPLAY_SCREENSHOT_QUALITY = 85;
+  static constexpr u8 DEFAULT_DISPLAY_MAX_QUEUED_FRAMES = 2;
   static constexpr float DEFAULT_OSD_SCALE = 100.0f;
 
   static constexpr u8 DEFAULT_CDROM_READAHEAD_SECTORS = 8;
+  static constexpr u32 DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE_MB = 4;
   static constexpr CDROMMechaconVersion DEFAULT_CDROM_MECHACON_VERSION = CDROMMechaconVersion::VC1A;
 
   static constexpr ControllerType DEFAULT_CONTROLLER_1_TYPE = ControllerType::AnalogController;
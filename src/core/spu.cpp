@@ -17,6 +17,7 @@
 #include "common/bitfield.h"
 #include "common/bitutils.h"
 #include "common/fifo_queue.h"
+#include "common/intrin.h"
 #include "common/log.h"
 #include "common/path.h"
 
@@ -49,6 +50,7 @@ enum : u32
   VOICE_ADDRESS_SHIFT = 3,
   NUM_SAMPLES_PER_ADPCM_BLOCK = 28,
   NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK = 3,
+  NUM_ADPCM_BLOCK_CACHE_ENTRIES = 2048,
   SYSCLK_TICKS_PER_SPU_TICK = static_cast<u32>(System::MASTER_CLOCK) / static_cast<u32>(SAMPLE_RATE), // 0x300
   CAPTURE_BUFFER_SIZE_PER_CHANNEL = 0x400,
   MINIMUM_TICKS_BETWEEN_KEY_ON_OFF = 2,
@@ -273,6 +275,18 @@ struct Voice
   void TickADSR();
 };
 
+// Decoded ADPCM block, direct-mapped on the block address. The decode output depends on the two samples carried over
+// from the previous block, so those form part of the key - for a looping voice in steady state they repeat exactly.
+struct ADPCMBlockCacheEntry
+{
+  u16 address;
+  ADPCMFlags flags;
+  bool valid;
+  std::array<s16, 2> previous_samples;
+  std::array<s16, 2> next_samples;
+  std::array<s16, NUM_SAMPLES_PER_ADPCM_BLOCK> samples;
+};
+
 struct ReverbRegisters
 {
   s16 vLOUT;
@@ -330,6 +344,8 @@ static void WriteToCaptureBuffer(u32 index, s16 value);
 static void IncrementCaptureBufferPosition();
 
 static void ReadADPCMBlock(u16 address, ADPCMBlock* block);
+static void InvalidateBlockCache();
+static void InvalidateBlockCacheForRAMWrite(u32 ram_address);
 static std::tuple<s32, s32> SampleVoice(u32 voice_index);
 
 static void UpdateNoise();
@@ -405,6 +421,7 @@ static std::array<Voice, NUM_VOICES> s_voices{};
 static InlineFIFOQueue<u16, FIFO_SIZE_IN_HALFWORDS> s_transfer_fifo;
 
 static std::array<u8, RAM_SIZE> s_ram{};
+static std::array<ADPCMBlockCacheEntry, NUM_ADPCM_BLOCK_CACHE_ENTRIES> s_block_cache{};
 
 #ifdef SPU_DUMP_ALL_VOICES
 // +1 for reverb output
@@ -526,6 +543,7 @@ void SPU::Reset()
   s_transfer_fifo.Clear();
   s_transfer_event->Deactivate();
   s_ram.fill(0);
+  InvalidateBlockCache();
   UpdateEventInterval();
 }
 
@@ -592,6 +610,7 @@ bool SPU::DoState(StateWrapper& sw)
 
   if (sw.IsReading())
   {
+    InvalidateBlockCache();
     UpdateEventInterval();
     UpdateTransferEvent();
   }
@@ -1190,6 +1209,7 @@ void SPU::WriteToCaptureBuffer(u32 index, s16 value)
   const u32 ram_address = (index * CAPTURE_BUFFER_SIZE_PER_CHANNEL) | ZeroExtend16(s_capture_buffer_position);
   // Log_DebugPrintf("write to capture buffer %u (0x%08X) <- 0x%04X", index, ram_address, u16(value));
   std::memcpy(&s_ram[ram_address], &value, sizeof(value));
+  InvalidateBlockCacheForRAMWrite(ram_address);
   if (IsRAMIRQTriggerable() && CheckRAMIRQ(ram_address))
   {
     Log_DebugPrintf("Trigger IRQ @ %08X %04X from capture buffer", ram_address, ram_address / 8);
@@ -1228,6 +1248,7 @@ ALWAYS_INLINE_RELEASE void SPU::ExecuteFIFOWriteToRAM(TickCount& ticks)
   {
     u16 value = s_transfer_fifo.Pop();
     std::memcpy(&s_ram[s_transfer_address], &value, sizeof(u16));
+    InvalidateBlockCacheForRAMWrite(s_transfer_address);
     s_transfer_address = (s_transfer_address + sizeof(u16)) & RAM_MASK;
     ticks -= TRANSFER_TICKS_PER_HALFWORD;
 
@@ -1303,6 +1324,7 @@ void SPU::ManualTransferWrite(u16 value)
   }
 
   std::memcpy(&s_ram[s_transfer_address], &value, sizeof(u16));
+  InvalidateBlockCacheForRAMWrite(s_transfer_address);
   s_transfer_address = (s_transfer_address + sizeof(u16)) & RAM_MASK;
 
   if (IsRAMIRQTriggerable() && CheckRAMIRQ(s_transfer_address))
@@ -1452,6 +1474,11 @@ void SPU::DMAWrite(const u32* words, u32 word_count)
   UpdateTransferEvent();
 }
 
+u32 SPU::GetDMAWriteSpace()
+{
+  return s_transfer_fifo.GetSpace() / 2;
+}
+
 void SPU::GeneratePendingSamples()
 {
   if (s_transfer_event->IsActive())
@@ -1799,16 +1826,69 @@ void SPU::Voice::DecodeBlock(const ADPCMBlock& block)
   const s32 filter_neg = filter_table_neg[filter_index];
   s16 last_samples[2] = {adpcm_last_samples[0], adpcm_last_samples[1]};
 
-  // samples
+  // Extend all nibbles to 16-bit and apply the header shift up front - unlike the filter recurrence below, this part
+  // has no serial dependency. The block is exactly 16 bytes, so load the whole thing and shift out the header rather
+  // than reading past the end of the data array.
+  alignas(VECTOR_ALIGNMENT) std::array<s16, 32> expanded;
+#if defined(CPU_ARCH_SSE)
+  const __m128i data = _mm_srli_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&block)), 2);
+  const __m128i lo_nibbles = _mm_and_si128(data, _mm_set1_epi8(0x0F));
+  const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi16(data, 4), _mm_set1_epi8(0x0F));
+  const __m128i interleaved_lo = _mm_unpacklo_epi8(lo_nibbles, hi_nibbles);
+  const __m128i interleaved_hi = _mm_unpackhi_epi8(lo_nibbles, hi_nibbles);
+  const __m128i shift_count = _mm_cvtsi32_si128(shift);
+  const __m128i zero = _mm_setzero_si128();
+
+  // unpacking with zero in the low byte positions the nibble in bits 8-11, so only four more bits to shift up
+  _mm_store_si128(reinterpret_cast<__m128i*>(&expanded[0]),
+                  _mm_sra_epi16(_mm_slli_epi16(_mm_unpacklo_epi8(zero, interleaved_lo), 4), shift_count));
+  _mm_store_si128(reinterpret_cast<__m128i*>(&expanded[8]),
+                  _mm_sra_epi16(_mm_slli_epi16(_mm_unpackhi_epi8(zero, interleaved_lo), 4), shift_count));
+  _mm_store_si128(reinterpret_cast<__m128i*>(&expanded[16]),
+                  _mm_sra_epi16(_mm_slli_epi16(_mm_unpacklo_epi8(zero, interleaved_hi), 4), shift_count));
+  _mm_store_si128(reinterpret_cast<__m128i*>(&expanded[24]),
+                  _mm_sra_epi16(_mm_slli_epi16(_mm_unpackhi_epi8(zero, interleaved_hi), 4), shift_count));
+#elif defined(CPU_ARCH_NEON)
+  const uint8x16_t data = vextq_u8(vld1q_u8(reinterpret_cast<const u8*>(&block)), vdupq_n_u8(0), 2);
+  const uint8x16_t lo_nibbles = vandq_u8(data, vdupq_n_u8(0x0F));
+  const uint8x16_t hi_nibbles = vshrq_n_u8(data, 4);
+  const uint8x16x2_t interleaved = vzipq_u8(lo_nibbles, hi_nibbles);
+  const int16x8_t shift_count = vdupq_n_s16(-static_cast<s16>(shift));
+
+  vst1q_s16(&expanded[0],
+            vshlq_s16(vshlq_n_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(interleaved.val[0]))), 12), shift_count));
+  vst1q_s16(&expanded[8],
+            vshlq_s16(vshlq_n_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(interleaved.val[0]))), 12), shift_count));
+  vst1q_s16(&expanded[16],
+            vshlq_s16(vshlq_n_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(interleaved.val[1]))), 12), shift_count));
+  vst1q_s16(&expanded[24],
+            vshlq_s16(vshlq_n_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(interleaved.val[1]))), 12), shift_count));
+#else
   for (u32 i = 0; i < NUM_SAMPLES_PER_ADPCM_BLOCK; i++)
+    expanded[i] = static_cast<s16>(static_cast<s16>(ZeroExtend16(block.GetNibble(i)) << 12) >> shift);
+#endif
+
+  // samples
+  if (filter_pos == 0 && filter_neg == 0)
   {
-    // extend 4-bit to 16-bit, apply shift from header and mix in previous samples
-    s32 sample = s32(static_cast<s16>(ZeroExtend16(block.GetNibble(i)) << 12) >> shift);
-    sample += (last_samples[0] * filter_pos) >> 6;
-    sample += (last_samples[1] * filter_neg) >> 6;
+    // filter 0 mixes nothing in from previous samples, so the expanded values are the decoded samples as-is
+    std::copy_n(expanded.begin(), NUM_SAMPLES_PER_ADPCM_BLOCK,
+                current_block_samples.begin() + NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK);
+    last_samples[1] = expanded[NUM_SAMPLES_PER_ADPCM_BLOCK - 2];
+    last_samples[0] = expanded[NUM_SAMPLES_PER_ADPCM_BLOCK - 1];
+  }
+  else
+  {
+    for (u32 i = 0; i < NUM_SAMPLES_PER_ADPCM_BLOCK; i++)
+    {
+      // mix in previous samples
+      s32 sample = s32(expanded[i]);
+      sample += (last_samples[0] * filter_pos) >> 6;
+      sample += (last_samples[1] * filter_neg) >> 6;
 
-    last_samples[1] = last_samples[0];
-    current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + i] = last_samples[0] = static_cast<s16>(Clamp16(sample));
+      last_samples[1] = last_samples[0];
+      current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + i] = last_samples[0] = static_cast<s16>(Clamp16(sample));
+    }
   }
 
   std::copy(last_samples, last_samples + countof(last_samples), adpcm_last_samples.begin());
@@ -1887,11 +1967,25 @@ s32 SPU::Voice::Interpolate() const
   const u8 i = counter.interpolation_index;
   const u32 s = NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + ZeroExtend32(counter.sample_index.GetValue());
 
+#if defined(CPU_ARCH_SSE)
+  // Multiply-accumulate across the four taps. Any two adjacent taps sum to less than 0x8000 in magnitude, so the
+  // pairwise 32-bit products in PMADDWD cannot overflow.
+  const __m128i coefficients =
+    _mm_set_epi16(0, 0, 0, 0, gauss[0x000 + i], gauss[0x100 + i], gauss[0x1FF - i], gauss[0x0FF - i]);
+  const __m128i samples = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&current_block_samples[s - 3]));
+  const __m128i products = _mm_madd_epi16(coefficients, samples);
+  return (_mm_cvtsi128_si32(products) + _mm_cvtsi128_si32(_mm_srli_si128(products, 4))) >> 15;
+#elif defined(CPU_ARCH_NEON)
+  const s16 coefficients[4] = {gauss[0x0FF - i], gauss[0x1FF - i], gauss[0x100 + i], gauss[0x000 + i]};
+  const int32x4_t products = vmull_s16(vld1_s16(coefficients), vld1_s16(&current_block_samples[s - 3]));
+  return vaddvq_s32(products) >> 15;
+#else
   s32 out = s32(gauss[0x0FF - i]) * s32(current_block_samples[s - 3]);
   out += s32(gauss[0x1FF - i]) * s32(current_block_samples[s - 2]);
   out += s32(gauss[0x100 + i]) * s32(current_block_samples[s - 1]);
   out += s32(gauss[0x000 + i]) * s32(current_block_samples[s - 0]);
   return out >> 15;
+#endif
 }
 
 void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
@@ -1921,6 +2015,25 @@ void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
   }
 }
 
+ALWAYS_INLINE static u32 BlockCacheIndex(u16 address)
+{
+  return ZeroExtend32(static_cast<u16>(address >> 1)) % SPU::NUM_ADPCM_BLOCK_CACHE_ENTRIES;
+}
+
+void SPU::InvalidateBlockCache()
+{
+  for (ADPCMBlockCacheEntry& entry : s_block_cache)
+    entry.valid = false;
+}
+
+void SPU::InvalidateBlockCacheForRAMWrite(u32 ram_address)
+{
+  // Blocks are 16 bytes starting on an 8-byte boundary, so a write can land in one of two candidate blocks.
+  const u32 chunk_address = ram_address & ~7u;
+  s_block_cache[BlockCacheIndex(Truncate16(chunk_address / 8))].valid = false;
+  s_block_cache[BlockCacheIndex(Truncate16(((chunk_address - 8) & RAM_MASK) / 8))].valid = false;
+}
+
 ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
 {
   Voice& voice = s_voices[voice_index];
@@ -1941,9 +2054,47 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
 
   if (!voice.has_samples)
   {
-    ADPCMBlock block;
-    ReadADPCMBlock(voice.current_address, &block);
-    voice.DecodeBlock(block);
+    ADPCMBlockCacheEntry& cache_entry = s_block_cache[BlockCacheIndex(voice.current_address)];
+    if (cache_entry.valid && cache_entry.address == voice.current_address &&
+        cache_entry.previous_samples == voice.adpcm_last_samples)
+    {
+      // Skip the decode, but the IRQ check has to happen as if we had read the block from RAM.
+      const u32 ram_address = (ZeroExtend32(voice.current_address) * 8) & RAM_MASK;
+      if (IsRAMIRQTriggerable() && (CheckRAMIRQ(ram_address) || CheckRAMIRQ((ram_address + 8) & RAM_MASK)))
+      {
+        Log_DebugPrintf("Trigger IRQ @ %08X %04X from cached ADPCM block", ram_address, ram_address / 8);
+        TriggerRAMIRQ();
+      }
+
+      // store samples needed for interpolation, same as DecodeBlock()
+      voice.current_block_samples[2] =
+        voice.current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + NUM_SAMPLES_PER_ADPCM_BLOCK - 1];
+      voice.current_block_samples[1] =
+        voice.current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + NUM_SAMPLES_PER_ADPCM_BLOCK - 2];
+      voice.current_block_samples[0] =
+        voice.current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + NUM_SAMPLES_PER_ADPCM_BLOCK - 3];
+      std::copy(cache_entry.samples.begin(), cache_entry.samples.end(),
+                voice.current_block_samples.begin() + NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK);
+      voice.adpcm_last_samples = cache_entry.next_samples;
+      voice.current_block_flags.bits = cache_entry.flags.bits;
+    }
+    else
+    {
+      ADPCMBlock block;
+      ReadADPCMBlock(voice.current_address, &block);
+
+      const std::array<s16, 2> previous_samples = voice.adpcm_last_samples;
+      voice.DecodeBlock(block);
+
+      cache_entry.valid = true;
+      cache_entry.address = voice.current_address;
+      cache_entry.flags.bits = voice.current_block_flags.bits;
+      cache_entry.previous_samples = previous_samples;
+      cache_entry.next_samples = voice.adpcm_last_samples;
+      std::copy_n(voice.current_block_samples.begin() + NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK,
+                  NUM_SAMPLES_PER_ADPCM_BLOCK, cache_entry.samples.begin());
+    }
+
     voice.has_samples = true;
 
     if (voice.current_block_flags.loop_start && !voice.ignore_loop_address)
@@ -1953,9 +2104,14 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
     }
   }
 
-  // skip interpolation when the volume is muted anyway
+  // Skip interpolation when the ADSR volume is zero, or when both channel volumes are muted and nothing else
+  // observes this voice's output (the capture buffers for voices 1/3, or pitch modulation of the next voice).
+  // The envelope, counters and block decoding still advance as normal either way.
+  const bool output_observed = (voice_index == 1 || voice_index == 3) ||
+                               (voice_index < (NUM_VOICES - 1) && IsPitchModulationEnabled(voice_index + 1));
   s32 volume;
-  if (voice.regs.adsr_volume != 0)
+  if (voice.regs.adsr_volume != 0 &&
+      (output_observed || voice.left_volume.current_level != 0 || voice.right_volume.current_level != 0))
   {
     // interpolate/sample and apply ADSR volume
     s32 sample;
@@ -2089,20 +2245,50 @@ void SPU::ReverbWrite(u32 address, s16 data)
   // TODO: This should check interrupts.
   const u32 real_address = ReverbMemoryAddress(address << 2);
   std::memcpy(&s_ram[real_address], &data, sizeof(data));
+  InvalidateBlockCacheForRAMWrite(real_address);
 }
 
 // Zeroes optimized out; middle removed too(it's 16384)
-static constexpr std::array<s16, 20> s_reverb_resample_coefficients = {
+alignas(VECTOR_ALIGNMENT) static constexpr std::array<s16, 20> s_reverb_resample_coefficients = {
   -1, 2, -10, 35, -103, 266, -616, 1332, -2960, 10246, 10246, -2960, 1332, -616, 266, -103, 35, -10, 2, -1,
 };
+
+#if defined(CPU_ARCH_SSE)
+// Same coefficients with a zero after each, so PMADDWD picks out the even taps of the interleaved downsample buffer.
+alignas(VECTOR_ALIGNMENT) static constexpr std::array<s16, 40> s_reverb_resample_coefficients_even = {
+  -1, 0, 2,     0, -10,   0, 35,   0, -103, 0, 266,  0, -616, 0, 1332, 0, -2960, 0, 10246, 0,
+  10246, 0, -2960, 0, 1332, 0, -616, 0, 266,  0, -103, 0, 35,   0, -10,  0, 2,     0, -1,    0,
+};
+#endif
 static s16 s_last_reverb_input[2];
 static s32 s_last_reverb_output[2];
 
 ALWAYS_INLINE static s32 Reverb4422(const s16* src)
 {
+#if defined(CPU_ARCH_SSE)
+  __m128i acc = _mm_setzero_si128();
+  for (u32 i = 0; i < 5; i++)
+  {
+    acc = _mm_add_epi32(
+      acc, _mm_madd_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(&s_reverb_resample_coefficients_even[i * 8])),
+                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i * 8]))));
+  }
+  acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
+  acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 4));
+  s32 out = _mm_cvtsi128_si32(acc); // 32-bits is adequate(it won't overflow)
+#elif defined(CPU_ARCH_NEON)
+  int32x4_t acc = vdupq_n_s32(0);
+  for (u32 i = 0; i < 5; i++)
+  {
+    const int16x4x2_t samples = vld2_s16(&src[i * 8]);
+    acc = vmlal_s16(acc, vld1_s16(&s_reverb_resample_coefficients[i * 4]), samples.val[0]);
+  }
+  s32 out = vaddvq_s32(acc); // 32-bits is adequate(it won't overflow)
+#else
   s32 out = 0; // 32-bits is adequate(it won't overflow)
   for (u32 i = 0; i < 20; i++)
     out += s_reverb_resample_coefficients[i] * src[i * 2];
+#endif
 
   // Middle non-zero
   out += 0x4000 * src[19];
@@ -2121,9 +2307,29 @@ ALWAYS_INLINE static s32 Reverb2244(const s16* src)
   }
   else
   {
+#if defined(CPU_ARCH_SSE)
+    __m128i acc =
+      _mm_madd_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(&s_reverb_resample_coefficients[0])),
+                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[0])));
+    acc = _mm_add_epi32(
+      acc, _mm_madd_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(&s_reverb_resample_coefficients[8])),
+                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[8]))));
+    acc = _mm_add_epi32(
+      acc, _mm_madd_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&s_reverb_resample_coefficients[16])),
+                          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&src[16]))));
+    acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 4));
+    out = _mm_cvtsi128_si32(acc);
+#elif defined(CPU_ARCH_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+    for (u32 i = 0; i < 5; i++)
+      acc = vmlal_s16(acc, vld1_s16(&s_reverb_resample_coefficients[i * 4]), vld1_s16(&src[i * 4]));
+    out = vaddvq_s32(acc);
+#else
     out = 0;
     for (u32 i = 0; i < 20; i++)
       out += s_reverb_resample_coefficients[i] * src[i];
+#endif
 
     out >>= 14;
     out = std::clamp<s32>(out, -32768, 32767);
@@ -30,6 +30,10 @@ void WriteRegister(u32 offset, u16 value);
 void DMARead(u32* words, u32 word_count);
 void DMAWrite(const u32* words, u32 word_count);
 
+/// Returns the number of words the transfer FIFO can currently accept. Used to size batched DMA
+/// block transfers.
+u32 GetDMAWriteSpace();
+
 // Render statistics debug window.
 void DrawDebugStateWindow();
 
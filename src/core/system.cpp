@@ -12,7 +12,9 @@
 #include "cpu_code_cache.h"
 #include "cpu_core.h"
 #include "cpu_pgxp.h"
+#include "cpu_profiler.h"
 #include "dma.h"
+#include "frame_export.h"
 #include "fullscreen_ui.h"
 #include "game_database.h"
 #include "game_list.h"
@@ -27,6 +29,8 @@
 #include "multitap.h"
 #include "pad.h"
 #include "pcdrv.h"
+#include "perf_stats.h"
+#include "performance_advisor.h"
 #include "psf_loader.h"
 #include "save_state_version.h"
 #include "sio.h"
@@ -48,7 +52,9 @@
 #include "common/error.h"
 #include "common/file_system.h"
 #include "common/log.h"
+#include "common/memory_budget.h"
 #include "common/path.h"
+#include "common/perf_trace.h"
 #include "common/string_util.h"
 #include "common/threading.h"
 
@@ -60,10 +66,12 @@
 #include <cctype>
 #include <cinttypes>
 #include <cmath>
+#include <condition_variable>
 #include <cstdio>
 #include <deque>
 #include <fstream>
 #include <limits>
+#include <mutex>
 #include <thread>
 
 Log_SetChannel(System);
@@ -105,22 +113,32 @@ static void InternalReset();
 static void ClearRunningGame();
 static void DestroySystem();
 static std::string GetMediaPathFromSaveState(const char* path);
-static bool DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_display, bool is_memory_state);
+static bool DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_display, bool is_memory_state,
+                    bool skip_ram = false);
 static bool CreateGPU(GPURenderer renderer, bool is_switching);
 static bool SaveUndoLoadState();
+static void WaitForSaveStateWrites();
+static void WriteQueuedSaveState(const std::string& filename, const u8* buffer, u32 buffer_size, bool compress);
 static void WarnAboutUnsafeSettings();
 static void LogUnsafeSettingsToConsole(const std::string& messages);
 
 /// Throttles the system, i.e. sleeps until it's time to execute the next frame.
 static void Throttle();
 
+/// Accumulates present-to-present timing under vsync, refining the reported refresh rate.
+static void AccumulatePresentTiming(Common::Timer::Value now);
+
 static void SetRewinding(bool enabled);
 static bool SaveRewindState();
+static bool PopRewindState();
+static void UpdateRewindMemoryUsage();
 static void DoRewind();
 
 static void SaveRunaheadState();
 static bool DoRunahead();
 
+static void SavePsfSeekState();
+
 static bool Initialize(bool force_software_renderer);
 static bool FastForwardToFirstFrame();
 
@@ -143,99 +161,144 @@ static void PollDiscordPresence();
 static constexpr const float PERFORMANCE_COUNTER_UPDATE_INTERVAL = 1.0f;
 static constexpr const char FALLBACK_EXE_NAME[] = "PSX.EXE";
 
-static std::unique_ptr<INISettingsInterface> s_game_settings_interface;
-static std::unique_ptr<INISettingsInterface> s_input_settings_interface;
-static std::string s_input_profile_name;
-
-static System::State s_state = System::State::Shutdown;
-static std::atomic_bool s_startup_cancelled{false};
-static bool s_keep_gpu_device_on_shutdown = false;
+// Seconds between PSF seek snapshots, and the maximum number of them to keep. When the limit is
+// reached, every other snapshot is dropped and the interval doubles, so a fixed memory budget
+// covers the whole track at progressively coarser granularity.
+static constexpr const float PSF_SEEK_SNAPSHOT_INTERVAL = 2.0f;
+static constexpr const u32 MAX_PSF_SEEK_STATES = 64;
+
+// All mutable state belonging to the currently-active System. Process-wide resources (BIOS
+// database, game database, shader caches, thread pool) deliberately live outside of it; keeping
+// the per-instance state in one struct makes that boundary explicit, and is the first step
+// towards hosting multiple Systems in a single process. Subsystem globals (CPU::g_state,
+// Bus::g_ram, ...) still limit us to one active instance for now.
+struct SystemState
+{
+  std::unique_ptr<INISettingsInterface> game_settings_interface;
+  std::unique_ptr<INISettingsInterface> input_settings_interface;
+  std::string input_profile_name;
 
-static ConsoleRegion s_region = ConsoleRegion::NTSC_U;
-TickCount System::g_ticks_per_second = System::MASTER_CLOCK;
-static TickCount s_max_slice_ticks = System::MASTER_CLOCK / 10;
-static u32 s_frame_number = 1;
-static u32 s_internal_frame_number = 1;
-static const BIOS::ImageInfo* s_bios_image_info = nullptr;
-static BIOS::Hash s_bios_hash = {};
-
-static std::string s_running_game_path;
-static std::string s_running_game_serial;
-static std::string s_running_game_title;
-static const GameDatabase::Entry* s_running_game_entry = nullptr;
-static System::GameHash s_running_game_hash;
-static bool s_was_fast_booted;
-
-static float s_throttle_frequency = 60.0f;
-static float s_target_speed = 1.0f;
-static Common::Timer::Value s_frame_period = 0;
-static Common::Timer::Value s_next_frame_time = 0;
-static bool s_last_frame_skipped = false;
-
-static bool s_system_executing = false;
-static bool s_system_interrupted = false;
-static bool s_frame_step_request = false;
-static bool s_fast_forward_enabled = false;
-static bool s_turbo_enabled = false;
-static bool s_throttler_enabled = true;
-static bool s_display_all_frames = true;
-static bool s_syncing_to_host = false;
-
-static float s_average_frame_time_accumulator = 0.0f;
-static float s_minimum_frame_time_accumulator = 0.0f;
-static float s_maximum_frame_time_accumulator = 0.0f;
-
-static float s_vps = 0.0f;
-static float s_fps = 0.0f;
-static float s_speed = 0.0f;
-static float s_minimum_frame_time = 0.0f;
-static float s_maximum_frame_time = 0.0f;
-static float s_average_frame_time = 0.0f;
-static float s_cpu_thread_usage = 0.0f;
-static float s_cpu_thread_time = 0.0f;
-static float s_sw_thread_usage = 0.0f;
-static float s_sw_thread_time = 0.0f;
-static float s_average_gpu_time = 0.0f;
-static float s_accumulated_gpu_time = 0.0f;
-static float s_gpu_usage = 0.0f;
-static System::FrameTimeHistory s_frame_time_history;
-static u32 s_frame_time_history_pos = 0;
-static u32 s_last_frame_number = 0;
-static u32 s_last_internal_frame_number = 0;
-static u32 s_last_global_tick_counter = 0;
-static u64 s_last_cpu_time = 0;
-static u64 s_last_sw_time = 0;
-static u32 s_presents_since_last_update = 0;
-static Common::Timer s_fps_timer;
-static Common::Timer s_frame_timer;
-static Threading::ThreadHandle s_cpu_thread_handle;
-
-static std::unique_ptr<CheatList> s_cheat_list;
-
-// temporary save state, created when loading, used to undo load state
-static std::unique_ptr<ByteStream> m_undo_load_state;
-
-static bool s_memory_saves_enabled = false;
-
-static std::deque<System::MemorySaveState> s_rewind_states;
-static s32 s_rewind_load_frequency = -1;
-static s32 s_rewind_load_counter = -1;
-static s32 s_rewind_save_frequency = -1;
-static s32 s_rewind_save_counter = -1;
-static bool s_rewinding_first_save = false;
-
-static std::deque<System::MemorySaveState> s_runahead_states;
-static bool s_runahead_replay_pending = false;
-static u32 s_runahead_frames = 0;
-static u32 s_runahead_replay_frames = 0;
-
-// Used to track play time. We use a monotonic timer here, in case of clock changes.
-static u64 s_session_start_time = 0;
+  System::State state = System::State::Shutdown;
+  std::atomic_bool startup_cancelled{false};
+  bool keep_gpu_device_on_shutdown = false;
+
+  ConsoleRegion region = ConsoleRegion::NTSC_U;
+  TickCount max_slice_ticks = System::MASTER_CLOCK / 10;
+  u32 frame_number = 1;
+  u32 internal_frame_number = 1;
+  const BIOS::ImageInfo* bios_image_info = nullptr;
+  BIOS::Hash bios_hash = {};
+
+  std::string running_game_path;
+  std::string running_game_serial;
+  std::string running_game_title;
+  const GameDatabase::Entry* running_game_entry = nullptr;
+  System::GameHash running_game_hash = 0;
+  bool was_fast_booted = false;
+
+  float throttle_frequency = 60.0f;
+  float target_speed = 1.0f;
+  Common::Timer::Value frame_period = 0;
+  Common::Timer::Value next_frame_time = 0;
+  bool last_frame_skipped = false;
+
+  // Refresh rate measured from present timestamps. The rate drivers report is usually rounded
+  // (59.94Hz panels claim 60), so pacing against measured intervals avoids periodic judder.
+  Common::Timer::Value last_present_time = 0;
+  Common::Timer::Value present_interval_sum = 0;
+  u32 present_interval_count = 0;
+  float measured_refresh_rate = 0.0f;
+
+  bool system_executing = false;
+  bool system_interrupted = false;
+  bool frame_step_request = false;
+  bool fast_forward_enabled = false;
+  bool turbo_enabled = false;
+  bool throttler_enabled = true;
+  bool display_all_frames = true;
+  bool syncing_to_host = false;
+
+  float average_frame_time_accumulator = 0.0f;
+  float minimum_frame_time_accumulator = 0.0f;
+  float maximum_frame_time_accumulator = 0.0f;
+
+  float vps = 0.0f;
+  float fps = 0.0f;
+  float speed = 0.0f;
+  float minimum_frame_time = 0.0f;
+  float maximum_frame_time = 0.0f;
+  float average_frame_time = 0.0f;
+  float cpu_thread_usage = 0.0f;
+  float cpu_thread_time = 0.0f;
+  float sw_thread_usage = 0.0f;
+  float sw_thread_time = 0.0f;
+  float average_gpu_time = 0.0f;
+  float accumulated_gpu_time = 0.0f;
+  float gpu_usage = 0.0f;
+  System::FrameTimeHistory frame_time_history;
+  u32 frame_time_history_pos = 0;
+  u32 last_frame_number = 0;
+  u32 last_internal_frame_number = 0;
+  u32 last_global_tick_counter = 0;
+  u64 last_cpu_time = 0;
+  u64 last_sw_time = 0;
+  u32 presents_since_last_update = 0;
+  Common::Timer fps_timer;
+  Common::Timer frame_timer;
+  Threading::ThreadHandle cpu_thread_handle;
+
+  std::unique_ptr<CheatList> cheat_list;
+
+  // temporary save state, created when loading, used to undo load state
+  std::unique_ptr<ByteStream> undo_load_state;
+
+  bool memory_saves_enabled = false;
+
+  std::deque<System::MemorySaveState> rewind_states;
+  s32 rewind_load_frequency = -1;
+  s32 rewind_load_counter = -1;
+  s32 rewind_save_frequency = -1;
+  s32 rewind_save_counter = -1;
+  bool rewinding_first_save = false;
+
+  // Uncompressed copy of the newest rewind snapshot; rewind slots only store deltas against it,
+  // and popping a slot XORs its delta back into this buffer to roll it backwards.
+  std::unique_ptr<GrowableMemoryByteStream> rewind_reference;
+  std::unique_ptr<GrowableMemoryByteStream> rewind_scratch;
+  u32 rewind_reference_size = 0;
+
+  std::deque<System::MemorySaveState> runahead_states;
+
+  // Snapshots taken periodically during PSF playback, keyed by the frame they were taken at and
+  // kept in frame order. Seeking restores the newest snapshot at or before the target frame and
+  // emulates the remainder, instead of replaying the track from the start.
+  std::deque<std::pair<u32, System::MemorySaveState>> psf_seek_states;
+  s32 psf_seek_save_frequency = -1;
+  s32 psf_seek_save_counter = -1;
+  u32 psf_seek_target_frame = 0;
+  bool psf_seek_replay = false;
+  bool psf_playback = false;
+
+  // Save state writes queued to the thread pool. Tracked so loads wait for in-flight writes.
+  std::mutex save_state_write_mutex;
+  std::condition_variable save_state_write_cv;
+  u32 save_state_writes_pending = 0;
+  bool runahead_replay_pending = false;
+  u32 runahead_frames = 0;
+  u32 runahead_replay_frames = 0;
+
+  // Used to track play time. We use a monotonic timer here, in case of clock changes.
+  u64 session_start_time = 0;
 
 #ifdef ENABLE_DISCORD_PRESENCE
-static bool s_discord_presence_active = false;
-static time_t s_discord_presence_time_epoch;
+  bool discord_presence_active = false;
+  time_t discord_presence_time_epoch = 0;
 #endif
+};
+
+static SystemState s_state;
+
+TickCount System::g_ticks_per_second = System::MASTER_CLOCK;
 
 static TinyString GetTimestampStringForFileName()
 {
@@ -280,6 +343,12 @@ void System::Internal::ProcessShutdown()
 
   CPU::CodeCache::ProcessShutdown();
   Bus::ReleaseMemory();
+
+  FileSystem::ShutdownAsyncFileIO();
+  Threading::ThreadPool::Shutdown();
+
+  // Drain anything still queued to the logger thread before the process goes away.
+  Log::SetAsyncOutputEnabled(false);
 }
 
 void System::Internal::IdlePollUpdate()
@@ -295,75 +364,75 @@ void System::Internal::IdlePollUpdate()
 
 System::State System::GetState()
 {
-  return s_state;
+  return s_state.state;
 }
 
 void System::SetState(State new_state)
 {
-  if (s_state == new_state)
+  if (s_state.state == new_state)
     return;
 
-  Assert(s_state == State::Paused || s_state == State::Running);
+  Assert(s_state.state == State::Paused || s_state.state == State::Running);
   Assert(new_state == State::Paused || new_state == State::Running);
-  s_state = new_state;
+  s_state.state = new_state;
 }
 
 bool System::IsRunning()
 {
-  return s_state == State::Running;
+  return s_state.state == State::Running;
 }
 
 bool System::IsExecutionInterrupted()
 {
-  return s_state != State::Running || s_system_interrupted;
+  return s_state.state != State::Running || s_state.system_interrupted;
 }
 
 bool System::IsPaused()
 {
-  return s_state == State::Paused;
+  return s_state.state == State::Paused;
 }
 
 bool System::IsShutdown()
 {
-  return s_state == State::Shutdown;
+  return s_state.state == State::Shutdown;
 }
 
 bool System::IsValid()
 {
-  return s_state == State::Running || s_state == State::Paused;
+  return s_state.state == State::Running || s_state.state == State::Paused;
 }
 
 bool System::IsValidOrInitializing()
 {
-  return s_state == State::Starting || s_state == State::Running || s_state == State::Paused;
+  return s_state.state == State::Starting || s_state.state == State::Running || s_state.state == State::Paused;
 }
 
 bool System::IsExecuting()
 {
-  DebugAssert(s_state != State::Shutdown);
-  return s_system_executing;
+  DebugAssert(s_state.state != State::Shutdown);
+  return s_state.system_executing;
 }
 
 bool System::IsStartupCancelled()
 {
-  return s_startup_cancelled.load();
+  return s_state.startup_cancelled.load();
 }
 
 void System::CancelPendingStartup()
 {
-  if (s_state == State::Starting)
-    s_startup_cancelled.store(true);
+  if (s_state.state == State::Starting)
+    s_state.startup_cancelled.store(true);
 }
 
 void System::InterruptExecution()
 {
-  if (s_system_executing)
-    s_system_interrupted = true;
+  if (s_state.system_executing)
+    s_state.system_interrupted = true;
 }
 
 ConsoleRegion System::GetRegion()
 {
-  return s_region;
+  return s_state.region;
 }
 
 DiscRegion System::GetDiscRegion()
@@ -373,18 +442,18 @@ DiscRegion System::GetDiscRegion()
 
 bool System::IsPALRegion()
 {
-  return s_region == ConsoleRegion::PAL;
+  return s_state.region == ConsoleRegion::PAL;
 }
 
 TickCount System::GetMaxSliceTicks()
 {
-  return s_max_slice_ticks;
+  return s_state.max_slice_ticks;
 }
 
 void System::UpdateOverclock()
 {
   g_ticks_per_second = ScaleTicksToOverclock(MASTER_CLOCK);
-  s_max_slice_ticks = ScaleTicksToOverclock(MASTER_CLOCK / 10);
+  s_state.max_slice_ticks = ScaleTicksToOverclock(MASTER_CLOCK / 10);
   SPU::CPUClockChanged();
   CDROM::CPUClockChanged();
   g_gpu->CPUClockChanged();
@@ -394,117 +463,117 @@ void System::UpdateOverclock()
 
 u32 System::GetFrameNumber()
 {
-  return s_frame_number;
+  return s_state.frame_number;
 }
 
 u32 System::GetInternalFrameNumber()
 {
-  return s_internal_frame_number;
+  return s_state.internal_frame_number;
 }
 
 const std::string& System::GetDiscPath()
 {
-  return s_running_game_path;
+  return s_state.running_game_path;
 }
 const std::string& System::GetGameSerial()
 {
-  return s_running_game_serial;
+  return s_state.running_game_serial;
 }
 
 const std::string& System::GetGameTitle()
 {
-  return s_running_game_title;
+  return s_state.running_game_title;
 }
 
 const GameDatabase::Entry* System::GetGameDatabaseEntry()
 {
-  return s_running_game_entry;
+  return s_state.running_game_entry;
 }
 
 System::GameHash System::GetGameHash()
 {
-  return s_running_game_hash;
+  return s_state.running_game_hash;
 }
 
 bool System::IsRunningUnknownGame()
 {
-  return !s_running_game_entry;
+  return !s_state.running_game_entry;
 }
 
 bool System::WasFastBooted()
 {
-  return s_was_fast_booted;
+  return s_state.was_fast_booted;
 }
 
 const BIOS::ImageInfo* System::GetBIOSImageInfo()
 {
-  return s_bios_image_info;
+  return s_state.bios_image_info;
 }
 
 const BIOS::Hash& System::GetBIOSHash()
 {
-  return s_bios_hash;
+  return s_state.bios_hash;
 }
 
 float System::GetFPS()
 {
-  return s_fps;
+  return s_state.fps;
 }
 float System::GetVPS()
 {
-  return s_vps;
+  return s_state.vps;
 }
 float System::GetEmulationSpeed()
 {
-  return s_speed;
+  return s_state.speed;
 }
 float System::GetAverageFrameTime()
 {
-  return s_average_frame_time;
+  return s_state.average_frame_time;
 }
 float System::GetMinimumFrameTime()
 {
-  return s_minimum_frame_time;
+  return s_state.minimum_frame_time;
 }
 float System::GetMaximumFrameTime()
 {
-  return s_maximum_frame_time;
+  return s_state.maximum_frame_time;
 }
 float System::GetThrottleFrequency()
 {
-  return s_throttle_frequency;
+  return s_state.throttle_frequency;
 }
 float System::GetCPUThreadUsage()
 {
-  return s_cpu_thread_usage;
+  return s_state.cpu_thread_usage;
 }
 float System::GetCPUThreadAverageTime()
 {
-  return s_cpu_thread_time;
+  return s_state.cpu_thread_time;
 }
 float System::GetSWThreadUsage()
 {
-  return s_sw_thread_usage;
+  return s_state.sw_thread_usage;
 }
 float System::GetSWThreadAverageTime()
 {
-  return s_sw_thread_time;
+  return s_state.sw_thread_time;
 }
 float System::GetGPUUsage()
 {
-  return s_gpu_usage;
+  return s_state.gpu_usage;
 }
 float System::GetGPUAverageTime()
 {
-  return s_average_gpu_time;
+  return s_state.average_gpu_time;
 }
 const System::FrameTimeHistory& System::GetFrameTimeHistory()
 {
-  return s_frame_time_history;
+  return s_state.frame_time_history;
 }
 u32 System::GetFrameTimeHistoryPos()
 {
-  return s_frame_time_history_pos;
+  return s_state.frame_time_history_pos;
 }
 
 bool System::IsExeFileName(const std::string_view& path)
@@ -521,7 +590,7 @@ bool System::IsPsfFileName(const std::string_view& path)
 bool System::IsLoadableFilename(const std::string_view& path)
 {
   static constexpr const std::array extensions = {
-    ".bin", ".cue",     ".img",    ".iso", ".chd", ".ecm", ".mds", // discs
+    ".bin", ".cue",     ".img",    ".iso", ".chd", ".zcd", ".ecm", ".mds", // discs
     ".exe", ".psexe",   ".ps-exe",                                 // exes
     ".psf", ".minipsf",                                            // psf
     ".m3u",                                                        // playlists
@@ -939,9 +1008,9 @@ void System::LoadSettings(bool display_osd_messages)
   // apply compatibility settings
   if (g_settings.apply_compatibility_settings)
   {
-    if (!s_running_game_serial.empty())
+    if (!s_state.running_game_serial.empty())
     {
-      const GameDatabase::Entry* entry = GameDatabase::GetEntryForSerial(s_running_game_serial);
+      const GameDatabase::Entry* entry = GameDatabase::GetEntryForSerial(s_state.running_game_serial);
       if (entry)
         entry->ApplySettings(g_settings, display_osd_messages);
     }
@@ -955,6 +1024,11 @@ void System::LoadSettings(bool display_osd_messages)
   }
 
   g_settings.FixIncompatibleSettings(display_osd_messages);
+
+  // sized when the image is opened, so push it before any media changes
+  CDImage::SetCHDHunkCacheSize(g_settings.cdrom_chd_hunk_cache_size_mb);
+
+  MemoryBudget::SetTotalBudget(static_cast<u64>(g_settings.memory_budget_mb) * 1048576);
 }
 
 void System::SetDefaultSettings(SettingsInterface& si)
@@ -999,8 +1073,8 @@ void System::ApplySettings(bool display_osd_messages)
   if (IsValid())
   {
     ResetPerformanceCounters();
-    if (s_system_executing)
-      s_system_interrupted = true;
+    if (s_state.system_executing)
+      s_state.system_interrupted = true;
   }
 }
 
@@ -1016,17 +1090,27 @@ bool System::ReloadGameSettings(bool display_osd_messages)
 bool System::UpdateGameSettingsLayer()
 {
   std::unique_ptr<INISettingsInterface> new_interface;
-  if (g_settings.apply_game_settings && !s_running_game_serial.empty())
+  if (g_settings.apply_game_settings && !s_state.running_game_serial.empty())
   {
-    std::string filename(GetGameSettingsPath(s_running_game_serial));
+    std::string filename(GetGameSettingsPath(s_state.running_game_serial));
     if (FileSystem::FileExists(filename.c_str()))
     {
-      Log_InfoPrintf("Loading game settings from '%s'...", filename.c_str());
-      new_interface = std::make_unique<INISettingsInterface>(std::move(filename));
-      if (!new_interface->Load())
+      // Every settings change comes back through here, so reuse the already-parsed interface
+      // unless the file itself has been modified since it was loaded.
+      if (s_state.game_settings_interface && s_state.game_settings_interface->GetFileName() == filename &&
+          !s_state.game_settings_interface->IsFileModified())
+      {
+        new_interface = std::move(s_state.game_settings_interface);
+      }
+      else
       {
-        Log_ErrorPrintf("Failed to parse game settings ini '%s'", new_interface->GetFileName().c_str());
-        new_interface.reset();
+        Log_InfoPrintf("Loading game settings from '%s'...", filename.c_str());
+        new_interface = std::make_unique<INISettingsInterface>(std::move(filename));
+        if (!new_interface->Load())
+        {
+          Log_ErrorPrintf("Failed to parse game settings ini '%s'", new_interface->GetFileName().c_str());
+          new_interface.reset();
+        }
       }
     }
     else
@@ -1044,11 +1128,11 @@ bool System::UpdateGameSettingsLayer()
       new_interface->GetStringValue("ControllerPorts", "InputProfileName", &input_profile_name);
   }
 
-  if (!s_game_settings_interface && !new_interface && s_input_profile_name == input_profile_name)
+  if (!s_state.game_settings_interface && !new_interface && s_state.input_profile_name == input_profile_name)
     return false;
 
   Host::Internal::SetGameSettingsLayer(new_interface.get());
-  s_game_settings_interface = std::move(new_interface);
+  s_state.game_settings_interface = std::move(new_interface);
 
   std::unique_ptr<INISettingsInterface> input_interface;
   if (!use_game_settings_for_controller)
@@ -1058,13 +1142,21 @@ bool System::UpdateGameSettingsLayer()
       const std::string filename(GetInputProfilePath(input_profile_name));
       if (FileSystem::FileExists(filename.c_str()))
       {
-        Log_InfoPrintf("Loading input profile from '%s'...", filename.c_str());
-        input_interface = std::make_unique<INISettingsInterface>(std::move(filename));
-        if (!input_interface->Load())
+        if (s_state.input_settings_interface && s_state.input_settings_interface->GetFileName() == filename &&
+            !s_state.input_settings_interface->IsFileModified())
         {
-          Log_ErrorPrintf("Failed to parse input profile ini '%s'", input_interface->GetFileName().c_str());
-          input_interface.reset();
-          input_profile_name = {};
+          input_interface = std::move(s_state.input_settings_interface);
+        }
+        else
+        {
+          Log_InfoPrintf("Loading input profile from '%s'...", filename.c_str());
+          input_interface = std::make_unique<INISettingsInterface>(std::move(filename));
+          if (!input_interface->Load())
+          {
+            Log_ErrorPrintf("Failed to parse input profile ini '%s'", input_interface->GetFileName().c_str());
+            input_interface.reset();
+            input_profile_name = {};
+          }
         }
       }
       else
@@ -1080,11 +1172,11 @@ bool System::UpdateGameSettingsLayer()
   else
   {
     // using game settings for bindings too
-    Host::Internal::SetInputSettingsLayer(s_game_settings_interface.get());
+    Host::Internal::SetInputSettingsLayer(s_state.game_settings_interface.get());
   }
 
-  s_input_settings_interface = std::move(input_interface);
-  s_input_profile_name = std::move(input_profile_name);
+  s_state.input_settings_interface = std::move(input_interface);
+  s_state.input_profile_name = std::move(input_profile_name);
   return true;
 }
 
@@ -1100,7 +1192,7 @@ void System::ResetSystem()
   {
     // Make sure a pre-existing cheat file hasn't been loaded when resetting
     // after enabling HC mode.
-    s_cheat_list.reset();
+    s_state.cheat_list.reset();
     ApplySettings(false);
   }
 
@@ -1160,6 +1252,9 @@ bool System::LoadState(const char* filename)
   if (!IsValid())
     return false;
 
+  // In case the state we're about to read is still being written out.
+  WaitForSaveStateWrites();
+
   if (Achievements::IsHardcoreModeActive())
   {
     Achievements::ConfirmHardcoreModeDisableAsync(TRANSLATE("Achievements", "Loading state"),
@@ -1192,7 +1287,7 @@ bool System::LoadState(const char* filename)
     Host::ReportFormattedErrorAsync("Load State Error",
                                     TRANSLATE("OSDMessage", "Loading state from '%s' failed. Resetting."), filename);
 
-    if (m_undo_load_state)
+    if (s_state.undo_load_state)
       UndoLoadState();
 
     return false;
@@ -1208,8 +1303,73 @@ bool System::LoadState(const char* filename)
   return true;
 }
 
+void System::WaitForSaveStateWrites()
+{
+  std::unique_lock<std::mutex> lock(s_state.save_state_write_mutex);
+  s_state.save_state_write_cv.wait(lock, []() { return (s_state.save_state_writes_pending == 0); });
+}
+
+void System::WriteQueuedSaveState(const std::string& filename, const u8* buffer, u32 buffer_size, bool compress)
+{
+  Common::Timer write_timer;
+
+  std::unique_ptr<ByteStream> stream =
+    ByteStream::OpenFile(filename.c_str(), BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE | BYTESTREAM_OPEN_TRUNCATE |
+                                             BYTESTREAM_OPEN_ATOMIC_UPDATE | BYTESTREAM_OPEN_STREAMED);
+  bool result = static_cast<bool>(stream);
+
+  if (result && (!compress || buffer_size < sizeof(SAVE_STATE_HEADER)))
+  {
+    result = stream->Write2(buffer, buffer_size);
+  }
+  else if (result)
+  {
+    // The in-memory snapshot is an uncompressed save state. Everything up to the data section
+    // (header, media filename, screenshot) is written as-is, the data section is recompressed.
+    SAVE_STATE_HEADER header;
+    std::memcpy(&header, buffer, sizeof(header));
+    header.data_compression_type = SAVE_STATE_HEADER::COMPRESSION_TYPE_ZSTD;
+
+    result = stream->Write2(buffer, header.offset_to_data);
+    if (result)
+    {
+      std::unique_ptr<ByteStream> cstream(ByteStream::CreateZstdCompressStream(stream.get(), 0));
+      result =
+        cstream->Write2(buffer + header.offset_to_data, buffer_size - header.offset_to_data) && cstream->Commit();
+    }
+
+    if (result)
+    {
+      header.data_compressed_size = static_cast<u32>(stream->GetPosition()) - header.offset_to_data;
+
+      const u64 end_position = stream->GetPosition();
+      result = stream->SeekAbsolute(0) && stream->Write2(&header, sizeof(header)) && stream->SeekAbsolute(end_position);
+    }
+  }
+
+  if (!result)
+  {
+    Host::ReportFormattedErrorAsync(TRANSLATE("OSDMessage", "Save State"),
+                                    TRANSLATE("OSDMessage", "Saving state to '%s' failed."), filename.c_str());
+    if (stream)
+      stream->Discard();
+    return;
+  }
+
+  stream->Commit();
+
+  const std::string display_name(FileSystem::GetDisplayNameFromPath(filename));
+  Host::AddIconOSDMessage(
+    "save_state", ICON_FA_SAVE,
+    fmt::format(TRANSLATE_FS("OSDMessage", "State saved to '{}'."), Path::GetFileName(display_name)), 5.0f);
+  Log_VerbosePrintf("Writing state took %.2f msec", write_timer.GetTimeMilliseconds());
+}
+
 bool System::SaveState(const char* filename, bool backup_existing_save)
 {
+  // Wait for any earlier write of the same slot to finish before touching the files.
+  WaitForSaveStateWrites();
+
   if (backup_existing_save && FileSystem::FileExists(filename))
   {
     const std::string backup_filename(Path::ReplaceExtension(filename, "bak"));
@@ -1219,43 +1379,43 @@ bool System::SaveState(const char* filename, bool backup_existing_save)
 
   Common::Timer save_timer;
 
-  std::unique_ptr<ByteStream> stream =
-    ByteStream::OpenFile(filename, BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE | BYTESTREAM_OPEN_TRUNCATE |
-                                     BYTESTREAM_OPEN_ATOMIC_UPDATE | BYTESTREAM_OPEN_STREAMED);
-  if (!stream)
-    return false;
-
-  Log_InfoPrintf("Saving state to '%s'...", filename);
-
+  // Serialize the whole state uncompressed into memory on this thread; compression and file I/O
+  // run on a pool worker, so emulation only stalls for the serialization itself.
+  std::shared_ptr<GrowableMemoryByteStream> buffer = ByteStream::CreateGrowableMemoryStream();
   const u32 screenshot_size = 256;
-  const bool result = SaveStateToStream(stream.get(), screenshot_size,
-                                        g_settings.compress_save_states ? SAVE_STATE_HEADER::COMPRESSION_TYPE_ZSTD :
-                                                                          SAVE_STATE_HEADER::COMPRESSION_TYPE_NONE);
-  if (!result)
+  if (!SaveStateToStream(buffer.get(), screenshot_size, SAVE_STATE_HEADER::COMPRESSION_TYPE_NONE))
   {
     Host::ReportFormattedErrorAsync(TRANSLATE("OSDMessage", "Save State"),
                                     TRANSLATE("OSDMessage", "Saving state to '%s' failed."), filename);
-    stream->Discard();
+    return false;
   }
-  else
+
+  Log_InfoPrintf("Saving state to '%s'...", filename);
+  Log_VerbosePrintf("Serializing state took %.2f msec", save_timer.GetTimeMilliseconds());
+
   {
-    const std::string display_name(FileSystem::GetDisplayNameFromPath(filename));
-    Host::AddIconOSDMessage(
-      "save_state", ICON_FA_SAVE,
-      fmt::format(TRANSLATE_FS("OSDMessage", "State saved to '{}'."), Path::GetFileName(display_name)), 5.0f);
-    stream->Commit();
+    std::unique_lock<std::mutex> lock(s_state.save_state_write_mutex);
+    s_state.save_state_writes_pending++;
   }
 
-  Log_VerbosePrintf("Saving state took %.2f msec", save_timer.GetTimeMilliseconds());
-  return result;
+  const bool compress = g_settings.compress_save_states;
+  Threading::ThreadPool::QueueWork([filename_copy = std::string(filename), buffer = std::move(buffer), compress]() {
+    WriteQueuedSaveState(filename_copy, buffer->GetMemoryPointer(), static_cast<u32>(buffer->GetSize()), compress);
+
+    std::unique_lock<std::mutex> lock(s_state.save_state_write_mutex);
+    s_state.save_state_writes_pending--;
+    s_state.save_state_write_cv.notify_all();
+  });
+
+  return true;
 }
 
 bool System::SaveResumeState()
 {
-  if (s_running_game_serial.empty())
+  if (s_state.running_game_serial.empty())
     return false;
 
-  const std::string path(GetGameSaveStateFileName(s_running_game_serial, -1));
+  const std::string path(GetGameSaveStateFileName(s_state.running_game_serial, -1));
   return SaveState(path.c_str(), false);
 }
 
@@ -1274,11 +1434,11 @@ bool System::BootSystem(SystemBootParameters parameters)
   else
     Log_InfoPrintf("Boot Filename: %s", parameters.filename.c_str());
 
-  Assert(s_state == State::Shutdown);
-  s_state = State::Starting;
-  s_startup_cancelled.store(false);
-  s_keep_gpu_device_on_shutdown = static_cast<bool>(g_gpu_device);
-  s_region = g_settings.region;
+  Assert(s_state.state == State::Shutdown);
+  s_state.state = State::Starting;
+  s_state.startup_cancelled.store(false);
+  s_state.keep_gpu_device_on_shutdown = static_cast<bool>(g_gpu_device);
+  s_state.region = g_settings.region;
   Host::OnSystemStarting();
 
   // Load CD image up and detect region.
@@ -1293,17 +1453,20 @@ bool System::BootSystem(SystemBootParameters parameters)
     const bool do_psf_boot = (!do_exe_boot && IsPsfFileName(parameters.filename));
     if (do_exe_boot || do_psf_boot)
     {
-      if (s_region == ConsoleRegion::Auto)
+      if (s_state.region == ConsoleRegion::Auto)
       {
         const DiscRegion file_region =
           (do_exe_boot ? GetRegionForExe(parameters.filename.c_str()) : GetRegionForPsf(parameters.filename.c_str()));
         Log_InfoPrintf("EXE/PSF Region: %s", Settings::GetDiscRegionDisplayName(file_region));
-        s_region = GetConsoleRegionForDiscRegion(file_region);
+        s_state.region = GetConsoleRegionForDiscRegion(file_region);
       }
       if (do_psf_boot)
         psf_boot = std::move(parameters.filename);
       else
         exe_boot = std::move(parameters.filename);
+
+      // Seek snapshotting is only enabled for PSF playback, where execution is deterministic.
+      s_state.psf_playback = do_psf_boot;
     }
     else
     {
@@ -1313,27 +1476,27 @@ bool System::BootSystem(SystemBootParameters parameters)
       {
         Host::ReportErrorAsync("Error", fmt::format("Failed to load CD image '{}': {}",
                                                     Path::GetFileName(parameters.filename), error.GetDescription()));
-        s_state = State::Shutdown;
+        s_state.state = State::Shutdown;
         Host::OnSystemDestroyed();
         Host::OnIdleStateChanged();
         return false;
       }
 
       disc_region = GetRegionForImage(disc.get());
-      if (s_region == ConsoleRegion::Auto)
+      if (s_state.region == ConsoleRegion::Auto)
       {
         if (disc_region != DiscRegion::Other)
         {
-          s_region = GetConsoleRegionForDiscRegion(disc_region);
+          s_state.region = GetConsoleRegionForDiscRegion(disc_region);
           Log_InfoPrintf("Auto-detected console %s region for '%s' (region %s)",
-                         Settings::GetConsoleRegionName(s_region), parameters.filename.c_str(),
+                         Settings::GetConsoleRegionName(s_state.region), parameters.filename.c_str(),
                          Settings::GetDiscRegionName(disc_region));
         }
         else
         {
-          s_region = ConsoleRegion::NTSC_U;
+          s_state.region = ConsoleRegion::NTSC_U;
           Log_WarningPrintf("Could not determine console region for disc region %s. Defaulting to %s.",
-                            Settings::GetDiscRegionName(disc_region), Settings::GetConsoleRegionName(s_region));
+                            Settings::GetDiscRegionName(disc_region), Settings::GetConsoleRegionName(s_state.region));
         }
       }
     }
@@ -1341,11 +1504,11 @@ bool System::BootSystem(SystemBootParameters parameters)
   else
   {
     // Default to NTSC for BIOS boot.
-    if (s_region == ConsoleRegion::Auto)
-      s_region = ConsoleRegion::NTSC_U;
+    if (s_state.region == ConsoleRegion::Auto)
+      s_state.region = ConsoleRegion::NTSC_U;
   }
 
-  Log_InfoPrintf("Console Region: %s", Settings::GetConsoleRegionDisplayName(s_region));
+  Log_InfoPrintf("Console Region: %s", Settings::GetConsoleRegionDisplayName(s_state.region));
 
   // Switch subimage.
   if (disc && parameters.media_playlist_index != 0 && !disc->SwitchSubImage(parameters.media_playlist_index, &error))
@@ -1353,7 +1516,7 @@ bool System::BootSystem(SystemBootParameters parameters)
     Host::ReportErrorAsync("Error",
                            fmt::format("Failed to switch to subimage {} in '{}': {}", parameters.media_playlist_index,
                                        parameters.filename, error.GetDescription()));
-    s_state = State::Shutdown;
+    s_state.state = State::Shutdown;
     Host::OnSystemDestroyed();
     Host::OnIdleStateChanged();
     return false;
@@ -1368,7 +1531,7 @@ bool System::BootSystem(SystemBootParameters parameters)
     {
       Host::ReportFormattedErrorAsync("Error", "File '%s' is not a valid executable to boot.",
                                       parameters.override_exe.c_str());
-      s_state = State::Shutdown;
+      s_state.state = State::Shutdown;
       Host::OnSystemDestroyed();
       Host::OnIdleStateChanged();
       return false;
@@ -1381,7 +1544,7 @@ bool System::BootSystem(SystemBootParameters parameters)
   // Check for SBI.
   if (!CheckForSBIFile(disc.get()))
   {
-    s_state = State::Shutdown;
+    s_state.state = State::Shutdown;
     ClearRunningGame();
     Host::OnSystemDestroyed();
     Host::OnIdleStateChanged();
@@ -1413,7 +1576,7 @@ bool System::BootSystem(SystemBootParameters parameters)
 
     if (cancelled)
     {
-      s_state = State::Shutdown;
+      s_state.state = State::Shutdown;
       ClearRunningGame();
       Host::OnSystemDestroyed();
       Host::OnIdleStateChanged();
@@ -1424,7 +1587,7 @@ bool System::BootSystem(SystemBootParameters parameters)
   // Load BIOS image.
   if (!LoadBIOS(parameters.override_bios))
   {
-    s_state = State::Shutdown;
+    s_state.state = State::Shutdown;
     ClearRunningGame();
     Host::OnSystemDestroyed();
     Host::OnIdleStateChanged();
@@ -1434,7 +1597,7 @@ bool System::BootSystem(SystemBootParameters parameters)
   // Component setup.
   if (!Initialize(parameters.force_software_renderer))
   {
-    s_state = State::Shutdown;
+    s_state.state = State::Shutdown;
     ClearRunningGame();
     Host::OnSystemDestroyed();
     Host::OnIdleStateChanged();
@@ -1468,11 +1631,11 @@ bool System::BootSystem(SystemBootParameters parameters)
   if (CDROM::HasMedia() && (parameters.override_fast_boot.has_value() ? parameters.override_fast_boot.value() :
                                                                         g_settings.bios_patch_fast_boot))
   {
-    if (s_bios_image_info && s_bios_image_info->patch_compatible)
+    if (s_state.bios_image_info && s_state.bios_image_info->patch_compatible)
     {
       // TODO: Fast boot without patches...
       BIOS::PatchBIOSFastBoot(Bus::g_bios, Bus::BIOS_SIZE);
-      s_was_fast_booted = true;
+      s_state.was_fast_booted = true;
     }
     else
     {
@@ -1482,10 +1645,10 @@ bool System::BootSystem(SystemBootParameters parameters)
 
   // Texture replacement preloading.
   // TODO: Move this and everything else below OnSystemStarted().
-  g_texture_replacements.SetGameID(s_running_game_serial);
+  g_texture_replacements.SetGameID(s_state.running_game_serial);
 
   // Good to go.
-  s_state = State::Running;
+  s_state.state = State::Running;
   SPU::GetOutputStream()->SetPaused(false);
 
   FullscreenUI::OnSystemStarted();
@@ -1539,47 +1702,52 @@ bool System::BootSystem(SystemBootParameters parameters)
 bool System::Initialize(bool force_software_renderer)
 {
   g_ticks_per_second = ScaleTicksToOverclock(MASTER_CLOCK);
-  s_max_slice_ticks = ScaleTicksToOverclock(MASTER_CLOCK / 10);
-  s_frame_number = 1;
-  s_internal_frame_number = 1;
-
-  s_target_speed = g_settings.emulation_speed;
-  s_throttle_frequency = 60.0f;
-  s_frame_period = 0;
-  s_next_frame_time = 0;
-  s_turbo_enabled = false;
-  s_fast_forward_enabled = false;
-
-  s_rewind_load_frequency = -1;
-  s_rewind_load_counter = -1;
-  s_rewinding_first_save = true;
-
-  s_average_frame_time_accumulator = 0.0f;
-  s_minimum_frame_time_accumulator = 0.0f;
-  s_maximum_frame_time_accumulator = 0.0f;
-
-  s_vps = 0.0f;
-  s_fps = 0.0f;
-  s_speed = 0.0f;
-  s_minimum_frame_time = 0.0f;
-  s_maximum_frame_time = 0.0f;
-  s_average_frame_time = 0.0f;
-  s_cpu_thread_usage = 0.0f;
-  s_cpu_thread_time = 0.0f;
-  s_sw_thread_usage = 0.0f;
-  s_sw_thread_time = 0.0f;
-  s_average_gpu_time = 0.0f;
-  s_accumulated_gpu_time = 0.0f;
-  s_gpu_usage = 0.0f;
-  s_last_frame_number = 0;
-  s_last_internal_frame_number = 0;
-  s_last_global_tick_counter = 0;
-  s_presents_since_last_update = 0;
-  s_last_cpu_time = 0;
-  s_fps_timer.Reset();
-  s_frame_timer.Reset();
-  s_frame_time_history.fill(0.0f);
-  s_frame_time_history_pos = 0;
+  s_state.max_slice_ticks = ScaleTicksToOverclock(MASTER_CLOCK / 10);
+  s_state.frame_number = 1;
+  s_state.internal_frame_number = 1;
+
+  s_state.target_speed = g_settings.emulation_speed;
+  s_state.throttle_frequency = 60.0f;
+  s_state.frame_period = 0;
+  s_state.next_frame_time = 0;
+  s_state.turbo_enabled = false;
+  s_state.fast_forward_enabled = false;
+
+  s_state.last_present_time = 0;
+  s_state.present_interval_sum = 0;
+  s_state.present_interval_count = 0;
+  s_state.measured_refresh_rate = 0.0f;
+
+  s_state.rewind_load_frequency = -1;
+  s_state.rewind_load_counter = -1;
+  s_state.rewinding_first_save = true;
+
+  s_state.average_frame_time_accumulator = 0.0f;
+  s_state.minimum_frame_time_accumulator = 0.0f;
+  s_state.maximum_frame_time_accumulator = 0.0f;
+
+  s_state.vps = 0.0f;
+  s_state.fps = 0.0f;
+  s_state.speed = 0.0f;
+  s_state.minimum_frame_time = 0.0f;
+  s_state.maximum_frame_time = 0.0f;
+  s_state.average_frame_time = 0.0f;
+  s_state.cpu_thread_usage = 0.0f;
+  s_state.cpu_thread_time = 0.0f;
+  s_state.sw_thread_usage = 0.0f;
+  s_state.sw_thread_time = 0.0f;
+  s_state.average_gpu_time = 0.0f;
+  s_state.accumulated_gpu_time = 0.0f;
+  s_state.gpu_usage = 0.0f;
+  s_state.last_frame_number = 0;
+  s_state.last_internal_frame_number = 0;
+  s_state.last_global_tick_counter = 0;
+  s_state.presents_since_last_update = 0;
+  s_state.last_cpu_time = 0;
+  s_state.fps_timer.Reset();
+  s_state.frame_timer.Reset();
+  s_state.frame_time_history.fill(0.0f);
+  s_state.frame_time_history_pos = 0;
 
   TimingEvents::Initialize();
 
@@ -1609,7 +1777,7 @@ bool System::Initialize(bool force_software_renderer)
   if (IsStartupCancelled())
   {
     g_gpu.reset();
-    if (!s_keep_gpu_device_on_shutdown)
+    if (!s_state.keep_gpu_device_on_shutdown)
     {
       Host::ReleaseGPUDevice();
       Host::ReleaseRenderWindow();
@@ -1631,9 +1799,12 @@ bool System::Initialize(bool force_software_renderer)
   MDEC::Initialize();
   SIO::Initialize();
   PCDrv::Initialize();
+  FrameExport::Initialize();
+  PerfStats::Reset();
   PostProcessing::Initialize();
 
-  s_cpu_thread_handle = Threading::ThreadHandle::GetForCallingThread();
+  s_state.cpu_thread_handle = Threading::ThreadHandle::GetForCallingThread();
+  Threading::SetPerformanceHintForCurrentThread();
 
   UpdateThrottlePeriod();
   UpdateMemorySaveStateSettings();
@@ -1643,8 +1814,8 @@ bool System::Initialize(bool force_software_renderer)
 
 void System::DestroySystem()
 {
-  DebugAssert(!s_system_executing);
-  if (s_state == State::Shutdown)
+  DebugAssert(!s_state.system_executing);
+  if (s_state.state == State::Shutdown)
     return;
 
   Host::ClearOSDMessages();
@@ -1661,12 +1832,16 @@ void System::DestroySystem()
 
   SetTimerResolutionIncreased(false);
 
-  s_cpu_thread_usage = {};
+  s_state.cpu_thread_usage = {};
 
   ClearMemorySaveStates();
+  s_state.psf_playback = false;
+  s_state.psf_seek_replay = false;
 
   g_texture_replacements.Shutdown();
 
+  PerformanceAdvisor::OnSystemShutdown();
+  FrameExport::Shutdown();
   PCDrv::Shutdown();
   SIO::Shutdown();
   MDEC::Shutdown();
@@ -1677,6 +1852,7 @@ void System::DestroySystem()
   g_gpu.reset();
   InterruptController::Shutdown();
   DMA::Shutdown();
+  CPU::Profiler::Shutdown();
   CPU::PGXP::Shutdown();
   CPU::CodeCache::Shutdown();
   Bus::Shutdown();
@@ -1685,7 +1861,7 @@ void System::DestroySystem()
   ClearRunningGame();
 
   // Restore present-all-frames behavior.
-  if (s_keep_gpu_device_on_shutdown && g_gpu_device)
+  if (s_state.keep_gpu_device_on_shutdown && g_gpu_device)
   {
     g_gpu_device->SetDisplayMaxFPS(0.0f);
   }
@@ -1695,12 +1871,12 @@ void System::DestroySystem()
     Host::ReleaseRenderWindow();
   }
 
-  s_bios_hash = {};
-  s_bios_image_info = nullptr;
-  s_was_fast_booted = false;
-  s_cheat_list.reset();
+  s_state.bios_hash = {};
+  s_state.bios_image_info = nullptr;
+  s_state.was_fast_booted = false;
+  s_state.cheat_list.reset();
 
-  s_state = State::Shutdown;
+  s_state.state = State::Shutdown;
 
   Host::OnSystemDestroyed();
   Host::OnIdleStateChanged();
@@ -1708,17 +1884,17 @@ void System::DestroySystem()
 
 void System::ClearRunningGame()
 {
-  UpdateSessionTime(s_running_game_serial);
+  UpdateSessionTime(s_state.running_game_serial);
 
-  s_running_game_serial.clear();
-  s_running_game_path.clear();
-  s_running_game_title.clear();
-  s_running_game_entry = nullptr;
-  s_running_game_hash = 0;
+  s_state.running_game_serial.clear();
+  s_state.running_game_path.clear();
+  s_state.running_game_title.clear();
+  s_state.running_game_entry = nullptr;
+  s_state.running_game_hash = 0;
 
-  Host::OnGameChanged(s_running_game_path, s_running_game_serial, s_running_game_title);
+  Host::OnGameChanged(s_state.running_game_path, s_state.running_game_serial, s_state.running_game_title);
 
-  Achievements::GameChanged(s_running_game_path, nullptr);
+  Achievements::GameChanged(s_state.running_game_path, nullptr);
 
 #ifdef ENABLE_DISCORD_PRESENCE
   UpdateDiscordPresence(true);
@@ -1729,41 +1905,43 @@ bool System::FastForwardToFirstFrame()
 {
   // If we're taking more than 60 seconds to load the game, oof..
   static constexpr u32 MAX_FRAMES_TO_SKIP = 30 * 60;
-  const u32 current_frame_number = s_frame_number;
-  const u32 current_internal_frame_number = s_internal_frame_number;
+  const u32 current_frame_number = s_state.frame_number;
+  const u32 current_internal_frame_number = s_state.internal_frame_number;
 
   SPU::SetAudioOutputMuted(true);
-  while (s_internal_frame_number == current_internal_frame_number &&
-         (s_frame_number - current_frame_number) <= MAX_FRAMES_TO_SKIP)
+  while (s_state.internal_frame_number == current_internal_frame_number &&
+         (s_state.frame_number - current_frame_number) <= MAX_FRAMES_TO_SKIP)
   {
     Panic("Fixme");
     // System::RunFrame();
   }
   SPU::SetAudioOutputMuted(false);
 
-  return (s_internal_frame_number != current_internal_frame_number);
+  return (s_state.internal_frame_number != current_internal_frame_number);
 }
 
 void System::Execute()
 {
+  PerfTrace::RegisterCurrentThread("CPUThread");
+
   for (;;)
   {
-    switch (s_state)
+    switch (s_state.state)
     {
       case State::Running:
       {
-        s_system_executing = true;
+        s_state.system_executing = true;
 
         // TODO: Purge reset/restore
         g_gpu->RestoreDeviceContext();
         TimingEvents::UpdateCPUDowncount();
 
-        if (s_rewind_load_counter >= 0)
+        if (s_state.rewind_load_counter >= 0)
           DoRewind();
         else
           CPU::Execute();
 
-        s_system_executing = false;
+        s_state.system_executing = false;
         continue;
       }
 
@@ -1782,17 +1960,40 @@ void System::Execute()
 
 void System::FrameDone()
 {
-  s_frame_number++;
+  s_state.frame_number++;
+
+  // The frame timer hasn't been reset yet, so this is the emulation portion of the frame, without
+  // whatever presentation and throttling add below.
+  PerfStats::AddSample(PerfStats::Metric::EmuSlice, static_cast<float>(s_state.frame_timer.GetTimeMilliseconds()));
+
+  if (PerfTrace::IsCapturing())
+    PerfTrace::AddCounter("Frame", static_cast<double>(s_state.frame_number));
+
+  // Pick up any blocks the async compiler thread finished during the frame.
+  CPU::CodeCache::ProcessPendingCompilations();
 
   // Vertex buffer is shared, need to flush what we have.
-  g_gpu->FlushRender();
+  {
+    PerfTrace::Scope flush_scope("GPU::FlushRender");
+    g_gpu->FlushRender();
+  }
 
   // Generate any pending samples from the SPU before sleeping, this way we reduce the chances of underruns.
   // TODO: when running ahead, we can skip this (and the flush above)
-  SPU::GeneratePendingSamples();
+  {
+    PerfTrace::Scope spu_scope("SPU::GeneratePendingSamples");
+    SPU::GeneratePendingSamples();
+  }
 
-  if (s_cheat_list)
-    s_cheat_list->Apply();
+  // Sampled after generating, so the histogram reflects how close each frame came to underrunning.
+  if (AudioStream* stream = SPU::GetOutputStream(); stream && stream->GetBufferSize() > 0)
+  {
+    PerfStats::AddSample(PerfStats::Metric::AudioFill, static_cast<float>(stream->GetBufferedFramesRelaxed()) * 100.0f /
+                                                         static_cast<float>(stream->GetBufferSize()));
+  }
+
+  if (s_state.cheat_list)
+    s_state.cheat_list->Apply();
 
   if (Achievements::IsActive())
     Achievements::FrameUpdate();
@@ -1801,29 +2002,62 @@ void System::FrameDone()
   PollDiscordPresence();
 #endif
 
-  if (s_frame_step_request)
+  if (s_state.frame_step_request)
   {
-    s_frame_step_request = false;
+    s_state.frame_step_request = false;
     PauseSystem(true);
   }
 
+  // Periodic snapshots for PSF seeking, and fast-forwarding to a seek target. Catch-up frames run
+  // with audio muted and without throttling or presentation, the same as a runahead replay.
+  if (s_state.psf_seek_save_counter >= 0)
+  {
+    if (s_state.psf_seek_save_counter == 0)
+    {
+      SavePsfSeekState();
+      s_state.psf_seek_save_counter = s_state.psf_seek_save_frequency;
+    }
+    else
+    {
+      s_state.psf_seek_save_counter--;
+    }
+  }
+  if (s_state.psf_seek_replay)
+  {
+    if (s_state.frame_number < s_state.psf_seek_target_frame)
+    {
+      // Keep pumping messages so the host stays responsive during long seeks.
+      Host::PumpMessagesOnCPUThread();
+      if (IsExecutionInterrupted())
+      {
+        s_state.system_interrupted = false;
+        CPU::ExitExecution();
+      }
+
+      return;
+    }
+
+    s_state.psf_seek_replay = false;
+    SPU::SetAudioOutputMuted(false);
+  }
+
   // Save states for rewind and runahead.
-  if (s_rewind_save_counter >= 0)
+  if (s_state.rewind_save_counter >= 0)
   {
-    if (s_rewind_save_counter == 0)
+    if (s_state.rewind_save_counter == 0)
     {
       SaveRewindState();
-      s_rewind_save_counter = s_rewind_save_frequency;
+      s_state.rewind_save_counter = s_state.rewind_save_frequency;
     }
     else
     {
-      s_rewind_save_counter--;
+      s_state.rewind_save_counter--;
     }
   }
-  else if (s_runahead_frames > 0)
+  else if (s_state.runahead_frames > 0)
   {
     // We don't want to poll during replay, because otherwise we'll lose frames.
-    if (s_runahead_replay_frames == 0)
+    if (s_state.runahead_replay_frames == 0)
     {
       // For runahead, poll input early, that way we can use the remainder of this frame to replay.
       // *technically* this means higher input latency (by less than a frame), but runahead itself
@@ -1834,7 +2068,7 @@ void System::FrameDone()
 
       if (IsExecutionInterrupted())
       {
-        s_system_interrupted = false;
+        s_state.system_interrupted = false;
         CPU::ExitExecution();
         return;
       }
@@ -1851,33 +2085,34 @@ void System::FrameDone()
 
   // TODO: Kick cmdbuffer early
   const DisplaySyncMode sync_mode = g_gpu_device->GetSyncMode();
-  const bool throttle_after_present = (sync_mode == DisplaySyncMode::Disabled);
-  if (!throttle_after_present && s_throttler_enabled && !IsExecutionInterrupted())
+  const bool throttle_after_present =
+    (sync_mode == DisplaySyncMode::Disabled || sync_mode == DisplaySyncMode::Mailbox);
+  if (!throttle_after_present && s_state.throttler_enabled && !IsExecutionInterrupted())
     Throttle();
 
   const Common::Timer::Value current_time = Common::Timer::GetCurrentValue();
-  if (current_time < s_next_frame_time || s_display_all_frames || s_last_frame_skipped)
+  if (current_time < s_state.next_frame_time || s_state.display_all_frames || s_state.last_frame_skipped)
   {
-    s_last_frame_skipped = !PresentDisplay(true);
+    s_state.last_frame_skipped = !PresentDisplay(true);
   }
-  else if (current_time >= s_next_frame_time)
+  else if (current_time >= s_state.next_frame_time)
   {
     Log_DebugPrintf("Skipping displaying frame");
-    s_last_frame_skipped = true;
+    s_state.last_frame_skipped = true;
   }
 
-  if (throttle_after_present && s_throttler_enabled && !IsExecutionInterrupted())
+  if (throttle_after_present && s_state.throttler_enabled && !IsExecutionInterrupted())
     Throttle();
 
   // Input poll already done above
-  if (s_runahead_frames == 0)
+  if (s_state.runahead_frames == 0)
   {
     Host::PumpMessagesOnCPUThread();
     InputManager::PollSources();
 
     if (IsExecutionInterrupted())
     {
-      s_system_interrupted = false;
+      s_state.system_interrupted = false;
       CPU::ExitExecution();
       return;
     }
@@ -1893,24 +2128,24 @@ void System::FrameDone()
 
 void System::SetThrottleFrequency(float frequency)
 {
-  if (s_throttle_frequency == frequency)
+  if (s_state.throttle_frequency == frequency)
     return;
 
-  s_throttle_frequency = frequency;
+  s_state.throttle_frequency = frequency;
   UpdateThrottlePeriod();
 }
 
 void System::UpdateThrottlePeriod()
 {
-  if (s_target_speed > std::numeric_limits<double>::epsilon())
+  if (s_state.target_speed > std::numeric_limits<double>::epsilon())
   {
-    const double target_speed = std::max(static_cast<double>(s_target_speed), std::numeric_limits<double>::epsilon());
-    s_frame_period =
-      Common::Timer::ConvertSecondsToValue(1.0 / (static_cast<double>(s_throttle_frequency) * target_speed));
+    const double target_speed = std::max(static_cast<double>(s_state.target_speed), std::numeric_limits<double>::epsilon());
+    s_state.frame_period =
+      Common::Timer::ConvertSecondsToValue(1.0 / (static_cast<double>(s_state.throttle_frequency) * target_speed));
   }
   else
   {
-    s_frame_period = 1;
+    s_state.frame_period = 1;
   }
 
   ResetThrottler();
@@ -1918,7 +2153,7 @@ void System::UpdateThrottlePeriod()
 
 void System::ResetThrottler()
 {
-  s_next_frame_time = Common::Timer::GetCurrentValue() + s_frame_period;
+  s_state.next_frame_time = Common::Timer::GetCurrentValue() + s_state.frame_period;
 }
 
 void System::Throttle()
@@ -1927,29 +2162,74 @@ void System::Throttle()
   // running those frames at the intended time, because otherwise if we pause in the debugger, we'll run
   // hundreds of frames when we resume.
   Common::Timer::Value current_time = Common::Timer::GetCurrentValue();
-  if (current_time > s_next_frame_time)
+  if (current_time > s_state.next_frame_time)
   {
-    const Common::Timer::Value diff = static_cast<s64>(current_time) - static_cast<s64>(s_next_frame_time);
-    s_next_frame_time += (diff / s_frame_period) * s_frame_period + s_frame_period;
+    const Common::Timer::Value diff = static_cast<s64>(current_time) - static_cast<s64>(s_state.next_frame_time);
+    s_state.next_frame_time += (diff / s_state.frame_period) * s_state.frame_period + s_state.frame_period;
     return;
   }
 
-  // Use a spinwait if we undersleep for all platforms except android.. don't want to burn battery.
-  // Linux also seems to do a much better job of waking up at the requested time.
-#if !defined(__linux__) && !defined(__ANDROID__)
-  Common::Timer::SleepUntil(s_next_frame_time, g_settings.display_all_frames);
+  // Sleep until just before the deadline, then pause-spin off the remainder. The spin window is
+  // short (and uses pause hints), so this stays cheap on handhelds while removing the jitter from
+  // late scheduler wakeups. Android keeps the plain sleep, we don't want to burn battery there.
+#if !defined(__ANDROID__)
+  Common::Timer::SleepUntil(s_state.next_frame_time, true);
 #else
-  Common::Timer::SleepUntil(s_next_frame_time, false);
+  Common::Timer::SleepUntil(s_state.next_frame_time, false);
 #endif
 
 #if 0
   Log_DevPrintf("Asked for %.2f ms, slept for %.2f ms, %.2f ms late",
-                Common::Timer::ConvertValueToMilliseconds(s_next_frame_time - current_time),
+                Common::Timer::ConvertValueToMilliseconds(s_state.next_frame_time - current_time),
                 Common::Timer::ConvertValueToMilliseconds(Common::Timer::GetCurrentValue() - current_time),
-                Common::Timer::ConvertValueToMilliseconds(Common::Timer::GetCurrentValue() - s_next_frame_time));
+                Common::Timer::ConvertValueToMilliseconds(Common::Timer::GetCurrentValue() - s_state.next_frame_time));
 #endif
 
-  s_next_frame_time += s_frame_period;
+  s_state.next_frame_time += s_state.frame_period;
+}
+
+void System::AccumulatePresentTiming(Common::Timer::Value now)
+{
+  // Intervals are only meaningful when presents are actually gated by the display.
+  const DisplaySyncMode sync_mode = GetEffectiveDisplaySyncMode();
+  if (sync_mode != DisplaySyncMode::VSync && sync_mode != DisplaySyncMode::VSyncRelaxed)
+  {
+    s_state.last_present_time = 0;
+    s_state.present_interval_sum = 0;
+    s_state.present_interval_count = 0;
+    return;
+  }
+
+  const Common::Timer::Value last = std::exchange(s_state.last_present_time, now);
+  if (last == 0 || now <= last)
+    return;
+
+  // Toss implausible intervals - dropped frames, compositor stalls, debugger pauses.
+  const double seconds = Common::Timer::ConvertValueToSeconds(now - last);
+  if (seconds < (1.0 / 500.0) || seconds > (1.0 / 30.0))
+    return;
+
+  s_state.present_interval_sum += (now - last);
+
+  // ~2 seconds worth of samples at 60Hz before we trust the average.
+  constexpr u32 REFRESH_MEASUREMENT_SAMPLES = 120;
+  if (++s_state.present_interval_count < REFRESH_MEASUREMENT_SAMPLES)
+    return;
+
+  const float measured = static_cast<float>(static_cast<double>(s_state.present_interval_count) /
+                                            Common::Timer::ConvertValueToSeconds(s_state.present_interval_sum));
+  s_state.present_interval_sum = 0;
+  s_state.present_interval_count = 0;
+
+  const float previous = std::exchange(s_state.measured_refresh_rate, measured);
+
+  // Re-derive the sync-to-host ratio when the measurement moves by more than 0.05%. The
+  // hysteresis stops us from re-running the speed limiter update on normal jitter.
+  if (g_settings.sync_to_host_refresh_rate && (std::abs(measured - previous) / measured) > 0.0005f)
+  {
+    Log_VerbosePrintf("Measured display refresh rate: %.3fhz (reported rate was %.3fhz)", measured, previous);
+    UpdateSpeedLimiterState();
+  }
 }
 
 void System::SingleStepCPU()
@@ -1963,7 +2243,7 @@ void System::SingleStepCPU()
 
 void System::IncrementInternalFrameNumber()
 {
-  s_internal_frame_number++;
+  s_state.internal_frame_number++;
 }
 
 void System::RecreateSystem()
@@ -2043,7 +2323,7 @@ bool System::CreateGPU(GPURenderer renderer, bool is_switching)
     if (!g_gpu)
     {
       Log_ErrorPrintf("Failed to create fallback software renderer.");
-      if (!s_keep_gpu_device_on_shutdown)
+      if (!s_state.keep_gpu_device_on_shutdown)
       {
         Host::ReleaseGPUDevice();
         Host::ReleaseRenderWindow();
@@ -2055,23 +2335,24 @@ bool System::CreateGPU(GPURenderer renderer, bool is_switching)
   return true;
 }
 
-bool System::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_display, bool is_memory_state)
+bool System::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_display, bool is_memory_state,
+                     bool skip_ram)
 {
   if (!sw.DoMarker("System"))
     return false;
 
-  sw.Do(&s_region);
-  sw.Do(&s_frame_number);
-  sw.Do(&s_internal_frame_number);
+  sw.Do(&s_state.region);
+  sw.Do(&s_state.frame_number);
+  sw.Do(&s_state.internal_frame_number);
 
   // Don't bother checking this at all for memory states, since they won't have a different BIOS...
   if (!is_memory_state)
   {
-    BIOS::Hash bios_hash = s_bios_hash;
-    sw.DoBytesEx(bios_hash.bytes, sizeof(bios_hash.bytes), 58, s_bios_hash.bytes);
-    if (bios_hash != s_bios_hash)
+    BIOS::Hash bios_hash = s_state.bios_hash;
+    sw.DoBytesEx(bios_hash.bytes, sizeof(bios_hash.bytes), 58, s_state.bios_hash.bytes);
+    if (bios_hash != s_state.bios_hash)
     {
-      Log_WarningPrintf("BIOS hash mismatch: System: %s | State: %s", s_bios_hash.ToString().c_str(),
+      Log_WarningPrintf("BIOS hash mismatch: System: %s | State: %s", s_state.bios_hash.ToString().c_str(),
                         bios_hash.ToString().c_str());
       Host::AddKeyedOSDMessage("StateBIOSMismatch",
                                TRANSLATE_STR("OSDMessage",
@@ -2097,7 +2378,7 @@ bool System::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_di
   if (sw.IsReading() && g_settings.gpu_pgxp_enable && !is_memory_state)
     CPU::PGXP::Reset();
 
-  if (!sw.DoMarker("Bus") || !Bus::DoState(sw))
+  if (!sw.DoMarker("Bus") || !Bus::DoState(sw, skip_ram))
     return false;
 
   if (!sw.DoMarker("DMA") || !DMA::DoState(sw))
@@ -2177,11 +2458,11 @@ bool System::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_di
 bool System::LoadBIOS(const std::string& override_bios_path)
 {
   std::optional<BIOS::Image> bios_image(
-    override_bios_path.empty() ? BIOS::GetBIOSImage(s_region) : FileSystem::ReadBinaryFile(override_bios_path.c_str()));
+    override_bios_path.empty() ? BIOS::GetBIOSImage(s_state.region) : FileSystem::ReadBinaryFile(override_bios_path.c_str()));
   if (!bios_image.has_value())
   {
     Host::ReportFormattedErrorAsync("Error", TRANSLATE("System", "Failed to load %s BIOS."),
-                                    Settings::GetConsoleRegionName(s_region));
+                                    Settings::GetConsoleRegionName(s_state.region));
     return false;
   }
 
@@ -2191,12 +2472,12 @@ bool System::LoadBIOS(const std::string& override_bios_path)
     return false;
   }
 
-  s_bios_hash = BIOS::GetImageHash(bios_image.value());
-  s_bios_image_info = BIOS::GetInfoForImage(bios_image.value(), s_bios_hash);
-  if (s_bios_image_info)
-    Log_InfoPrintf("Using BIOS: %s", s_bios_image_info->description);
+  s_state.bios_hash = BIOS::GetImageHash(bios_image.value());
+  s_state.bios_image_info = BIOS::GetInfoForImage(bios_image.value(), s_state.bios_hash);
+  if (s_state.bios_image_info)
+    Log_InfoPrintf("Using BIOS: %s", s_state.bios_image_info->description);
   else
-    Log_WarningPrintf("Using an unknown BIOS: %s", s_bios_hash.ToString().c_str());
+    Log_WarningPrintf("Using an unknown BIOS: %s", s_state.bios_hash.ToString().c_str());
 
   std::memcpy(Bus::g_bios, bios_image->data(), Bus::BIOS_SIZE);
   return true;
@@ -2223,8 +2504,8 @@ void System::InternalReset()
   MDEC::Reset();
   SIO::Reset();
   PCDrv::Reset();
-  s_frame_number = 1;
-  s_internal_frame_number = 0;
+  s_state.frame_number = 1;
+  s_state.internal_frame_number = 0;
   TimingEvents::Reset();
   ResetPerformanceCounters();
 
@@ -2233,6 +2514,8 @@ void System::InternalReset()
 
 std::string System::GetMediaPathFromSaveState(const char* path)
 {
+  WaitForSaveStateWrites();
+
   std::string ret;
 
   std::unique_ptr<ByteStream> stream(ByteStream::OpenFile(path, BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_SEEKABLE));
@@ -2398,8 +2681,8 @@ bool System::LoadStateFromStream(ByteStream* state, bool update_display, bool ig
     return false;
   }
 
-  if (s_state == State::Starting)
-    s_state = State::Running;
+  if (s_state.state == State::Starting)
+    s_state.state = State::Running;
 
   ResetPerformanceCounters();
   ResetThrottler();
@@ -2413,6 +2696,8 @@ bool System::SaveStateToStream(ByteStream* state, u32 screenshot_size /* = 256 *
   if (IsShutdown())
     return false;
 
+  PerfStats::StallScope stall_scope(PerfStats::StallSource::SaveState);
+
   SAVE_STATE_HEADER header = {};
 
   const u64 header_position = state->GetPosition();
@@ -2422,8 +2707,8 @@ bool System::SaveStateToStream(ByteStream* state, u32 screenshot_size /* = 256 *
   // fill in header
   header.magic = SAVE_STATE_MAGIC;
   header.version = SAVE_STATE_VERSION;
-  StringUtil::Strlcpy(header.title, s_running_game_title.c_str(), sizeof(header.title));
-  StringUtil::Strlcpy(header.serial, s_running_game_serial.c_str(), sizeof(header.serial));
+  StringUtil::Strlcpy(header.title, s_state.running_game_title.c_str(), sizeof(header.title));
+  StringUtil::Strlcpy(header.serial, s_state.running_game_serial.c_str(), sizeof(header.serial));
 
   if (CDROM::HasMedia() && !ignore_media)
   {
@@ -2524,27 +2809,28 @@ bool System::SaveStateToStream(ByteStream* state, u32 screenshot_size /* = 256 *
 
 float System::GetTargetSpeed()
 {
-  return s_target_speed;
+  return s_state.target_speed;
 }
 
 void System::UpdatePerformanceCounters()
 {
-  const float frame_time = static_cast<float>(s_frame_timer.GetTimeMillisecondsAndReset());
-  s_minimum_frame_time_accumulator =
-    (s_minimum_frame_time_accumulator == 0.0f) ? frame_time : std::min(s_minimum_frame_time_accumulator, frame_time);
-  s_average_frame_time_accumulator += frame_time;
-  s_maximum_frame_time_accumulator = std::max(s_maximum_frame_time_accumulator, frame_time);
-  s_frame_time_history[s_frame_time_history_pos] = frame_time;
-  s_frame_time_history_pos = (s_frame_time_history_pos + 1) % NUM_FRAME_TIME_SAMPLES;
+  const float frame_time = static_cast<float>(s_state.frame_timer.GetTimeMillisecondsAndReset());
+  PerfStats::AddSample(PerfStats::Metric::FrameTime, frame_time);
+  s_state.minimum_frame_time_accumulator =
+    (s_state.minimum_frame_time_accumulator == 0.0f) ? frame_time : std::min(s_state.minimum_frame_time_accumulator, frame_time);
+  s_state.average_frame_time_accumulator += frame_time;
+  s_state.maximum_frame_time_accumulator = std::max(s_state.maximum_frame_time_accumulator, frame_time);
+  s_state.frame_time_history[s_state.frame_time_history_pos] = frame_time;
+  s_state.frame_time_history_pos = (s_state.frame_time_history_pos + 1) % NUM_FRAME_TIME_SAMPLES;
 
   // update fps counter
   const Common::Timer::Value now_ticks = Common::Timer::GetCurrentValue();
-  const Common::Timer::Value ticks_diff = now_ticks - s_fps_timer.GetStartValue();
+  const Common::Timer::Value ticks_diff = now_ticks - s_state.fps_timer.GetStartValue();
   const float time = static_cast<float>(Common::Timer::ConvertValueToSeconds(ticks_diff));
   if (time < PERFORMANCE_COUNTER_UPDATE_INTERVAL)
     return;
 
-  const u32 frames_run = s_frame_number - s_last_frame_number;
+  const u32 frames_run = s_state.frame_number - s_state.last_frame_number;
   const float frames_runf = static_cast<float>(frames_run);
   const u32 global_tick_counter = TimingEvents::GetGlobalTickCounter();
 
@@ -2555,107 +2841,131 @@ void System::UpdatePerformanceCounters()
   const double time_divider = 1000.0 * (1.0 / static_cast<double>(Threading::GetThreadTicksPerSecond())) *
                               (1.0 / static_cast<double>(frames_runf));
 
-  s_minimum_frame_time = std::exchange(s_minimum_frame_time_accumulator, 0.0f);
-  s_average_frame_time = std::exchange(s_average_frame_time_accumulator, 0.0f) / frames_runf;
-  s_maximum_frame_time = std::exchange(s_maximum_frame_time_accumulator, 0.0f);
+  s_state.minimum_frame_time = std::exchange(s_state.minimum_frame_time_accumulator, 0.0f);
+  s_state.average_frame_time = std::exchange(s_state.average_frame_time_accumulator, 0.0f) / frames_runf;
+  s_state.maximum_frame_time = std::exchange(s_state.maximum_frame_time_accumulator, 0.0f);
 
-  s_vps = static_cast<float>(frames_runf / time);
-  s_last_frame_number = s_frame_number;
-  s_fps = static_cast<float>(s_internal_frame_number - s_last_internal_frame_number) / time;
-  s_last_internal_frame_number = s_internal_frame_number;
-  s_speed = static_cast<float>(static_cast<double>(global_tick_counter - s_last_global_tick_counter) /
+  s_state.vps = static_cast<float>(frames_runf / time);
+  s_state.last_frame_number = s_state.frame_number;
+  s_state.fps = static_cast<float>(s_state.internal_frame_number - s_state.last_internal_frame_number) / time;
+  s_state.last_internal_frame_number = s_state.internal_frame_number;
+  s_state.speed = static_cast<float>(static_cast<double>(global_tick_counter - s_state.last_global_tick_counter) /
                                (static_cast<double>(g_ticks_per_second) * time)) *
             100.0f;
-  s_last_global_tick_counter = global_tick_counter;
+  s_state.last_global_tick_counter = global_tick_counter;
 
   const Threading::Thread* sw_thread = g_gpu->GetSWThread();
-  const u64 cpu_time = s_cpu_thread_handle ? s_cpu_thread_handle.GetCPUTime() : 0;
+  const u64 cpu_time = s_state.cpu_thread_handle ? s_state.cpu_thread_handle.GetCPUTime() : 0;
   const u64 sw_time = sw_thread ? sw_thread->GetCPUTime() : 0;
-  const u64 cpu_delta = cpu_time - s_last_cpu_time;
-  const u64 sw_delta = sw_time - s_last_sw_time;
-  s_last_cpu_time = cpu_time;
-  s_last_sw_time = sw_time;
+  const u64 cpu_delta = cpu_time - s_state.last_cpu_time;
+  const u64 sw_delta = sw_time - s_state.last_sw_time;
+  s_state.last_cpu_time = cpu_time;
+  s_state.last_sw_time = sw_time;
 
-  s_cpu_thread_usage = static_cast<float>(static_cast<double>(cpu_delta) * pct_divider);
-  s_cpu_thread_time = static_cast<float>(static_cast<double>(cpu_delta) * time_divider);
-  s_sw_thread_usage = static_cast<float>(static_cast<double>(sw_delta) * pct_divider);
-  s_sw_thread_time = static_cast<float>(static_cast<double>(sw_delta) * time_divider);
+  s_state.cpu_thread_usage = static_cast<float>(static_cast<double>(cpu_delta) * pct_divider);
+  s_state.cpu_thread_time = static_cast<float>(static_cast<double>(cpu_delta) * time_divider);
+  s_state.sw_thread_usage = static_cast<float>(static_cast<double>(sw_delta) * pct_divider);
+  s_state.sw_thread_time = static_cast<float>(static_cast<double>(sw_delta) * time_divider);
 
-  s_fps_timer.ResetTo(now_ticks);
+  s_state.fps_timer.ResetTo(now_ticks);
 
   if (g_gpu_device->IsGPUTimingEnabled())
   {
-    s_average_gpu_time = s_accumulated_gpu_time / static_cast<float>(std::max(s_presents_since_last_update, 1u));
-    s_gpu_usage = s_accumulated_gpu_time / (time * 10.0f);
+    s_state.average_gpu_time = s_state.accumulated_gpu_time / static_cast<float>(std::max(s_state.presents_since_last_update, 1u));
+    s_state.gpu_usage = s_state.accumulated_gpu_time / (time * 10.0f);
+
+    if (s_state.presents_since_last_update > 0)
+      g_gpu->UpdateDynamicResolutionScale(s_state.average_gpu_time);
+  }
+  s_state.accumulated_gpu_time = 0.0f;
+  s_state.presents_since_last_update = 0;
+
+  if (PerfTrace::IsCapturing())
+  {
+    PerfTrace::AddCounter("VPS", s_state.vps);
+    PerfTrace::AddCounter("AverageFrameTimeMS", s_state.average_frame_time);
+    if (g_gpu_device->IsGPUTimingEnabled())
+      PerfTrace::AddCounter("GPUTimeMS", s_state.average_gpu_time);
   }
-  s_accumulated_gpu_time = 0.0f;
-  s_presents_since_last_update = 0;
 
   if (g_settings.display_show_gpu_stats)
     g_gpu->UpdateStatistics(frames_run);
 
-  Log_VerbosePrintf("FPS: %.2f VPS: %.2f CPU: %.2f GPU: %.2f Average: %.2fms Min: %.2fms Max: %.2f ms", s_fps, s_vps,
-                    s_cpu_thread_usage, s_gpu_usage, s_average_frame_time, s_minimum_frame_time, s_maximum_frame_time);
+  PerformanceAdvisor::AddSample();
+
+  Log_VerbosePrintf("FPS: %.2f VPS: %.2f CPU: %.2f GPU: %.2f Average: %.2fms Min: %.2fms Max: %.2f ms", s_state.fps, s_state.vps,
+                    s_state.cpu_thread_usage, s_state.gpu_usage, s_state.average_frame_time, s_state.minimum_frame_time, s_state.maximum_frame_time);
 
   Host::OnPerformanceCountersUpdated();
 }
 
 void System::ResetPerformanceCounters()
 {
-  s_last_frame_number = s_frame_number;
-  s_last_internal_frame_number = s_internal_frame_number;
-  s_last_global_tick_counter = TimingEvents::GetGlobalTickCounter();
-  s_last_cpu_time = s_cpu_thread_handle ? s_cpu_thread_handle.GetCPUTime() : 0;
+  s_state.last_frame_number = s_state.frame_number;
+  s_state.last_internal_frame_number = s_state.internal_frame_number;
+  s_state.last_global_tick_counter = TimingEvents::GetGlobalTickCounter();
+  s_state.last_cpu_time = s_state.cpu_thread_handle ? s_state.cpu_thread_handle.GetCPUTime() : 0;
   if (const Threading::Thread* sw_thread = g_gpu->GetSWThread(); sw_thread)
-    s_last_sw_time = sw_thread->GetCPUTime();
+    s_state.last_sw_time = sw_thread->GetCPUTime();
   else
-    s_last_sw_time = 0;
+    s_state.last_sw_time = 0;
 
-  s_average_frame_time_accumulator = 0.0f;
-  s_minimum_frame_time_accumulator = 0.0f;
-  s_maximum_frame_time_accumulator = 0.0f;
-  s_frame_timer.Reset();
-  s_fps_timer.Reset();
+  s_state.average_frame_time_accumulator = 0.0f;
+  s_state.minimum_frame_time_accumulator = 0.0f;
+  s_state.maximum_frame_time_accumulator = 0.0f;
+  s_state.frame_timer.Reset();
+  s_state.fps_timer.Reset();
   ResetThrottler();
 }
 
 void System::UpdateSpeedLimiterState()
 {
-  const float old_target_speed = s_target_speed;
-  s_target_speed = s_turbo_enabled ?
+  const float old_target_speed = s_state.target_speed;
+  s_state.target_speed = s_state.turbo_enabled ?
                      g_settings.turbo_speed :
-                     (s_fast_forward_enabled ? g_settings.fast_forward_speed : g_settings.emulation_speed);
-  s_throttler_enabled = (s_target_speed != 0.0f);
-  s_display_all_frames = !s_throttler_enabled || g_settings.display_all_frames;
+                     (s_state.fast_forward_enabled ? g_settings.fast_forward_speed : g_settings.emulation_speed);
+  s_state.throttler_enabled = (s_state.target_speed != 0.0f);
+  s_state.display_all_frames = !s_state.throttler_enabled || g_settings.display_all_frames;
 
-  s_syncing_to_host = false;
+  s_state.syncing_to_host = false;
   if (g_settings.sync_to_host_refresh_rate && (g_settings.audio_stretch_mode != AudioStretchMode::Off) &&
-      s_target_speed == 1.0f && IsValid())
+      s_state.target_speed == 1.0f && IsValid())
   {
-    float host_refresh_rate;
-    if (g_gpu_device->GetHostRefreshRate(&host_refresh_rate))
+    if (GetEffectiveDisplaySyncMode() == DisplaySyncMode::VRR)
     {
-      const float ratio = host_refresh_rate / System::GetThrottleFrequency();
-      s_syncing_to_host = (ratio >= 0.95f && ratio <= 1.05f);
-      Log_InfoPrintf("Refresh rate: Host=%fhz Guest=%fhz Ratio=%f - %s", host_refresh_rate,
-                     System::GetThrottleFrequency(), ratio, s_syncing_to_host ? "can sync" : "can't sync");
-      if (s_syncing_to_host)
-        s_target_speed *= ratio;
+      // VRR passthrough: the display follows whatever rate we present at, so there's no need to
+      // bend the emulation speed towards it. Pace at the native rate and let it track us.
+      Log_InfoPrintf("VRR display, presenting at native rate.");
+    }
+    else
+    {
+      // Prefer the rate measured from present timestamps over what the driver reports - the
+      // reported value is usually rounded (59.94Hz panels claim a flat 60).
+      float host_refresh_rate = s_state.measured_refresh_rate;
+      if (host_refresh_rate > 0.0f || g_gpu_device->GetHostRefreshRate(&host_refresh_rate))
+      {
+        const float ratio = host_refresh_rate / System::GetThrottleFrequency();
+        s_state.syncing_to_host = (ratio >= 0.95f && ratio <= 1.05f);
+        Log_InfoPrintf("Refresh rate: Host=%fhz Guest=%fhz Ratio=%f - %s", host_refresh_rate,
+                       System::GetThrottleFrequency(), ratio, s_state.syncing_to_host ? "can sync" : "can't sync");
+        if (s_state.syncing_to_host)
+          s_state.target_speed *= ratio;
+      }
     }
   }
 
   // When syncing to host and using vsync, we don't need to sleep.
-  if (s_syncing_to_host && s_display_all_frames)
+  if (s_state.syncing_to_host && s_state.display_all_frames)
   {
     const DisplaySyncMode effective_sync_mode = GetEffectiveDisplaySyncMode();
     if (effective_sync_mode == DisplaySyncMode::VSync || effective_sync_mode == DisplaySyncMode::VSyncRelaxed)
     {
       Log_InfoPrintf("Using host vsync for throttling.");
-      s_throttler_enabled = false;
+      s_state.throttler_enabled = false;
     }
   }
 
-  Log_VerbosePrintf("Target speed: %f%%", s_target_speed * 100.0f);
+  Log_VerbosePrintf("Target speed: %f%%", s_state.target_speed * 100.0f);
 
   if (IsValid())
   {
@@ -2665,11 +2975,11 @@ void System::UpdateSpeedLimiterState()
 
     // Adjust nominal rate when resampling, or syncing to host.
     const bool rate_adjust =
-      (s_syncing_to_host || g_settings.audio_stretch_mode == AudioStretchMode::Resample) && s_target_speed > 0.0f;
-    stream->SetNominalRate(rate_adjust ? s_target_speed : 1.0f);
+      (s_state.syncing_to_host || g_settings.audio_stretch_mode == AudioStretchMode::Resample) && s_state.target_speed > 0.0f;
+    stream->SetNominalRate(rate_adjust ? s_state.target_speed : 1.0f);
 
-    if (old_target_speed < s_target_speed)
-      stream->UpdateTargetTempo(s_target_speed);
+    if (old_target_speed < s_state.target_speed)
+      stream->UpdateTargetTempo(s_state.target_speed);
 
     UpdateThrottlePeriod();
     ResetThrottler();
@@ -2680,35 +2990,60 @@ void System::UpdateSpeedLimiterState()
     UpdateDisplaySync();
 
   if (g_settings.increase_timer_resolution)
-    SetTimerResolutionIncreased(s_throttler_enabled);
+    SetTimerResolutionIncreased(s_state.throttler_enabled);
 }
 
 void System::UpdateDisplaySync()
 {
   const DisplaySyncMode display_sync_mode = GetEffectiveDisplaySyncMode();
   const bool syncing_to_host_vsync =
-    (s_syncing_to_host &&
+    (s_state.syncing_to_host &&
      (display_sync_mode == DisplaySyncMode::VSync || display_sync_mode == DisplaySyncMode::VSyncRelaxed) &&
-     s_display_all_frames);
-  const float max_display_fps = (s_throttler_enabled || s_syncing_to_host) ? 0.0f : g_settings.display_max_fps;
+     s_state.display_all_frames);
+  float max_display_fps = (s_state.throttler_enabled || s_state.syncing_to_host) ? 0.0f : g_settings.display_max_fps;
+  if (max_display_fps == 0.0f && !s_state.throttler_enabled && !s_state.syncing_to_host &&
+      g_settings.display_skip_rendering_when_unthrottled)
+  {
+    // Rendering frames is only skipped when presentation would skip them, so without a present cap
+    // there would be no interval to skip against. Fall back to the console's rate.
+    max_display_fps = GetThrottleFrequency();
+  }
   Log_VerbosePrintf("Display sync: %s%s", Settings::GetDisplaySyncModeDisplayName(display_sync_mode),
                     syncing_to_host_vsync ? " (for throttling)" : "");
   Log_VerbosePrintf("Max display fps: %f (%s)", max_display_fps,
-                    s_display_all_frames ? "displaying all frames" : "skipping displaying frames when needed");
+                    s_state.display_all_frames ? "displaying all frames" : "skipping displaying frames when needed");
 
   g_gpu_device->SetDisplayMaxFPS(max_display_fps);
+  g_gpu_device->SetMaxQueuedFrames(g_settings.display_max_queued_frames);
   g_gpu_device->SetSyncMode(display_sync_mode);
 }
 
+bool System::ShouldSkipRenderingFrame()
+{
+  // Every frame gets scanned out while throttled (or syncing to host), since it may be displayed.
+  // When unthrottled, skip scanning out frames which the present cap is going to drop anyway;
+  // drawing to VRAM still happens, so emulation state stays coherent.
+  if (!g_settings.display_skip_rendering_when_unthrottled || s_state.throttler_enabled || s_state.syncing_to_host ||
+      s_state.display_all_frames)
+  {
+    return false;
+  }
+
+  return g_gpu_device->WouldSkipDisplayingFrame();
+}
+
 DisplaySyncMode System::GetEffectiveDisplaySyncMode()
 {
-  // Disable vsync if running outside 100%.
-  return (IsValid() && IsRunningAtNonStandardSpeed()) ? DisplaySyncMode::Disabled : g_settings.display_sync_mode;
+  // Disable vsync if running outside 100%. Mailbox can stay active, presenting never blocks in
+  // that mode, so fast-forward runs uncapped without introducing tearing.
+  return (IsValid() && IsRunningAtNonStandardSpeed() && g_settings.display_sync_mode != DisplaySyncMode::Mailbox) ?
+           DisplaySyncMode::Disabled :
+           g_settings.display_sync_mode;
 }
 
 bool System::IsFastForwardEnabled()
 {
-  return s_fast_forward_enabled;
+  return s_state.fast_forward_enabled;
 }
 
 void System::SetFastForwardEnabled(bool enabled)
@@ -2716,13 +3051,13 @@ void System::SetFastForwardEnabled(bool enabled)
   if (!IsValid())
     return;
 
-  s_fast_forward_enabled = enabled;
+  s_state.fast_forward_enabled = enabled;
   UpdateSpeedLimiterState();
 }
 
 bool System::IsTurboEnabled()
 {
-  return s_turbo_enabled;
+  return s_state.turbo_enabled;
 }
 
 void System::SetTurboEnabled(bool enabled)
@@ -2730,7 +3065,7 @@ void System::SetTurboEnabled(bool enabled)
   if (!IsValid())
     return;
 
-  s_turbo_enabled = enabled;
+  s_state.turbo_enabled = enabled;
   UpdateSpeedLimiterState();
 }
 
@@ -2774,7 +3109,7 @@ void System::DoFrameStep()
     return;
   }
 
-  s_frame_step_request = true;
+  s_state.frame_step_request = true;
   PauseSystem(false);
 }
 
@@ -3021,7 +3356,7 @@ void System::ResetControllers()
 std::unique_ptr<MemoryCard> System::GetMemoryCardForSlot(u32 slot, MemoryCardType type)
 {
   // Disable memory cards when running PSFs.
-  const bool is_running_psf = !s_running_game_path.empty() && IsPsfFileName(s_running_game_path.c_str());
+  const bool is_running_psf = !s_state.running_game_path.empty() && IsPsfFileName(s_state.running_game_path.c_str());
   if (is_running_psf)
     return nullptr;
 
@@ -3031,7 +3366,7 @@ std::unique_ptr<MemoryCard> System::GetMemoryCardForSlot(u32 slot, MemoryCardTyp
   {
     case MemoryCardType::PerGame:
     {
-      if (s_running_game_serial.empty())
+      if (s_state.running_game_serial.empty())
       {
         Host::AddIconOSDMessage(
           std::move(message_key), ICON_FA_SD_CARD,
@@ -3044,13 +3379,13 @@ std::unique_ptr<MemoryCard> System::GetMemoryCardForSlot(u32 slot, MemoryCardTyp
       else
       {
         Host::RemoveKeyedOSDMessage(std::move(message_key));
-        return MemoryCard::Open(g_settings.GetGameMemoryCardPath(s_running_game_serial.c_str(), slot));
+        return MemoryCard::Open(g_settings.GetGameMemoryCardPath(s_state.running_game_serial.c_str(), slot));
       }
     }
 
     case MemoryCardType::PerGameTitle:
     {
-      if (s_running_game_title.empty())
+      if (s_state.running_game_title.empty())
       {
         Host::AddIconOSDMessage(
           std::move(message_key), ICON_FA_SD_CARD,
@@ -3065,22 +3400,22 @@ std::unique_ptr<MemoryCard> System::GetMemoryCardForSlot(u32 slot, MemoryCardTyp
         std::string card_path;
 
         // Playlist - use title if different.
-        if (HasMediaSubImages() && s_running_game_entry && s_running_game_title != s_running_game_entry->title)
+        if (HasMediaSubImages() && s_state.running_game_entry && s_state.running_game_title != s_state.running_game_entry->title)
         {
           card_path =
-            g_settings.GetGameMemoryCardPath(MemoryCard::SanitizeGameTitleForFileName(s_running_game_title), slot);
+            g_settings.GetGameMemoryCardPath(MemoryCard::SanitizeGameTitleForFileName(s_state.running_game_title), slot);
         }
         // Multi-disc game - use disc set name.
-        else if (s_running_game_entry && !s_running_game_entry->disc_set_name.empty())
+        else if (s_state.running_game_entry && !s_state.running_game_entry->disc_set_name.empty())
         {
           card_path = g_settings.GetGameMemoryCardPath(
-            MemoryCard::SanitizeGameTitleForFileName(s_running_game_entry->disc_set_name), slot);
+            MemoryCard::SanitizeGameTitleForFileName(s_state.running_game_entry->disc_set_name), slot);
         }
 
         // But prefer a disc-specific card if one already exists.
         std::string disc_card_path =
           g_settings.GetGameMemoryCardPath(MemoryCard::SanitizeGameTitleForFileName(
-                                             s_running_game_entry ? s_running_game_entry->title : s_running_game_title),
+                                             s_state.running_game_entry ? s_state.running_game_entry->title : s_state.running_game_title),
                                            slot);
         if (disc_card_path != card_path)
         {
@@ -3107,7 +3442,7 @@ std::unique_ptr<MemoryCard> System::GetMemoryCardForSlot(u32 slot, MemoryCardTyp
 
     case MemoryCardType::PerGameFileTitle:
     {
-      const std::string display_name(FileSystem::GetDisplayNameFromPath(s_running_game_path));
+      const std::string display_name(FileSystem::GetDisplayNameFromPath(s_state.running_game_path));
       const std::string_view file_title(Path::GetFileTitle(display_name));
       if (file_title.empty())
       {
@@ -3315,13 +3650,13 @@ bool System::InsertMedia(const char* path)
   const DiscRegion region = GetRegionForImage(image.get());
   UpdateRunningGame(path, image.get(), false);
   CDROM::InsertMedia(std::move(image), region);
-  Log_InfoFmt("Inserted media from {} ({}, {})", s_running_game_path, s_running_game_serial, s_running_game_title);
+  Log_InfoFmt("Inserted media from {} ({}, {})", s_state.running_game_path, s_state.running_game_serial, s_state.running_game_title);
   if (g_settings.cdrom_load_image_to_ram)
     CDROM::PrecacheMedia();
 
   Host::AddIconOSDMessage(
     "DiscInserted", ICON_FA_COMPACT_DISC,
-    fmt::format(TRANSLATE_FS("OSDMessage", "Inserted disc '{}' ({})."), s_running_game_title, s_running_game_serial),
+    fmt::format(TRANSLATE_FS("OSDMessage", "Inserted disc '{}' ({})."), s_state.running_game_title, s_state.running_game_serial),
     Host::OSD_INFO_DURATION);
 
   if (g_settings.HasAnyPerGameMemoryCards())
@@ -3343,72 +3678,74 @@ void System::RemoveMedia()
 
 void System::UpdateRunningGame(const char* path, CDImage* image, bool booting)
 {
-  if (!booting && s_running_game_path == path)
+  if (!booting && s_state.running_game_path == path)
     return;
 
-  const std::string prev_serial = std::move(s_running_game_serial);
+  const std::string prev_serial = std::move(s_state.running_game_serial);
 
-  s_running_game_path.clear();
-  s_running_game_serial = {};
-  s_running_game_title.clear();
-  s_running_game_entry = nullptr;
-  s_running_game_hash = 0;
+  s_state.running_game_path.clear();
+  s_state.running_game_serial = {};
+  s_state.running_game_title.clear();
+  s_state.running_game_entry = nullptr;
+  s_state.running_game_hash = 0;
 
   if (path && std::strlen(path) > 0)
   {
-    s_running_game_path = path;
+    s_state.running_game_path = path;
 
     if (IsExeFileName(path) || IsPsfFileName(path))
     {
       // TODO: We could pull the title from the PSF.
-      s_running_game_title = Path::GetFileTitle(path);
+      s_state.running_game_title = Path::GetFileTitle(path);
     }
     else if (image)
     {
       std::string id;
-      GetGameDetailsFromImage(image, &id, &s_running_game_hash);
+      GetGameDetailsFromImage(image, &id, &s_state.running_game_hash);
 
-      s_running_game_entry = GameDatabase::GetEntryForGameDetails(id, s_running_game_hash);
-      if (s_running_game_entry)
+      s_state.running_game_entry = GameDatabase::GetEntryForGameDetails(id, s_state.running_game_hash);
+      if (s_state.running_game_entry)
       {
-        s_running_game_serial = s_running_game_entry->serial;
-        s_running_game_title = s_running_game_entry->title;
+        s_state.running_game_serial = s_state.running_game_entry->serial;
+        s_state.running_game_title = s_state.running_game_entry->title;
       }
       else
       {
-        s_running_game_serial = std::move(id);
-        s_running_game_title = Path::GetFileTitle(FileSystem::GetDisplayNameFromPath(path));
+        s_state.running_game_serial = std::move(id);
+        s_state.running_game_title = Path::GetFileTitle(FileSystem::GetDisplayNameFromPath(path));
       }
 
       if (image->HasSubImages())
       {
         std::string image_title = image->GetMetadata("title");
         if (!image_title.empty())
-          s_running_game_title = std::move(image_title);
+          s_state.running_game_title = std::move(image_title);
       }
     }
   }
 
   if (!booting)
-    g_texture_replacements.SetGameID(s_running_game_serial);
+    g_texture_replacements.SetGameID(s_state.running_game_serial);
 
   if (booting)
     Achievements::ResetHardcoreMode();
 
-  Achievements::GameChanged(s_running_game_path, image);
+  Achievements::GameChanged(s_state.running_game_path, image);
 
   UpdateGameSettingsLayer();
   ApplySettings(true);
 
-  s_cheat_list.reset();
+  PerformanceAdvisor::OnGameChanged();
+
+  s_state.cheat_list.reset();
   if (g_settings.enable_cheats)
     LoadCheatList();
 
-  if (s_running_game_serial != prev_serial)
+  if (s_state.running_game_serial != prev_serial)
     UpdateSessionTime(prev_serial);
 
   if (SaveStateSelectorUI::IsOpen())
-    SaveStateSelectorUI::RefreshList(s_running_game_serial);
+    SaveStateSelectorUI::RefreshList(s_state.running_game_serial);
   else
     SaveStateSelectorUI::ClearList();
 
@@ -3416,19 +3753,19 @@ void System::UpdateRunningGame(const char* path, CDImage* image, bool booting)
   UpdateDiscordPresence(booting);
 #endif
 
-  Host::OnGameChanged(s_running_game_path, s_running_game_serial, s_running_game_title);
+  Host::OnGameChanged(s_state.running_game_path, s_state.running_game_serial, s_state.running_game_title);
 }
 
 bool System::CheckForSBIFile(CDImage* image)
 {
-  if (!s_running_game_entry || !s_running_game_entry->HasTrait(GameDatabase::Trait::IsLibCryptProtected) || !image ||
+  if (!s_state.running_game_entry || !s_state.running_game_entry->HasTrait(GameDatabase::Trait::IsLibCryptProtected) || !image ||
       image->HasNonStandardSubchannel())
   {
     return true;
   }
 
-  Log_WarningPrintf("SBI file missing but required for %s (%s)", s_running_game_serial.c_str(),
-                    s_running_game_title.c_str());
+  Log_WarningPrintf("SBI file missing but required for %s (%s)", s_state.running_game_serial.c_str(),
+                    s_state.running_game_title.c_str());
 
   if (Host::GetBoolSettingValue("CDROM", "AllowBootingWithoutSBIFile", false))
   {
@@ -3438,7 +3775,7 @@ bool System::CheckForSBIFile(CDImage* image)
         TRANSLATE_FS("System", "You are attempting to run a libcrypt protected game without an SBI file:\n\n{0}: "
                                "{1}\n\nThe game will likely not run properly.\n\nPlease check the README for "
                                "instructions on how to add an SBI file.\n\nDo you wish to continue?"),
-        s_running_game_serial, s_running_game_title));
+        s_state.running_game_serial, s_state.running_game_title));
   }
   else
   {
@@ -3449,7 +3786,7 @@ bool System::CheckForSBIFile(CDImage* image)
         TRANSLATE_FS("System", "You are attempting to run a libcrypt protected game without an SBI file:\n\n{0}: "
                                "{1}\n\nYour dump is incomplete, you must add the SBI file to run this game. \n\nThe "
                                "name of the SBI file must match the name of the disc image."),
-        s_running_game_serial, s_running_game_title));
+        s_state.running_game_serial, s_state.running_game_title));
 #else
     // Shorter because no confirm messages.
     Host::ReportErrorAsync("Missing SBI file.", "The selected game requires a SBI file to run properly.");
@@ -3533,12 +3870,12 @@ bool System::SwitchMediaSubImage(u32 index)
 
 bool System::HasCheatList()
 {
-  return static_cast<bool>(s_cheat_list);
+  return static_cast<bool>(s_state.cheat_list);
 }
 
 CheatList* System::GetCheatList()
 {
-  return s_cheat_list.get();
+  return s_state.cheat_list.get();
 }
 
 void System::ApplyCheatCode(const CheatCode& code)
@@ -3550,7 +3887,7 @@ void System::ApplyCheatCode(const CheatCode& code)
 void System::SetCheatList(std::unique_ptr<CheatList> cheats)
 {
   Assert(!IsShutdown());
-  s_cheat_list = std::move(cheats);
+  s_state.cheat_list = std::move(cheats);
 }
 
 void System::CheckForSettingsChanges(const Settings& old_settings)
@@ -3585,21 +3922,26 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
     RecreateGPU(g_settings.gpu_renderer, recreate_device);
   }
 
+  // Only drop rewind/runahead states when a change actually invalidates them, so that toggling
+  // cosmetic options (OSD, audio, speed limiter, etc.) doesn't throw away the rewind buffer.
+  bool clear_memory_save_states = false;
+
   if (IsValid())
   {
-    ClearMemorySaveStates();
-
     if (g_settings.cpu_overclock_active != old_settings.cpu_overclock_active ||
         (g_settings.cpu_overclock_active &&
          (g_settings.cpu_overclock_numerator != old_settings.cpu_overclock_numerator ||
           g_settings.cpu_overclock_denominator != old_settings.cpu_overclock_denominator)))
     {
       UpdateOverclock();
+      clear_memory_save_states = true;
     }
 
     if (g_settings.audio_backend != old_settings.audio_backend ||
         g_settings.audio_driver != old_settings.audio_driver ||
-        g_settings.audio_output_device != old_settings.audio_output_device)
+        g_settings.audio_output_device != old_settings.audio_output_device ||
+        g_settings.audio_buffer_ms != old_settings.audio_buffer_ms ||
+        g_settings.audio_output_latency_ms != old_settings.audio_output_latency_ms)
     {
       if (g_settings.audio_backend != old_settings.audio_backend)
       {
@@ -3611,13 +3953,15 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
 
       SPU::RecreateOutputStream();
     }
-    if (g_settings.audio_stretch_mode != old_settings.audio_stretch_mode)
+    else if (g_settings.audio_stretch_mode != old_settings.audio_stretch_mode)
+    {
+      // Stretch mode can be changed on the existing stream, no need to tear it down.
       SPU::GetOutputStream()->SetStretchMode(g_settings.audio_stretch_mode);
+    }
     if (g_settings.audio_buffer_ms != old_settings.audio_buffer_ms ||
         g_settings.audio_output_latency_ms != old_settings.audio_output_latency_ms ||
         g_settings.audio_stretch_mode != old_settings.audio_stretch_mode)
     {
-      SPU::RecreateOutputStream();
       UpdateSpeedLimiterState();
     }
 
@@ -3638,6 +3982,7 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
       if (g_settings.cpu_execution_mode != CPUExecutionMode::Interpreter)
         CPU::CodeCache::Initialize();
       CPU::ClearICache();
+      clear_memory_save_states = true;
     }
 
     if (CPU::CodeCache::IsUsingAnyRecompiler() &&
@@ -3654,6 +3999,8 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
 
       if (g_settings.cpu_recompiler_icache != old_settings.cpu_recompiler_icache)
         CPU::ClearICache();
+
+      clear_memory_save_states = true;
     }
 
     if (g_settings.enable_cheats != old_settings.enable_cheats)
@@ -3661,10 +4008,23 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
       if (g_settings.enable_cheats)
         LoadCheatList();
       else
-        s_cheat_list.reset();
+        s_state.cheat_list.reset();
     }
 
-    SPU::GetOutputStream()->SetOutputVolume(GetAudioOutputVolume());
+    if (g_settings.debugging.export_frames != old_settings.debugging.export_frames)
+    {
+      if (g_settings.debugging.export_frames)
+        FrameExport::Initialize();
+      else
+        FrameExport::Shutdown();
+    }
+
+    if (g_settings.audio_output_volume != old_settings.audio_output_volume ||
+        g_settings.audio_fast_forward_volume != old_settings.audio_fast_forward_volume ||
+        g_settings.audio_output_muted != old_settings.audio_output_muted)
+    {
+      SPU::GetOutputStream()->SetOutputVolume(GetAudioOutputVolume());
+    }
 
     if (g_settings.gpu_resolution_scale != old_settings.gpu_resolution_scale ||
         g_settings.gpu_multisamples != old_settings.gpu_multisamples ||
@@ -3703,8 +4063,12 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
       g_gpu->UpdateSettings(old_settings);
       if (!IsPaused())
         InvalidateDisplay();
+      clear_memory_save_states = true;
     }
 
+    if (g_settings.mdec_async_decode != old_settings.mdec_async_decode)
+      MDEC::UpdateSettings();
+
     if (g_settings.gpu_widescreen_hack != old_settings.gpu_widescreen_hack ||
         g_settings.display_aspect_ratio != old_settings.display_aspect_ratio ||
         (g_settings.display_aspect_ratio == DisplayAspectRatio::Custom &&
@@ -3726,6 +4090,7 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         CPU::PGXP::Initialize();
 
       CPU::CodeCache::Reset();
+      clear_memory_save_states = true;
     }
 
     if (g_settings.display_show_gpu_stats != old_settings.display_show_gpu_stats)
@@ -3739,6 +4104,7 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         (g_settings.memory_card_use_playlist_title != old_settings.memory_card_use_playlist_title))
     {
       UpdateMemoryCardTypes();
+      clear_memory_save_states = true;
     }
 
     if (g_settings.rewind_enable != old_settings.rewind_enable ||
@@ -3765,6 +4131,7 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         g_settings.emulation_speed != old_settings.emulation_speed ||
         g_settings.fast_forward_speed != old_settings.fast_forward_speed ||
         g_settings.display_max_fps != old_settings.display_max_fps ||
+        g_settings.display_max_queued_frames != old_settings.display_max_queued_frames ||
         g_settings.display_all_frames != old_settings.display_all_frames ||
         g_settings.sync_to_host_refresh_rate != old_settings.sync_to_host_refresh_rate)
     {
@@ -3800,6 +4167,7 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         UpdateControllers();
         ResetControllers();
         controllers_updated = true;
+        clear_memory_save_states = true;
       }
     }
   }
@@ -3808,7 +4176,13 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
     UpdateControllerSettings();
 
   if (g_settings.multitap_mode != old_settings.multitap_mode)
+  {
     UpdateMultitaps();
+    clear_memory_save_states = true;
+  }
+
+  if (IsValid() && clear_memory_save_states)
+    ClearMemorySaveStates();
 
   Achievements::UpdateSettings(old_settings);
 
@@ -3922,49 +4296,86 @@ void System::CalculateRewindMemoryUsage(u32 num_saves, u32 resolution_scale, u64
 
 void System::ClearMemorySaveStates()
 {
-  s_rewind_states.clear();
-  s_runahead_states.clear();
+  s_state.rewind_states.clear();
+  s_state.rewind_reference.reset();
+  s_state.rewind_scratch.reset();
+  s_state.rewind_reference_size = 0;
+  s_state.runahead_states.clear();
+  s_state.psf_seek_states.clear();
+  MemoryBudget::SetUsage(MemoryBudget::Component::RewindStates, 0);
 }
 
 void System::UpdateMemorySaveStateSettings()
 {
   ClearMemorySaveStates();
 
-  s_memory_saves_enabled = g_settings.rewind_enable;
+  s_state.memory_saves_enabled = g_settings.rewind_enable;
 
   if (g_settings.rewind_enable)
   {
-    s_rewind_save_frequency = static_cast<s32>(std::ceil(g_settings.rewind_save_frequency * s_throttle_frequency));
-    s_rewind_save_counter = 0;
+    s_state.rewind_save_frequency = static_cast<s32>(std::ceil(g_settings.rewind_save_frequency * s_state.throttle_frequency));
+    s_state.rewind_save_counter = 0;
 
     u64 ram_usage, vram_usage;
     CalculateRewindMemoryUsage(g_settings.rewind_save_slots, g_settings.gpu_resolution_scale, &ram_usage, &vram_usage);
     Log_InfoPrintf(
       "Rewind is enabled, saving every %d frames, with %u slots and %" PRIu64 "MB RAM and %" PRIu64 "MB VRAM usage",
-      std::max(s_rewind_save_frequency, 1), g_settings.rewind_save_slots, ram_usage / 1048576, vram_usage / 1048576);
+      std::max(s_state.rewind_save_frequency, 1), g_settings.rewind_save_slots, ram_usage / 1048576, vram_usage / 1048576);
   }
   else
   {
-    s_rewind_save_frequency = -1;
-    s_rewind_save_counter = -1;
+    s_state.rewind_save_frequency = -1;
+    s_state.rewind_save_counter = -1;
   }
 
-  s_rewind_load_frequency = -1;
-  s_rewind_load_counter = -1;
+  s_state.rewind_load_frequency = -1;
+  s_state.rewind_load_counter = -1;
+
+  s_state.runahead_frames = g_settings.runahead_frames;
+  s_state.runahead_replay_pending = false;
+  if (s_state.runahead_frames > 0)
+    Log_InfoPrintf("Runahead is active with %u frames", s_state.runahead_frames);
 
-  s_runahead_frames = g_settings.runahead_frames;
-  s_runahead_replay_pending = false;
-  if (s_runahead_frames > 0)
-    Log_InfoPrintf("Runahead is active with %u frames", s_runahead_frames);
+  // With write tracking active, the per-frame runahead snapshots only copy the RAM pages the game
+  // wrote, instead of all of RAM.
+  Bus::EnableRAMWriteTracking(s_state.runahead_frames > 0);
+
+  if (s_state.psf_playback)
+  {
+    s_state.psf_seek_save_frequency =
+      static_cast<s32>(std::ceil(PSF_SEEK_SNAPSHOT_INTERVAL * s_state.throttle_frequency));
+    s_state.psf_seek_save_counter = 0;
+  }
+  else
+  {
+    s_state.psf_seek_save_frequency = -1;
+    s_state.psf_seek_save_counter = -1;
+  }
 }
 
 bool System::LoadMemoryState(const MemorySaveState& mss)
 {
-  mss.state_stream->SeekAbsolute(0);
+  const bool tracked_ram = static_cast<bool>(mss.ram_copy);
+  if (tracked_ram)
+  {
+    DebugAssert(mss.ram_copy_size == Bus::g_ram_size);
+
+    // Only pages that can differ from the snapshot need restoring: pages stale in the slot, plus
+    // anything written since the last tracking interval started. The copies below land through the
+    // protected mapping, so the tracker picks them up like any other write.
+    const std::bitset<Bus::RAM_8MB_CODE_PAGE_COUNT> restore_pages = mss.stale_ram_pages | Bus::GetRAMDirtyPages();
+    const u32 page_count = mss.ram_copy_size / HOST_PAGE_SIZE;
+    for (u32 i = 0; i < page_count; i++)
+    {
+      if (restore_pages[i])
+        std::memcpy(&Bus::g_ram[i * HOST_PAGE_SIZE], &mss.ram_copy[i * HOST_PAGE_SIZE], HOST_PAGE_SIZE);
+    }
+  }
 
-  StateWrapper sw(mss.state_stream.get(), StateWrapper::Mode::Read, SAVE_STATE_VERSION);
+  StateWrapper sw(mss.state_stream->GetMemoryPointer(), mss.state_stream->GetMemorySize(), StateWrapper::Mode::Read,
+                  SAVE_STATE_VERSION);
   GPUTexture* host_texture = mss.vram_texture.get();
-  if (!DoState(sw, &host_texture, true, true))
+  if (!DoState(sw, &host_texture, true, true, tracked_ram))
   {
     Host::ReportErrorAsync("Error", "Failed to load memory save state, resetting.");
     InternalReset();
@@ -3974,16 +4385,16 @@ bool System::LoadMemoryState(const MemorySaveState& mss)
   return true;
 }
 
-bool System::SaveMemoryState(MemorySaveState* mss)
+bool System::SaveMemoryState(MemorySaveState* mss, bool tracked_ram)
 {
   if (!mss->state_stream)
     mss->state_stream = std::make_unique<GrowableMemoryByteStream>(nullptr, MAX_SAVE_STATE_SIZE);
-  else
-    mss->state_stream->SeekAbsolute(0);
 
+  const bool skip_ram = (tracked_ram && Bus::IsRAMWriteTrackingEnabled());
   GPUTexture* host_texture = mss->vram_texture.release();
-  StateWrapper sw(mss->state_stream.get(), StateWrapper::Mode::Write, SAVE_STATE_VERSION);
-  if (!DoState(sw, &host_texture, false, true))
+  StateWrapper sw(mss->state_stream->GetMemoryPointer(), mss->state_stream->GetMemorySize(),
+                  StateWrapper::Mode::Write, SAVE_STATE_VERSION);
+  if (!DoState(sw, &host_texture, false, true, skip_ram))
   {
     Log_ErrorPrint("Failed to create rewind state.");
     delete host_texture;
@@ -3991,11 +4402,40 @@ bool System::SaveMemoryState(MemorySaveState* mss)
   }
 
   mss->vram_texture.reset(host_texture);
+
+  if (skip_ram)
+  {
+    // RAM lives outside the stream; refresh only the pages that went stale while the slot was
+    // sitting in the queue.
+    if (!mss->ram_copy || mss->ram_copy_size != Bus::g_ram_size)
+    {
+      mss->ram_copy = std::make_unique<u8[]>(Bus::g_ram_size);
+      mss->ram_copy_size = Bus::g_ram_size;
+      mss->stale_ram_pages.set();
+    }
+
+    const u32 page_count = mss->ram_copy_size / HOST_PAGE_SIZE;
+    for (u32 i = 0; i < page_count; i++)
+    {
+      if (mss->stale_ram_pages[i])
+        std::memcpy(&mss->ram_copy[i * HOST_PAGE_SIZE], &Bus::g_ram[i * HOST_PAGE_SIZE], HOST_PAGE_SIZE);
+    }
+
+    mss->stale_ram_pages.reset();
+  }
+  else
+  {
+    mss->ram_copy.reset();
+    mss->ram_copy_size = 0;
+  }
+
   return true;
 }
 
 bool System::SaveRewindState()
 {
+  PerfTrace::Scope trace_scope("SaveRewindState");
+
 #ifdef PROFILE_MEMORY_SAVE_STATES
   Common::Timer save_timer;
 #endif
@@ -4003,46 +4443,197 @@ bool System::SaveRewindState()
   // try to reuse the frontmost slot
   const u32 save_slots = g_settings.rewind_save_slots;
   MemorySaveState mss;
-  while (s_rewind_states.size() >= save_slots)
+  while (s_state.rewind_states.size() >= save_slots)
   {
-    mss = std::move(s_rewind_states.front());
-    s_rewind_states.pop_front();
+    mss = std::move(s_state.rewind_states.front());
+    s_state.rewind_states.pop_front();
   }
 
-  if (!SaveMemoryState(&mss))
+  // Serialize the full state into the scratch buffer. Only the XOR delta against the previous
+  // snapshot gets stored in the slot; adjacent snapshots differ in very little, so the delta
+  // compresses to a fraction of the full state.
+  if (!s_state.rewind_scratch)
+    s_state.rewind_scratch = std::make_unique<GrowableMemoryByteStream>(nullptr, MAX_SAVE_STATE_SIZE);
+
+  u32 state_size;
+  GPUTexture* host_texture = mss.vram_texture.release();
+  {
+    StateWrapper sw(s_state.rewind_scratch->GetMemoryPointer(), s_state.rewind_scratch->GetMemorySize(),
+                    StateWrapper::Mode::Write, SAVE_STATE_VERSION);
+    if (!DoState(sw, &host_texture, false, true))
+    {
+      Log_ErrorPrint("Failed to create rewind state.");
+      delete host_texture;
+      return false;
+    }
+
+    state_size = static_cast<u32>(sw.GetPosition());
+  }
+  mss.vram_texture.reset(host_texture);
+  if (!mss.state_stream)
+    mss.state_stream = std::make_unique<GrowableMemoryByteStream>(nullptr, 0);
+  mss.state_stream->SeekAbsolute(0);
+
+  mss.is_delta = (!s_state.rewind_states.empty() && s_state.rewind_reference && s_state.rewind_reference_size > 0);
+  mss.state_size = state_size;
+  mss.delta_size = mss.is_delta ? std::max(state_size, s_state.rewind_reference_size) : state_size;
+
+  bool result;
+  {
+    std::unique_ptr<ByteStream> cstream(ByteStream::CreateZstdCompressStream(mss.state_stream.get(), 1));
+    if (!mss.is_delta)
+    {
+      result = cstream->Write2(s_state.rewind_scratch->GetMemoryPointer(), state_size);
+    }
+    else
+    {
+      const u8* cur = s_state.rewind_scratch->GetMemoryPointer();
+      const u8* prev = s_state.rewind_reference->GetMemoryPointer();
+      const u32 min_size = std::min(state_size, s_state.rewind_reference_size);
+
+      u8 chunk[16384];
+      result = true;
+      for (u32 offset = 0; offset < min_size && result; offset += static_cast<u32>(sizeof(chunk)))
+      {
+        const u32 len = std::min(static_cast<u32>(sizeof(chunk)), min_size - offset);
+        for (u32 i = 0; i < len; i++)
+          chunk[i] = cur[offset + i] ^ prev[offset + i];
+        result = cstream->Write2(chunk, len);
+      }
+
+      // where the sizes differ the shorter buffer is implicitly zero, i.e. the tail is stored as-is
+      if (result && state_size > min_size)
+        result = cstream->Write2(cur + min_size, state_size - min_size);
+      else if (result && s_state.rewind_reference_size > min_size)
+        result = cstream->Write2(prev + min_size, s_state.rewind_reference_size - min_size);
+    }
+    result = result && cstream->Commit();
+  }
+
+  if (!result)
+  {
+    Log_ErrorPrint("Failed to compress rewind state.");
     return false;
+  }
+
+  mss.compressed_size = static_cast<u32>(mss.state_stream->GetPosition());
+
+  // the scratch buffer becomes the new reference snapshot
+  std::swap(s_state.rewind_scratch, s_state.rewind_reference);
+  s_state.rewind_reference_size = state_size;
 
-  s_rewind_states.push_back(std::move(mss));
+  s_state.rewind_states.push_back(std::move(mss));
+
+  // The rewind history only ever grows here, so this is the one spot that needs to react to
+  // global memory pressure; dropping the oldest slots just shortens how far back we can rewind.
+  while (MemoryBudget::IsOverBudget() && s_state.rewind_states.size() > 1)
+  {
+    s_state.rewind_states.pop_front();
+    UpdateRewindMemoryUsage();
+  }
+  UpdateRewindMemoryUsage();
 
 #ifdef PROFILE_MEMORY_SAVE_STATES
-  Log_DevPrintf("Saved rewind state (%" PRIu64 " bytes, took %.4f ms)", s_rewind_states.back().state_stream->GetSize(),
-                save_timer.GetTimeMilliseconds());
+  Log_DevPrintf("Saved rewind state (%u bytes compressed from %u, took %.4f ms)",
+                s_state.rewind_states.back().compressed_size, state_size, save_timer.GetTimeMilliseconds());
 #endif
 
   return true;
 }
 
+void System::UpdateRewindMemoryUsage()
+{
+  // Host VRAM copies are not counted, the budget covers CPU memory.
+  u64 usage = 0;
+  for (const MemorySaveState& mss : s_state.rewind_states)
+    usage += mss.state_stream ? mss.state_stream->GetMemorySize() : 0;
+  usage += s_state.rewind_reference ? s_state.rewind_reference->GetMemorySize() : 0;
+  usage += s_state.rewind_scratch ? s_state.rewind_scratch->GetMemorySize() : 0;
+  MemoryBudget::SetUsage(MemoryBudget::Component::RewindStates, usage);
+}
+
+bool System::PopRewindState()
+{
+  MemorySaveState mss = std::move(s_state.rewind_states.back());
+  s_state.rewind_states.pop_back();
+  UpdateRewindMemoryUsage();
+  if (mss.vram_texture)
+    g_gpu_device->RecycleTexture(std::move(mss.vram_texture));
+
+  if (s_state.rewind_states.empty())
+  {
+    // nothing left to roll back to
+    s_state.rewind_reference_size = 0;
+    return true;
+  }
+
+  // The XOR delta is symmetric, so applying the popped slot's delta to the reference snapshot
+  // turns it into the previous snapshot.
+  DebugAssert(mss.is_delta && s_state.rewind_reference);
+  if (mss.delta_size > s_state.rewind_reference->GetMemorySize())
+    s_state.rewind_reference->ResizeMemory(mss.delta_size);
+
+  u8* ref = s_state.rewind_reference->GetMemoryPointer();
+  if (mss.delta_size > s_state.rewind_reference_size)
+    std::memset(ref + s_state.rewind_reference_size, 0, mss.delta_size - s_state.rewind_reference_size);
+
+  mss.state_stream->SeekAbsolute(0);
+  std::unique_ptr<ByteStream> dstream(
+    ByteStream::CreateZstdDecompressStream(mss.state_stream.get(), mss.compressed_size));
+
+  u8 chunk[16384];
+  bool result = static_cast<bool>(dstream);
+  for (u32 offset = 0; offset < mss.delta_size && result; offset += static_cast<u32>(sizeof(chunk)))
+  {
+    const u32 len = std::min(static_cast<u32>(sizeof(chunk)), mss.delta_size - offset);
+    result = dstream->Read2(chunk, len);
+    if (result)
+    {
+      for (u32 i = 0; i < len; i++)
+        ref[offset + i] ^= chunk[i];
+    }
+  }
+
+  if (!result)
+  {
+    Log_ErrorPrint("Failed to apply rewind state delta, clearing rewind states.");
+    ClearMemorySaveStates();
+    return false;
+  }
+
+  s_state.rewind_reference_size = s_state.rewind_states.back().state_size;
+  return true;
+}
+
 bool System::LoadRewindState(u32 skip_saves /*= 0*/, bool consume_state /*=true */)
 {
-  while (skip_saves > 0 && !s_rewind_states.empty())
+  while (skip_saves > 0 && !s_state.rewind_states.empty())
   {
-    g_gpu_device->RecycleTexture(std::move(s_rewind_states.back().vram_texture));
-    s_rewind_states.pop_back();
+    if (!PopRewindState())
+      return false;
     skip_saves--;
   }
 
-  if (s_rewind_states.empty())
+  if (s_state.rewind_states.empty() || !s_state.rewind_reference)
     return false;
 
 #ifdef PROFILE_MEMORY_SAVE_STATES
   Common::Timer load_timer;
 #endif
 
-  if (!LoadMemoryState(s_rewind_states.back()))
+  // the reference buffer is always the uncompressed form of the newest slot
+  StateWrapper sw(s_state.rewind_reference->GetMemoryPointer(), s_state.rewind_reference->GetMemorySize(),
+                  StateWrapper::Mode::Read, SAVE_STATE_VERSION);
+  GPUTexture* host_texture = s_state.rewind_states.back().vram_texture.get();
+  if (!DoState(sw, &host_texture, true, true))
+  {
+    Host::ReportErrorAsync("Error", "Failed to load memory save state, resetting.");
+    InternalReset();
     return false;
+  }
 
   if (consume_state)
-    s_rewind_states.pop_back();
+    PopRewindState();
 
 #ifdef PROFILE_MEMORY_SAVE_STATES
   Log_DevPrintf("Rewind load took %.4f ms", load_timer.GetTimeMilliseconds());
@@ -4053,7 +4644,7 @@ bool System::LoadRewindState(u32 skip_saves /*= 0*/, bool consume_state /*=true
 
 bool System::IsRewinding()
 {
-  return (s_rewind_load_frequency >= 0);
+  return (s_state.rewind_load_frequency >= 0);
 }
 
 void System::SetRewinding(bool enabled)
@@ -4064,33 +4655,33 @@ void System::SetRewinding(bool enabled)
 
     // Try to rewind at the replay speed, or one per second maximum.
     const float load_frequency = std::min(g_settings.rewind_save_frequency, 1.0f);
-    s_rewind_load_frequency = static_cast<s32>(std::ceil(load_frequency * s_throttle_frequency));
-    s_rewind_load_counter = 0;
+    s_state.rewind_load_frequency = static_cast<s32>(std::ceil(load_frequency * s_state.throttle_frequency));
+    s_state.rewind_load_counter = 0;
 
-    if (!was_enabled && s_system_executing)
-      s_system_interrupted = true;
+    if (!was_enabled && s_state.system_executing)
+      s_state.system_interrupted = true;
   }
   else
   {
-    s_rewind_load_frequency = -1;
-    s_rewind_load_counter = -1;
-    s_rewinding_first_save = true;
+    s_state.rewind_load_frequency = -1;
+    s_state.rewind_load_counter = -1;
+    s_state.rewinding_first_save = true;
   }
 }
 
 void System::DoRewind()
 {
-  if (s_rewind_load_counter == 0)
+  if (s_state.rewind_load_counter == 0)
   {
-    const u32 skip_saves = BoolToUInt32(!s_rewinding_first_save);
-    s_rewinding_first_save = false;
+    const u32 skip_saves = BoolToUInt32(!s_state.rewinding_first_save);
+    s_state.rewinding_first_save = false;
     LoadRewindState(skip_saves, false);
     ResetPerformanceCounters();
-    s_rewind_load_counter = s_rewind_load_frequency;
+    s_state.rewind_load_counter = s_state.rewind_load_frequency;
   }
   else
   {
-    s_rewind_load_counter--;
+    s_state.rewind_load_counter--;
   }
 
   InvalidateDisplay();
@@ -4102,21 +4693,31 @@ void System::DoRewind()
 
 void System::SaveRunaheadState()
 {
+  // Fold the pages written since the previous snapshot into every slot still holding one, so a
+  // reused slot knows which parts of its RAM copy have gone stale, then start a fresh interval.
+  if (Bus::IsRAMWriteTrackingEnabled())
+  {
+    const std::bitset<Bus::RAM_8MB_CODE_PAGE_COUNT>& dirty_pages = Bus::GetRAMDirtyPages();
+    for (MemorySaveState& s : s_state.runahead_states)
+      s.stale_ram_pages |= dirty_pages;
+    Bus::ResetRAMDirtyPages();
+  }
+
   // try to reuse the frontmost slot
   MemorySaveState mss;
-  while (s_runahead_states.size() >= s_runahead_frames)
+  while (s_state.runahead_states.size() >= s_state.runahead_frames)
   {
-    mss = std::move(s_runahead_states.front());
-    s_runahead_states.pop_front();
+    mss = std::move(s_state.runahead_states.front());
+    s_state.runahead_states.pop_front();
   }
 
-  if (!SaveMemoryState(&mss))
+  if (!SaveMemoryState(&mss, true))
   {
     Log_ErrorPrint("Failed to save runahead state.");
     return;
   }
 
-  s_runahead_states.push_back(std::move(mss));
+  s_state.runahead_states.push_back(std::move(mss));
 }
 
 bool System::DoRunahead()
@@ -4125,45 +4726,45 @@ bool System::DoRunahead()
   static Common::Timer replay_timer;
 #endif
 
-  if (s_runahead_replay_pending)
+  if (s_state.runahead_replay_pending)
   {
 #ifdef PROFILE_MEMORY_SAVE_STATES
-    Log_DevPrintf("runahead starting at frame %u", s_frame_number);
+    Log_DevPrintf("runahead starting at frame %u", s_state.frame_number);
     replay_timer.Reset();
 #endif
 
     // we need to replay and catch up - load the state,
-    s_runahead_replay_pending = false;
-    if (s_runahead_states.empty() || !LoadMemoryState(s_runahead_states.front()))
+    s_state.runahead_replay_pending = false;
+    if (s_state.runahead_states.empty() || !LoadMemoryState(s_state.runahead_states.front()))
     {
-      s_runahead_states.clear();
+      s_state.runahead_states.clear();
       return false;
     }
 
     // figure out how many frames we need to run to catch up
-    s_runahead_replay_frames = static_cast<u32>(s_runahead_states.size());
+    s_state.runahead_replay_frames = static_cast<u32>(s_state.runahead_states.size());
 
     // and throw away all the states, forcing us to catch up below
-    s_runahead_states.clear();
+    s_state.runahead_states.clear();
 
     // run the frames with no audio
     SPU::SetAudioOutputMuted(true);
 
 #ifdef PROFILE_MEMORY_SAVE_STATES
-    Log_VerbosePrintf("Rewound to frame %u, took %.2f ms", s_frame_number, replay_timer.GetTimeMilliseconds());
+    Log_VerbosePrintf("Rewound to frame %u, took %.2f ms", s_state.frame_number, replay_timer.GetTimeMilliseconds());
 #endif
 
     // we don't want to save the frame we just loaded. but we are "one frame ahead", because the frame we just tossed
     // was never saved, so return but don't decrement the counter
     return true;
   }
-  else if (s_runahead_replay_frames == 0)
+  else if (s_state.runahead_replay_frames == 0)
   {
     return false;
   }
 
-  s_runahead_replay_frames--;
-  if (s_runahead_replay_frames > 0)
+  s_state.runahead_replay_frames--;
+  if (s_state.runahead_replay_frames > 0)
   {
     // keep running ahead
     SaveRunaheadState();
@@ -4171,7 +4772,7 @@ bool System::DoRunahead()
   }
 
 #ifdef PROFILE_MEMORY_SAVE_STATES
-  Log_VerbosePrintf("Running %d frames to catch up took %.2f ms", s_runahead_frames,
+  Log_VerbosePrintf("Running %d frames to catch up took %.2f ms", s_state.runahead_frames,
                     replay_timer.GetTimeMilliseconds());
 #endif
 
@@ -4179,7 +4780,7 @@ bool System::DoRunahead()
   SPU::SetAudioOutputMuted(false);
 
 #ifdef PROFILE_MEMORY_SAVE_STATES
-  Log_DevPrintf("runahead ending at frame %u, took %.2f ms", s_frame_number, replay_timer.GetTimeMilliseconds());
+  Log_DevPrintf("runahead ending at frame %u, took %.2f ms", s_state.frame_number, replay_timer.GetTimeMilliseconds());
 #endif
 
   return false;
@@ -4187,14 +4788,86 @@ bool System::DoRunahead()
 
 void System::SetRunaheadReplayFlag()
 {
-  if (s_runahead_frames == 0 || s_runahead_states.empty())
+  if (s_state.runahead_frames == 0 || s_state.runahead_states.empty())
     return;
 
 #ifdef PROFILE_MEMORY_SAVE_STATES
   Log_DevPrintf("Runahead rewind pending...");
 #endif
 
-  s_runahead_replay_pending = true;
+  s_state.runahead_replay_pending = true;
+}
+
+void System::SavePsfSeekState()
+{
+  if (s_state.psf_seek_states.size() >= MAX_PSF_SEEK_STATES)
+  {
+    // Thin out the list and take snapshots half as often from now on.
+    std::deque<std::pair<u32, MemorySaveState>> thinned;
+    for (size_t i = 0; i < s_state.psf_seek_states.size(); i += 2)
+      thinned.push_back(std::move(s_state.psf_seek_states[i]));
+    s_state.psf_seek_states.swap(thinned);
+    s_state.psf_seek_save_frequency *= 2;
+  }
+
+  MemorySaveState mss;
+  if (!SaveMemoryState(&mss))
+  {
+    Log_ErrorPrint("Failed to save PSF seek state.");
+    return;
+  }
+
+  s_state.psf_seek_states.emplace_back(s_state.frame_number, std::move(mss));
+}
+
+bool System::SeekPsfPlayback(float seconds)
+{
+  if (!IsValid() || !s_state.psf_playback)
+    return false;
+
+  const u32 target_frame = static_cast<u32>(std::max(seconds, 0.0f) * s_state.throttle_frequency);
+  if (target_frame < s_state.frame_number)
+  {
+    // Restore the newest snapshot at or before the target. Snapshots past the restored frame are
+    // dropped, since re-saving them during catch-up would leave the list out of frame order.
+    size_t index = s_state.psf_seek_states.size();
+    while (index > 0 && s_state.psf_seek_states[index - 1].first > target_frame)
+      index--;
+    if (index == 0)
+    {
+      Log_ErrorPrintf("No PSF seek snapshot at or before frame %u", target_frame);
+      return false;
+    }
+
+    if (!LoadMemoryState(s_state.psf_seek_states[index - 1].second))
+    {
+      s_state.psf_seek_states.clear();
+      return false;
+    }
+
+    s_state.psf_seek_states.erase(s_state.psf_seek_states.begin() + index, s_state.psf_seek_states.end());
+    s_state.runahead_states.clear();
+    ResetPerformanceCounters();
+    ResetThrottler();
+  }
+
+  if (s_state.frame_number < target_frame)
+  {
+    // Emulate the remainder with audio muted; FrameDone() unmutes once the target is reached.
+    s_state.psf_seek_target_frame = target_frame;
+    if (!s_state.psf_seek_replay)
+    {
+      s_state.psf_seek_replay = true;
+      SPU::SetAudioOutputMuted(true);
+    }
+  }
+  else if (s_state.psf_seek_replay)
+  {
+    s_state.psf_seek_replay = false;
+    SPU::SetAudioOutputMuted(false);
+  }
+
+  return true;
 }
 
 void System::ShutdownSystem(bool save_resume_state)
@@ -4205,24 +4878,24 @@ void System::ShutdownSystem(bool save_resume_state)
   if (save_resume_state)
     SaveResumeState();
 
-  s_state = State::Stopping;
-  if (!s_system_executing)
+  s_state.state = State::Stopping;
+  if (!s_state.system_executing)
     DestroySystem();
 }
 
 bool System::CanUndoLoadState()
 {
-  return static_cast<bool>(m_undo_load_state);
+  return static_cast<bool>(s_state.undo_load_state);
 }
 
 std::optional<ExtendedSaveStateInfo> System::GetUndoSaveStateInfo()
 {
   std::optional<ExtendedSaveStateInfo> ssi;
-  if (m_undo_load_state)
+  if (s_state.undo_load_state)
   {
-    m_undo_load_state->SeekAbsolute(0);
-    ssi = InternalGetExtendedSaveStateInfo(m_undo_load_state.get());
-    m_undo_load_state->SeekAbsolute(0);
+    s_state.undo_load_state->SeekAbsolute(0);
+    ssi = InternalGetExtendedSaveStateInfo(s_state.undo_load_state.get());
+    s_state.undo_load_state->SeekAbsolute(0);
 
     if (ssi)
       ssi->timestamp = 0;
@@ -4233,39 +4906,39 @@ std::optional<ExtendedSaveStateInfo> System::GetUndoSaveStateInfo()
 
 bool System::UndoLoadState()
 {
-  if (!m_undo_load_state)
+  if (!s_state.undo_load_state)
     return false;
 
   Assert(IsValid());
 
-  m_undo_load_state->SeekAbsolute(0);
-  if (!LoadStateFromStream(m_undo_load_state.get(), true))
+  s_state.undo_load_state->SeekAbsolute(0);
+  if (!LoadStateFromStream(s_state.undo_load_state.get(), true))
   {
     Host::ReportErrorAsync("Error", "Failed to load undo state, resetting system.");
-    m_undo_load_state.reset();
+    s_state.undo_load_state.reset();
     ResetSystem();
     return false;
   }
 
   Log_InfoPrintf("Loaded undo save state.");
-  m_undo_load_state.reset();
+  s_state.undo_load_state.reset();
   return true;
 }
 
 bool System::SaveUndoLoadState()
 {
-  if (m_undo_load_state)
-    m_undo_load_state.reset();
+  if (s_state.undo_load_state)
+    s_state.undo_load_state.reset();
 
-  m_undo_load_state = ByteStream::CreateGrowableMemoryStream(nullptr, System::MAX_SAVE_STATE_SIZE);
-  if (!SaveStateToStream(m_undo_load_state.get()))
+  s_state.undo_load_state = ByteStream::CreateGrowableMemoryStream(nullptr, System::MAX_SAVE_STATE_SIZE);
+  if (!SaveStateToStream(s_state.undo_load_state.get()))
   {
     Host::AddOSDMessage(TRANSLATE_STR("OSDMessage", "Failed to save undo load state."), 15.0f);
-    m_undo_load_state.reset();
+    s_state.undo_load_state.reset();
     return false;
   }
 
-  Log_InfoPrintf("Saved undo load state: %" PRIu64 " bytes", m_undo_load_state->GetSize());
+  Log_InfoPrintf("Saved undo load state: %" PRIu64 " bytes", s_state.undo_load_state->GetSize());
   return true;
 }
 
@@ -4339,6 +5012,56 @@ void System::StopDumpingAudio()
   Host::AddOSDMessage(TRANSLATE_STR("OSDMessage", "Stopped dumping audio."), 5.0f);
 }
 
+bool System::IsRecordingGPUDump()
+{
+  return System::IsValid() && g_gpu->IsRecordingGPUDump();
+}
+
+bool System::StartRecordingGPUDump(const char* filename)
+{
+  if (!System::IsValid())
+    return false;
+
+  std::string auto_filename;
+  if (!filename)
+  {
+    const auto& serial = System::GetGameSerial();
+    if (serial.empty())
+    {
+      auto_filename = Path::Combine(
+        EmuFolders::Dumps, fmt::format("gpu" FS_OSPATH_SEPARATOR_STR "{}.psxgpu", GetTimestampStringForFileName()));
+    }
+    else
+    {
+      auto_filename = Path::Combine(EmuFolders::Dumps, fmt::format("gpu" FS_OSPATH_SEPARATOR_STR "{}_{}.psxgpu", serial,
+                                                                   GetTimestampStringForFileName()));
+    }
+
+    filename = auto_filename.c_str();
+  }
+
+  if (g_gpu->StartRecordingGPUDump(filename))
+  {
+    Host::AddFormattedOSDMessage(5.0f, TRANSLATE("OSDMessage", "Started recording GPU dump to '%s'."), filename);
+    return true;
+  }
+  else
+  {
+    Host::AddFormattedOSDMessage(10.0f, TRANSLATE("OSDMessage", "Failed to start recording GPU dump to '%s'."),
+                                 filename);
+    return false;
+  }
+}
+
+void System::StopRecordingGPUDump()
+{
+  if (!System::IsValid() || !g_gpu->IsRecordingGPUDump())
+    return;
+
+  g_gpu->StopRecordingGPUDump();
+  Host::AddOSDMessage(TRANSLATE_STR("OSDMessage", "Stopped recording GPU dump."), 5.0f);
+}
+
 bool System::SaveScreenshot(const char* filename, DisplayScreenshotMode mode, DisplayScreenshotFormat format,
                             u8 quality, bool compress_on_thread)
 {
@@ -4575,11 +5298,11 @@ bool System::LoadCheatList()
 
 bool System::LoadCheatListFromDatabase()
 {
-  if (IsShutdown() || s_running_game_serial.empty() || Achievements::IsHardcoreModeActive())
+  if (IsShutdown() || s_state.running_game_serial.empty() || Achievements::IsHardcoreModeActive())
     return false;
 
   std::unique_ptr<CheatList> cl = std::make_unique<CheatList>();
-  if (!cl->LoadFromPackage(s_running_game_serial))
+  if (!cl->LoadFromPackage(s_state.running_game_serial))
     return false;
 
   Log_InfoPrintf("Loaded %u cheats from database.", cl->GetCodeCount());
@@ -4787,6 +5510,9 @@ void System::HostDisplayResized()
 
 bool System::PresentDisplay(bool allow_skip_present)
 {
+  PerfTrace::Scope trace_scope("PresentDisplay");
+
+  const Common::Timer::Value present_start_time = Common::Timer::GetCurrentValue();
   const bool skip_present = allow_skip_present && g_gpu_device->ShouldSkipDisplayingFrame();
 
   Host::BeginPresentFrame();
@@ -4799,9 +5525,6 @@ bool System::PresentDisplay(bool allow_skip_present)
     FullscreenUI::Render();
     ImGuiManager::RenderTextOverlays();
     ImGuiManager::RenderOSDMessages();
-
-    if (s_state == State::Running)
-      ImGuiManager::RenderSoftwareCursors();
   }
 
   // Debug windows are always rendered, otherwise mouse input breaks on skip.
@@ -4817,12 +5540,22 @@ bool System::PresentDisplay(bool allow_skip_present)
   if (do_present)
   {
     g_gpu_device->RenderImGui();
+
+    // Late-latched cursor layer: sample the pointer position after everything else has been
+    // rendered, so light-gun crosshairs don't carry the whole frame's latency.
+    if (!skip_present && s_state.state == State::Running)
+      ImGuiManager::RenderSoftwareCursors();
+
     g_gpu_device->EndPresent();
 
+    // Timestamp after the present, that's the point gated by the display.
+    if (s_state.state == State::Running)
+      AccumulatePresentTiming(Common::Timer::GetCurrentValue());
+
     if (g_gpu_device->IsGPUTimingEnabled())
     {
-      s_accumulated_gpu_time += g_gpu_device->GetAndResetAccumulatedGPUTime();
-      s_presents_since_last_update++;
+      s_state.accumulated_gpu_time += g_gpu_device->GetAndResetAccumulatedGPUTime();
+      s_state.presents_since_last_update++;
     }
   }
   else
@@ -4833,6 +5566,9 @@ bool System::PresentDisplay(bool allow_skip_present)
 
   ImGuiManager::NewFrame();
 
+  PerfStats::AddSample(PerfStats::Metric::Present, static_cast<float>(Common::Timer::ConvertValueToMilliseconds(
+                                                     Common::Timer::GetCurrentValue() - present_start_time)));
+
   return do_present;
 }
 
@@ -4867,69 +5603,69 @@ void System::UpdateSessionTime(const std::string& prev_serial)
   {
     // round up to seconds
     const std::time_t etime =
-      static_cast<std::time_t>(std::round(Common::Timer::ConvertValueToSeconds(ctime - s_session_start_time)));
+      static_cast<std::time_t>(std::round(Common::Timer::ConvertValueToSeconds(ctime - s_state.session_start_time)));
     const std::time_t wtime = std::time(nullptr);
     GameList::AddPlayedTimeForSerial(prev_serial, wtime, etime);
   }
 
-  s_session_start_time = ctime;
+  s_state.session_start_time = ctime;
 }
 
 u64 System::GetSessionPlayedTime()
 {
   const u64 ctime = Common::Timer::GetCurrentValue();
-  return static_cast<u64>(std::round(Common::Timer::ConvertValueToSeconds(ctime - s_session_start_time)));
+  return static_cast<u64>(std::round(Common::Timer::ConvertValueToSeconds(ctime - s_state.session_start_time)));
 }
 
 #ifdef ENABLE_DISCORD_PRESENCE
 
 void System::InitializeDiscordPresence()
 {
-  if (s_discord_presence_active)
+  if (s_state.discord_presence_active)
     return;
 
   DiscordEventHandlers handlers = {};
   Discord_Initialize("705325712680288296", &handlers, 0, nullptr);
-  s_discord_presence_active = true;
+  s_state.discord_presence_active = true;
 
   UpdateDiscordPresence(true);
 }
 
 void System::ShutdownDiscordPresence()
 {
-  if (!s_discord_presence_active)
+  if (!s_state.discord_presence_active)
     return;
 
   Discord_ClearPresence();
   Discord_Shutdown();
-  s_discord_presence_active = false;
+  s_state.discord_presence_active = false;
 }
 
 void System::UpdateDiscordPresence(bool update_session_time)
 {
-  if (!s_discord_presence_active)
+  if (!s_state.discord_presence_active)
     return;
 
   if (update_session_time)
-    s_discord_presence_time_epoch = std::time(nullptr);
+    s_state.discord_presence_time_epoch = std::time(nullptr);
 
   // https://discord.com/developers/docs/rich-presence/how-to#updating-presence-update-presence-payload-fields
   DiscordRichPresence rp = {};
   rp.largeImageKey = "duckstation_logo";
   rp.largeImageText = "DuckStation PS1/PSX Emulator";
-  rp.startTimestamp = s_discord_presence_time_epoch;
+  rp.startTimestamp = s_state.discord_presence_time_epoch;
   rp.details = "No Game Running";
   if (IsValidOrInitializing())
   {
     // Use disc set name if it's not a custom title.
-    if (s_running_game_entry && !s_running_game_entry->disc_set_name.empty() &&
-        s_running_game_title == s_running_game_entry->title)
+    if (s_state.running_game_entry && !s_state.running_game_entry->disc_set_name.empty() &&
+        s_state.running_game_title == s_state.running_game_entry->title)
     {
-      rp.details = s_running_game_entry->disc_set_name.c_str();
+      rp.details = s_state.running_game_entry->disc_set_name.data();
     }
     else
     {
-      rp.details = s_running_game_title.empty() ? "Unknown Game" : s_running_game_title.c_str();
+      rp.details = s_state.running_game_title.empty() ? "Unknown Game" : s_state.running_game_title.c_str();
     }
   }
 
@@ -4946,7 +5682,7 @@ void System::UpdateDiscordPresence(bool update_session_time)
 
 void System::PollDiscordPresence()
 {
-  if (!s_discord_presence_active)
+  if (!s_state.discord_presence_active)
     return;
 
   Discord_RunCallbacks();
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
 
 #pragma once
+#include "bus.h"
 #include "common/timer.h"
 #include "settings.h"
 #include "timing_event.h"
@@ -254,8 +255,23 @@ struct MemorySaveState
 {
   std::unique_ptr<GPUTexture> vram_texture;
   std::unique_ptr<GrowableMemoryByteStream> state_stream;
+
+  // Rewind slots store a zstd-compressed XOR delta against the previous snapshot rather than the
+  // full state. Runahead slots do not use these fields.
+  u32 state_size = 0;
+  u32 delta_size = 0;
+  u32 compressed_size = 0;
+  bool is_delta = false;
+
+  // Runahead slots instead keep a raw copy of guest RAM outside the serialized stream, so a reused
+  // slot only re-copies the pages the game has written since the slot last held a snapshot
+  // (see Bus::EnableRAMWriteTracking). stale_ram_pages is the set where ram_copy may differ from
+  // the current RAM contents.
+  std::unique_ptr<u8[]> ram_copy;
+  u32 ram_copy_size = 0;
+  std::bitset<Bus::RAM_8MB_CODE_PAGE_COUNT> stale_ram_pages{};
 };
-bool SaveMemoryState(MemorySaveState* mss);
+bool SaveMemoryState(MemorySaveState* mss, bool tracked_ram = false);
 bool LoadMemoryState(const MemorySaveState& mss);
 bool LoadStateFromStream(ByteStream* stream, bool update_display, bool ignore_media = false);
 bool SaveStateToStream(ByteStream* state, u32 screenshot_size = 256, u32 compression_method = 0,
@@ -288,6 +304,10 @@ void ResetPerformanceCounters();
 /// Resets vsync/max present fps state.
 void UpdateDisplaySync();
 
+/// Returns true if the GPU can skip scanning out the current frame, because it will never be presented.
+/// Only the case while unthrottled with frame-skipping enabled; VRAM rendering is unaffected.
+bool ShouldSkipRenderingFrame();
+
 // Access controllers for simulating input.
 Controller* GetController(u32 slot);
 void UpdateControllers();
@@ -416,6 +436,16 @@ bool StartDumpingAudio(const char* filename = nullptr);
 /// Stops dumping audio to file if it has been started.
 void StopDumpingAudio();
 
+/// Returns true if currently recording the GPU command stream.
+bool IsRecordingGPUDump();
+
+/// Starts recording the GPU command stream to a file. If no file name is provided, one will be generated
+/// automatically.
+bool StartRecordingGPUDump(const char* filename = nullptr);
+
+/// Stops recording the GPU command stream if it has been started.
+void StopRecordingGPUDump();
+
 /// Saves a screenshot to the specified file. If no file name is provided, one will be generated automatically.
 bool SaveScreenshot(const char* filename = nullptr, DisplayScreenshotMode mode = g_settings.display_screenshot_mode,
                     DisplayScreenshotFormat format = g_settings.display_screenshot_format,
@@ -477,6 +507,11 @@ void UpdateMemorySaveStateSettings();
 bool LoadRewindState(u32 skip_saves = 0, bool consume_state = true);
 void SetRunaheadReplayFlag();
 
+/// Seeks PSF playback to the given offset from the start of the track, by restoring the nearest
+/// preceding seek snapshot and emulating the remainder with audio muted. Returns false if the
+/// system was not booted from a PSF file, or the target cannot be reached from any snapshot.
+bool SeekPsfPlayback(float seconds);
+
 #ifdef ENABLE_DISCORD_PRESENCE
 /// Called when rich presence changes.
 void UpdateDiscordPresence(bool update_session_time);
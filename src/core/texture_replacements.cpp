@@ -8,8 +8,10 @@
 #include "common/bitutils.h"
 #include "common/file_system.h"
 #include "common/log.h"
+#include "common/memory_budget.h"
 #include "common/path.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 #include "common/timer.h"
 
 #include "fmt/format.h"
@@ -18,7 +20,9 @@
 #include "xxh_x86dispatch.h"
 #endif
 
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
 
 Log_SetChannel(TextureReplacements);
 
@@ -60,9 +64,18 @@ bool TextureReplacementHash::ParseString(const std::string_view& sv)
   return true;
 }
 
-TextureReplacements::TextureReplacements() = default;
+TextureReplacements::TextureReplacements()
+{
+  // The registry is constant-initialized, so registering from a global constructor is safe.
+  MemoryBudget::SetReclaimHandler(MemoryBudget::Component::PackTextureCache, &ReclaimPackCacheMemory, this);
+}
 
-TextureReplacements::~TextureReplacements() = default;
+TextureReplacements::~TextureReplacements()
+{
+  MemoryBudget::ClearReclaimHandler(MemoryBudget::Component::PackTextureCache);
+  StopLoaderThread();
+  StopDumperThread();
+}
 
 void TextureReplacements::SetGameID(std::string game_id)
 {
@@ -73,55 +86,82 @@ void TextureReplacements::SetGameID(std::string game_id)
   Reload();
 }
 
-const TextureReplacementTexture* TextureReplacements::GetVRAMWriteReplacement(u32 width, u32 height, const void* pixels)
+const TextureReplacementTexture* TextureReplacements::GetVRAMWriteReplacement(u32 width, u32 height, const void* pixels,
+                                                                              TextureReplacementHash* out_hash)
 {
+  if (m_vram_write_replacements.empty() && m_pack_replacements.empty())
+    return nullptr;
+
+  // When every loaded replacement carries a partial hash, a miss on the cheap prefix hash rules the
+  // write out without touching the rest of its data. Sets with legacy names pay the full hash always.
+  if (m_partial_prefilter_valid &&
+      m_replacement_partial_hashes.find(GetPartialVRAMWriteHash(width, height, pixels)) ==
+        m_replacement_partial_hashes.end())
+  {
+    return nullptr;
+  }
+
   const TextureReplacementHash hash = GetVRAMWriteHash(width, height, pixels);
+  if (out_hash)
+    *out_hash = hash;
 
   const auto it = m_vram_write_replacements.find(hash);
-  if (it == m_vram_write_replacements.end())
-    return nullptr;
+  if (it != m_vram_write_replacements.end())
+    return LoadTexture(it->second);
+
+  const auto pack_it = m_pack_replacements.find(hash);
+  if (pack_it != m_pack_replacements.end())
+    return GetPackReplacement(hash, pack_it->second);
 
-  return LoadTexture(it->second);
+  return nullptr;
 }
 
 void TextureReplacements::DumpVRAMWrite(u32 width, u32 height, const void* pixels)
 {
-  std::string filename = GetVRAMWriteDumpFilename(width, height, pixels);
-  if (filename.empty())
+  if (m_game_id.empty())
     return;
 
-  RGBA8Image image;
-  image.SetSize(width, height);
+  // Hashing, deduplication and the PNG encode all happen on the dumper thread, the upload path
+  // only pays for a copy of the write into a pooled buffer.
+  DumpJob job;
+  job.width = width;
+  job.height = height;
+  job.force_alpha_channel = g_settings.texture_replacements.dump_vram_write_force_alpha_channel;
+  job.dump_directory = GetDumpDirectory();
 
-  const u16* src_pixels = reinterpret_cast<const u16*>(pixels);
-
-  for (u32 y = 0; y < height; y++)
   {
-    for (u32 x = 0; x < width; x++)
+    std::unique_lock lock(m_dumper_mutex);
+    if (!m_dump_buffer_pool.empty())
     {
-      image.SetPixel(x, y, VRAMRGBA5551ToRGBA8888(*src_pixels));
-      src_pixels++;
+      job.pixels = std::move(m_dump_buffer_pool.back());
+      m_dump_buffer_pool.pop_back();
     }
   }
 
-  if (g_settings.texture_replacements.dump_vram_write_force_alpha_channel)
-  {
-    for (u32 y = 0; y < height; y++)
-    {
-      for (u32 x = 0; x < width; x++)
-        image.SetPixel(x, y, image.GetPixel(x, y) | 0xFF000000u);
-    }
-  }
+  job.pixels.resize(width * height);
+  std::memcpy(job.pixels.data(), pixels, width * height * sizeof(u16));
 
-  Log_InfoPrintf("Dumping %ux%u VRAM write to '%s'", width, height, filename.c_str());
-  if (!image.SaveToFile(filename.c_str()))
-    Log_ErrorPrintf("Failed to dump %ux%u VRAM write to '%s'", width, height, filename.c_str());
+  std::unique_lock lock(m_dumper_mutex);
+  if (!m_dumper_thread.joinable())
+    StartDumperThread();
+
+  m_dumper_queue.push_back(std::move(job));
+  m_dumper_wake_cv.notify_one();
 }
 
 void TextureReplacements::Shutdown()
 {
+  StopLoaderThread();
+  StopDumperThread();
+  m_dumper_queue.clear();
+  m_dump_buffer_pool.clear();
+  m_dumped_hashes.clear();
+  ClearPacks();
   m_texture_cache.clear();
   m_vram_write_replacements.clear();
+  m_loose_partial_hashes.clear();
+  m_replacement_partial_hashes.clear();
+  m_partial_prefilter_valid = false;
   m_game_id.clear();
 }
 
@@ -141,35 +181,146 @@ TextureReplacementHash TextureReplacements::GetVRAMWriteHash(u32 width, u32 heig
   return {hash.low64, hash.high64};
 }
 
-std::string TextureReplacements::GetVRAMWriteDumpFilename(u32 width, u32 height, const void* pixels) const
+u64 TextureReplacements::GetPartialVRAMWriteHash(u32 width, u32 height, const void* pixels) const
 {
-  if (m_game_id.empty())
-    return {};
+  // Seeding with the dimensions keeps differently-sized writes which share a prefix apart.
+  const size_t size = width * height * sizeof(u16);
+  return XXH3_64bits_withSeed(pixels, std::min<size_t>(size, PARTIAL_HASH_SIZE),
+                              (ZeroExtend64(width) << 32) | ZeroExtend64(height));
+}
 
-  const TextureReplacementHash hash = GetVRAMWriteHash(width, height, pixels);
-  const std::string dump_directory(GetDumpDirectory());
-  std::string filename(Path::Combine(dump_directory, fmt::format("vram-write-{}.png", hash.ToString())));
+void TextureReplacements::ProcessDumpJob(DumpJob& job)
+{
+  const TextureReplacementHash hash = GetVRAMWriteHash(job.width, job.height, job.pixels.data());
+  const u64 partial_hash = GetPartialVRAMWriteHash(job.width, job.height, job.pixels.data());
+
+  {
+    std::unique_lock lock(m_dumper_mutex);
+    if (!m_dumped_hashes.insert(hash).second)
+      return;
+  }
 
+  const std::string filename(
+    Path::Combine(job.dump_directory, fmt::format("vram-write-{:016x}-{}.png", partial_hash, hash.ToString())));
   if (FileSystem::FileExists(filename.c_str()))
-    return {};
+    return;
+
+  // Don't redump writes which were dumped before the partial hash was added to the name.
+  const std::string legacy_filename(
+    Path::Combine(job.dump_directory, fmt::format("vram-write-{}.png", hash.ToString())));
+  if (FileSystem::FileExists(legacy_filename.c_str()))
+    return;
+
+  if (!FileSystem::EnsureDirectoryExists(job.dump_directory.c_str(), false))
+    return;
+
+  RGBA8Image image;
+  image.SetSize(job.width, job.height);
+
+  const u16* src_pixels = job.pixels.data();
+
+  for (u32 y = 0; y < job.height; y++)
+  {
+    for (u32 x = 0; x < job.width; x++)
+    {
+      image.SetPixel(x, y, VRAMRGBA5551ToRGBA8888(*src_pixels));
+      src_pixels++;
+    }
+  }
 
-  if (!FileSystem::EnsureDirectoryExists(dump_directory.c_str(), false))
-    return {};
+  if (job.force_alpha_channel)
+  {
+    for (u32 y = 0; y < job.height; y++)
+    {
+      for (u32 x = 0; x < job.width; x++)
+        image.SetPixel(x, y, image.GetPixel(x, y) | 0xFF000000u);
+    }
+  }
 
-  return filename;
+  Log_InfoPrintf("Dumping %ux%u VRAM write to '%s'", job.width, job.height, filename.c_str());
+  if (!image.SaveToFile(filename.c_str()))
+    Log_ErrorPrintf("Failed to dump %ux%u VRAM write to '%s'", job.width, job.height, filename.c_str());
+}
+
+void TextureReplacements::StartDumperThread()
+{
+  m_dumper_shutdown.store(false);
+  m_dumper_thread = std::thread(&TextureReplacements::DumperThreadEntryPoint, this);
+}
+
+void TextureReplacements::StopDumperThread()
+{
+  if (!m_dumper_thread.joinable())
+    return;
+
+  // The queue is drained rather than dropped, dump sessions span entire playthroughs and losing
+  // the last few writes at shutdown would leave holes in the set.
+  {
+    std::unique_lock lock(m_dumper_mutex);
+    m_dumper_shutdown.store(true);
+    m_dumper_wake_cv.notify_one();
+  }
+
+  m_dumper_thread.join();
+}
+
+void TextureReplacements::DumperThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("Texture Dumper");
+
+  std::unique_lock lock(m_dumper_mutex);
+  for (;;)
+  {
+    m_dumper_wake_cv.wait(lock, [this]() { return m_dumper_shutdown.load() || !m_dumper_queue.empty(); });
+    if (m_dumper_queue.empty())
+    {
+      if (m_dumper_shutdown.load())
+        break;
+
+      continue;
+    }
+
+    DumpJob job = std::move(m_dumper_queue.front());
+    m_dumper_queue.pop_front();
+    lock.unlock();
+
+    ProcessDumpJob(job);
+
+    lock.lock();
+    m_dump_buffer_pool.push_back(std::move(job.pixels));
+  }
 }
 
 void TextureReplacements::Reload()
 {
+  StopLoaderThread();
+  ClearPacks();
   m_vram_write_replacements.clear();
+  m_loose_partial_hashes.clear();
+
+  {
+    // The dumped-hash filter only serves to skip disk checks, starting over after a game change
+    // just costs a FileExists() per repeated write.
+    std::unique_lock lock(m_dumper_mutex);
+    m_dumped_hashes.clear();
+  }
 
   if (g_settings.texture_replacements.AnyReplacementsEnabled())
-    FindTextures(GetSourceDirectory());
+  {
+    const std::string directory = GetSourceDirectory();
+    FindTextures(directory);
+    FindPacks(directory);
+  }
+
+  UpdatePartialHashPrefilter();
 
   if (g_settings.texture_replacements.preload_textures)
     PreloadTextures();
 
   PurgeUnreferencedTexturesFromCache();
+
+  if (!m_packs.empty())
+    StartLoaderThread();
 }
 
 void TextureReplacements::PurgeUnreferencedTexturesFromCache()
@@ -188,6 +339,7 @@ void TextureReplacements::PurgeUnreferencedTexturesFromCache()
 
 bool TextureReplacements::ParseReplacementFilename(const std::string& filename,
                                                    TextureReplacementHash* replacement_hash,
+                                                   std::optional<u64>* partial_hash,
                                                    ReplacmentType* replacement_type)
 {
   const char* extension = std::strrchr(filename.c_str(), '.');
@@ -215,7 +367,19 @@ bool TextureReplacements::ParseReplacementFilename(const std::string& filename,
     return false;
   }
 
-  if (!replacement_hash->ParseString(std::string_view(hashpart, static_cast<size_t>(extension - hashpart))))
+  // Newer dumps prefix the name with a 16-digit partial hash, older ones are just the full hash.
+  std::string_view hashes(hashpart, static_cast<size_t>(extension - hashpart));
+  partial_hash->reset();
+  if (hashes.length() == 49 && hashes[16] == '-')
+  {
+    *partial_hash = StringUtil::FromChars<u64>(hashes.substr(0, 16), 16);
+    if (!partial_hash->has_value())
+      return false;
+
+    hashes = hashes.substr(17);
+  }
+
+  if (!replacement_hash->ParseString(hashes))
     return false;
 
   extension++;
@@ -244,8 +408,9 @@ void TextureReplacements::FindTextures(const std::string& dir)
       continue;
 
     TextureReplacementHash hash;
+    std::optional<u64> partial_hash;
     ReplacmentType type;
-    if (!ParseReplacementFilename(fd.FileName, &hash, &type))
+    if (!ParseReplacementFilename(fd.FileName, &hash, &partial_hash, &type))
       continue;
 
     switch (type)
@@ -259,6 +424,9 @@ void TextureReplacements::FindTextures(const std::string& dir)
           continue;
         }
 
+        if (partial_hash.has_value())
+          m_loose_partial_hashes.emplace(hash, partial_hash.value());
+
         m_vram_write_replacements.emplace(hash, std::move(fd.FileName));
       }
       break;
@@ -312,3 +480,411 @@ void TextureReplacements::PreloadTextures()
 
 #undef UPDATE_PROGRESS
 }
+
+void TextureReplacements::UpdatePartialHashPrefilter()
+{
+  // The prefilter can only rule writes out when every loaded replacement contributes a partial
+  // hash, otherwise a legacy-named replacement would never match.
+  m_replacement_partial_hashes.clear();
+  m_partial_prefilter_valid = true;
+
+  for (const auto& it : m_vram_write_replacements)
+  {
+    const auto partial_it = m_loose_partial_hashes.find(it.first);
+    if (partial_it == m_loose_partial_hashes.end())
+    {
+      m_partial_prefilter_valid = false;
+      break;
+    }
+
+    m_replacement_partial_hashes.insert(partial_it->second);
+  }
+
+  if (m_partial_prefilter_valid)
+  {
+    for (const auto& it : m_pack_replacements)
+    {
+      const PackEntry& entry = m_packs[it.second.pack_index]->entries[it.second.entry_index];
+      if (!entry.partial_hash_valid)
+      {
+        m_partial_prefilter_valid = false;
+        break;
+      }
+
+      m_replacement_partial_hashes.insert(entry.partial_hash);
+    }
+  }
+
+  if (!m_partial_prefilter_valid)
+  {
+    m_replacement_partial_hashes.clear();
+    if (!m_vram_write_replacements.empty() || !m_pack_replacements.empty())
+      Log_WarningPrintf("Replacements without partial hashes present, hash prefilter disabled");
+  }
+}
+
+void TextureReplacements::FindPacks(const std::string& dir)
+{
+  FileSystem::FindResultsArray files;
+  FileSystem::FindFiles(dir.c_str(), "*.dstexpack", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_RECURSIVE, &files);
+
+  for (FILESYSTEM_FIND_DATA& fd : files)
+  {
+    if (fd.Attributes & FILESYSTEM_FILE_ATTRIBUTE_DIRECTORY)
+      continue;
+
+    LoadPack(std::move(fd.FileName));
+  }
+}
+
+bool TextureReplacements::LoadPack(std::string filename)
+{
+  FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(filename.c_str(), "rb");
+  if (!fp)
+  {
+    Log_ErrorPrintf("Failed to open replacement pack '%s'", filename.c_str());
+    return false;
+  }
+
+  PackHeader header;
+  if (std::fread(&header, sizeof(header), 1, fp.get()) != 1 || header.signature != PACK_SIGNATURE ||
+      header.version != PACK_VERSION)
+  {
+    Log_ErrorPrintf("Replacement pack '%s' has an invalid header", filename.c_str());
+    return false;
+  }
+
+  std::unique_ptr<ReplacementPack> pack = std::make_unique<ReplacementPack>();
+  pack->entries.resize(header.num_entries);
+  if (header.num_entries == 0 ||
+      std::fread(pack->entries.data(), sizeof(PackEntry), header.num_entries, fp.get()) != header.num_entries)
+  {
+    Log_ErrorPrintf("Failed to read %u entries from replacement pack '%s'", header.num_entries, filename.c_str());
+    return false;
+  }
+
+  const s64 file_size = FileSystem::FSize64(fp.get());
+  for (const PackEntry& entry : pack->entries)
+  {
+    const u64 data_size = ZeroExtend64(entry.width) * ZeroExtend64(entry.height) * sizeof(u32);
+    if (entry.width == 0 || entry.height == 0 || file_size < 0 ||
+        (entry.data_offset + data_size) > static_cast<u64>(file_size))
+    {
+      Log_ErrorPrintf("Replacement pack '%s' has an out-of-range entry", filename.c_str());
+      return false;
+    }
+  }
+
+  const u32 pack_index = static_cast<u32>(m_packs.size());
+  u32 num_registered = 0;
+  for (u32 i = 0; i < header.num_entries; i++)
+  {
+    const PackEntry& entry = pack->entries[i];
+
+    // Loose files take priority, so individual textures from a pack can still be overridden.
+    if (m_vram_write_replacements.find(entry.hash) != m_vram_write_replacements.end())
+      continue;
+
+    if (!m_pack_replacements.emplace(entry.hash, PackEntryRef{pack_index, i}).second)
+    {
+      Log_WarningPrintf("Duplicate replacement '%s' in pack '%s'", entry.hash.ToString().c_str(), filename.c_str());
+      continue;
+    }
+
+    num_registered++;
+  }
+
+  Log_InfoPrintf("Loaded %u replacement textures from pack '%s'", num_registered, filename.c_str());
+  pack->filename = std::move(filename);
+  pack->fp = std::move(fp);
+  m_packs.push_back(std::move(pack));
+  return true;
+}
+
+void TextureReplacements::ClearPacks()
+{
+  {
+    std::unique_lock lock(m_pack_cache_mutex);
+    m_pack_cache.clear();
+    m_pack_cache_size = 0;
+    m_pack_cache_counter = 0;
+    m_pack_cache_pinned_hash = {};
+    MemoryBudget::SetUsage(MemoryBudget::Component::PackTextureCache, 0);
+  }
+
+  m_loader_queue.clear();
+  m_pack_replacements.clear();
+  m_packs.clear();
+}
+
+const TextureReplacementTexture* TextureReplacements::GetPackReplacement(const TextureReplacementHash& hash,
+                                                                         const PackEntryRef& ref)
+{
+  {
+    std::unique_lock lock(m_pack_cache_mutex);
+    PackCache::iterator it = m_pack_cache.find(hash);
+    if (it != m_pack_cache.end())
+    {
+      it->second.last_access = ++m_pack_cache_counter;
+      m_pack_cache_pinned_hash = hash;
+      QueuePackPrefetch(ref);
+      return &it->second.texture;
+    }
+  }
+
+  // Cache miss - read on the calling thread, a seek and copy is cheap compared to an image decode.
+  TextureReplacementTexture texture;
+  if (!ReadPackEntry(ref, &texture))
+    return nullptr;
+
+  std::unique_lock lock(m_pack_cache_mutex);
+  const TextureReplacementTexture* ret = AddPackTextureToCache(hash, std::move(texture));
+  m_pack_cache_pinned_hash = hash;
+  QueuePackPrefetch(ref);
+  return ret;
+}
+
+bool TextureReplacements::ReadPackEntry(const PackEntryRef& ref, TextureReplacementTexture* texture)
+{
+  ReplacementPack* pack = m_packs[ref.pack_index].get();
+  const PackEntry& entry = pack->entries[ref.entry_index];
+
+  std::vector<u32> pixels(entry.width * entry.height);
+
+  {
+    std::unique_lock lock(pack->file_mutex);
+    if (FileSystem::FSeek64(pack->fp.get(), static_cast<s64>(entry.data_offset), SEEK_SET) != 0 ||
+        std::fread(pixels.data(), sizeof(u32), pixels.size(), pack->fp.get()) != pixels.size())
+    {
+      Log_ErrorPrintf("Failed to read %ux%u texture at offset %" PRIu64 " from pack '%s'", entry.width, entry.height,
+                      entry.data_offset, pack->filename.c_str());
+      return false;
+    }
+  }
+
+  texture->SetPixels(entry.width, entry.height, std::move(pixels));
+  return true;
+}
+
+const TextureReplacementTexture* TextureReplacements::AddPackTextureToCache(const TextureReplacementHash& hash,
+                                                                            TextureReplacementTexture texture)
+{
+  const size_t size = texture.GetWidth() * texture.GetHeight() * sizeof(u32);
+  EvictPackCache(size);
+
+  PackCacheEntry entry;
+  entry.texture = std::move(texture);
+  entry.last_access = ++m_pack_cache_counter;
+
+  const auto ip = m_pack_cache.emplace(hash, std::move(entry));
+  if (ip.second)
+    m_pack_cache_size += size;
+  else
+    ip.first->second.last_access = m_pack_cache_counter;
+
+  MemoryBudget::SetUsage(MemoryBudget::Component::PackTextureCache, m_pack_cache_size);
+  return &ip.first->second.texture;
+}
+
+void TextureReplacements::EvictPackCache(size_t required_size)
+{
+  const size_t budget =
+    static_cast<size_t>(g_settings.texture_replacements.replacement_cache_size_mb) * 1048576;
+
+  while (!m_pack_cache.empty() && (m_pack_cache_size + required_size) > budget)
+  {
+    PackCache::iterator lowest = m_pack_cache.end();
+    for (PackCache::iterator it = m_pack_cache.begin(); it != m_pack_cache.end(); ++it)
+    {
+      // The texture most recently handed out may still be in use by the VRAM blit, never drop it.
+      if (it->first == m_pack_cache_pinned_hash)
+        continue;
+
+      if (lowest == m_pack_cache.end() || it->second.last_access < lowest->second.last_access)
+        lowest = it;
+    }
+    if (lowest == m_pack_cache.end())
+      break;
+
+    m_pack_cache_size -=
+      lowest->second.texture.GetWidth() * lowest->second.texture.GetHeight() * sizeof(u32);
+    m_pack_cache.erase(lowest);
+  }
+
+  MemoryBudget::SetUsage(MemoryBudget::Component::PackTextureCache, m_pack_cache_size);
+}
+
+u64 TextureReplacements::ReclaimPackCacheMemory(void* userdata, u64 bytes_requested)
+{
+  // Invoked from whichever thread is trying to allocate, so take the cache lock. Shrinking the
+  // cache only costs re-reads from the pack file, making this the cheapest reclaim after covers.
+  TextureReplacements* self = static_cast<TextureReplacements*>(userdata);
+  std::unique_lock lock(self->m_pack_cache_mutex);
+
+  const size_t old_size = self->m_pack_cache_size;
+  const size_t target = (bytes_requested < old_size) ? (old_size - static_cast<size_t>(bytes_requested)) : 0;
+
+  // EvictPackCache() trims to the configured budget less required_size; express the target the same way.
+  const size_t budget =
+    static_cast<size_t>(g_settings.texture_replacements.replacement_cache_size_mb) * 1048576;
+  if (budget > target)
+    self->EvictPackCache(budget - target);
+
+  return static_cast<u64>(old_size - self->m_pack_cache_size);
+}
+
+void TextureReplacements::QueuePackPrefetch(const PackEntryRef& ref)
+{
+  // Packs are written in discovery order, which approximates the order the game uploads textures
+  // in, so warming the following entries hides the read latency for the rest of the scene.
+  const ReplacementPack* pack = m_packs[ref.pack_index].get();
+  const u32 first = ref.entry_index + 1;
+  const u32 end = std::min(first + PACK_PREFETCH_COUNT, static_cast<u32>(pack->entries.size()));
+  if (first >= end)
+    return;
+
+  std::unique_lock lock(m_loader_mutex);
+  for (u32 i = first; i < end; i++)
+    m_loader_queue.push_back(PackEntryRef{ref.pack_index, i});
+  m_loader_wake_cv.notify_one();
+}
+
+void TextureReplacements::StartLoaderThread()
+{
+  m_loader_shutdown.store(false);
+  m_loader_thread = std::thread(&TextureReplacements::LoaderThreadEntryPoint, this);
+}
+
+void TextureReplacements::StopLoaderThread()
+{
+  if (!m_loader_thread.joinable())
+    return;
+
+  {
+    std::unique_lock lock(m_loader_mutex);
+    m_loader_shutdown.store(true);
+    m_loader_queue.clear();
+    m_loader_wake_cv.notify_one();
+  }
+
+  m_loader_thread.join();
+}
+
+void TextureReplacements::LoaderThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("Texture Pack Loader");
+
+  std::unique_lock lock(m_loader_mutex);
+  for (;;)
+  {
+    m_loader_wake_cv.wait(lock, [this]() { return m_loader_shutdown.load() || !m_loader_queue.empty(); });
+    if (m_loader_shutdown.load())
+      break;
+
+    const PackEntryRef ref = m_loader_queue.front();
+    m_loader_queue.pop_front();
+    lock.unlock();
+
+    const TextureReplacementHash hash = m_packs[ref.pack_index]->entries[ref.entry_index].hash;
+
+    bool cached;
+    {
+      std::unique_lock cache_lock(m_pack_cache_mutex);
+      cached = (m_pack_cache.find(hash) != m_pack_cache.end());
+    }
+
+    if (!cached)
+    {
+      TextureReplacementTexture texture;
+      if (ReadPackEntry(ref, &texture))
+      {
+        std::unique_lock cache_lock(m_pack_cache_mutex);
+        AddPackTextureToCache(hash, std::move(texture));
+      }
+    }
+
+    lock.lock();
+  }
+}
+
+bool TextureReplacements::CompileReplacementPack()
+{
+  if (m_game_id.empty() || m_vram_write_replacements.empty())
+  {
+    Log_ErrorPrintf("No loose replacement textures to pack for '%s'", m_game_id.c_str());
+    return false;
+  }
+
+  const std::string filename = Path::Combine(GetSourceDirectory(), "replacements.dstexpack");
+  FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(filename.c_str(), "wb");
+  if (!fp)
+  {
+    Log_ErrorPrintf("Failed to open '%s' for writing", filename.c_str());
+    return false;
+  }
+
+  static constexpr float UPDATE_INTERVAL = 1.0f;
+
+  Common::Timer last_update_time;
+  u32 num_textures_packed = 0;
+  const u32 total_textures = static_cast<u32>(m_vram_write_replacements.size());
+
+  // The index is written last, once the image sizes are known, but space for the worst case is
+  // reserved up front so the data offsets are final. Entries which fail to load leave a gap.
+  std::vector<PackEntry> entries;
+  entries.reserve(total_textures);
+  if (FileSystem::FSeek64(fp.get(), static_cast<s64>(sizeof(PackHeader) + (sizeof(PackEntry) * total_textures)),
+                          SEEK_SET) != 0)
+  {
+    return false;
+  }
+
+  for (const auto& it : m_vram_write_replacements)
+  {
+    if (last_update_time.GetTimeSeconds() >= UPDATE_INTERVAL)
+    {
+      Host::DisplayLoadingScreen("Compiling texture replacement pack...", 0, static_cast<int>(total_textures),
+                                 static_cast<int>(num_textures_packed));
+      last_update_time.Reset();
+    }
+
+    num_textures_packed++;
+
+    RGBA8Image image;
+    if (!image.LoadFromFile(it.second.c_str()))
+    {
+      Log_WarningPrintf("Skipping '%s', it failed to load", it.second.c_str());
+      continue;
+    }
+
+    const auto partial_it = m_loose_partial_hashes.find(it.first);
+
+    PackEntry entry;
+    entry.hash = it.first;
+    entry.partial_hash = (partial_it != m_loose_partial_hashes.end()) ? partial_it->second : 0;
+    entry.partial_hash_valid = BoolToUInt32(partial_it != m_loose_partial_hashes.end());
+    entry.width = image.GetWidth();
+    entry.height = image.GetHeight();
+    entry.unused = 0;
+    entry.data_offset = static_cast<u64>(FileSystem::FTell64(fp.get()));
+    if (std::fwrite(image.GetPixels(), sizeof(u32), image.GetWidth() * image.GetHeight(), fp.get()) !=
+        (image.GetWidth() * image.GetHeight()))
+    {
+      Log_ErrorPrintf("Failed to write pixel data to '%s'", filename.c_str());
+      return false;
+    }
+
+    entries.push_back(entry);
+  }
+
+  const PackHeader header = {PACK_SIGNATURE, PACK_VERSION, static_cast<u32>(entries.size()), 0};
+  if (FileSystem::FSeek64(fp.get(), 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, fp.get()) != 1 ||
+      std::fwrite(entries.data(), sizeof(PackEntry), entries.size(), fp.get()) != entries.size())
+  {
+    Log_ErrorPrintf("Failed to write index to '%s'", filename.c_str());
+    return false;
+  }
+
+  Log_InfoPrintf("Packed %zu replacement textures into '%s'", entries.size(), filename.c_str());
+  return true;
+}
@@ -5,13 +5,22 @@
 
 #include "util/image.h"
 
+#include "common/file_system.h"
 #include "common/hash_combine.h"
 
 #include "types.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 struct TextureReplacementHash
@@ -58,9 +67,16 @@ public:
 
   void Reload();
 
-  const TextureReplacementTexture* GetVRAMWriteReplacement(u32 width, u32 height, const void* pixels);
+  /// Returns the replacement for a VRAM write, if any. When a replacement is found, out_hash
+  /// receives the write's content hash, which callers can use to key their own caches.
+  const TextureReplacementTexture* GetVRAMWriteReplacement(u32 width, u32 height, const void* pixels,
+                                                           TextureReplacementHash* out_hash = nullptr);
   void DumpVRAMWrite(u32 width, u32 height, const void* pixels);
 
+  /// Packs the loose replacement images for the current game into a single .dstexpack archive,
+  /// which is loaded in place of them and streamed on demand instead of being decoded per file.
+  bool CompileReplacementPack();
+
   void Shutdown();
 
 private:
@@ -72,26 +88,137 @@ private:
   using VRAMWriteReplacementMap = std::unordered_map<TextureReplacementHash, std::string>;
   using TextureCache = std::unordered_map<std::string, TextureReplacementTexture>;
 
+  enum : u32
+  {
+    PACK_SIGNATURE = 0x50545344, // 'DSTP'
+    PACK_VERSION = 2,
+    PACK_PREFETCH_COUNT = 16,
+
+    // Number of leading bytes of a VRAM write covered by the partial hash prefilter.
+    PARTIAL_HASH_SIZE = 1024,
+  };
+
+  struct PackHeader
+  {
+    u32 signature;
+    u32 version;
+    u32 num_entries;
+    u32 unused;
+  };
+
+  struct PackEntry
+  {
+    TextureReplacementHash hash;
+    u64 partial_hash;
+    u32 partial_hash_valid;
+    u32 width;
+    u32 height;
+    u32 unused;
+    u64 data_offset; // raw RGBA8 rows, width * height * 4 bytes
+  };
+  static_assert(sizeof(PackEntry) == 48, "pack entries are tightly packed");
+
+  struct ReplacementPack
+  {
+    std::string filename;
+    FileSystem::ManagedCFilePtr fp;
+    std::vector<PackEntry> entries;
+    std::mutex file_mutex;
+  };
+
+  struct PackEntryRef
+  {
+    u32 pack_index;
+    u32 entry_index;
+  };
+
+  struct PackCacheEntry
+  {
+    TextureReplacementTexture texture;
+    u64 last_access;
+  };
+
+  using PackReplacementMap = std::unordered_map<TextureReplacementHash, PackEntryRef>;
+  using PackCache = std::unordered_map<TextureReplacementHash, PackCacheEntry>;
+
+  struct DumpJob
+  {
+    u32 width;
+    u32 height;
+    bool force_alpha_channel;
+    std::string dump_directory;
+    std::vector<u16> pixels;
+  };
+
   static bool ParseReplacementFilename(const std::string& filename, TextureReplacementHash* replacement_hash,
-                                       ReplacmentType* replacement_type);
+                                       std::optional<u64>* partial_hash, ReplacmentType* replacement_type);
 
   std::string GetSourceDirectory() const;
   std::string GetDumpDirectory() const;
 
   TextureReplacementHash GetVRAMWriteHash(u32 width, u32 height, const void* pixels) const;
-  std::string GetVRAMWriteDumpFilename(u32 width, u32 height, const void* pixels) const;
+  u64 GetPartialVRAMWriteHash(u32 width, u32 height, const void* pixels) const;
 
   void FindTextures(const std::string& dir);
+  void UpdatePartialHashPrefilter();
 
   const TextureReplacementTexture* LoadTexture(const std::string& filename);
   void PreloadTextures();
   void PurgeUnreferencedTexturesFromCache();
 
+  void FindPacks(const std::string& dir);
+  bool LoadPack(std::string filename);
+  void ClearPacks();
+
+  const TextureReplacementTexture* GetPackReplacement(const TextureReplacementHash& hash, const PackEntryRef& ref);
+  bool ReadPackEntry(const PackEntryRef& ref, TextureReplacementTexture* texture);
+  const TextureReplacementTexture* AddPackTextureToCache(const TextureReplacementHash& hash,
+                                                         TextureReplacementTexture texture); // cache lock held
+  void EvictPackCache(size_t required_size);                                                 // cache lock held
+  static u64 ReclaimPackCacheMemory(void* userdata, u64 bytes_requested);
+  void QueuePackPrefetch(const PackEntryRef& ref);
+
+  void StartLoaderThread();
+  void StopLoaderThread();
+  void LoaderThreadEntryPoint();
+
+  void ProcessDumpJob(DumpJob& job);
+  void StartDumperThread();
+  void StopDumperThread();
+  void DumperThreadEntryPoint();
+
   std::string m_game_id;
 
   TextureCache m_texture_cache;
 
   VRAMWriteReplacementMap m_vram_write_replacements;
+  std::unordered_map<TextureReplacementHash, u64> m_loose_partial_hashes;
+
+  std::unordered_set<u64> m_replacement_partial_hashes;
+  bool m_partial_prefilter_valid = false;
+
+  std::vector<std::unique_ptr<ReplacementPack>> m_packs;
+  PackReplacementMap m_pack_replacements;
+
+  std::mutex m_pack_cache_mutex;
+  PackCache m_pack_cache;
+  size_t m_pack_cache_size = 0;
+  u64 m_pack_cache_counter = 0;
+  TextureReplacementHash m_pack_cache_pinned_hash = {};
+
+  std::thread m_loader_thread;
+  std::mutex m_loader_mutex;
+  std::condition_variable m_loader_wake_cv;
+  std::deque<PackEntryRef> m_loader_queue;
+  std::atomic_bool m_loader_shutdown{false};
+
+  std::thread m_dumper_thread;
+  std::mutex m_dumper_mutex;
+  std::condition_variable m_dumper_wake_cv;
+  std::deque<DumpJob> m_dumper_queue;
+  std::vector<std::vector<u16>> m_dump_buffer_pool;
+  std::unordered_set<TextureReplacementHash> m_dumped_hashes;
+  std::atomic_bool m_dumper_shutdown{false};
 };
 
 extern TextureReplacements g_texture_replacements;
\ No newline at end of file
@@ -73,6 +73,10 @@ static void AddSysClkTicks(void*, TickCount sysclk_ticks, TickCount ticks_late);
 static TickCount GetTicksUntilNextInterrupt();
 static void UpdateSysClkEvent();
 
+// Maximum time between sysclk event invocations when no timer has an IRQ deadline. Counters are
+// caught up on register access, so this only bounds how many ticks accumulate in one catch-up.
+static constexpr TickCount NO_IRQ_UPDATE_PERIOD = static_cast<TickCount>(System::MASTER_CLOCK);
+
 static std::unique_ptr<TimingEvent> s_sysclk_event;
 
 static std::array<CounterState, NUM_TIMERS> s_states{};
@@ -437,7 +441,10 @@ void Timers::UpdateIRQ(u32 index)
 
 TickCount Timers::GetTicksUntilNextInterrupt()
 {
-  TickCount min_ticks = System::GetMaxSliceTicks();
+  // When no counter has an IRQ deadline, there is no reason to wake up at slice granularity just
+  // to advance counters; they are caught up lazily when the registers are read or written. The
+  // period only needs to be short enough that the catch-up tick count cannot overflow.
+  TickCount min_ticks = NO_IRQ_UPDATE_PERIOD;
   for (u32 i = 0; i < NUM_TIMERS; i++)
   {
     const CounterState& cs = s_states[i];
@@ -447,6 +454,12 @@ TickCount Timers::GetTicksUntilNextInterrupt()
       continue;
     }
 
+    // One-shot IRQs which have already fired can't fire again until the mode register is
+    // rewritten, and in pulse mode the request bit does not latch, so hitting the target or
+    // overflow changes nothing observable. Skip the deadline rather than waking every period.
+    if (!cs.mode.irq_repeat && cs.irq_done && !cs.mode.irq_pulse_n)
+      continue;
+
     if (cs.mode.irq_at_target)
     {
       TickCount ticks = (cs.counter <= cs.target) ? static_cast<TickCount>(cs.target - cs.counter) :
@@ -4,24 +4,33 @@
 #include "timing_event.h"
 #include "common/assert.h"
 #include "common/log.h"
+#include "common/thirdparty/SmallVector.h"
 #include "cpu_core.h"
 #include "cpu_core_private.h"
 #include "system.h"
 #include "util/state_wrapper.h"
+
+#include <limits>
+
 Log_SetChannel(TimingEvents);
 
 namespace TimingEvents {
 
-static TimingEvent* s_active_events_head;
-static TimingEvent* s_active_events_tail;
+// Active events are kept in a binary min-heap on their absolute deadline, with each event tracking
+// its own heap index, giving O(log n) reschedules. Deadlines sit on a monotonic 64-bit timeline
+// (s_current_time), so consuming a slice is a single addition instead of walking every event to
+// decrement a relative downcount. The distance to the root's deadline is mirrored in
+// s_next_event_downcount so the dispatcher's per-slice check stays a single load and compare.
+// Inline storage keeps the heap in static memory; the system never comes close to 32 events.
+static llvm::SmallVector<TimingEvent*, 32> s_event_heap;
 static TimingEvent* s_current_event = nullptr;
-static u32 s_active_event_count = 0;
-static u32 s_global_tick_counter = 0;
+static TickCount s_next_event_downcount = std::numeric_limits<TickCount>::max();
+static u64 s_current_time = 0;
 static bool s_frame_done = false;
 
 u32 GetGlobalTickCounter()
 {
-  return s_global_tick_counter;
+  return static_cast<u32>(s_current_time);
 }
 
 void Initialize()
@@ -31,12 +40,20 @@ void Initialize()
 
 void Reset()
 {
-  s_global_tick_counter = 0;
+  // The timeline restarts, so rebase any still-active deadlines onto the new epoch. A uniform
+  // shift keeps both the heap order and the mirrored downcount valid.
+  for (TimingEvent* event : s_event_heap)
+  {
+    event->m_deadline -= s_current_time;
+    event->m_last_run_time -= s_current_time;
+  }
+
+  s_current_time = 0;
 }
 
 void Shutdown()
 {
-  Assert(s_active_event_count == 0);
+  Assert(s_event_heap.empty());
 }
 
 std::unique_ptr<TimingEvent> CreateTimingEvent(std::string name, TickCount period, TickCount interval,
@@ -52,215 +69,120 @@ std::unique_ptr<TimingEvent> CreateTimingEvent(std::string name, TickCount perio
 
 void UpdateCPUDowncount()
 {
-  const u32 event_downcount = s_active_events_head->GetDowncount();
-  CPU::g_state.downcount = CPU::HasPendingInterrupt() ? 0 : event_downcount;
+  CPU::g_state.downcount = CPU::HasPendingInterrupt() ? 0 : static_cast<u32>(s_next_event_downcount);
 }
 
-TimingEvent** GetHeadEventPtr()
+const TickCount* GetNextEventDowncountPtr()
 {
-  return &s_active_events_head;
+  return &s_next_event_downcount;
 }
 
-static void SortEvent(TimingEvent* event)
+static void HeapSiftUp(u32 index)
 {
-  const TickCount event_downcount = event->m_downcount;
+  TimingEvent* const event = s_event_heap[index];
+  const u64 event_deadline = event->m_deadline;
 
-  if (event->prev && event->prev->m_downcount > event_downcount)
+  while (index > 0)
   {
-    // move backwards
-    TimingEvent* current = event->prev;
-    while (current && current->m_downcount > event_downcount)
-      current = current->prev;
-
-    // unlink
-    if (event->prev)
-      event->prev->next = event->next;
-    else
-      s_active_events_head = event->next;
-    if (event->next)
-      event->next->prev = event->prev;
-    else
-      s_active_events_tail = event->prev;
-
-    // insert after current
-    if (current)
-    {
-      event->next = current->next;
-      if (current->next)
-        current->next->prev = event;
-      else
-        s_active_events_tail = event;
-
-      event->prev = current;
-      current->next = event;
-    }
-    else
-    {
-      // insert at front
-      DebugAssert(s_active_events_head);
-      s_active_events_head->prev = event;
-      event->prev = nullptr;
-      event->next = s_active_events_head;
-      s_active_events_head = event;
-      UpdateCPUDowncount();
-    }
+    const u32 parent_index = (index - 1) / 2;
+    TimingEvent* const parent = s_event_heap[parent_index];
+    if (parent->m_deadline <= event_deadline)
+      break;
+
+    s_event_heap[index] = parent;
+    parent->m_heap_index = index;
+    index = parent_index;
   }
-  else if (event->next && event_downcount > event->next->m_downcount)
-  {
-    // move forwards
-    TimingEvent* current = event->next;
-    while (current && event_downcount > current->m_downcount)
-      current = current->next;
-
-    // unlink
-    if (event->prev)
-    {
-      event->prev->next = event->next;
-    }
-    else
-    {
-      s_active_events_head = event->next;
-      UpdateCPUDowncount();
-    }
-    if (event->next)
-      event->next->prev = event->prev;
-    else
-      s_active_events_tail = event->prev;
-
-    // insert before current
-    if (current)
-    {
-      event->next = current;
-      event->prev = current->prev;
-
-      if (current->prev)
-      {
-        current->prev->next = event;
-      }
-      else
-      {
-        s_active_events_head = event;
-        UpdateCPUDowncount();
-      }
 
-      current->prev = event;
-    }
-    else
-    {
-      // insert at back
-      DebugAssert(s_active_events_tail);
-      s_active_events_tail->next = event;
-      event->next = nullptr;
-      event->prev = s_active_events_tail;
-      s_active_events_tail = event;
-    }
-  }
+  s_event_heap[index] = event;
+  event->m_heap_index = index;
 }
 
-static void AddActiveEvent(TimingEvent* event)
+static void HeapSiftDown(u32 index)
 {
-  DebugAssert(!event->prev && !event->next);
-  s_active_event_count++;
+  const u32 size = static_cast<u32>(s_event_heap.size());
+  TimingEvent* const event = s_event_heap[index];
+  const u64 event_deadline = event->m_deadline;
 
-  TimingEvent* current = nullptr;
-  TimingEvent* next = s_active_events_head;
-  while (next && event->m_downcount > next->m_downcount)
+  for (;;)
   {
-    current = next;
-    next = next->next;
-  }
+    u32 child_index = (index * 2) + 1;
+    if (child_index >= size)
+      break;
 
-  if (!next)
-  {
-    // new tail
-    event->prev = s_active_events_tail;
-    if (s_active_events_tail)
-    {
-      s_active_events_tail->next = event;
-      s_active_events_tail = event;
-    }
-    else
-    {
-      // first event
-      s_active_events_tail = event;
-      s_active_events_head = event;
-      UpdateCPUDowncount();
-    }
+    if ((child_index + 1) < size && s_event_heap[child_index + 1]->m_deadline < s_event_heap[child_index]->m_deadline)
+      child_index++;
+
+    if (event_deadline <= s_event_heap[child_index]->m_deadline)
+      break;
+
+    s_event_heap[index] = s_event_heap[child_index];
+    s_event_heap[index]->m_heap_index = index;
+    index = child_index;
   }
-  else if (!current)
+
+  s_event_heap[index] = event;
+  event->m_heap_index = index;
+}
+
+static void UpdateNextEventDowncount()
+{
+  const TickCount downcount =
+    s_event_heap.empty() ? std::numeric_limits<TickCount>::max() :
+                           static_cast<TickCount>(s_event_heap.front()->m_deadline - s_current_time);
+  if (downcount != s_next_event_downcount)
   {
-    // new head
-    event->next = s_active_events_head;
-    s_active_events_head->prev = event;
-    s_active_events_head = event;
+    s_next_event_downcount = downcount;
     UpdateCPUDowncount();
   }
-  else
-  {
-    // inbetween current < event > next
-    event->prev = current;
-    event->next = next;
-    current->next = event;
-    next->prev = event;
-  }
 }
 
-static void RemoveActiveEvent(TimingEvent* event)
+static void SortEvent(TimingEvent* event)
 {
-  DebugAssert(s_active_event_count > 0);
+  HeapSiftUp(event->m_heap_index);
+  HeapSiftDown(event->m_heap_index);
+  UpdateNextEventDowncount();
+}
 
-  if (event->next)
-  {
-    event->next->prev = event->prev;
-  }
-  else
-  {
-    s_active_events_tail = event->prev;
-  }
+static void AddActiveEvent(TimingEvent* event)
+{
+  event->m_heap_index = static_cast<u32>(s_event_heap.size());
+  s_event_heap.push_back(event);
+  HeapSiftUp(event->m_heap_index);
+  UpdateNextEventDowncount();
+}
 
-  if (event->prev)
-  {
-    event->prev->next = event->next;
-  }
-  else
+static void RemoveActiveEvent(TimingEvent* event)
+{
+  DebugAssert(!s_event_heap.empty() && s_event_heap[event->m_heap_index] == event);
+
+  const u32 index = event->m_heap_index;
+  TimingEvent* const moved = s_event_heap.back();
+  s_event_heap.pop_back();
+  if (moved != event)
   {
-    s_active_events_head = event->next;
-    if (s_active_events_head)
-      UpdateCPUDowncount();
+    s_event_heap[index] = moved;
+    moved->m_heap_index = index;
+    HeapSiftUp(index);
+    HeapSiftDown(moved->m_heap_index);
   }
 
-  event->prev = nullptr;
-  event->next = nullptr;
-
-  s_active_event_count--;
+  UpdateNextEventDowncount();
 }
 
 static void SortEvents()
 {
-  std::vector<TimingEvent*> events;
-  events.reserve(s_active_event_count);
+  // Heap indices are still valid after a state load, only the keys changed, so re-heapify in place.
+  const u32 size = static_cast<u32>(s_event_heap.size());
+  for (u32 i = (size / 2); i > 0; i--)
+    HeapSiftDown(i - 1);
 
-  TimingEvent* next = s_active_events_head;
-  while (next)
-  {
-    TimingEvent* current = next;
-    events.push_back(current);
-    next = current->next;
-    current->prev = nullptr;
-    current->next = nullptr;
-  }
-
-  s_active_events_head = nullptr;
-  s_active_events_tail = nullptr;
-  s_active_event_count = 0;
-
-  for (TimingEvent* event : events)
-    AddActiveEvent(event);
+  UpdateNextEventDowncount();
 }
 
 static TimingEvent* FindActiveEvent(const char* name)
 {
-  for (TimingEvent* event = s_active_events_head; event; event = event->next)
+  for (TimingEvent* event : s_event_heap)
   {
     if (event->GetName().compare(name) == 0)
       return event;
@@ -290,36 +212,30 @@ void RunEvents()
       CPU::DispatchInterrupt();
 
     TickCount pending_ticks = CPU::GetPendingTicks();
-    if (pending_ticks >= s_active_events_head->GetDowncount())
+    if (pending_ticks >= s_next_event_downcount)
     {
       CPU::ResetPendingTicks();
 
       do
       {
-        const TickCount time = std::min(pending_ticks, s_active_events_head->GetDowncount());
-        s_global_tick_counter += static_cast<u32>(time);
+        // Advancing the timeline is all that "charging" the slice to the events takes; the
+        // deadlines are absolute, so late events are simply those at or below the new time.
+        const TickCount time = std::min(pending_ticks, s_next_event_downcount);
+        s_current_time += static_cast<u32>(time);
         pending_ticks -= time;
-
-        // Apply downcount to all events.
-        // This will result in a negative downcount for those events which are late.
-        for (TimingEvent* event = s_active_events_head; event; event = event->next)
-        {
-          event->m_downcount -= time;
-          event->m_time_since_last_run += time;
-        }
+        s_next_event_downcount -= time;
 
         // Now we can actually run the callbacks.
-        while (s_active_events_head->m_downcount <= 0)
+        while (!s_event_heap.empty() && s_event_heap.front()->m_deadline <= s_current_time)
         {
-          // move it to the end, since that'll likely be its new position
-          TimingEvent* event = s_active_events_head;
+          TimingEvent* event = s_event_heap.front();
           s_current_event = event;
 
           // Factor late time into the time for the next invocation.
-          const TickCount ticks_late = -event->m_downcount;
-          const TickCount ticks_to_execute = event->m_time_since_last_run;
-          event->m_downcount += event->m_interval;
-          event->m_time_since_last_run = 0;
+          const TickCount ticks_late = static_cast<TickCount>(s_current_time - event->m_deadline);
+          const TickCount ticks_to_execute = static_cast<TickCount>(s_current_time - event->m_last_run_time);
+          event->m_deadline += static_cast<u32>(event->m_interval);
+          event->m_last_run_time = s_current_time;
 
           // The cycles_late is only an indicator, it doesn't modify the cycles to execute.
           event->m_callback(event->m_callback_param, ticks_to_execute, ticks_late);
@@ -343,10 +259,15 @@ void RunEvents()
 
 bool DoState(StateWrapper& sw)
 {
-  sw.Do(&s_global_tick_counter);
+  // The stream format stays base-relative; only the low 32 bits of the timeline are meaningful
+  // across a load, and the events are rebuilt against the fresh epoch below.
+  u32 global_tick_counter = static_cast<u32>(s_current_time);
+  sw.Do(&global_tick_counter);
 
   if (sw.IsReading())
   {
+    s_current_time = ZeroExtend64(global_tick_counter);
+
     // Load timestamps for the clock events.
     // Any oneshot events should be recreated by the load state method, so we can fix up their times here.
     u32 event_count = 0;
@@ -372,8 +293,8 @@ bool DoState(StateWrapper& sw)
       }
 
       // Using reschedule is safe here since we call sort afterwards.
-      event->m_downcount = downcount;
-      event->m_time_since_last_run = time_since_last_run;
+      event->m_deadline = s_current_time + static_cast<s64>(downcount);
+      event->m_last_run_time = s_current_time - static_cast<s64>(time_since_last_run);
       event->m_period = period;
       event->m_interval = interval;
     }
@@ -389,19 +310,21 @@ bool DoState(StateWrapper& sw)
   }
   else
   {
+    u32 event_count = static_cast<u32>(s_event_heap.size());
+    sw.Do(&event_count);
 
-    sw.Do(&s_active_event_count);
-
-    for (TimingEvent* event = s_active_events_head; event; event = event->next)
+    for (TimingEvent* event : s_event_heap)
     {
+      TickCount downcount = static_cast<TickCount>(event->m_deadline - s_current_time);
+      TickCount time_since_last_run = static_cast<TickCount>(s_current_time - event->m_last_run_time);
       sw.Do(&event->m_name);
-      sw.Do(&event->m_downcount);
-      sw.Do(&event->m_time_since_last_run);
+      sw.Do(&downcount);
+      sw.Do(&time_since_last_run);
       sw.Do(&event->m_period);
       sw.Do(&event->m_interval);
     }
 
-    Log_DebugPrintf("Wrote %u events to save state.", s_active_event_count);
+    Log_DebugPrintf("Wrote %u events to save state.", event_count);
   }
 
   return !sw.HasError();
@@ -411,8 +334,8 @@ bool DoState(StateWrapper& sw)
 
 TimingEvent::TimingEvent(std::string name, TickCount period, TickCount interval, TimingEventCallback callback,
                          void* callback_param)
-  : m_callback(callback), m_callback_param(callback_param), m_downcount(interval), m_time_since_last_run(0),
-    m_period(period), m_interval(interval), m_name(std::move(name))
+  : m_callback(callback), m_callback_param(callback_param), m_deadline(static_cast<u32>(interval)),
+    m_last_run_time(0), m_period(period), m_interval(interval), m_name(std::move(name))
 {
 }
 
@@ -422,14 +345,21 @@ TimingEvent::~TimingEvent()
     TimingEvents::RemoveActiveEvent(this);
 }
 
+TickCount TimingEvent::GetDowncount() const
+{
+  return static_cast<TickCount>(m_deadline - TimingEvents::s_current_time);
+}
+
 TickCount TimingEvent::GetTicksSinceLastExecution() const
 {
-  return CPU::GetPendingTicks() + m_time_since_last_run;
+  const u64 now = TimingEvents::s_current_time + static_cast<u32>(CPU::GetPendingTicks());
+  return static_cast<TickCount>(now - m_last_run_time);
 }
 
 TickCount TimingEvent::GetTicksUntilNextExecution() const
 {
-  return std::max(m_downcount - CPU::GetPendingTicks(), static_cast<TickCount>(0));
+  const u64 now = TimingEvents::s_current_time + static_cast<u32>(CPU::GetPendingTicks());
+  return std::max(static_cast<TickCount>(m_deadline - now), static_cast<TickCount>(0));
 }
 
 void TimingEvent::Delay(TickCount ticks)
@@ -440,23 +370,22 @@ void TimingEvent::Delay(TickCount ticks)
     return;
   }
 
-  m_downcount += ticks;
+  m_deadline += static_cast<s64>(ticks);
 
   DebugAssert(TimingEvents::s_current_event != this);
   TimingEvents::SortEvent(this);
-  if (TimingEvents::s_active_events_head == this)
-    TimingEvents::UpdateCPUDowncount();
 }
 
 void TimingEvent::Schedule(TickCount ticks)
 {
   const TickCount pending_ticks = CPU::GetPendingTicks();
-  m_downcount = pending_ticks + ticks;
+  const u64 now = TimingEvents::s_current_time + static_cast<u32>(pending_ticks);
+  m_deadline = now + static_cast<s64>(ticks);
 
   if (!m_active)
   {
     // Event is going active, so we want it to only execute ticks from the current timestamp.
-    m_time_since_last_run = -pending_ticks;
+    m_last_run_time = now;
     m_active = true;
     TimingEvents::AddActiveEvent(this);
   }
@@ -465,11 +394,7 @@ void TimingEvent::Schedule(TickCount ticks)
     // Event is already active, so we leave the time since last run alone, and just modify the downcount.
     // If this is a call from an IO handler for example, re-sort the event queue.
     if (TimingEvents::s_current_event != this)
-    {
       TimingEvents::SortEvent(this);
-      if (TimingEvents::s_active_events_head == this)
-        TimingEvents::UpdateCPUDowncount();
-    }
   }
 }
 
@@ -491,14 +416,10 @@ void TimingEvent::Reset()
   if (!m_active)
     return;
 
-  m_downcount = m_interval;
-  m_time_since_last_run = 0;
+  m_deadline = TimingEvents::s_current_time + static_cast<u32>(m_interval);
+  m_last_run_time = TimingEvents::s_current_time;
   if (TimingEvents::s_current_event != this)
-  {
     TimingEvents::SortEvent(this);
-    if (TimingEvents::s_active_events_head == this)
-      TimingEvents::UpdateCPUDowncount();
-  }
 }
 
 void TimingEvent::InvokeEarly(bool force /* = false */)
@@ -506,20 +427,18 @@ void TimingEvent::InvokeEarly(bool force /* = false */)
   if (!m_active)
     return;
 
-  const TickCount pending_ticks = CPU::GetPendingTicks();
-  const TickCount ticks_to_execute = m_time_since_last_run + pending_ticks;
+  const u64 now = TimingEvents::s_current_time + static_cast<u32>(CPU::GetPendingTicks());
+  const TickCount ticks_to_execute = static_cast<TickCount>(now - m_last_run_time);
   if ((!force && ticks_to_execute < m_period) || ticks_to_execute <= 0)
     return;
 
-  m_downcount = pending_ticks + m_interval;
-  m_time_since_last_run -= ticks_to_execute;
+  m_deadline = now + static_cast<u32>(m_interval);
+  m_last_run_time = now;
   m_callback(m_callback_param, ticks_to_execute, 0);
 
-  // Since we've changed the downcount, we need to re-sort the events.
+  // Since we've changed the deadline, we need to re-sort the events.
   DebugAssert(TimingEvents::s_current_event != this);
   TimingEvents::SortEvent(this);
-  if (TimingEvents::s_active_events_head == this)
-    TimingEvents::UpdateCPUDowncount();
 }
 
 void TimingEvent::Activate()
@@ -527,10 +446,10 @@ void TimingEvent::Activate()
   if (m_active)
     return;
 
-  // leave the downcount intact
-  const TickCount pending_ticks = CPU::GetPendingTicks();
-  m_downcount += pending_ticks;
-  m_time_since_last_run -= pending_ticks;
+  // Rebase the stored relative remainders onto the current timeline, leaving the downcount intact.
+  const u64 now = TimingEvents::s_current_time + static_cast<u32>(CPU::GetPendingTicks());
+  m_deadline += now;
+  m_last_run_time = now - m_last_run_time;
 
   m_active = true;
   TimingEvents::AddActiveEvent(this);
@@ -541,9 +460,10 @@ void TimingEvent::Deactivate()
   if (!m_active)
     return;
 
-  const TickCount pending_ticks = CPU::GetPendingTicks();
-  m_downcount -= pending_ticks;
-  m_time_since_last_run += pending_ticks;
+  // Back to relative remainders, exactly undoing Activate().
+  const u64 now = TimingEvents::s_current_time + static_cast<u32>(CPU::GetPendingTicks());
+  m_deadline -= now;
+  m_last_run_time = now - m_last_run_time;
 
   m_active = false;
   TimingEvents::RemoveActiveEvent(this);
@@ -27,7 +27,7 @@ public:
   // Returns the number of ticks between each event.
   ALWAYS_INLINE TickCount GetPeriod() const { return m_period; }
   ALWAYS_INLINE TickCount GetInterval() const { return m_interval; }
-  ALWAYS_INLINE TickCount GetDowncount() const { return m_downcount; }
+  TickCount GetDowncount() const;
 
   // Includes pending time.
   TickCount GetTicksSinceLastExecution() const;
@@ -63,14 +63,17 @@ public:
   void SetInterval(TickCount interval) { m_interval = interval; }
   void SetPeriod(TickCount period) { m_period = period; }
 
-  TimingEvent* prev = nullptr;
-  TimingEvent* next = nullptr;
+  // Position of this event in the active event heap.
+  u32 m_heap_index = 0;
 
   TimingEventCallback m_callback;
   void* m_callback_param;
 
-  TickCount m_downcount;
-  TickCount m_time_since_last_run;
+  // While active, the absolute tick the event fires at and the absolute tick it last ran at, on
+  // the scheduler's monotonic 64-bit timeline. While inactive, both hold base-relative remainders
+  // (modular arithmetic makes the rebase in Activate()/Deactivate() exact either way).
+  u64 m_deadline;
+  u64 m_last_run_time;
   TickCount m_period;
   TickCount m_interval;
   bool m_active = false;
@@ -99,6 +102,7 @@ void RunEvents();
 
 void UpdateCPUDowncount();
 
-TimingEvent** GetHeadEventPtr();
+/// Returns the address of the cached downcount for the next event, for use by the recompilers.
+const TickCount* GetNextEventDowncountPtr();
 
 } // namespace TimingEvents
\ No newline at end of file
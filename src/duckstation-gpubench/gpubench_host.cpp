@@ -0,0 +1,684 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "core/achievements.h"
+#include "core/fullscreen_ui.h"
+#include "core/game_list.h"
+#include "core/gpu.h"
+#include "core/gpu_dump.h"
+#include "core/host.h"
+#include "core/system.h"
+
+#include "scmversion/scmversion.h"
+
+#include "util/gpu_device.h"
+#include "util/imgui_manager.h"
+#include "util/input_manager.h"
+#include "util/platform_misc.h"
+
+#include "common/assert.h"
+#include "common/crash_handler.h"
+#include "common/error.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/memory_settings_interface.h"
+#include "common/path.h"
+#include "common/string_util.h"
+#include "common/timer.h"
+
+#include <csignal>
+#include <cstdio>
+#include <vector>
+
+Log_SetChannel(GPUBenchHost);
+
+namespace GPUBenchHost {
+static bool ParseCommandLineParameters(int argc, char* argv[], std::string& dump_filename);
+static void PrintCommandLineVersion();
+static void PrintCommandLineHelp(const char* progname);
+static bool InitializeConfig();
+static void InitializeEarlyConsole();
+static void HookSignals();
+static bool SetFolders();
+static int RunBenchmark(const std::string& dump_filename);
+} // namespace GPUBenchHost
+
+static std::unique_ptr<MemorySettingsInterface> s_base_settings_interface;
+
+static u32 s_frames_to_run = 0; // 0 means the whole dump
+static std::string s_csv_filename;
+
+bool GPUBenchHost::SetFolders()
+{
+  std::string program_path(FileSystem::GetProgramPath());
+  Log_InfoPrintf("Program Path: %s", program_path.c_str());
+
+  EmuFolders::AppRoot = Path::Canonicalize(Path::GetDirectory(program_path));
+  EmuFolders::DataRoot = EmuFolders::AppRoot;
+
+#ifdef __APPLE__
+  static constexpr char MAC_DATA_DIR[] = "Library/Application Support/DuckStation";
+  const char* home_dir = getenv("HOME");
+  if (home_dir)
+    EmuFolders::DataRoot = Path::Combine(home_dir, MAC_DATA_DIR);
+#endif
+
+  // On Windows/Linux, these are in the binary directory.
+  EmuFolders::Resources = Path::Combine(EmuFolders::AppRoot, "resources");
+
+  Log_DevPrintf("AppRoot Directory: %s", EmuFolders::AppRoot.c_str());
+  Log_DevPrintf("DataRoot Directory: %s", EmuFolders::DataRoot.c_str());
+  Log_DevPrintf("Resources Directory: %s", EmuFolders::Resources.c_str());
+
+  // Write crash dumps to the data directory, since that'll be accessible for certain.
+  CrashHandler::SetWriteDirectory(EmuFolders::DataRoot);
+
+  // the resources directory should exist, bail out if not
+  if (!FileSystem::DirectoryExists(EmuFolders::Resources.c_str()))
+  {
+    Log_ErrorPrint("Resources directory is missing, your installation is incomplete.");
+    return false;
+  }
+
+  return true;
+}
+
+bool GPUBenchHost::InitializeConfig()
+{
+  SetFolders();
+
+  s_base_settings_interface = std::make_unique<MemorySettingsInterface>();
+  Host::Internal::SetBaseSettingsLayer(s_base_settings_interface.get());
+
+  // default settings for runner
+  SettingsInterface& si = *s_base_settings_interface.get();
+  g_settings.Save(si);
+  si.SetStringValue("Pad1", "Type", Settings::GetControllerTypeName(ControllerType::None));
+  si.SetStringValue("Pad2", "Type", Settings::GetControllerTypeName(ControllerType::None));
+  si.SetStringValue("MemoryCards", "Card1Type", Settings::GetMemoryCardTypeName(MemoryCardType::None));
+  si.SetStringValue("MemoryCards", "Card2Type", Settings::GetMemoryCardTypeName(MemoryCardType::None));
+  si.SetStringValue("ControllerPorts", "MultitapMode", Settings::GetMultitapModeName(MultitapMode::Disabled));
+  si.SetStringValue("Audio", "Backend", Settings::GetAudioBackendName(AudioBackend::Null));
+  si.SetBoolValue("Logging", "LogToConsole", true);
+  si.SetBoolValue("Main", "ApplyGameSettings", false); // don't want game settings interfering
+  si.SetFloatValue("Main", "EmulationSpeed", 0.0f);
+
+  // replay as fast as the backend can go
+  si.SetStringValue("Display", "SyncMode", Settings::GetDisplaySyncModeName(DisplaySyncMode::Disabled));
+
+  // disable all sources
+  for (u32 i = 0; i < static_cast<u32>(InputSourceType::Count); i++)
+    si.SetBoolValue("InputSources", InputManager::InputSourceToString(static_cast<InputSourceType>(i)), false);
+
+  EmuFolders::LoadConfig(*s_base_settings_interface.get());
+  EmuFolders::EnsureFoldersExist();
+
+  return true;
+}
+
+void Host::ReportFatalError(const std::string_view& title, const std::string_view& message)
+{
+  Log_ErrorPrintf("ReportFatalError: %.*s", static_cast<int>(message.size()), message.data());
+  abort();
+}
+
+void Host::ReportErrorAsync(const std::string_view& title, const std::string_view& message)
+{
+  if (!title.empty() && !message.empty())
+  {
+    Log_ErrorPrintf("ReportErrorAsync: %.*s: %.*s", static_cast<int>(title.size()), title.data(),
+                    static_cast<int>(message.size()), message.data());
+  }
+  else if (!message.empty())
+  {
+    Log_ErrorPrintf("ReportErrorAsync: %.*s", static_cast<int>(message.size()), message.data());
+  }
+}
+
+bool Host::ConfirmMessage(const std::string_view& title, const std::string_view& message)
+{
+  if (!title.empty() && !message.empty())
+  {
+    Log_ErrorPrintf("ConfirmMessage: %.*s: %.*s", static_cast<int>(title.size()), title.data(),
+                    static_cast<int>(message.size()), message.data());
+  }
+  else if (!message.empty())
+  {
+    Log_ErrorPrintf("ConfirmMessage: %.*s", static_cast<int>(message.size()), message.data());
+  }
+
+  return true;
+}
+
+void Host::ReportDebuggerMessage(const std::string_view& message)
+{
+  Log_ErrorPrintf("ReportDebuggerMessage: %.*s", static_cast<int>(message.size()), message.data());
+}
+
+std::span<const std::pair<const char*, const char*>> Host::GetAvailableLanguageList()
+{
+  return {};
+}
+
+bool Host::ChangeLanguage(const char* new_language)
+{
+  return false;
+}
+
+s32 Host::Internal::GetTranslatedStringImpl(const std::string_view& context, const std::string_view& msg, char* tbuf,
+                                            size_t tbuf_space)
+{
+  if (msg.size() > tbuf_space)
+    return -1;
+  else if (msg.empty())
+    return 0;
+
+  std::memcpy(tbuf, msg.data(), msg.size());
+  return static_cast<s32>(msg.size());
+}
+
+void Host::LoadSettings(SettingsInterface& si, std::unique_lock<std::mutex>& lock)
+{
+}
+
+void Host::CheckForSettingsChanges(const Settings& old_settings)
+{
+}
+
+void Host::CommitBaseSettingChanges()
+{
+  // noop, in memory
+}
+
+bool Host::ResourceFileExists(std::string_view filename, bool allow_override)
+{
+  const std::string path(Path::Combine(EmuFolders::Resources, filename));
+  return FileSystem::FileExists(path.c_str());
+}
+
+std::optional<std::vector<u8>> Host::ReadResourceFile(std::string_view filename, bool allow_override)
+{
+  const std::string path(Path::Combine(EmuFolders::Resources, filename));
+  std::optional<std::vector<u8>> ret(FileSystem::ReadBinaryFile(path.c_str()));
+  if (!ret.has_value())
+    Log_ErrorPrintf("Failed to read resource file '%s'", filename);
+  return ret;
+}
+
+std::optional<std::string> Host::ReadResourceFileToString(std::string_view filename, bool allow_override)
+{
+  const std::string path(Path::Combine(EmuFolders::Resources, filename));
+  std::optional<std::string> ret(FileSystem::ReadFileToString(path.c_str()));
+  if (!ret.has_value())
+    Log_ErrorPrintf("Failed to read resource file to string '%s'", filename);
+  return ret;
+}
+
+std::optional<std::time_t> Host::GetResourceFileTimestamp(std::string_view filename, bool allow_override)
+{
+  const std::string path(Path::Combine(EmuFolders::Resources, filename));
+  FILESYSTEM_STAT_DATA sd;
+  if (!FileSystem::StatFile(path.c_str(), &sd))
+  {
+    Log_ErrorPrintf("Failed to stat resource file '%s'", filename);
+    return std::nullopt;
+  }
+
+  return sd.ModificationTime;
+}
+
+void Host::OnSystemStarting()
+{
+  //
+}
+
+void Host::OnSystemStarted()
+{
+  //
+}
+
+void Host::OnSystemDestroyed()
+{
+  //
+}
+
+void Host::OnSystemPaused()
+{
+  //
+}
+
+void Host::OnSystemResumed()
+{
+  //
+}
+
+void Host::OnIdleStateChanged()
+{
+  //
+}
+
+void Host::OnPerformanceCountersUpdated()
+{
+  //
+}
+
+void Host::OnGameChanged(const std::string& disc_path, const std::string& game_serial, const std::string& game_name)
+{
+  Log_InfoPrintf("Disc Path: %s", disc_path.c_str());
+  Log_InfoPrintf("Game Serial: %s", game_serial.c_str());
+  Log_InfoPrintf("Game Name: %s", game_name.c_str());
+}
+
+void Host::PumpMessagesOnCPUThread()
+{
+  // noop, the replay loop drives the system
+}
+
+void Host::RunOnCPUThread(std::function<void()> function, bool block /* = false */)
+{
+  // only one thread in this version...
+  function();
+}
+
+void Host::RequestResizeHostDisplay(s32 width, s32 height)
+{
+  //
+}
+
+void Host::RequestExit(bool save_state_if_running)
+{
+  //
+}
+
+void Host::RequestSystemShutdown(bool allow_confirm, bool save_state)
+{
+  //
+}
+
+bool Host::IsFullscreen()
+{
+  return false;
+}
+
+void Host::SetFullscreen(bool enabled)
+{
+  //
+}
+
+std::optional<WindowInfo> Host::AcquireRenderWindow(bool recreate_window)
+{
+  WindowInfo wi;
+  wi.SetSurfaceless();
+  return wi;
+}
+
+void Host::ReleaseRenderWindow()
+{
+  //
+}
+
+void Host::BeginPresentFrame()
+{
+  //
+}
+
+void Host::OpenURL(const std::string_view& url)
+{
+  //
+}
+
+bool Host::CopyTextToClipboard(const std::string_view& text)
+{
+  return false;
+}
+
+void Host::SetMouseMode(bool relative, bool hide_cursor)
+{
+  //
+}
+
+void Host::OnAchievementsLoginRequested(Achievements::LoginRequestReason reason)
+{
+  // noop
+}
+
+void Host::OnAchievementsLoginSuccess(const char* username, u32 points, u32 sc_points, u32 unread_messages)
+{
+  // noop
+}
+
+void Host::OnAchievementsRefreshed()
+{
+  // noop
+}
+
+void Host::OnAchievementsHardcoreModeChanged(bool enabled)
+{
+  // noop
+}
+
+void Host::OnCoverDownloaderOpenRequested()
+{
+  // noop
+}
+
+std::optional<u32> InputManager::ConvertHostKeyboardStringToCode(const std::string_view& str)
+{
+  return std::nullopt;
+}
+
+std::optional<std::string> InputManager::ConvertHostKeyboardCodeToString(u32 code)
+{
+  return std::nullopt;
+}
+
+const char* InputManager::ConvertHostKeyboardCodeToIcon(u32 code)
+{
+  return nullptr;
+}
+
+void Host::AddFixedInputBindings(SettingsInterface& si)
+{
+  // noop
+}
+
+void Host::OnInputDeviceConnected(const std::string_view& identifier, const std::string_view& device_name)
+{
+  // noop
+}
+
+void Host::OnInputDeviceDisconnected(const std::string_view& identifier)
+{
+  // noop
+}
+
+std::optional<WindowInfo> Host::GetTopLevelWindowInfo()
+{
+  return std::nullopt;
+}
+
+void Host::RefreshGameListAsync(bool invalidate_cache)
+{
+  // noop
+}
+
+void Host::CancelGameListRefresh()
+{
+  // noop
+}
+
+BEGIN_HOTKEY_LIST(g_host_hotkeys)
+END_HOTKEY_LIST()
+
+static void SignalHandler(int signal)
+{
+  std::signal(signal, SIG_DFL);
+
+  // MacOS is missing std::quick_exit() despite it being C++11...
+#ifndef __APPLE__
+  std::quick_exit(1);
+#else
+  _Exit(1);
+#endif
+}
+
+void GPUBenchHost::HookSignals()
+{
+  std::signal(SIGINT, SignalHandler);
+  std::signal(SIGTERM, SignalHandler);
+}
+
+void GPUBenchHost::InitializeEarlyConsole()
+{
+  const bool was_console_enabled = Log::IsConsoleOutputEnabled();
+  if (!was_console_enabled)
+    Log::SetConsoleOutputParams(true);
+}
+
+void GPUBenchHost::PrintCommandLineVersion()
+{
+  InitializeEarlyConsole();
+  std::fprintf(stderr, "DuckStation GPU Benchmark Runner Version %s (%s)\n", g_scm_tag_str, g_scm_branch_str);
+  std::fprintf(stderr, "https://github.com/stenzek/duckstation\n");
+  std::fprintf(stderr, "\n");
+}
+
+void GPUBenchHost::PrintCommandLineHelp(const char* progname)
+{
+  InitializeEarlyConsole();
+  PrintCommandLineVersion();
+  std::fprintf(stderr, "Usage: %s [parameters] [--] [dump filename]\n", progname);
+  std::fprintf(stderr, "\n");
+  std::fprintf(stderr, "  -help: Displays this information and exits.\n");
+  std::fprintf(stderr, "  -version: Displays version information and exits.\n");
+  std::fprintf(stderr, "  -frames: Sets the maximum number of frames to replay. Defaults to the whole dump.\n");
+  std::fprintf(stderr, "  -csv <filename>: Writes per-frame timings to the specified file.\n");
+  std::fprintf(stderr, "  -log <level>: Sets the log level. Defaults to verbose.\n");
+  std::fprintf(stderr, "  -renderer <renderer>: Sets the graphics renderer. Defaults to automatic.\n");
+  std::fprintf(stderr, "  -upscale <multiplier>: Sets the resolution scale.\n");
+  std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
+                       "    parameters make up the filename. Use when the filename contains\n"
+                       "    spaces or starts with a dash.\n");
+  std::fprintf(stderr, "\n");
+}
+
+bool GPUBenchHost::ParseCommandLineParameters(int argc, char* argv[], std::string& dump_filename)
+{
+  bool no_more_args = false;
+  for (int i = 1; i < argc; i++)
+  {
+    if (!no_more_args)
+    {
+#define CHECK_ARG(str) !std::strcmp(argv[i], str)
+#define CHECK_ARG_PARAM(str) (!std::strcmp(argv[i], str) && ((i + 1) < argc))
+
+      if (CHECK_ARG("-help"))
+      {
+        PrintCommandLineHelp(argv[0]);
+        return false;
+      }
+      else if (CHECK_ARG("-version"))
+      {
+        PrintCommandLineVersion();
+        return false;
+      }
+      else if (CHECK_ARG_PARAM("-frames"))
+      {
+        s_frames_to_run = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_frames_to_run == 0)
+        {
+          Log_ErrorPrintf("Invalid frame count specified: %s", argv[i]);
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-csv"))
+      {
+        s_csv_filename = argv[++i];
+        if (s_csv_filename.empty())
+        {
+          Log_ErrorPrint("Invalid CSV filename specified.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-log"))
+      {
+        std::optional<LOGLEVEL> level = Settings::ParseLogLevelName(argv[++i]);
+        if (!level.has_value())
+        {
+          Log_ErrorPrintf("Invalid log level specified.");
+          return false;
+        }
+
+        Log::SetConsoleOutputParams(true, level.value());
+        s_base_settings_interface->SetStringValue("Logging", "LogLevel", Settings::GetLogLevelName(level.value()));
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-renderer"))
+      {
+        std::optional<GPURenderer> renderer = Settings::ParseRendererName(argv[++i]);
+        if (!renderer.has_value())
+        {
+          Log_ErrorPrintf("Invalid renderer specified.");
+          return false;
+        }
+
+        s_base_settings_interface->SetStringValue("GPU", "Renderer", Settings::GetRendererName(renderer.value()));
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-upscale"))
+      {
+        const u32 upscale = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (upscale == 0)
+        {
+          Log_ErrorPrint("Invalid upscale value.");
+          return false;
+        }
+
+        Log_InfoFmt("Setting upscale to {}.", upscale);
+        s_base_settings_interface->SetIntValue("GPU", "ResolutionScale", static_cast<s32>(upscale));
+        continue;
+      }
+      else if (CHECK_ARG("--"))
+      {
+        no_more_args = true;
+        continue;
+      }
+      else if (argv[i][0] == '-')
+      {
+        Log_ErrorPrintf("Unknown parameter: '%s'", argv[i]);
+        return false;
+      }
+
+#undef CHECK_ARG
+#undef CHECK_ARG_PARAM
+    }
+
+    if (!dump_filename.empty())
+      dump_filename += ' ';
+    dump_filename += argv[i];
+  }
+
+  return true;
+}
+
+int GPUBenchHost::RunBenchmark(const std::string& dump_filename)
+{
+  std::unique_ptr<GPUDump::Player> player = GPUDump::Player::Open(dump_filename.c_str());
+  if (!player)
+  {
+    Log_ErrorPrintf("Failed to open GPU dump '%s'.", dump_filename.c_str());
+    return EXIT_FAILURE;
+  }
+
+  // We only need a valid system for the GPU to exist, the CPU never executes. Booting with no
+  // filename drops into the BIOS shell, which doesn't get a chance to touch the GPU.
+  if (!System::BootSystem(SystemBootParameters()))
+  {
+    Log_ErrorPrint("Failed to boot system.");
+    return EXIT_FAILURE;
+  }
+
+  const u32 frame_count =
+    (s_frames_to_run > 0) ? std::min(s_frames_to_run, player->GetFrameCount()) : player->GetFrameCount();
+  Log_InfoPrintf("Replaying %u frames from '%s'...", frame_count, dump_filename.c_str());
+
+  g_gpu_device->SetGPUTimingEnabled(true);
+
+  std::vector<float> frame_wall_times_ms;
+  std::vector<float> frame_gpu_times_ms;
+  frame_wall_times_ms.reserve(frame_count);
+  frame_gpu_times_ms.reserve(frame_count);
+
+  Common::Timer frame_timer;
+  for (u32 frame = 0; frame < frame_count; frame++)
+  {
+    frame_timer.Reset();
+    if (!player->RunFrame())
+    {
+      Log_WarningPrintf("Dump ended early at frame %u.", frame);
+      break;
+    }
+
+    // Give the backend a submission boundary, so queued work is flushed every frame.
+    System::InvalidateDisplay();
+
+    frame_wall_times_ms.push_back(static_cast<float>(frame_timer.GetTimeMilliseconds()));
+    frame_gpu_times_ms.push_back(g_gpu_device->GetAndResetAccumulatedGPUTime());
+  }
+
+  System::ShutdownSystem(false);
+
+  if (frame_wall_times_ms.empty())
+  {
+    Log_ErrorPrint("No frames were replayed.");
+    return EXIT_FAILURE;
+  }
+
+  if (!s_csv_filename.empty())
+  {
+    auto fp = FileSystem::OpenManagedCFile(s_csv_filename.c_str(), "wb");
+    if (!fp)
+    {
+      Log_ErrorPrintf("Failed to open '%s' for CSV output.", s_csv_filename.c_str());
+      return EXIT_FAILURE;
+    }
+
+    std::fprintf(fp.get(), "frame,wall_ms,gpu_ms\n");
+    for (size_t i = 0; i < frame_wall_times_ms.size(); i++)
+      std::fprintf(fp.get(), "%zu,%.4f,%.4f\n", i, frame_wall_times_ms[i], frame_gpu_times_ms[i]);
+
+    Log_InfoPrintf("Wrote per-frame timings to '%s'.", s_csv_filename.c_str());
+  }
+
+  float total_ms = 0.0f;
+  float min_ms = frame_wall_times_ms[0];
+  float max_ms = frame_wall_times_ms[0];
+  float total_gpu_ms = 0.0f;
+  for (size_t i = 0; i < frame_wall_times_ms.size(); i++)
+  {
+    total_ms += frame_wall_times_ms[i];
+    min_ms = std::min(min_ms, frame_wall_times_ms[i]);
+    max_ms = std::max(max_ms, frame_wall_times_ms[i]);
+    total_gpu_ms += frame_gpu_times_ms[i];
+  }
+
+  const float frames = static_cast<float>(frame_wall_times_ms.size());
+  std::fprintf(stdout, "Replayed %zu frames in %.2f ms (%.2f FPS)\n", frame_wall_times_ms.size(), total_ms,
+               frames / (total_ms / 1000.0f));
+  std::fprintf(stdout, "Wall time per frame: avg %.4f ms, min %.4f ms, max %.4f ms\n", total_ms / frames, min_ms,
+               max_ms);
+  std::fprintf(stdout, "GPU time per frame: avg %.4f ms\n", total_gpu_ms / frames);
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  GPUBenchHost::InitializeEarlyConsole();
+
+  if (!GPUBenchHost::InitializeConfig())
+    return EXIT_FAILURE;
+
+  std::string dump_filename;
+  if (!GPUBenchHost::ParseCommandLineParameters(argc, argv, dump_filename))
+    return EXIT_FAILURE;
+
+  if (dump_filename.empty())
+  {
+    Log_ErrorPrint("No dump path specified.");
+    return EXIT_FAILURE;
+  }
+
+  if (!System::Internal::ProcessStartup())
+    return EXIT_FAILURE;
+
+  GPUBenchHost::HookSignals();
+
+  const int result = GPUBenchHost::RunBenchmark(dump_filename);
+
+  System::Internal::ProcessShutdown();
+  return result;
+}
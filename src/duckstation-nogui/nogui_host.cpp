@@ -8,6 +8,7 @@
 
 #include "core/achievements.h"
 #include "core/controller.h"
+#include "core/cpu_code_cache.h"
 #include "core/fullscreen_ui.h"
 #include "core/game_list.h"
 #include "core/gpu.h"
@@ -15,6 +16,7 @@
 #include "core/imgui_overlays.h"
 #include "core/settings.h"
 #include "core/system.h"
+#include "core/timing_event.h"
 
 #include "util/gpu_device.h"
 #include "util/imgui_fullscreen.h"
@@ -22,6 +24,7 @@
 #include "util/ini_settings_interface.h"
 #include "util/input_manager.h"
 #include "util/platform_misc.h"
+#include "util/resource_bundle.h"
 
 #include "imgui.h"
 #include "imgui_internal.h"
@@ -36,7 +39,9 @@
 #include "common/path.h"
 #include "common/string_util.h"
 #include "common/threading.h"
+#include "common/timer.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <cmath>
 #include <condition_variable>
@@ -128,6 +133,8 @@ static void UpdateWindowTitle(const std::string& game_title);
 static void CancelAsyncOp();
 static void StartAsyncOp(std::function<void(ProgressCallback*)> callback);
 static void AsyncOpThreadEntryPoint(std::function<void(ProgressCallback*)> callback);
+static void BenchmarkFrameDone();
+static void WriteBenchmarkResults();
 
 //////////////////////////////////////////////////////////////////////////
 // Local variable declarations
@@ -137,6 +144,16 @@ static bool s_batch_mode = false;
 static bool s_is_fullscreen = false;
 static bool s_was_paused_by_focus_loss = false;
 
+// Headless benchmark mode. Frame times are measured from the second frame onwards, so system
+// startup and save state loading don't pollute the numbers.
+static u32 s_benchmark_frames = 0;
+static std::string s_benchmark_output_path;
+static std::vector<double> s_benchmark_frame_times_ms;
+static Common::Timer::Value s_benchmark_last_frame_time = 0;
+static Common::Timer::Value s_benchmark_start_time = 0;
+static u32 s_benchmark_start_tick_counter = 0;
+static u64 s_benchmark_start_block_count = 0;
+
 static Threading::Thread s_cpu_thread;
 static Threading::KernelSemaphore s_platform_window_updated;
 static std::atomic_bool s_running{false};
@@ -169,8 +186,11 @@ bool NoGUIHost::SetCriticalFolders()
   // Write crash dumps to the data directory, since that'll be accessible for certain.
   CrashHandler::SetWriteDirectory(EmuFolders::DataRoot);
 
-  // the resources directory should exist, bail out if not
-  if (!FileSystem::DirectoryExists(EmuFolders::Resources.c_str()))
+  // a compressed bundle can stand in for the loose resources directory
+  ResourceBundle::Open(Path::Combine(EmuFolders::AppRoot, ResourceBundle::DEFAULT_FILENAME).c_str());
+
+  // the resources directory (or a bundle) should exist, bail out if not
+  if (!FileSystem::DirectoryExists(EmuFolders::Resources.c_str()) && !ResourceBundle::IsOpen())
   {
     g_nogui_window->ReportError("Error", "Resources directory is missing, your installation is incomplete.");
     return false;
@@ -415,14 +435,17 @@ ALWAYS_INLINE std::string NoGUIHost::GetResourcePath(std::string_view filename,
 
 bool Host::ResourceFileExists(std::string_view filename, bool allow_override)
 {
+  // loose files (including user overrides) take precedence over the bundle
   const std::string path = NoGUIHost::GetResourcePath(filename, allow_override);
-  return FileSystem::FileExists(path.c_str());
+  return FileSystem::FileExists(path.c_str()) || ResourceBundle::HasFile(filename);
 }
 
 std::optional<std::vector<u8>> Host::ReadResourceFile(std::string_view filename, bool allow_override)
 {
   const std::string path = NoGUIHost::GetResourcePath(filename, allow_override);
   std::optional<std::vector<u8>> ret(FileSystem::ReadBinaryFile(path.c_str()));
+  if (!ret.has_value())
+    ret = ResourceBundle::ReadBinaryFile(filename);
   if (!ret.has_value())
     Log_ErrorPrintf("Failed to read resource file '%s'", filename);
   return ret;
@@ -432,6 +455,8 @@ std::optional<std::string> Host::ReadResourceFileToString(std::string_view filen
 {
   const std::string path = NoGUIHost::GetResourcePath(filename, allow_override);
   std::optional<std::string> ret(FileSystem::ReadFileToString(path.c_str()));
+  if (!ret.has_value())
+    ret = ResourceBundle::ReadFileToString(filename);
   if (!ret.has_value())
     Log_ErrorPrintf("Failed to read resource file to string '%s'", filename);
   return ret;
@@ -443,6 +468,10 @@ std::optional<std::time_t> Host::GetResourceFileTimestamp(std::string_view filen
   FILESYSTEM_STAT_DATA sd;
   if (!FileSystem::StatFile(path.c_str(), &sd))
   {
+    // bundled entries share the timestamp of the bundle itself
+    if (ResourceBundle::HasFile(filename))
+      return ResourceBundle::GetTimestamp();
+
     Log_ErrorPrintf("Failed to stat resource file '%s'", filename);
     return std::nullopt;
   }
@@ -864,6 +893,97 @@ void Host::PumpMessagesOnCPUThread()
 {
   NoGUIHost::ProcessCPUThreadPlatformMessages();
   NoGUIHost::ProcessCPUThreadEvents(false);
+
+  if (NoGUIHost::s_benchmark_frames > 0) [[unlikely]]
+    NoGUIHost::BenchmarkFrameDone();
+}
+
+void NoGUIHost::BenchmarkFrameDone()
+{
+  if (!System::IsValid())
+    return;
+
+  const Common::Timer::Value now = Common::Timer::GetCurrentValue();
+  if (s_benchmark_last_frame_time == 0)
+  {
+    // First frame after the system came up, start measuring from here.
+    s_benchmark_start_time = now;
+    s_benchmark_start_tick_counter = TimingEvents::GetGlobalTickCounter();
+    s_benchmark_start_block_count = CPU::CodeCache::GetCompiledBlockCount();
+    s_benchmark_frame_times_ms.reserve(s_benchmark_frames);
+  }
+  else
+  {
+    s_benchmark_frame_times_ms.push_back(Common::Timer::ConvertValueToMilliseconds(now - s_benchmark_last_frame_time));
+  }
+  s_benchmark_last_frame_time = now;
+
+  if (static_cast<u32>(s_benchmark_frame_times_ms.size()) >= s_benchmark_frames)
+  {
+    WriteBenchmarkResults();
+    s_benchmark_frames = 0;
+    System::ShutdownSystem(false);
+  }
+}
+
+void NoGUIHost::WriteBenchmarkResults()
+{
+  const double wall_time_s =
+    Common::Timer::ConvertValueToSeconds(Common::Timer::GetCurrentValue() - s_benchmark_start_time);
+  const u32 ticks_run = TimingEvents::GetGlobalTickCounter() - s_benchmark_start_tick_counter;
+  const u64 blocks_compiled = CPU::CodeCache::GetCompiledBlockCount() - s_benchmark_start_block_count;
+  const double speed_percent =
+    (static_cast<double>(ticks_run) / (static_cast<double>(System::g_ticks_per_second) * wall_time_s)) * 100.0;
+
+  std::vector<double> sorted_times(s_benchmark_frame_times_ms);
+  std::sort(sorted_times.begin(), sorted_times.end());
+  const auto percentile = [&sorted_times](double fraction) {
+    const size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted_times.size() - 1));
+    return sorted_times[index];
+  };
+  double mean_time = 0.0;
+  for (const double time : sorted_times)
+    mean_time += time;
+  mean_time /= static_cast<double>(sorted_times.size());
+
+  std::FILE* fp = stdout;
+  FileSystem::ManagedCFilePtr file;
+  if (!s_benchmark_output_path.empty())
+  {
+    file = FileSystem::OpenManagedCFile(s_benchmark_output_path.c_str(), "wb");
+    if (!file)
+      Log_ErrorPrintf("Failed to open '%s', writing benchmark results to stdout.", s_benchmark_output_path.c_str());
+    else
+      fp = file.get();
+  }
+
+  std::fprintf(fp, "{\n");
+  std::fprintf(fp, "  \"game_serial\": \"%s\",\n", System::GetGameSerial().c_str());
+  std::fprintf(fp, "  \"renderer\": \"%s\",\n", Settings::GetRendererName(g_settings.gpu_renderer));
+  std::fprintf(fp, "  \"cpu_execution_mode\": \"%s\",\n",
+               Settings::GetCPUExecutionModeName(g_settings.cpu_execution_mode));
+  std::fprintf(fp, "  \"frames\": %u,\n", static_cast<u32>(s_benchmark_frame_times_ms.size()));
+  std::fprintf(fp, "  \"wall_time_s\": %.3f,\n", wall_time_s);
+  std::fprintf(fp, "  \"average_fps\": %.2f,\n", static_cast<double>(s_benchmark_frame_times_ms.size()) / wall_time_s);
+  std::fprintf(fp, "  \"emulation_speed_percent\": %.2f,\n", speed_percent);
+  std::fprintf(fp, "  \"frame_time_ms\": {\n");
+  std::fprintf(fp, "    \"mean\": %.4f,\n", mean_time);
+  std::fprintf(fp, "    \"min\": %.4f,\n", sorted_times.front());
+  std::fprintf(fp, "    \"p50\": %.4f,\n", percentile(0.50));
+  std::fprintf(fp, "    \"p90\": %.4f,\n", percentile(0.90));
+  std::fprintf(fp, "    \"p95\": %.4f,\n", percentile(0.95));
+  std::fprintf(fp, "    \"p99\": %.4f,\n", percentile(0.99));
+  std::fprintf(fp, "    \"max\": %.4f\n", sorted_times.back());
+  std::fprintf(fp, "  },\n");
+  std::fprintf(fp, "  \"blocks_compiled\": %" PRIu64 ",\n", blocks_compiled);
+  std::fprintf(fp, "  \"cpu_thread_usage_percent\": %.2f,\n", System::GetCPUThreadUsage());
+  std::fprintf(fp, "  \"gpu_time_ms\": %.4f,\n", System::GetGPUAverageTime());
+  std::fprintf(fp, "  \"gpu_usage_percent\": %.2f\n", System::GetGPUUsage());
+  std::fprintf(fp, "}\n");
+  std::fflush(fp);
+
+  if (!s_benchmark_output_path.empty() && file)
+    Log_InfoPrintf("Benchmark results written to '%s'.", s_benchmark_output_path.c_str());
 }
 
 std::unique_ptr<NoGUIPlatform> NoGUIHost::CreatePlatform()
@@ -1072,6 +1192,11 @@ void NoGUIHost::PrintCommandLineHelp(const char* progname)
   std::fprintf(stderr, "  -help: Displays this information and exits.\n");
   std::fprintf(stderr, "  -version: Displays version information and exits.\n");
   std::fprintf(stderr, "  -batch: Enables batch mode (exits after powering off).\n");
+  std::fprintf(stderr, "  -benchmark <frames>: Runs the provided game/save state for the given\n"
+                       "    number of frames with no vsync, throttling or audio output, then\n"
+                       "    prints frame time statistics as JSON and exits.\n");
+  std::fprintf(stderr, "  -benchmarkfile <filename>: Writes benchmark results to the specified\n"
+                       "    file instead of stdout.\n");
   std::fprintf(stderr, "  -fastboot: Force fast boot for provided filename.\n");
   std::fprintf(stderr, "  -slowboot: Force slow boot for provided filename.\n");
   std::fprintf(stderr, "  -bios: Boot into the BIOS shell.\n");
@@ -1136,6 +1261,25 @@ bool NoGUIHost::ParseCommandLineParametersAndInitializeConfig(int argc, char* ar
         s_batch_mode = true;
         continue;
       }
+      else if (CHECK_ARG_PARAM("-benchmark"))
+      {
+        s_benchmark_frames = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_benchmark_frames == 0)
+        {
+          Log_ErrorPrintf("Invalid benchmark frame count.");
+          return false;
+        }
+
+        Log_InfoPrintf("Command Line: Running benchmark for %u frames.", s_benchmark_frames);
+        s_batch_mode = true;
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-benchmarkfile"))
+      {
+        s_benchmark_output_path = argv[++i];
+        Log_InfoPrintf("Command Line: Writing benchmark results to '%s'.", s_benchmark_output_path.c_str());
+        continue;
+      }
       else if (CHECK_ARG("-bios"))
       {
         Log_InfoPrintf("Command Line: Starting BIOS.");
@@ -1243,6 +1387,21 @@ bool NoGUIHost::ParseCommandLineParametersAndInitializeConfig(int argc, char* ar
     return EXIT_FAILURE;
   }
 
+  if (s_benchmark_frames > 0)
+  {
+    // Benchmarks run unthrottled and headless: no vsync, no speed limit, no audio output, and GPU
+    // timing enabled so device timestamps show up in the results.
+    SettingsInterface& si = *s_base_settings_interface;
+    si.SetFloatValue("Main", "EmulationSpeed", 0.0f);
+    si.SetStringValue("Display", "SyncMode", Settings::GetDisplaySyncModeName(DisplaySyncMode::Disabled));
+    si.SetBoolValue("Display", "DisplayAllFrames", false);
+    si.SetBoolValue("Display", "ShowGPU", true);
+    si.SetStringValue("Audio", "Backend", Settings::GetAudioBackendName(AudioBackend::Null));
+    si.SetBoolValue("Main", "RewindEnable", false);
+    si.SetIntValue("Main", "RunaheadFrameCount", 0);
+    si.SetBoolValue("Main", "SaveStateOnExit", false);
+  }
+
   // Check the file we're starting actually exists.
 
   if (autoboot && !autoboot->filename.empty() && !FileSystem::FileExists(autoboot->filename.c_str()))
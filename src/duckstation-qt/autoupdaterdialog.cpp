@@ -11,11 +11,13 @@
 
 #include "util/http_downloader.h"
 
+#include "common/delta_patch.h"
 #include "common/error.h"
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/minizip_helpers.h"
 #include "common/path.h"
+#include "common/sha256_digest.h"
 #include "common/string_util.h"
 
 #include <QtCore/QCoreApplication>
@@ -33,6 +35,9 @@
 // Interval at which HTTP requests are polled.
 static constexpr u32 HTTP_POLL_INTERVAL = 10;
 
+// Suffix identifying binary patch entries in delta update packages. Must match the updater.
+static constexpr char DELTA_PATCH_SUFFIX[] = ".dsdp";
+
 #if defined(_WIN32)
 #include "common/windows_headers.h"
 #include <shellapi.h>
@@ -127,6 +132,22 @@ std::string AutoUpdaterDialog::getCurrentUpdateTag() const
 #endif
 }
 
+QString AutoUpdaterDialog::getDeltaAssetFilename() const
+{
+#ifdef AUTO_UPDATER_SUPPORTED
+  // Delta packages are published alongside the full package, named for the version they patch,
+  // e.g. delta-1234abcde-duckstation-windows-x64-release.zip. Dev builds without a proper hash
+  // can't match one.
+  const QString hash = QString::fromUtf8(g_scm_hash_str);
+  if (hash.length() < 9)
+    return {};
+
+  return QStringLiteral("delta-%1-%2").arg(hash.left(9)).arg(QString::fromUtf8(UPDATE_ASSET_FILENAME));
+#else
+  return {};
+#endif
+}
+
 void AutoUpdaterDialog::reportError(const char* msg, ...)
 {
   std::va_list ap;
@@ -278,31 +299,62 @@ void AutoUpdaterDialog::getLatestReleaseComplete(s32 status_code, std::vector<u8
       // search for the correct file
       const QJsonArray assets(doc_object["assets"].toArray());
       const QString asset_filename(UPDATE_ASSET_FILENAME);
+      const QString delta_asset_filename = getDeltaAssetFilename();
+      QJsonObject full_asset;
+      QJsonObject delta_asset;
       for (const QJsonValue& asset : assets)
       {
         const QJsonObject asset_obj(asset.toObject());
-        if (asset_obj["name"] == asset_filename)
-        {
-          m_download_url = asset_obj["browser_download_url"].toString();
-          if (!m_download_url.isEmpty())
-          {
-            m_download_size = asset_obj["size"].toInt();
-            m_ui.currentVersion->setText(tr("Current Version: %1 (%2)").arg(g_scm_hash_str).arg(g_scm_date_str));
-            m_ui.newVersion->setText(
-              tr("New Version: %1 (%2)").arg(m_latest_sha).arg(doc_object["published_at"].toString()));
-            m_ui.updateNotes->setText(tr("Loading..."));
-            m_ui.downloadAndInstall->setEnabled(true);
-            queueGetChanges();
-
-            // We have to defer this, because it comes back through the timer/HTTP callback...
-            QMetaObject::invokeMethod(this, "exec", Qt::QueuedConnection);
-
-            emit updateCheckCompleted();
-            return;
-          }
+        const QString asset_name = asset_obj["name"].toString();
+        if (asset_name == asset_filename)
+          full_asset = asset_obj;
+        else if (!delta_asset_filename.isEmpty() && asset_name == delta_asset_filename)
+          delta_asset = asset_obj;
+      }
 
-          break;
+      m_download_url = full_asset["browser_download_url"].toString();
+      if (!m_download_url.isEmpty())
+      {
+        m_download_size = full_asset["size"].toInt();
+
+        // Newer GitHub API revisions publish a per-asset digest, which lets us verify the
+        // archive as it streams in. Older responses simply don't have it.
+        const QString asset_digest = full_asset["digest"].toString();
+        if (asset_digest.startsWith(QStringLiteral("sha256:")))
+          m_download_sha256 = asset_digest.mid(7);
+
+        // Prefer a delta package when one was published against this version; it is a fraction
+        // of the size of the full package. The full package is kept as the fallback in case the
+        // delta fails to validate against this install.
+        m_full_download_url = m_download_url;
+        m_full_download_sha256 = m_download_sha256;
+        m_full_download_size = m_download_size;
+        const QString delta_url = delta_asset["browser_download_url"].toString();
+        if (!delta_url.isEmpty())
+        {
+          m_is_delta_download = true;
+          m_download_url = delta_url;
+          m_download_size = delta_asset["size"].toInt();
+          m_download_sha256.clear();
+          const QString delta_digest = delta_asset["digest"].toString();
+          if (delta_digest.startsWith(QStringLiteral("sha256:")))
+            m_download_sha256 = delta_digest.mid(7);
+          Log_InfoPrintf("Using delta update package '%s' (%d bytes).",
+                         delta_asset_filename.toUtf8().constData(), m_download_size);
         }
+
+        m_ui.currentVersion->setText(tr("Current Version: %1 (%2)").arg(g_scm_hash_str).arg(g_scm_date_str));
+        m_ui.newVersion->setText(
+          tr("New Version: %1 (%2)").arg(m_latest_sha).arg(doc_object["published_at"].toString()));
+        m_ui.updateNotes->setText(tr("Loading..."));
+        m_ui.downloadAndInstall->setEnabled(true);
+        queueGetChanges();
+
+        // We have to defer this, because it comes back through the timer/HTTP callback...
+        QMetaObject::invokeMethod(this, "exec", Qt::QueuedConnection);
+
+        emit updateCheckCompleted();
+        return;
       }
 
       reportError("Asset/asset download not found");
@@ -409,49 +461,100 @@ void AutoUpdaterDialog::downloadUpdateClicked()
 {
   m_display_messages = true;
 
-  std::optional<bool> download_result;
   QtModalProgressCallback progress(this);
   progress.SetTitle(tr("Automatic Updater").toUtf8().constData());
-  progress.SetStatusText(tr("Downloading %1...").arg(m_latest_sha).toUtf8().constData());
   progress.GetDialog().setWindowIcon(windowIcon());
   progress.SetCancellable(true);
 
-  m_http->CreateRequest(
-    m_download_url.toStdString(),
-    [this, &download_result](s32 status_code, const std::string&, std::vector<u8> response) {
-      if (status_code == HTTPDownloader::HTTP_STATUS_CANCELLED)
-        return;
+  // A delta download which does not match this install restarts the loop with the full package.
+  for (;;)
+  {
+    std::optional<bool> download_result;
+    bool delta_fallback = false;
+    progress.SetStatusText(tr("Downloading %1...").arg(m_latest_sha).toUtf8().constData());
+
+    // The archive is hashed as it streams in, so by the time the last chunk arrives there is no
+    // separate verification pass left to run.
+    SHA256Digest download_hash;
+    m_http->CreateStreamingRequest(
+      m_download_url.toStdString(),
+      [this, &download_result, &download_hash, &delta_fallback](s32 status_code, const std::string&,
+                                                                std::vector<u8> response) {
+        if (status_code == HTTPDownloader::HTTP_STATUS_CANCELLED)
+          return;
 
-      if (status_code != HTTPDownloader::HTTP_STATUS_OK)
-      {
-        reportError("Download failed: %d", status_code);
-        download_result = false;
-        return;
-      }
+        if (status_code != HTTPDownloader::HTTP_STATUS_OK)
+        {
+          reportError("Download failed: %d", status_code);
+          download_result = false;
+          return;
+        }
 
-      if (response.empty())
-      {
-        reportError("Download failed: Update is empty");
-        download_result = false;
-        return;
-      }
+        if (response.empty())
+        {
+          reportError("Download failed: Update is empty");
+          download_result = false;
+          return;
+        }
 
-      download_result = processUpdate(response);
-    },
-    &progress);
+        if (!m_download_sha256.isEmpty())
+        {
+          u8 digest[SHA256Digest::DIGEST_SIZE];
+          download_hash.Final(digest);
+          const QString downloaded_digest = QString::fromStdString(SHA256Digest::DigestToString(digest));
+          if (downloaded_digest.compare(m_download_sha256, Qt::CaseInsensitive) != 0)
+          {
+            reportError("Download failed: digest mismatch (expected %s, got %s)",
+                        m_download_sha256.toUtf8().constData(), downloaded_digest.toUtf8().constData());
+            download_result = false;
+            return;
+          }
 
-  // Block until completion.
-  while (m_http->HasAnyRequests())
-  {
-    QApplication::processEvents(QEventLoop::AllEvents, HTTP_POLL_INTERVAL);
-    m_http->PollRequests();
-  }
+          Log_InfoPrintf("Update archive digest verified.");
+        }
 
-  if (download_result.value_or(false))
-  {
-    // updater started. since we're a modal on the main window, we have to queue this.
-    QMetaObject::invokeMethod(g_main_window, "requestExit", Qt::QueuedConnection, Q_ARG(bool, true));
-    done(0);
+        if (m_is_delta_download && !prepareDeltaUpdate(&response))
+        {
+          delta_fallback = true;
+          return;
+        }
+
+        download_result = processUpdate(response);
+      },
+      [&download_hash](const void* data, size_t size, bool restarted) {
+        if (restarted)
+          download_hash.Reset();
+        download_hash.Update(data, static_cast<u32>(size));
+      },
+      &progress);
+
+    // Block until completion.
+    while (m_http->HasAnyRequests())
+    {
+      QApplication::processEvents(QEventLoop::AllEvents, HTTP_POLL_INTERVAL);
+      m_http->PollRequests();
+    }
+
+    if (delta_fallback)
+    {
+      // This install doesn't match what the delta was generated against (wrong version, or
+      // modified files). Grab the full package instead.
+      Log_WarningPrint("Delta update failed to validate, falling back to the full package.");
+      m_is_delta_download = false;
+      m_download_url = m_full_download_url;
+      m_download_sha256 = m_full_download_sha256;
+      m_download_size = m_full_download_size;
+      continue;
+    }
+
+    if (download_result.value_or(false))
+    {
+      // updater started. since we're a modal on the main window, we have to queue this.
+      QMetaObject::invokeMethod(g_main_window, "requestExit", Qt::QueuedConnection, Q_ARG(bool, true));
+      done(0);
+    }
+
+    break;
   }
 }
 
@@ -484,6 +587,89 @@ void AutoUpdaterDialog::remindMeLaterClicked()
   done(0);
 }
 
+#if defined(_WIN32) || defined(__APPLE__)
+
+// Checks that every patch in a delta package was generated against the corresponding file in the
+// current install, reading only the patch headers. The updater verifies the digests again before
+// committing anything; catching a mismatch here means we can still download the full package.
+static bool ValidateDeltaBaseFiles(const std::vector<u8>& zip_data, const std::string& root, const char* strip_prefix)
+{
+  unzFile zf = MinizipHelpers::OpenUnzMemoryFile(zip_data.data(), zip_data.size());
+  if (!zf)
+    return false;
+
+  bool result = (unzGoToFirstFile(zf) == UNZ_OK);
+  while (result)
+  {
+    char zip_filename_buffer[256];
+    unz_file_info64 file_info;
+    if (unzGetCurrentFileInfo64(zf, &file_info, zip_filename_buffer, sizeof(zip_filename_buffer), nullptr, 0, nullptr,
+                                0) != UNZ_OK)
+    {
+      result = false;
+      break;
+    }
+
+    std::string_view filename(zip_filename_buffer);
+    if (StringUtil::EndsWithNoCase(filename, DELTA_PATCH_SUFFIX))
+    {
+      filename.remove_suffix(std::strlen(DELTA_PATCH_SUFFIX));
+      if (strip_prefix)
+      {
+        const size_t prefix_length = std::strlen(strip_prefix);
+        if (filename.length() <= prefix_length || !StringUtil::StartsWithNoCase(filename, strip_prefix))
+        {
+          result = false;
+          break;
+        }
+        filename.remove_prefix(prefix_length);
+      }
+
+      if (unzOpenCurrentFile(zf) != UNZ_OK)
+      {
+        result = false;
+        break;
+      }
+
+      u8 header_buffer[sizeof(DeltaPatch::Header)];
+      const bool header_read = (unzReadCurrentFile(zf, header_buffer, sizeof(header_buffer)) ==
+                                static_cast<int>(sizeof(header_buffer)));
+      unzCloseCurrentFile(zf);
+
+      DeltaPatch::Header header;
+      if (!header_read || !DeltaPatch::GetHeader(header_buffer, sizeof(header_buffer), &header))
+      {
+        result = false;
+        break;
+      }
+
+      const std::string base_path = Path::Combine(root, filename);
+      const std::optional<std::vector<u8>> base_data = FileSystem::ReadBinaryFile(base_path.c_str());
+      if (!base_data.has_value() || base_data->size() != header.base_size ||
+          !DeltaPatch::HashMatches(header.base_hash, base_data->data(), base_data->size()))
+      {
+        Log_WarningPrintf("Delta base file '%s' does not match the patch.", base_path.c_str());
+        result = false;
+        break;
+      }
+    }
+
+    const int res = unzGoToNextFile(zf);
+    if (res == UNZ_END_OF_LIST_OF_FILE)
+      break;
+    if (res != UNZ_OK)
+    {
+      result = false;
+      break;
+    }
+  }
+
+  unzClose(zf);
+  return result;
+}
+
+#endif
+
 #ifdef _WIN32
 
 static constexpr char UPDATER_EXECUTABLE[] = "updater.exe";
@@ -531,6 +717,13 @@ bool AutoUpdaterDialog::processUpdate(const std::vector<u8>& update_data)
   return doUpdate(application_dir, update_zip_path, updater_path);
 }
 
+bool AutoUpdaterDialog::prepareDeltaUpdate(std::vector<u8>* update_data)
+{
+  // The delta zip is handed to the updater as-is; patches are applied against the install
+  // directory during staging. Check the base files up front while we can still fall back.
+  return ValidateDeltaBaseFiles(*update_data, EmuFolders::AppRoot, nullptr);
+}
+
 bool AutoUpdaterDialog::extractUpdater(const std::string& zip_path, const std::string& destination_path, Error* error)
 {
   unzFile zf = MinizipHelpers::OpenUnzFile(zip_path.c_str());
@@ -705,6 +898,16 @@ bool AutoUpdaterDialog::processUpdate(const std::vector<u8>& update_data)
   return true;
 }
 
+bool AutoUpdaterDialog::prepareDeltaUpdate(std::vector<u8>* update_data)
+{
+  const std::optional<std::string> bundle_path = CocoaTools::GetNonTranslocatedBundlePath();
+  if (!bundle_path.has_value())
+    return false;
+
+  // Patch entries carry the same DuckStation.app prefix as files in the full packages.
+  return ValidateDeltaBaseFiles(*update_data, bundle_path.value(), "DuckStation.app/");
+}
+
 void AutoUpdaterDialog::cleanupAfterUpdate()
 {
 }
@@ -791,6 +994,69 @@ bool AutoUpdaterDialog::processUpdate(const std::vector<u8>& update_data)
   return true;
 }
 
+bool AutoUpdaterDialog::prepareDeltaUpdate(std::vector<u8>* update_data)
+{
+  // For the AppImage, the delta package is a zip holding a single patch for the image itself.
+  // Apply it here; the patched image then feeds the normal full-update path above.
+  const char* appimage_path = std::getenv("APPIMAGE");
+  if (!appimage_path)
+    return false;
+
+  const std::optional<std::vector<u8>> base_data = FileSystem::ReadBinaryFile(appimage_path);
+  if (!base_data.has_value())
+    return false;
+
+  unzFile zf = MinizipHelpers::OpenUnzMemoryFile(update_data->data(), update_data->size());
+  if (!zf)
+    return false;
+
+  std::vector<u8> patch_data;
+  if (unzGoToFirstFile(zf) == UNZ_OK)
+  {
+    do
+    {
+      char zip_filename_buffer[256];
+      unz_file_info64 file_info;
+      if (unzGetCurrentFileInfo64(zf, &file_info, zip_filename_buffer, sizeof(zip_filename_buffer), nullptr, 0,
+                                  nullptr, 0) != UNZ_OK)
+      {
+        break;
+      }
+
+      if (StringUtil::EndsWithNoCase(zip_filename_buffer, DELTA_PATCH_SUFFIX) && unzOpenCurrentFile(zf) == UNZ_OK)
+      {
+        patch_data.resize(static_cast<size_t>(file_info.uncompressed_size));
+        if (unzReadCurrentFile(zf, patch_data.data(), static_cast<unsigned>(patch_data.size())) !=
+            static_cast<int>(patch_data.size()))
+        {
+          patch_data.clear();
+        }
+        unzCloseCurrentFile(zf);
+        break;
+      }
+    } while (unzGoToNextFile(zf) == UNZ_OK);
+  }
+  unzClose(zf);
+
+  if (patch_data.empty())
+  {
+    Log_ErrorPrintf("No patch found in delta update package.");
+    return false;
+  }
+
+  Error error;
+  std::vector<u8> patched_data;
+  if (!DeltaPatch::Apply(patch_data.data(), patch_data.size(), base_data->data(), base_data->size(), &patched_data,
+                         &error))
+  {
+    Log_ErrorPrintf("Failed to apply AppImage delta: %s", error.GetDescription().c_str());
+    return false;
+  }
+
+  *update_data = std::move(patched_data);
+  return true;
+}
+
 void AutoUpdaterDialog::cleanupAfterUpdate()
 {
   // Remove old/backup AppImage.
@@ -818,6 +1084,11 @@ bool AutoUpdaterDialog::processUpdate(const std::vector<u8>& update_data)
   return false;
 }
 
+bool AutoUpdaterDialog::prepareDeltaUpdate(std::vector<u8>* update_data)
+{
+  return false;
+}
+
 void AutoUpdaterDialog::cleanupAfterUpdate()
 {
 }
@@ -61,8 +61,15 @@ private:
   void queueGetChanges();
   void getChangesComplete(s32 status_code, std::vector<u8> response);
 
+  QString getDeltaAssetFilename() const;
+
   bool processUpdate(const std::vector<u8>& update_data);
 
+  /// Validates a downloaded delta package against the current install, and on platforms where the
+  /// patch is applied in-process, replaces update_data with the patched image. Returns false when
+  /// the delta does not match, in which case the full package is downloaded instead.
+  bool prepareDeltaUpdate(std::vector<u8>* update_data);
+
 #ifdef _WIN32
   bool doesUpdaterNeedElevation(const std::string& application_dir) const;
   bool doUpdate(const std::string& application_dir, const std::string& zip_path, const std::string& updater_path);
@@ -75,8 +82,15 @@ private:
   QTimer* m_http_poll_timer = nullptr;
   QString m_latest_sha;
   QString m_download_url;
+  QString m_download_sha256;
   int m_download_size = 0;
 
+  // The full package, retained as the fallback when a delta download fails to validate.
+  QString m_full_download_url;
+  QString m_full_download_sha256;
+  int m_full_download_size = 0;
+  bool m_is_delta_download = false;
+
   bool m_display_messages = false;
   bool m_update_will_break_save_states = false;
 };
@@ -5,17 +5,21 @@
 #include "common/file_system.h"
 #include "common/path.h"
 #include "common/string_util.h"
+#include "core/settings.h"
 #include "core/system.h"
 #include "qthost.h"
 #include "qtutils.h"
+#include "fmt/format.h"
 #include <QtConcurrent/QtConcurrent>
 #include <QtCore/QDate>
 #include <QtCore/QDateTime>
+#include <QtCore/QFile>
 #include <QtCore/QFuture>
 #include <QtCore/QFutureWatcher>
 #include <QtGui/QGuiApplication>
 #include <QtGui/QIcon>
 #include <QtGui/QPainter>
+#include <limits>
 
 static constexpr std::array<const char*, GameListModel::Column_Count> s_column_names = {
   {"Type", "Serial", "Title", "File Title", "Developer", "Publisher", "Genre", "Year", "Players", "Time Played",
@@ -26,6 +30,11 @@ static constexpr int COVER_ART_HEIGHT = 512;
 static constexpr int COVER_ART_SPACING = 32;
 static constexpr int MIN_COVER_CACHE_SIZE = 256;
 
+// Memory budget for decoded covers. The cache is sized by how many covers at the current cell
+// size and DPR fit in this budget, never less than the visible set, so shrinking the window does
+// not evict covers that would have to be decoded again when it grows back.
+static constexpr size_t COVER_CACHE_MEMORY_BUDGET = 64 * 1024 * 1024;
+
 static int DPRScale(int size, float dpr)
 {
   return static_cast<int>(static_cast<float>(size) * dpr);
@@ -98,6 +107,96 @@ static QPixmap createPlaceholderImage(const QPixmap& placeholder_pixmap, int wid
   return pm;
 }
 
+// Pre-scaled cover thumbnails are cached on disk so scrolling the grid never has to decode and
+// rescale a full-size cover image again. Each file is the raw premultiplied-ARGB bits of the
+// padded grid-cell pixmap, prefixed with a small header, and is memory-mapped on load. The cache
+// key incorporates the cell size and device pixel ratio, and the header records the cover file's
+// modification time, so changed covers and scale/DPI changes regenerate naturally.
+namespace {
+#pragma pack(push, 1)
+struct ThumbnailCacheHeader
+{
+  u32 magic;
+  u32 width; // in device pixels
+  u32 height;
+  u32 image_format;
+  float device_pixel_ratio;
+  s64 source_modified_time;
+};
+#pragma pack(pop)
+} // namespace
+
+static constexpr u32 THUMBNAIL_CACHE_MAGIC = 0x31435647; // 'GVC1'
+
+static std::string getCachedThumbnailPath(const std::string& cover_path, int width, int height, float dpr)
+{
+  const std::string key(fmt::format("{}|{}x{}@{}", cover_path, width, height, dpr));
+  return Path::Combine(EmuFolders::Cache,
+                       fmt::format("covers" FS_OSPATH_SEPARATOR_STR "{:016X}.thumb", std::hash<std::string>{}(key)));
+}
+
+static QPixmap tryLoadCachedThumbnail(const std::string& thumbnail_path, const std::string& cover_path, float dpr)
+{
+  FILESYSTEM_STAT_DATA sd;
+  if (!FileSystem::StatFile(cover_path.c_str(), &sd))
+    return QPixmap();
+
+  QFile file(QString::fromStdString(thumbnail_path));
+  if (!file.open(QIODevice::ReadOnly) || file.size() < static_cast<qint64>(sizeof(ThumbnailCacheHeader)))
+    return QPixmap();
+
+  const uchar* map = file.map(0, file.size());
+  if (!map)
+    return QPixmap();
+
+  ThumbnailCacheHeader header;
+  std::memcpy(&header, map, sizeof(header));
+  const QImage::Format format = static_cast<QImage::Format>(header.image_format);
+  if (header.magic != THUMBNAIL_CACHE_MAGIC || header.device_pixel_ratio != dpr ||
+      header.source_modified_time != static_cast<s64>(sd.ModificationTime) || header.width == 0 ||
+      header.height == 0 || format != QImage::Format_ARGB32_Premultiplied ||
+      file.size() != static_cast<qint64>(sizeof(header) + (static_cast<u64>(header.width) * header.height * 4)))
+  {
+    return QPixmap();
+  }
+
+  // fromImage() deep-copies the bits, so the mapping can go away when the file closes.
+  QImage image(map + sizeof(header), header.width, header.height, header.width * 4, format);
+  image.setDevicePixelRatio(dpr);
+  return QPixmap::fromImage(image);
+}
+
+static void storeCachedThumbnail(const std::string& thumbnail_path, const std::string& cover_path, const QPixmap& pm)
+{
+  FILESYSTEM_STAT_DATA sd;
+  if (!FileSystem::StatFile(cover_path.c_str(), &sd))
+    return;
+
+  QImage image = pm.toImage();
+  if (image.isNull())
+    return;
+  else if (image.format() != QImage::Format_ARGB32_Premultiplied)
+    image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+  FileSystem::EnsureDirectoryExists(Path::Combine(EmuFolders::Cache, "covers").c_str(), false);
+
+  QFile file(QString::fromStdString(thumbnail_path));
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    return;
+
+  const ThumbnailCacheHeader header = {THUMBNAIL_CACHE_MAGIC,
+                                       static_cast<u32>(image.width()),
+                                       static_cast<u32>(image.height()),
+                                       static_cast<u32>(image.format()),
+                                       static_cast<float>(pm.devicePixelRatio()),
+                                       static_cast<s64>(sd.ModificationTime)};
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  // Write row-by-row, since bytesPerLine() can include alignment padding.
+  for (int y = 0; y < image.height(); y++)
+    file.write(reinterpret_cast<const char*>(image.constScanLine(y)), static_cast<qint64>(image.width()) * 4);
+}
+
 std::optional<GameListModel::Column> GameListModel::getColumnIdForName(std::string_view name)
 {
   for (int column = 0; column < Column_Count; column++)
@@ -128,6 +227,7 @@ void GameListModel::setCoverScale(float scale)
   if (m_cover_scale == scale)
     return;
 
+  m_cover_load_generation++;
   m_cover_pixmap_cache.Clear();
   m_cover_scale = scale;
   m_loading_pixmap = QPixmap(getCoverArtWidth(), getCoverArtHeight());
@@ -138,6 +238,7 @@ void GameListModel::setCoverScale(float scale)
 
 void GameListModel::refreshCovers()
 {
+  m_cover_load_generation++;
   m_cover_pixmap_cache.Clear();
   refresh();
 }
@@ -149,7 +250,15 @@ void GameListModel::updateCacheSize(int width, int height)
   const int cover_height = getCoverArtHeight();
   const int num_columns = ((width + (cover_width - 1)) / cover_width);
   const int num_rows = ((height + (cover_height - 1)) / cover_height);
-  m_cover_pixmap_cache.SetMaxCapacity(static_cast<int>(std::max(num_columns * num_rows, MIN_COVER_CACHE_SIZE)));
+
+  const float dpr = qApp->devicePixelRatio();
+  const size_t bytes_per_cover = static_cast<size_t>(static_cast<float>(cover_width) * dpr) *
+                                 static_cast<size_t>(static_cast<float>(cover_height) * dpr) * 4;
+  const int budget_covers =
+    static_cast<int>(std::min<size_t>(COVER_CACHE_MEMORY_BUDGET / std::max<size_t>(bytes_per_cover, 1),
+                                      static_cast<size_t>(std::numeric_limits<int>::max())));
+  m_cover_pixmap_cache.SetMaxCapacity(
+    static_cast<size_t>(std::max(std::max(num_columns * num_rows, MIN_COVER_CACHE_SIZE), budget_covers)));
 }
 
 void GameListModel::reloadThemeSpecificImages()
@@ -160,30 +269,49 @@ void GameListModel::reloadThemeSpecificImages()
 
 void GameListModel::loadOrGenerateCover(const GameList::Entry* ge)
 {
-  QFuture<QPixmap> future =
-    QtConcurrent::run([this, path = ge->path, title = ge->title, serial = ge->serial]() -> QPixmap {
+  // Capture the cell geometry by value; the job must not read model state that can change while
+  // it's in flight on the pool thread.
+  const u32 generation = m_cover_load_generation;
+  const int cover_width = getCoverArtWidth();
+  const int cover_height = getCoverArtHeight();
+  const float cover_scale = m_cover_scale;
+
+  QFuture<QPixmap> future = QtConcurrent::run(
+    [this, path = ge->path, title = ge->title, serial = ge->serial, cover_width, cover_height, cover_scale]() -> QPixmap {
       QPixmap image;
       const std::string cover_path(GameList::GetCoverImagePath(path, serial, title));
       if (!cover_path.empty())
       {
         const float dpr = qApp->devicePixelRatio();
-        image = QPixmap(QString::fromStdString(cover_path));
-        if (!image.isNull())
+        const std::string thumbnail_path(getCachedThumbnailPath(cover_path, cover_width, cover_height, dpr));
+
+        // Use the pre-scaled thumbnail from a previous run if there is one, skipping the decode.
+        image = tryLoadCachedThumbnail(thumbnail_path, cover_path, dpr);
+        if (image.isNull())
         {
-          image.setDevicePixelRatio(dpr);
-          resizeAndPadPixmap(&image, getCoverArtWidth(), getCoverArtHeight(), dpr);
+          image = QPixmap(QString::fromStdString(cover_path));
+          if (!image.isNull())
+          {
+            image.setDevicePixelRatio(dpr);
+            resizeAndPadPixmap(&image, cover_width, cover_height, dpr);
+            storeCachedThumbnail(thumbnail_path, cover_path, image);
+          }
         }
       }
 
       if (image.isNull())
-        image =
-          createPlaceholderImage(m_placeholder_pixmap, getCoverArtWidth(), getCoverArtHeight(), m_cover_scale, title);
+        image = createPlaceholderImage(m_placeholder_pixmap, cover_width, cover_height, cover_scale, title);
 
       return image;
     });
 
   // Context must be 'this' so we run on the UI thread.
-  future.then(this, [this, path = ge->path](QPixmap pm) {
+  future.then(this, [this, generation, path = ge->path](QPixmap pm) {
+    // A stale result from before a scale change or refresh would be the wrong size; drop it and
+    // let the next paint of the cell start a fresh job.
+    if (generation != m_cover_load_generation)
+      return;
+
     m_cover_pixmap_cache.Insert(std::move(path), std::move(pm));
     invalidateCoverForPath(path);
   });
@@ -274,13 +402,13 @@ QVariant GameListModel::data(const QModelIndex& index, int role) const
           return QtUtils::StringViewToQString(Path::GetFileTitle(ge->path));
 
         case Column_Developer:
-          return QString::fromStdString(ge->developer);
+          return QtUtils::StringViewToQString(ge->developer);
 
         case Column_Publisher:
-          return QString::fromStdString(ge->publisher);
+          return QtUtils::StringViewToQString(ge->publisher);
 
         case Column_Genre:
-          return QString::fromStdString(ge->genre);
+          return QtUtils::StringViewToQString(ge->genre);
 
         case Column_Year:
         {
@@ -353,13 +481,13 @@ QVariant GameListModel::data(const QModelIndex& index, int role) const
           return QtUtils::StringViewToQString(Path::GetFileTitle(ge->path));
 
         case Column_Developer:
-          return QString::fromStdString(ge->developer);
+          return QtUtils::StringViewToQString(ge->developer);
 
         case Column_Publisher:
-          return QString::fromStdString(ge->publisher);
+          return QtUtils::StringViewToQString(ge->publisher);
 
         case Column_Genre:
-          return QString::fromStdString(ge->genre);
+          return QtUtils::StringViewToQString(ge->genre);
 
         case Column_Year:
           return QDateTime::fromSecsSinceEpoch(static_cast<qint64>(ge->release_date), Qt::UTC).date().year();
@@ -447,6 +575,25 @@ void GameListModel::refresh()
   endResetModel();
 }
 
+void GameListModel::entryAdded(u32 index)
+{
+  beginInsertRows(QModelIndex(), static_cast<int>(index), static_cast<int>(index));
+  endInsertRows();
+}
+
+void GameListModel::entryChanged(u32 index)
+{
+  const int row = static_cast<int>(index);
+  emit dataChanged(createIndex(row, 0), createIndex(row, Column_Count - 1));
+}
+
+void GameListModel::removeEntry(u32 index)
+{
+  beginRemoveRows(QModelIndex(), static_cast<int>(index), static_cast<int>(index));
+  GameList::RemoveEntryByIndex(index);
+  endRemoveRows();
+}
+
 bool GameListModel::titlesLessThan(int left_row, int right_row) const
 {
   if (left_row < 0 || left_row >= static_cast<int>(GameList::GetEntryCount()) || right_row < 0 ||
@@ -547,21 +694,21 @@ bool GameListModel::lessThan(const QModelIndex& left_index, const QModelIndex& r
     {
       if (left->genre == right->genre)
         return titlesLessThan(left_row, right_row);
-      return (StringUtil::Strcasecmp(left->genre.c_str(), right->genre.c_str()) < 0);
+      return (StringUtil::Strcasecmp(left->genre.data(), right->genre.data()) < 0);
     }
 
     case Column_Developer:
     {
       if (left->developer == right->developer)
         return titlesLessThan(left_row, right_row);
-      return (StringUtil::Strcasecmp(left->developer.c_str(), right->developer.c_str()) < 0);
+      return (StringUtil::Strcasecmp(left->developer.data(), right->developer.data()) < 0);
     }
 
     case Column_Publisher:
     {
       if (left->publisher == right->publisher)
         return titlesLessThan(left_row, right_row);
-      return (StringUtil::Strcasecmp(left->publisher.c_str(), right->publisher.c_str()) < 0);
+      return (StringUtil::Strcasecmp(left->publisher.data(), right->publisher.data()) < 0);
     }
 
     case Column_Year:
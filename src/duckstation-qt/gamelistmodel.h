@@ -59,6 +59,14 @@ public:
   void refresh();
   void reloadThemeSpecificImages();
 
+  // Row-level updates for incremental refreshes, so a single-file change doesn't reset the whole
+  // model. entryAdded()/entryChanged() are notifications for changes the game list has already
+  // made; removeEntry() performs the removal itself so the row disappears inside the
+  // begin/endRemoveRows() bracket.
+  void entryAdded(u32 index);
+  void entryChanged(u32 index);
+  void removeEntry(u32 index);
+
   bool titlesLessThan(int left_row, int right_row) const;
 
   bool lessThan(const QModelIndex& left_index, const QModelIndex& right_index, int column) const;
@@ -85,6 +93,11 @@ private:
   void invalidateCoverForPath(const std::string& path);
 
   float m_cover_scale = 0.0f;
+
+  // Bumped whenever cached covers are invalidated (scale change, refresh). In-flight decode jobs
+  // carry the generation they were started under, and results from stale generations are dropped
+  // instead of repopulating the cache with wrong-sized pixmaps.
+  u32 m_cover_load_generation = 0;
   bool m_show_titles_for_covers = false;
 
   std::array<QString, Column_Count> m_column_display_names;
@@ -12,9 +12,13 @@
 #include "core/settings.h"
 
 #include "common/assert.h"
+#include "common/file_system.h"
+#include "common/path.h"
 #include "common/string_util.h"
 
+#include <QtCore/QFileSystemWatcher>
 #include <QtCore/QSortFilterProxyModel>
+#include <QtCore/QTimer>
 #include <QtGui/QGuiApplication>
 #include <QtGui/QPixmap>
 #include <QtGui/QWheelEvent>
@@ -22,15 +26,22 @@
 #include <QtWidgets/QMenu>
 #include <QtWidgets/QScrollBar>
 
+#include <algorithm>
+
 static constexpr float MIN_SCALE = 0.1f;
 static constexpr float MAX_SCALE = 2.0f;
 
+// How long to wait after the last filesystem notification before rescanning the changed
+// directories. Copies into the library tend to generate bursts of events for the same file.
+static constexpr int WATCHER_DEBOUNCE_INTERVAL_MS = 1000;
+
 static const char* SUPPORTED_FORMATS_STRING =
   QT_TRANSLATE_NOOP(GameListWidget, ".cue (Cue Sheets)\n"
                                     ".iso/.img (Single Track Image)\n"
                                     ".ecm (Error Code Modeling Image)\n"
                                     ".mds (Media Descriptor Sidecar)\n"
                                     ".chd (Compressed Hunks of Data)\n"
+                                    ".zcd (Zstd Compressed Disc)\n"
                                     ".pbp (PlayStation Portable, Only Decrypted)");
 
 class GameListSortModel final : public QSortFilterProxyModel
@@ -191,6 +202,15 @@ void GameListWidget::initialize()
   connect(m_empty_ui.scanForNewGames, &QPushButton::clicked, this, [this]() { refresh(false); });
   m_ui.stack->insertWidget(2, m_empty_widget);
 
+  // Incremental refresh: watch the configured directories (inotify/ReadDirectoryChangesW under the
+  // hood), and feed single-file changes through the game list instead of rescanning everything.
+  m_watcher = new QFileSystemWatcher(this);
+  connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &GameListWidget::onWatchedDirectoryChanged);
+  m_watcher_debounce_timer = new QTimer(this);
+  m_watcher_debounce_timer->setSingleShot(true);
+  m_watcher_debounce_timer->setInterval(WATCHER_DEBOUNCE_INTERVAL_MS);
+  connect(m_watcher_debounce_timer, &QTimer::timeout, this, &GameListWidget::processWatchedDirectoryChanges);
+
   if (Host::GetBaseBoolSettingValue("UI", "GameListGridView", false))
     m_ui.stack->setCurrentIndex(1);
   else
@@ -263,11 +283,147 @@ void GameListWidget::onRefreshComplete()
   delete m_refresh_thread;
   m_refresh_thread = nullptr;
 
+  // The search directories (or their contents) may have changed, re-sync the watches. Anything the
+  // watcher queued up during the refresh has been covered by it.
+  m_pending_changed_directories.clear();
+  updateWatchedDirectories();
+
   // if we still had no games, switch to the helper widget
   if (m_model->rowCount() == 0)
     m_ui.stack->setCurrentIndex(2);
 }
 
+void GameListWidget::updateWatchedDirectories()
+{
+  const QStringList old_directories(m_watcher->directories());
+  if (!old_directories.isEmpty())
+    m_watcher->removePaths(old_directories);
+
+  QStringList directories;
+  for (const std::string& dir : Host::GetBaseStringListSetting("GameList", "Paths"))
+    directories.append(QString::fromStdString(dir));
+  for (const std::string& dir : Host::GetBaseStringListSetting("GameList", "RecursivePaths"))
+  {
+    directories.append(QString::fromStdString(dir));
+
+    // Directory watches don't extend to subdirectories, so each one needs its own.
+    FileSystem::FindResultsArray subdirs;
+    FileSystem::FindFiles(dir.c_str(), "*",
+                          FILESYSTEM_FIND_FOLDERS | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE,
+                          &subdirs);
+    for (const FILESYSTEM_FIND_DATA& fd : subdirs)
+      directories.append(QString::fromStdString(fd.FileName));
+  }
+
+  directories.removeDuplicates();
+  if (!directories.isEmpty())
+    m_watcher->addPaths(directories);
+}
+
+void GameListWidget::onWatchedDirectoryChanged(const QString& path)
+{
+  if (!m_pending_changed_directories.contains(path))
+    m_pending_changed_directories.append(path);
+
+  // restarts the timer if it's already running, coalescing bursts of events
+  m_watcher_debounce_timer->start();
+}
+
+static bool IsPathInWatchedDirectory(const std::string& path, const std::string& dir, bool recursive)
+{
+  if (path.length() <= dir.length() || !StringUtil::StartsWithNoCase(path, dir) ||
+      (path[dir.length()] != FS_OSPATH_SEPARATOR_CHARACTER && path[dir.length()] != '/'))
+  {
+    return false;
+  }
+
+  return recursive || Path::GetDirectory(path).length() == dir.length();
+}
+
+void GameListWidget::processWatchedDirectoryChanges()
+{
+  const QStringList changed_directories(m_pending_changed_directories);
+  m_pending_changed_directories.clear();
+
+  // A full refresh in flight covers anything the watcher noticed.
+  if (m_refresh_thread)
+    return;
+
+  const std::vector<std::string> excluded_paths(Host::GetBaseStringListSetting("GameList", "ExcludedPaths"));
+  const std::vector<std::string> recursive_dirs(Host::GetBaseStringListSetting("GameList", "RecursivePaths"));
+
+  for (const QString& changed_directory : changed_directories)
+  {
+    const std::string dir(changed_directory.toStdString());
+
+    // Subdirectories of a recursive search directory are covered by it, and changes within them
+    // need to be handled recursively too, for files inside freshly-created subdirectories.
+    bool recursive = false;
+    for (const std::string& root : recursive_dirs)
+    {
+      if (dir == root || IsPathInWatchedDirectory(dir, root, true))
+      {
+        recursive = true;
+        break;
+      }
+    }
+
+    // Drop entries whose files have disappeared.
+    {
+      const auto lock = GameList::GetLock();
+      for (u32 i = 0; i < GameList::GetEntryCount();)
+      {
+        const GameList::Entry* entry = GameList::GetEntryByIndex(i);
+        if (IsPathInWatchedDirectory(entry->path, dir, recursive) && !FileSystem::FileExists(entry->path.c_str()))
+        {
+          m_model->removeEntry(i);
+          continue;
+        }
+
+        i++;
+      }
+    }
+
+    // Scan anything new or modified.
+    FileSystem::FindResultsArray files;
+    FileSystem::FindFiles(dir.c_str(), "*",
+                          recursive ? (FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE) :
+                                      (FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES),
+                          &files);
+    for (FILESYSTEM_FIND_DATA& fd : files)
+    {
+      if (!GameList::IsScannableFilename(fd.FileName) ||
+          std::find(excluded_paths.begin(), excluded_paths.end(), fd.FileName) != excluded_paths.end())
+      {
+        continue;
+      }
+
+      {
+        const auto lock = GameList::GetLock();
+        const GameList::Entry* entry = GameList::GetEntryForPath(fd.FileName.c_str());
+        if (entry && entry->last_modified_time == fd.ModificationTime)
+          continue;
+      }
+
+      u32 index;
+      const GameList::FileScanResult result = GameList::ScanFile(std::move(fd.FileName), &index);
+      if (result == GameList::FileScanResult::Added)
+        m_model->entryAdded(index);
+      else if (result == GameList::FileScanResult::Updated)
+        m_model->entryChanged(index);
+    }
+  }
+
+  // Created/removed subdirectories need their watches updated as well.
+  updateWatchedDirectories();
+
+  // if this was the first game added, switch away from the placeholder
+  if (m_ui.stack->currentIndex() == 2 && m_model->rowCount() > 0)
+    m_ui.stack->setCurrentIndex(Host::GetBaseBoolSettingValue("UI", "GameListGridView", false) ? 1 : 0);
+  else if (m_model->rowCount() == 0)
+    m_ui.stack->setCurrentIndex(2);
+}
+
 void GameListWidget::onSelectionModelCurrentChanged(const QModelIndex& current, const QModelIndex& previous)
 {
   const QModelIndex source_index = m_sort_model->mapToSource(current);
@@ -7,11 +7,15 @@
 
 #include "core/game_list.h"
 
+#include <QtCore/QStringList>
 #include <QtWidgets/QListView>
 #include <QtWidgets/QTableView>
 
 Q_DECLARE_METATYPE(const GameList::Entry*);
 
+class QFileSystemWatcher;
+class QTimer;
+
 class GameListModel;
 class GameListSortModel;
 class GameListRefreshThread;
@@ -69,6 +73,9 @@ private Q_SLOTS:
   void onRefreshProgress(const QString& status, int current, int total);
   void onRefreshComplete();
 
+  void onWatchedDirectoryChanged(const QString& path);
+  void processWatchedDirectoryChanges();
+
   void onSelectionModelCurrentChanged(const QModelIndex& current, const QModelIndex& previous);
   void onTableViewItemActivated(const QModelIndex& index);
   void onTableViewContextMenuRequested(const QPoint& point);
@@ -98,6 +105,7 @@ private:
   void saveTableViewColumnSortSettings();
   void listZoom(float delta);
   void updateToolbar();
+  void updateWatchedDirectories();
 
   Ui::GameListWidget m_ui;
 
@@ -110,4 +118,8 @@ private:
   Ui::EmptyGameListWidget m_empty_ui;
 
   GameListRefreshThread* m_refresh_thread = nullptr;
+
+  QFileSystemWatcher* m_watcher = nullptr;
+  QTimer* m_watcher_debounce_timer = nullptr;
+  QStringList m_pending_changed_directories;
 };
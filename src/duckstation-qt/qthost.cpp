@@ -41,6 +41,7 @@
 #include "util/input_manager.h"
 #include "util/platform_misc.h"
 #include "util/postprocessing.h"
+#include "util/resource_bundle.h"
 
 #include "scmversion/scmversion.h"
 
@@ -80,6 +81,10 @@ static constexpr u32 BACKGROUND_CONTROLLER_POLLING_INTERVAL = 100;
 /// Poll at half the vsync rate for FSUI to reduce the chance of getting a press+release in the same frame.
 static constexpr u32 FULLSCREEN_UI_CONTROLLER_POLLING_INTERVAL = 8;
 
+/// How long we wait after startup before kicking off the update check, so it doesn't compete with
+/// the first paint and the game list load for disk/network time.
+static constexpr u32 STARTUP_UPDATE_CHECK_DELAY_MS = 500;
+
 //////////////////////////////////////////////////////////////////////////
 // Local function declarations
 //////////////////////////////////////////////////////////////////////////
@@ -401,8 +406,11 @@ bool QtHost::SetCriticalFolders()
   // Write crash dumps to the data directory, since that'll be accessible for certain.
   CrashHandler::SetWriteDirectory(EmuFolders::DataRoot);
 
-  // the resources directory should exist, bail out if not
-  if (!FileSystem::DirectoryExists(EmuFolders::Resources.c_str()))
+  // a compressed bundle can stand in for the loose resources directory
+  ResourceBundle::Open(Path::Combine(EmuFolders::AppRoot, ResourceBundle::DEFAULT_FILENAME).c_str());
+
+  // the resources directory (or a bundle) should exist, bail out if not
+  if (!FileSystem::DirectoryExists(EmuFolders::Resources.c_str()) && !ResourceBundle::IsOpen())
   {
     QMessageBox::critical(nullptr, QStringLiteral("Error"),
                           QStringLiteral("Resources directory is missing, your installation is incomplete."));
@@ -739,10 +747,9 @@ void EmuThread::resumeSystemFromMostRecentState()
 
 void EmuThread::onDisplayWindowKeyEvent(int key, bool pressed)
 {
-  DebugAssert(isOnThread());
-
-  InputManager::InvokeEvents(InputManager::MakeHostKeyboardKey(key), static_cast<float>(pressed),
-                             GenericInputBinding::Unknown);
+  // Runs on the UI thread; the event fires on the emu thread at the next input poll.
+  InputManager::QueueEvent(InputManager::MakeHostKeyboardKey(key), static_cast<float>(pressed),
+                           GenericInputBinding::Unknown);
 }
 
 void EmuThread::onDisplayWindowTextEntered(const QString& text)
@@ -754,16 +761,14 @@ void EmuThread::onDisplayWindowTextEntered(const QString& text)
 
 void EmuThread::onDisplayWindowMouseButtonEvent(int button, bool pressed)
 {
-  DebugAssert(isOnThread());
-
-  InputManager::InvokeEvents(InputManager::MakePointerButtonKey(0, button), static_cast<float>(pressed),
-                             GenericInputBinding::Unknown);
+  // Runs on the UI thread; the event fires on the emu thread at the next input poll.
+  InputManager::QueueEvent(InputManager::MakePointerButtonKey(0, button), static_cast<float>(pressed),
+                           GenericInputBinding::Unknown);
 }
 
 void EmuThread::onDisplayWindowMouseWheelEvent(const QPoint& delta_angle)
 {
-  DebugAssert(isOnThread());
-
+  // Runs on the UI thread; the deltas accumulate atomically until the next input poll.
   const float dx = std::clamp(static_cast<float>(delta_angle.x()) / QtUtils::MOUSE_WHEEL_DELTA, -1.0f, 1.0f);
   if (dx != 0.0f)
     InputManager::UpdatePointerRelativeDelta(0, InputPointerAxis::WheelX, dx);
@@ -886,10 +891,16 @@ void EmuThread::connectDisplaySignals(DisplayWidget* widget)
 
   connect(widget, &DisplayWidget::windowResizedEvent, this, &EmuThread::onDisplayWindowResized);
   connect(widget, &DisplayWidget::windowRestoredEvent, this, &EmuThread::redrawDisplayWindow);
-  connect(widget, &DisplayWidget::windowKeyEvent, this, &EmuThread::onDisplayWindowKeyEvent);
+
+  // Key/button/wheel events are pushed into InputManager's lock-free queue on the UI thread and
+  // drained once per slice by PollSources(), instead of a queued invocation per event.
+  connect(widget, &DisplayWidget::windowKeyEvent, this, &EmuThread::onDisplayWindowKeyEvent,
+          Qt::DirectConnection);
   connect(widget, &DisplayWidget::windowTextEntered, this, &EmuThread::onDisplayWindowTextEntered);
-  connect(widget, &DisplayWidget::windowMouseButtonEvent, this, &EmuThread::onDisplayWindowMouseButtonEvent);
-  connect(widget, &DisplayWidget::windowMouseWheelEvent, this, &EmuThread::onDisplayWindowMouseWheelEvent);
+  connect(widget, &DisplayWidget::windowMouseButtonEvent, this, &EmuThread::onDisplayWindowMouseButtonEvent,
+          Qt::DirectConnection);
+  connect(widget, &DisplayWidget::windowMouseWheelEvent, this, &EmuThread::onDisplayWindowMouseWheelEvent,
+          Qt::DirectConnection);
 }
 
 void Host::OnSystemStarting()
@@ -1645,14 +1656,17 @@ ALWAYS_INLINE std::string QtHost::GetResourcePath(std::string_view filename, boo
 
 bool Host::ResourceFileExists(std::string_view filename, bool allow_override)
 {
+  // loose files (including user overrides) take precedence over the bundle
   const std::string path = QtHost::GetResourcePath(filename, allow_override);
-  return FileSystem::FileExists(path.c_str());
+  return FileSystem::FileExists(path.c_str()) || ResourceBundle::HasFile(filename);
 }
 
 std::optional<std::vector<u8>> Host::ReadResourceFile(std::string_view filename, bool allow_override)
 {
   const std::string path = QtHost::GetResourcePath(filename, allow_override);
   std::optional<std::vector<u8>> ret(FileSystem::ReadBinaryFile(path.c_str()));
+  if (!ret.has_value())
+    ret = ResourceBundle::ReadBinaryFile(filename);
   if (!ret.has_value())
     Log_ErrorFmt("Failed to read resource file '{}'", filename);
   return ret;
@@ -1662,6 +1676,8 @@ std::optional<std::string> Host::ReadResourceFileToString(std::string_view filen
 {
   const std::string path = QtHost::GetResourcePath(filename, allow_override);
   std::optional<std::string> ret(FileSystem::ReadFileToString(path.c_str()));
+  if (!ret.has_value())
+    ret = ResourceBundle::ReadFileToString(filename);
   if (!ret.has_value())
     Log_ErrorFmt("Failed to read resource file to string '{}'", filename);
   return ret;
@@ -1674,6 +1690,10 @@ std::optional<std::time_t> Host::GetResourceFileTimestamp(std::string_view filen
   FILESYSTEM_STAT_DATA sd;
   if (!FileSystem::StatFile(path.c_str(), &sd))
   {
+    // bundled entries share the timestamp of the bundle itself
+    if (ResourceBundle::HasFile(filename))
+      return ResourceBundle::GetTimestamp();
+
     Log_ErrorFmt("Failed to stat resource file '{}'", filename);
     return std::nullopt;
   }
@@ -2265,27 +2285,30 @@ int main(int argc, char* argv[])
   // Create all window objects, the emuthread might still be starting up at this point.
   main_window = new MainWindow();
 
+  // Don't bother showing the window in no-gui mode. Show it before starting the game list
+  // refresh, so the first paint isn't queued behind the refresh thread's progress events.
+  if (!s_nogui_mode)
+    main_window->show();
+
   // When running in batch mode, ensure game list is loaded, but don't scan for any new files.
+  // The refresh runs on its own thread, overlapping the remaining startup work below.
   if (!s_batch_mode)
     main_window->refreshGameList(false);
   else
     GameList::Refresh(false, true);
 
-  // Don't bother showing the window in no-gui mode.
-  if (!s_nogui_mode)
-    main_window->show();
-
   // Initialize big picture mode if requested.
   if (s_start_fullscreen_ui)
     g_emu_thread->startFullscreenUI();
   else
     s_start_fullscreen_ui_fullscreen = false;
 
-  // Skip the update check if we're booting a game directly.
+  // Skip the update check if we're booting a game directly. Otherwise defer it until after the
+  // window has painted and the game list has had a chance to load; it's not startup-critical.
   if (autoboot)
     g_emu_thread->bootSystem(std::move(autoboot));
   else if (!s_nogui_mode)
-    main_window->startupUpdateCheck();
+    QTimer::singleShot(STARTUP_UPDATE_CHECK_DELAY_MS, main_window, &MainWindow::startupUpdateCheck);
 
   // This doesn't return until we exit.
   result = app.exec();
@@ -14,6 +14,7 @@
 #include "util/imgui_manager.h"
 #include "util/input_manager.h"
 #include "util/platform_misc.h"
+#include "util/resource_bundle.h"
 
 #include "common/assert.h"
 #include "common/crash_handler.h"
@@ -24,8 +25,19 @@
 #include "common/path.h"
 #include "common/string_util.h"
 
+#include <algorithm>
 #include <csignal>
 #include <cstdio>
+#include <thread>
+
+#ifdef _WIN32
+#include "common/windows_headers.h"
+#include <process.h>
+#else
+#include <cerrno>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 Log_SetChannel(RegTestHost);
 
@@ -38,12 +50,15 @@ static void InitializeEarlyConsole();
 static void HookSignals();
 static bool SetFolders();
 static std::string GetFrameDumpFilename(u32 frame);
+static bool GatherJobPaths(const std::string& source, std::vector<std::string>* paths);
+static int DispatchJobs(int argc, char* argv[], const std::string& source);
 } // namespace RegTestHost
 
 static std::unique_ptr<MemorySettingsInterface> s_base_settings_interface;
 
 static u32 s_frames_to_run = 60 * 60;
 static u32 s_frame_dump_interval = 0;
+static u32 s_parallel_jobs = 0;
 static std::string s_dump_base_directory;
 static std::string s_dump_game_directory;
 
@@ -72,8 +87,11 @@ bool RegTestHost::SetFolders()
   // Write crash dumps to the data directory, since that'll be accessible for certain.
   CrashHandler::SetWriteDirectory(EmuFolders::DataRoot);
 
-  // the resources directory should exist, bail out if not
-  if (!FileSystem::DirectoryExists(EmuFolders::Resources.c_str()))
+  // a compressed bundle can stand in for the loose resources directory
+  ResourceBundle::Open(Path::Combine(EmuFolders::AppRoot, ResourceBundle::DEFAULT_FILENAME).c_str());
+
+  // the resources directory (or a bundle) should exist, bail out if not
+  if (!FileSystem::DirectoryExists(EmuFolders::Resources.c_str()) && !ResourceBundle::IsOpen())
   {
     Log_ErrorPrint("Resources directory is missing, your installation is incomplete.");
     return false;
@@ -191,14 +209,17 @@ void Host::CommitBaseSettingChanges()
 
 bool Host::ResourceFileExists(std::string_view filename, bool allow_override)
 {
+  // loose files take precedence over the bundle
   const std::string path(Path::Combine(EmuFolders::Resources, filename));
-  return FileSystem::FileExists(path.c_str());
+  return FileSystem::FileExists(path.c_str()) || ResourceBundle::HasFile(filename);
 }
 
 std::optional<std::vector<u8>> Host::ReadResourceFile(std::string_view filename, bool allow_override)
 {
   const std::string path(Path::Combine(EmuFolders::Resources, filename));
   std::optional<std::vector<u8>> ret(FileSystem::ReadBinaryFile(path.c_str()));
+  if (!ret.has_value())
+    ret = ResourceBundle::ReadBinaryFile(filename);
   if (!ret.has_value())
     Log_ErrorPrintf("Failed to read resource file '%s'", filename);
   return ret;
@@ -208,6 +229,8 @@ std::optional<std::string> Host::ReadResourceFileToString(std::string_view filen
 {
   const std::string path(Path::Combine(EmuFolders::Resources, filename));
   std::optional<std::string> ret(FileSystem::ReadFileToString(path.c_str()));
+  if (!ret.has_value())
+    ret = ResourceBundle::ReadFileToString(filename);
   if (!ret.has_value())
     Log_ErrorPrintf("Failed to read resource file to string '%s'", filename);
   return ret;
@@ -219,6 +242,10 @@ std::optional<std::time_t> Host::GetResourceFileTimestamp(std::string_view filen
   FILESYSTEM_STAT_DATA sd;
   if (!FileSystem::StatFile(path.c_str(), &sd))
   {
+    // bundled entries share the timestamp of the bundle itself
+    if (ResourceBundle::HasFile(filename))
+      return ResourceBundle::GetTimestamp();
+
     Log_ErrorPrintf("Failed to stat resource file '%s'", filename);
     return std::nullopt;
   }
@@ -337,7 +364,10 @@ void Host::BeginPresentFrame()
   if (s_frame_dump_interval > 0 && (s_frame_dump_interval == 1 || (frame % s_frame_dump_interval) == 0))
   {
     std::string dump_filename(RegTestHost::GetFrameDumpFilename(frame));
-    g_gpu->WriteDisplayTextureToFile(std::move(dump_filename));
+
+    // Pipelined readback: the copy is fenced and the PNG encode runs on a worker thread, so the
+    // emulation thread never blocks on the GPU between dumped frames.
+    g_gpu->WriteDisplayTextureToFile(std::move(dump_filename), true);
   }
 }
 
@@ -473,6 +503,9 @@ void RegTestHost::PrintCommandLineHelp(const char* progname)
   std::fprintf(stderr, "  -dumpdir: Set frame dump base directory (will be dumped to basedir/gametitle).\n");
   std::fprintf(stderr, "  -dumpinterval: Dumps every N frames.\n");
   std::fprintf(stderr, "  -frames: Sets the number of frames to execute.\n");
+  std::fprintf(stderr, "  -jobs <count>: Runs multiple games in parallel child processes. The boot\n"
+                       "    filename is treated as a directory to scan, or a text file listing one\n"
+                       "    game path per line.\n");
   std::fprintf(stderr, "  -log <level>: Sets the log level. Defaults to verbose.\n");
   std::fprintf(stderr, "  -renderer <renderer>: Sets the graphics renderer. Default to software.\n");
   std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
@@ -542,6 +575,17 @@ bool RegTestHost::ParseCommandLineParameters(int argc, char* argv[], std::option
 
         continue;
       }
+      else if (CHECK_ARG_PARAM("-jobs"))
+      {
+        s_parallel_jobs = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_parallel_jobs == 0)
+        {
+          Log_ErrorPrintf("Invalid job count specified: %s", argv[i]);
+          return false;
+        }
+
+        continue;
+      }
       else if (CHECK_ARG_PARAM("-log"))
       {
         std::optional<LOGLEVEL> level = Settings::ParseLogLevelName(argv[++i]);
@@ -635,6 +679,225 @@ std::string RegTestHost::GetFrameDumpFilename(u32 frame)
   return Path::Combine(s_dump_game_directory, fmt::format("frame_{:05d}.png", frame));
 }
 
+bool RegTestHost::GatherJobPaths(const std::string& source, std::vector<std::string>* paths)
+{
+  if (FileSystem::DirectoryExists(source.c_str()))
+  {
+    FileSystem::FindResultsArray results;
+    FileSystem::FindFiles(source.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_RECURSIVE, &results);
+    for (FILESYSTEM_FIND_DATA& fd : results)
+    {
+      if (System::IsLoadableFilename(fd.FileName))
+        paths->push_back(std::move(fd.FileName));
+    }
+  }
+  else if (System::IsLoadableFilename(source))
+  {
+    paths->push_back(source);
+  }
+  else
+  {
+    // Not a directory or a disc image, assume it's a text file listing one game path per line.
+    const std::optional<std::string> listing = FileSystem::ReadFileToString(source.c_str());
+    if (!listing.has_value())
+    {
+      Log_ErrorPrintf("Failed to read game list '%s'.", source.c_str());
+      return false;
+    }
+
+    for (const std::string_view& line : StringUtil::SplitString(listing.value(), '\n', true))
+    {
+      const std::string_view trimmed_line = StringUtil::StripWhitespace(line);
+      if (trimmed_line.empty() || trimmed_line[0] == '#')
+        continue;
+
+      paths->emplace_back(trimmed_line);
+    }
+  }
+
+  if (paths->empty())
+  {
+    Log_ErrorPrintf("No loadable files found in '%s'.", source.c_str());
+    return false;
+  }
+
+  // Deterministic job order regardless of directory iteration order.
+  std::sort(paths->begin(), paths->end());
+  return true;
+}
+
+int RegTestHost::DispatchJobs(int argc, char* argv[], const std::string& source)
+{
+  std::vector<std::string> paths;
+  if (!GatherJobPaths(source, &paths))
+    return EXIT_FAILURE;
+
+  // Children get the same command line, minus the job count and with the game path substituted.
+  static constexpr const char* param_options[] = {"-dumpdir", "-dumpinterval", "-frames", "-log",
+                                                  "-renderer", "-upscale",     "-cpu"};
+  std::vector<std::string> base_args;
+  base_args.push_back(FileSystem::GetProgramPath());
+  for (int i = 1; i < argc; i++)
+  {
+    if (!std::strcmp(argv[i], "-jobs"))
+    {
+      i++;
+      continue;
+    }
+    else if (!std::strcmp(argv[i], "--"))
+    {
+      // Everything from here on is the source path, which is replaced per-job.
+      break;
+    }
+    else if (argv[i][0] == '-')
+    {
+      base_args.push_back(argv[i]);
+      for (const char* param_option : param_options)
+      {
+        if (!std::strcmp(argv[i], param_option) && (i + 1) < argc)
+        {
+          base_args.push_back(argv[++i]);
+          break;
+        }
+      }
+    }
+
+    // Bare arguments make up the source path, drop them too.
+  }
+
+  u32 num_jobs = std::min(s_parallel_jobs, std::max(std::thread::hardware_concurrency(), 1u));
+#ifdef _WIN32
+  // WaitForMultipleObjects() can only wait on this many handles at once.
+  num_jobs = std::min<u32>(num_jobs, MAXIMUM_WAIT_OBJECTS);
+#endif
+
+  Log_InfoPrintf("Dispatching %zu games across %u jobs...", paths.size(), num_jobs);
+
+#ifdef _WIN32
+  std::vector<std::pair<HANDLE, size_t>> running;
+#else
+  std::vector<std::pair<pid_t, size_t>> running;
+#endif
+  std::vector<int> exit_codes(paths.size(), -1);
+  size_t next_job = 0;
+
+  while (next_job < paths.size() || !running.empty())
+  {
+    while (next_job < paths.size() && running.size() < num_jobs)
+    {
+      const size_t job_index = next_job++;
+      Log_InfoPrintf("[%zu/%zu] Starting '%s'...", job_index + 1, paths.size(), paths[job_index].c_str());
+
+      std::vector<std::string> args = base_args;
+      args.push_back("--");
+      args.push_back(paths[job_index]);
+
+#ifdef _WIN32
+      // _spawnv() joins arguments with spaces and no quoting, so quote them ourselves.
+      std::vector<std::string> quoted_args;
+      std::vector<const char*> argv_ptrs;
+      quoted_args.reserve(args.size());
+      for (const std::string& arg : args)
+      {
+        quoted_args.push_back((arg.find(' ') != std::string::npos) ? fmt::format("\"{}\"", arg) : arg);
+        argv_ptrs.push_back(quoted_args.back().c_str());
+      }
+      argv_ptrs.push_back(nullptr);
+
+      const intptr_t handle = _spawnv(_P_NOWAIT, base_args.front().c_str(), argv_ptrs.data());
+      if (handle < 0)
+      {
+        Log_ErrorPrintf("_spawnv() for '%s' failed: %d", paths[job_index].c_str(), errno);
+        exit_codes[job_index] = 127;
+        continue;
+      }
+
+      running.emplace_back(reinterpret_cast<HANDLE>(handle), job_index);
+#else
+      std::vector<char*> argv_ptrs;
+      argv_ptrs.reserve(args.size() + 1);
+      for (const std::string& arg : args)
+        argv_ptrs.push_back(const_cast<char*>(arg.c_str()));
+      argv_ptrs.push_back(nullptr);
+
+      const pid_t pid = fork();
+      if (pid < 0)
+      {
+        Log_ErrorPrintf("fork() for '%s' failed: %d", paths[job_index].c_str(), errno);
+        exit_codes[job_index] = 127;
+        continue;
+      }
+      else if (pid == 0)
+      {
+        execv(argv_ptrs[0], argv_ptrs.data());
+        std::fprintf(stderr, "execv() failed: %d\n", errno);
+        _exit(127);
+      }
+
+      running.emplace_back(pid, job_index);
+#endif
+    }
+
+    if (running.empty())
+      continue;
+
+#ifdef _WIN32
+    std::vector<HANDLE> handles;
+    handles.reserve(running.size());
+    for (const auto& [handle, job_index] : running)
+      handles.push_back(handle);
+
+    const DWORD wres = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, INFINITE);
+    if (wres < WAIT_OBJECT_0 || wres >= (WAIT_OBJECT_0 + handles.size()))
+    {
+      Log_ErrorPrintf("WaitForMultipleObjects() returned %08X", static_cast<unsigned>(wres));
+      return EXIT_FAILURE;
+    }
+
+    const size_t running_index = wres - WAIT_OBJECT_0;
+    DWORD exit_code = 255;
+    GetExitCodeProcess(running[running_index].first, &exit_code);
+    CloseHandle(running[running_index].first);
+    exit_codes[running[running_index].second] = static_cast<int>(exit_code);
+    running.erase(running.begin() + running_index);
+#else
+    int status = 0;
+    const pid_t pid = wait(&status);
+    if (pid < 0)
+    {
+      Log_ErrorPrintf("wait() failed: %d", errno);
+      return EXIT_FAILURE;
+    }
+
+    for (auto it = running.begin(); it != running.end(); ++it)
+    {
+      if (it->first != pid)
+        continue;
+
+      exit_codes[it->second] = WIFEXITED(status) ? WEXITSTATUS(status) : -WTERMSIG(status);
+      running.erase(it);
+      break;
+    }
+#endif
+  }
+
+  size_t failed_jobs = 0;
+  for (size_t i = 0; i < paths.size(); i++)
+  {
+    if (exit_codes[i] != 0)
+      failed_jobs++;
+  }
+
+  Log_InfoPrintf("%zu/%zu jobs succeeded.", paths.size() - failed_jobs, paths.size());
+  for (size_t i = 0; i < paths.size(); i++)
+  {
+    if (exit_codes[i] != 0)
+      Log_ErrorPrintf("  Failed (exit code %d): %s", exit_codes[i], paths[i].c_str());
+  }
+
+  return (failed_jobs == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int main(int argc, char* argv[])
 {
   RegTestHost::InitializeEarlyConsole();
@@ -652,6 +915,10 @@ int main(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+  // In dispatcher mode the parent never boots a system, it only spawns children.
+  if (s_parallel_jobs > 0)
+    return RegTestHost::DispatchJobs(argc, argv, autoboot->filename);
+
   if (!System::Internal::ProcessStartup())
     return EXIT_FAILURE;
 
@@ -3,6 +3,7 @@
 
 #include "updater.h"
 
+#include "common/delta_patch.h"
 #include "common/error.h"
 #include "common/file_system.h"
 #include "common/log.h"
@@ -12,11 +13,16 @@
 #include "common/string_util.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifdef _WIN32
@@ -30,6 +36,14 @@
 #include "common/cocoa_tools.h"
 #endif
 
+// Entries in delta update zips which carry this suffix are binary patches against the file of the
+// same name in the current install, rather than complete replacement files.
+static constexpr char DELTA_PATCH_SUFFIX[] = ".dsdp";
+
+// Upper bound on extraction workers. Decompression saturates well before this, and on the
+// flash-storage end the writes are sequential per file anyway.
+static constexpr u32 MAX_EXTRACT_WORKERS = 8;
+
 Updater::Updater(ProgressCallback* progress) : m_progress(progress)
 {
   progress->SetTitle("DuckStation Update Installer");
@@ -187,7 +201,12 @@ bool Updater::ParseZip()
       if (process_file)
       {
         entry.destination_filename = filename_to_add;
-        m_progress->DisplayFormattedInformation("Found file in zip: '%s'", entry.destination_filename.c_str());
+        entry.is_delta_patch = StringUtil::EndsWithNoCase(entry.destination_filename, DELTA_PATCH_SUFFIX);
+        if (entry.is_delta_patch)
+          entry.destination_filename.erase(entry.destination_filename.length() - std::strlen(DELTA_PATCH_SUFFIX));
+        m_progress->DisplayFormattedInformation("Found %s in zip: '%s'",
+                                                entry.is_delta_patch ? "delta patch" : "file",
+                                                entry.destination_filename.c_str());
         m_update_paths.push_back(std::move(entry));
       }
     }
@@ -271,86 +290,266 @@ bool Updater::StageUpdate()
 {
   m_progress->SetProgressRange(static_cast<u32>(m_update_paths.size()));
   m_progress->SetProgressValue(0);
+  m_progress->SetStatusText("Extracting update...");
+
+  // Entries are independent and decompression dominates extraction time, so they are fanned out
+  // across a pool of workers, each with its own handle to the zip (an unzFile has a single
+  // current-file cursor, so handles cannot be shared). The progress callback is only touched from
+  // this thread; workers report errors back as strings.
+  const u32 worker_count =
+    std::min(std::min(std::max(std::thread::hardware_concurrency(), 1u), MAX_EXTRACT_WORKERS),
+             static_cast<u32>(m_update_paths.size()));
+  if (worker_count <= 1)
+  {
+    for (const FileToUpdate& ftu : m_update_paths)
+    {
+      m_progress->SetFormattedStatusText("Extracting '%s' (mode %o)...", ftu.original_zip_filename.c_str(),
+                                         ftu.file_mode);
 
-  for (const FileToUpdate& ftu : m_update_paths)
+      std::string error_message;
+      if (!StageUpdateFile(m_zf, ftu, &error_message))
+      {
+        m_progress->ModalError(error_message.c_str());
+        return false;
+      }
+
+      m_progress->IncrementProgressValue();
+    }
+
+    return true;
+  }
+
+  std::atomic<size_t> next_entry{0};
+  std::atomic<u32> completed_entries{0};
+  std::atomic<bool> failed{false};
+  std::mutex error_mutex;
+  std::string first_error;
+
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count);
+  for (u32 i = 0; i < worker_count; i++)
+  {
+    workers.emplace_back([this, &next_entry, &completed_entries, &failed, &error_mutex, &first_error]() {
+      unzFile zf = MinizipHelpers::OpenUnzFile(m_zip_path.c_str());
+      if (!zf)
+      {
+        std::unique_lock lock(error_mutex);
+        if (first_error.empty())
+          first_error = "Failed to open update zip on worker thread.";
+        failed.store(true);
+        return;
+      }
+
+      while (!failed.load())
+      {
+        const size_t index = next_entry.fetch_add(1);
+        if (index >= m_update_paths.size())
+          break;
+
+        std::string error_message;
+        if (!StageUpdateFile(zf, m_update_paths[index], &error_message))
+        {
+          std::unique_lock lock(error_mutex);
+          if (first_error.empty())
+            first_error = std::move(error_message);
+          failed.store(true);
+          break;
+        }
+
+        completed_entries.fetch_add(1);
+      }
+
+      unzClose(zf);
+    });
+  }
+
+  // Pump progress from this thread while the workers drain the entry list.
+  while (completed_entries.load() < m_update_paths.size() && !failed.load())
+  {
+    m_progress->SetProgressValue(completed_entries.load());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  for (std::thread& worker : workers)
+    worker.join();
+
+  if (failed.load())
+  {
+    m_progress->ModalError(first_error.c_str());
+    return false;
+  }
+
+  m_progress->SetProgressValue(static_cast<u32>(m_update_paths.size()));
+  return true;
+}
+
+bool Updater::StageUpdateFile(unzFile zf, const FileToUpdate& ftu, std::string* error_message)
+{
+  if (unzLocateFile(zf, ftu.original_zip_filename.c_str(), 0) != UNZ_OK)
   {
-    m_progress->SetFormattedStatusText("Extracting '%s' (mode %o)...", ftu.original_zip_filename.c_str(),
-                                       ftu.file_mode);
+    *error_message = StringUtil::StdStringFromFormat("Unable to locate file '%s' in zip",
+                                                     ftu.original_zip_filename.c_str());
+    return false;
+  }
+  else if (unzOpenCurrentFile(zf) != UNZ_OK)
+  {
+    *error_message = StringUtil::StdStringFromFormat("Failed to open file '%s' in zip",
+                                                     ftu.original_zip_filename.c_str());
+    return false;
+  }
 
-    if (unzLocateFile(m_zf, ftu.original_zip_filename.c_str(), 0) != UNZ_OK)
+  const std::string destination_file = StringUtil::StdStringFromFormat(
+    "%s" FS_OSPATH_SEPARATOR_STR "%s", m_staging_directory.c_str(), ftu.destination_filename.c_str());
+  if (ftu.is_delta_patch)
+  {
+    const bool result = ExtractDeltaPatchedFile(zf, ftu, destination_file, error_message);
+    unzCloseCurrentFile(zf);
+    return result;
+  }
+
+  std::FILE* fp = FileSystem::OpenCFile(destination_file.c_str(), "wb");
+  if (!fp)
+  {
+    *error_message = StringUtil::StdStringFromFormat("Failed to open staging output file '%s'",
+                                                     destination_file.c_str());
+    unzCloseCurrentFile(zf);
+    return false;
+  }
+
+  static constexpr u32 CHUNK_SIZE = 4096;
+  u8 buffer[CHUNK_SIZE];
+  for (;;)
+  {
+    int byte_count = unzReadCurrentFile(zf, buffer, CHUNK_SIZE);
+    if (byte_count < 0)
     {
-      m_progress->DisplayFormattedModalError("Unable to locate file '%s' in zip", ftu.original_zip_filename.c_str());
+      *error_message = StringUtil::StdStringFromFormat("Failed to read file '%s' from zip",
+                                                       ftu.original_zip_filename.c_str());
+      std::fclose(fp);
+      FileSystem::DeleteFile(destination_file.c_str());
+      unzCloseCurrentFile(zf);
       return false;
     }
-    else if (unzOpenCurrentFile(m_zf) != UNZ_OK)
+    else if (byte_count == 0)
     {
-      m_progress->DisplayFormattedModalError("Failed to open file '%s' in zip", ftu.original_zip_filename.c_str());
-      return false;
+      // end of file
+      break;
     }
 
-    m_progress->DisplayFormattedInformation("Extracting '%s'...", ftu.destination_filename.c_str());
+    if (std::fwrite(buffer, static_cast<size_t>(byte_count), 1, fp) != 1)
+    {
+      *error_message = StringUtil::StdStringFromFormat("Failed to write to file '%s'", destination_file.c_str());
+      std::fclose(fp);
+      FileSystem::DeleteFile(destination_file.c_str());
+      unzCloseCurrentFile(zf);
+      return false;
+    }
+  }
 
-    const std::string destination_file = StringUtil::StdStringFromFormat(
-      "%s" FS_OSPATH_SEPARATOR_STR "%s", m_staging_directory.c_str(), ftu.destination_filename.c_str());
-    std::FILE* fp = FileSystem::OpenCFile(destination_file.c_str(), "wb");
-    if (!fp)
+#ifndef _WIN32
+  if (ftu.file_mode != 0)
+  {
+    const int fd = fileno(fp);
+    const int res = (fd >= 0) ? fchmod(fd, ftu.file_mode) : -1;
+    if (res < 0)
     {
-      m_progress->DisplayFormattedModalError("Failed to open staging output file '%s'", destination_file.c_str());
-      unzCloseCurrentFile(m_zf);
+      *error_message = StringUtil::StdStringFromFormat("Failed to set mode for file '%s' (fd %d) to %u: errno %d",
+                                                       destination_file.c_str(), fd, res, errno);
+      std::fclose(fp);
+      FileSystem::DeleteFile(destination_file.c_str());
+      unzCloseCurrentFile(zf);
       return false;
     }
+  }
+#endif
 
+  std::fclose(fp);
+  unzCloseCurrentFile(zf);
+  return true;
+}
+
+bool Updater::ExtractDeltaPatchedFile(unzFile zf, const FileToUpdate& ftu, const std::string& destination_file,
+                                      std::string* error_message)
+{
+  // Patches are a few percent of the size of the file they produce, so reading the whole thing
+  // into memory is cheap. The current zip file position is the patch entry.
+  std::vector<u8> patch_data;
+  for (;;)
+  {
     static constexpr u32 CHUNK_SIZE = 4096;
     u8 buffer[CHUNK_SIZE];
-    for (;;)
+    const int byte_count = unzReadCurrentFile(zf, buffer, CHUNK_SIZE);
+    if (byte_count < 0)
     {
-      int byte_count = unzReadCurrentFile(m_zf, buffer, CHUNK_SIZE);
-      if (byte_count < 0)
-      {
-        m_progress->DisplayFormattedModalError("Failed to read file '%s' from zip", ftu.original_zip_filename.c_str());
-        std::fclose(fp);
-        FileSystem::DeleteFile(destination_file.c_str());
-        unzCloseCurrentFile(m_zf);
-        return false;
-      }
-      else if (byte_count == 0)
-      {
-        // end of file
-        break;
-      }
-
-      if (std::fwrite(buffer, static_cast<size_t>(byte_count), 1, fp) != 1)
-      {
-        m_progress->DisplayFormattedModalError("Failed to write to file '%s'", destination_file.c_str());
-        std::fclose(fp);
-        FileSystem::DeleteFile(destination_file.c_str());
-        unzCloseCurrentFile(m_zf);
-        return false;
-      }
+      *error_message = StringUtil::StdStringFromFormat("Failed to read patch '%s' from zip",
+                                                       ftu.original_zip_filename.c_str());
+      return false;
     }
-
-#ifndef _WIN32
-    if (ftu.file_mode != 0)
+    else if (byte_count == 0)
     {
-      const int fd = fileno(fp);
-      const int res = (fd >= 0) ? fchmod(fd, ftu.file_mode) : -1;
-      if (res < 0)
-      {
-        m_progress->DisplayFormattedModalError("Failed to set mode for file '%s' (fd %d) to %u: errno %d",
-                                               destination_file.c_str(), fd, res, errno);
-        std::fclose(fp);
-        FileSystem::DeleteFile(destination_file.c_str());
-        unzCloseCurrentFile(m_zf);
-        return false;
-      }
+      break;
     }
-#endif
 
+    patch_data.insert(patch_data.end(), buffer, buffer + byte_count);
+  }
+
+  const std::string base_file = StringUtil::StdStringFromFormat(
+    "%s" FS_OSPATH_SEPARATOR_STR "%s", m_destination_directory.c_str(), ftu.destination_filename.c_str());
+  const std::optional<std::vector<u8>> base_data = FileSystem::ReadBinaryFile(base_file.c_str());
+  if (!base_data.has_value())
+  {
+    *error_message = StringUtil::StdStringFromFormat(
+      "Failed to read file '%s' to apply patch against. Please install a full update package.", base_file.c_str());
+    return false;
+  }
+
+  // Apply() verifies the current file's digest before patching, and the result's digest
+  // afterwards. A failure here aborts the update before anything has been committed, leaving the
+  // current install untouched; a full package must be downloaded instead.
+  Error error;
+  std::vector<u8> patched_data;
+  if (!DeltaPatch::Apply(patch_data.data(), patch_data.size(), base_data->data(), base_data->size(), &patched_data,
+                         &error))
+  {
+    *error_message = StringUtil::StdStringFromFormat(
+      "Failed to apply patch for '%s': %s\nPlease install a full update package.", ftu.destination_filename.c_str(),
+      error.GetDescription().c_str());
+    return false;
+  }
+
+  std::FILE* fp = FileSystem::OpenCFile(destination_file.c_str(), "wb");
+  if (!fp)
+  {
+    *error_message = StringUtil::StdStringFromFormat("Failed to open staging output file '%s'",
+                                                     destination_file.c_str());
+    return false;
+  }
+
+  if (!patched_data.empty() && std::fwrite(patched_data.data(), patched_data.size(), 1, fp) != 1)
+  {
+    *error_message = StringUtil::StdStringFromFormat("Failed to write to file '%s'", destination_file.c_str());
     std::fclose(fp);
-    unzCloseCurrentFile(m_zf);
-    m_progress->IncrementProgressValue();
+    FileSystem::DeleteFile(destination_file.c_str());
+    return false;
   }
 
+#ifndef _WIN32
+  if (ftu.file_mode != 0)
+  {
+    const int fd = fileno(fp);
+    const int res = (fd >= 0) ? fchmod(fd, ftu.file_mode) : -1;
+    if (res < 0)
+    {
+      *error_message = StringUtil::StdStringFromFormat("Failed to set mode for file '%s' (fd %d) to %u: errno %d",
+                                                       destination_file.c_str(), fd, res, errno);
+      std::fclose(fp);
+      FileSystem::DeleteFile(destination_file.c_str());
+      return false;
+    }
+  }
+#endif
+
+  std::fclose(fp);
   return true;
 }
 
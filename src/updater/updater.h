@@ -31,9 +31,13 @@ private:
     std::string original_zip_filename;
     std::string destination_filename;
     u32 file_mode;
+    bool is_delta_patch;
   };
 
   bool ParseZip();
+  bool StageUpdateFile(unzFile zf, const FileToUpdate& ftu, std::string* error_message);
+  bool ExtractDeltaPatchedFile(unzFile zf, const FileToUpdate& ftu, const std::string& destination_file,
+                               std::string* error_message);
   void CloseUpdateZip();
 
   std::string m_zip_path;
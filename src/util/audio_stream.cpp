@@ -27,6 +27,7 @@ AudioStream::AudioStream(u32 sample_rate, u32 channels, u32 buffer_ms, AudioStre
 
 AudioStream::~AudioStream()
 {
+  StopStretchThread();
   DestroyBuffer();
 }
 
@@ -256,6 +257,13 @@ void AudioStream::EmptyBuffer()
 {
   if (m_stretch_mode != AudioStretchMode::Off)
   {
+    std::unique_lock<std::mutex> lock(m_stretch_mutex);
+
+    // toss any raw chunks the stretch thread hasn't picked up yet; the worker only touches the
+    // queue with the mutex held, so it's quiesced here
+    if (m_stretch_thread_started)
+      m_stretch_chunks.Clear();
+
     m_soundtouch->clear();
     if (m_stretch_mode == AudioStretchMode::TimeStretch)
       m_soundtouch->setTempo(m_nominal_rate);
@@ -268,7 +276,10 @@ void AudioStream::SetNominalRate(float tempo)
 {
   m_nominal_rate = tempo;
   if (m_stretch_mode == AudioStretchMode::Resample)
+  {
+    std::unique_lock<std::mutex> lock(m_stretch_mutex);
     m_soundtouch->setRate(tempo);
+  }
 }
 
 void AudioStream::UpdateTargetTempo(float tempo)
@@ -280,6 +291,7 @@ void AudioStream::UpdateTargetTempo(float tempo)
   if (tempo)
     tempo *= tempo;
 
+  std::unique_lock<std::mutex> lock(m_stretch_mutex);
   m_average_position = AVERAGING_WINDOW;
   m_average_available = AVERAGING_WINDOW;
   std::fill_n(m_average_fullness.data(), AVERAGING_WINDOW, tempo);
@@ -348,9 +360,39 @@ void AudioStream::EndWrite(u32 num_frames)
   m_staging_buffer_pos = 0;
 
   if (m_stretch_mode != AudioStretchMode::Off)
-    StretchWrite();
+  {
+    if (m_stretch_thread_started)
+      QueueStretchChunk();
+    else
+      StretchWrite();
+  }
   else
+  {
     InternalWriteFrames(m_staging_buffer.data(), CHUNK_SIZE);
+  }
+}
+
+void AudioStream::QueueStretchChunk()
+{
+  StretchChunk* chunk;
+  if (m_stretch_chunks.BeginWrite(&chunk, 1) == 0)
+  {
+    // Stretch thread is more than a whole ring behind. Drop the chunk, the same way a buffer overrun would.
+    Log_DebugPrintf("Stretch ring full, chunk dropped");
+    return;
+  }
+
+  std::memcpy(chunk->samples, m_staging_buffer.data(), sizeof(chunk->samples));
+  m_stretch_chunks.EndWrite(1);
+
+  // The push must be ordered before the sleeping check below, otherwise the wake can be missed.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (m_stretch_thread_sleeping.load())
+  {
+    std::unique_lock<std::mutex> lock(m_stretch_mutex);
+    m_stretch_thread_wake.notify_one();
+  }
 }
 
 static constexpr float S16_TO_FLOAT = 1.0f / 32767.0f;
@@ -522,30 +564,86 @@ void AudioStream::StretchAllocate()
   m_average_available = 0;
 
   m_staging_buffer_pos = 0;
+
+  StartStretchThread();
 }
 
 void AudioStream::StretchDestroy()
 {
+  StopStretchThread();
   m_soundtouch.reset();
 }
 
 void AudioStream::StretchWrite()
 {
-  S16ChunkToFloat(m_staging_buffer.data(), m_float_buffer.data());
+  StretchWriteChunk(m_staging_buffer.data());
+}
+
+void AudioStream::StretchWriteChunk(const s32* chunk)
+{
+  S16ChunkToFloat(chunk, m_float_buffer.data());
 
   m_soundtouch->putSamples(m_float_buffer.data(), CHUNK_SIZE);
 
   int tempProgress;
   while (tempProgress = m_soundtouch->receiveSamples((float*)m_float_buffer.data(), CHUNK_SIZE), tempProgress != 0)
   {
-    FloatChunkToS16(m_staging_buffer.data(), m_float_buffer.data(), tempProgress);
-    InternalWriteFrames(m_staging_buffer.data(), tempProgress);
+    FloatChunkToS16(m_stretch_output_buffer.data(), m_float_buffer.data(), tempProgress);
+    InternalWriteFrames(m_stretch_output_buffer.data(), tempProgress);
   }
 
   if (m_stretch_mode == AudioStretchMode::TimeStretch)
     UpdateStretchTempo();
 }
 
+void AudioStream::StartStretchThread()
+{
+  DebugAssert(!m_stretch_thread_started);
+  m_stretch_chunks.Clear();
+  m_stretch_thread_shutdown = false;
+  m_stretch_thread_started = m_stretch_thread.Start([this]() { StretchThreadEntryPoint(); });
+  if (!m_stretch_thread_started)
+    Log_ErrorPrintf("Failed to start stretch thread, falling back to processing on the emulation thread.");
+}
+
+void AudioStream::StopStretchThread()
+{
+  if (!m_stretch_thread_started)
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(m_stretch_mutex);
+    m_stretch_thread_shutdown = true;
+    m_stretch_thread_wake.notify_one();
+  }
+
+  m_stretch_thread.Join();
+  m_stretch_thread_started = false;
+}
+
+void AudioStream::StretchThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("Audio Stretch");
+
+  std::unique_lock<std::mutex> lock(m_stretch_mutex);
+  while (!m_stretch_thread_shutdown)
+  {
+    const StretchChunk* chunk;
+    if (m_stretch_chunks.BeginRead(&chunk, 1) == 0)
+    {
+      m_stretch_thread_sleeping.store(true);
+      m_stretch_thread_wake.wait(lock,
+                                 [this]() { return (m_stretch_thread_shutdown || !m_stretch_chunks.IsEmpty()); });
+      m_stretch_thread_sleeping.store(false);
+      continue;
+    }
+
+    // The mutex stays held while the chunk is processed, so tempo/rate updates never race the stretcher.
+    StretchWriteChunk(chunk->samples);
+    m_stretch_chunks.EndRead(1);
+  }
+}
+
 float AudioStream::AddAndGetAverageTempo(float val)
 {
   if (m_stretch_reset >= STRETCH_RESET_THRESHOLD)
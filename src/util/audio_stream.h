@@ -2,10 +2,14 @@
 // SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
 
 #pragma once
+#include "common/fifo_queue.h"
+#include "common/threading.h"
 #include "common/types.h"
 #include <array>
 #include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -113,6 +117,7 @@ private:
     AVERAGING_WINDOW = 50,
     STRETCH_RESET_THRESHOLD = 5,
     TARGET_IPS = 691,
+    NUM_STRETCH_RING_CHUNKS = 32,
   };
 
   void AllocateBuffer();
@@ -123,9 +128,15 @@ private:
   void StretchAllocate();
   void StretchDestroy();
   void StretchWrite();
+  void StretchWriteChunk(const s32* chunk);
   void StretchUnderrun();
   void StretchOverrun();
 
+  void StartStretchThread();
+  void StopStretchThread();
+  void StretchThreadEntryPoint();
+  void QueueStretchChunk();
+
   float AddAndGetAverageTempo(float val);
   void UpdateStretchTempo();
 
@@ -150,9 +161,29 @@ private:
 
   std::array<float, AVERAGING_BUFFER_SIZE> m_average_fullness = {};
 
+  // Stretch worker thread. The emulation thread pushes raw chunks into a lock-free ring, the worker runs the
+  // SoundTouch processing and writes the result into the output buffer. The mutex only guards the SoundTouch
+  // state (held while a chunk is processed, and by the rare tempo/mode updates), never the data path.
+  Threading::Thread m_stretch_thread;
+  std::mutex m_stretch_mutex;
+  std::condition_variable m_stretch_thread_wake;
+  std::atomic_bool m_stretch_thread_sleeping{false};
+  bool m_stretch_thread_shutdown = false;
+  bool m_stretch_thread_started = false;
+
+  struct StretchChunk
+  {
+    s32 samples[CHUNK_SIZE];
+  };
+
+  SPSCFIFOQueue<StretchChunk, NUM_STRETCH_RING_CHUNKS> m_stretch_chunks;
+
   // temporary staging buffer, used for timestretching
   alignas(16) std::array<s32, CHUNK_SIZE> m_staging_buffer;
 
+  // output staging for the stretch thread, which can't share m_staging_buffer with the producer
+  alignas(16) std::array<s32, CHUNK_SIZE> m_stretch_output_buffer;
+
   // float buffer, soundtouch only accepts float samples as input
   alignas(16) std::array<float, CHUNK_SIZE * MAX_CHANNELS> m_float_buffer;
 };
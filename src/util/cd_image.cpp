@@ -88,6 +88,10 @@ std::unique_ptr<CDImage> CDImage::Open(const char* filename, bool allow_patches,
   {
     image = OpenCHDImage(filename, error);
   }
+  else if (StringUtil::Strcasecmp(extension, ".zcd") == 0)
+  {
+    image = OpenZCDImage(filename, error);
+  }
   else if (StringUtil::Strcasecmp(extension, ".ecm") == 0)
   {
     image = OpenEcmImage(filename, error);
@@ -335,6 +339,18 @@ bool CDImage::ReadRawSector(void* buffer, SubChannelQ* subq)
   return true;
 }
 
+void CDImage::ReadRawSectorAsync(void* buffer, SubChannelQ* subq, AsyncReadCompletion completion, void* userdata)
+{
+  // Synchronous fallback: every current format is backed by a blocking library, so just do the
+  // read now and complete inline.
+  completion(userdata, ReadRawSector(buffer, subq));
+}
+
+bool CDImage::SupportsDeferredAsyncReads() const
+{
+  return false;
+}
+
 bool CDImage::ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index)
 {
   GenerateSubChannelQ(subq, index, lba_in_index);
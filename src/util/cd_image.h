@@ -239,21 +239,32 @@ public:
   /// Returns true if the specified filename is a CD-ROM device name.
   static bool IsDeviceName(const char* filename);
 
+  /// Sets the byte budget for the decompressed hunk cache used by CHD images, in megabytes. Takes effect for
+  /// images opened after the call; already-open images keep their current cache size.
+  static void SetCHDHunkCacheSize(u32 size_in_mb);
+
   // Opening disc image.
   static std::unique_ptr<CDImage> Open(const char* filename, bool allow_patches, Error* error);
   static std::unique_ptr<CDImage> OpenBinImage(const char* filename, Error* error);
   static std::unique_ptr<CDImage> OpenCueSheetImage(const char* filename, Error* error);
   static std::unique_ptr<CDImage> OpenCHDImage(const char* filename, Error* error);
+  static std::unique_ptr<CDImage> OpenZCDImage(const char* filename, Error* error);
   static std::unique_ptr<CDImage> OpenEcmImage(const char* filename, Error* error);
   static std::unique_ptr<CDImage> OpenMdsImage(const char* filename, Error* error);
   static std::unique_ptr<CDImage> OpenPBPImage(const char* filename, Error* error);
   static std::unique_ptr<CDImage> OpenM3uImage(const char* filename, bool apply_patches, Error* error);
   static std::unique_ptr<CDImage> OpenDeviceImage(const char* filename, Error* error);
   static std::unique_ptr<CDImage>
-  CreateMemoryImage(CDImage* image, ProgressCallback* progress = ProgressCallback::NullProgressCallback);
+  CreateMemoryImage(CDImage* image, ProgressCallback* progress = ProgressCallback::NullProgressCallback,
+                    bool compress = false);
   static std::unique_ptr<CDImage> OverlayPPFPatch(const char* filename, std::unique_ptr<CDImage> parent_image,
                                                   ProgressCallback* progress = ProgressCallback::NullProgressCallback);
 
+  /// Writes the contents of any opened image (BIN/CUE, CHD, ...) out as a ZCD image.
+  static bool ConvertToZCD(CDImage* image, const char* filename,
+                           ProgressCallback* progress = ProgressCallback::NullProgressCallback,
+                           Error* error = nullptr);
+
   // Accessors.
   const std::string& GetFileName() const { return m_filename; }
   LBA GetPositionOnDisc() const { return m_position_on_disc; }
@@ -297,6 +308,22 @@ public:
   // Read a single raw sector, and subchannel from the current LBA.
   bool ReadRawSector(void* buffer, SubChannelQ* subq);
 
+  // Completion callback for asynchronous reads. Invoked exactly once per request with the read
+  // result; userdata is passed through untouched.
+  using AsyncReadCompletion = void (*)(void* userdata, bool result);
+
+  // Reads a single raw sector and subchannel from the current LBA, invoking the completion
+  // callback when the data is available. The base implementation is the synchronous fallback: it
+  // performs the read and invokes the completion inline, before returning. A subclass with
+  // genuinely overlappable I/O may complete from another thread after returning, but must
+  // return true from SupportsDeferredAsyncReads() so callers that require inline completion can
+  // tell the difference.
+  virtual void ReadRawSectorAsync(void* buffer, SubChannelQ* subq, AsyncReadCompletion completion, void* userdata);
+
+  // Returns true if ReadRawSectorAsync() may invoke its completion after returning (from another
+  // thread). All current formats are backed by synchronous libraries and return false.
+  virtual bool SupportsDeferredAsyncReads() const;
+
   // Reads sub-channel Q for the specified index+LBA.
   virtual bool ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index);
 
@@ -12,7 +12,9 @@
 #include "common/heap_array.h"
 #include "common/intrin.h"
 #include "common/log.h"
+#include "common/lru_cache.h"
 #include "common/path.h"
+#include "common/threading.h"
 #include "common/string_util.h"
 
 #include "fmt/format.h"
@@ -20,12 +22,15 @@
 #include "libchdr/chd.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <limits>
 #include <mutex>
 #include <optional>
+#include <thread>
 
 Log_SetChannel(CDImageCHD);
 
@@ -56,6 +61,9 @@ static std::optional<CDImage::TrackMode> ParseTrackModeString(const char* str)
 static std::vector<std::pair<std::string, chd_header>> s_chd_hash_cache; // <filename, header>
 static std::recursive_mutex s_chd_hash_cache_mutex;
 
+// Byte budget for the decompressed hunk cache, in megabytes. Read when an image is opened.
+static u32 s_chd_hunk_cache_size_mb = 4;
+
 class CDImageCHD : public CDImage
 {
 public:
@@ -79,7 +87,7 @@ private:
   static constexpr u32 MAX_PARENTS = 32; // Surely someone wouldn't be insane enough to go beyond this...
 
   chd_file* OpenCHD(std::string_view filename, FileSystem::ManagedCFilePtr fp, Error* error, u32 recursion_level);
-  bool UpdateHunkBuffer(const Index& index, LBA lba_in_index, u32& hunk_offset);
+  const u8* GetHunkData(const Index& index, LBA lba_in_index, u32& hunk_offset);
 
   static void CopyAndSwap(void* dst_ptr, const u8* src_ptr);
 
@@ -87,8 +95,14 @@ private:
   u32 m_hunk_size = 0;
   u32 m_sectors_per_hunk = 0;
 
-  DynamicHeapArray<u8, 16> m_hunk_buffer;
-  u32 m_current_hunk_index = static_cast<u32>(-1);
+  // Decompressed hunks, LRU-evicted against the configured byte budget. The hunk size is fixed per image, so
+  // the budget reduces to an entry count. Bypassed entirely once the image has been precached.
+  LRUCache<u32, DynamicHeapArray<u8, 16>> m_hunk_cache;
+  u64 m_hunk_cache_hits = 0;
+  u64 m_hunk_cache_misses = 0;
+
+  // Filled by Precache() with every hunk decompressed; reads are serviced directly from it afterwards.
+  DynamicHeapArray<u8, 16> m_precache_data;
   bool m_precached = false;
 
   CDSubChannelReplacement m_sbi;
@@ -99,6 +113,14 @@ CDImageCHD::CDImageCHD() = default;
 
 CDImageCHD::~CDImageCHD()
 {
+  if ((m_hunk_cache_hits + m_hunk_cache_misses) > 0)
+  {
+    Log_DevFmt("Hunk cache for '{}': {} hits, {} misses ({:.1f}% hit rate)", Path::GetFileName(m_filename),
+               m_hunk_cache_hits, m_hunk_cache_misses,
+               (static_cast<double>(m_hunk_cache_hits) * 100.0) /
+                 static_cast<double>(m_hunk_cache_hits + m_hunk_cache_misses));
+  }
+
   if (m_chd)
     chd_close(m_chd);
 }
@@ -261,7 +283,11 @@ bool CDImageCHD::Open(const char* filename, Error* error)
   }
 
   m_sectors_per_hunk = m_hunk_size / CHD_CD_SECTOR_DATA_SIZE;
-  m_hunk_buffer.resize(m_hunk_size);
+
+  const u32 cache_hunks = std::max<u32>((s_chd_hunk_cache_size_mb * 1048576u) / m_hunk_size, 1u);
+  m_hunk_cache.SetMaxCapacity(cache_hunks);
+  Log_VerboseFmt("Hunk cache: up to {} hunks of {} bytes each", cache_hunks, m_hunk_size);
+
   m_filename = filename;
 
   u32 disc_lba = 0;
@@ -429,11 +455,12 @@ bool CDImageCHD::ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_
     return CDImage::ReadSubChannelQ(subq, index, lba_in_index);
 
   u32 hunk_offset;
-  if (!UpdateHunkBuffer(index, lba_in_index, hunk_offset))
+  const u8* hunk_data = GetHunkData(index, lba_in_index, hunk_offset);
+  if (!hunk_data)
     return false;
 
   u8 deinterleaved_subchannel_data[96];
-  const u8* raw_subchannel_data = &m_hunk_buffer[hunk_offset + RAW_SECTOR_SIZE];
+  const u8* raw_subchannel_data = &hunk_data[hunk_offset + RAW_SECTOR_SIZE];
   const u8* real_subchannel_data = raw_subchannel_data;
   if (index.submode == CDImage::SubchannelMode::RawInterleaved)
   {
@@ -454,24 +481,124 @@ bool CDImageCHD::HasNonStandardSubchannel() const
 
 CDImage::PrecacheResult CDImageCHD::Precache(ProgressCallback* progress)
 {
+  // Decompresses every hunk into memory, rather than just caching the compressed file like chd_precache() does.
+  // This both removes decompression from the read path, and lets us spread the work over multiple threads,
+  // since hunks are independent of one another.
+  static constexpr u32 MAX_PRECACHE_THREADS = 8;
+
+  // Grant hunks to workers in contiguous batches, so each worker issues sequential reads to the source file.
+  static constexpr u32 PRECACHE_BATCH_SIZE = 16;
+
   if (m_precached)
     return CDImage::PrecacheResult::Success;
 
   progress->SetStatusText(fmt::format("Precaching {}...", FileSystem::GetDisplayNameFromPath(m_filename)).c_str());
-  progress->SetProgressRange(100);
 
-  auto callback = [](size_t pos, size_t total, void* param) {
-    const u32 percent = static_cast<u32>((pos * 100) / total);
-    static_cast<ProgressCallback*>(param)->SetProgressValue(std::min<u32>(percent, 100));
+  const chd_header* header = chd_get_header(m_chd);
+  const u32 total_hunks = header->totalhunks;
+  if (total_hunks == 0)
+    return CDImage::PrecacheResult::ReadError;
+
+  m_precache_data.resize(static_cast<size_t>(total_hunks) * m_hunk_size);
+  progress->SetProgressRange(total_hunks);
+  progress->SetProgressValue(0);
+
+  // Each worker needs its own chd_file, the decompression state within is not thread-safe. The first worker
+  // reuses our own handle; if any of the extra opens fail, we just run with however many we got.
+  std::vector<chd_file*> worker_chds;
+  worker_chds.push_back(m_chd);
+
+  // The calling thread keeps the loading screen pumping, so decompression runs entirely on the pool.
+  const u32 requested_threads =
+    std::min(Threading::ThreadPool::GetWorkerCount(), std::min(MAX_PRECACHE_THREADS, total_hunks));
+  for (u32 i = 1; i < requested_threads; i++)
+  {
+    Error open_error;
+    auto fp = FileSystem::OpenManagedSharedCFile(m_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite);
+    chd_file* worker_chd = fp ? OpenCHD(m_filename, std::move(fp), &open_error, 0) : nullptr;
+    if (!worker_chd)
+    {
+      Log_WarningFmt("Failed to open additional CHD handle, precaching with {} thread(s).", i);
+      break;
+    }
+
+    worker_chds.push_back(worker_chd);
+  }
+
+  std::atomic<u32> next_batch{0};
+  std::atomic<u32> completed_hunks{0};
+  std::atomic<bool> failed{false};
+
+  const auto worker_func = [this, total_hunks, &next_batch, &completed_hunks, &failed](chd_file* chd) {
+    for (;;)
+    {
+      const u32 start_hunk = next_batch.fetch_add(1, std::memory_order_acq_rel) * PRECACHE_BATCH_SIZE;
+      if (start_hunk >= total_hunks || failed.load(std::memory_order_relaxed))
+        break;
+
+      const u32 end_hunk = std::min(start_hunk + PRECACHE_BATCH_SIZE, total_hunks);
+      for (u32 hunk_index = start_hunk; hunk_index != end_hunk; hunk_index++)
+      {
+        const chd_error err = chd_read(chd, hunk_index, &m_precache_data[static_cast<size_t>(hunk_index) * m_hunk_size]);
+        if (err != CHDERR_NONE)
+        {
+          Log_ErrorFmt("chd_read({}) failed during precache: {}", hunk_index, chd_error_string(err));
+          failed.store(true, std::memory_order_release);
+          break;
+        }
+      }
+
+      completed_hunks.fetch_add(end_hunk - start_hunk, std::memory_order_acq_rel);
+    }
   };
 
-  if (chd_precache_progress(m_chd, callback, progress) != CHDERR_NONE)
+  if (worker_chds.size() == 1)
+  {
+    worker_func(m_chd);
+    progress->SetProgressValue(completed_hunks.load(std::memory_order_acquire));
+  }
+  else
+  {
+    std::atomic<u32> finished_workers{0};
+    for (chd_file* worker_chd : worker_chds)
+    {
+      Threading::ThreadPool::QueueWork([&worker_func, &finished_workers, worker_chd]() {
+        worker_func(worker_chd);
+        finished_workers.fetch_add(1, std::memory_order_acq_rel);
+      });
+    }
+
+    // The loading screen belongs to this thread, so pump progress here instead of from the workers.
+    while (finished_workers.load(std::memory_order_acquire) < static_cast<u32>(worker_chds.size()))
+    {
+      progress->SetProgressValue(completed_hunks.load(std::memory_order_acquire));
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  for (chd_file* worker_chd : worker_chds)
+  {
+    if (worker_chd != m_chd)
+      chd_close(worker_chd);
+  }
+
+  if (failed.load(std::memory_order_acquire))
+  {
+    m_precache_data.deallocate();
     return CDImage::PrecacheResult::ReadError;
+  }
 
+  progress->SetProgressValue(total_hunks);
+  m_hunk_cache.Clear();
   m_precached = true;
   return CDImage::PrecacheResult::Success;
 }
 
+void CDImage::SetCHDHunkCacheSize(u32 size_in_mb)
+{
+  s_chd_hunk_cache_size_mb = size_in_mb;
+}
+
 bool CDImageCHD::IsPrecached() const
 {
   return m_precached;
@@ -536,40 +663,46 @@ ALWAYS_INLINE_RELEASE void CDImageCHD::CopyAndSwap(void* dst_ptr, const u8* src_
 bool CDImageCHD::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
 {
   u32 hunk_offset;
-  if (!UpdateHunkBuffer(index, lba_in_index, hunk_offset))
+  const u8* hunk_data = GetHunkData(index, lba_in_index, hunk_offset);
+  if (!hunk_data)
     return false;
 
   // Audio data is in big-endian, so we have to swap it for little endian hosts...
   if (index.mode == TrackMode::Audio)
-    CopyAndSwap(buffer, &m_hunk_buffer[hunk_offset]);
+    CopyAndSwap(buffer, &hunk_data[hunk_offset]);
   else
-    std::memcpy(buffer, &m_hunk_buffer[hunk_offset], RAW_SECTOR_SIZE);
+    std::memcpy(buffer, &hunk_data[hunk_offset], RAW_SECTOR_SIZE);
 
   return true;
 }
 
-ALWAYS_INLINE_RELEASE bool CDImageCHD::UpdateHunkBuffer(const Index& index, LBA lba_in_index, u32& hunk_offset)
+ALWAYS_INLINE_RELEASE const u8* CDImageCHD::GetHunkData(const Index& index, LBA lba_in_index, u32& hunk_offset)
 {
   const u32 disc_frame = static_cast<LBA>(index.file_offset) + lba_in_index;
   const u32 hunk_index = static_cast<u32>(disc_frame / m_sectors_per_hunk);
   hunk_offset = static_cast<u32>((disc_frame % m_sectors_per_hunk) * CHD_CD_SECTOR_DATA_SIZE);
   DebugAssert((m_hunk_size - hunk_offset) >= CHD_CD_SECTOR_DATA_SIZE);
 
-  if (m_current_hunk_index == hunk_index)
-    return true;
+  if (m_precached)
+    return &m_precache_data[static_cast<size_t>(hunk_index) * m_hunk_size];
 
-  const chd_error err = chd_read(m_chd, hunk_index, m_hunk_buffer.data());
-  if (err != CHDERR_NONE)
+  if (const DynamicHeapArray<u8, 16>* entry = m_hunk_cache.Lookup(hunk_index))
   {
-    Log_ErrorFmt("chd_read({}) failed: %s", hunk_index, chd_error_string(err));
+    m_hunk_cache_hits++;
+    return entry->data();
+  }
 
-    // data might have been partially written
-    m_current_hunk_index = static_cast<u32>(-1);
-    return false;
+  m_hunk_cache_misses++;
+
+  DynamicHeapArray<u8, 16> hunk_data(m_hunk_size);
+  const chd_error err = chd_read(m_chd, hunk_index, hunk_data.data());
+  if (err != CHDERR_NONE)
+  {
+    Log_ErrorFmt("chd_read({}) failed: {}", hunk_index, chd_error_string(err));
+    return nullptr;
   }
 
-  m_current_hunk_index = hunk_index;
-  return true;
+  return m_hunk_cache.Insert(hunk_index, std::move(hunk_data))->data();
 }
 
 s64 CDImageCHD::GetSizeOnDisk() const
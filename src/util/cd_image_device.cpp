@@ -9,11 +9,14 @@
 #include "common/log.h"
 #include "common/small_string.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 
 #include <algorithm>
 #include <cerrno>
 #include <cinttypes>
 #include <cmath>
+#include <condition_variable>
+#include <mutex>
 #include <optional>
 #include <span>
 
@@ -136,6 +139,219 @@ enum class SCSIReadMode : u8
   }
 }
 
+#if defined(_WIN32) || (defined(__linux__) && !defined(__ANDROID__))
+
+namespace {
+
+// Keeps the drive streaming ahead of the emulated read position. Neither SPTD nor SG_IO has a
+// usable async submission path, and the drive only processes one command at a time anyway, so
+// instead all device commands are funneled through a single readahead thread which keeps fetching
+// the sectors following the last request. The consumer only blocks when it asks for a sector that
+// has not come back from the drive yet, i.e. the seek cost is paid once instead of per-sector.
+class CDImageDeviceBase : public CDImage
+{
+public:
+  ~CDImageDeviceBase() override;
+
+  bool ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index) override;
+  bool HasNonStandardSubchannel() const override;
+
+protected:
+  enum : u32
+  {
+    READAHEAD_SECTOR_COUNT = 8,
+  };
+
+  bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
+
+  /// Issues a single blocking read at the device level, filling m_buffer and m_subq. Only called
+  /// from the readahead thread once it is running.
+  virtual bool ReadSectorToBuffer(LBA lba) = 0;
+
+  void StartReadaheadThread();
+  void StopReadaheadThread();
+
+  LBA m_current_lba = ~static_cast<LBA>(0);
+  bool m_has_valid_subcode = false;
+
+  std::array<u8, RAW_SECTOR_SIZE + ALL_SUBCODE_SIZE> m_buffer;
+  std::array<u8, SUBCHANNEL_BYTES_PER_FRAME> m_subq;
+
+private:
+  struct CachedSector
+  {
+    LBA lba = ~static_cast<LBA>(0);
+    bool error = false;
+    u8 data[RAW_SECTOR_SIZE];
+    u8 subq[SUBCHANNEL_BYTES_PER_FRAME];
+  };
+
+  bool GetSector(LBA lba, void* data, SubChannelQ* subq);
+  void ReadaheadThreadEntryPoint();
+
+  Threading::Thread m_readahead_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_readahead_thread_wake;
+  std::condition_variable m_sector_available;
+  std::array<CachedSector, READAHEAD_SECTOR_COUNT> m_cache;
+  LBA m_request_lba = ~static_cast<LBA>(0);
+  bool m_readahead_thread_started = false;
+  bool m_readahead_thread_shutdown = false;
+};
+
+} // namespace
+
+CDImageDeviceBase::~CDImageDeviceBase()
+{
+  // Subclasses must stop the thread before tearing down the device handle.
+  Assert(!m_readahead_thread_started);
+}
+
+void CDImageDeviceBase::StartReadaheadThread()
+{
+  m_readahead_thread_shutdown = false;
+  m_readahead_thread_started = m_readahead_thread.Start([this]() { ReadaheadThreadEntryPoint(); });
+  if (!m_readahead_thread_started)
+    Log_ErrorPrint("Failed to start readahead thread, falling back to synchronous reads.");
+}
+
+void CDImageDeviceBase::StopReadaheadThread()
+{
+  if (!m_readahead_thread_started)
+    return;
+
+  {
+    std::unique_lock lock(m_mutex);
+    m_readahead_thread_shutdown = true;
+    m_readahead_thread_wake.notify_one();
+    m_sector_available.notify_all();
+  }
+
+  m_readahead_thread.Join();
+  m_readahead_thread_started = false;
+}
+
+bool CDImageDeviceBase::GetSector(LBA lba, void* data, SubChannelQ* subq)
+{
+  if (!m_readahead_thread_started)
+  {
+    if (m_current_lba != lba && !ReadSectorToBuffer(lba))
+      return false;
+
+    if (data)
+      std::memcpy(data, m_buffer.data(), RAW_SECTOR_SIZE);
+    if (subq)
+      std::memcpy(subq->data.data(), m_subq.data(), SUBCHANNEL_BYTES_PER_FRAME);
+
+    return true;
+  }
+
+  std::unique_lock lock(m_mutex);
+
+  CachedSector& cs = m_cache[lba % READAHEAD_SECTOR_COUNT];
+  if (cs.lba == lba && cs.error)
+  {
+    // Retry failed sectors on a fresh request, matching the old synchronous behaviour.
+    cs.lba = ~static_cast<LBA>(0);
+  }
+
+  if (m_request_lba != lba)
+    m_request_lba = lba;
+  m_readahead_thread_wake.notify_one();
+
+  while (cs.lba != lba && !m_readahead_thread_shutdown)
+    m_sector_available.wait(lock);
+
+  if (cs.lba != lba || cs.error)
+    return false;
+
+  if (data)
+    std::memcpy(data, cs.data, RAW_SECTOR_SIZE);
+  if (subq)
+    std::memcpy(subq->data.data(), cs.subq, SUBCHANNEL_BYTES_PER_FRAME);
+
+  return true;
+}
+
+void CDImageDeviceBase::ReadaheadThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("CDImageDevice Readahead");
+
+  std::unique_lock lock(m_mutex);
+  while (!m_readahead_thread_shutdown)
+  {
+    // Find the first sector in the window which has not been fetched yet.
+    LBA fetch_lba = ~static_cast<LBA>(0);
+    if (m_request_lba != ~static_cast<LBA>(0))
+    {
+      for (u32 i = 0; i < READAHEAD_SECTOR_COUNT; i++)
+      {
+        const LBA lba = m_request_lba + i;
+        const CachedSector& cs = m_cache[lba % READAHEAD_SECTOR_COUNT];
+        if (cs.lba == lba)
+        {
+          // Don't prefetch past a failed sector, otherwise we'd hammer the drive at lead-out.
+          if (cs.error)
+            break;
+
+          continue;
+        }
+
+        fetch_lba = lba;
+        break;
+      }
+    }
+
+    if (fetch_lba == ~static_cast<LBA>(0))
+    {
+      m_readahead_thread_wake.wait(lock);
+      continue;
+    }
+
+    lock.unlock();
+    const bool result = ReadSectorToBuffer(fetch_lba);
+    lock.lock();
+
+    // The window may have moved while the command was in flight.
+    if (fetch_lba >= m_request_lba && fetch_lba < (m_request_lba + READAHEAD_SECTOR_COUNT))
+    {
+      CachedSector& cs = m_cache[fetch_lba % READAHEAD_SECTOR_COUNT];
+      cs.lba = fetch_lba;
+      cs.error = !result;
+      if (result)
+      {
+        std::memcpy(cs.data, m_buffer.data(), RAW_SECTOR_SIZE);
+        std::memcpy(cs.subq, m_subq.data(), SUBCHANNEL_BYTES_PER_FRAME);
+      }
+
+      m_sector_available.notify_one();
+    }
+  }
+}
+
+bool CDImageDeviceBase::ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index)
+{
+  if (index.file_sector_size == 0 || !m_has_valid_subcode)
+    return CDImage::ReadSubChannelQ(subq, index, lba_in_index);
+
+  return GetSector(static_cast<LBA>(index.file_offset) + lba_in_index, nullptr, subq);
+}
+
+bool CDImageDeviceBase::HasNonStandardSubchannel() const
+{
+  return m_has_valid_subcode;
+}
+
+bool CDImageDeviceBase::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
+{
+  if (index.file_sector_size == 0)
+    return false;
+
+  return GetSector(static_cast<LBA>(index.file_offset) + lba_in_index, buffer, nullptr);
+}
+
+#endif
+
 #if defined(_WIN32)
 
 // The include order here is critical.
@@ -160,7 +376,7 @@ static void U16ToBE(u8* beval, u16 leval)
 
 namespace {
 
-class CDImageDeviceWin32 : public CDImage
+class CDImageDeviceWin32 : public CDImageDeviceBase
 {
 public:
   CDImageDeviceWin32();
@@ -168,11 +384,8 @@ public:
 
   bool Open(const char* filename, Error* error);
 
-  bool ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index) override;
-  bool HasNonStandardSubchannel() const override;
-
 protected:
-  bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
+  bool ReadSectorToBuffer(LBA lba) override;
 
 private:
   std::optional<u32> DoSCSICommand(u8 cmd[SCSI_CMD_LENGTH], std::span<u8> out_buffer);
@@ -180,18 +393,11 @@ private:
   bool DoRawRead(LBA lba);
   bool DoSetSpeed(u32 speed_multiplier);
 
-  bool ReadSectorToBuffer(LBA lba);
   bool DetermineReadMode(bool try_sptd);
 
   HANDLE m_hDevice = INVALID_HANDLE_VALUE;
 
-  u32 m_current_lba = ~static_cast<LBA>(0);
-
   SCSIReadMode m_scsi_read_mode = SCSIReadMode::None;
-  bool m_has_valid_subcode = false;
-
-  std::array<u8, CD_RAW_SECTOR_WITH_SUBCODE_SIZE> m_buffer;
-  std::array<u8, SUBCHANNEL_BYTES_PER_FRAME> m_subq;
 };
 
 } // namespace
@@ -200,6 +406,8 @@ CDImageDeviceWin32::CDImageDeviceWin32() = default;
 
 CDImageDeviceWin32::~CDImageDeviceWin32()
 {
+  StopReadaheadThread();
+
   if (m_hDevice != INVALID_HANDLE_VALUE)
     CloseHandle(m_hDevice);
 }
@@ -371,39 +579,9 @@ bool CDImageDeviceWin32::Open(const char* filename, Error* error)
     return false;
   }
 
-  return Seek(1, Position{0, 0, 0});
-}
+  StartReadaheadThread();
 
-bool CDImageDeviceWin32::ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index)
-{
-  if (index.file_sector_size == 0 || !m_has_valid_subcode)
-    return CDImage::ReadSubChannelQ(subq, index, lba_in_index);
-
-  const LBA offset = static_cast<LBA>(index.file_offset) + lba_in_index;
-  if (m_current_lba != offset && !ReadSectorToBuffer(offset))
-    return false;
-
-  // P, Q, ...
-  std::memcpy(subq->data.data(), m_subq.data(), SUBCHANNEL_BYTES_PER_FRAME);
-  return true;
-}
-
-bool CDImageDeviceWin32::HasNonStandardSubchannel() const
-{
-  return m_has_valid_subcode;
-}
-
-bool CDImageDeviceWin32::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
-{
-  if (index.file_sector_size == 0)
-    return false;
-
-  const LBA offset = static_cast<LBA>(index.file_offset) + lba_in_index;
-  if (m_current_lba != offset && !ReadSectorToBuffer(offset))
-    return false;
-
-  std::memcpy(buffer, m_buffer.data(), RAW_SECTOR_SIZE);
-  return true;
+  return Seek(1, Position{0, 0, 0});
 }
 
 std::optional<u32> CDImageDeviceWin32::DoSCSICommand(u8 cmd[SCSI_CMD_LENGTH], std::span<u8> out_buffer)
@@ -650,7 +828,7 @@ bool CDImage::IsDeviceName(const char* filename)
 
 namespace {
 
-class CDImageDeviceLinux : public CDImage
+class CDImageDeviceLinux : public CDImageDeviceBase
 {
 public:
   CDImageDeviceLinux();
@@ -658,17 +836,13 @@ public:
 
   bool Open(const char* filename, Error* error);
 
-  bool ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index) override;
-  bool HasNonStandardSubchannel() const override;
-
 protected:
-  bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
+  bool ReadSectorToBuffer(LBA lba) override;
 
 private:
   // Raw reads use an offset of 00:02:00
   static constexpr LBA RAW_READ_OFFSET = 2 * FRAMES_PER_SECOND;
 
-  bool ReadSectorToBuffer(LBA lba);
   bool DetermineReadMode(Error* error);
 
   std::optional<u32> DoSCSICommand(u8 cmd[SCSI_CMD_LENGTH], std::span<u8> out_buffer);
@@ -677,12 +851,8 @@ private:
   bool DoSetSpeed(u32 speed_multiplier);
 
   int m_fd = -1;
-  LBA m_current_lba = ~static_cast<LBA>(0);
 
   SCSIReadMode m_scsi_read_mode = SCSIReadMode::None;
-
-  std::array<u8, RAW_SECTOR_SIZE + ALL_SUBCODE_SIZE> m_buffer;
-  std::array<u8, SUBCHANNEL_BYTES_PER_FRAME> m_subq;
 };
 
 } // namespace
@@ -691,6 +861,8 @@ CDImageDeviceLinux::CDImageDeviceLinux() = default;
 
 CDImageDeviceLinux::~CDImageDeviceLinux()
 {
+  StopReadaheadThread();
+
   if (m_fd >= 0)
     close(m_fd);
 }
@@ -861,39 +1033,9 @@ bool CDImageDeviceLinux::Open(const char* filename, Error* error)
   if (!DetermineReadMode(error))
     return false;
 
-  return Seek(1, Position{0, 0, 0});
-}
+  StartReadaheadThread();
 
-bool CDImageDeviceLinux::ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index)
-{
-  if (index.file_sector_size == 0 || m_scsi_read_mode < SCSIReadMode::Full)
-    return CDImage::ReadSubChannelQ(subq, index, lba_in_index);
-
-  const LBA disc_lba = static_cast<LBA>(index.file_offset) + lba_in_index;
-  if (m_current_lba != disc_lba && !ReadSectorToBuffer(disc_lba))
-    return false;
-
-  std::memcpy(subq->data.data(), m_subq.data(), SUBCHANNEL_BYTES_PER_FRAME);
-  return true;
-}
-
-bool CDImageDeviceLinux::HasNonStandardSubchannel() const
-{
-  // Can only read subchannel through SPTD.
-  return m_scsi_read_mode >= SCSIReadMode::Full;
-}
-
-bool CDImageDeviceLinux::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
-{
-  if (index.file_sector_size == 0)
-    return false;
-
-  const LBA disc_lba = static_cast<LBA>(index.file_offset) + lba_in_index;
-  if (m_current_lba != disc_lba && !ReadSectorToBuffer(disc_lba))
-    return false;
-
-  std::memcpy(buffer, m_buffer.data(), RAW_SECTOR_SIZE);
-  return true;
+  return Seek(1, Position{0, 0, 0});
 }
 
 std::optional<u32> CDImageDeviceLinux::DoSCSICommand(u8 cmd[SCSI_CMD_LENGTH], std::span<u8> out_buffer)
@@ -999,6 +1141,7 @@ bool CDImageDeviceLinux::DetermineReadMode(Error* error)
     {
       Log_VerbosePrint("Using SCSI reads with subcode");
       m_scsi_read_mode = SCSIReadMode::Full;
+      m_has_valid_subcode = true;
       return true;
     }
   }
@@ -1010,6 +1153,7 @@ bool CDImageDeviceLinux::DetermineReadMode(Error* error)
     {
       Log_VerbosePrint("Using SCSI reads with subq only");
       m_scsi_read_mode = SCSIReadMode::SubQOnly;
+      m_has_valid_subcode = true;
       return true;
     }
   }
@@ -7,6 +7,7 @@
 #include "common/error.h"
 #include "common/file_system.h"
 #include "common/log.h"
+#include "common/lru_cache.h"
 #include <array>
 #include <cerrno>
 #include <map>
@@ -212,10 +213,16 @@ private:
 
   using DataMap = std::map<u32, SectorEntry>;
 
+  // EDC/ECC reconstruction is expensive enough to cause underruns on slow hosts when games re-read the same
+  // sectors (audio loops, directory sectors), so completed sectors are kept around. 128 sectors = ~300KB.
+  static constexpr u32 SECTOR_CACHE_SIZE = 128;
+
   DataMap m_data_map;
   std::vector<u8> m_chunk_buffer;
   u32 m_chunk_start = 0;
 
+  LRUCache<u32, std::array<u8, RAW_SECTOR_SIZE>> m_sector_cache{SECTOR_CACHE_SIZE};
+
   CDSubChannelReplacement m_sbi;
 };
 
@@ -530,6 +537,12 @@ bool CDImageEcm::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_i
   const u32 file_start = static_cast<u32>(index.file_offset) + (lba_in_index * index.file_sector_size);
   const u32 file_end = file_start + RAW_SECTOR_SIZE;
 
+  if (const std::array<u8, RAW_SECTOR_SIZE>* cached_sector = m_sector_cache.Lookup(file_start))
+  {
+    std::memcpy(buffer, cached_sector->data(), RAW_SECTOR_SIZE);
+    return true;
+  }
+
   if (file_start < m_chunk_start || file_end > (m_chunk_start + m_chunk_buffer.size()))
   {
     if (!ReadChunks(file_start, RAW_SECTOR_SIZE))
@@ -540,6 +553,10 @@ bool CDImageEcm::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_i
 
   const size_t chunk_offset = static_cast<size_t>(file_start - m_chunk_start);
   std::memcpy(buffer, &m_chunk_buffer[chunk_offset], RAW_SECTOR_SIZE);
+
+  std::array<u8, RAW_SECTOR_SIZE> cache_entry;
+  std::memcpy(cache_entry.data(), &m_chunk_buffer[chunk_offset], RAW_SECTOR_SIZE);
+  m_sector_cache.Insert(file_start, cache_entry);
   return true;
 }
 
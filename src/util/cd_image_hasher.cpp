@@ -8,9 +8,16 @@
 
 #include "common/md5_digest.h"
 #include "common/string_util.h"
+#include "common/threading.h"
+
+#include <vector>
 
 namespace CDImageHasher {
 
+// Number of sectors read before handing a batch off to the hash job. Two batches are in flight at
+// once: the calling thread reads into one while a worker hashes the other.
+static constexpr u32 HASH_BATCH_SECTORS = 64;
+
 static bool ReadIndex(CDImage* image, u8 track, u8 index, MD5Digest* digest, ProgressCallback* progress_callback);
 static bool ReadTrack(CDImage* image, u8 track, MD5Digest* digest, ProgressCallback* progress_callback);
 
@@ -34,21 +41,54 @@ bool CDImageHasher::ReadIndex(CDImage* image, u8 track, u8 index, MD5Digest* dig
     return false;
   }
 
-  std::array<u8, CDImage::RAW_SECTOR_SIZE> sector;
-  for (u32 lba = 0; lba < index_length; lba++)
+  // MD5 is order-dependent, so the digest itself cannot be split across threads without changing
+  // the hash. Instead, sector reads (and any decompression behind them) are overlapped with
+  // hashing: the calling thread fills one batch while a pool worker feeds the previous one to the
+  // digest, with at most one hash job in flight so batches arrive in order.
+  std::vector<u8> buffers[2];
+  buffers[0].resize(HASH_BATCH_SECTORS * CDImage::RAW_SECTOR_SIZE);
+  buffers[1].resize(HASH_BATCH_SECTORS * CDImage::RAW_SECTOR_SIZE);
+
+  Threading::KernelSemaphore hash_done;
+  bool hash_in_flight = false;
+  u32 buffer_idx = 0;
+
+  for (u32 lba = 0; lba < index_length;)
   {
-    if ((lba % update_interval) == 0)
-      progress_callback->SetProgressValue(lba);
+    const u32 batch_size = std::min(HASH_BATCH_SECTORS, index_length - lba);
+    u8* const buffer = buffers[buffer_idx].data();
 
-    if (!image->ReadRawSector(sector.data(), nullptr))
+    for (u32 i = 0; i < batch_size; i++)
     {
-      progress_callback->DisplayFormattedModalError("Failed to read sector %u from image", image->GetPositionOnDisc());
-      return false;
+      if (((lba + i) % update_interval) == 0)
+        progress_callback->SetProgressValue(lba + i);
+
+      if (!image->ReadRawSector(&buffer[i * CDImage::RAW_SECTOR_SIZE], nullptr))
+      {
+        progress_callback->DisplayFormattedModalError("Failed to read sector %u from image",
+                                                      image->GetPositionOnDisc());
+        if (hash_in_flight)
+          hash_done.Wait();
+        return false;
+      }
     }
 
-    digest->Update(sector.data(), static_cast<u32>(sector.size()));
+    if (hash_in_flight)
+      hash_done.Wait();
+
+    hash_in_flight = true;
+    Threading::ThreadPool::QueueWork([digest, buffer, batch_size, &hash_done]() {
+      digest->Update(buffer, batch_size * CDImage::RAW_SECTOR_SIZE);
+      hash_done.Post();
+    });
+
+    buffer_idx ^= 1;
+    lba += batch_size;
   }
 
+  if (hash_in_flight)
+    hash_done.Wait();
+
   progress_callback->SetProgressValue(index_length);
   return true;
 }
@@ -7,10 +7,16 @@
 #include "common/assert.h"
 #include "common/file_system.h"
 #include "common/log.h"
+#include "common/memory_budget.h"
 #include "common/path.h"
 
+#include <zstd.h>
+
 #include <algorithm>
 #include <cerrno>
+#include <cinttypes>
+#include <limits>
+#include <vector>
 
 Log_SetChannel(CDImageMemory);
 
@@ -22,7 +28,7 @@ public:
   CDImageMemory();
   ~CDImageMemory() override;
 
-  bool CopyImage(CDImage* image, ProgressCallback* progress);
+  bool CopyImage(CDImage* image, ProgressCallback* progress, bool compress);
 
   bool ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index) override;
   bool HasNonStandardSubchannel() const override;
@@ -33,8 +39,22 @@ protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
 
 private:
+  // Favour decode speed, the whole point is that per-sector decompression is cheap at PS1 read rates.
+  static constexpr int COMPRESSION_LEVEL = 1;
+
   u8* m_memory = nullptr;
   u32 m_memory_sectors = 0;
+
+  // Compressed copy. Sector n occupies [m_sector_offsets[n], m_sector_offsets[n + 1]) in the data buffer; an
+  // extent of exactly RAW_SECTOR_SIZE bytes is stored raw (compressed output is only kept when it is smaller),
+  // anything shorter is a zstd frame.
+  std::vector<u8> m_compressed_data;
+  std::vector<u32> m_sector_offsets;
+  ZSTD_DCtx* m_dctx = nullptr;
+
+  // Bytes reported to MemoryBudget, returned in the destructor.
+  u64 m_accounted_size = 0;
+
   CDSubChannelReplacement m_sbi;
 };
 
@@ -44,11 +64,15 @@ CDImageMemory::CDImageMemory() = default;
 
 CDImageMemory::~CDImageMemory()
 {
+  if (m_dctx)
+    ZSTD_freeDCtx(m_dctx);
   if (m_memory)
     std::free(m_memory);
+
+  MemoryBudget::AddUsage(MemoryBudget::Component::DiscPrecache, -static_cast<s64>(m_accounted_size));
 }
 
-bool CDImageMemory::CopyImage(CDImage* image, ProgressCallback* progress)
+bool CDImageMemory::CopyImage(CDImage* image, ProgressCallback* progress, bool compress)
 {
   // figure out the total number of sectors (not including blank pregaps)
   m_memory_sectors = 0;
@@ -59,46 +83,134 @@ bool CDImageMemory::CopyImage(CDImage* image, ProgressCallback* progress)
       m_memory_sectors += image->GetIndex(i).length;
   }
 
-  if ((static_cast<u64>(RAW_SECTOR_SIZE) * static_cast<u64>(m_memory_sectors)) >=
-      static_cast<u64>(std::numeric_limits<size_t>::max()))
+  const u64 raw_size = static_cast<u64>(RAW_SECTOR_SIZE) * static_cast<u64>(m_memory_sectors);
+  if (raw_size >= static_cast<u64>(std::numeric_limits<size_t>::max()))
   {
     progress->DisplayFormattedModalError("Insufficient address space");
     return false;
   }
 
-  progress->SetFormattedStatusText("Allocating memory for %u sectors...", m_memory_sectors);
-
-  m_memory =
-    static_cast<u8*>(std::malloc(static_cast<size_t>(RAW_SECTOR_SIZE) * static_cast<size_t>(m_memory_sectors)));
-  if (!m_memory)
+  // the compressed layout uses 32-bit offsets, and the raw-stored fallback bounds the data to the raw size
+  if (compress && raw_size >= static_cast<u64>(std::numeric_limits<u32>::max()))
   {
-    progress->DisplayFormattedModalError("Failed to allocate memory for %u sectors", m_memory_sectors);
-    return false;
+    Log_WarningPrintf("Image is too large for compressed precache, storing raw.");
+    compress = false;
   }
 
-  progress->SetStatusText("Preloading CD image to RAM...");
-  progress->SetProgressRange(m_memory_sectors);
-  progress->SetProgressValue(0);
+  // Ask the other accounted subsystems to shrink before committing this much memory. Conservatively
+  // request the raw size; the compressed copy releases the difference once its final size is known.
+  if (!MemoryBudget::ReclaimForAllocation(raw_size))
+    Log_WarningPrintf("Precaching image exceeds the configured memory budget.");
+  m_accounted_size = raw_size;
+  MemoryBudget::AddUsage(MemoryBudget::Component::DiscPrecache, static_cast<s64>(m_accounted_size));
 
-  u8* memory_ptr = m_memory;
-  u32 sectors_read = 0;
-  for (u32 i = 0; i < image->GetIndexCount(); i++)
+  if (compress)
   {
-    const Index& index = image->GetIndex(i);
-    if (index.file_sector_size == 0)
-      continue;
+    ZSTD_CCtx* cctx = ZSTD_createCCtx();
+    if (!cctx)
+    {
+      progress->DisplayFormattedModalError("Failed to create compression context");
+      return false;
+    }
+
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, COMPRESSION_LEVEL);
+
+    progress->SetStatusText("Preloading CD image to RAM (compressed)...");
+    progress->SetProgressRange(m_memory_sectors);
+    progress->SetProgressValue(0);
 
-    for (u32 lba = 0; lba < index.length; lba++)
+    m_sector_offsets.reserve(m_memory_sectors + 1);
+    m_compressed_data.reserve(static_cast<size_t>(raw_size / 2));
+
+    u8 sector_buffer[RAW_SECTOR_SIZE];
+    std::vector<u8> compress_buffer(ZSTD_compressBound(RAW_SECTOR_SIZE));
+
+    u32 sectors_read = 0;
+    for (u32 i = 0; i < image->GetIndexCount(); i++)
     {
-      if (!image->ReadSectorFromIndex(memory_ptr, index, lba))
+      const Index& index = image->GetIndex(i);
+      if (index.file_sector_size == 0)
+        continue;
+
+      for (u32 lba = 0; lba < index.length; lba++)
       {
-        Log_ErrorPrintf("Failed to read LBA %u in index %u", lba, i);
-        return false;
+        if (!image->ReadSectorFromIndex(sector_buffer, index, lba))
+        {
+          Log_ErrorPrintf("Failed to read LBA %u in index %u", lba, i);
+          ZSTD_freeCCtx(cctx);
+          return false;
+        }
+
+        const size_t result =
+          ZSTD_compress2(cctx, compress_buffer.data(), compress_buffer.size(), sector_buffer, RAW_SECTOR_SIZE);
+
+        m_sector_offsets.push_back(static_cast<u32>(m_compressed_data.size()));
+        if (ZSTD_isError(result) || result >= RAW_SECTOR_SIZE)
+          m_compressed_data.insert(m_compressed_data.end(), sector_buffer, sector_buffer + RAW_SECTOR_SIZE);
+        else
+          m_compressed_data.insert(m_compressed_data.end(), compress_buffer.data(), compress_buffer.data() + result);
+
+        progress->SetProgressValue(sectors_read);
+        sectors_read++;
       }
+    }
+
+    ZSTD_freeCCtx(cctx);
+    m_sector_offsets.push_back(static_cast<u32>(m_compressed_data.size()));
+    m_compressed_data.shrink_to_fit();
+
+    m_dctx = ZSTD_createDCtx();
+    if (!m_dctx)
+    {
+      progress->DisplayFormattedModalError("Failed to create decompression context");
+      return false;
+    }
 
-      progress->SetProgressValue(sectors_read);
-      memory_ptr += RAW_SECTOR_SIZE;
-      sectors_read++;
+    Log_InfoPrintf("Compressed %u sectors from %" PRIu64 " to %zu bytes (%.1f%%)", m_memory_sectors, raw_size,
+                   m_compressed_data.size(),
+                   (static_cast<double>(m_compressed_data.size()) * 100.0) / static_cast<double>(raw_size));
+
+    const u64 compressed_size =
+      static_cast<u64>(m_compressed_data.size()) + (static_cast<u64>(m_sector_offsets.size()) * sizeof(u32));
+    MemoryBudget::AddUsage(MemoryBudget::Component::DiscPrecache,
+                           static_cast<s64>(compressed_size) - static_cast<s64>(m_accounted_size));
+    m_accounted_size = compressed_size;
+  }
+  else
+  {
+    progress->SetFormattedStatusText("Allocating memory for %u sectors...", m_memory_sectors);
+
+    m_memory = static_cast<u8*>(std::malloc(static_cast<size_t>(raw_size)));
+    if (!m_memory)
+    {
+      progress->DisplayFormattedModalError("Failed to allocate memory for %u sectors", m_memory_sectors);
+      return false;
+    }
+
+    progress->SetStatusText("Preloading CD image to RAM...");
+    progress->SetProgressRange(m_memory_sectors);
+    progress->SetProgressValue(0);
+
+    u8* memory_ptr = m_memory;
+    u32 sectors_read = 0;
+    for (u32 i = 0; i < image->GetIndexCount(); i++)
+    {
+      const Index& index = image->GetIndex(i);
+      if (index.file_sector_size == 0)
+        continue;
+
+      for (u32 lba = 0; lba < index.length; lba++)
+      {
+        if (!image->ReadSectorFromIndex(memory_ptr, index, lba))
+        {
+          Log_ErrorPrintf("Failed to read LBA %u in index %u", lba, i);
+          return false;
+        }
+
+        progress->SetProgressValue(sectors_read);
+        memory_ptr += RAW_SECTOR_SIZE;
+        sectors_read++;
+      }
     }
   }
 
@@ -153,16 +265,38 @@ bool CDImageMemory::ReadSectorFromIndex(void* buffer, const Index& index, LBA lb
   if (sector_number >= m_memory_sectors)
     return false;
 
+  if (!m_sector_offsets.empty())
+  {
+    const u32 start = m_sector_offsets[static_cast<size_t>(sector_number)];
+    const u32 size = m_sector_offsets[static_cast<size_t>(sector_number) + 1] - start;
+    if (size == RAW_SECTOR_SIZE)
+    {
+      std::memcpy(buffer, &m_compressed_data[start], RAW_SECTOR_SIZE);
+      return true;
+    }
+
+    const size_t result = ZSTD_decompressDCtx(m_dctx, buffer, RAW_SECTOR_SIZE, &m_compressed_data[start], size);
+    if (ZSTD_isError(result) || result != RAW_SECTOR_SIZE)
+    {
+      Log_ErrorPrintf("Failed to decompress sector %" PRIu64 ": %s", sector_number,
+                      ZSTD_isError(result) ? ZSTD_getErrorName(result) : "short output");
+      return false;
+    }
+
+    return true;
+  }
+
   const size_t file_offset = static_cast<size_t>(sector_number) * static_cast<size_t>(RAW_SECTOR_SIZE);
   std::memcpy(buffer, &m_memory[file_offset], RAW_SECTOR_SIZE);
   return true;
 }
 
-std::unique_ptr<CDImage>
-CDImage::CreateMemoryImage(CDImage* image, ProgressCallback* progress /* = ProgressCallback::NullProgressCallback */)
+std::unique_ptr<CDImage> CDImage::CreateMemoryImage(CDImage* image,
+                                                    ProgressCallback* progress /* = ProgressCallback::NullProgressCallback */,
+                                                    bool compress /* = false */)
 {
   std::unique_ptr<CDImageMemory> memory_image = std::make_unique<CDImageMemory>();
-  if (!memory_image->CopyImage(image, progress))
+  if (!memory_image->CopyImage(image, progress, compress))
     return {};
 
   return memory_image;
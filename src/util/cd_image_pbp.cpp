@@ -8,15 +8,20 @@
 #include "common/error.h"
 #include "common/file_system.h"
 #include "common/log.h"
+#include "common/lru_cache.h"
 #include "common/path.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 
 #include "zlib.h"
 
 #include <array>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <variant>
 #include <vector>
@@ -168,11 +173,23 @@ private:
 
   bool IsValidEboot(Error* error);
 
+  // Number of blocks the worker inflates ahead of a sequential reader, and how many decompressed blocks are
+  // kept around. A block is 16 sectors, so 4 blocks ahead covers a comfortable FMV streaming margin.
+  enum : u32
+  {
+    PREFETCH_BLOCKS = 4,
+    BLOCK_CACHE_SIZE = 16,
+  };
+
   bool InitDecompressionStream();
   bool DecompressBlock(const BlockInfo& block_info);
 
   bool OpenDisc(u32 index, Error* error);
 
+  void StartPrefetchThread();
+  void StopPrefetchThread();
+  void PrefetchThreadEntryPoint();
+
   static const std::string* LookupStringSFOTableEntry(const char* key, const SFOTable& table);
 
   FILE* m_file = nullptr;
@@ -197,12 +214,28 @@ private:
 
   z_stream m_inflate_stream;
 
+  // Decompress-ahead. m_mutex guards the file/inflate state, the block cache, and the prefetch range; the
+  // worker holds it for the duration of a block decode, so a missing reader waits at most one block.
+  Threading::Thread m_prefetch_thread;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_prefetch_thread_wake;
+  bool m_prefetch_thread_shutdown = false;
+  bool m_prefetch_thread_started = false;
+  u32 m_prefetch_start = 0;
+  u32 m_prefetch_count = 0;
+
+  LRUCache<u32, std::unique_ptr<std::array<u8, DECOMPRESSED_BLOCK_SIZE>>> m_block_cache{BLOCK_CACHE_SIZE};
+  u32 m_last_block = static_cast<u32>(-1);
+  u32 m_sequential_blocks = 0;
+
   CDSubChannelReplacement m_sbi;
 };
 } // namespace
 
 CDImagePBP::~CDImagePBP()
 {
+  StopPrefetchThread();
+
   if (m_file)
     fclose(m_file);
 
@@ -516,11 +549,16 @@ bool CDImagePBP::OpenDisc(u32 index, Error* error)
     return false;
   }
 
+  StopPrefetchThread();
+
   m_current_block = static_cast<u32>(-1);
   m_blockinfo_table.fill({});
   m_toc.fill({});
   m_decompressed_block.fill(0x00);
   m_compressed_block.clear();
+  m_block_cache.Clear();
+  m_last_block = static_cast<u32>(-1);
+  m_sequential_blocks = 0;
 
   // Go to ISO header
   const u32 iso_header_start = m_disc_offsets[index];
@@ -756,7 +794,11 @@ bool CDImagePBP::OpenDisc(u32 index, Error* error)
   }
 
   m_current_disc = index;
-  return Seek(1, Position{0, 0, 0});
+  if (!Seek(1, Position{0, 0, 0}))
+    return false;
+
+  StartPrefetchThread();
+  return true;
 }
 
 const std::string* CDImagePBP::LookupStringSFOTableEntry(const char* key, const SFOTable& table)
@@ -839,6 +881,8 @@ bool CDImagePBP::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_i
   const u32 offset_in_block = offset_in_file % DECOMPRESSED_BLOCK_SIZE;
   const u32 requested_block = offset_in_file / DECOMPRESSED_BLOCK_SIZE;
 
+  std::unique_lock lock(m_mutex);
+
   BlockInfo& bi = m_blockinfo_table[requested_block];
 
   if (bi.size == 0)
@@ -847,16 +891,111 @@ bool CDImagePBP::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_i
     return false;
   }
 
-  if (m_current_block != requested_block && !DecompressBlock(bi))
+  if (requested_block == (m_last_block + 1))
+    m_sequential_blocks++;
+  else if (requested_block != m_last_block)
+    m_sequential_blocks = 0;
+  m_last_block = requested_block;
+
+  bool have_block = false;
+  if (const auto* cached_block = m_block_cache.Lookup(requested_block))
+  {
+    std::memcpy(buffer, (*cached_block)->data() + offset_in_block, RAW_SECTOR_SIZE);
+    have_block = true;
+  }
+  else if (m_current_block == requested_block)
+  {
+    std::memcpy(buffer, &m_decompressed_block[offset_in_block], RAW_SECTOR_SIZE);
+    have_block = true;
+  }
+
+  if (!have_block)
   {
-    Log_ErrorPrintf("Failed to decompress block %u", requested_block);
-    return false;
+    if (!DecompressBlock(bi))
+    {
+      Log_ErrorPrintf("Failed to decompress block %u", requested_block);
+      return false;
+    }
+
+    m_current_block = requested_block;
+    std::memcpy(buffer, &m_decompressed_block[offset_in_block], RAW_SECTOR_SIZE);
+  }
+
+  // second consecutive block means the game is streaming, get ahead of it
+  if (m_prefetch_thread_started && m_sequential_blocks >= 1)
+  {
+    m_prefetch_start = requested_block + 1;
+    m_prefetch_count = PREFETCH_BLOCKS;
+    m_prefetch_thread_wake.notify_one();
   }
 
-  std::memcpy(buffer, &m_decompressed_block[offset_in_block], RAW_SECTOR_SIZE);
   return true;
 }
 
+void CDImagePBP::StartPrefetchThread()
+{
+  m_prefetch_thread_shutdown = false;
+  m_prefetch_start = 0;
+  m_prefetch_count = 0;
+  m_prefetch_thread_started = m_prefetch_thread.Start([this]() { PrefetchThreadEntryPoint(); });
+  if (!m_prefetch_thread_started)
+    Log_ErrorPrintf("Failed to start prefetch thread, blocks will be decompressed on demand.");
+}
+
+void CDImagePBP::StopPrefetchThread()
+{
+  if (!m_prefetch_thread_started)
+    return;
+
+  {
+    std::unique_lock lock(m_mutex);
+    m_prefetch_thread_shutdown = true;
+    m_prefetch_thread_wake.notify_one();
+  }
+
+  m_prefetch_thread.Join();
+  m_prefetch_thread_started = false;
+}
+
+void CDImagePBP::PrefetchThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("PBP Prefetch");
+
+  std::unique_lock lock(m_mutex);
+  for (;;)
+  {
+    m_prefetch_thread_wake.wait(lock, [this]() { return (m_prefetch_count > 0 || m_prefetch_thread_shutdown); });
+    if (m_prefetch_thread_shutdown)
+      break;
+
+    const u32 block = m_prefetch_start;
+    m_prefetch_start++;
+    m_prefetch_count--;
+
+    if (block >= BLOCK_TABLE_NUM_ENTRIES || m_blockinfo_table[block].size == 0)
+    {
+      m_prefetch_count = 0;
+      continue;
+    }
+
+    if (m_block_cache.Lookup(block) || m_current_block == block)
+      continue;
+
+    if (!DecompressBlock(m_blockinfo_table[block]))
+    {
+      // let the reading thread surface the error if it actually gets here
+      m_prefetch_count = 0;
+      continue;
+    }
+
+    m_current_block = block;
+
+    auto cached_block = std::make_unique<std::array<u8, DECOMPRESSED_BLOCK_SIZE>>();
+    std::memcpy(cached_block->data(), m_decompressed_block.data(), DECOMPRESSED_BLOCK_SIZE);
+    m_block_cache.Insert(block, std::move(cached_block));
+  }
+}
+
 #if _DEBUG
 void CDImagePBP::PrintPBPHeaderInfo(const PBPHeader& pbp_header)
 {
@@ -967,6 +1106,8 @@ std::string CDImagePBP::GetSubImageMetadata(u32 index, const std::string_view& t
 
 s64 CDImagePBP::GetSizeOnDisk() const
 {
+  // FSize64() moves the file position around, which would upset an in-progress prefetch
+  std::unique_lock lock(m_mutex);
   return FileSystem::FSize64(m_file);
 }
 
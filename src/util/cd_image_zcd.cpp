@@ -0,0 +1,583 @@
+// SPDX-FileCopyrightText: 2019-2023 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "cd_image.h"
+#include "cd_subchannel_replacement.h"
+
+#include "common/assert.h"
+#include "common/error.h"
+#include "common/file_system.h"
+#include "common/heap_array.h"
+#include "common/log.h"
+
+#include "fmt/format.h"
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+
+Log_SetChannel(CDImageZCD);
+
+// ZCD: seekable zstd-compressed disc image.
+//
+// Layout is header, track table, index table, block offset table, then the data blocks. Sectors from all
+// file-backed indices are stored consecutively as raw 2352-byte sectors, grouped into fixed-size blocks which
+// are individually zstd-compressed; the offset table holds block_count + 1 absolute file offsets, so a block's
+// compressed size is the difference between neighbours. A block whose extent equals its raw size is stored
+// uncompressed (compressed output is only kept when it is smaller). When subchannel data is embedded, each
+// block carries the 12-byte Q frames for its sectors after the sector data. All fields are little-endian.
+
+namespace {
+
+enum : u32
+{
+  ZCD_SECTORS_PER_BLOCK = 8,
+  ZCD_COMPRESSION_LEVEL = 19,
+
+  // Upper bound on sectors_per_block accepted when reading, keeping the block buffer size
+  // (sectors_per_block * bytes_per_sector) well clear of u32 overflow for crafted headers.
+  ZCD_MAX_SECTORS_PER_BLOCK = 1024,
+};
+
+static constexpr char ZCD_MAGIC[4] = {'Z', 'C', 'D', '1'};
+
+#pragma pack(push, 1)
+struct ZCDHeader
+{
+  char magic[4]; // "ZCD1"
+  u32 sectors_per_block;
+  u32 lba_count;
+  u32 data_sector_count;
+  u32 block_count;
+  u32 track_count;
+  u32 index_count;
+  u8 has_subchannel;
+  u8 unused[3];
+};
+
+struct ZCDTrackEntry
+{
+  u32 track_number;
+  u32 start_lba;
+  u32 first_index;
+  u32 length;
+  u8 mode;
+  u8 submode;
+  u8 control_bits;
+  u8 unused;
+};
+
+struct ZCDIndexEntry
+{
+  u64 file_offset; // sector number within the stored data
+  u32 file_sector_size;
+  u32 start_lba_on_disc;
+  u32 track_number;
+  u32 index_number;
+  u32 start_lba_in_track;
+  u32 length;
+  u8 mode;
+  u8 submode;
+  u8 control_bits;
+  u8 is_pregap;
+};
+#pragma pack(pop)
+
+class CDImageZCD : public CDImage
+{
+public:
+  CDImageZCD();
+  ~CDImageZCD() override;
+
+  bool Open(const char* filename, Error* error);
+
+  bool ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index) override;
+  bool HasNonStandardSubchannel() const override;
+  PrecacheResult Precache(ProgressCallback* progress) override;
+  bool IsPrecached() const override;
+  s64 GetSizeOnDisk() const override;
+
+protected:
+  bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
+
+private:
+  u32 GetBlockSectorCount(u32 block_index) const
+  {
+    return std::min<u32>(m_header.sectors_per_block,
+                         m_header.data_sector_count - (block_index * m_header.sectors_per_block));
+  }
+
+  u32 GetBlockRawSize(u32 block_index) const { return GetBlockSectorCount(block_index) * m_bytes_per_sector; }
+
+  const u8* GetBlockData(u32 block_index);
+
+  std::FILE* m_fp = nullptr;
+  ZCDHeader m_header = {};
+  u32 m_bytes_per_sector = 0; // RAW_SECTOR_SIZE, plus the Q frame when subchannel is embedded
+
+  std::vector<u64> m_block_offsets;
+  ZSTD_DCtx* m_dctx = nullptr;
+
+  DynamicHeapArray<u8, 16> m_block_buffer;
+  DynamicHeapArray<u8, 16> m_compressed_buffer;
+  u32 m_current_block = static_cast<u32>(-1);
+
+  // Filled by Precache() with every block decompressed, stored consecutively.
+  DynamicHeapArray<u8, 16> m_precache_data;
+  bool m_precached = false;
+
+  CDSubChannelReplacement m_sbi;
+};
+
+} // namespace
+
+CDImageZCD::CDImageZCD() = default;
+
+CDImageZCD::~CDImageZCD()
+{
+  if (m_dctx)
+    ZSTD_freeDCtx(m_dctx);
+  if (m_fp)
+    std::fclose(m_fp);
+}
+
+bool CDImageZCD::Open(const char* filename, Error* error)
+{
+  m_fp = FileSystem::OpenCFile(filename, "rb");
+  if (!m_fp)
+  {
+    Log_ErrorPrintf("Failed to open ZCD '%s': errno %d", filename, errno);
+    if (error)
+      error->SetErrno(errno);
+    return false;
+  }
+
+  if (std::fread(&m_header, sizeof(m_header), 1, m_fp) != 1 ||
+      std::memcmp(m_header.magic, ZCD_MAGIC, sizeof(ZCD_MAGIC)) != 0)
+  {
+    Log_ErrorPrintf("'%s' is not a ZCD image", filename);
+    Error::SetString(error, "File is not a ZCD image");
+    return false;
+  }
+
+  if (m_header.sectors_per_block == 0 || m_header.sectors_per_block > ZCD_MAX_SECTORS_PER_BLOCK ||
+      m_header.data_sector_count == 0 || m_header.track_count == 0 || m_header.index_count == 0 ||
+      m_header.block_count != ((m_header.data_sector_count + m_header.sectors_per_block - 1) /
+                               m_header.sectors_per_block))
+  {
+    Log_ErrorPrintf("'%s' has invalid header fields", filename);
+    Error::SetString(error, "Invalid ZCD header");
+    return false;
+  }
+
+  m_bytes_per_sector = RAW_SECTOR_SIZE + (m_header.has_subchannel ? SUBCHANNEL_BYTES_PER_FRAME : 0);
+
+  for (u32 i = 0; i < m_header.track_count; i++)
+  {
+    ZCDTrackEntry entry;
+    if (std::fread(&entry, sizeof(entry), 1, m_fp) != 1)
+    {
+      Error::SetString(error, "Failed to read track table");
+      return false;
+    }
+
+    m_tracks.push_back(Track{entry.track_number, entry.start_lba, entry.first_index, entry.length,
+                             static_cast<TrackMode>(entry.mode), static_cast<SubchannelMode>(entry.submode),
+                             SubChannelQ::Control(entry.control_bits)});
+  }
+
+  for (u32 i = 0; i < m_header.index_count; i++)
+  {
+    ZCDIndexEntry entry;
+    if (std::fread(&entry, sizeof(entry), 1, m_fp) != 1)
+    {
+      Error::SetString(error, "Failed to read index table");
+      return false;
+    }
+
+    Index index = {};
+    index.file_offset = entry.file_offset;
+    index.file_index = 0;
+    index.file_sector_size = entry.file_sector_size;
+    index.start_lba_on_disc = entry.start_lba_on_disc;
+    index.track_number = entry.track_number;
+    index.index_number = entry.index_number;
+    index.start_lba_in_track = entry.start_lba_in_track;
+    index.length = entry.length;
+    index.mode = static_cast<TrackMode>(entry.mode);
+    index.submode = static_cast<SubchannelMode>(entry.submode);
+    index.control.bits = entry.control_bits;
+    index.is_pregap = (entry.is_pregap != 0);
+    m_indices.push_back(index);
+  }
+
+  m_block_offsets.resize(m_header.block_count + 1);
+  if (std::fread(m_block_offsets.data(), sizeof(u64), m_block_offsets.size(), m_fp) != m_block_offsets.size())
+  {
+    Error::SetString(error, "Failed to read block offset table");
+    return false;
+  }
+
+  m_dctx = ZSTD_createDCtx();
+  if (!m_dctx)
+  {
+    Error::SetString(error, "Failed to create decompression context");
+    return false;
+  }
+
+  m_block_buffer.resize(m_header.sectors_per_block * m_bytes_per_sector);
+
+  m_filename = filename;
+  m_lba_count = m_header.lba_count;
+
+  m_sbi.LoadFromImagePath(filename);
+
+  return Seek(1, Position{0, 0, 0});
+}
+
+const u8* CDImageZCD::GetBlockData(u32 block_index)
+{
+  if (m_precached)
+  {
+    return &m_precache_data[static_cast<size_t>(block_index) * m_header.sectors_per_block * m_bytes_per_sector];
+  }
+
+  if (m_current_block == block_index)
+    return m_block_buffer.data();
+
+  const u64 start = m_block_offsets[block_index];
+  const u64 size = m_block_offsets[block_index + 1] - start;
+  const u32 raw_size = GetBlockRawSize(block_index);
+  if (size == 0 || size > raw_size || FileSystem::FSeek64(m_fp, start, SEEK_SET) != 0)
+  {
+    Log_ErrorPrintf("Invalid extent for block %u", block_index);
+    return nullptr;
+  }
+
+  if (size == raw_size)
+  {
+    // stored raw
+    if (std::fread(m_block_buffer.data(), raw_size, 1, m_fp) != 1)
+    {
+      Log_ErrorPrintf("Failed to read block %u", block_index);
+      return nullptr;
+    }
+  }
+  else
+  {
+    if (m_compressed_buffer.size() < size)
+      m_compressed_buffer.resize(static_cast<size_t>(size));
+
+    if (std::fread(m_compressed_buffer.data(), static_cast<size_t>(size), 1, m_fp) != 1)
+    {
+      Log_ErrorPrintf("Failed to read block %u", block_index);
+      return nullptr;
+    }
+
+    const size_t result =
+      ZSTD_decompressDCtx(m_dctx, m_block_buffer.data(), raw_size, m_compressed_buffer.data(), static_cast<size_t>(size));
+    if (ZSTD_isError(result) || result != raw_size)
+    {
+      Log_ErrorPrintf("Failed to decompress block %u: %s", block_index,
+                      ZSTD_isError(result) ? ZSTD_getErrorName(result) : "short output");
+      return nullptr;
+    }
+  }
+
+  m_current_block = block_index;
+  return m_block_buffer.data();
+}
+
+bool CDImageZCD::ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index)
+{
+  if (m_sbi.GetReplacementSubChannelQ(index.start_lba_on_disc + lba_in_index, subq))
+    return true;
+
+  if (!m_header.has_subchannel || index.file_sector_size == 0)
+    return CDImage::ReadSubChannelQ(subq, index, lba_in_index);
+
+  const u32 sector_number = static_cast<u32>(index.file_offset) + lba_in_index;
+  if (sector_number >= m_header.data_sector_count)
+    return false;
+
+  const u32 block_index = sector_number / m_header.sectors_per_block;
+  const u8* block_data = GetBlockData(block_index);
+  if (!block_data)
+    return false;
+
+  const u32 sector_in_block = sector_number % m_header.sectors_per_block;
+  std::memcpy(subq->data.data(),
+              &block_data[(GetBlockSectorCount(block_index) * RAW_SECTOR_SIZE) +
+                          (sector_in_block * SUBCHANNEL_BYTES_PER_FRAME)],
+              SUBCHANNEL_BYTES_PER_FRAME);
+  return true;
+}
+
+bool CDImageZCD::HasNonStandardSubchannel() const
+{
+  return (m_sbi.GetReplacementSectorCount() > 0 || m_header.has_subchannel != 0);
+}
+
+CDImage::PrecacheResult CDImageZCD::Precache(ProgressCallback* progress)
+{
+  if (m_precached)
+    return CDImage::PrecacheResult::Success;
+
+  progress->SetStatusText(fmt::format("Precaching {}...", FileSystem::GetDisplayNameFromPath(m_filename)).c_str());
+  progress->SetProgressRange(m_header.block_count);
+  progress->SetProgressValue(0);
+
+  m_precache_data.resize(static_cast<size_t>(m_header.data_sector_count) * m_bytes_per_sector);
+
+  // blocks are consecutive in the file, so this is one sequential pass
+  for (u32 block_index = 0; block_index < m_header.block_count; block_index++)
+  {
+    const u8* block_data = GetBlockData(block_index);
+    if (!block_data)
+    {
+      m_precache_data.deallocate();
+      return CDImage::PrecacheResult::ReadError;
+    }
+
+    std::memcpy(&m_precache_data[static_cast<size_t>(block_index) * m_header.sectors_per_block * m_bytes_per_sector],
+                block_data, GetBlockRawSize(block_index));
+    progress->SetProgressValue(block_index + 1);
+  }
+
+  m_block_buffer.deallocate();
+  m_compressed_buffer.deallocate();
+  m_current_block = static_cast<u32>(-1);
+  m_precached = true;
+  return CDImage::PrecacheResult::Success;
+}
+
+bool CDImageZCD::IsPrecached() const
+{
+  return m_precached;
+}
+
+bool CDImageZCD::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
+{
+  const u32 sector_number = static_cast<u32>(index.file_offset) + lba_in_index;
+  if (sector_number >= m_header.data_sector_count)
+    return false;
+
+  const u8* block_data = GetBlockData(sector_number / m_header.sectors_per_block);
+  if (!block_data)
+    return false;
+
+  std::memcpy(buffer, &block_data[(sector_number % m_header.sectors_per_block) * RAW_SECTOR_SIZE], RAW_SECTOR_SIZE);
+  return true;
+}
+
+s64 CDImageZCD::GetSizeOnDisk() const
+{
+  return FileSystem::FSize64(m_fp);
+}
+
+std::unique_ptr<CDImage> CDImage::OpenZCDImage(const char* filename, Error* error)
+{
+  std::unique_ptr<CDImageZCD> image = std::make_unique<CDImageZCD>();
+  if (!image->Open(filename, error))
+    return {};
+
+  return image;
+}
+
+bool CDImage::ConvertToZCD(CDImage* image, const char* filename, ProgressCallback* progress, Error* error)
+{
+  // count the stored sectors (not including blank pregaps)
+  u32 data_sector_count = 0;
+  for (u32 i = 0; i < image->GetIndexCount(); i++)
+  {
+    const Index& index = image->GetIndex(i);
+    if (index.file_sector_size > 0)
+      data_sector_count += index.length;
+  }
+  if (data_sector_count == 0)
+  {
+    Error::SetString(error, "Image contains no file-backed sectors");
+    return false;
+  }
+
+  const bool has_subchannel = image->HasNonStandardSubchannel();
+  const u32 bytes_per_sector = RAW_SECTOR_SIZE + (has_subchannel ? SUBCHANNEL_BYTES_PER_FRAME : 0);
+  const u32 block_count = (data_sector_count + ZCD_SECTORS_PER_BLOCK - 1) / ZCD_SECTORS_PER_BLOCK;
+
+  auto fp = FileSystem::OpenManagedCFile(filename, "w+b");
+  if (!fp)
+  {
+    if (error)
+      error->SetErrno(errno);
+    return false;
+  }
+
+  ZSTD_CCtx* cctx = ZSTD_createCCtx();
+  if (!cctx)
+  {
+    Error::SetString(error, "Failed to create compression context");
+    return false;
+  }
+
+  ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, ZCD_COMPRESSION_LEVEL);
+
+  ZCDHeader header = {};
+  std::memcpy(header.magic, ZCD_MAGIC, sizeof(header.magic));
+  header.sectors_per_block = ZCD_SECTORS_PER_BLOCK;
+  header.lba_count = image->GetLBACount();
+  header.data_sector_count = data_sector_count;
+  header.block_count = block_count;
+  header.track_count = image->GetTrackCount();
+  header.index_count = image->GetIndexCount();
+  header.has_subchannel = BoolToUInt8(has_subchannel);
+
+  bool ok = (std::fwrite(&header, sizeof(header), 1, fp.get()) == 1);
+
+  for (u32 i = 1; i <= image->GetTrackCount() && ok; i++)
+  {
+    const Track& track = image->GetTrack(i);
+    const ZCDTrackEntry entry = {track.track_number,           track.start_lba,
+                                 track.first_index,            track.length,
+                                 static_cast<u8>(track.mode),  static_cast<u8>(track.submode),
+                                 track.control.bits,           0};
+    ok = (std::fwrite(&entry, sizeof(entry), 1, fp.get()) == 1);
+  }
+
+  u32 current_offset = 0;
+  for (u32 i = 0; i < image->GetIndexCount() && ok; i++)
+  {
+    const Index& index = image->GetIndex(i);
+    ZCDIndexEntry entry = {};
+    if (index.file_sector_size > 0)
+    {
+      entry.file_offset = current_offset;
+      entry.file_sector_size = RAW_SECTOR_SIZE;
+      current_offset += index.length;
+    }
+    entry.start_lba_on_disc = index.start_lba_on_disc;
+    entry.track_number = index.track_number;
+    entry.index_number = index.index_number;
+    entry.start_lba_in_track = index.start_lba_in_track;
+    entry.length = index.length;
+    entry.mode = static_cast<u8>(index.mode);
+    entry.submode = static_cast<u8>(index.submode);
+    entry.control_bits = index.control.bits;
+    entry.is_pregap = BoolToUInt8(index.is_pregap);
+    ok = (std::fwrite(&entry, sizeof(entry), 1, fp.get()) == 1);
+  }
+
+  // placeholder offset table, rewritten once the blocks have been compressed
+  const s64 offset_table_position = FileSystem::FTell64(fp.get());
+  std::vector<u64> block_offsets(block_count + 1, 0);
+  ok = ok && (std::fwrite(block_offsets.data(), sizeof(u64), block_offsets.size(), fp.get()) == block_offsets.size());
+
+  progress->SetStatusText(fmt::format("Converting {}...", FileSystem::GetDisplayNameFromPath(filename)).c_str());
+  progress->SetProgressRange(data_sector_count);
+  progress->SetProgressValue(0);
+
+  DynamicHeapArray<u8, 16> block_buffer(static_cast<size_t>(ZCD_SECTORS_PER_BLOCK) * bytes_per_sector);
+  DynamicHeapArray<u8, 16> compress_buffer(ZSTD_compressBound(block_buffer.size()));
+
+  u32 block_index = 0;
+  u32 sectors_in_block = 0;
+  u32 sectors_written = 0;
+
+  const auto flush_block = [&]() {
+    const u32 raw_size = sectors_in_block * bytes_per_sector;
+
+    // pack the Q frames up against the sector data in short final blocks
+    if (has_subchannel && sectors_in_block != ZCD_SECTORS_PER_BLOCK)
+    {
+      std::memmove(&block_buffer[sectors_in_block * RAW_SECTOR_SIZE],
+                   &block_buffer[ZCD_SECTORS_PER_BLOCK * static_cast<u32>(RAW_SECTOR_SIZE)],
+                   sectors_in_block * SUBCHANNEL_BYTES_PER_FRAME);
+    }
+
+    block_offsets[block_index] = static_cast<u64>(FileSystem::FTell64(fp.get()));
+
+    const size_t result =
+      ZSTD_compress2(cctx, compress_buffer.data(), compress_buffer.size(), block_buffer.data(), raw_size);
+    if (ZSTD_isError(result) || result >= raw_size)
+      ok = ok && (std::fwrite(block_buffer.data(), raw_size, 1, fp.get()) == 1);
+    else
+      ok = ok && (std::fwrite(compress_buffer.data(), result, 1, fp.get()) == 1);
+
+    block_index++;
+    sectors_in_block = 0;
+  };
+
+  for (u32 i = 0; i < image->GetIndexCount() && ok; i++)
+  {
+    const Index& index = image->GetIndex(i);
+    if (index.file_sector_size == 0)
+      continue;
+
+    for (u32 lba = 0; lba < index.length && ok; lba++)
+    {
+      if (!image->ReadSectorFromIndex(&block_buffer[sectors_in_block * RAW_SECTOR_SIZE], index, lba))
+      {
+        Log_ErrorPrintf("Failed to read LBA %u in index %u", lba, i);
+        Error::SetString(error, "Failed to read sector from source image");
+        ok = false;
+        break;
+      }
+
+      if (has_subchannel)
+      {
+        SubChannelQ subq;
+        if (!image->ReadSubChannelQ(&subq, index, lba))
+        {
+          Log_ErrorPrintf("Failed to read subchannel for LBA %u in index %u", lba, i);
+          Error::SetString(error, "Failed to read subchannel from source image");
+          ok = false;
+          break;
+        }
+
+        std::memcpy(&block_buffer[(ZCD_SECTORS_PER_BLOCK * static_cast<u32>(RAW_SECTOR_SIZE)) +
+                                  (sectors_in_block * SUBCHANNEL_BYTES_PER_FRAME)],
+                    subq.data.data(), SUBCHANNEL_BYTES_PER_FRAME);
+      }
+
+      sectors_in_block++;
+      sectors_written++;
+      if (sectors_in_block == ZCD_SECTORS_PER_BLOCK)
+        flush_block();
+
+      progress->SetProgressValue(sectors_written);
+    }
+  }
+
+  if (ok && sectors_in_block > 0)
+    flush_block();
+
+  ZSTD_freeCCtx(cctx);
+
+  if (ok)
+  {
+    Assert(block_index == block_count && sectors_written == data_sector_count);
+    block_offsets[block_count] = static_cast<u64>(FileSystem::FTell64(fp.get()));
+
+    ok = (FileSystem::FSeek64(fp.get(), offset_table_position, SEEK_SET) == 0) &&
+         (std::fwrite(block_offsets.data(), sizeof(u64), block_offsets.size(), fp.get()) == block_offsets.size()) &&
+         (std::fflush(fp.get()) == 0);
+  }
+
+  if (!ok)
+  {
+    if (error && !error->IsValid())
+      Error::SetString(error, "Failed to write output file");
+
+    fp.reset();
+    FileSystem::DeleteFile(filename);
+    return false;
+  }
+
+  Log_InfoPrintf("Converted %u sectors (%u blocks) to '%s', %" PRIu64 " -> %" PRIu64 " bytes", data_sector_count,
+                 block_count, filename, static_cast<u64>(data_sector_count) * bytes_per_sector,
+                 block_offsets[block_count]);
+  return true;
+}
@@ -7,6 +7,7 @@
 #include "common/path.h"
 #include <algorithm>
 #include <memory>
+#include <vector>
 Log_SetChannel(CDSubChannelReplacement);
 
 #pragma pack(push, 1)
@@ -63,8 +64,19 @@ bool CDSubChannelReplacement::LoadSBI(const std::string& path)
 
   m_replacement_subq.clear();
 
-  SBIFileEntry entry;
-  while (std::fread(&entry, sizeof(entry), 1, fp.get()) == 1)
+  // Bulk-load the remainder of the file in one read rather than an fread() per entry.
+  const u32 num_entries =
+    static_cast<u32>(std::max<s64>(FileSystem::FSize64(fp.get()) - static_cast<s64>(sizeof(header)), 0) /
+                     sizeof(SBIFileEntry));
+  std::vector<SBIFileEntry> entries(num_entries);
+  if (num_entries > 0 && std::fread(entries.data(), sizeof(SBIFileEntry), num_entries, fp.get()) != num_entries)
+  {
+    Log_ErrorFmt("Failed to read {} entries from '{}'", num_entries, path);
+    return true;
+  }
+
+  m_replacement_subq.reserve(num_entries);
+  for (const SBIFileEntry& entry : entries)
   {
     if (!IsValidPackedBCD(entry.minute_bcd) || !IsValidPackedBCD(entry.second_bcd) ||
         !IsValidPackedBCD(entry.frame_bcd))
@@ -90,9 +102,10 @@ bool CDSubChannelReplacement::LoadSBI(const std::string& path)
     subq.data[10] = Truncate8(crc);
     subq.data[11] = Truncate8(crc >> 8);
 
-    m_replacement_subq.emplace(lba, subq);
+    m_replacement_subq.push_back(ReplacementEntry{lba, subq});
   }
 
+  FinalizeEntries();
   Log_InfoFmt("Loaded {} replacement sectors from SBI '{}'", m_replacement_subq.size(), path);
   return true;
 }
@@ -105,8 +118,17 @@ bool CDSubChannelReplacement::LoadLSD(const std::string& path)
 
   m_replacement_subq.clear();
 
-  LSDFileEntry entry;
-  while (std::fread(&entry, sizeof(entry), 1, fp.get()) == 1)
+  const u32 num_entries =
+    static_cast<u32>(std::max<s64>(FileSystem::FSize64(fp.get()), 0) / sizeof(LSDFileEntry));
+  std::vector<LSDFileEntry> entries(num_entries);
+  if (num_entries > 0 && std::fread(entries.data(), sizeof(LSDFileEntry), num_entries, fp.get()) != num_entries)
+  {
+    Log_ErrorFmt("Failed to read {} entries from '{}'", num_entries, path);
+    return true;
+  }
+
+  m_replacement_subq.reserve(num_entries);
+  for (const LSDFileEntry& entry : entries)
   {
     if (!IsValidPackedBCD(entry.minute_bcd) || !IsValidPackedBCD(entry.second_bcd) ||
         !IsValidPackedBCD(entry.frame_bcd))
@@ -123,9 +145,10 @@ bool CDSubChannelReplacement::LoadLSD(const std::string& path)
 
     Log_DebugFmt("{:02x}:{:02x}:{:02x}: CRC {}", entry.minute_bcd, entry.second_bcd, entry.frame_bcd,
                  subq.IsCRCValid() ? "VALID" : "INVALID");
-    m_replacement_subq.emplace(lba, subq);
+    m_replacement_subq.push_back(ReplacementEntry{lba, subq});
   }
 
+  FinalizeEntries();
   Log_InfoFmt("Loaded {} replacement sectors from LSD '{}'", m_replacement_subq.size(), path);
   return true;
 }
@@ -141,13 +164,28 @@ bool CDSubChannelReplacement::LoadFromImagePath(std::string_view image_path)
   return false;
 }
 
+void CDSubChannelReplacement::FinalizeEntries()
+{
+  std::stable_sort(m_replacement_subq.begin(), m_replacement_subq.end(),
+                   [](const ReplacementEntry& lhs, const ReplacementEntry& rhs) { return lhs.lba < rhs.lba; });
+
+  // keep the first of any duplicate positions, matching the old map insertion behaviour
+  m_replacement_subq.erase(std::unique(m_replacement_subq.begin(), m_replacement_subq.end(),
+                                       [](const ReplacementEntry& lhs, const ReplacementEntry& rhs) {
+                                         return lhs.lba == rhs.lba;
+                                       }),
+                           m_replacement_subq.end());
+}
+
 void CDSubChannelReplacement::AddReplacementSubChannelQ(u32 lba, const CDImage::SubChannelQ& subq)
 {
-  auto iter = m_replacement_subq.find(lba);
-  if (iter != m_replacement_subq.end())
-    iter->second.data = subq.data;
+  const auto iter = std::lower_bound(
+    m_replacement_subq.begin(), m_replacement_subq.end(), lba,
+    [](const ReplacementEntry& entry, u32 key_lba) { return entry.lba < key_lba; });
+  if (iter != m_replacement_subq.end() && iter->lba == lba)
+    iter->subq.data = subq.data;
   else
-    m_replacement_subq.emplace(lba, subq);
+    m_replacement_subq.insert(iter, ReplacementEntry{lba, subq});
 }
 
 bool CDSubChannelReplacement::GetReplacementSubChannelQ(u8 minute_bcd, u8 second_bcd, u8 frame_bcd,
@@ -158,10 +196,16 @@ bool CDSubChannelReplacement::GetReplacementSubChannelQ(u8 minute_bcd, u8 second
 
 bool CDSubChannelReplacement::GetReplacementSubChannelQ(u32 lba, CDImage::SubChannelQ* subq) const
 {
-  const auto iter = m_replacement_subq.find(lba);
-  if (iter == m_replacement_subq.cend())
+  // cheap range rejection first, the majority of sector reads fall outside the replacement set
+  if (m_replacement_subq.empty() || lba < m_replacement_subq.front().lba || lba > m_replacement_subq.back().lba)
+    return false;
+
+  const auto iter = std::lower_bound(
+    m_replacement_subq.begin(), m_replacement_subq.end(), lba,
+    [](const ReplacementEntry& entry, u32 key_lba) { return entry.lba < key_lba; });
+  if (iter == m_replacement_subq.end() || iter->lba != lba)
     return false;
 
-  *subq = iter->second;
+  *subq = iter->subq;
   return true;
 }
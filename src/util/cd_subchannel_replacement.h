@@ -6,7 +6,7 @@
 #include "common/types.h"
 #include <array>
 #include <cstdio>
-#include <unordered_map>
+#include <vector>
 
 class CDSubChannelReplacement
 {
@@ -28,10 +28,19 @@ public:
   bool GetReplacementSubChannelQ(u32 lba, CDImage::SubChannelQ* subq) const;
 
 private:
-  using ReplacementMap = std::unordered_map<u32, CDImage::SubChannelQ>;
+  struct ReplacementEntry
+  {
+    u32 lba;
+    CDImage::SubChannelQ subq;
+  };
 
   bool LoadSBI(const std::string& path);
   bool LoadLSD(const std::string& path);
 
-  ReplacementMap m_replacement_subq;
+  /// Sorts entries by LBA after bulk loading, dropping any duplicate positions.
+  void FinalizeEntries();
+
+  // Sorted by LBA. Replacements are sparse (a libcrypt SBI is a handful of sectors), so a flat
+  // array probed with binary search beats chasing map nodes on every sector read.
+  std::vector<ReplacementEntry> m_replacement_subq;
 };
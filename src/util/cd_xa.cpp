@@ -4,6 +4,8 @@
 #include "cd_xa.h"
 #include "cd_image.h"
 
+#include "common/intrin.h"
+
 #include <algorithm>
 #include <array>
 
@@ -11,6 +13,44 @@ namespace CDXA {
 static constexpr std::array<s32, 4> s_xa_adpcm_filter_table_pos = {{0, 60, 115, 98}};
 static constexpr std::array<s32, 4> s_xa_adpcm_filter_table_neg = {{0, 0, -52, -55}};
 
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+
+template<bool IS_8BIT>
+ALWAYS_INLINE_RELEASE static void UnpackXA_ADPCMBlock(const u8* words_ptr, u32 block, u8 shift, s32* raw_samples)
+{
+  // Shift the block's nibble up to the top of each word, mask off the neighbouring nibbles that
+  // came along for the ride, then arithmetic-shift back down. This reproduces the scalar sign
+  // extension and shift scaling exactly, including 8-bit mode only ever using the low nibble of
+  // each byte, as the scalar path's Truncate16 does.
+  // NOTE: assumes LE
+  const u32 lshift = 28 - (block * (IS_8BIT ? 8 : 4));
+  const u32 rshift = 16 + shift;
+
+#if defined(CPU_ARCH_SSE)
+  const __m128i vlshift = _mm_cvtsi32_si128(static_cast<int>(lshift));
+  const __m128i vrshift = _mm_cvtsi32_si128(static_cast<int>(rshift));
+  const __m128i vmask = _mm_set1_epi32(static_cast<int>(0xF0000000u));
+  for (u32 i = 0; i < 28; i += 4)
+  {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words_ptr + (i * sizeof(u32))));
+    v = _mm_sra_epi32(_mm_and_si128(_mm_sll_epi32(v, vlshift), vmask), vrshift);
+    _mm_store_si128(reinterpret_cast<__m128i*>(raw_samples + i), v);
+  }
+#elif defined(CPU_ARCH_NEON)
+  const int32x4_t vlshift = vdupq_n_s32(static_cast<s32>(lshift));
+  const int32x4_t vrshift = vdupq_n_s32(-static_cast<s32>(rshift));
+  const int32x4_t vmask = vdupq_n_s32(static_cast<s32>(0xF0000000u));
+  for (u32 i = 0; i < 28; i += 4)
+  {
+    int32x4_t v = vreinterpretq_s32_u8(vld1q_u8(words_ptr + (i * sizeof(u32))));
+    v = vshlq_s32(vandq_s32(vshlq_s32(v, vlshift), vmask), vrshift);
+    vst1q_s32(raw_samples + i, v);
+  }
+#endif
+}
+
+#endif // CPU_ARCH_SSE || CPU_ARCH_NEON
+
 template<bool IS_STEREO, bool IS_8BIT>
 ALWAYS_INLINE_RELEASE static void DecodeXA_ADPCMChunk(const u8* chunk_ptr, s16* samples, s32* last_samples)
 {
@@ -34,6 +74,26 @@ ALWAYS_INLINE_RELEASE static void DecodeXA_ADPCMChunk(const u8* chunk_ptr, s16*
       IS_STEREO ? &samples[(block / 2) * (WORDS_PER_BLOCK * 2) + (block % 2)] : &samples[block * WORDS_PER_BLOCK];
     constexpr u32 out_samples_increment = IS_STEREO ? 2 : 1;
 
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+    // Bulk-unpack the block's samples, then run the (inherently serial) filter recurrence over the
+    // contiguous buffer. The scalar path below re-reads every data word once per block.
+    alignas(VECTOR_ALIGNMENT) s32 raw_samples[WORDS_PER_BLOCK];
+    UnpackXA_ADPCMBlock<IS_8BIT>(words_ptr, block, shift, raw_samples);
+
+    s32* prev = IS_STEREO ? &last_samples[(block & 1) * 2] : last_samples;
+    for (u32 word = 0; word < WORDS_PER_BLOCK; word++)
+    {
+      // mix in previous values
+      const s32 interp_sample = raw_samples[word] + ((prev[0] * filter_pos) + (prev[1] * filter_neg) + 32) / 64;
+
+      // update previous values
+      prev[1] = prev[0];
+      prev[0] = interp_sample;
+
+      *out_samples_ptr = static_cast<s16>(std::clamp<s32>(interp_sample, -0x8000, 0x7FFF));
+      out_samples_ptr += out_samples_increment;
+    }
+#else
     for (u32 word = 0; word < 28; word++)
     {
       // NOTE: assumes LE
@@ -55,6 +115,7 @@ ALWAYS_INLINE_RELEASE static void DecodeXA_ADPCMChunk(const u8* chunk_ptr, s16*
       *out_samples_ptr = static_cast<s16>(std::clamp<s32>(interp_sample, -0x8000, 0x7FFF));
       out_samples_ptr += out_samples_increment;
     }
+#endif
   }
 }
 
@@ -10,6 +10,7 @@
 #include "common/log.h"
 #include "common/scoped_guard.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 
 #include "cubeb/cubeb.h"
 #include "fmt/format.h"
@@ -229,6 +230,14 @@ void CubebAudioStream::StateCallback(cubeb_stream* stream, void* user_ptr, cubeb
 long CubebAudioStream::DataCallback(cubeb_stream* stm, void* user_ptr, const void* input_buffer, void* output_buffer,
                                     long nframes)
 {
+  // cubeb owns the callback thread, so the performance hint has to be applied from within it.
+  static thread_local bool performance_hint_set = false;
+  if (!performance_hint_set)
+  {
+    performance_hint_set = true;
+    Threading::SetPerformanceHintForCurrentThread();
+  }
+
   static_cast<CubebAudioStream*>(user_ptr)->ReadFrames(static_cast<s16*>(output_buffer), static_cast<u32>(nframes));
   return nframes;
 }
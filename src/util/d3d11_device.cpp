@@ -191,6 +191,7 @@ void D3D11Device::SetFeatures(FeatureMask disabled_features)
   m_features.shader_cache = true;
   m_features.pipeline_cache = false;
   m_features.prefer_unused_textures = false;
+  m_features.threaded_pipeline_creation = false;
 }
 
 bool D3D11Device::CreateSwapChain()
@@ -266,6 +267,11 @@ bool D3D11Device::CreateSwapChain()
 
   if (!m_is_exclusive_fullscreen)
   {
+    // The frame-latency waitable object lets us cap the present queue at a single frame,
+    // instead of the 2-3 frames DXGI queues by default. Not allowed on fullscreen swap chains.
+    if (m_using_flip_model_swap_chain)
+      swap_chain_desc.Flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+
     Log_VerbosePrintf("Creating a %dx%d %s windowed swap chain", swap_chain_desc.Width, swap_chain_desc.Height,
                       m_using_flip_model_swap_chain ? "flip-discard" : "discard");
     hr = m_dxgi_factory->CreateSwapChainForHwnd(m_device.Get(), window_hwnd, &swap_chain_desc, nullptr, nullptr,
@@ -297,6 +303,15 @@ bool D3D11Device::CreateSwapChain()
     Log_WarningPrintf("MakeWindowAssociation() to disable ALT+ENTER failed");
   }
 
+  if (swap_chain_desc.Flags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT)
+  {
+    ComPtr<IDXGISwapChain2> swap_chain2;
+    if (SUCCEEDED(m_swap_chain.As(&swap_chain2)) && SUCCEEDED(swap_chain2->SetMaximumFrameLatency(1)))
+      m_frame_latency_waitable_object = swap_chain2->GetFrameLatencyWaitableObject();
+    if (!m_frame_latency_waitable_object)
+      Log_WarningPrintf("Failed to get frame latency waitable object.");
+  }
+
   if (!CreateSwapChainRTV())
   {
     DestroySwapChain();
@@ -363,6 +378,12 @@ void D3D11Device::DestroySwapChain()
 
   m_swap_chain_rtv.Reset();
 
+  if (m_frame_latency_waitable_object)
+  {
+    CloseHandle(m_frame_latency_waitable_object);
+    m_frame_latency_waitable_object = {};
+  }
+
   // switch out of fullscreen before destroying
   BOOL is_fullscreen;
   if (SUCCEEDED(m_swap_chain->GetFullscreenState(&is_fullscreen, nullptr)) && is_fullscreen)
@@ -408,8 +429,11 @@ void D3D11Device::ResizeWindow(s32 new_window_width, s32 new_window_height, floa
 
   m_swap_chain_rtv.Reset();
 
-  HRESULT hr = m_swap_chain->ResizeBuffers(0, 0, 0, DXGI_FORMAT_UNKNOWN,
-                                           m_using_allow_tearing ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0);
+  u32 resize_flags = m_using_allow_tearing ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+  if (m_frame_latency_waitable_object)
+    resize_flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+
+  HRESULT hr = m_swap_chain->ResizeBuffers(0, 0, 0, DXGI_FORMAT_UNKNOWN, resize_flags);
   if (FAILED(hr))
     Log_ErrorPrintf("ResizeBuffers() failed: 0x%08X", hr);
 
@@ -632,6 +656,11 @@ bool D3D11Device::BeginPresent(bool skip_present)
   if ((m_sync_mode == DisplaySyncMode::VSync || m_sync_mode == DisplaySyncMode::VSyncRelaxed) && m_gpu_timing_enabled)
     PopTimestampQuery();
 
+  // Block here, before the frame is built, until the present queue drains to one frame. Waiting
+  // in Present() instead would add a whole frame of latency with the work already done.
+  if (m_frame_latency_waitable_object)
+    WaitForSingleObjectEx(m_frame_latency_waitable_object, 1000, TRUE);
+
   static constexpr float clear_color[4] = {0.0f, 0.0f, 0.0f, 1.0f};
   m_context->ClearRenderTargetView(m_swap_chain_rtv.Get(), clear_color);
   m_context->OMSetRenderTargets(1, m_swap_chain_rtv.GetAddressOf(), nullptr);
@@ -652,9 +681,9 @@ void D3D11Device::EndPresent()
   // DirectX has no concept of tear-or-sync. I guess if we measured times ourselves, we could implement it.
   if (m_sync_mode == DisplaySyncMode::VSync || m_sync_mode == DisplaySyncMode::VSyncRelaxed)
     m_swap_chain->Present(BoolToUInt32(1), 0);
-  else if (m_using_allow_tearing) // Disabled or VRR, VRR requires the allow tearing flag :/
+  else if (m_using_allow_tearing && m_sync_mode != DisplaySyncMode::Mailbox) // Disabled or VRR, VRR requires the allow tearing flag :/
     m_swap_chain->Present(0, DXGI_PRESENT_ALLOW_TEARING);
-  else
+  else // Mailbox: a flip-model present with interval 0 and no tearing replaces any queued frame.
     m_swap_chain->Present(0, 0);
 
   if (m_gpu_timing_enabled)
@@ -155,6 +155,7 @@ private:
   ComPtr<IDXGIFactory5> m_dxgi_factory;
   ComPtr<IDXGISwapChain1> m_swap_chain;
   ComPtr<ID3D11RenderTargetView> m_swap_chain_rtv;
+  HANDLE m_frame_latency_waitable_object = {};
 
   RasterizationStateMap m_rasterization_states;
   DepthStateMap m_depth_states;
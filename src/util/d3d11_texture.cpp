@@ -497,6 +497,25 @@ void D3D11DownloadTexture::Flush()
   // Handled when mapped.
 }
 
+bool D3D11DownloadTexture::IsDataReady()
+{
+  if (IsMapped() || !m_needs_flush)
+    return true;
+
+  // D3D11 has no queryable fence here, so a DO_NOT_WAIT map doubles as the readiness poll.
+  D3D11_MAPPED_SUBRESOURCE sr;
+  const HRESULT hr =
+    D3D11Device::GetD3DContext()->Map(m_texture.Get(), 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &sr);
+  if (hr == DXGI_ERROR_WAS_STILL_DRAWING)
+    return false;
+
+  // Any real mapping error gets surfaced by the blocking Map() in ReadTexels().
+  if (SUCCEEDED(hr))
+    D3D11Device::GetD3DContext()->Unmap(m_texture.Get(), 0);
+
+  return true;
+}
+
 void D3D11DownloadTexture::SetDebugName(std::string_view name)
 {
   if (name.empty())
@@ -134,6 +134,7 @@ public:
   void Unmap() override;
 
   void Flush() override;
+  bool IsDataReady() override;
 
   void SetDebugName(std::string_view name) override;
 
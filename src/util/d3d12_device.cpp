@@ -198,6 +198,15 @@ bool D3D12Device::CreateDevice(const std::string_view& adapter, bool threaded_pr
     return false;
   }
 
+  // Presents go through their own queue, fenced against the main queue, so the flip/vblank wait
+  // doesn't serialize next-frame rendering behind it.
+  hr = m_device->CreateCommandQueue(&queue_desc, IID_PPV_ARGS(&m_present_queue));
+  if (FAILED(hr))
+  {
+    Error::SetHResult(error, "Failed to create present queue: ", hr);
+    return false;
+  }
+
   D3D12MA::ALLOCATOR_DESC allocatorDesc = {};
   allocatorDesc.pDevice = m_device.Get();
   allocatorDesc.pAdapter = m_adapter.Get();
@@ -219,6 +228,13 @@ bool D3D12Device::CreateDevice(const std::string_view& adapter, bool threaded_pr
     return false;
   }
 
+  hr = m_device->CreateFence(m_present_fence_value, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_present_fence));
+  if (FAILED(hr))
+  {
+    Error::SetHResult(error, "Failed to create present fence: ", hr);
+    return false;
+  }
+
   m_fence_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
   if (m_fence_event == NULL)
   {
@@ -271,6 +287,7 @@ void D3D12Device::DestroyDevice()
 
   m_pipeline_library.Reset();
   std::vector<u8>().swap(s_pipeline_cache_data);
+  m_present_fence.Reset();
   m_fence.Reset();
   if (m_fence_event != NULL)
   {
@@ -279,6 +296,7 @@ void D3D12Device::DestroyDevice()
   }
 
   m_allocator.Reset();
+  m_present_queue.Reset();
   m_command_queue.Reset();
   m_device.Reset();
   m_adapter.Reset();
@@ -615,6 +633,18 @@ void D3D12Device::WaitForGPUIdle()
     WaitForFence(m_command_lists[index].fence_counter);
     index = (index + 1) % NUM_COMMAND_LISTS;
   }
+
+  WaitForPresentQueueIdle();
+}
+
+void D3D12Device::WaitForPresentQueueIdle()
+{
+  if (!m_present_fence || m_present_fence->GetCompletedValue() >= m_present_fence_value)
+    return;
+
+  const HRESULT hr = m_present_fence->SetEventOnCompletion(m_present_fence_value, m_fence_event);
+  AssertMsg(SUCCEEDED(hr), "Set present fence event on completion");
+  WaitForSingleObject(m_fence_event, INFINITE);
 }
 
 bool D3D12Device::CreateTimestampQuery()
@@ -693,6 +723,72 @@ void D3D12Device::DeferObjectDestruction(ComPtr<ID3D12Object> resource)
                                    std::pair<D3D12MA::Allocation*, ID3D12Object*>(nullptr, resource.Detach()));
 }
 
+bool D3D12Device::AcquireUploadStagingBuffer(u32 size, UploadStagingBuffer* out)
+{
+  const u32 bucket_size = std::max<u32>(Common::NextPow2(size), MIN_UPLOAD_STAGING_BUFFER_SIZE);
+
+  for (auto it = m_upload_staging_pool.begin(); it != m_upload_staging_pool.end(); ++it)
+  {
+    if (it->size != bucket_size || it->fence_value > m_completed_fence_value)
+      continue;
+
+    *out = std::move(*it);
+    m_upload_staging_pool_size -= bucket_size;
+    m_upload_staging_pool.erase(it);
+    return true;
+  }
+
+  const D3D12MA::ALLOCATION_DESC allocation_desc = {D3D12MA::ALLOCATION_FLAG_NONE, D3D12_HEAP_TYPE_UPLOAD,
+                                                    D3D12_HEAP_FLAG_NONE, nullptr, nullptr};
+  const D3D12_RESOURCE_DESC resource_desc = {D3D12_RESOURCE_DIMENSION_BUFFER,
+                                             0,
+                                             bucket_size,
+                                             1,
+                                             1,
+                                             1,
+                                             DXGI_FORMAT_UNKNOWN,
+                                             {1, 0},
+                                             D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
+                                             D3D12_RESOURCE_FLAG_NONE};
+  HRESULT hr =
+    m_allocator->CreateResource(&allocation_desc, &resource_desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+                                out->allocation.ReleaseAndGetAddressOf(), IID_PPV_ARGS(out->resource.GetAddressOf()));
+  if (FAILED(hr))
+  {
+    Log_ErrorPrintf("CreateResource() for %u byte staging buffer failed with %08X", bucket_size, hr);
+    return false;
+  }
+
+  // Upload-heap buffers can stay persistently mapped for their lifetime.
+  hr = out->resource->Map(0, nullptr, &out->map_ptr);
+  if (FAILED(hr))
+  {
+    Log_ErrorPrintf("Map() for %u byte staging buffer failed with %08X", bucket_size, hr);
+    out->resource.Reset();
+    out->allocation.Reset();
+    return false;
+  }
+
+  out->size = bucket_size;
+  out->fence_value = 0;
+  return true;
+}
+
+void D3D12Device::ReleaseUploadStagingBuffer(UploadStagingBuffer buffer)
+{
+  buffer.fence_value = GetCurrentFenceValue();
+
+  // Bound the pool; anything past the cap takes the usual deferred-destruction path.
+  if ((m_upload_staging_pool_size + buffer.size) > MAX_UPLOAD_STAGING_POOL_SIZE)
+  {
+    DeferResourceDestruction(std::move(buffer.allocation), std::move(buffer.resource));
+    return;
+  }
+
+  m_upload_staging_pool_size += buffer.size;
+  m_upload_staging_pool.push_back(std::move(buffer));
+}
+
 void D3D12Device::DeferResourceDestruction(ComPtr<D3D12MA::Allocation> allocation, ComPtr<ID3D12Resource> resource)
 {
   DebugAssert(allocation && resource);
@@ -833,7 +929,7 @@ bool D3D12Device::CreateSwapChain()
     fs_desc.Windowed = FALSE;
 
     Log_VerbosePrintf("Creating a %dx%d exclusive fullscreen swap chain", fs_sd_desc.Width, fs_sd_desc.Height);
-    hr = m_dxgi_factory->CreateSwapChainForHwnd(m_command_queue.Get(), window_hwnd, &fs_sd_desc, &fs_desc,
+    hr = m_dxgi_factory->CreateSwapChainForHwnd(m_present_queue.Get(), window_hwnd, &fs_sd_desc, &fs_desc,
                                                 fullscreen_output.Get(), m_swap_chain.ReleaseAndGetAddressOf());
     if (FAILED(hr))
     {
@@ -846,7 +942,7 @@ bool D3D12Device::CreateSwapChain()
   if (!m_is_exclusive_fullscreen)
   {
     Log_VerbosePrintf("Creating a %dx%d windowed swap chain", swap_chain_desc.Width, swap_chain_desc.Height);
-    hr = m_dxgi_factory->CreateSwapChainForHwnd(m_command_queue.Get(), window_hwnd, &swap_chain_desc, nullptr, nullptr,
+    hr = m_dxgi_factory->CreateSwapChainForHwnd(m_present_queue.Get(), window_hwnd, &swap_chain_desc, nullptr, nullptr,
                                                 m_swap_chain.ReleaseAndGetAddressOf());
   }
 
@@ -920,6 +1016,7 @@ bool D3D12Device::CreateSwapChainRTV()
     }
   }
 
+  m_swap_chain_buffer_present_values.assign(m_swap_chain_buffers.size(), 0);
   m_current_swap_chain_buffer = 0;
   return true;
 }
@@ -930,6 +1027,7 @@ void D3D12Device::DestroySwapChainRTVs()
   if (InRenderPass())
     EndRenderPass();
   SubmitCommandList(true);
+  WaitForPresentQueueIdle();
 
   for (auto it = m_swap_chain_buffers.rbegin(); it != m_swap_chain_buffers.rend(); ++it)
   {
@@ -937,6 +1035,7 @@ void D3D12Device::DestroySwapChainRTVs()
     it->first.Reset();
   }
   m_swap_chain_buffers.clear();
+  m_swap_chain_buffer_present_values.clear();
   m_current_swap_chain_buffer = 0;
 }
 
@@ -961,6 +1060,9 @@ void D3D12Device::RenderBlankFrame()
   if (InRenderPass())
     EndRenderPass();
 
+  WaitForPreviousBackbufferPresent();
+
+  const u32 presented_buffer = m_current_swap_chain_buffer;
   auto& swap_chain_buf = m_swap_chain_buffers[m_current_swap_chain_buffer];
   ID3D12GraphicsCommandList4* cmdlist = GetCommandList();
   m_current_swap_chain_buffer = ((m_current_swap_chain_buffer + 1) % static_cast<u32>(m_swap_chain_buffers.size()));
@@ -969,8 +1071,9 @@ void D3D12Device::RenderBlankFrame()
   cmdlist->ClearRenderTargetView(swap_chain_buf.second, s_present_clear_color.Color, 0, nullptr);
   D3D12Texture::TransitionSubresourceToState(cmdlist, swap_chain_buf.first.Get(), 0, D3D12_RESOURCE_STATE_RENDER_TARGET,
                                              D3D12_RESOURCE_STATE_PRESENT);
+  const u64 submit_fence_value = m_command_lists[m_current_command_list].fence_counter;
   SubmitCommandList(false);
-  m_swap_chain->Present(0, m_using_allow_tearing ? DXGI_PRESENT_ALLOW_TEARING : 0);
+  QueuePresent(presented_buffer, submit_fence_value, 0, m_using_allow_tearing ? DXGI_PRESENT_ALLOW_TEARING : 0);
 }
 
 bool D3D12Device::UpdateWindow()
@@ -1089,6 +1192,9 @@ bool D3D12Device::BeginPresent(bool frame_skip)
     return false;
   }
 
+  // Don't start writing the backbuffer until its previous present has completed.
+  WaitForPreviousBackbufferPresent();
+
   BeginSwapChainRenderPass();
   return true;
 }
@@ -1098,6 +1204,7 @@ void D3D12Device::EndPresent()
   DebugAssert(InRenderPass() && m_num_current_render_targets == 0 && !m_current_depth_target);
   EndRenderPass();
 
+  const u32 presented_buffer = m_current_swap_chain_buffer;
   const auto& swap_chain_buf = m_swap_chain_buffers[m_current_swap_chain_buffer];
   m_current_swap_chain_buffer = ((m_current_swap_chain_buffer + 1) % static_cast<u32>(m_swap_chain_buffers.size()));
 
@@ -1105,19 +1212,46 @@ void D3D12Device::EndPresent()
   D3D12Texture::TransitionSubresourceToState(cmdlist, swap_chain_buf.first.Get(), 0, D3D12_RESOURCE_STATE_RENDER_TARGET,
                                              D3D12_RESOURCE_STATE_PRESENT);
 
+  const u64 submit_fence_value = m_command_lists[m_current_command_list].fence_counter;
   SubmitCommandList(false);
 
   // DirectX has no concept of tear-or-sync. I guess if we measured times ourselves, we could implement it.
   if (m_sync_mode == DisplaySyncMode::VSync || m_sync_mode == DisplaySyncMode::VSyncRelaxed)
-    m_swap_chain->Present(BoolToUInt32(1), 0);
-  else if (m_using_allow_tearing) // Disabled or VRR, VRR requires the allow tearing flag :/
-    m_swap_chain->Present(0, DXGI_PRESENT_ALLOW_TEARING);
-  else
-    m_swap_chain->Present(0, 0);
+    QueuePresent(presented_buffer, submit_fence_value, BoolToUInt32(1), 0);
+  else if (m_using_allow_tearing && m_sync_mode != DisplaySyncMode::Mailbox) // Disabled or VRR, VRR requires the allow tearing flag :/
+    QueuePresent(presented_buffer, submit_fence_value, 0, DXGI_PRESENT_ALLOW_TEARING);
+  else // Mailbox: a flip-model present with interval 0 and no tearing replaces any queued frame.
+    QueuePresent(presented_buffer, submit_fence_value, 0, 0);
 
   TrimTexturePool();
 }
 
+void D3D12Device::QueuePresent(u32 buffer_index, u64 wait_fence_value, UINT sync_interval, UINT flags)
+{
+  // The present executes on its own queue once the main queue has finished rendering the
+  // backbuffer, so any flip/vblank wait happens there instead of stalling next-frame rendering.
+  HRESULT hr = m_present_queue->Wait(m_fence.Get(), wait_fence_value);
+  DebugAssertMsg(SUCCEEDED(hr), "Wait for render fence on present queue");
+
+  m_swap_chain->Present(sync_interval, flags);
+
+  hr = m_present_queue->Signal(m_present_fence.Get(), ++m_present_fence_value);
+  DebugAssertMsg(SUCCEEDED(hr), "Signal present fence");
+  m_swap_chain_buffer_present_values[buffer_index] = m_present_fence_value;
+}
+
+void D3D12Device::WaitForPreviousBackbufferPresent()
+{
+  // GPU-side wait; anything submitted to the main queue after this point won't execute until the
+  // last present of this backbuffer has finished. Rarely blocks with triple buffering.
+  const u64 last_present_value = m_swap_chain_buffer_present_values[m_current_swap_chain_buffer];
+  if (last_present_value == 0 || m_present_fence->GetCompletedValue() >= last_present_value)
+    return;
+
+  const HRESULT hr = m_command_queue->Wait(m_present_fence.Get(), last_present_value);
+  DebugAssertMsg(SUCCEEDED(hr), "Wait for present fence on main queue");
+}
+
 #ifdef _DEBUG
 static UINT64 Palette(float phase, const std::array<float, 3>& a, const std::array<float, 3>& b,
                       const std::array<float, 3>& c, const std::array<float, 3>& d)
@@ -1198,6 +1332,9 @@ void D3D12Device::SetFeatures(FeatureMask disabled_features)
   m_features.pipeline_cache = true;
   m_features.prefer_unused_textures = true;
 
+  // Both CreateGraphicsPipelineState() and the pipeline library are internally synchronized.
+  m_features.threaded_pipeline_creation = true;
+
   BOOL allow_tearing_supported = false;
   HRESULT hr = m_dxgi_factory->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allow_tearing_supported,
                                                    sizeof(allow_tearing_supported));
@@ -1380,6 +1517,9 @@ bool D3D12Device::CreateBuffers()
 
 void D3D12Device::DestroyBuffers()
 {
+  m_upload_staging_pool.clear();
+  m_upload_staging_pool_size = 0;
+
   m_texture_upload_buffer.Destroy(false);
   m_uniform_buffer.Destroy(false);
   m_index_buffer.Destroy(false);
@@ -51,6 +51,10 @@ public:
 
     /// Start/End timestamp queries.
     NUM_TIMESTAMP_QUERIES_PER_CMDLIST = 2,
+
+    /// Minimum bucket size and total cap for the recycled upload staging buffer pool.
+    MIN_UPLOAD_STAGING_BUFFER_SIZE = 1 * 1024 * 1024,
+    MAX_UPLOAD_STAGING_POOL_SIZE = 64 * 1024 * 1024,
   };
 
 public:
@@ -157,6 +161,26 @@ public:
   /// Last "completed" fence.
   u64 GetCompletedFenceValue() const { return m_completed_fence_value; }
 
+  // Mapped upload-heap buffer for uploads which don't fit in the texture stream buffer.
+  // Bucketed by power-of-two size and recycled once the owning fence completes, so
+  // steady-state large uploads (VRAM updates, texture replacements) don't hit the allocator.
+  struct UploadStagingBuffer
+  {
+    ComPtr<D3D12MA::Allocation> allocation;
+    ComPtr<ID3D12Resource> resource;
+    void* map_ptr = nullptr;
+    u32 size = 0;
+    u64 fence_value = 0;
+  };
+
+  /// Returns a mapped staging buffer of at least size bytes, reusing a pooled buffer when the
+  /// GPU has finished with one of the right bucket.
+  bool AcquireUploadStagingBuffer(u32 size, UploadStagingBuffer* out);
+
+  /// Returns the buffer to the pool once the current command list's fence completes. The
+  /// resource stays valid for commands recorded in the current list.
+  void ReleaseUploadStagingBuffer(UploadStagingBuffer buffer);
+
   // Schedule a d3d12 resource for destruction later on. This will occur when the command buffer
   // is next re-used, and the GPU has finished working with the specified resource.
   void DeferObjectDestruction(ComPtr<ID3D12Object> resource);
@@ -239,6 +263,17 @@ private:
   void RenderBlankFrame();
   void MoveToNextCommandList();
 
+  // Hands a present off to the present queue once the main queue has finished rendering the
+  // backbuffer, so the vblank wait doesn't hold up next-frame work on the main queue.
+  void QueuePresent(u32 buffer_index, u64 wait_fence_value, UINT sync_interval, UINT flags);
+
+  // Queues a GPU-side wait on the main queue until the last present of the current backbuffer
+  // has completed, i.e. it is safe to render to it again.
+  void WaitForPreviousBackbufferPresent();
+
+  // Blocks the CPU until all queued presents have executed.
+  void WaitForPresentQueueIdle();
+
   bool CreateSRVDescriptor(ID3D12Resource* resource, u32 layers, u32 levels, u32 samples, DXGI_FORMAT format,
                            D3D12DescriptorHandle* dh);
   bool CreateRTVDescriptor(ID3D12Resource* resource, u32 samples, DXGI_FORMAT format, D3D12DescriptorHandle* dh);
@@ -273,12 +308,15 @@ private:
   ComPtr<IDXGIAdapter1> m_adapter;
   ComPtr<ID3D12Device1> m_device;
   ComPtr<ID3D12CommandQueue> m_command_queue;
+  ComPtr<ID3D12CommandQueue> m_present_queue;
   ComPtr<D3D12MA::Allocator> m_allocator;
 
   ComPtr<ID3D12Fence> m_fence;
+  ComPtr<ID3D12Fence> m_present_fence;
   HANDLE m_fence_event = {};
   u64 m_current_fence_value = 0;
   u64 m_completed_fence_value = 0;
+  u64 m_present_fence_value = 0;
 
   std::array<CommandList, NUM_COMMAND_LISTS> m_command_lists;
   u32 m_current_command_list = NUM_COMMAND_LISTS - 1;
@@ -287,6 +325,7 @@ private:
   ComPtr<IDXGIFactory5> m_dxgi_factory;
   ComPtr<IDXGISwapChain1> m_swap_chain;
   std::vector<std::pair<ComPtr<ID3D12Resource>, D3D12DescriptorHandle>> m_swap_chain_buffers;
+  std::vector<u64> m_swap_chain_buffer_present_values;
   u32 m_current_swap_chain_buffer = 0;
   bool m_allow_tearing_supported = false;
   bool m_using_allow_tearing = false;
@@ -314,6 +353,8 @@ private:
   D3D12StreamBuffer m_index_buffer;
   D3D12StreamBuffer m_uniform_buffer;
   D3D12StreamBuffer m_texture_upload_buffer;
+  std::vector<UploadStagingBuffer> m_upload_staging_pool;
+  u32 m_upload_staging_pool_size = 0;
 
   u32 m_uniform_buffer_position = 0;
   bool m_in_render_pass = false;
@@ -346,41 +346,19 @@ void D3D12Texture::CopyTextureDataForUpload(void* dst, const void* src, u32 widt
 ID3D12Resource* D3D12Texture::AllocateUploadStagingBuffer(const void* data, u32 pitch, u32 upload_pitch, u32 width,
                                                           u32 height) const
 {
+  D3D12Device& dev = D3D12Device::GetInstance();
   const u32 size = upload_pitch * height;
-  ComPtr<ID3D12Resource> resource;
-  ComPtr<D3D12MA::Allocation> allocation;
-
-  const D3D12MA::ALLOCATION_DESC allocation_desc = {D3D12MA::ALLOCATION_FLAG_NONE, D3D12_HEAP_TYPE_UPLOAD,
-                                                    D3D12_HEAP_FLAG_NONE, nullptr, nullptr};
-  const D3D12_RESOURCE_DESC resource_desc = {
-    D3D12_RESOURCE_DIMENSION_BUFFER, 0, size, 1, 1, 1, DXGI_FORMAT_UNKNOWN, {1, 0}, D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
-    D3D12_RESOURCE_FLAG_NONE};
-  HRESULT hr = D3D12Device::GetInstance().GetAllocator()->CreateResource(
-    &allocation_desc, &resource_desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, allocation.GetAddressOf(),
-    IID_PPV_ARGS(resource.GetAddressOf()));
-  if (FAILED(hr))
-  {
-    Log_ErrorPrintf("CreateResource() failed with %08X", hr);
-    return nullptr;
-  }
 
-  void* map_ptr;
-  hr = resource->Map(0, nullptr, &map_ptr);
-  if (FAILED(hr))
-  {
-    Log_ErrorPrintf("Map() failed with %08X", hr);
+  D3D12Device::UploadStagingBuffer sbuf;
+  if (!dev.AcquireUploadStagingBuffer(size, &sbuf))
     return nullptr;
-  }
 
-  CopyTextureDataForUpload(map_ptr, data, width, height, pitch, upload_pitch);
+  CopyTextureDataForUpload(sbuf.map_ptr, data, width, height, pitch, upload_pitch);
 
-  const D3D12_RANGE write_range = {0, size};
-  resource->Unmap(0, &write_range);
-
-  // Immediately queue it for freeing after the command buffer finishes, since it's only needed for the copy.
-  // This adds the reference needed to keep the buffer alive.
-  ID3D12Resource* ret = resource.Get();
-  D3D12Device::GetInstance().DeferResourceDestruction(std::move(allocation), std::move(resource));
+  // Immediately queue it for recycling after the command buffer finishes, since it's only needed for the copy.
+  // The pool holds the reference needed to keep the buffer alive.
+  ID3D12Resource* ret = sbuf.resource.Get();
+  dev.ReleaseUploadStagingBuffer(std::move(sbuf));
   return ret;
 }
 
@@ -989,6 +967,11 @@ void D3D12DownloadTexture::Flush()
     dev.WaitForFence(m_copy_fence_value);
 }
 
+bool D3D12DownloadTexture::IsDataReady()
+{
+  return (!m_needs_flush || D3D12Device::GetInstance().GetCompletedFenceValue() >= m_copy_fence_value);
+}
+
 void D3D12DownloadTexture::SetDebugName(std::string_view name)
 {
   if (name.empty())
@@ -0,0 +1,468 @@
+// SPDX-FileCopyrightText: 2019-2023 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "evdev_input_source.h"
+#include "input_manager.h"
+
+#include "common/log.h"
+#include "common/string_util.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+Log_SetChannel(EvdevInputSource);
+
+static constexpr const char* DEVICE_DIRECTORY = "/dev/input";
+
+static bool TestEventBit(const unsigned long* bits, u32 bit)
+{
+  constexpr u32 BITS_PER_LONG = sizeof(unsigned long) * 8;
+  return ((bits[bit / BITS_PER_LONG] >> (bit % BITS_PER_LONG)) & 1u) != 0;
+}
+
+static GenericInputBinding GetGenericBindingForButton(u16 code)
+{
+  // Linux gamepad spec face button layout, i.e. what xpad and hid-sony report.
+  switch (code)
+  {
+    case BTN_SOUTH:
+      return GenericInputBinding::Cross;
+    case BTN_EAST:
+      return GenericInputBinding::Circle;
+    case BTN_WEST:
+      return GenericInputBinding::Square;
+    case BTN_NORTH:
+      return GenericInputBinding::Triangle;
+    case BTN_TL:
+      return GenericInputBinding::L1;
+    case BTN_TR:
+      return GenericInputBinding::R1;
+    case BTN_TL2:
+      return GenericInputBinding::L2;
+    case BTN_TR2:
+      return GenericInputBinding::R2;
+    case BTN_SELECT:
+      return GenericInputBinding::Select;
+    case BTN_START:
+      return GenericInputBinding::Start;
+    case BTN_MODE:
+      return GenericInputBinding::System;
+    case BTN_THUMBL:
+      return GenericInputBinding::L3;
+    case BTN_THUMBR:
+      return GenericInputBinding::R3;
+    case BTN_DPAD_UP:
+      return GenericInputBinding::DPadUp;
+    case BTN_DPAD_DOWN:
+      return GenericInputBinding::DPadDown;
+    case BTN_DPAD_LEFT:
+      return GenericInputBinding::DPadLeft;
+    case BTN_DPAD_RIGHT:
+      return GenericInputBinding::DPadRight;
+    default:
+      return GenericInputBinding::Unknown;
+  }
+}
+
+EvdevInputSource::EvdevInputSource() = default;
+
+EvdevInputSource::~EvdevInputSource() = default;
+
+std::string EvdevInputSource::GetDeviceIdentifier(u32 node_index)
+{
+  return fmt::format("Evdev-{}", node_index);
+}
+
+bool EvdevInputSource::Initialize(SettingsInterface& si, std::unique_lock<std::mutex>& settings_lock)
+{
+  // Devices can come and go, so a successful init doesn't require any to be present.
+  ReloadDevices();
+  return true;
+}
+
+void EvdevInputSource::UpdateSettings(SettingsInterface& si, std::unique_lock<std::mutex>& settings_lock)
+{
+}
+
+bool EvdevInputSource::ReloadDevices()
+{
+  // detect any removals
+  PollEvents();
+
+  DIR* dir = opendir(DEVICE_DIRECTORY);
+  if (!dir)
+  {
+    Log_ErrorPrintf("opendir(%s) failed: %d", DEVICE_DIRECTORY, errno);
+    return false;
+  }
+
+  bool changed = false;
+  struct dirent* de;
+  while ((de = readdir(dir)))
+  {
+    u32 node_index;
+    if (std::sscanf(de->d_name, "event%u", &node_index) != 1)
+      continue;
+
+    // do we already have this one?
+    if (GetDeviceByNodeIndex(node_index))
+      continue;
+
+    const std::string path = fmt::format("{}/{}", DEVICE_DIRECTORY, de->d_name);
+    changed |= OpenDevice(node_index, path.c_str());
+  }
+
+  closedir(dir);
+  return changed;
+}
+
+void EvdevInputSource::Shutdown()
+{
+  for (DeviceData& dd : m_devices)
+  {
+    InputManager::OnInputDeviceDisconnected(GetDeviceIdentifier(dd.node_index));
+    CloseDevice(dd);
+  }
+  m_devices.clear();
+}
+
+EvdevInputSource::DeviceData* EvdevInputSource::GetDeviceByNodeIndex(u32 node_index)
+{
+  for (DeviceData& dd : m_devices)
+  {
+    if (dd.node_index == node_index)
+      return &dd;
+  }
+
+  return nullptr;
+}
+
+bool EvdevInputSource::OpenDevice(u32 node_index, const char* path)
+{
+  const int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0)
+  {
+    // EACCES is the common case when we're not in the input group, don't spam about it.
+    if (errno != EACCES && errno != ENOENT)
+      Log_WarningPrintf("open(%s) failed: %d", path, errno);
+
+    return false;
+  }
+
+  unsigned long key_bits[(KEY_MAX / (sizeof(unsigned long) * 8)) + 1] = {};
+  unsigned long abs_bits[(ABS_MAX / (sizeof(unsigned long) * 8)) + 1] = {};
+  ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(key_bits)), key_bits);
+  ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(abs_bits)), abs_bits);
+
+  // Only claim devices which look like game controllers. Grabbing the system keyboard or mouse
+  // would steal it from the rest of the system, so anything without joystick/gamepad buttons is
+  // left for the other sources.
+  bool has_gamepad_button = false;
+  for (u32 code = BTN_JOYSTICK; code < BTN_DIGI && !has_gamepad_button; code++)
+    has_gamepad_button = TestEventBit(key_bits, code);
+  if (!has_gamepad_button)
+  {
+    close(fd);
+    return false;
+  }
+
+  DeviceData dd;
+  dd.fd = fd;
+  dd.node_index = node_index;
+
+  char name[128] = {};
+  if (ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name) >= 0)
+    dd.name = name;
+  if (dd.name.empty())
+    dd.name = "Unknown";
+
+  for (u32 code = 0; code <= KEY_MAX; code++)
+  {
+    if (TestEventBit(key_bits, code))
+      dd.button_codes.push_back(static_cast<u16>(code));
+  }
+
+  for (u32 code = 0; code <= ABS_MAX; code++)
+  {
+    if (!TestEventBit(abs_bits, code))
+      continue;
+
+    struct input_absinfo ai = {};
+    if (ioctl(fd, EVIOCGABS(code), &ai) < 0 || ai.maximum <= ai.minimum)
+      continue;
+
+    dd.axes.push_back({static_cast<u16>(code), ai.minimum, ai.maximum - ai.minimum});
+  }
+
+  // Take exclusive access, so events don't get double-handled when another source (e.g. SDL) is
+  // also watching the device. Not fatal if it fails, we just might see duplicates.
+  dd.grabbed = (ioctl(fd, EVIOCGRAB, 1) == 0);
+  if (!dd.grabbed)
+    Log_WarningPrintf("EVIOCGRAB on '%s' (%s) failed: %d", dd.name.c_str(), path, errno);
+
+  Log_InfoPrintf("'%s' (%s) has %zu buttons and %zu axes%s", dd.name.c_str(), path, dd.button_codes.size(),
+                 dd.axes.size(), dd.grabbed ? ", grabbed" : "");
+
+  const std::string name_copy = dd.name;
+  m_devices.push_back(std::move(dd));
+  InputManager::OnInputDeviceConnected(GetDeviceIdentifier(node_index), name_copy);
+  return true;
+}
+
+void EvdevInputSource::CloseDevice(DeviceData& dd)
+{
+  if (dd.fd < 0)
+    return;
+
+  if (dd.grabbed)
+    ioctl(dd.fd, EVIOCGRAB, 0);
+
+  close(dd.fd);
+  dd.fd = -1;
+}
+
+void EvdevInputSource::PollEvents()
+{
+  for (size_t i = 0; i < m_devices.size();)
+  {
+    DeviceData& dd = m_devices[i];
+    if (!ProcessDeviceEvents(dd))
+    {
+      Log_InfoPrintf("Evdev device %u ('%s') removed", dd.node_index, dd.name.c_str());
+      InputManager::OnInputDeviceDisconnected(GetDeviceIdentifier(dd.node_index));
+      CloseDevice(dd);
+      m_devices.erase(m_devices.begin() + i);
+      continue;
+    }
+
+    i++;
+  }
+}
+
+bool EvdevInputSource::ProcessDeviceEvents(DeviceData& dd)
+{
+  for (;;)
+  {
+    struct input_event events[32];
+    const ssize_t nread = read(dd.fd, events, sizeof(events));
+    if (nread < 0)
+    {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        return true;
+
+      // anything else (usually ENODEV) means the device went away
+      return false;
+    }
+
+    const size_t count = static_cast<size_t>(nread) / sizeof(struct input_event);
+    for (size_t i = 0; i < count; i++)
+    {
+      const struct input_event& ev = events[i];
+      if (ev.type == EV_KEY && ev.value != 2) // ignore auto-repeat
+        HandleKeyEvent(dd, ev.code, ev.value);
+      else if (ev.type == EV_ABS)
+        HandleAbsEvent(dd, ev.code, ev.value);
+    }
+  }
+}
+
+void EvdevInputSource::HandleKeyEvent(const DeviceData& dd, u16 code, s32 value)
+{
+  InputManager::InvokeEvents(MakeGenericControllerButtonKey(InputSourceType::Evdev, dd.node_index, code),
+                             (value != 0) ? 1.0f : 0.0f, GetGenericBindingForButton(code));
+}
+
+void EvdevInputSource::HandleAbsEvent(const DeviceData& dd, u16 code, s32 value)
+{
+  for (const AxisRange& ar : dd.axes)
+  {
+    if (ar.code != code)
+      continue;
+
+    // normalize to -1..1, triggers with a zero minimum get bound with FullAxis
+    const float norm =
+      std::clamp((static_cast<float>(value - ar.min_value) / static_cast<float>(ar.range)) * 2.0f - 1.0f, -1.0f, 1.0f);
+    InputManager::InvokeEvents(MakeGenericControllerAxisKey(InputSourceType::Evdev, dd.node_index, code), norm,
+                               GenericInputBinding::Unknown);
+    return;
+  }
+}
+
+std::vector<std::pair<std::string, std::string>> EvdevInputSource::EnumerateDevices()
+{
+  std::vector<std::pair<std::string, std::string>> ret;
+  for (const DeviceData& dd : m_devices)
+    ret.emplace_back(GetDeviceIdentifier(dd.node_index), dd.name);
+
+  return ret;
+}
+
+std::vector<InputBindingKey> EvdevInputSource::EnumerateMotors()
+{
+  // no force feedback support
+  return {};
+}
+
+void EvdevInputSource::UpdateMotorState(InputBindingKey key, float intensity)
+{
+}
+
+bool EvdevInputSource::GetGenericBindingMapping(const std::string_view& device, GenericInputBindingMapping* mapping)
+{
+  if (!device.starts_with("Evdev-"))
+    return false;
+
+  const std::optional<u32> node_index = StringUtil::FromChars<u32>(device.substr(6));
+  if (!node_index.has_value())
+    return false;
+
+  const DeviceData* dd = GetDeviceByNodeIndex(node_index.value());
+  if (!dd)
+    return false;
+
+  for (const u16 code : dd->button_codes)
+  {
+    const GenericInputBinding binding = GetGenericBindingForButton(code);
+    if (binding != GenericInputBinding::Unknown)
+      mapping->emplace_back(binding, fmt::format("Evdev-{}/Button{}", node_index.value(), code));
+  }
+
+  for (const AxisRange& ar : dd->axes)
+  {
+    switch (ar.code)
+    {
+      case ABS_X:
+        mapping->emplace_back(GenericInputBinding::LeftStickLeft, fmt::format("Evdev-{}/-Axis{}", node_index.value(), ar.code));
+        mapping->emplace_back(GenericInputBinding::LeftStickRight, fmt::format("Evdev-{}/+Axis{}", node_index.value(), ar.code));
+        break;
+      case ABS_Y:
+        mapping->emplace_back(GenericInputBinding::LeftStickUp, fmt::format("Evdev-{}/-Axis{}", node_index.value(), ar.code));
+        mapping->emplace_back(GenericInputBinding::LeftStickDown, fmt::format("Evdev-{}/+Axis{}", node_index.value(), ar.code));
+        break;
+      case ABS_RX:
+        mapping->emplace_back(GenericInputBinding::RightStickLeft, fmt::format("Evdev-{}/-Axis{}", node_index.value(), ar.code));
+        mapping->emplace_back(GenericInputBinding::RightStickRight, fmt::format("Evdev-{}/+Axis{}", node_index.value(), ar.code));
+        break;
+      case ABS_RY:
+        mapping->emplace_back(GenericInputBinding::RightStickUp, fmt::format("Evdev-{}/-Axis{}", node_index.value(), ar.code));
+        mapping->emplace_back(GenericInputBinding::RightStickDown, fmt::format("Evdev-{}/+Axis{}", node_index.value(), ar.code));
+        break;
+      case ABS_Z:
+        mapping->emplace_back(GenericInputBinding::L2, fmt::format("Evdev-{}/FullAxis{}", node_index.value(), ar.code));
+        break;
+      case ABS_RZ:
+        mapping->emplace_back(GenericInputBinding::R2, fmt::format("Evdev-{}/FullAxis{}", node_index.value(), ar.code));
+        break;
+      case ABS_HAT0X:
+        mapping->emplace_back(GenericInputBinding::DPadLeft, fmt::format("Evdev-{}/-Axis{}", node_index.value(), ar.code));
+        mapping->emplace_back(GenericInputBinding::DPadRight, fmt::format("Evdev-{}/+Axis{}", node_index.value(), ar.code));
+        break;
+      case ABS_HAT0Y:
+        mapping->emplace_back(GenericInputBinding::DPadUp, fmt::format("Evdev-{}/-Axis{}", node_index.value(), ar.code));
+        mapping->emplace_back(GenericInputBinding::DPadDown, fmt::format("Evdev-{}/+Axis{}", node_index.value(), ar.code));
+        break;
+      default:
+        break;
+    }
+  }
+
+  return true;
+}
+
+std::optional<InputBindingKey> EvdevInputSource::ParseKeyString(const std::string_view& device,
+                                                               const std::string_view& binding)
+{
+  if (!device.starts_with("Evdev-") || binding.empty())
+    return std::nullopt;
+
+  const std::optional<u32> node_index = StringUtil::FromChars<u32>(device.substr(6));
+  if (!node_index.has_value())
+    return std::nullopt;
+
+  InputBindingKey key = {};
+  key.source_type = InputSourceType::Evdev;
+  key.source_index = node_index.value();
+
+  if (binding[0] == '+' || binding[0] == '-')
+  {
+    const std::string_view axis_binding(binding.substr(1));
+    if (!axis_binding.starts_with("Axis"))
+      return std::nullopt;
+
+    const std::optional<u32> axis_code = StringUtil::FromChars<u32>(axis_binding.substr(4));
+    if (!axis_code.has_value())
+      return std::nullopt;
+
+    key.source_subtype = InputSubclass::ControllerAxis;
+    key.data = axis_code.value();
+    key.modifier = (binding[0] == '-') ? InputModifier::Negate : InputModifier::None;
+    return key;
+  }
+  else if (binding.starts_with("FullAxis"))
+  {
+    const std::optional<u32> axis_code = StringUtil::FromChars<u32>(binding.substr(8));
+    if (!axis_code.has_value())
+      return std::nullopt;
+
+    key.source_subtype = InputSubclass::ControllerAxis;
+    key.data = axis_code.value();
+    key.modifier = InputModifier::FullAxis;
+    return key;
+  }
+  else if (binding.starts_with("Button"))
+  {
+    const std::optional<u32> button_code = StringUtil::FromChars<u32>(binding.substr(6));
+    if (!button_code.has_value())
+      return std::nullopt;
+
+    key.source_subtype = InputSubclass::ControllerButton;
+    key.data = button_code.value();
+    return key;
+  }
+
+  // unknown axis/button
+  return std::nullopt;
+}
+
+TinyString EvdevInputSource::ConvertKeyToString(InputBindingKey key)
+{
+  TinyString ret;
+
+  if (key.source_type == InputSourceType::Evdev)
+  {
+    if (key.source_subtype == InputSubclass::ControllerAxis)
+    {
+      if (key.modifier == InputModifier::FullAxis)
+      {
+        ret.format("Evdev-{}/FullAxis{}", static_cast<u32>(key.source_index), key.data);
+      }
+      else
+      {
+        ret.format("Evdev-{}/{}Axis{}", static_cast<u32>(key.source_index),
+                   (key.modifier == InputModifier::Negate) ? '-' : '+', key.data);
+      }
+    }
+    else if (key.source_subtype == InputSubclass::ControllerButton)
+    {
+      ret.format("Evdev-{}/Button{}", static_cast<u32>(key.source_index), key.data);
+    }
+  }
+
+  return ret;
+}
+
+TinyString EvdevInputSource::ConvertKeyToIcon(InputBindingKey key)
+{
+  return {};
+}
+
+std::unique_ptr<InputSource> InputSource::CreateEvdevSource()
+{
+  return std::make_unique<EvdevInputSource>();
+}
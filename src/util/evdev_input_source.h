@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2019-2023 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "input_source.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+class EvdevInputSource final : public InputSource
+{
+public:
+  EvdevInputSource();
+  ~EvdevInputSource() override;
+
+  bool Initialize(SettingsInterface& si, std::unique_lock<std::mutex>& settings_lock) override;
+  void UpdateSettings(SettingsInterface& si, std::unique_lock<std::mutex>& settings_lock) override;
+  bool ReloadDevices() override;
+  void Shutdown() override;
+
+  void PollEvents() override;
+  std::vector<std::pair<std::string, std::string>> EnumerateDevices() override;
+  std::vector<InputBindingKey> EnumerateMotors() override;
+  bool GetGenericBindingMapping(const std::string_view& device, GenericInputBindingMapping* mapping) override;
+  void UpdateMotorState(InputBindingKey key, float intensity) override;
+
+  std::optional<InputBindingKey> ParseKeyString(const std::string_view& device,
+                                                const std::string_view& binding) override;
+  TinyString ConvertKeyToString(InputBindingKey key) override;
+  TinyString ConvertKeyToIcon(InputBindingKey key) override;
+
+private:
+  struct AxisRange
+  {
+    u16 code;
+    s32 min_value;
+    s32 range;
+  };
+
+  struct DeviceData
+  {
+    int fd = -1;
+    u32 node_index = 0;
+    bool grabbed = false;
+    std::string name;
+
+    // Key/axis codes the device reported via EVIOCGBIT. Bindings use the raw evdev codes, so
+    // they stay stable regardless of which other devices are plugged in.
+    std::vector<u16> button_codes;
+    std::vector<AxisRange> axes;
+  };
+
+  static std::string GetDeviceIdentifier(u32 node_index);
+
+  bool OpenDevice(u32 node_index, const char* path);
+  void CloseDevice(DeviceData& dd);
+  DeviceData* GetDeviceByNodeIndex(u32 node_index);
+
+  /// Drains all pending events from the device. Returns false if the device was unplugged.
+  bool ProcessDeviceEvents(DeviceData& dd);
+
+  void HandleKeyEvent(const DeviceData& dd, u16 code, s32 value);
+  void HandleAbsEvent(const DeviceData& dd, u16 code, s32 value);
+
+  std::vector<DeviceData> m_devices;
+};
@@ -585,6 +585,41 @@ void GPUDevice::RenderImGui()
   }
 }
 
+void GPUDevice::RenderCursorLayer(GPUTexture* texture, float left, float top, float right, float bottom, u32 color)
+{
+  GL_SCOPE("RenderCursorLayer");
+
+  SetPipeline(m_imgui_pipeline.get());
+  SetViewportAndScissor(0, 0, m_window_info.surface_width, m_window_info.surface_height);
+
+  const float L = 0.0f;
+  const float R = static_cast<float>(m_window_info.surface_width);
+  const float T = 0.0f;
+  const float B = static_cast<float>(m_window_info.surface_height);
+  const float ortho_projection[4][4] = {
+    {2.0f / (R - L), 0.0f, 0.0f, 0.0f},
+    {0.0f, 2.0f / (T - B), 0.0f, 0.0f},
+    {0.0f, 0.0f, 0.5f, 0.0f},
+    {(R + L) / (L - R), (T + B) / (B - T), 0.5f, 1.0f},
+  };
+  PushUniformBuffer(ortho_projection, sizeof(ortho_projection));
+
+  const ImDrawVert vertices[4] = {
+    {ImVec2(left, top), ImVec2(0.0f, 0.0f), color},
+    {ImVec2(right, top), ImVec2(1.0f, 0.0f), color},
+    {ImVec2(right, bottom), ImVec2(1.0f, 1.0f), color},
+    {ImVec2(left, bottom), ImVec2(0.0f, 1.0f), color},
+  };
+  const DrawIndex indices[6] = {0, 1, 2, 0, 2, 3};
+
+  u32 base_vertex, base_index;
+  UploadVertexBuffer(vertices, sizeof(ImDrawVert), static_cast<u32>(std::size(vertices)), &base_vertex);
+  UploadIndexBuffer(indices, static_cast<u32>(std::size(indices)), &base_index);
+
+  SetTextureSampler(0, texture, m_linear_sampler.get());
+  DrawIndexed(static_cast<u32>(std::size(indices)), base_index, base_vertex);
+}
+
 void GPUDevice::SetSyncMode(DisplaySyncMode mode)
 {
   m_sync_mode = mode;
@@ -973,6 +1008,16 @@ bool GPUDevice::ShouldSkipDisplayingFrame()
   return false;
 }
 
+bool GPUDevice::WouldSkipDisplayingFrame() const
+{
+  if (m_display_frame_interval == 0.0f)
+    return false;
+
+  const u64 now = Common::Timer::GetCurrentValue();
+  const double diff = Common::Timer::ConvertValueToSeconds(now - m_last_frame_displayed_time);
+  return (diff < m_display_frame_interval);
+}
+
 void GPUDevice::ThrottlePresentation()
 {
   const float throttle_rate = (m_window_info.surface_refresh_rate > 0.0f) ? m_window_info.surface_refresh_rate : 60.0f;
@@ -448,6 +448,7 @@ public:
     bool shader_cache : 1;
     bool pipeline_cache : 1;
     bool prefer_unused_textures : 1;
+    bool threaded_pipeline_creation : 1;
   };
 
   struct Statistics
@@ -636,6 +637,12 @@ public:
   /// Renders ImGui screen elements. Call before EndPresent().
   void RenderImGui();
 
+  /// Draws a single textured quad on top of the current render target, using the ImGui pipeline.
+  /// Intended as a late-latched cursor layer: callers sample the pointer position immediately
+  /// before this call, after all other rendering, so crosshairs don't pay a frame's worth of
+  /// latency. Call between RenderImGui() and EndPresent().
+  void RenderCursorLayer(GPUTexture* texture, float left, float top, float right, float bottom, u32 color);
+
   ALWAYS_INLINE DisplaySyncMode GetSyncMode() const { return m_sync_mode; }
   ALWAYS_INLINE bool IsVSyncActive() const
   {
@@ -651,8 +658,13 @@ public:
   static Common::Rectangle<s32> FlipToLowerLeft(const Common::Rectangle<s32>& rc, s32 target_height);
   void SetDisplayMaxFPS(float max_fps);
   bool ShouldSkipDisplayingFrame();
+  bool WouldSkipDisplayingFrame() const;
   void ThrottlePresentation();
 
+  /// Sets the maximum number of frames the host GPU driver is allowed to queue ahead of the
+  /// display. Only has an effect on backends which can enforce it (e.g. Vulkan's present wait).
+  ALWAYS_INLINE void SetMaxQueuedFrames(u32 count) { m_max_queued_frames = count; }
+
   virtual bool SupportsTextureFormat(GPUTexture::Format format) const = 0;
 
   virtual bool GetHostRefreshRate(float* refresh_rate);
@@ -755,6 +767,7 @@ protected:
   static Statistics s_stats;
 
   DisplaySyncMode m_sync_mode = DisplaySyncMode::Disabled;
+  u32 m_max_queued_frames = 2;
   bool m_gpu_timing_enabled = false;
   bool m_debug_device = false;
 };
@@ -6,7 +6,9 @@
 #include "gpu_device.h"
 #include "gpu_texture.h"
 
+#include <algorithm>
 #include <unordered_map>
+#include <utility>
 
 class GPUFramebufferManagerBase
 {
@@ -47,9 +49,34 @@ public:
   void Clear();
 
 private:
-  using MapType = std::unordered_map<Key, FBOType, KeyHash>;
+  struct Entry
+  {
+    FBOType fbo;
+    u64 last_use;
+  };
+
+  using MapType = std::unordered_map<Key, Entry, KeyHash>;
+
+  /// Soft cap on the number of live framebuffer objects. Hitting it evicts the
+  /// least-recently-used entry, so long sessions don't accumulate a framebuffer for every
+  /// texture pairing they ever rendered to.
+  enum : u32
+  {
+    MAX_FRAMEBUFFERS = 128
+  };
+
+  void EvictOneEntry();
 
   MapType m_map;
+
+  // Last two framebuffers handed out, checked before probing the map. Render-target switches
+  // ping-pong between the same pair during downsampling and postprocessing, so this catches
+  // the common case without hashing. Entry pointers are stable until the entry is erased.
+  Key m_mru_keys[2] = {};
+  Entry* m_mru_entries[2] = {};
+  u32 m_mru_count = 0;
+
+  u64 m_use_counter = 0;
 };
 
 template<typename FBOType, FBOType (*FactoryFunc)(GPUTexture* const* rts, u32 num_rts, GPUTexture* ds, u32 flags),
@@ -73,17 +100,72 @@ FBOType GPUFramebufferManager<FBOType, FactoryFunc, DestroyFunc>::Lookup(GPUText
   key.num_rts = num_rts;
   key.flags = flags;
 
+  for (u32 i = 0; i < m_mru_count; i++)
+  {
+    if (m_mru_keys[i] == key)
+    {
+      Entry* const entry = m_mru_entries[i];
+      entry->last_use = ++m_use_counter;
+      if (i != 0)
+      {
+        std::swap(m_mru_keys[0], m_mru_keys[1]);
+        std::swap(m_mru_entries[0], m_mru_entries[1]);
+      }
+      return entry->fbo;
+    }
+  }
+
   auto it = m_map.find(key);
   if (it == m_map.end())
   {
+    if (m_map.size() >= MAX_FRAMEBUFFERS)
+      EvictOneEntry();
+
     FBOType fbo = FactoryFunc(rts, num_rts, ds, flags);
     if (!fbo)
       return fbo;
 
-    it = m_map.emplace(key, fbo).first;
+    it = m_map.emplace(key, Entry{fbo, 0}).first;
   }
 
-  return it->second;
+  Entry& entry = it->second;
+  entry.last_use = ++m_use_counter;
+
+  if (m_mru_count > 0)
+  {
+    m_mru_keys[1] = m_mru_keys[0];
+    m_mru_entries[1] = m_mru_entries[0];
+  }
+  m_mru_keys[0] = key;
+  m_mru_entries[0] = &entry;
+  m_mru_count = std::min(m_mru_count + 1, 2u);
+
+  return entry.fbo;
+}
+
+template<typename FBOType, FBOType (*FactoryFunc)(GPUTexture* const* rts, u32 num_rts, GPUTexture* ds, u32 flags),
+         void (*DestroyFunc)(FBOType fbo)>
+void GPUFramebufferManager<FBOType, FactoryFunc, DestroyFunc>::EvictOneEntry()
+{
+  auto lowest = m_map.end();
+  for (auto it = m_map.begin(); it != m_map.end(); ++it)
+  {
+    // Never evict the MRU entries; on GL the most recent one is the currently-bound FBO.
+    bool in_mru = false;
+    for (u32 i = 0; i < m_mru_count; i++)
+      in_mru |= (m_mru_entries[i] == &it->second);
+    if (in_mru)
+      continue;
+
+    if (lowest == m_map.end() || it->second.last_use < lowest->second.last_use)
+      lowest = it;
+  }
+
+  if (lowest == m_map.end())
+    return;
+
+  DestroyFunc(lowest->second.fbo);
+  m_map.erase(lowest);
 }
 
 template<typename FBOType, FBOType (*FactoryFunc)(GPUTexture* const* rts, u32 num_rts, GPUTexture* ds, u32 flags),
@@ -91,6 +173,7 @@ template<typename FBOType, FBOType (*FactoryFunc)(GPUTexture* const* rts, u32 nu
 void GPUFramebufferManager<FBOType, FactoryFunc, DestroyFunc>::RemoveRTReferences(const GPUTexture* tex)
 {
   DebugAssert(tex->IsRenderTarget());
+  m_mru_count = 0;
   for (auto it = m_map.begin(); it != m_map.end();)
   {
     if (!it->first.ContainsRT(tex))
@@ -99,7 +182,7 @@ void GPUFramebufferManager<FBOType, FactoryFunc, DestroyFunc>::RemoveRTReference
       continue;
     }
 
-    DestroyFunc(it->second);
+    DestroyFunc(it->second.fbo);
     it = m_map.erase(it);
   }
 }
@@ -109,6 +192,7 @@ template<typename FBOType, FBOType (*FactoryFunc)(GPUTexture* const* rts, u32 nu
 void GPUFramebufferManager<FBOType, FactoryFunc, DestroyFunc>::RemoveDSReferences(const GPUTexture* tex)
 {
   DebugAssert(tex->IsDepthStencil());
+  m_mru_count = 0;
   for (auto it = m_map.begin(); it != m_map.end();)
   {
     if (it->first.ds != tex)
@@ -117,7 +201,7 @@ void GPUFramebufferManager<FBOType, FactoryFunc, DestroyFunc>::RemoveDSReference
       continue;
     }
 
-    DestroyFunc(it->second);
+    DestroyFunc(it->second.fbo);
     it = m_map.erase(it);
   }
 }
@@ -137,6 +221,8 @@ template<typename FBOType, FBOType (*FactoryFunc)(GPUTexture* const* rts, u32 nu
 void GPUFramebufferManager<FBOType, FactoryFunc, DestroyFunc>::Clear()
 {
   for (auto it : m_map)
-    DestroyFunc(it.second);
+    DestroyFunc(it.second.fbo);
   m_map.clear();
+  m_mru_count = 0;
+  m_use_counter = 0;
 }
@@ -92,6 +92,8 @@ void GPUShaderCache::Close()
 
 void GPUShaderCache::Clear()
 {
+  std::unique_lock lock(m_mutex);
+
   if (!IsOpen())
     return;
 
@@ -248,6 +250,8 @@ GPUShaderCache::CacheIndexKey GPUShaderCache::GetCacheKey(GPUShaderStage stage,
 
 bool GPUShaderCache::Lookup(const CacheIndexKey& key, ShaderBinary* binary)
 {
+  std::unique_lock lock(m_mutex);
+
   auto iter = m_index.find(key);
   if (iter == m_index.end())
     return false;
@@ -277,6 +281,8 @@ bool GPUShaderCache::Lookup(const CacheIndexKey& key, ShaderBinary* binary)
 
 bool GPUShaderCache::Insert(const CacheIndexKey& key, const void* data, u32 data_size)
 {
+  std::unique_lock lock(m_mutex);
+
   DynamicHeapArray<u8> compress_buffer(ZSTD_compressBound(data_size));
   const size_t compress_result = ZSTD_compress(compress_buffer.data(), compress_buffer.size(), data, data_size, 0);
   if (ZSTD_isError(compress_result))
@@ -7,6 +7,7 @@
 #include "common/heap_array.h"
 #include "common/types.h"
 
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -53,6 +54,7 @@ public:
   static CacheIndexKey GetCacheKey(GPUShaderStage stage, const std::string_view& shader_code,
                                    const std::string_view& entry_point);
 
+  /// Lookup/insert are safe to call concurrently, e.g. from parallel shader compilation.
   bool Lookup(const CacheIndexKey& key, ShaderBinary* binary);
   bool Insert(const CacheIndexKey& key, const void* data, u32 data_size);
   void Clear();
@@ -72,6 +74,9 @@ private:
 
   CacheIndex m_index;
 
+  // Serializes index/blob file access for concurrent Lookup()/Insert() calls.
+  std::mutex m_mutex;
+
   std::string m_base_filename;
   u32 m_version;
 
@@ -6,8 +6,10 @@
 
 #include "common/align.h"
 #include "common/bitutils.h"
+#include "common/intrin.h"
 #include "common/log.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 
 Log_SetChannel(GPUTexture);
 
@@ -230,6 +232,195 @@ bool GPUTexture::ValidateConfig(u32 width, u32 height, u32 layers, u32 levels, u
   return true;
 }
 
+// Runs fn(start_row, end_row) over all rows, fanning slices out across the shared thread pool
+// when the image is large enough that the worker wake-up pays for itself.
+static void ConvertRowsInParallel(u32 width, u32 height, const std::function<void(u32, u32)>& fn)
+{
+  constexpr u32 PARALLEL_CONVERT_PIXELS_THRESHOLD = 1024 * 1024;
+
+  const u32 num_slices = Threading::ThreadPool::GetWorkerCount() + 1;
+  if ((static_cast<u64>(width) * static_cast<u64>(height)) < PARALLEL_CONVERT_PIXELS_THRESHOLD || num_slices <= 1 ||
+      height < num_slices)
+  {
+    fn(0, height);
+    return;
+  }
+
+  const u32 rows_per_slice = (height + num_slices - 1) / num_slices;
+  Threading::ThreadPool::ParallelFor(num_slices, [&fn, rows_per_slice, height](u32 slice) {
+    const u32 start_row = slice * rows_per_slice;
+    fn(start_row, std::min(start_row + rows_per_slice, height));
+  });
+}
+
+// Row kernels for ConvertTextureDataToRGBA8(). Vectorized on SSE2/NEON hosts with a scalar tail
+// for the last few pixels; the low-bit replication matches the scalar versions exactly.
+static void ConvertBGRA8RowToRGBA8(u8* pixels, u32 width)
+{
+  u32 x = 0;
+
+#if defined(CPU_ARCH_SSE)
+  for (; (x + 4) <= width; x += 4)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+    const __m128i ga = _mm_and_si128(v, _mm_set1_epi32(static_cast<s32>(0xFF00FF00u)));
+    const __m128i b = _mm_slli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xFF)), 16);
+    const __m128i r = _mm_and_si128(_mm_srli_epi32(v, 16), _mm_set1_epi32(0xFF));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), _mm_or_si128(ga, _mm_or_si128(b, r)));
+    pixels += sizeof(__m128i);
+  }
+#elif defined(CPU_ARCH_NEON)
+  for (; (x + 4) <= width; x += 4)
+  {
+    const uint32x4_t v = vld1q_u32(reinterpret_cast<const u32*>(pixels));
+    const uint32x4_t ga = vandq_u32(v, vdupq_n_u32(0xFF00FF00u));
+    const uint32x4_t b = vshlq_n_u32(vandq_u32(v, vdupq_n_u32(0xFFu)), 16);
+    const uint32x4_t r = vandq_u32(vshrq_n_u32(v, 16), vdupq_n_u32(0xFFu));
+    vst1q_u32(reinterpret_cast<u32*>(pixels), vorrq_u32(ga, vorrq_u32(b, r)));
+    pixels += sizeof(uint32x4_t);
+  }
+#endif
+
+  for (; x < width; x++)
+  {
+    u32 pixel;
+    std::memcpy(&pixel, pixels, sizeof(pixel));
+    pixel = (pixel & 0xFF00FF00) | ((pixel & 0xFF) << 16) | ((pixel >> 16) & 0xFF);
+    std::memcpy(pixels, &pixel, sizeof(pixel));
+    pixels += sizeof(pixel);
+  }
+}
+
+static void ConvertRGB565RowToRGBA8(const u8* pixels_in, u8* pixels_out, u32 width)
+{
+  u32 x = 0;
+
+#if defined(CPU_ARCH_SSE)
+  // Expands four zero-extended 565 texels in the low 16 bits of each lane.
+  const auto expand = [](const __m128i p) {
+    const __m128i r5 = _mm_srli_epi32(p, 11);
+    const __m128i g6 = _mm_and_si128(_mm_srli_epi32(p, 5), _mm_set1_epi32(0x3F));
+    const __m128i b5 = _mm_and_si128(p, _mm_set1_epi32(0x1F));
+    const __m128i r8 = _mm_or_si128(_mm_slli_epi32(r5, 3), _mm_and_si128(r5, _mm_set1_epi32(7)));
+    const __m128i g8 = _mm_or_si128(_mm_slli_epi32(g6, 2), _mm_and_si128(g6, _mm_set1_epi32(3)));
+    const __m128i b8 = _mm_or_si128(_mm_slli_epi32(b5, 3), _mm_and_si128(b5, _mm_set1_epi32(7)));
+    return _mm_or_si128(_mm_or_si128(r8, _mm_slli_epi32(g8, 8)),
+                        _mm_or_si128(_mm_slli_epi32(b8, 16), _mm_set1_epi32(static_cast<s32>(0xFF000000u))));
+  };
+
+  for (; (x + 8) <= width; x += 8)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels_in));
+    const __m128i zero = _mm_setzero_si128();
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels_out), expand(_mm_unpacklo_epi16(v, zero)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels_out + sizeof(__m128i)), expand(_mm_unpackhi_epi16(v, zero)));
+    pixels_in += sizeof(__m128i);
+    pixels_out += sizeof(__m128i) * 2;
+  }
+#elif defined(CPU_ARCH_NEON)
+  const auto expand = [](const uint32x4_t p) {
+    const uint32x4_t r5 = vshrq_n_u32(p, 11);
+    const uint32x4_t g6 = vandq_u32(vshrq_n_u32(p, 5), vdupq_n_u32(0x3F));
+    const uint32x4_t b5 = vandq_u32(p, vdupq_n_u32(0x1F));
+    const uint32x4_t r8 = vorrq_u32(vshlq_n_u32(r5, 3), vandq_u32(r5, vdupq_n_u32(7)));
+    const uint32x4_t g8 = vorrq_u32(vshlq_n_u32(g6, 2), vandq_u32(g6, vdupq_n_u32(3)));
+    const uint32x4_t b8 = vorrq_u32(vshlq_n_u32(b5, 3), vandq_u32(b5, vdupq_n_u32(7)));
+    return vorrq_u32(vorrq_u32(r8, vshlq_n_u32(g8, 8)), vorrq_u32(vshlq_n_u32(b8, 16), vdupq_n_u32(0xFF000000u)));
+  };
+
+  for (; (x + 8) <= width; x += 8)
+  {
+    const uint16x8_t v = vld1q_u16(reinterpret_cast<const u16*>(pixels_in));
+    vst1q_u32(reinterpret_cast<u32*>(pixels_out), expand(vmovl_u16(vget_low_u16(v))));
+    vst1q_u32(reinterpret_cast<u32*>(pixels_out + sizeof(uint32x4_t)), expand(vmovl_u16(vget_high_u16(v))));
+    pixels_in += sizeof(uint16x8_t);
+    pixels_out += sizeof(uint32x4_t) * 2;
+  }
+#endif
+
+  for (; x < width; x++)
+  {
+    // RGB565 -> RGBA8
+    u16 pixel_in;
+    std::memcpy(&pixel_in, pixels_in, sizeof(u16));
+    pixels_in += sizeof(u16);
+    const u8 r5 = Truncate8(pixel_in >> 11);
+    const u8 g6 = Truncate8((pixel_in >> 5) & 0x3F);
+    const u8 b5 = Truncate8(pixel_in & 0x1F);
+    const u32 rgba8 = ZeroExtend32((r5 << 3) | (r5 & 7)) | (ZeroExtend32((g6 << 2) | (g6 & 3)) << 8) |
+                      (ZeroExtend32((b5 << 3) | (b5 & 7)) << 16) | (0xFF000000u);
+    std::memcpy(pixels_out, &rgba8, sizeof(u32));
+    pixels_out += sizeof(u32);
+  }
+}
+
+static void ConvertRGBA5551RowToRGBA8(const u8* pixels_in, u8* pixels_out, u32 width)
+{
+  u32 x = 0;
+
+#if defined(CPU_ARCH_SSE)
+  const auto expand = [](const __m128i p) {
+    const __m128i a1 = _mm_and_si128(p, _mm_set1_epi32(0x8000));
+    const __m128i r5 = _mm_and_si128(_mm_srli_epi32(p, 10), _mm_set1_epi32(0x1F));
+    const __m128i g5 = _mm_and_si128(_mm_srli_epi32(p, 5), _mm_set1_epi32(0x1F));
+    const __m128i b5 = _mm_and_si128(p, _mm_set1_epi32(0x1F));
+    const __m128i r8 = _mm_or_si128(_mm_slli_epi32(r5, 3), _mm_and_si128(r5, _mm_set1_epi32(7)));
+    const __m128i g8 = _mm_or_si128(_mm_slli_epi32(g5, 3), _mm_and_si128(g5, _mm_set1_epi32(7)));
+    const __m128i b8 = _mm_or_si128(_mm_slli_epi32(b5, 3), _mm_and_si128(b5, _mm_set1_epi32(7)));
+    const __m128i a8 = _mm_and_si128(_mm_cmpeq_epi32(a1, _mm_set1_epi32(0x8000)),
+                                     _mm_set1_epi32(static_cast<s32>(0xFF000000u)));
+    return _mm_or_si128(_mm_or_si128(r8, _mm_slli_epi32(g8, 8)), _mm_or_si128(_mm_slli_epi32(b8, 16), a8));
+  };
+
+  for (; (x + 8) <= width; x += 8)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels_in));
+    const __m128i zero = _mm_setzero_si128();
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels_out), expand(_mm_unpacklo_epi16(v, zero)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels_out + sizeof(__m128i)), expand(_mm_unpackhi_epi16(v, zero)));
+    pixels_in += sizeof(__m128i);
+    pixels_out += sizeof(__m128i) * 2;
+  }
+#elif defined(CPU_ARCH_NEON)
+  const auto expand = [](const uint32x4_t p) {
+    const uint32x4_t r5 = vandq_u32(vshrq_n_u32(p, 10), vdupq_n_u32(0x1F));
+    const uint32x4_t g5 = vandq_u32(vshrq_n_u32(p, 5), vdupq_n_u32(0x1F));
+    const uint32x4_t b5 = vandq_u32(p, vdupq_n_u32(0x1F));
+    const uint32x4_t r8 = vorrq_u32(vshlq_n_u32(r5, 3), vandq_u32(r5, vdupq_n_u32(7)));
+    const uint32x4_t g8 = vorrq_u32(vshlq_n_u32(g5, 3), vandq_u32(g5, vdupq_n_u32(7)));
+    const uint32x4_t b8 = vorrq_u32(vshlq_n_u32(b5, 3), vandq_u32(b5, vdupq_n_u32(7)));
+    const uint32x4_t a8 =
+      vandq_u32(vceqq_u32(vandq_u32(p, vdupq_n_u32(0x8000)), vdupq_n_u32(0x8000)), vdupq_n_u32(0xFF000000u));
+    return vorrq_u32(vorrq_u32(r8, vshlq_n_u32(g8, 8)), vorrq_u32(vshlq_n_u32(b8, 16), a8));
+  };
+
+  for (; (x + 8) <= width; x += 8)
+  {
+    const uint16x8_t v = vld1q_u16(reinterpret_cast<const u16*>(pixels_in));
+    vst1q_u32(reinterpret_cast<u32*>(pixels_out), expand(vmovl_u16(vget_low_u16(v))));
+    vst1q_u32(reinterpret_cast<u32*>(pixels_out + sizeof(uint32x4_t)), expand(vmovl_u16(vget_high_u16(v))));
+    pixels_in += sizeof(uint16x8_t);
+    pixels_out += sizeof(uint32x4_t) * 2;
+  }
+#endif
+
+  for (; x < width; x++)
+  {
+    // RGBA5551 -> RGBA8
+    u16 pixel_in;
+    std::memcpy(&pixel_in, pixels_in, sizeof(u16));
+    pixels_in += sizeof(u16);
+    const u8 a1 = Truncate8(pixel_in >> 15);
+    const u8 r5 = Truncate8((pixel_in >> 10) & 0x1F);
+    const u8 g6 = Truncate8((pixel_in >> 5) & 0x1F);
+    const u8 b5 = Truncate8(pixel_in & 0x1F);
+    const u32 rgba8 = ZeroExtend32((r5 << 3) | (r5 & 7)) | (ZeroExtend32((g6 << 3) | (g6 & 7)) << 8) |
+                      (ZeroExtend32((b5 << 3) | (b5 & 7)) << 16) | (a1 ? 0xFF000000u : 0u);
+    std::memcpy(pixels_out, &rgba8, sizeof(u32));
+    pixels_out += sizeof(u32);
+  }
+}
+
 bool GPUTexture::ConvertTextureDataToRGBA8(u32 width, u32 height, std::vector<u32>& texture_data,
                                            u32& texture_data_stride, GPUTexture::Format format)
 {
@@ -237,18 +428,10 @@ bool GPUTexture::ConvertTextureDataToRGBA8(u32 width, u32 height, std::vector<u3
   {
     case Format::BGRA8:
     {
-      for (u32 y = 0; y < height; y++)
-      {
-        u8* pixels = reinterpret_cast<u8*>(texture_data.data()) + (y * texture_data_stride);
-        for (u32 x = 0; x < width; x++)
-        {
-          u32 pixel;
-          std::memcpy(&pixel, pixels, sizeof(pixel));
-          pixel = (pixel & 0xFF00FF00) | ((pixel & 0xFF) << 16) | ((pixel >> 16) & 0xFF);
-          std::memcpy(pixels, &pixel, sizeof(pixel));
-          pixels += sizeof(pixel);
-        }
-      }
+      ConvertRowsInParallel(width, height, [&texture_data, texture_data_stride, width](u32 start_row, u32 end_row) {
+        for (u32 y = start_row; y < end_row; y++)
+          ConvertBGRA8RowToRGBA8(reinterpret_cast<u8*>(texture_data.data()) + (y * texture_data_stride), width);
+      });
 
       return true;
     }
@@ -260,26 +443,16 @@ bool GPUTexture::ConvertTextureDataToRGBA8(u32 width, u32 height, std::vector<u3
     {
       std::vector<u32> temp(width * height);
 
-      for (u32 y = 0; y < height; y++)
-      {
-        const u8* pixels_in = reinterpret_cast<const u8*>(texture_data.data()) + (y * texture_data_stride);
-        u8* pixels_out = reinterpret_cast<u8*>(temp.data()) + (y * width * sizeof(u32));
-
-        for (u32 x = 0; x < width; x++)
-        {
-          // RGB565 -> RGBA8
-          u16 pixel_in;
-          std::memcpy(&pixel_in, pixels_in, sizeof(u16));
-          pixels_in += sizeof(u16);
-          const u8 r5 = Truncate8(pixel_in >> 11);
-          const u8 g6 = Truncate8((pixel_in >> 5) & 0x3F);
-          const u8 b5 = Truncate8(pixel_in & 0x1F);
-          const u32 rgba8 = ZeroExtend32((r5 << 3) | (r5 & 7)) | (ZeroExtend32((g6 << 2) | (g6 & 3)) << 8) |
-                            (ZeroExtend32((b5 << 3) | (b5 & 7)) << 16) | (0xFF000000u);
-          std::memcpy(pixels_out, &rgba8, sizeof(u32));
-          pixels_out += sizeof(u32);
-        }
-      }
+      ConvertRowsInParallel(width, height,
+                            [&texture_data, &temp, texture_data_stride, width](u32 start_row, u32 end_row) {
+                              for (u32 y = start_row; y < end_row; y++)
+                              {
+                                ConvertRGB565RowToRGBA8(reinterpret_cast<const u8*>(texture_data.data()) +
+                                                          (y * texture_data_stride),
+                                                        reinterpret_cast<u8*>(temp.data()) + (y * width * sizeof(u32)),
+                                                        width);
+                              }
+                            });
 
       texture_data = std::move(temp);
       texture_data_stride = sizeof(u32) * width;
@@ -290,27 +463,17 @@ bool GPUTexture::ConvertTextureDataToRGBA8(u32 width, u32 height, std::vector<u3
     {
       std::vector<u32> temp(width * height);
 
-      for (u32 y = 0; y < height; y++)
-      {
-        const u8* pixels_in = reinterpret_cast<const u8*>(texture_data.data()) + (y * texture_data_stride);
-        u8* pixels_out = reinterpret_cast<u8*>(temp.data()) + (y * width * sizeof(u32));
-
-        for (u32 x = 0; x < width; x++)
-        {
-          // RGBA5551 -> RGBA8
-          u16 pixel_in;
-          std::memcpy(&pixel_in, pixels_in, sizeof(u16));
-          pixels_in += sizeof(u16);
-          const u8 a1 = Truncate8(pixel_in >> 15);
-          const u8 r5 = Truncate8((pixel_in >> 10) & 0x1F);
-          const u8 g6 = Truncate8((pixel_in >> 5) & 0x1F);
-          const u8 b5 = Truncate8(pixel_in & 0x1F);
-          const u32 rgba8 = ZeroExtend32((r5 << 3) | (r5 & 7)) | (ZeroExtend32((g6 << 3) | (g6 & 7)) << 8) |
-                            (ZeroExtend32((b5 << 3) | (b5 & 7)) << 16) | (a1 ? 0xFF000000u : 0u);
-          std::memcpy(pixels_out, &rgba8, sizeof(u32));
-          pixels_out += sizeof(u32);
-        }
-      }
+      ConvertRowsInParallel(width, height,
+                            [&texture_data, &temp, texture_data_stride, width](u32 start_row, u32 end_row) {
+                              for (u32 y = start_row; y < end_row; y++)
+                              {
+                                ConvertRGBA5551RowToRGBA8(reinterpret_cast<const u8*>(texture_data.data()) +
+                                                            (y * texture_data_stride),
+                                                          reinterpret_cast<u8*>(temp.data()) +
+                                                            (y * width * sizeof(u32)),
+                                                          width);
+                              }
+                            });
 
       texture_data = std::move(temp);
       texture_data_stride = sizeof(u32) * width;
@@ -219,6 +219,10 @@ public:
   /// call to CopyFromTexture() and the Flush() call.
   virtual void Flush() = 0;
 
+  /// Returns true if the GPU has completed any copy queued by CopyFromTexture(), i.e. a
+  /// Map()/ReadTexels() call will not stall. Intended for polling asynchronous readbacks.
+  virtual bool IsDataReady() = 0;
+
   /// Sets object name that will be displayed in graphics debuggers.
   virtual void SetDebugName(std::string_view name) = 0;
 
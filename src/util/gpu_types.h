@@ -19,6 +19,7 @@ enum class DisplaySyncMode : u8
   Disabled,
   VSync,
   VSyncRelaxed,
+  Mailbox,
   VRR,
   Count
 };
@@ -12,7 +12,7 @@
 Log_SetChannel(HTTPDownloader);
 
 static constexpr float DEFAULT_TIMEOUT_IN_SECONDS = 30;
-static constexpr u32 DEFAULT_MAX_ACTIVE_REQUESTS = 4;
+static constexpr u32 DEFAULT_MAX_ACTIVE_REQUESTS = 16;
 
 const char HTTPDownloader::DEFAULT_USER_AGENT[] =
   "Mozilla/5.0 (Windows NT 10.0; Win64; x64; rv:85.0) Gecko/20100101 Firefox/85.0";
@@ -55,6 +55,28 @@ void HTTPDownloader::CreateRequest(std::string url, Request::Callback callback,
   LockedAddRequest(req);
 }
 
+void HTTPDownloader::CreateStreamingRequest(std::string url, Request::Callback callback,
+                                            Request::ChunkCallback chunk_callback, ProgressCallback* progress)
+{
+  Request* req = InternalCreateRequest();
+  req->parent = this;
+  req->type = Request::Type::Get;
+  req->url = std::move(url);
+  req->callback = std::move(callback);
+  req->chunk_callback = std::move(chunk_callback);
+  req->progress = progress;
+  req->start_time = Common::Timer::GetCurrentValue();
+
+  std::unique_lock<std::mutex> lock(m_pending_http_request_lock);
+  if (LockedGetActiveRequestCount() < m_max_active_requests)
+  {
+    if (!StartRequest(req))
+      return;
+  }
+
+  LockedAddRequest(req);
+}
+
 void HTTPDownloader::CreatePostRequest(std::string url, std::string post_data, Request::Callback callback,
                                        ProgressCallback* progress)
 {
@@ -102,6 +124,18 @@ void HTTPDownloader::LockedPollRequests(std::unique_lock<std::mutex>& lock)
         current_time >= req->start_time &&
         Common::Timer::ConvertValueToSeconds(current_time - req->start_time) >= m_timeout)
     {
+      // try to pick up a stalled download where it left off before giving up on it
+      if (req->type == Request::Type::Get && !req->data.empty() && req->resumes_remaining > 0 && ResumeRequest(req))
+      {
+        Log_WarningFmt("Request for '{}' stalled after {} bytes, resuming with a range request", req->url,
+                       req->data.size());
+        req->resumes_remaining--;
+        req->start_time = current_time;
+        unstarted_requests++;
+        index++;
+        continue;
+      }
+
       // request timed out
       Log_ErrorFmt("Request for '{}' timed out", req->url);
 
@@ -208,6 +242,11 @@ void HTTPDownloader::WaitForAllRequests()
   }
 }
 
+bool HTTPDownloader::ResumeRequest(Request* request)
+{
+  return false;
+}
+
 void HTTPDownloader::LockedAddRequest(Request* request)
 {
   m_pending_http_requests.push_back(request);
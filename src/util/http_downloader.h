@@ -31,6 +31,18 @@ public:
     using Data = std::vector<u8>;
     using Callback = std::function<void(s32 status_code, const std::string& content_type, Data data)>;
 
+    /// Invoked as response data arrives, ahead of the final callback, so the caller can process the
+    /// body incrementally (hashing, spooling to disk). Like progress updates, this can fire on a
+    /// worker thread depending on the backend. When restarted is set, everything delivered so far
+    /// must be discarded; a stalled transfer was restarted from the beginning of the resource.
+    using ChunkCallback = std::function<void(const void* data, size_t size, bool restarted)>;
+
+    enum : u32
+    {
+      // Number of times a stalled GET with partial data is resumed with a range request before failing.
+      MAX_TRANSFER_RESUMES = 2,
+    };
+
     enum class Type
     {
       Get,
@@ -48,6 +60,7 @@ public:
 
     HTTPDownloader* parent;
     Callback callback;
+    ChunkCallback chunk_callback;
     ProgressCallback* progress;
     std::string url;
     std::string post_data;
@@ -57,6 +70,8 @@ public:
     s32 status_code = 0;
     u32 content_length = 0;
     u32 last_progress_update = 0;
+    u32 resume_offset = 0;
+    u32 resumes_remaining = MAX_TRANSFER_RESUMES;
     Type type = Type::Get;
     std::atomic<State> state{State::Pending};
   };
@@ -73,6 +88,13 @@ public:
   void SetMaxActiveRequests(u32 max_active_requests);
 
   void CreateRequest(std::string url, Request::Callback callback, ProgressCallback* progress = nullptr);
+
+  /// Variant which streams the body to chunk_callback as it is received. The complete body is
+  /// still accumulated and handed to the final callback, since ranged resumes of stalled
+  /// transfers pick up from it.
+  void CreateStreamingRequest(std::string url, Request::Callback callback, Request::ChunkCallback chunk_callback,
+                              ProgressCallback* progress = nullptr);
+
   void CreatePostRequest(std::string url, std::string post_data, Request::Callback callback,
                          ProgressCallback* progress = nullptr);
   void PollRequests();
@@ -88,6 +110,10 @@ protected:
   virtual bool StartRequest(Request* request) = 0;
   virtual void CloseRequest(Request* request) = 0;
 
+  /// Prepares a stalled request for a ranged restart, continuing from the data received so far.
+  /// Returns false if the backend cannot resume the request, in which case it fails as a timeout.
+  virtual bool ResumeRequest(Request* request);
+
   void LockedAddRequest(Request* request);
   u32 LockedGetActiveRequestCount();
   void LockedPollRequests(std::unique_lock<std::mutex>& lock);
@@ -15,12 +15,18 @@
 
 Log_SetChannel(HTTPDownloader);
 
+// Number of idle connections/easy handles kept around for reuse between requests.
+static constexpr u32 MAX_CACHED_CONNECTIONS = 16;
+
 HTTPDownloaderCurl::HTTPDownloaderCurl() : HTTPDownloader()
 {
 }
 
 HTTPDownloaderCurl::~HTTPDownloaderCurl()
 {
+  for (CURL* handle : m_free_handles)
+    curl_easy_cleanup(handle);
+
   if (m_multi_handle)
     curl_multi_cleanup(m_multi_handle);
 }
@@ -65,6 +71,11 @@ bool HTTPDownloaderCurl::Initialize(std::string user_agent)
     return false;
   }
 
+  // Keep finished connections alive for reuse instead of closing them with the transfer, and
+  // multiplex concurrent requests over a single connection when the server speaks HTTP/2.
+  curl_multi_setopt(m_multi_handle, CURLMOPT_MAXCONNECTS, static_cast<long>(MAX_CACHED_CONNECTIONS));
+  curl_multi_setopt(m_multi_handle, CURLMOPT_PIPELINING, static_cast<long>(CURLPIPE_MULTIPLEX));
+
   m_user_agent = std::move(user_agent);
   return true;
 }
@@ -72,6 +83,20 @@ bool HTTPDownloaderCurl::Initialize(std::string user_agent)
 size_t HTTPDownloaderCurl::WriteCallback(char* ptr, size_t size, size_t nmemb, void* userdata)
 {
   Request* req = static_cast<Request*>(userdata);
+
+  // If the server ignored our range request and is sending the whole thing again, throw away the
+  // partial data from the stalled transfer rather than duplicating it.
+  bool restarted = false;
+  if (req->resume_offset > 0 && req->data.size() == req->resume_offset)
+  {
+    long response_code = 0;
+    if (curl_easy_getinfo(req->handle, CURLINFO_RESPONSE_CODE, &response_code) == CURLE_OK && response_code != 206)
+    {
+      req->data.clear();
+      restarted = true;
+    }
+  }
+
   const size_t current_size = req->data.size();
   const size_t transfer_size = size * nmemb;
   const size_t new_size = current_size + transfer_size;
@@ -79,6 +104,9 @@ size_t HTTPDownloaderCurl::WriteCallback(char* ptr, size_t size, size_t nmemb, v
   req->start_time = Common::Timer::GetCurrentValue();
   std::memcpy(&req->data[current_size], ptr, transfer_size);
 
+  if (req->chunk_callback)
+    req->chunk_callback(ptr, transfer_size, restarted);
+
   if (req->content_length == 0)
   {
     curl_off_t length;
@@ -89,10 +117,40 @@ size_t HTTPDownloaderCurl::WriteCallback(char* ptr, size_t size, size_t nmemb, v
   return nmemb;
 }
 
+CURL* HTTPDownloaderCurl::GetEasyHandle()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_free_handles_mutex);
+    if (!m_free_handles.empty())
+    {
+      CURL* handle = m_free_handles.back();
+      m_free_handles.pop_back();
+      return handle;
+    }
+  }
+
+  return curl_easy_init();
+}
+
+void HTTPDownloaderCurl::ReleaseEasyHandle(CURL* handle)
+{
+  curl_easy_reset(handle);
+
+  std::unique_lock<std::mutex> lock(m_free_handles_mutex);
+  if (m_free_handles.size() < MAX_CACHED_CONNECTIONS)
+  {
+    m_free_handles.push_back(handle);
+    return;
+  }
+
+  lock.unlock();
+  curl_easy_cleanup(handle);
+}
+
 HTTPDownloader::Request* HTTPDownloaderCurl::InternalCreateRequest()
 {
   Request* req = new Request();
-  req->handle = curl_easy_init();
+  req->handle = GetEasyHandle();
   if (!req->handle)
   {
     delete req;
@@ -144,6 +202,10 @@ void HTTPDownloaderCurl::InternalPollRequests()
       curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &response_code);
       req->status_code = static_cast<s32>(response_code);
 
+      // a ranged continuation of a stalled transfer is a success as far as the caller cares
+      if (req->resume_offset > 0 && req->status_code == 206)
+        req->status_code = HTTP_STATUS_OK;
+
       char* content_type = nullptr;
       if (curl_easy_getinfo(req->handle, CURLINFO_CONTENT_TYPE, &content_type) == CURLE_OK && content_type)
         req->content_type = content_type;
@@ -172,6 +234,11 @@ bool HTTPDownloaderCurl::StartRequest(HTTPDownloader::Request* request)
   curl_easy_setopt(req->handle, CURLOPT_NOSIGNAL, 1L);
   curl_easy_setopt(req->handle, CURLOPT_PRIVATE, req);
   curl_easy_setopt(req->handle, CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(req->handle, CURLOPT_TCP_KEEPALIVE, 1L);
+  curl_easy_setopt(req->handle, CURLOPT_PIPEWAIT, 1L);
+
+  if (req->resume_offset > 0)
+    curl_easy_setopt(req->handle, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(req->resume_offset));
 
   if (request->type == Request::Type::Post)
   {
@@ -188,7 +255,7 @@ bool HTTPDownloaderCurl::StartRequest(HTTPDownloader::Request* request)
   {
     Log_ErrorFmt("curl_multi_add_handle() returned {}", static_cast<int>(err));
     req->callback(HTTP_STATUS_ERROR, std::string(), req->data);
-    curl_easy_cleanup(req->handle);
+    ReleaseEasyHandle(req->handle);
     delete req;
     return false;
   }
@@ -201,6 +268,24 @@ void HTTPDownloaderCurl::CloseRequest(HTTPDownloader::Request* request)
   Request* req = static_cast<Request*>(request);
   DebugAssert(req->handle);
   curl_multi_remove_handle(m_multi_handle, req->handle);
-  curl_easy_cleanup(req->handle);
+  ReleaseEasyHandle(req->handle);
   delete req;
 }
+
+bool HTTPDownloaderCurl::ResumeRequest(HTTPDownloader::Request* request)
+{
+  Request* req = static_cast<Request*>(request);
+  DebugAssert(req->handle);
+
+  const CURLMcode err = curl_multi_remove_handle(m_multi_handle, req->handle);
+  if (err != CURLM_OK)
+  {
+    Log_ErrorFmt("curl_multi_remove_handle() returned {}", static_cast<int>(err));
+    return false;
+  }
+
+  // restarted by the usual pending-request path, picking up from what we already have
+  req->resume_offset = static_cast<u32>(req->data.size());
+  req->state.store(Request::State::Pending, std::memory_order_release);
+  return true;
+}
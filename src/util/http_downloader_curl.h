@@ -22,6 +22,7 @@ protected:
   void InternalPollRequests() override;
   bool StartRequest(HTTPDownloader::Request* request) override;
   void CloseRequest(HTTPDownloader::Request* request) override;
+  bool ResumeRequest(HTTPDownloader::Request* request) override;
 
 private:
   struct Request : HTTPDownloader::Request
@@ -31,6 +32,13 @@ private:
 
   static size_t WriteCallback(char* ptr, size_t size, size_t nmemb, void* userdata);
 
+  CURL* GetEasyHandle();
+  void ReleaseEasyHandle(CURL* handle);
+
   CURLM* m_multi_handle = nullptr;
   std::string m_user_agent;
+
+  // Completed easy handles are reset and kept for reuse, instead of being recreated per request.
+  std::mutex m_free_handles_mutex;
+  std::vector<CURL*> m_free_handles;
 };
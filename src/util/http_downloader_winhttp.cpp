@@ -194,6 +194,9 @@ void CALLBACK HTTPDownloaderWinHttp::HTTPStatusCallback(HINTERNET hRequest, DWOR
       req->data.resize(new_size);
       req->start_time = Common::Timer::GetCurrentValue();
 
+      if (req->chunk_callback && dwStatusInformationLength > 0)
+        req->chunk_callback(req->data.data() + req->io_position, dwStatusInformationLength, false);
+
       if (!WinHttpQueryDataAvailable(hRequest, nullptr) && GetLastError() != ERROR_IO_PENDING)
       {
         Log_ErrorPrintf("WinHttpQueryDataAvailable() failed: %u", GetLastError());
@@ -13,6 +13,7 @@
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/lru_cache.h"
+#include "common/memory_budget.h"
 #include "common/path.h"
 #include "common/string_util.h"
 #include "common/threading.h"
@@ -45,6 +46,7 @@ static constexpr float MENU_BACKGROUND_ANIMATION_TIME = 0.5f;
 static std::optional<RGBA8Image> LoadTextureImage(const char* path);
 static std::shared_ptr<GPUTexture> UploadTexture(const char* path, const RGBA8Image& image);
 static void TextureLoaderThread();
+static void EvictTextureCacheOverBudget();
 
 static void DrawFileSelector();
 static void DrawChoiceDialog();
@@ -90,6 +92,10 @@ static u32 s_close_button_state = 0;
 static bool s_focus_reset_queued = false;
 static bool s_light_theme = false;
 
+// Cover images can be arbitrarily large, so the texture cache is bounded by decoded size as well
+// as entry count. When the budget is exceeded, the least-recently-drawn textures are dropped and
+// reloaded through the async path if they scroll back into view.
+static constexpr std::size_t MAX_TEXTURE_CACHE_MEMORY = 64 * 1024 * 1024;
 static LRUCache<std::string, std::shared_ptr<GPUTexture>> s_texture_cache(128, true);
 static std::shared_ptr<GPUTexture> s_placeholder_texture;
 static std::atomic_bool s_texture_load_thread_quit{false};
@@ -241,6 +247,7 @@ void ImGuiFullscreen::Shutdown()
   g_large_font = nullptr;
 
   s_texture_cache.Clear();
+  MemoryBudget::SetUsage(MemoryBudget::Component::CoverCache, 0);
 
   s_notifications.clear();
   s_background_progress_dialogs.clear();
@@ -357,6 +364,38 @@ bool ImGuiFullscreen::InvalidateCachedTexture(const std::string& path)
   return s_texture_cache.Remove(path);
 }
 
+void ImGuiFullscreen::EvictTextureCacheOverBudget()
+{
+  // Pending loads share s_placeholder_texture, so only count each real texture once.
+  const auto get_texture_size = [](const std::shared_ptr<GPUTexture>& tex) -> std::size_t {
+    if (!tex || tex == s_placeholder_texture)
+      return 0;
+    return static_cast<std::size_t>(tex->GetWidth()) * tex->GetHeight() * tex->GetPixelSize();
+  };
+
+  std::size_t usage = 0;
+  s_texture_cache.ForEachItem(
+    [&usage, &get_texture_size](const std::shared_ptr<GPUTexture>& tex) { usage += get_texture_size(tex); });
+
+  // Covers are the cheapest thing to re-create, so under global memory pressure halve the local
+  // cap instead of waiting for the budget to recover on its own. GPU textures can only be released
+  // on this thread, which is why this per-frame safe point stands in for a reclaim handler.
+  const std::size_t cap =
+    MemoryBudget::IsOverBudget() ? (MAX_TEXTURE_CACHE_MEMORY / 2) : MAX_TEXTURE_CACHE_MEMORY;
+  if (usage > cap)
+  {
+    s_texture_cache.EvictWhile([&usage, &get_texture_size, cap](const std::shared_ptr<GPUTexture>& tex) {
+      if (usage <= cap)
+        return false;
+
+      usage -= get_texture_size(tex);
+      return true;
+    });
+  }
+
+  MemoryBudget::SetUsage(MemoryBudget::Component::CoverCache, usage);
+}
+
 void ImGuiFullscreen::UploadAsyncTextures()
 {
   std::unique_lock lock(s_texture_load_mutex);
@@ -475,6 +514,7 @@ void ImGuiFullscreen::BeginLayout()
   // we evict from the texture cache at the start of the frame, in case we go over mid-frame,
   // we need to keep all those textures alive until the end of the frame
   s_texture_cache.ManualEvict();
+  EvictTextureCacheOverBudget();
   PushResetLayout();
 }
 
@@ -2642,7 +2682,8 @@ void ImGuiFullscreen::DrawNotifications(ImVec2& position, float spacing)
     const ImVec2 badge_max(badge_min.x + badge_size, badge_min.y + badge_size);
     if (!notif.badge_path.empty())
     {
-      GPUTexture* tex = GetCachedTexture(notif.badge_path.c_str());
+      // Badges come off disk (or the network cache), don't decode them on the render thread.
+      GPUTexture* tex = GetCachedTextureAsync(notif.badge_path.c_str());
       if (tex)
       {
         dl->AddImage(tex, badge_min, badge_max, ImVec2(0.0f, 0.0f), ImVec2(1.0f, 1.0f),
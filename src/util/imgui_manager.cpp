@@ -24,6 +24,7 @@
 #include <atomic>
 #include <chrono>
 #include <cmath>
+#include <cstring>
 #include <deque>
 #include <mutex>
 #include <unordered_map>
@@ -55,6 +56,13 @@ struct OSDMessage
   float last_y;
 };
 
+struct CachedDrawList
+{
+  std::unique_ptr<ImDrawList> draw_list;
+  u64 version = 0;
+  bool valid = false;
+};
+
 } // namespace
 
 static void UpdateScale();
@@ -65,6 +73,7 @@ static bool AddImGuiFonts(bool fullscreen_fonts);
 static ImFont* AddTextFont(float size);
 static ImFont* AddFixedFont(float size);
 static bool AddIconFonts(float size);
+static void AppendCachedDrawList(const ImDrawList* src, ImDrawList* dst);
 static void AcquirePendingOSDMessages(Common::Timer::Value current_time);
 static void DrawOSDMessages(Common::Timer::Value current_time);
 static void CreateSoftwareCursorTextures();
@@ -108,6 +117,9 @@ static std::mutex s_osd_messages_lock;
 static bool s_show_osd_messages = true;
 static bool s_scale_changed = false;
 
+// retained draw lists for overlays which rarely change, see Begin/EndCachedDrawList()
+static std::unordered_map<u32, CachedDrawList> s_cached_draw_lists;
+
 static std::array<ImGuiManager::SoftwareCursor, InputManager::MAX_SOFTWARE_CURSORS> s_software_cursors = {};
 } // namespace ImGuiManager
 
@@ -212,6 +224,8 @@ void ImGuiManager::Shutdown()
 {
   DestroySoftwareCursorTextures();
 
+  s_cached_draw_lists.clear();
+
   if (ImGui::GetCurrentContext())
     ImGui::DestroyContext();
 
@@ -271,6 +285,9 @@ void ImGuiManager::UpdateScale()
 
   if (!g_gpu_device->UpdateImGuiFontTexture())
     Panic("Failed to recreate font texture after scale+resize");
+
+  // retained vertices reference the old atlas texture/UVs
+  InvalidateCachedDrawLists();
 }
 
 void ImGuiManager::NewFrame()
@@ -293,6 +310,84 @@ void ImGuiManager::NewFrame()
   s_imgui_wants_mouse.store(io.WantCaptureMouse, std::memory_order_release);
 }
 
+ImDrawList* ImGuiManager::BeginCachedDrawList(u32 id, u64 version)
+{
+  CachedDrawList& entry = s_cached_draw_lists[id];
+  if (entry.valid && entry.version == version)
+  {
+    AppendCachedDrawList(entry.draw_list.get(), ImGui::GetBackgroundDrawList());
+    return nullptr;
+  }
+
+  if (!entry.draw_list)
+    entry.draw_list = std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData());
+
+  ImDrawList* const dl = entry.draw_list.get();
+  dl->_ResetForNewFrame();
+  dl->PushTextureID(ImGui::GetIO().Fonts->TexID);
+  dl->PushClipRectFullScreen();
+  entry.version = version;
+  entry.valid = false;
+  return dl;
+}
+
+void ImGuiManager::EndCachedDrawList(u32 id)
+{
+  const auto iter = s_cached_draw_lists.find(id);
+  DebugAssert(iter != s_cached_draw_lists.end() && iter->second.draw_list);
+
+  CachedDrawList& entry = iter->second;
+  ImDrawList* const dl = entry.draw_list.get();
+  dl->PopClipRect();
+  dl->PopTextureID();
+  entry.valid = true;
+  AppendCachedDrawList(dl, ImGui::GetBackgroundDrawList());
+}
+
+void ImGuiManager::InvalidateCachedDrawLists()
+{
+  for (auto& [id, entry] : s_cached_draw_lists)
+    entry.valid = false;
+}
+
+void ImGuiManager::AppendCachedDrawList(const ImDrawList* src, ImDrawList* dst)
+{
+  const int num_vertices = src->VtxBuffer.Size;
+  const int num_indices = src->IdxBuffer.Size;
+  if (num_indices == 0)
+    return;
+
+  // Everything in a cached list uses the font atlas and one clip rect, so it all lands in a single
+  // command, and re-submitting it is a reserve and two buffer copies. PrimReserve() takes care of
+  // starting a new command with the correct VtxOffset if the destination crosses 64K vertices.
+  const ImDrawCmd* cmd = nullptr;
+  for (const ImDrawCmd& it : src->CmdBuffer)
+  {
+    if (it.ElemCount == 0)
+      continue;
+
+    DebugAssert(!cmd && it.VtxOffset == 0);
+    cmd = &it;
+  }
+  if (!cmd)
+    return;
+
+  dst->PushClipRect(ImVec2(cmd->ClipRect.x, cmd->ClipRect.y), ImVec2(cmd->ClipRect.z, cmd->ClipRect.w));
+  dst->PushTextureID(cmd->TextureId);
+  dst->PrimReserve(num_indices, num_vertices);
+  std::memcpy(dst->_VtxWritePtr, src->VtxBuffer.Data, sizeof(ImDrawVert) * static_cast<u32>(num_vertices));
+
+  const ImDrawIdx base_vertex = static_cast<ImDrawIdx>(dst->_VtxCurrentIdx);
+  for (int i = 0; i < num_indices; i++)
+    dst->_IdxWritePtr[i] = static_cast<ImDrawIdx>(src->IdxBuffer.Data[i] + base_vertex);
+
+  dst->_VtxWritePtr += num_vertices;
+  dst->_IdxWritePtr += num_indices;
+  dst->_VtxCurrentIdx += static_cast<u32>(num_vertices);
+  dst->PopTextureID();
+  dst->PopClipRect();
+}
+
 void ImGuiManager::SetStyle()
 {
   ImGuiStyle& style = ImGui::GetStyle();
@@ -1065,13 +1160,10 @@ void ImGuiManager::DrawSoftwareCursor(const SoftwareCursor& sc, const std::pair<
   if (!sc.texture)
     return;
 
-  const ImVec2 min(pos.first - sc.extent_x, pos.second - sc.extent_y);
-  const ImVec2 max(pos.first + sc.extent_x, pos.second + sc.extent_y);
-
-  ImDrawList* dl = ImGui::GetForegroundDrawList();
-
-  dl->AddImage(reinterpret_cast<ImTextureID>(sc.texture.get()), min, max, ImVec2(0.0f, 0.0f), ImVec2(1.0f, 1.0f),
-               sc.color);
+  // Composited directly into the swap chain instead of the ImGui draw list, so the position
+  // sampled above is the one that hits the screen, not the one from the start of the frame.
+  g_gpu_device->RenderCursorLayer(sc.texture.get(), pos.first - sc.extent_x, pos.second - sc.extent_y,
+                                  pos.first + sc.extent_x, pos.second + sc.extent_y, sc.color);
 }
 
 void ImGuiManager::RenderSoftwareCursors()
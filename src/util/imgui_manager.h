@@ -9,6 +9,7 @@
 
 class Error;
 
+struct ImDrawList;
 struct ImFont;
 
 union InputBindingKey;
@@ -46,6 +47,16 @@ void NewFrame();
 /// Renders any on-screen display elements.
 void RenderOSDMessages();
 
+/// Begins recording the cached overlay draw list identified by id. Returns nullptr when the cached
+/// contents for version are still valid, in which case they have already been re-submitted to the
+/// background draw list. Otherwise, record into the returned draw list and call EndCachedDrawList()
+/// afterwards. Cached lists may only reference the font atlas texture and a single clip rect.
+ImDrawList* BeginCachedDrawList(u32 id, u64 version);
+void EndCachedDrawList(u32 id);
+
+/// Drops all cached overlay draw lists, forcing them to be rebuilt on the next draw.
+void InvalidateCachedDrawLists();
+
 /// Returns the scale of all on-screen elements.
 float GetGlobalScale();
 
@@ -104,7 +115,9 @@ void ClearSoftwareCursor(u32 index);
 /// Sets the position of a software cursor, used when we have relative coordinates such as controllers.
 void SetSoftwareCursorPosition(u32 index, float pos_x, float pos_y);
 
-/// Adds software cursors to ImGui render list.
+/// Composites software cursors into the swap chain, sampling pointer positions at call time.
+/// Call between GPUDevice::RenderImGui() and EndPresent(), so crosshairs are latched as late as
+/// possible rather than carrying the latency of the whole frame.
 void RenderSoftwareCursors();
 } // namespace ImGuiManager
 
@@ -59,11 +59,30 @@ bool INISettingsInterface::Load()
   SI_Error err = SI_FAIL;
   auto fp = FileSystem::OpenManagedCFile(m_filename.c_str(), "rb");
   if (fp)
+  {
     err = m_ini.LoadFile(fp.get());
+    if (err == SI_OK)
+    {
+      FILESYSTEM_STAT_DATA sd;
+      m_file_modified_time = FileSystem::StatFile(fp.get(), &sd) ? sd.ModificationTime : 0;
+    }
+  }
 
   return (err == SI_OK);
 }
 
+bool INISettingsInterface::IsFileModified() const
+{
+  if (m_filename.empty())
+    return false;
+
+  FILESYSTEM_STAT_DATA sd;
+  if (!FileSystem::StatFile(m_filename.c_str(), &sd))
+    return true;
+
+  return (sd.ModificationTime != m_file_modified_time);
+}
+
 bool INISettingsInterface::Save()
 {
   if (m_filename.empty())
@@ -97,6 +116,11 @@ bool INISettingsInterface::Save()
     return false;
   }
 
+  {
+    FILESYSTEM_STAT_DATA sd;
+    m_file_modified_time = FileSystem::StatFile(m_filename.c_str(), &sd) ? sd.ModificationTime : 0;
+  }
+
   m_dirty = false;
   return true;
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 #include "common/settings_interface.h"
+#include <ctime>
 
 // being a pain here...
 #ifdef _WIN32
@@ -21,6 +22,10 @@ public:
   bool Load();
   bool Save() override;
 
+  /// Returns true when the file on disk has been modified since the last successful Load() or
+  /// Save(), i.e. the parsed values may be stale and a reload is required.
+  bool IsFileModified() const;
+
   void Clear() override;
 
   bool GetIntValue(const char* section, const char* key, s32* value) const override;
@@ -59,5 +64,6 @@ public:
 private:
   std::string m_filename;
   CSimpleIniA m_ini;
+  std::time_t m_file_modified_time = 0;
   bool m_dirty = false;
 };
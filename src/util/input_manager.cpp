@@ -7,6 +7,7 @@
 #include "common/log.h"
 #include "common/path.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 #include "common/timer.h"
 #include "core/controller.h"
 #include "core/host.h"
@@ -18,12 +19,18 @@
 
 #include "fmt/core.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <cstring>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -92,6 +99,35 @@ struct MacroButton
   bool trigger_state;       ///< Whether the macro button is active.
 };
 
+// ------------------------------------------------------------------------
+// Cross-Thread Event Queue
+// ------------------------------------------------------------------------
+// Bounded lock-free ring for events raised off the emulation thread (e.g. host window input on
+// the UI thread). Producers claim a slot when its sequence equals the write position, and publish
+// it by storing sequence = position + 1. The single consumer (PollSources()) releases a slot for
+// reuse by storing sequence = position + queue size.
+
+struct QueuedInputEvent
+{
+  std::atomic<u32> sequence{0};
+  InputBindingKey key;
+  GenericInputBinding generic_key;
+  float value;
+};
+
+struct InputEventQueue
+{
+  static constexpr u32 SIZE = 256; // must be a power of two
+
+  InputEventQueue()
+  {
+    for (u32 i = 0; i < SIZE; i++)
+      events[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  std::array<QueuedInputEvent, SIZE> events;
+};
+
 } // namespace
 
 // ------------------------------------------------------------------------
@@ -116,11 +152,17 @@ static void AddHotkeyBindings(SettingsInterface& si);
 static void AddPadBindings(SettingsInterface& si, const std::string& section, u32 pad,
                            const Controller::ControllerInfo* cinfo);
 static void UpdateContinuedVibration();
+static void DispatchPadVibrationIntensity(u32 pad_index, float large_or_single_motor_intensity,
+                                          float small_motor_intensity);
+static void WakeVibrationThread(bool state_changed, bool continued_update);
+static void StopVibrationThread();
+static void VibrationThreadProc();
 static void GenerateRelativeMouseEvents();
 
 static bool DoEventHook(InputBindingKey key, float value);
 static bool PreprocessEvent(InputBindingKey key, float value, GenericInputBinding generic_key);
 static bool ProcessEvent(InputBindingKey key, float value, bool skip_button_handlers);
+static void DrainQueuedEvents();
 
 static void LoadMacroButtonConfig(SettingsInterface& si, const std::string& section, u32 pad,
                                   const Controller::ControllerInfo* cinfo);
@@ -135,13 +177,68 @@ static void UpdateInputSourceState(SettingsInterface& si, std::unique_lock<std::
 // Local Variables
 // ------------------------------------------------------------------------
 
-// This is a multimap containing any binds related to the specified key.
-using BindingMap = std::unordered_multimap<InputBindingKey, std::shared_ptr<InputBinding>, InputBindingKeyHash>;
+// Flat dispatch table for binds. Entries are sorted by masked key, with all bindings for the
+// same key adjacent, so per-event lookup is a binary search over contiguous memory rather than
+// hash-map node walks. The table is only rebuilt when bindings change, which is rare.
+using BindingMap = std::vector<std::pair<InputBindingKey, std::shared_ptr<InputBinding>>>;
 using VibrationBindingArray = std::vector<PadVibrationBinding>;
+
+struct BindingLookupLess
+{
+  bool operator()(const BindingMap::value_type& lhs, const InputBindingKey& rhs) const
+  {
+    return lhs.first.bits < rhs.bits;
+  }
+  bool operator()(const InputBindingKey& lhs, const BindingMap::value_type& rhs) const
+  {
+    return lhs.bits < rhs.first.bits;
+  }
+};
+
 static BindingMap s_binding_map;
 static VibrationBindingArray s_pad_vibration_array;
 static std::mutex s_binding_map_write_lock;
 
+// Vibration dispatch thread state. Host motor updates (SDL/XInput) can block for milliseconds on
+// Bluetooth controllers, so the emulation thread only latches the most recent intensities into
+// the slots below; a low-priority worker issues the actual updates at a capped rate, and bursts
+// of redundant writes collapse into one. The worker is started lazily and is always stopped
+// before the binding array or the sources are torn down, so it is the only thread touching the
+// sources' motor state while it runs.
+static constexpr u32 MAX_VIBRATION_PADS = 8;
+static constexpr u32 VIBRATION_DISPATCH_INTERVAL_MS = 10;
+static std::array<std::atomic<u64>, MAX_VIBRATION_PADS> s_latched_vibration_state;
+static std::atomic<bool> s_vibration_state_dirty{false};
+static std::thread s_vibration_thread;
+static std::mutex s_vibration_thread_mutex;
+static std::condition_variable s_vibration_thread_wake;
+static bool s_vibration_thread_shutdown = false;
+static bool s_vibration_continued_pending = false;
+
+ALWAYS_INLINE static u64 PackVibrationState(float large_or_single_motor_intensity, float small_motor_intensity)
+{
+  u32 large_bits, small_bits;
+  std::memcpy(&large_bits, &large_or_single_motor_intensity, sizeof(large_bits));
+  std::memcpy(&small_bits, &small_motor_intensity, sizeof(small_bits));
+  return (static_cast<u64>(small_bits) << 32) | static_cast<u64>(large_bits);
+}
+
+ALWAYS_INLINE static void UnpackVibrationState(u64 value, float* large_or_single_motor_intensity,
+                                               float* small_motor_intensity)
+{
+  const u32 large_bits = static_cast<u32>(value);
+  const u32 small_bits = static_cast<u32>(value >> 32);
+  std::memcpy(large_or_single_motor_intensity, &large_bits, sizeof(large_bits));
+  std::memcpy(small_motor_intensity, &small_bits, sizeof(small_bits));
+}
+
+/// Returns the range of dispatch-table entries for the given masked key.
+ALWAYS_INLINE static std::pair<BindingMap::const_iterator, BindingMap::const_iterator>
+GetBindingsForKey(InputBindingKey masked_key)
+{
+  return std::equal_range(s_binding_map.begin(), s_binding_map.end(), masked_key, BindingLookupLess());
+}
+
 // Hooks/intercepting (for setting bindings)
 static std::mutex m_event_intercept_mutex;
 static InputInterceptHook::Callback m_event_intercept_callback;
@@ -185,6 +282,10 @@ static std::array<float, static_cast<u8>(InputPointerAxis::Count)> s_pointer_axi
 using PointerMoveCallback = std::function<void(InputBindingKey key, float value)>;
 static std::vector<std::pair<u32, PointerMoveCallback>> s_pointer_move_callbacks;
 
+static InputEventQueue s_event_queue;
+static std::atomic<u32> s_event_queue_write_pos{0};
+static u32 s_event_queue_read_pos = 0; // only accessed by the consumer
+
 // ------------------------------------------------------------------------
 // Binding Parsing
 // ------------------------------------------------------------------------
@@ -523,9 +624,13 @@ void InputManager::AddBinding(const std::string_view& binding, const InputEventH
   if (!ibinding)
     return;
 
-  // plop it in the input map for all the keys
+  // plop it in the dispatch table for all the keys, keeping it sorted
   for (u32 i = 0; i < ibinding->num_keys; i++)
-    s_binding_map.emplace(ibinding->keys[i].MaskDirection(), ibinding);
+  {
+    const InputBindingKey masked_key = ibinding->keys[i].MaskDirection();
+    const auto pos = std::upper_bound(s_binding_map.begin(), s_binding_map.end(), masked_key, BindingLookupLess());
+    s_binding_map.emplace(pos, masked_key, ibinding);
+  }
 }
 
 void InputManager::AddVibrationBinding(u32 pad_index, const InputBindingKey* motor_0_binding,
@@ -602,6 +707,9 @@ static std::array<const char*, static_cast<u32>(InputSourceType::Count)> s_input
   "XInput",
   "RawInput",
 #endif
+#ifdef ENABLE_EVDEV
+  "Evdev",
+#endif
 #ifdef ENABLE_SDL2
   "SDL",
 #endif
@@ -638,6 +746,12 @@ bool InputManager::GetInputSourceDefaultEnabled(InputSourceType type)
       return false;
 #endif
 
+#ifdef ENABLE_EVDEV
+    // Off by default, SDL is the usual path and grabbing devices away from it would be rude.
+    case InputSourceType::Evdev:
+      return false;
+#endif
+
 #ifdef ENABLE_SDL2
     case InputSourceType::SDL:
       return true;
@@ -931,7 +1045,7 @@ void InputManager::AddPadBindings(SettingsInterface& si, const std::string& sect
 bool InputManager::HasAnyBindingsForKey(InputBindingKey key)
 {
   std::unique_lock lock(s_binding_map_write_lock);
-  return (s_binding_map.find(key.MaskDirection()) != s_binding_map.end());
+  return std::binary_search(s_binding_map.begin(), s_binding_map.end(), key.MaskDirection(), BindingLookupLess());
 }
 
 bool InputManager::HasAnyBindingsForSource(InputBindingKey key)
@@ -965,12 +1079,63 @@ bool InputManager::InvokeEvents(InputBindingKey key, float value, GenericInputBi
   return ProcessEvent(key, value, skip_button_handlers);
 }
 
+void InputManager::QueueEvent(InputBindingKey key, float value, GenericInputBinding generic_key)
+{
+  u32 pos = s_event_queue_write_pos.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    QueuedInputEvent& ev = s_event_queue.events[pos % InputEventQueue::SIZE];
+    const u32 seq = ev.sequence.load(std::memory_order_acquire);
+    const s32 diff = static_cast<s32>(seq - pos);
+    if (diff == 0)
+    {
+      if (s_event_queue_write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        ev.key = key;
+        ev.value = value;
+        ev.generic_key = generic_key;
+        ev.sequence.store(pos + 1, std::memory_order_release);
+        return;
+      }
+    }
+    else if (diff < 0)
+    {
+      // More than SIZE events between polls means the emulation thread has stalled; don't make
+      // the producer thread wait on it as well.
+      Log_WarningPrintf("Input event queue overflow, dropping event.");
+      return;
+    }
+    else
+    {
+      pos = s_event_queue_write_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void InputManager::DrainQueuedEvents()
+{
+  for (;;)
+  {
+    QueuedInputEvent& ev = s_event_queue.events[s_event_queue_read_pos % InputEventQueue::SIZE];
+    if (ev.sequence.load(std::memory_order_acquire) != (s_event_queue_read_pos + 1))
+      break;
+
+    const InputBindingKey key = ev.key;
+    const GenericInputBinding generic_key = ev.generic_key;
+    const float value = ev.value;
+    ev.sequence.store(s_event_queue_read_pos + InputEventQueue::SIZE, std::memory_order_release);
+    s_event_queue_read_pos++;
+
+    InvokeEvents(key, value, generic_key);
+  }
+}
+
 bool InputManager::ProcessEvent(InputBindingKey key, float value, bool skip_button_handlers)
 {
   // find all the bindings associated with this key
   const InputBindingKey masked_key = key.MaskDirection();
-  const auto range = s_binding_map.equal_range(masked_key);
-  if (range.first == s_binding_map.end())
+  const auto range = GetBindingsForKey(masked_key);
+  if (range.first == range.second)
     return false;
 
   // Now we can actually fire/activate bindings.
@@ -1040,7 +1205,7 @@ bool InputManager::ProcessEvent(InputBindingKey key, float value, bool skip_butt
           // they could still activate and take precedence over us, so we leave them alone.
           for (u32 j = 0; j < binding->num_keys; j++)
           {
-            const auto range2 = s_binding_map.equal_range(binding->keys[j].MaskDirection());
+            const auto range2 = GetBindingsForKey(binding->keys[j].MaskDirection());
             for (auto it2 = range2.first; it2 != range2.second; ++it2)
             {
               InputBinding* other_binding = it2->second.get();
@@ -1461,6 +1626,22 @@ void InputManager::OnInputDeviceDisconnected(const std::string_view& identifier)
 
 void InputManager::SetPadVibrationIntensity(u32 pad_index, float large_or_single_motor_intensity,
                                             float small_motor_intensity)
+{
+  // Latch and hand off to the dispatch thread; the actual motor updates can block for
+  // milliseconds on Bluetooth controllers, which is a frame drop if done here. Redundant values
+  // are dropped now, and intermediate ones by the capped dispatch rate.
+  if (pad_index >= MAX_VIBRATION_PADS || s_pad_vibration_array.empty())
+    return;
+
+  const u64 packed_state = PackVibrationState(large_or_single_motor_intensity, small_motor_intensity);
+  if (s_latched_vibration_state[pad_index].exchange(packed_state, std::memory_order_acq_rel) == packed_state)
+    return;
+
+  WakeVibrationThread(true, false);
+}
+
+void InputManager::DispatchPadVibrationIntensity(u32 pad_index, float large_or_single_motor_intensity,
+                                                 float small_motor_intensity)
 {
   for (PadVibrationBinding& pad : s_pad_vibration_array)
   {
@@ -1510,8 +1691,89 @@ void InputManager::SetPadVibrationIntensity(u32 pad_index, float large_or_single
   }
 }
 
+void InputManager::WakeVibrationThread(bool state_changed, bool continued_update)
+{
+  {
+    std::unique_lock lock(s_vibration_thread_mutex);
+    if (state_changed)
+      s_vibration_state_dirty.store(true, std::memory_order_relaxed);
+    if (continued_update)
+      s_vibration_continued_pending = true;
+
+    // Started lazily; PauseVibration() stops it, and the next update (or continued-effect tick
+    // after unpausing) brings it back.
+    if (!s_vibration_thread.joinable())
+    {
+      s_vibration_thread_shutdown = false;
+      s_vibration_thread = std::thread(&InputManager::VibrationThreadProc);
+    }
+  }
+
+  s_vibration_thread_wake.notify_one();
+}
+
+void InputManager::StopVibrationThread()
+{
+  // Start/stop both only happen on the emulation thread, so joinable() can't change under us.
+  {
+    std::unique_lock lock(s_vibration_thread_mutex);
+    if (!s_vibration_thread.joinable())
+      return;
+
+    s_vibration_thread_shutdown = true;
+  }
+
+  s_vibration_thread_wake.notify_one();
+  s_vibration_thread.join();
+  s_vibration_thread = {};
+}
+
+void InputManager::VibrationThreadProc()
+{
+  Threading::SetNameOfCurrentThread("Vibration Dispatch");
+  Threading::SetBackgroundHintForCurrentThread();
+
+  std::unique_lock lock(s_vibration_thread_mutex);
+  while (!s_vibration_thread_shutdown)
+  {
+    s_vibration_thread_wake.wait(lock, []() {
+      return (s_vibration_thread_shutdown || s_vibration_state_dirty.load(std::memory_order_relaxed) ||
+              s_vibration_continued_pending);
+    });
+    if (s_vibration_thread_shutdown)
+      break;
+
+    const bool continued_update = std::exchange(s_vibration_continued_pending, false);
+    lock.unlock();
+
+    // Dispatch the most recently latched state. Anything the emulation thread writes while a
+    // blocking update below is in flight just overwrites its slot and gets picked up next round.
+    if (s_vibration_state_dirty.exchange(false, std::memory_order_acq_rel))
+    {
+      for (u32 pad_index = 0; pad_index < MAX_VIBRATION_PADS; pad_index++)
+      {
+        float large_or_single_motor_intensity, small_motor_intensity;
+        UnpackVibrationState(s_latched_vibration_state[pad_index].load(std::memory_order_acquire),
+                             &large_or_single_motor_intensity, &small_motor_intensity);
+        DispatchPadVibrationIntensity(pad_index, large_or_single_motor_intensity, small_motor_intensity);
+      }
+    }
+
+    if (continued_update)
+      UpdateContinuedVibration();
+
+    // Cap the dispatch rate; a burst of writes within the window collapses into one update.
+    std::this_thread::sleep_for(std::chrono::milliseconds(VIBRATION_DISPATCH_INTERVAL_MS));
+    lock.lock();
+  }
+}
+
 void InputManager::PauseVibration()
 {
+  // Stop the dispatch thread first, making this thread the only one touching the sources. The
+  // thread restarts on the next latched update or continued-effect tick.
+  StopVibrationThread();
+
   for (PadVibrationBinding& binding : s_pad_vibration_array)
   {
     for (u32 motor_index = 0; motor_index < MAX_MOTORS_PER_PAD; motor_index++)
@@ -1937,6 +2199,9 @@ bool InputManager::ReloadDevices()
 
 void InputManager::CloseSources()
 {
+  // No vibration dispatch may be in flight once the sources are gone.
+  StopVibrationThread();
+
   for (u32 i = FIRST_EXTERNAL_INPUT_SOURCE; i < LAST_EXTERNAL_INPUT_SOURCE; i++)
   {
     if (s_input_sources[i])
@@ -1949,6 +2214,9 @@ void InputManager::CloseSources()
 
 void InputManager::PollSources()
 {
+  // Fire any events queued from other threads since the last slice.
+  DrainQueuedEvents();
+
   for (u32 i = FIRST_EXTERNAL_INPUT_SOURCE; i < LAST_EXTERNAL_INPUT_SOURCE; i++)
   {
     if (s_input_sources[i])
@@ -1960,8 +2228,11 @@ void InputManager::PollSources()
   if (System::GetState() == System::State::Running)
   {
     UpdateMacroButtons();
+
+    // Continued effects are re-notified from the dispatch thread too; this just keeps it awake
+    // while the system is running, preserving the pause gating (PauseVibration() stops it).
     if (!s_pad_vibration_array.empty())
-      UpdateContinuedVibration();
+      WakeVibrationThread(false, true);
   }
 }
 
@@ -2111,6 +2382,9 @@ void InputManager::ReloadSources(SettingsInterface& si, std::unique_lock<std::mu
   UpdateInputSourceState(si, settings_lock, InputSourceType::XInput, &InputSource::CreateXInputSource);
   UpdateInputSourceState(si, settings_lock, InputSourceType::RawInput, &InputSource::CreateWin32RawInputSource);
 #endif
+#ifdef ENABLE_EVDEV
+  UpdateInputSourceState(si, settings_lock, InputSourceType::Evdev, &InputSource::CreateEvdevSource);
+#endif
 #ifdef ENABLE_SDL2
   UpdateInputSourceState(si, settings_lock, InputSourceType::SDL, &InputSource::CreateSDLSource);
 #endif
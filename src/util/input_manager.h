@@ -27,6 +27,9 @@ enum class InputSourceType : u32
   XInput,
   RawInput,
 #endif
+#ifdef ENABLE_EVDEV
+  Evdev,
+#endif
 #ifdef ENABLE_SDL2
   SDL,
 #endif
@@ -292,6 +295,11 @@ void AddVibrationBinding(u32 pad_index, const InputBindingKey* motor_0_binding,
 /// Returns true if anything was bound to this key, otherwise false.
 bool InvokeEvents(InputBindingKey key, float value, GenericInputBinding generic_key = GenericInputBinding::Unknown);
 
+/// Queues an event raised on another thread (e.g. host window input on the UI thread). Queued
+/// events are drained and fired by PollSources() on the emulation thread, so bursts from
+/// high-polling-rate devices cost one lock-free push each instead of a cross-thread invocation.
+void QueueEvent(InputBindingKey key, float value, GenericInputBinding generic_key = GenericInputBinding::Unknown);
+
 /// Clears internal state for any binds with a matching source/index.
 void ClearBindStateFromSource(InputBindingKey key);
 
@@ -306,7 +314,8 @@ void RemoveHook();
 bool HasHook();
 
 /// Internal method used by pads to dispatch vibration updates to input sources.
-/// Intensity is normalized from 0 to 1.
+/// Intensity is normalized from 0 to 1. Only latches the values; a background thread issues the
+/// actual updates to the sources, since host rumble calls can block on wireless controllers.
 void SetPadVibrationIntensity(u32 pad_index, float large_or_single_motor_intensity, float small_motor_intensity);
 
 /// Zeros all vibration intensities. Call when pausing.
@@ -76,6 +76,9 @@ public:
   static std::unique_ptr<InputSource> CreateXInputSource();
   static std::unique_ptr<InputSource> CreateWin32RawInputSource();
 #endif
+#ifdef ENABLE_EVDEV
+  static std::unique_ptr<InputSource> CreateEvdevSource();
+#endif
 #ifdef ENABLE_SDL2
   static std::unique_ptr<InputSource> CreateSDLSource();
 #endif
@@ -82,6 +82,84 @@ bool IsoReader::ReadPVD(Error* error)
   return false;
 }
 
+std::string IsoReader::CanonicalizePath(const std::string_view& path)
+{
+  std::string key;
+  key.reserve(path.size());
+  for (const char ch : path)
+  {
+    if (ch == '/' || ch == '\\')
+    {
+      // strip leading slashes and collapse duplicates
+      if (key.empty() || key.back() == '/')
+        continue;
+
+      key.push_back('/');
+    }
+    else
+    {
+      key.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(ch))));
+    }
+  }
+
+  if (!key.empty() && key.back() == '/')
+    key.pop_back();
+
+  return key;
+}
+
+bool IsoReader::IndexDirectory(const std::string& path, u32 directory_record_lba, u32 directory_record_size, u32 depth,
+                               Error* error)
+{
+  // Corrupted images can contain looping directory structures, don't recurse forever.
+  static constexpr u32 MAX_DIRECTORY_DEPTH = 16;
+  if (depth >= MAX_DIRECTORY_DEPTH)
+  {
+    Error::SetString(error, fmt::format("Maximum directory depth exceeded at '{}'", path));
+    return false;
+  }
+
+  std::vector<std::pair<std::string, ISODirectoryEntry>> subdirectories;
+
+  const u32 num_sectors = (directory_record_size + (SECTOR_SIZE - 1)) / SECTOR_SIZE;
+  u8 sector_buffer[SECTOR_SIZE];
+  for (u32 i = 0; i < num_sectors; i++)
+  {
+    if (!ReadSector(sector_buffer, directory_record_lba + i, error))
+      return false;
+
+    u32 sector_offset = 0;
+    while ((sector_offset + sizeof(ISODirectoryEntry)) < SECTOR_SIZE)
+    {
+      const ISODirectoryEntry* de = reinterpret_cast<const ISODirectoryEntry*>(&sector_buffer[sector_offset]);
+      if (de->entry_length < sizeof(ISODirectoryEntry))
+        break;
+
+      const std::string_view de_filename = GetDirectoryEntryFileName(sector_buffer, sector_offset);
+      sector_offset += de->entry_length;
+
+      if (de_filename.empty() || de_filename == "." || de_filename == "..")
+        continue;
+
+      std::string entry_path = path.empty() ? CanonicalizePath(de_filename) :
+                                              fmt::format("{}/{}", path, CanonicalizePath(de_filename));
+      if (de->IsDirectory())
+        subdirectories.emplace_back(entry_path, *de);
+
+      m_file_index.emplace(std::move(entry_path), *de);
+    }
+  }
+
+  // Recurse only after the parent has been fully read, the sector buffer gets reused.
+  for (const auto& [subdirectory_path, subdirectory_de] : subdirectories)
+  {
+    if (!IndexDirectory(subdirectory_path, subdirectory_de.location_le, subdirectory_de.length_le, depth + 1, error))
+      return false;
+  }
+
+  return true;
+}
+
 std::optional<IsoReader::ISODirectoryEntry> IsoReader::LocateFile(const std::string_view& path, Error* error)
 {
   const ISODirectoryEntry* root_de = reinterpret_cast<const ISODirectoryEntry*>(m_pvd.root_directory_entry);
@@ -91,6 +169,32 @@ std::optional<IsoReader::ISODirectoryEntry> IsoReader::LocateFile(const std::str
     return *root_de;
   }
 
+  // Index the directory tree the first time anything is looked up, so repeated lookups (e.g. PCDrv
+  // serving files to the guest) don't walk directory records from disc every time.
+  if (!m_file_index_built)
+  {
+    Error index_error;
+    m_file_index_built = true;
+    m_file_index_valid = IndexDirectory(std::string(), root_de->location_le, root_de->length_le, 0, &index_error);
+    if (!m_file_index_valid)
+    {
+      Log_WarningFmt("Failed to index directory tree, falling back to walking: {}", index_error.GetDescription());
+      m_file_index.clear();
+    }
+  }
+
+  if (m_file_index_valid)
+  {
+    const auto it = m_file_index.find(CanonicalizePath(path));
+    if (it == m_file_index.end())
+    {
+      Error::SetString(error, fmt::format("Path '{}' not found", path));
+      return std::nullopt;
+    }
+
+    return it->second;
+  }
+
   // start at the root directory
   u8 sector_buffer[SECTOR_SIZE];
   return LocateFile(path, sector_buffer, root_de->location_le, root_de->length_le, error);
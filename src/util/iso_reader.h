@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class CDImage;
@@ -163,6 +164,7 @@ public:
 
 private:
   static std::string_view GetDirectoryEntryFileName(const u8* sector, u32 de_sector_offset);
+  static std::string CanonicalizePath(const std::string_view& path);
 
   bool ReadSector(u8* buf, u32 lsn, Error* error);
   bool ReadPVD(Error* error);
@@ -170,9 +172,17 @@ private:
   std::optional<ISODirectoryEntry> LocateFile(const std::string_view& path, u8* sector_buffer, u32 directory_record_lba,
                                               u32 directory_record_size, Error* error);
 
+  bool IndexDirectory(const std::string& path, u32 directory_record_lba, u32 directory_record_size, u32 depth,
+                      Error* error);
+
   CDImage* m_image;
   u32 m_track_number;
 
   ISOPrimaryVolumeDescriptor m_pvd = {};
   u32 m_pvd_lba = 0;
+
+  // Canonicalized path -> directory entry map, built the first time anything is looked up.
+  std::unordered_map<std::string, ISODirectoryEntry> m_file_index;
+  bool m_file_index_built = false;
+  bool m_file_index_valid = false;
 };
@@ -48,9 +48,12 @@ bool JitCodeBuffer::Allocate(u32 size /* = 64 * 1024 * 1024 */, u32 far_code_siz
   // Try to find a region in 32-bit range of ourselves.
   // Assume that the DuckStation binary will at max be 256MB. Therefore the max offset is
   // +/- 256MB + round_up_pow2(size). This'll be 512MB for the JITs.
+  // Candidates are aligned to the huge page size, otherwise transparent huge pages can never back
+  // the buffer and hot blocks burn iTLB entries at 4K granularity.
+  static constexpr uintptr_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
   static const u8 base_ptr = 0;
   const u8* base =
-    reinterpret_cast<const u8*>(Common::AlignDownPow2(reinterpret_cast<uintptr_t>(&base_ptr), HOST_PAGE_SIZE));
+    reinterpret_cast<const u8*>(Common::AlignDownPow2(reinterpret_cast<uintptr_t>(&base_ptr), HUGE_PAGE_SIZE));
   const u32 max_displacement = 0x80000000u - Common::NextPow2(256 * 1024 * 1024 + m_total_size);
   const u8* max_address = ((base + max_displacement) < base) ?
                             reinterpret_cast<const u8*>(std::numeric_limits<uintptr_t>::max()) :
@@ -82,7 +85,13 @@ bool JitCodeBuffer::Allocate(u32 size /* = 64 * 1024 * 1024 */, u32 far_code_siz
     return false;
 #endif
 
+  // The buffer keeps one protection for its whole lifetime (Apple Silicon aside, where MAP_JIT
+  // toggles it per-thread), so huge pages backing it never need to be split back up. Best-effort,
+  // same as the RAM mappings.
+  MemMap::AdviseHugePages(m_code_ptr, m_total_size);
+
   m_free_code_ptr = m_code_ptr;
+  m_code_end_ptr = m_code_ptr + size;
   m_code_size = size;
   m_code_used = 0;
 
@@ -211,6 +220,7 @@ bool JitCodeBuffer::Initialize(void* buffer, u32 size, u32 far_code_size /* = 0
   m_total_size = size;
   m_free_code_ptr = m_code_ptr + guard_size;
   m_code_size = size - far_code_size - (guard_size * 2);
+  m_code_end_ptr = m_free_code_ptr + m_code_size;
   m_code_used = 0;
 
   m_far_code_ptr = static_cast<u8*>(m_code_ptr) + m_code_size;
@@ -249,9 +259,14 @@ void JitCodeBuffer::Destroy()
 
   m_code_ptr = nullptr;
   m_free_code_ptr = nullptr;
+  m_code_end_ptr = nullptr;
   m_code_size = 0;
   m_code_reserve_size = 0;
   m_code_used = 0;
+  m_segments_base_ptr = nullptr;
+  m_segment_size = 0;
+  m_num_segments = 0;
+  m_active_segment = 0;
   m_far_code_ptr = nullptr;
   m_free_far_code_ptr = nullptr;
   m_far_code_size = 0;
@@ -282,11 +297,48 @@ void JitCodeBuffer::CommitCode(u32 length)
   FlushInstructionCache(m_free_code_ptr, length);
 #endif
 
-  Assert(length <= (m_code_size - m_code_used));
+  Assert(length <= GetFreeCodeSpace());
   m_free_code_ptr += length;
   m_code_used += length;
 }
 
+void JitCodeBuffer::SetupSegments(u32 count)
+{
+  DebugAssert(count > 0 && (GetFreeCodeSpace() / count) > 0);
+
+  m_segments_base_ptr = m_free_code_ptr;
+  m_segment_size = Common::AlignDownPow2(GetFreeCodeSpace() / count, 16);
+  m_num_segments = count;
+  m_active_segment = 0;
+  m_code_end_ptr = m_segments_base_ptr + m_segment_size;
+}
+
+u32 JitCodeBuffer::GetSegmentForPointer(const void* ptr) const
+{
+  const u8* const cptr = static_cast<const u8*>(ptr);
+  if (m_num_segments == 0 || cptr < m_segments_base_ptr ||
+      cptr >= (m_segments_base_ptr + (static_cast<size_t>(m_segment_size) * m_num_segments)))
+  {
+    return m_num_segments;
+  }
+
+  return static_cast<u32>(cptr - m_segments_base_ptr) / m_segment_size;
+}
+
+void JitCodeBuffer::SwitchToSegment(u32 index)
+{
+  DebugAssert(index < m_num_segments);
+
+  u8* const segment_ptr = m_segments_base_ptr + (static_cast<size_t>(index) * m_segment_size);
+  std::memset(segment_ptr, 0, m_segment_size);
+  FlushInstructionCache(segment_ptr, m_segment_size);
+
+  m_free_code_ptr = segment_ptr;
+  m_code_end_ptr = segment_ptr + m_segment_size;
+  m_code_used = static_cast<u32>(segment_ptr - (m_code_ptr + m_guard_size));
+  m_active_segment = index;
+}
+
 void JitCodeBuffer::CommitFarCode(u32 length)
 {
   if (length == 0)
@@ -307,7 +359,12 @@ void JitCodeBuffer::Reset()
   MemMap::BeginCodeWrite();
 
   m_free_code_ptr = m_code_ptr + m_guard_size + m_code_reserve_size;
+  m_code_end_ptr = m_free_code_ptr + m_code_size;
   m_code_used = 0;
+  m_segments_base_ptr = nullptr;
+  m_segment_size = 0;
+  m_num_segments = 0;
+  m_active_segment = 0;
   std::memset(m_free_code_ptr, 0, m_code_size);
   FlushInstructionCache(m_free_code_ptr, m_code_size);
 
@@ -32,10 +32,26 @@ public:
   ALWAYS_INLINE u32 GetTotalUsed() const { return m_code_used + m_far_code_used; }
 
   ALWAYS_INLINE u8* GetFreeCodePointer() const { return m_free_code_ptr; }
-  ALWAYS_INLINE u32 GetFreeCodeSpace() const { return static_cast<u32>(m_code_size - m_code_used); }
+  ALWAYS_INLINE u32 GetFreeCodeSpace() const { return static_cast<u32>(m_code_end_ptr - m_free_code_ptr); }
   void ReserveCode(u32 size);
   void CommitCode(u32 length);
 
+  /// Carves the remaining near-code space into equally-sized segments which can be discarded
+  /// individually instead of flushing the whole buffer. Anything committed beforehand (e.g. the
+  /// ASM dispatcher) stays permanently allocated. Allocation continues in the first segment.
+  void SetupSegments(u32 count);
+  ALWAYS_INLINE u32 GetSegmentCount() const { return m_num_segments; }
+  ALWAYS_INLINE u32 GetActiveSegment() const { return m_active_segment; }
+
+  /// Returns the segment containing the given near-code pointer, or GetSegmentCount() for
+  /// permanently-committed code, far code, and unsegmented buffers.
+  u32 GetSegmentForPointer(const void* ptr) const;
+
+  /// Discards all code in the given segment and makes it the active allocation target. The caller
+  /// is responsible for dropping all references into the segment beforehand, and for wrapping the
+  /// call in MemMap::BeginCodeWrite()/EndCodeWrite().
+  void SwitchToSegment(u32 index);
+
   ALWAYS_INLINE u8* GetFreeFarCodePointer() const { return m_free_far_code_ptr; }
   ALWAYS_INLINE u32 GetFreeFarCodeSpace() const { return static_cast<u32>(m_far_code_size - m_far_code_used); }
   void CommitFarCode(u32 length);
@@ -52,10 +68,16 @@ private:
 
   u8* m_code_ptr = nullptr;
   u8* m_free_code_ptr = nullptr;
+  u8* m_code_end_ptr = nullptr;
   u32 m_code_size = 0;
   u32 m_code_reserve_size = 0;
   u32 m_code_used = 0;
 
+  u8* m_segments_base_ptr = nullptr;
+  u32 m_segment_size = 0;
+  u32 m_num_segments = 0;
+  u32 m_active_segment = 0;
+
   u8* m_far_code_ptr = nullptr;
   u8* m_free_far_code_ptr = nullptr;
   u32 m_far_code_size = 0;
@@ -241,6 +241,7 @@ void MetalDevice::SetFeatures(FeatureMask disabled_features)
   m_features.shader_cache = true;
   m_features.pipeline_cache = false;
   m_features.prefer_unused_textures = true;
+  m_features.threaded_pipeline_creation = false;
 }
 
 bool MetalDevice::LoadShaders()
@@ -1196,6 +1197,9 @@ std::unique_ptr<MetalDownloadTexture> MetalDownloadTexture::Create(u32 width, u3
         return {};
       }
 
+      // The buffer starts at the page boundary, so blits have to target the offset of the
+      // imported pointer within it.
+      memory_offset = page_offset;
       map_ptr = static_cast<u8*>(memory);
     }
 
@@ -1270,6 +1274,11 @@ void MetalDownloadTexture::Flush()
     dev.WaitForFenceCounter(m_copy_fence_counter);
 }
 
+bool MetalDownloadTexture::IsDataReady()
+{
+  return (!m_needs_flush || MetalDevice::GetInstance().m_completed_fence_counter >= m_copy_fence_counter);
+}
+
 void MetalDownloadTexture::SetDebugName(std::string_view name)
 {
   @autoreleasepool
@@ -496,6 +496,9 @@ bool OpenGLDevice::CheckFeatures(FeatureMask disabled_features)
   // Mobile drivers prefer textures to not be updated mid-frame.
   m_features.prefer_unused_textures = is_gles || vendor_id_arm || vendor_id_powervr || vendor_id_qualcomm;
 
+  // Program linking is tied to the context, which can't be current on multiple threads.
+  m_features.threaded_pipeline_creation = false;
+
   if (vendor_id_intel)
   {
     // Intel drivers corrupt image on readback when syncs are used for downloads.
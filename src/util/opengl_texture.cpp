@@ -879,6 +879,15 @@ void OpenGLDownloadTexture::Flush()
   m_sync = {};
 }
 
+bool OpenGLDownloadTexture::IsDataReady()
+{
+  if (!m_needs_flush || !m_sync)
+    return true;
+
+  const GLenum res = glClientWaitSync(m_sync, 0, 0);
+  return (res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED);
+}
+
 void OpenGLDownloadTexture::SetDebugName(std::string_view name)
 {
   if (name.empty())
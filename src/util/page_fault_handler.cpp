@@ -7,6 +7,7 @@
 #include "common/log.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <mutex>
 #include <vector>
@@ -34,9 +35,13 @@ Log_SetChannel(Common::PageFaultHandler);
 
 namespace Common::PageFaultHandler {
 
-static std::recursive_mutex s_exception_handler_mutex;
-static Handler s_exception_handler_callback;
-static bool s_in_exception_handler;
+// Only a single handler is ever registered (the code cache), so the fault path only has to load
+// one pointer. Keeping the load atomic and the recursion guard thread-local means the in-signal
+// path takes no locks: faults on one thread no longer serialize against faults on another, which
+// matters for fastmem backpatching latency. The mutex only guards install/remove.
+static std::mutex s_exception_handler_mutex;
+static std::atomic<Handler> s_exception_handler_callback{nullptr};
+static thread_local bool s_in_exception_handler;
 
 #if defined(CPU_ARCH_ARM64)
 static bool IsStoreInstruction(const void* ptr)
@@ -88,10 +93,7 @@ static PVOID s_veh_handle;
 
 static LONG ExceptionHandler(PEXCEPTION_POINTERS exi)
 {
-  // Executing the handler concurrently from multiple threads wouldn't go down well.
-  std::unique_lock lock(s_exception_handler_mutex);
-
-  // Prevent recursive exception filtering.
+  // Prevent recursive exception filtering on this thread.
   if (s_in_exception_handler)
     return EXCEPTION_CONTINUE_SEARCH;
 
@@ -99,6 +101,10 @@ static LONG ExceptionHandler(PEXCEPTION_POINTERS exi)
   if (exi->ExceptionRecord->ExceptionCode != EXCEPTION_ACCESS_VIOLATION)
     return EXCEPTION_CONTINUE_SEARCH;
 
+  const Handler handler = s_exception_handler_callback.load(std::memory_order_acquire);
+  if (!handler)
+    return EXCEPTION_CONTINUE_SEARCH;
+
 #if defined(_M_AMD64)
   void* const exception_pc = reinterpret_cast<void*>(exi->ContextRecord->Rip);
 #elif defined(_M_ARM64)
@@ -112,7 +118,7 @@ static LONG ExceptionHandler(PEXCEPTION_POINTERS exi)
 
   s_in_exception_handler = true;
 
-  const HandlerResult handled = s_exception_handler_callback(exception_pc, exception_address, is_write);
+  const HandlerResult handled = handler(exception_pc, exception_address, is_write);
 
   s_in_exception_handler = false;
 
@@ -154,13 +160,10 @@ static void CallExistingSignalHandler(int signal, siginfo_t* siginfo, void* ctx)
 
 static void SignalHandler(int sig, siginfo_t* info, void* ctx)
 {
-  // Executing the handler concurrently from multiple threads wouldn't go down well.
-  std::unique_lock lock(s_exception_handler_mutex);
-
-  // Prevent recursive exception filtering.
-  if (s_in_exception_handler)
+  // Prevent recursive exception filtering on this thread.
+  const Handler handler = s_exception_handler_callback.load(std::memory_order_acquire);
+  if (s_in_exception_handler || !handler)
   {
-    lock.unlock();
     CallExistingSignalHandler(sig, info, ctx);
     return;
   }
@@ -222,7 +225,7 @@ static void SignalHandler(int sig, siginfo_t* info, void* ctx)
 
   s_in_exception_handler = true;
 
-  const HandlerResult result = s_exception_handler_callback(exception_pc, exception_address, is_write);
+  const HandlerResult result = handler(exception_pc, exception_address, is_write);
 
   s_in_exception_handler = false;
 
@@ -231,7 +234,6 @@ static void SignalHandler(int sig, siginfo_t* info, void* ctx)
     return;
 
   // Call old signal handler, which will likely dump core.
-  lock.unlock();
   CallExistingSignalHandler(sig, info, ctx);
 }
 
@@ -240,8 +242,9 @@ static void SignalHandler(int sig, siginfo_t* info, void* ctx)
 bool InstallHandler(Handler handler)
 {
   std::unique_lock lock(s_exception_handler_mutex);
-  AssertMsg(!s_exception_handler_callback, "A page fault handler is already registered.");
-  if (!s_exception_handler_callback)
+  AssertMsg(!s_exception_handler_callback.load(std::memory_order_relaxed),
+            "A page fault handler is already registered.");
+  if (!s_exception_handler_callback.load(std::memory_order_relaxed))
   {
 #if defined(_WIN32) && (defined(CPU_ARCH_X64) || defined(CPU_ARCH_ARM64))
     s_veh_handle = AddVectoredExceptionHandler(1, ExceptionHandler);
@@ -275,19 +278,20 @@ bool InstallHandler(Handler handler)
 #endif
   }
 
-  s_exception_handler_callback = handler;
+  s_exception_handler_callback.store(handler, std::memory_order_release);
   return true;
 }
 
 bool RemoveHandler(Handler handler)
 {
   std::unique_lock lock(s_exception_handler_mutex);
-  AssertMsg(!s_exception_handler_callback || s_exception_handler_callback == handler,
+  const Handler installed_handler = s_exception_handler_callback.load(std::memory_order_relaxed);
+  AssertMsg(!installed_handler || installed_handler == handler,
             "Not removing the same handler previously registered.");
-  if (!s_exception_handler_callback)
+  if (!installed_handler)
     return false;
 
-  s_exception_handler_callback = nullptr;
+  s_exception_handler_callback.store(nullptr, std::memory_order_release);
 
 #if defined(_WIN32) && (defined(CPU_ARCH_X64) || defined(CPU_ARCH_ARM64))
   RemoveVectoredExceptionHandler(s_veh_handle);
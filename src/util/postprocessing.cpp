@@ -45,6 +45,7 @@ static void ClearStagesWithError(const Error& error);
 static SettingsInterface& GetLoadSettingsInterface();
 static void LoadStages();
 static void DestroyTextures();
+static void BeginSharedIntermediateScope();
 
 static std::vector<std::unique_ptr<PostProcessing::Shader>> s_stages;
 static bool s_enabled = false;
@@ -60,6 +61,15 @@ static std::unique_ptr<GPUTexture> s_output_texture;
 
 static std::unordered_map<u64, std::unique_ptr<GPUSampler>> s_samplers;
 static std::unique_ptr<GPUTexture> s_dummy_texture;
+
+// Pool of intermediate render targets shared between stages. Each stage claims its transient
+// targets from the pool in turn, so consecutive stages alias the same storage.
+struct SharedIntermediate
+{
+  std::unique_ptr<GPUTexture> texture;
+  bool claimed;
+};
+static std::vector<SharedIntermediate> s_shared_intermediates;
 } // namespace PostProcessing
 
 template<typename T>
@@ -653,6 +663,39 @@ GPUSampler* PostProcessing::GetSampler(const GPUSampler::Config& config)
   return it->second.get();
 }
 
+void PostProcessing::BeginSharedIntermediateScope()
+{
+  for (SharedIntermediate& intermediate : s_shared_intermediates)
+    intermediate.claimed = false;
+}
+
+GPUTexture* PostProcessing::GetSharedIntermediateTexture(u32 width, u32 height, GPUTexture::Format format)
+{
+  for (SharedIntermediate& intermediate : s_shared_intermediates)
+  {
+    if (intermediate.claimed || intermediate.texture->GetWidth() != width ||
+        intermediate.texture->GetHeight() != height || intermediate.texture->GetFormat() != format)
+    {
+      continue;
+    }
+
+    intermediate.claimed = true;
+    return intermediate.texture.get();
+  }
+
+  std::unique_ptr<GPUTexture> texture =
+    g_gpu_device->FetchTexture(width, height, 1, 1, 1, GPUTexture::Type::RenderTarget, format);
+  if (!texture)
+  {
+    Log_ErrorPrintf("Failed to create %ux%u shared intermediate texture", width, height);
+    return nullptr;
+  }
+
+  GPUTexture* ret = texture.get();
+  s_shared_intermediates.push_back({std::move(texture), true});
+  return ret;
+}
+
 GPUTexture* PostProcessing::GetDummyTexture()
 {
   if (s_dummy_texture)
@@ -697,6 +740,10 @@ bool PostProcessing::CheckTargets(GPUTexture::Format target_format, u32 target_w
 
     progress->SetFormattedStatusText("Compiling %s...", shader->GetName().c_str());
 
+    // Each stage claims shared intermediates afresh - anything the previous stage used is dead
+    // by the time this stage runs, so it's fair game for aliasing.
+    BeginSharedIntermediateScope();
+
     if (!shader->CompilePipeline(target_format, target_width, target_height, progress) ||
         !shader->ResizeOutput(target_format, target_width, target_height))
     {
@@ -725,6 +772,10 @@ void PostProcessing::DestroyTextures()
 
   g_gpu_device->RecycleTexture(std::move(s_output_texture));
   g_gpu_device->RecycleTexture(std::move(s_input_texture));
+
+  for (SharedIntermediate& intermediate : s_shared_intermediates)
+    g_gpu_device->RecycleTexture(std::move(intermediate.texture));
+  s_shared_intermediates.clear();
 }
 
 bool PostProcessing::Apply(GPUTexture* final_target, s32 final_left, s32 final_top, s32 final_width, s32 final_height,
@@ -133,4 +133,10 @@ bool Apply(GPUTexture* final_target, s32 final_left, s32 final_top, s32 final_wi
 GPUSampler* GetSampler(const GPUSampler::Config& config);
 GPUTexture* GetDummyTexture();
 
+/// Borrows an intermediate render target from the chain's shared pool. Stage-local render
+/// targets whose contents don't survive the frame can alias the same storage across stages,
+/// since their lifetimes never overlap. The pool owns the texture; returned pointers stay valid
+/// until the next target resize.
+GPUTexture* GetSharedIntermediateTexture(u32 width, u32 height, GPUTexture::Format format);
+
 }; // namespace PostProcessing
@@ -5,17 +5,20 @@
 #include "image.h"
 #include "input_manager.h"
 #include "shadergen.h"
+#include "state_wrapper.h"
 
 // TODO: Remove me
 #include "core/host.h"
 #include "core/settings.h"
 
 #include "common/assert.h"
+#include "common/byte_stream.h"
 #include "common/error.h"
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/path.h"
 #include "common/progress_callback.h"
+#include "common/scoped_guard.h"
 #include "common/string_util.h"
 
 #include "effect_codegen.hpp"
@@ -23,6 +26,7 @@
 #include "effect_preprocessor.hpp"
 
 #include "fmt/format.h"
+#include "xxhash.h"
 
 #include <bitset>
 #include <cctype>
@@ -35,6 +39,25 @@ Log_SetChannel(ReShadeFXShader);
 static constexpr s32 DEFAULT_BUFFER_WIDTH = 3840;
 static constexpr s32 DEFAULT_BUFFER_HEIGHT = 2160;
 
+// On-disk cache of generated code and reflection data, so the ReShadeFX frontend only runs when
+// an effect or one of its includes actually changes. Bump the version when the serialized layout
+// or anything feeding the generated code (compiler version, macro set) changes.
+static constexpr u32 MODULE_CACHE_SIGNATURE = 0x58465244; // 'DRFX'
+static constexpr u32 MODULE_CACHE_VERSION = 1;
+
+namespace {
+struct ModuleCacheDependency
+{
+  std::string path;
+  s64 modification_time;
+  s64 size;
+};
+} // namespace
+
+// Set while the preprocessor runs, so the include callbacks can record which files the effect
+// pulled in. Effects are only compiled from one thread.
+static std::vector<ModuleCacheDependency>* s_module_cache_dependencies = nullptr;
+
 static RenderAPI GetRenderAPI()
 {
   return g_gpu_device ? g_gpu_device->GetRenderAPI() : RenderAPI::D3D11;
@@ -58,6 +81,15 @@ static bool PreprocessorReadFileCallback(const std::string& path, std::string& d
   if (!rdata.has_value())
     return false;
 
+  // Only on-disk includes are tracked as cache dependencies, resource includes ship with the
+  // application and only change together with the cache version.
+  if (s_module_cache_dependencies && Path::IsAbsolute(path))
+  {
+    FILESYSTEM_STAT_DATA sd;
+    if (FileSystem::StatFile(path.c_str(), &sd))
+      s_module_cache_dependencies->push_back({path, static_cast<s64>(sd.ModificationTime), sd.Size});
+  }
+
   data = std::move(rdata.value());
   return true;
 }
@@ -95,6 +127,272 @@ static std::unique_ptr<reshadefx::codegen> CreateRFXCodegen()
   }
 }
 
+static void DoRFXType(StateWrapper& sw, reshadefx::type* type)
+{
+  sw.Do(&type->base);
+  sw.Do(&type->rows);
+  sw.Do(&type->cols);
+  sw.Do(&type->qualifiers);
+  sw.Do(&type->array_length);
+  sw.Do(&type->definition);
+}
+
+static void DoRFXConstant(StateWrapper& sw, reshadefx::constant* constant)
+{
+  sw.DoArray(constant->as_uint, std::size(constant->as_uint));
+  sw.Do(&constant->string_data);
+
+  u32 count = static_cast<u32>(constant->array_data.size());
+  sw.Do(&count);
+  if (sw.IsReading())
+    constant->array_data.resize(count);
+  for (reshadefx::constant& elem : constant->array_data)
+    DoRFXConstant(sw, &elem);
+}
+
+static void DoRFXAnnotation(StateWrapper& sw, reshadefx::annotation* annotation)
+{
+  DoRFXType(sw, &annotation->type);
+  sw.Do(&annotation->name);
+  DoRFXConstant(sw, &annotation->value);
+}
+
+template<typename T, typename F>
+static void DoRFXVector(StateWrapper& sw, std::vector<T>* vec, const F& do_element)
+{
+  u32 count = static_cast<u32>(vec->size());
+  sw.Do(&count);
+  if (sw.IsReading())
+    vec->resize(count);
+  for (T& elem : *vec)
+    do_element(sw, &elem);
+}
+
+static void DoRFXTextureInfo(StateWrapper& sw, reshadefx::texture_info* ti)
+{
+  sw.Do(&ti->id);
+  sw.Do(&ti->binding);
+  sw.Do(&ti->name);
+  sw.Do(&ti->semantic);
+  sw.Do(&ti->unique_name);
+  DoRFXVector(sw, &ti->annotations, DoRFXAnnotation);
+  sw.Do(&ti->type);
+  sw.Do(&ti->width);
+  sw.Do(&ti->height);
+  sw.Do(&ti->depth);
+  sw.Do(&ti->levels);
+  sw.Do(&ti->format);
+  sw.Do(&ti->render_target);
+  sw.Do(&ti->storage_access);
+}
+
+static void DoRFXSamplerInfo(StateWrapper& sw, reshadefx::sampler_info* si)
+{
+  sw.Do(&si->id);
+  sw.Do(&si->binding);
+  sw.Do(&si->texture_binding);
+  sw.Do(&si->name);
+  DoRFXType(sw, &si->type);
+  sw.Do(&si->unique_name);
+  sw.Do(&si->texture_name);
+  DoRFXVector(sw, &si->annotations, DoRFXAnnotation);
+  sw.Do(&si->filter);
+  sw.Do(&si->address_u);
+  sw.Do(&si->address_v);
+  sw.Do(&si->address_w);
+  sw.Do(&si->min_lod);
+  sw.Do(&si->max_lod);
+  sw.Do(&si->lod_bias);
+  sw.Do(&si->srgb);
+}
+
+static void DoRFXStorageInfo(StateWrapper& sw, reshadefx::storage_info* si)
+{
+  sw.Do(&si->id);
+  sw.Do(&si->binding);
+  sw.Do(&si->name);
+  DoRFXType(sw, &si->type);
+  sw.Do(&si->unique_name);
+  sw.Do(&si->texture_name);
+  sw.Do(&si->level);
+}
+
+static void DoRFXUniformInfo(StateWrapper& sw, reshadefx::uniform_info* ui)
+{
+  sw.Do(&ui->name);
+  DoRFXType(sw, &ui->type);
+  sw.Do(&ui->size);
+  sw.Do(&ui->offset);
+  DoRFXVector(sw, &ui->annotations, DoRFXAnnotation);
+  sw.Do(&ui->has_initializer_value);
+  DoRFXConstant(sw, &ui->initializer_value);
+}
+
+static void DoRFXEntryPoint(StateWrapper& sw, reshadefx::entry_point* ep)
+{
+  sw.Do(&ep->name);
+  sw.Do(&ep->type);
+}
+
+static void DoRFXPassInfo(StateWrapper& sw, reshadefx::pass_info* pi)
+{
+  sw.Do(&pi->name);
+  sw.DoArray(pi->render_target_names, std::size(pi->render_target_names));
+  sw.Do(&pi->vs_entry_point);
+  sw.Do(&pi->ps_entry_point);
+  sw.Do(&pi->cs_entry_point);
+  sw.Do(&pi->generate_mipmaps);
+  sw.Do(&pi->clear_render_targets);
+  sw.Do(&pi->srgb_write_enable);
+  sw.DoArray(pi->blend_enable, std::size(pi->blend_enable));
+  sw.Do(&pi->stencil_enable);
+  sw.DoArray(pi->color_write_mask, std::size(pi->color_write_mask));
+  sw.Do(&pi->stencil_read_mask);
+  sw.Do(&pi->stencil_write_mask);
+  sw.DoArray(pi->blend_op, std::size(pi->blend_op));
+  sw.DoArray(pi->blend_op_alpha, std::size(pi->blend_op_alpha));
+  sw.DoArray(pi->src_blend, std::size(pi->src_blend));
+  sw.DoArray(pi->dest_blend, std::size(pi->dest_blend));
+  sw.DoArray(pi->src_blend_alpha, std::size(pi->src_blend_alpha));
+  sw.DoArray(pi->dest_blend_alpha, std::size(pi->dest_blend_alpha));
+  sw.Do(&pi->stencil_comparison_func);
+  sw.Do(&pi->stencil_reference_value);
+  sw.Do(&pi->stencil_op_pass);
+  sw.Do(&pi->stencil_op_fail);
+  sw.Do(&pi->stencil_op_depth_fail);
+  sw.Do(&pi->num_vertices);
+  sw.Do(&pi->topology);
+  sw.Do(&pi->viewport_width);
+  sw.Do(&pi->viewport_height);
+  sw.Do(&pi->viewport_dispatch_z);
+  DoRFXVector(sw, &pi->samplers, DoRFXSamplerInfo);
+  DoRFXVector(sw, &pi->storages, DoRFXStorageInfo);
+}
+
+static void DoRFXTechniqueInfo(StateWrapper& sw, reshadefx::technique_info* ti)
+{
+  sw.Do(&ti->name);
+  DoRFXVector(sw, &ti->passes, DoRFXPassInfo);
+  DoRFXVector(sw, &ti->annotations, DoRFXAnnotation);
+}
+
+static void DoRFXModule(StateWrapper& sw, reshadefx::module* mod)
+{
+  u32 code_size = static_cast<u32>(mod->code.size());
+  sw.Do(&code_size);
+  if (sw.IsReading())
+    mod->code.resize(code_size);
+  sw.DoBytes(mod->code.data(), code_size);
+
+  DoRFXVector(sw, &mod->entry_points, DoRFXEntryPoint);
+  DoRFXVector(sw, &mod->textures, DoRFXTextureInfo);
+  DoRFXVector(sw, &mod->samplers, DoRFXSamplerInfo);
+  DoRFXVector(sw, &mod->storages, DoRFXStorageInfo);
+  DoRFXVector(sw, &mod->uniforms, DoRFXUniformInfo);
+  DoRFXVector(sw, &mod->spec_constants, DoRFXUniformInfo);
+  DoRFXVector(sw, &mod->techniques, DoRFXTechniqueInfo);
+  sw.Do(&mod->total_uniform_size);
+  sw.Do(&mod->num_texture_bindings);
+  sw.Do(&mod->num_sampler_bindings);
+  sw.Do(&mod->num_storage_bindings);
+}
+
+static std::string GetModuleCacheFilename(const std::string& code, s32 buffer_width, s32 buffer_height)
+{
+  // Everything which influences the generated code participates in the key: the render API picks
+  // the codegen backend and __RENDERER__, the buffer dimensions are baked in as macros, and debug
+  // devices generate debug info.
+  const u64 seed = (static_cast<u64>(MODULE_CACHE_VERSION) << 56) | (static_cast<u64>(GetRenderAPI()) << 48) |
+                   (static_cast<u64>(g_gpu_device && g_gpu_device->IsDebugDevice()) << 40) |
+                   (static_cast<u64>(static_cast<u32>(buffer_width)) << 20) | static_cast<u64>(static_cast<u32>(buffer_height));
+  const XXH128_hash_t hash = XXH3_128bits_withSeed(code.data(), code.length(), seed);
+  return Path::Combine(EmuFolders::Cache,
+                       fmt::format("reshadefx" FS_OSPATH_SEPARATOR_STR "{:016x}{:016x}.bin", hash.high64, hash.low64));
+}
+
+static bool LoadModuleFromCache(const std::string& filename, reshadefx::module* mod)
+{
+  std::unique_ptr<ByteStream> stream =
+    ByteStream::OpenFile(filename.c_str(), BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_SEEKABLE);
+  if (!stream)
+    return false;
+
+  StateWrapper sw(stream.get(), StateWrapper::Mode::Read, MODULE_CACHE_VERSION);
+
+  u32 signature = 0;
+  u32 version = 0;
+  sw.Do(&signature);
+  sw.Do(&version);
+  if (sw.HasError() || signature != MODULE_CACHE_SIGNATURE || version != MODULE_CACHE_VERSION)
+    return false;
+
+  u32 num_dependencies = 0;
+  sw.Do(&num_dependencies);
+  for (u32 i = 0; i < num_dependencies; i++)
+  {
+    std::string dep_path;
+    s64 dep_modification_time = 0;
+    s64 dep_size = 0;
+    sw.Do(&dep_path);
+    sw.Do(&dep_modification_time);
+    sw.Do(&dep_size);
+
+    FILESYSTEM_STAT_DATA sd;
+    if (sw.HasError() || !FileSystem::StatFile(dep_path.c_str(), &sd) ||
+        static_cast<s64>(sd.ModificationTime) != dep_modification_time || sd.Size != dep_size)
+    {
+      Log_DevFmt("Include '{}' changed, discarding cached module '{}'", dep_path, filename);
+      return false;
+    }
+  }
+
+  DoRFXModule(sw, mod);
+  return !sw.HasError();
+}
+
+static void SaveModuleToCache(const std::string& filename, const std::vector<ModuleCacheDependency>& dependencies,
+                              reshadefx::module& mod)
+{
+  if (!FileSystem::EnsureDirectoryExists(std::string(Path::GetDirectory(filename)).c_str(), false))
+    return;
+
+  std::unique_ptr<ByteStream> stream =
+    ByteStream::OpenFile(filename.c_str(), BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE | BYTESTREAM_OPEN_TRUNCATE |
+                                             BYTESTREAM_OPEN_ATOMIC_UPDATE | BYTESTREAM_OPEN_SEEKABLE);
+  if (!stream)
+  {
+    Log_ErrorFmt("Failed to open module cache '{}' for writing", filename);
+    return;
+  }
+
+  StateWrapper sw(stream.get(), StateWrapper::Mode::Write, MODULE_CACHE_VERSION);
+
+  u32 value = MODULE_CACHE_SIGNATURE;
+  sw.Do(&value);
+  value = MODULE_CACHE_VERSION;
+  sw.Do(&value);
+
+  value = static_cast<u32>(dependencies.size());
+  sw.Do(&value);
+  for (const ModuleCacheDependency& dep : dependencies)
+  {
+    std::string dep_path = dep.path;
+    s64 dep_modification_time = dep.modification_time;
+    s64 dep_size = dep.size;
+    sw.Do(&dep_path);
+    sw.Do(&dep_modification_time);
+    sw.Do(&dep_size);
+  }
+
+  DoRFXModule(sw, &mod);
+
+  if (sw.HasError() || !stream->Commit())
+  {
+    Log_ErrorFmt("Failed to write module cache '{}'", filename);
+    stream->Discard();
+  }
+}
+
 static GPUTexture::Format MapTextureFormat(reshadefx::texture_format format)
 {
   static constexpr GPUTexture::Format s_mapping[] = {
@@ -370,6 +668,17 @@ bool PostProcessing::ReShadeFXShader::IsValid() const
 bool PostProcessing::ReShadeFXShader::CreateModule(s32 buffer_width, s32 buffer_height, reshadefx::module* mod,
                                                    std::string code, Error* error)
 {
+  const std::string cache_filename = GetModuleCacheFilename(code, buffer_width, buffer_height);
+  if (LoadModuleFromCache(cache_filename, mod))
+  {
+    Log_DevFmt("Using cached module for '{}'", m_filename);
+    return true;
+  }
+
+  std::vector<ModuleCacheDependency> dependencies;
+  s_module_cache_dependencies = &dependencies;
+  const ScopedGuard dependency_guard = []() { s_module_cache_dependencies = nullptr; };
+
   reshadefx::preprocessor pp;
   pp.set_include_callbacks(PreprocessorFileExistsCallback, PreprocessorReadFileCallback);
 
@@ -435,6 +744,8 @@ bool PostProcessing::ReShadeFXShader::CreateModule(s32 buffer_width, s32 buffer_
   cg->write_result(*mod);
 
   // FileSystem::WriteBinaryFile("D:\\out.txt", mod->code.data(), mod->code.size());
+
+  SaveModuleToCache(cache_filename, dependencies, *mod);
   return true;
 }
 
@@ -1122,7 +1433,8 @@ GPUTexture* PostProcessing::ReShadeFXShader::GetTextureByID(TextureID id, GPUTex
   if (static_cast<size_t>(id) >= m_textures.size())
     Panic("Unexpected texture ID");
 
-  return m_textures[static_cast<size_t>(id)].texture.get();
+  const Texture& tex = m_textures[static_cast<size_t>(id)];
+  return tex.texture ? tex.texture.get() : tex.shared_texture;
 }
 
 bool PostProcessing::ReShadeFXShader::CompilePipeline(GPUTexture::Format format, u32 width, u32 height,
@@ -1288,20 +1600,53 @@ bool PostProcessing::ReShadeFXShader::ResizeOutput(GPUTexture::Format format, u3
 {
   m_valid = false;
 
-  for (Texture& tex : m_textures)
+  // Work out which render targets are transient, i.e. always written before they're sampled
+  // within a frame. Those can borrow chain-shared storage, since nothing reads them once the
+  // next stage starts. Feedback textures sampled before the frame writes them (temporal
+  // effects) keep their own storage.
+  std::vector<bool> is_feedback(m_textures.size(), false);
+  {
+    std::vector<bool> written(m_textures.size(), false);
+    for (const Pass& pass : m_passes)
+    {
+      for (const Sampler& sampler : pass.samplers)
+      {
+        if (sampler.texture_id >= 0 && !written[sampler.texture_id])
+          is_feedback[sampler.texture_id] = true;
+      }
+      for (const TextureID rt : pass.render_targets)
+      {
+        if (rt >= 0)
+          written[rt] = true;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < m_textures.size(); i++)
   {
+    Texture& tex = m_textures[i];
     if (tex.rt_scale == 0.0f)
       continue;
 
     g_gpu_device->RecycleTexture(std::move(tex.texture));
+    tex.shared_texture = nullptr;
 
     const u32 t_width = std::max(static_cast<u32>(static_cast<float>(width) * tex.rt_scale), 1u);
     const u32 t_height = std::max(static_cast<u32>(static_cast<float>(height) * tex.rt_scale), 1u);
-    tex.texture = g_gpu_device->FetchTexture(t_width, t_height, 1, 1, 1, GPUTexture::Type::RenderTarget, tex.format);
-    if (!tex.texture)
+    if (!is_feedback[i])
     {
-      Log_ErrorPrintf("Failed to create %ux%u texture", t_width, t_height);
-      return {};
+      tex.shared_texture = PostProcessing::GetSharedIntermediateTexture(t_width, t_height, tex.format);
+      if (!tex.shared_texture)
+        return {};
+    }
+    else
+    {
+      tex.texture = g_gpu_device->FetchTexture(t_width, t_height, 1, 1, 1, GPUTexture::Type::RenderTarget, tex.format);
+      if (!tex.texture)
+      {
+        Log_ErrorPrintf("Failed to create %ux%u texture", t_width, t_height);
+        return {};
+      }
     }
   }
 
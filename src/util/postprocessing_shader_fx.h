@@ -88,6 +88,11 @@ private:
   struct Texture
   {
     std::unique_ptr<GPUTexture> texture;
+
+    // Transient render targets borrow chain-owned storage instead of allocating their own,
+    // aliased between stages. See ResizeOutput().
+    GPUTexture* shared_texture = nullptr;
+
     std::string reshade_name; // TODO: we might be able to drop this
     GPUTexture::Format format;
     float rt_scale;
@@ -114,8 +114,16 @@ void PostProcessing::GLSLShader::FillUniformBuffer(void* buffer, u32 texture_wid
 
 bool PostProcessing::GLSLShader::CompilePipeline(GPUTexture::Format format, u32 width, u32 height, ProgressCallback* progress)
 {
+  // Option values are passed through the uniform buffer, and the generated source only depends
+  // on the target format, so tweaking options or resizing never requires a recompile. Boot-time
+  // compiles still go through GPUShaderCache inside CreateShader(), keyed on the generated
+  // source hash.
+  if (m_pipeline && m_pipeline_format == format)
+    return true;
+
   if (m_pipeline)
     m_pipeline.reset();
+  m_pipeline_format = GPUTexture::Format::Unknown;
 
   PostProcessingGLSLShaderGen shadergen(g_gpu_device->GetRenderAPI(), g_gpu_device->GetFeatures().dual_source_blend,
                                         g_gpu_device->GetFeatures().framebuffer_fetch);
@@ -143,6 +151,8 @@ bool PostProcessing::GLSLShader::CompilePipeline(GPUTexture::Format format, u32
   if (!(m_pipeline = g_gpu_device->CreatePipeline(plconfig)))
     return false;
 
+  m_pipeline_format = format;
+
   if (!m_sampler)
   {
     GPUSampler::Config config = GPUSampler::GetNearestConfig();
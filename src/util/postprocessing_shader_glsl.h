@@ -52,6 +52,10 @@ private:
 
   std::unique_ptr<GPUPipeline> m_pipeline;
   std::unique_ptr<GPUSampler> m_sampler;
+
+  // Format the current pipeline was compiled for. The pipeline doesn't depend on the target
+  // size (options are uniforms), so recompilation is only needed when this changes.
+  GPUTexture::Format m_pipeline_format = GPUTexture::Format::Unknown;
 };
 
 } // namespace PostProcessing
\ No newline at end of file
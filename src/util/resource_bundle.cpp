@@ -0,0 +1,321 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "resource_bundle.h"
+
+#include "common/error.h"
+#include "common/file_system.h"
+#include "common/heterogeneous_containers.h"
+#include "common/log.h"
+#include "common/memmap.h"
+#include "common/path.h"
+#include "common/string_util.h"
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <cstring>
+
+Log_SetChannel(ResourceBundle);
+
+// Layout is header, entry table, name table, then the entry data. Each entry is individually
+// zstd-compressed; an entry whose compressed size equals its uncompressed size is stored raw
+// (compressed output is only kept when it is smaller). Names are stored without terminators,
+// use forward slashes on all platforms, and are relative to the resources directory. All fields
+// are little-endian.
+
+namespace {
+
+enum : u32
+{
+  BUNDLE_COMPRESSION_LEVEL = 19,
+};
+
+static constexpr char BUNDLE_MAGIC[4] = {'D', 'R', 'B', '1'};
+
+#pragma pack(push, 1)
+struct BundleHeader
+{
+  char magic[4]; // "DRB1"
+  u32 entry_count;
+  u32 name_table_size;
+  u32 unused;
+};
+
+struct BundleEntry
+{
+  u32 name_offset; // into the name table
+  u32 name_size;
+  u32 compressed_size;
+  u32 uncompressed_size;
+  u64 data_offset; // from the start of the file
+};
+#pragma pack(pop)
+
+struct IndexEntry
+{
+  u64 data_offset;
+  u32 compressed_size;
+  u32 uncompressed_size;
+};
+
+} // namespace
+
+// The map and index are written once by Open() and read-only afterwards; lookups and one-shot
+// zstd decompression are stateless, so readers on multiple threads need no locking.
+static const u8* s_bundle_data = nullptr;
+static size_t s_bundle_size = 0;
+static std::time_t s_bundle_timestamp = 0;
+static PreferUnorderedStringMap<IndexEntry> s_bundle_index;
+
+static bool MapBundleFile(const char* path)
+{
+  void* ptr = MemMap::MapReadOnlyFile(path, &s_bundle_size, nullptr);
+  if (!ptr)
+    return false;
+
+  // the index is walked immediately, and the first entries usually follow close behind
+  MemMap::AdviseReadAhead(ptr, s_bundle_size);
+
+  s_bundle_data = static_cast<const u8*>(ptr);
+  return true;
+}
+
+static void UnmapBundleFile()
+{
+  if (s_bundle_data)
+    MemMap::UnmapReadOnlyFile(const_cast<u8*>(s_bundle_data), s_bundle_size);
+
+  s_bundle_data = nullptr;
+  s_bundle_size = 0;
+}
+
+bool ResourceBundle::Open(const char* path)
+{
+  Close();
+
+  FILESYSTEM_STAT_DATA sd;
+  if (!FileSystem::StatFile(path, &sd))
+    return false;
+
+  if (!MapBundleFile(path))
+  {
+    Log_ErrorPrintf("Failed to map resource bundle '%s'", path);
+    return false;
+  }
+
+  BundleHeader header;
+  if (s_bundle_size < sizeof(header))
+  {
+    Log_ErrorPrintf("Resource bundle '%s' is too small", path);
+    Close();
+    return false;
+  }
+
+  std::memcpy(&header, s_bundle_data, sizeof(header));
+  const u64 entries_size = sizeof(BundleEntry) * static_cast<u64>(header.entry_count);
+  if (std::memcmp(header.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) != 0 ||
+      (sizeof(header) + entries_size + header.name_table_size) > s_bundle_size)
+  {
+    Log_ErrorPrintf("Resource bundle '%s' is corrupted", path);
+    Close();
+    return false;
+  }
+
+  const u8* const entries = s_bundle_data + sizeof(header);
+  const char* const names = reinterpret_cast<const char*>(entries + entries_size);
+  s_bundle_index.reserve(header.entry_count);
+  for (u32 i = 0; i < header.entry_count; i++)
+  {
+    BundleEntry entry;
+    std::memcpy(&entry, entries + (sizeof(entry) * i), sizeof(entry));
+    if ((static_cast<u64>(entry.name_offset) + entry.name_size) > header.name_table_size ||
+        (entry.data_offset + entry.compressed_size) > s_bundle_size ||
+        entry.compressed_size > entry.uncompressed_size)
+    {
+      Log_ErrorPrintf("Resource bundle '%s' is corrupted (entry %u)", path, i);
+      Close();
+      return false;
+    }
+
+    s_bundle_index.emplace(std::string(names + entry.name_offset, entry.name_size),
+                           IndexEntry{entry.data_offset, entry.compressed_size, entry.uncompressed_size});
+  }
+
+  s_bundle_timestamp = sd.ModificationTime;
+  Log_InfoPrintf("Using resource bundle '%s' (%u entries)", path, header.entry_count);
+  return true;
+}
+
+bool ResourceBundle::IsOpen()
+{
+  return (s_bundle_data != nullptr);
+}
+
+void ResourceBundle::Close()
+{
+  s_bundle_index.clear();
+  s_bundle_timestamp = 0;
+  UnmapBundleFile();
+}
+
+bool ResourceBundle::HasFile(std::string_view name)
+{
+  return (s_bundle_index.find(name) != s_bundle_index.end());
+}
+
+static bool ReadEntry(std::string_view name, void* dst)
+{
+  const auto it = s_bundle_index.find(name);
+  if (it == s_bundle_index.end())
+    return false;
+
+  const IndexEntry& entry = it->second;
+  const u8* const src = s_bundle_data + entry.data_offset;
+  if (entry.compressed_size == entry.uncompressed_size)
+  {
+    std::memcpy(dst, src, entry.uncompressed_size);
+    return true;
+  }
+
+  const size_t result = ZSTD_decompress(dst, entry.uncompressed_size, src, entry.compressed_size);
+  if (ZSTD_isError(result) || result != entry.uncompressed_size)
+  {
+    Log_ErrorFmt("Failed to decompress bundled resource '{}': {}",
+                 name, ZSTD_isError(result) ? ZSTD_getErrorName(result) : "short output");
+    return false;
+  }
+
+  return true;
+}
+
+std::optional<std::vector<u8>> ResourceBundle::ReadBinaryFile(std::string_view name)
+{
+  const auto it = s_bundle_index.find(name);
+  if (it == s_bundle_index.end())
+    return std::nullopt;
+
+  std::vector<u8> ret(it->second.uncompressed_size);
+  if (!ReadEntry(name, ret.data()))
+    return std::nullopt;
+
+  return ret;
+}
+
+std::optional<std::string> ResourceBundle::ReadFileToString(std::string_view name)
+{
+  const auto it = s_bundle_index.find(name);
+  if (it == s_bundle_index.end())
+    return std::nullopt;
+
+  std::string ret;
+  ret.resize(it->second.uncompressed_size);
+  if (!ReadEntry(name, ret.data()))
+    return std::nullopt;
+
+  return ret;
+}
+
+std::optional<std::time_t> ResourceBundle::GetTimestamp()
+{
+  if (!IsOpen())
+    return std::nullopt;
+
+  return s_bundle_timestamp;
+}
+
+bool ResourceBundle::Create(const char* directory, const char* output_path, Error* error)
+{
+  FileSystem::FindResultsArray files;
+  FileSystem::FindFiles(directory, "*",
+                        FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_RECURSIVE | FILESYSTEM_FIND_RELATIVE_PATHS, &files);
+  if (files.empty())
+  {
+    Error::SetStringFmt(error, "No files found in '{}'.", directory);
+    return false;
+  }
+
+  // sorted so the output is deterministic for a given input tree
+  std::sort(files.begin(), files.end(),
+            [](const FILESYSTEM_FIND_DATA& lhs, const FILESYSTEM_FIND_DATA& rhs) { return (lhs.FileName < rhs.FileName); });
+
+  std::vector<BundleEntry> entries;
+  std::string name_table;
+  std::vector<u8> data;
+  entries.reserve(files.size());
+
+  for (const FILESYSTEM_FIND_DATA& fd : files)
+  {
+    const std::string path = Path::Combine(directory, fd.FileName);
+    std::optional<std::vector<u8>> file_data = FileSystem::ReadBinaryFile(path.c_str());
+    if (!file_data.has_value())
+    {
+      Error::SetStringFmt(error, "Failed to read '{}'.", path);
+      return false;
+    }
+
+    std::string name = fd.FileName;
+#ifdef _WIN32
+    std::replace(name.begin(), name.end(), FS_OSPATH_SEPARATOR_CHARACTER, '/');
+#endif
+
+    BundleEntry entry = {};
+    entry.name_offset = static_cast<u32>(name_table.size());
+    entry.name_size = static_cast<u32>(name.size());
+    entry.uncompressed_size = static_cast<u32>(file_data->size());
+    name_table.append(name);
+
+    std::vector<u8> compressed(ZSTD_compressBound(file_data->size()));
+    const size_t result = ZSTD_compress(compressed.data(), compressed.size(), file_data->data(), file_data->size(),
+                                        BUNDLE_COMPRESSION_LEVEL);
+    if (ZSTD_isError(result))
+    {
+      Error::SetStringFmt(error, "Failed to compress '{}': {}", path, ZSTD_getErrorName(result));
+      return false;
+    }
+
+    // only keep the compressed copy when it's actually smaller
+    if (result < file_data->size())
+    {
+      entry.compressed_size = static_cast<u32>(result);
+      data.insert(data.end(), compressed.data(), compressed.data() + result);
+    }
+    else
+    {
+      entry.compressed_size = entry.uncompressed_size;
+      data.insert(data.end(), file_data->data(), file_data->data() + file_data->size());
+    }
+
+    entries.push_back(entry);
+  }
+
+  // fix up data offsets now that the table sizes are known
+  const u64 data_start =
+    sizeof(BundleHeader) + (sizeof(BundleEntry) * static_cast<u64>(entries.size())) + name_table.size();
+  u64 data_offset = data_start;
+  for (BundleEntry& entry : entries)
+  {
+    entry.data_offset = data_offset;
+    data_offset += entry.compressed_size;
+  }
+
+  BundleHeader header = {};
+  std::memcpy(header.magic, BUNDLE_MAGIC, sizeof(header.magic));
+  header.entry_count = static_cast<u32>(entries.size());
+  header.name_table_size = static_cast<u32>(name_table.size());
+
+  auto fp = FileSystem::OpenManagedCFile(output_path, "wb", error);
+  if (!fp)
+    return false;
+
+  if (std::fwrite(&header, sizeof(header), 1, fp.get()) != 1 ||
+      std::fwrite(entries.data(), sizeof(BundleEntry), entries.size(), fp.get()) != entries.size() ||
+      (!name_table.empty() && std::fwrite(name_table.data(), name_table.size(), 1, fp.get()) != 1) ||
+      std::fwrite(data.data(), data.size(), 1, fp.get()) != 1)
+  {
+    Error::SetStringFmt(error, "Failed to write '{}'.", output_path);
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2019-2024 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "common/types.h"
+
+#include <ctime>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Error;
+
+// Optional compressed archive of the resources directory. When a bundle file is shipped next to
+// (or instead of) the loose resources directory, opening it is a single map of the file; the
+// entry index is parsed up front and entries are decompressed individually on first use, so cold
+// boot does not open/read/close every resource file separately. The host resource functions fall
+// back to the bundle when the loose file is missing, so user overrides and unpacked development
+// trees keep working unchanged.
+namespace ResourceBundle {
+
+/// Name of the bundle file, expected next to the resources directory in the application root.
+static constexpr char DEFAULT_FILENAME[] = "resources.bundle";
+
+/// Maps the bundle at the given path and parses its index. Quietly returns false if the file does
+/// not exist; logs and returns false if it exists but is malformed.
+bool Open(const char* path);
+
+/// Returns true if a bundle was successfully opened.
+bool IsOpen();
+
+/// Unmaps the bundle and drops the index.
+void Close();
+
+/// Returns true if the bundle contains the named entry. Names use forward slashes and are
+/// relative to the resources directory, the same form the Host resource functions take.
+bool HasFile(std::string_view name);
+
+/// Decompresses and returns the named entry, or nullopt if it is not in the bundle.
+std::optional<std::vector<u8>> ReadBinaryFile(std::string_view name);
+std::optional<std::string> ReadFileToString(std::string_view name);
+
+/// Entries do not carry individual timestamps; the modification time of the bundle file itself
+/// stands in for all of them. Returns nullopt when no bundle is open.
+std::optional<std::time_t> GetTimestamp();
+
+/// Packs every file under the given directory into a bundle at output_path. Used by packaging,
+/// not at runtime.
+bool Create(const char* directory, const char* output_path, Error* error);
+
+} // namespace ResourceBundle
@@ -14,8 +14,10 @@
 
 #include "fmt/format.h"
 
+#include <atomic>
 #include <cstring>
 #include <memory>
+#include <mutex>
 Log_SetChannel(SPIRVCompiler);
 
 // glslang includes
@@ -32,24 +34,21 @@ namespace SPIRVCompiler {
 static std::optional<SPIRVCodeVector> CompileShaderToSPV(EShLanguage stage, const char* stage_filename,
                                                          std::string_view source, u32 options);
 
-static unsigned s_next_bad_shader_id = 1;
+static std::atomic<unsigned> s_next_bad_shader_id{1};
 } // namespace SPIRVCompiler
 
 std::optional<SPIRVCompiler::SPIRVCodeVector>
 SPIRVCompiler::CompileShaderToSPV(EShLanguage stage, const char* stage_filename, std::string_view source, u32 options)
 {
-  static bool glslang_initialized = false;
-  if (!glslang_initialized)
-  {
+  // Once the process is initialized, glslang is safe to use from multiple threads concurrently;
+  // each TShader/TProgram is independent and the pool allocator is thread-local.
+  static std::once_flag glslang_initialized;
+  std::call_once(glslang_initialized, []() {
     if (!glslang::InitializeProcess())
-    {
       Panic("Failed to initialize glslang shader compiler");
-      return std::nullopt;
-    }
 
     std::atexit(&glslang::FinalizeProcess);
-    glslang_initialized = true;
-  }
+  });
 
   std::unique_ptr<glslang::TShader> shader = std::make_unique<glslang::TShader>(stage);
   std::unique_ptr<glslang::TProgram> program;
@@ -13,19 +13,24 @@ StateWrapper::StateWrapper(ByteStream* stream, Mode mode, u32 version)
 {
 }
 
+StateWrapper::StateWrapper(void* buffer, size_t buffer_size, Mode mode, u32 version)
+  : m_stream(nullptr), m_buffer(static_cast<u8*>(buffer)), m_buffer_size(buffer_size), m_mode(mode), m_version(version)
+{
+}
+
 StateWrapper::~StateWrapper() = default;
 
 void StateWrapper::DoBytes(void* data, size_t length)
 {
   if (m_mode == Mode::Read)
   {
-    if (m_error || (m_error |= !m_stream->Read2(data, static_cast<u32>(length))) == true)
+    if (m_error || (m_error |= !ReadData(data, length)) == true)
       std::memset(data, 0, length);
   }
   else
   {
     if (!m_error)
-      m_error |= !m_stream->Write2(data, static_cast<u32>(length));
+      m_error |= !WriteData(data, length);
   }
 }
 
@@ -46,14 +51,14 @@ void StateWrapper::Do(bool* value_ptr)
   {
     u8 value = 0;
     if (!m_error)
-      m_error |= !m_stream->ReadByte(&value);
+      m_error |= !ReadData(&value, sizeof(value));
     *value_ptr = (value != 0);
   }
   else
   {
     u8 value = static_cast<u8>(*value_ptr);
     if (!m_error)
-      m_error |= !m_stream->WriteByte(value);
+      m_error |= !WriteData(&value, sizeof(value));
   }
 }
 
@@ -87,8 +92,8 @@ bool StateWrapper::DoMarker(const char* marker)
   if (m_mode == Mode::Write || file_value.equals(marker))
     return true;
 
-  Log_ErrorPrintf("Marker mismatch at offset %" PRIu64 ": found '%s' expected '%s'", m_stream->GetPosition(),
-                  file_value.c_str(), marker);
+  Log_ErrorPrintf("Marker mismatch at offset %" PRIu64 ": found '%s' expected '%s'", GetPosition(), file_value.c_str(),
+                  marker);
 
   return false;
 }
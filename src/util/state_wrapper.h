@@ -24,10 +24,16 @@ public:
   };
 
   StateWrapper(ByteStream* stream, Mode mode, u32 version);
+
+  /// Raw-memory fast path for memory save states (rewind/runahead). Skips the per-field virtual
+  /// stream dispatch; running past the end of the buffer sets the error flag.
+  StateWrapper(void* buffer, size_t buffer_size, Mode mode, u32 version);
+
   StateWrapper(const StateWrapper&) = delete;
   ~StateWrapper();
 
   ByteStream* GetStream() const { return m_stream; }
+  u64 GetPosition() const { return m_buffer ? static_cast<u64>(m_buffer_pos) : m_stream->GetPosition(); }
   bool HasError() const { return m_error; }
   bool IsReading() const { return (m_mode == Mode::Read); }
   bool IsWriting() const { return (m_mode == Mode::Write); }
@@ -41,13 +47,13 @@ public:
   {
     if (m_mode == Mode::Read)
     {
-      if (m_error || (m_error |= !m_stream->Read2(value_ptr, sizeof(T))) == true)
+      if (m_error || (m_error |= !ReadData(value_ptr, sizeof(T))) == true)
         *value_ptr = static_cast<T>(0);
     }
     else
     {
       if (!m_error)
-        m_error |= !m_stream->Write2(value_ptr, sizeof(T));
+        m_error |= !WriteData(value_ptr, sizeof(T));
     }
   }
 
@@ -59,7 +65,7 @@ public:
     if (m_mode == Mode::Read)
     {
       TType temp;
-      if (m_error || (m_error |= !m_stream->Read2(&temp, sizeof(TType))) == true)
+      if (m_error || (m_error |= !ReadData(&temp, sizeof(TType))) == true)
         temp = static_cast<TType>(0);
 
       *value_ptr = static_cast<T>(temp);
@@ -69,7 +75,7 @@ public:
       TType temp;
       std::memcpy(&temp, value_ptr, sizeof(TType));
       if (!m_error)
-        m_error |= !m_stream->Write2(&temp, sizeof(TType));
+        m_error |= !WriteData(&temp, sizeof(TType));
     }
   }
 
@@ -79,13 +85,13 @@ public:
   {
     if (m_mode == Mode::Read)
     {
-      if (m_error || (m_error |= !m_stream->Read2(value_ptr, sizeof(T))) == true)
+      if (m_error || (m_error |= !ReadData(value_ptr, sizeof(T))) == true)
         std::memset(value_ptr, 0, sizeof(*value_ptr));
     }
     else
     {
       if (!m_error)
-        m_error |= !m_stream->Write2(value_ptr, sizeof(T));
+        m_error |= !WriteData(value_ptr, sizeof(T));
     }
   }
 
@@ -201,11 +207,56 @@ public:
     }
 
     if (!m_error)
-      m_error = !m_stream->SeekRelative(static_cast<s64>(count));
+    {
+      if (m_buffer)
+      {
+        if ((m_buffer_size - m_buffer_pos) >= count)
+          m_buffer_pos += count;
+        else
+          m_error = true;
+      }
+      else
+      {
+        m_error = !m_stream->SeekRelative(static_cast<s64>(count));
+      }
+    }
   }
 
 private:
+  bool ReadData(void* data, size_t size)
+  {
+    if (m_buffer)
+    {
+      if ((m_buffer_size - m_buffer_pos) < size)
+        return false;
+
+      std::memcpy(data, m_buffer + m_buffer_pos, size);
+      m_buffer_pos += size;
+      return true;
+    }
+
+    return m_stream->Read2(data, static_cast<u32>(size));
+  }
+
+  bool WriteData(const void* data, size_t size)
+  {
+    if (m_buffer)
+    {
+      if ((m_buffer_size - m_buffer_pos) < size)
+        return false;
+
+      std::memcpy(m_buffer + m_buffer_pos, data, size);
+      m_buffer_pos += size;
+      return true;
+    }
+
+    return m_stream->Write2(data, static_cast<u32>(size));
+  }
+
   ByteStream* m_stream;
+  u8* m_buffer = nullptr;
+  size_t m_buffer_size = 0;
+  size_t m_buffer_pos = 0;
   Mode m_mode;
   u32 m_version;
   bool m_error = false;
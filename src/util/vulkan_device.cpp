@@ -61,6 +61,7 @@ enum : u32
   VERTEX_UNIFORM_BUFFER_SIZE = 8 * 1024 * 1024,
   FRAGMENT_UNIFORM_BUFFER_SIZE = 8 * 1024 * 1024,
   TEXTURE_BUFFER_SIZE = 64 * 1024 * 1024,
+  MAX_TEXTURE_BUFFER_SIZE = 256 * 1024 * 1024,
 
   UNIFORM_PUSH_CONSTANTS_STAGES = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
   UNIFORM_PUSH_CONSTANTS_SIZE = 128,
@@ -393,6 +394,10 @@ bool VulkanDevice::SelectDeviceExtensions(ExtensionList* extension_list, bool en
     SupportsExtension(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME, false) &&
     SupportsExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME, false);
   m_optional_extensions.vk_khr_push_descriptor = SupportsExtension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, false);
+  m_optional_extensions.vk_khr_present_id =
+    enable_surface && SupportsExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME, false);
+  m_optional_extensions.vk_khr_present_wait =
+    m_optional_extensions.vk_khr_present_id && SupportsExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME, false);
   m_optional_extensions.vk_ext_external_memory_host =
     SupportsExtension(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME, false);
 
@@ -485,6 +490,22 @@ bool VulkanDevice::CreateDevice(VkSurfaceKHR surface, bool enable_validation_lay
     return false;
   }
 
+  // Look for a dedicated transfer queue family (the copy engine on discrete GPUs), so that uploads
+  // can overlap with rendering instead of serializing on the graphics queue.
+  m_transfer_queue_family_index = queue_family_count;
+  for (u32 i = 0; i < queue_family_count; i++)
+  {
+    if (i == m_graphics_queue_family_index || (surface != VK_NULL_HANDLE && i == m_present_queue_family_index))
+      continue;
+
+    const VkQueueFlags flags = queue_family_properties[i].queueFlags;
+    if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+    {
+      m_transfer_queue_family_index = i;
+      break;
+    }
+  }
+
   VkDeviceCreateInfo device_info = {};
   device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
   device_info.pNext = nullptr;
@@ -492,7 +513,7 @@ bool VulkanDevice::CreateDevice(VkSurfaceKHR surface, bool enable_validation_lay
   device_info.queueCreateInfoCount = 0;
 
   static constexpr float queue_priorities[] = {1.0f};
-  std::array<VkDeviceQueueCreateInfo, 2> queue_infos;
+  std::array<VkDeviceQueueCreateInfo, 3> queue_infos;
   VkDeviceQueueCreateInfo& graphics_queue_info = queue_infos[device_info.queueCreateInfoCount++];
   graphics_queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
   graphics_queue_info.pNext = nullptr;
@@ -512,6 +533,17 @@ bool VulkanDevice::CreateDevice(VkSurfaceKHR surface, bool enable_validation_lay
     present_queue_info.pQueuePriorities = queue_priorities;
   }
 
+  if (m_transfer_queue_family_index != queue_family_count)
+  {
+    VkDeviceQueueCreateInfo& transfer_queue_info = queue_infos[device_info.queueCreateInfoCount++];
+    transfer_queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    transfer_queue_info.pNext = nullptr;
+    transfer_queue_info.flags = 0;
+    transfer_queue_info.queueFamilyIndex = m_transfer_queue_family_index;
+    transfer_queue_info.queueCount = 1;
+    transfer_queue_info.pQueuePriorities = queue_priorities;
+  }
+
   device_info.pQueueCreateInfos = queue_infos.data();
 
   ExtensionList enabled_extensions;
@@ -542,6 +574,10 @@ bool VulkanDevice::CreateDevice(VkSurfaceKHR surface, bool enable_validation_lay
     VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ATTACHMENT_FEEDBACK_LOOP_LAYOUT_FEATURES_EXT, nullptr, VK_TRUE};
   VkPhysicalDeviceDynamicRenderingFeatures dynamic_rendering_feature = {
     VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES, nullptr, VK_TRUE};
+  VkPhysicalDevicePresentIdFeaturesKHR present_id_feature = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+                                                             nullptr, VK_TRUE};
+  VkPhysicalDevicePresentWaitFeaturesKHR present_wait_feature = {
+    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR, nullptr, VK_TRUE};
 
   if (m_optional_extensions.vk_ext_rasterization_order_attachment_access)
     Vulkan::AddPointerToChain(&device_info, &rasterization_order_access_feature);
@@ -549,6 +585,10 @@ bool VulkanDevice::CreateDevice(VkSurfaceKHR surface, bool enable_validation_lay
     Vulkan::AddPointerToChain(&device_info, &attachment_feedback_loop_feature);
   if (m_optional_extensions.vk_khr_dynamic_rendering)
     Vulkan::AddPointerToChain(&device_info, &dynamic_rendering_feature);
+  if (m_optional_extensions.vk_khr_present_id)
+    Vulkan::AddPointerToChain(&device_info, &present_id_feature);
+  if (m_optional_extensions.vk_khr_present_wait)
+    Vulkan::AddPointerToChain(&device_info, &present_wait_feature);
 
   VkResult res = vkCreateDevice(m_physical_device, &device_info, nullptr, &m_device);
   if (res != VK_SUCCESS)
@@ -565,6 +605,11 @@ bool VulkanDevice::CreateDevice(VkSurfaceKHR surface, bool enable_validation_lay
   vkGetDeviceQueue(m_device, m_graphics_queue_family_index, 0, &m_graphics_queue);
   if (surface)
     vkGetDeviceQueue(m_device, m_present_queue_family_index, 0, &m_present_queue);
+  if (m_transfer_queue_family_index != queue_family_count)
+  {
+    vkGetDeviceQueue(m_device, m_transfer_queue_family_index, 0, &m_transfer_queue);
+    Log_DevPrintf("Using dedicated transfer queue (family %u) for uploads", m_transfer_queue_family_index);
+  }
 
   m_features.gpu_timing = (m_device_properties.limits.timestampComputeAndGraphics != 0 &&
                            queue_family_properties[m_graphics_queue_family_index].timestampValidBits > 0 &&
@@ -590,6 +635,10 @@ void VulkanDevice::ProcessDeviceExtensions()
     VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ATTACHMENT_FEEDBACK_LOOP_LAYOUT_FEATURES_EXT, nullptr, VK_FALSE};
   VkPhysicalDeviceDynamicRenderingFeatures dynamic_rendering_feature = {
     VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES, nullptr, VK_FALSE};
+  VkPhysicalDevicePresentIdFeaturesKHR present_id_feature = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+                                                             nullptr, VK_FALSE};
+  VkPhysicalDevicePresentWaitFeaturesKHR present_wait_feature = {
+    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR, nullptr, VK_FALSE};
 
   // add in optional feature structs
   if (m_optional_extensions.vk_ext_rasterization_order_attachment_access)
@@ -598,6 +647,10 @@ void VulkanDevice::ProcessDeviceExtensions()
     Vulkan::AddPointerToChain(&features2, &attachment_feedback_loop_feature);
   if (m_optional_extensions.vk_khr_dynamic_rendering)
     Vulkan::AddPointerToChain(&features2, &dynamic_rendering_feature);
+  if (m_optional_extensions.vk_khr_present_id)
+    Vulkan::AddPointerToChain(&features2, &present_id_feature);
+  if (m_optional_extensions.vk_khr_present_wait)
+    Vulkan::AddPointerToChain(&features2, &present_wait_feature);
 
   // we might not have VK_KHR_get_physical_device_properties2...
   if (!vkGetPhysicalDeviceFeatures2 || !vkGetPhysicalDeviceProperties2 || !vkGetPhysicalDeviceMemoryProperties2)
@@ -630,6 +683,10 @@ void VulkanDevice::ProcessDeviceExtensions()
   m_optional_extensions.vk_ext_attachment_feedback_loop_layout &=
     (attachment_feedback_loop_feature.attachmentFeedbackLoopLayout == VK_TRUE);
   m_optional_extensions.vk_khr_dynamic_rendering &= (dynamic_rendering_feature.dynamicRendering == VK_TRUE);
+  m_optional_extensions.vk_khr_present_id &= (present_id_feature.presentId == VK_TRUE);
+  m_optional_extensions.vk_khr_present_wait &=
+    (m_optional_extensions.vk_khr_present_id && present_wait_feature.presentWait == VK_TRUE &&
+     vkWaitForPresentKHR != nullptr);
 
   VkPhysicalDeviceProperties2 properties2 = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, nullptr, {}};
   VkPhysicalDevicePushDescriptorPropertiesKHR push_descriptor_properties = {
@@ -693,6 +750,8 @@ void VulkanDevice::ProcessDeviceExtensions()
                  m_optional_extensions.vk_khr_push_descriptor ? "supported" : "NOT supported");
   Log_InfoPrintf("VK_EXT_external_memory_host is %s",
                  m_optional_extensions.vk_ext_external_memory_host ? "supported" : "NOT supported");
+  Log_InfoPrintf("VK_KHR_present_wait is %s",
+                 m_optional_extensions.vk_khr_present_wait ? "supported" : "NOT supported");
 }
 
 bool VulkanDevice::CreateAllocator()
@@ -854,6 +913,42 @@ bool VulkanDevice::CreateCommandBuffers()
                             TinyString::from_format("Frame Descriptor Pool {}", frame_index));
     }
 
+    if (m_transfer_queue != VK_NULL_HANDLE)
+    {
+      VkCommandPoolCreateInfo transfer_pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, nullptr, 0,
+                                                    m_transfer_queue_family_index};
+      res = vkCreateCommandPool(m_device, &transfer_pool_info, nullptr, &resources.transfer_command_pool);
+      if (res != VK_SUCCESS)
+      {
+        LOG_VULKAN_ERROR(res, "vkCreateCommandPool failed: ");
+        return false;
+      }
+      Vulkan::SetObjectName(m_device, resources.transfer_command_pool,
+                            TinyString::from_format("Frame Transfer Command Pool {}", frame_index));
+
+      VkCommandBufferAllocateInfo transfer_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr,
+                                                          resources.transfer_command_pool,
+                                                          VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1u};
+      res = vkAllocateCommandBuffers(m_device, &transfer_buffer_info, &resources.transfer_command_buffer);
+      if (res != VK_SUCCESS)
+      {
+        LOG_VULKAN_ERROR(res, "vkAllocateCommandBuffers failed: ");
+        return false;
+      }
+      Vulkan::SetObjectName(m_device, resources.transfer_command_buffer,
+                            TinyString::from_format("Frame {} Transfer Command Buffer", frame_index));
+
+      const VkSemaphoreCreateInfo semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, nullptr, 0};
+      res = vkCreateSemaphore(m_device, &semaphore_info, nullptr, &resources.transfer_semaphore);
+      if (res != VK_SUCCESS)
+      {
+        LOG_VULKAN_ERROR(res, "vkCreateSemaphore failed: ");
+        return false;
+      }
+      Vulkan::SetObjectName(m_device, resources.transfer_semaphore,
+                            TinyString::from_format("Frame Transfer Semaphore {}", frame_index));
+    }
+
     ++frame_index;
   }
 
@@ -869,6 +964,12 @@ void VulkanDevice::DestroyCommandBuffers()
       vkDestroyFence(m_device, resources.fence, nullptr);
     if (resources.descriptor_pool != VK_NULL_HANDLE)
       vkDestroyDescriptorPool(m_device, resources.descriptor_pool, nullptr);
+    if (resources.transfer_semaphore != VK_NULL_HANDLE)
+      vkDestroySemaphore(m_device, resources.transfer_semaphore, nullptr);
+    if (resources.transfer_command_buffer != VK_NULL_HANDLE)
+      vkFreeCommandBuffers(m_device, resources.transfer_command_pool, 1, &resources.transfer_command_buffer);
+    if (resources.transfer_command_pool != VK_NULL_HANDLE)
+      vkDestroyCommandPool(m_device, resources.transfer_command_pool, nullptr);
     if (resources.command_buffers[0] != VK_NULL_HANDLE)
     {
       vkFreeCommandBuffers(m_device, resources.command_pool, static_cast<u32>(resources.command_buffers.size()),
@@ -1078,6 +1179,21 @@ VkCommandBuffer VulkanDevice::GetCurrentInitCommandBuffer()
   return buf;
 }
 
+VkCommandBuffer VulkanDevice::GetCurrentTransferCommandBuffer()
+{
+  CommandBuffer& res = m_frame_resources[m_current_frame];
+  DebugAssert(res.transfer_command_buffer != VK_NULL_HANDLE);
+  VkCommandBuffer buf = res.transfer_command_buffer;
+  if (res.transfer_buffer_used)
+    return buf;
+
+  VkCommandBufferBeginInfo bi{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
+                              VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr};
+  vkBeginCommandBuffer(buf, &bi);
+  res.transfer_buffer_used = true;
+  return buf;
+}
+
 VkDescriptorSet VulkanDevice::AllocateDescriptorSet(VkDescriptorSetLayout set_layout)
 {
   VkDescriptorSetAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO, nullptr,
@@ -1249,6 +1365,16 @@ void VulkanDevice::SubmitCommandBuffer(VulkanSwapChain* present_swap_chain /* =
     }
   }
 
+  if (resources.transfer_buffer_used)
+  {
+    res = vkEndCommandBuffer(resources.transfer_command_buffer);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkEndCommandBuffer failed: ");
+      Panic("Failed to end transfer command buffer");
+    }
+  }
+
   if (m_gpu_timing_enabled && resources.timestamp_written)
   {
     vkCmdWriteTimestamp(m_current_command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, m_timestamp_query_pool,
@@ -1286,7 +1412,30 @@ void VulkanDevice::DoSubmitCommandBuffer(u32 index, VulkanSwapChain* present_swa
 {
   CommandBuffer& resources = m_frame_resources[index];
 
-  uint32_t wait_bits = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  if (resources.transfer_buffer_used)
+  {
+    // Kick the uploads off to the copy engine first. The graphics submit below waits on the semaphore,
+    // and its fence covers the lifetime of anything the transfer queue touched.
+    const VkSubmitInfo transfer_submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO, nullptr, 0u, nullptr, nullptr, 1u,
+                                               &resources.transfer_command_buffer, 1u, &resources.transfer_semaphore};
+    const VkResult transfer_res = vkQueueSubmit(m_transfer_queue, 1, &transfer_submit_info, VK_NULL_HANDLE);
+    if (transfer_res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(transfer_res, "vkQueueSubmit for transfer queue failed: ");
+      m_last_submit_failed.store(true, std::memory_order_release);
+      return;
+    }
+  }
+
+  std::array<VkSemaphore, 2> wait_semaphores;
+  std::array<VkPipelineStageFlags, 2> wait_stages;
+  u32 num_wait_semaphores = 0;
+  if (resources.transfer_buffer_used)
+  {
+    wait_semaphores[num_wait_semaphores] = resources.transfer_semaphore;
+    wait_stages[num_wait_semaphores++] = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+  }
+
   VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO,
                               nullptr,
                               0u,
@@ -1300,14 +1449,20 @@ void VulkanDevice::DoSubmitCommandBuffer(u32 index, VulkanSwapChain* present_swa
 
   if (present_swap_chain)
   {
-    submit_info.pWaitSemaphores = present_swap_chain->GetImageAvailableSemaphorePtr();
-    submit_info.waitSemaphoreCount = 1;
-    submit_info.pWaitDstStageMask = &wait_bits;
+    wait_semaphores[num_wait_semaphores] = *present_swap_chain->GetImageAvailableSemaphorePtr();
+    wait_stages[num_wait_semaphores++] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 
     submit_info.pSignalSemaphores = present_swap_chain->GetRenderingFinishedSemaphorePtr();
     submit_info.signalSemaphoreCount = 1;
   }
 
+  if (num_wait_semaphores > 0)
+  {
+    submit_info.waitSemaphoreCount = num_wait_semaphores;
+    submit_info.pWaitSemaphores = wait_semaphores.data();
+    submit_info.pWaitDstStageMask = wait_stages.data();
+  }
+
   const VkResult res = vkQueueSubmit(m_graphics_queue, 1, &submit_info, resources.fence);
   if (res != VK_SUCCESS)
   {
@@ -1319,14 +1474,23 @@ void VulkanDevice::DoSubmitCommandBuffer(u32 index, VulkanSwapChain* present_swa
 
 void VulkanDevice::DoPresent(VulkanSwapChain* present_swap_chain)
 {
-  const VkPresentInfoKHR present_info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-                                         nullptr,
-                                         1,
-                                         present_swap_chain->GetRenderingFinishedSemaphorePtr(),
-                                         1,
-                                         present_swap_chain->GetSwapChainPtr(),
-                                         present_swap_chain->GetCurrentImageIndexPtr(),
-                                         nullptr};
+  VkPresentInfoKHR present_info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+                                   nullptr,
+                                   1,
+                                   present_swap_chain->GetRenderingFinishedSemaphorePtr(),
+                                   1,
+                                   present_swap_chain->GetSwapChainPtr(),
+                                   present_swap_chain->GetCurrentImageIndexPtr(),
+                                   nullptr};
+
+  // Tag the present with an identifier, so we can wait for it to hit the screen below.
+  u64 present_id = 0;
+  VkPresentIdKHR present_id_info = {VK_STRUCTURE_TYPE_PRESENT_ID_KHR, nullptr, 1, &present_id};
+  if (m_optional_extensions.vk_khr_present_wait)
+  {
+    present_id = present_swap_chain->GetNextPresentId();
+    Vulkan::AddPointerToChain(&present_info, &present_id_info);
+  }
 
   present_swap_chain->ReleaseCurrentImage();
 
@@ -1345,6 +1509,18 @@ void VulkanDevice::DoPresent(VulkanSwapChain* present_swap_chain)
   // submission. Don't care if it fails, we'll deal with that at the presentation call site.
   // Credit to dxvk for the idea.
   present_swap_chain->AcquireNextImage();
+
+  // Block until the present N frames ago has actually reached the screen, bounding the number
+  // of frames the driver can queue ahead of the display. A finite timeout keeps us from hanging
+  // if the compositor never presents (e.g. when the window is minimized).
+  if (m_optional_extensions.vk_khr_present_wait && present_id > m_max_queued_frames)
+  {
+    static constexpr u64 PRESENT_WAIT_TIMEOUT_NS = 100000000ULL; // 100ms
+    const VkResult wait_res = vkWaitForPresentKHR(m_device, present_swap_chain->GetSwapChain(),
+                                                  present_id - m_max_queued_frames, PRESENT_WAIT_TIMEOUT_NS);
+    if (wait_res != VK_SUCCESS && wait_res != VK_TIMEOUT && wait_res != VK_SUBOPTIMAL_KHR)
+      LOG_VULKAN_ERROR(wait_res, "vkWaitForPresentKHR failed: ");
+  }
 }
 
 void VulkanDevice::WaitForPresentComplete()
@@ -1429,6 +1605,13 @@ void VulkanDevice::BeginCommandBuffer(u32 index)
   if (res != VK_SUCCESS)
     LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
 
+  if (resources.transfer_command_pool != VK_NULL_HANDLE)
+  {
+    res = vkResetCommandPool(m_device, resources.transfer_command_pool, 0);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
+  }
+
   // Enable commands to be recorded to the two buffers again.
   VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
                                          VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr};
@@ -1453,6 +1636,7 @@ void VulkanDevice::BeginCommandBuffer(u32 index)
 
   resources.fence_counter = m_next_fence_counter++;
   resources.init_buffer_used = false;
+  resources.transfer_buffer_used = false;
   resources.timestamp_written = m_gpu_timing_enabled;
 
   m_current_frame = index;
@@ -1509,6 +1693,69 @@ bool VulkanDevice::CheckLastSubmitFail()
   return m_last_submit_failed.load(std::memory_order_acquire);
 }
 
+bool VulkanDevice::AcquireUploadStagingBuffer(u32 size, UploadStagingBuffer* out)
+{
+  const u32 bucket_size = std::max<u32>(Common::NextPow2(size), MIN_UPLOAD_STAGING_BUFFER_SIZE);
+
+  for (auto it = m_upload_staging_pool.begin(); it != m_upload_staging_pool.end(); ++it)
+  {
+    if (it->size != bucket_size || it->fence_counter > m_completed_fence_counter)
+      continue;
+
+    *out = *it;
+    m_upload_staging_pool_size -= bucket_size;
+    m_upload_staging_pool.erase(it);
+    return true;
+  }
+
+  const u32 queue_families[2] = {m_graphics_queue_family_index, m_transfer_queue_family_index};
+  const bool concurrent_sharing = HasTransferQueue();
+  const VkBufferCreateInfo bci = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+                                  nullptr,
+                                  0,
+                                  static_cast<VkDeviceSize>(bucket_size),
+                                  VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                  concurrent_sharing ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+                                  concurrent_sharing ? 2u : 0u,
+                                  concurrent_sharing ? queue_families : nullptr};
+
+  // Don't worry about setting the coherent bit for this upload, the main reason we had
+  // that set in StreamBuffer was for MoltenVK, which would upload the whole buffer on
+  // smaller uploads, but we're writing to the whole thing anyway.
+  VmaAllocationCreateInfo aci = {};
+  aci.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+  aci.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+
+  VmaAllocationInfo ai;
+  const VkResult res = vmaCreateBuffer(m_allocator, &bci, &aci, &out->buffer, &out->allocation, &ai);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "(AcquireUploadStagingBuffer) vmaCreateBuffer() failed: ");
+    return false;
+  }
+
+  out->map_ptr = ai.pMappedData;
+  out->size = bucket_size;
+  out->fence_counter = 0;
+  return true;
+}
+
+void VulkanDevice::ReleaseUploadStagingBuffer(UploadStagingBuffer& buffer, u32 written_size)
+{
+  vmaFlushAllocation(m_allocator, buffer.allocation, 0, written_size);
+  buffer.fence_counter = GetCurrentFenceCounter();
+
+  // Bound the pool; anything past the cap takes the usual deferred-destruction path.
+  if ((m_upload_staging_pool_size + buffer.size) > MAX_UPLOAD_STAGING_POOL_SIZE)
+  {
+    DeferBufferDestruction(buffer.buffer, buffer.allocation);
+    return;
+  }
+
+  m_upload_staging_pool_size += buffer.size;
+  m_upload_staging_pool.push_back(buffer);
+}
+
 void VulkanDevice::DeferBufferDestruction(VkBuffer object, VmaAllocation allocation)
 {
   m_cleanup_objects.emplace_back(GetCurrentFenceCounter(),
@@ -2543,6 +2790,9 @@ bool VulkanDevice::CheckFeatures(FeatureMask disabled_features)
   m_features.pipeline_cache = true;
   m_features.prefer_unused_textures = true;
 
+  // vkCreateGraphicsPipelines() is thread-safe, including concurrent access to the pipeline cache.
+  m_features.threaded_pipeline_creation = true;
+
   return true;
 }
 
@@ -2711,7 +2961,10 @@ bool VulkanDevice::CreateBuffers()
     return false;
   }
 
-  if (!m_texture_upload_buffer.Create(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, TEXTURE_BUFFER_SIZE))
+  // The upload buffer grows under pressure rather than stalling, since high resolution scales
+  // with texture replacements can burst well past the default size. It has no persistent
+  // bindings, so swapping the buffer out from under the callers is safe.
+  if (!m_texture_upload_buffer.Create(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, TEXTURE_BUFFER_SIZE, MAX_TEXTURE_BUFFER_SIZE))
   {
     Log_ErrorPrint("Failed to allocate texture upload buffer");
     return false;
@@ -2722,6 +2975,11 @@ bool VulkanDevice::CreateBuffers()
 
 void VulkanDevice::DestroyBuffers()
 {
+  for (UploadStagingBuffer& buf : m_upload_staging_pool)
+    vmaDestroyBuffer(m_allocator, buf.buffer, buf.allocation);
+  m_upload_staging_pool.clear();
+  m_upload_staging_pool_size = 0;
+
   m_texture_upload_buffer.Destroy(false);
   m_uniform_buffer.Destroy(false);
   m_index_buffer.Destroy(false);
@@ -2847,6 +3105,11 @@ bool VulkanDevice::CreatePipelineLayouts()
   }
 
   {
+    // Push descriptors skip both the per-texture persistent set cache and vkUpdateDescriptorSets
+    // on the draw path, which is where the CPU time goes on weaker drivers. When unsupported,
+    // VulkanTexture::GetDescriptorSetWithSampler() allocates from this layout instead.
+    if (m_optional_extensions.vk_khr_push_descriptor)
+      dslb.SetPushFlag();
     dslb.AddBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT);
     if ((m_single_texture_ds_layout = dslb.Create(m_device)) == VK_NULL_HANDLE)
       return false;
@@ -3626,7 +3889,22 @@ bool VulkanDevice::UpdateDescriptorSetsForLayout(bool new_layout, bool new_dynam
                 layout == GPUPipeline::Layout::SingleTextureAndPushConstants)
   {
     DebugAssert(m_current_textures[0] && m_current_samplers[0] != VK_NULL_HANDLE);
-    ds[num_ds++] = m_current_textures[0]->GetDescriptorSetWithSampler(m_current_samplers[0]);
+    if (m_optional_extensions.vk_khr_push_descriptor)
+    {
+      Vulkan::DescriptorSetUpdateBuilder dsub;
+      dsub.AddCombinedImageSamplerDescriptorWrite(VK_NULL_HANDLE, 0, m_current_textures[0]->GetView(),
+                                                  m_current_samplers[0], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+      const u32 set = (layout == GPUPipeline::Layout::SingleTextureAndUBO) ? 1 : 0;
+      dsub.PushUpdate(GetCurrentCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS,
+                      m_pipeline_layouts[static_cast<u8>(m_current_pipeline_layout)], set);
+      if (num_ds == 0)
+        return true;
+    }
+    else
+    {
+      ds[num_ds++] = m_current_textures[0]->GetDescriptorSetWithSampler(m_current_samplers[0]);
+    }
   }
   else if constexpr (layout == GPUPipeline::Layout::SingleTextureBufferAndPushConstants)
   {
@@ -38,6 +38,10 @@ public:
   enum : u32
   {
     NUM_COMMAND_BUFFERS = 3,
+
+    /// Minimum bucket size and total cap for the recycled upload staging buffer pool.
+    MIN_UPLOAD_STAGING_BUFFER_SIZE = 1 * 1024 * 1024,
+    MAX_UPLOAD_STAGING_POOL_SIZE = 64 * 1024 * 1024,
   };
 
   struct OptionalExtensions
@@ -53,6 +57,8 @@ public:
     bool vk_khr_driver_properties : 1;
     bool vk_khr_dynamic_rendering : 1;
     bool vk_khr_push_descriptor : 1;
+    bool vk_khr_present_id : 1;
+    bool vk_khr_present_wait : 1;
     bool vk_ext_external_memory_host : 1;
   };
 
@@ -139,6 +145,8 @@ public:
   ALWAYS_INLINE VkPhysicalDevice GetVulkanPhysicalDevice() const { return m_physical_device; }
   ALWAYS_INLINE u32 GetGraphicsQueueFamilyIndex() const { return m_graphics_queue_family_index; }
   ALWAYS_INLINE u32 GetPresentQueueFamilyIndex() const { return m_present_queue_family_index; }
+  ALWAYS_INLINE u32 GetTransferQueueFamilyIndex() const { return m_transfer_queue_family_index; }
+  ALWAYS_INLINE bool HasTransferQueue() const { return m_transfer_queue != VK_NULL_HANDLE; }
   ALWAYS_INLINE const OptionalExtensions& GetOptionalExtensions() const { return m_optional_extensions; }
 
   /// Returns true if Vulkan is suitable as a default for the devices in the system.
@@ -178,6 +186,11 @@ public:
   ALWAYS_INLINE VulkanStreamBuffer& GetTextureUploadBuffer() { return m_texture_upload_buffer; }
   VkCommandBuffer GetCurrentInitCommandBuffer();
 
+  // Command buffer for the dedicated transfer queue, when one exists. Submitted before the frame's
+  // graphics work, which waits on it with a semaphore. Callers are responsible for releasing resource
+  // ownership back to the graphics queue family.
+  VkCommandBuffer GetCurrentTransferCommandBuffer();
+
   /// Allocates a descriptor set from the pool reserved for the current frame.
   VkDescriptorSet AllocateDescriptorSet(VkDescriptorSetLayout set_layout);
 
@@ -198,6 +211,26 @@ public:
   // TODO: move out of struct
   u64 GetCurrentFenceCounter() const { return m_frame_resources[m_current_frame].fence_counter; }
 
+  // Mapped host-visible buffer for uploads which don't fit in the texture stream buffer.
+  // Bucketed by power-of-two size and recycled once the owning fence completes, so
+  // steady-state large uploads (VRAM updates, texture replacements) don't hit the allocator.
+  struct UploadStagingBuffer
+  {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VmaAllocation allocation = nullptr;
+    void* map_ptr = nullptr;
+    u32 size = 0;
+    u64 fence_counter = 0;
+  };
+
+  /// Returns a mapped staging buffer of at least size bytes, reusing a pooled buffer when the
+  /// GPU has finished with one of the right bucket.
+  bool AcquireUploadStagingBuffer(u32 size, UploadStagingBuffer* out);
+
+  /// Flushes written data and returns the buffer to the pool once the current command buffer's
+  /// fence completes. The VkBuffer stays valid for commands recorded in the current buffer.
+  void ReleaseUploadStagingBuffer(UploadStagingBuffer& buffer, u32 written_size);
+
   // Schedule a vulkan resource for destruction later on. This will occur when the command buffer
   // is next re-used, and the GPU has finished working with the specified resource.
   void DeferBufferDestruction(VkBuffer object, VmaAllocation allocation);
@@ -277,10 +310,14 @@ private:
     // [0] - Init (upload) command buffer, [1] - draw command buffer
     VkCommandPool command_pool = VK_NULL_HANDLE;
     std::array<VkCommandBuffer, 2> command_buffers{VK_NULL_HANDLE, VK_NULL_HANDLE};
+    VkCommandPool transfer_command_pool = VK_NULL_HANDLE;
+    VkCommandBuffer transfer_command_buffer = VK_NULL_HANDLE;
+    VkSemaphore transfer_semaphore = VK_NULL_HANDLE;
     VkDescriptorPool descriptor_pool = VK_NULL_HANDLE;
     VkFence fence = VK_NULL_HANDLE;
     u64 fence_counter = 0;
     bool init_buffer_used = false;
+    bool transfer_buffer_used = false;
     bool needs_fence_wait = false;
     bool timestamp_written = false;
   };
@@ -396,8 +433,10 @@ private:
 
   VkQueue m_graphics_queue = VK_NULL_HANDLE;
   VkQueue m_present_queue = VK_NULL_HANDLE;
+  VkQueue m_transfer_queue = VK_NULL_HANDLE;
   u32 m_graphics_queue_family_index = 0;
   u32 m_present_queue_family_index = 0;
+  u32 m_transfer_queue_family_index = 0;
 
   VkQueryPool m_timestamp_query_pool = VK_NULL_HANDLE;
   float m_accumulated_gpu_time = 0.0f;
@@ -451,6 +490,8 @@ private:
   VulkanStreamBuffer m_index_buffer;
   VulkanStreamBuffer m_uniform_buffer;
   VulkanStreamBuffer m_texture_upload_buffer;
+  std::vector<UploadStagingBuffer> m_upload_staging_pool;
+  u32 m_upload_staging_pool_size = 0;
 
   VkDescriptorSet m_ubo_descriptor_set = VK_NULL_HANDLE;
   u32 m_uniform_buffer_position = 0;
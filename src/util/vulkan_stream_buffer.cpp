@@ -9,16 +9,22 @@
 #include "common/assert.h"
 #include "common/bitutils.h"
 #include "common/log.h"
+
+#include <algorithm>
+
 Log_SetChannel(VulkanDevice);
 
 VulkanStreamBuffer::VulkanStreamBuffer() = default;
 
 VulkanStreamBuffer::VulkanStreamBuffer(VulkanStreamBuffer&& move)
-  : m_size(move.m_size), m_current_offset(move.m_current_offset), m_current_space(move.m_current_space),
-    m_current_gpu_position(move.m_current_gpu_position), m_allocation(move.m_allocation), m_buffer(move.m_buffer),
+  : m_size(move.m_size), m_max_size(move.m_max_size), m_current_offset(move.m_current_offset),
+    m_current_space(move.m_current_space), m_current_gpu_position(move.m_current_gpu_position),
+    m_usage(move.m_usage), m_allocation(move.m_allocation), m_buffer(move.m_buffer),
     m_host_pointer(move.m_host_pointer), m_tracked_fences(std::move(move.m_tracked_fences))
 {
   move.m_size = 0;
+  move.m_max_size = 0;
+  move.m_usage = 0;
   move.m_current_offset = 0;
   move.m_current_space = 0;
   move.m_current_gpu_position = 0;
@@ -39,6 +45,8 @@ VulkanStreamBuffer& VulkanStreamBuffer::operator=(VulkanStreamBuffer&& move)
     Destroy(true);
 
   std::swap(m_size, move.m_size);
+  std::swap(m_max_size, move.m_max_size);
+  std::swap(m_usage, move.m_usage);
   std::swap(m_current_offset, move.m_current_offset);
   std::swap(m_current_space, move.m_current_space);
   std::swap(m_current_gpu_position, move.m_current_gpu_position);
@@ -49,16 +57,22 @@ VulkanStreamBuffer& VulkanStreamBuffer::operator=(VulkanStreamBuffer&& move)
   return *this;
 }
 
-bool VulkanStreamBuffer::Create(VkBufferUsageFlags usage, u32 size)
+bool VulkanStreamBuffer::Create(VkBufferUsageFlags usage, u32 size, u32 max_size /* = 0 */)
 {
+  VulkanDevice& dev = VulkanDevice::GetInstance();
+
+  // When a dedicated transfer queue exists, uploads sourced from this buffer may execute on it,
+  // so share the buffer between the two queue families instead of requiring ownership transfers.
+  const u32 queue_families[2] = {dev.GetGraphicsQueueFamilyIndex(), dev.GetTransferQueueFamilyIndex()};
+  const bool concurrent_sharing = dev.HasTransferQueue();
   const VkBufferCreateInfo bci = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
                                   nullptr,
                                   0,
                                   static_cast<VkDeviceSize>(size),
                                   usage,
-                                  VK_SHARING_MODE_EXCLUSIVE,
-                                  0,
-                                  nullptr};
+                                  concurrent_sharing ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+                                  concurrent_sharing ? 2u : 0u,
+                                  concurrent_sharing ? queue_families : nullptr};
 
   VmaAllocationCreateInfo aci = {};
   aci.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
@@ -81,6 +95,8 @@ bool VulkanStreamBuffer::Create(VkBufferUsageFlags usage, u32 size)
 
   // Replace with the new buffer
   m_size = size;
+  m_max_size = std::max(size, max_size);
+  m_usage = usage;
   m_current_offset = 0;
   m_current_gpu_position = 0;
   m_tracked_fences.clear();
@@ -101,6 +117,8 @@ void VulkanStreamBuffer::Destroy(bool defer)
   }
 
   m_size = 0;
+  m_max_size = 0;
+  m_usage = 0;
   m_current_offset = 0;
   m_current_gpu_position = 0;
   m_tracked_fences.clear();
@@ -114,7 +132,7 @@ bool VulkanStreamBuffer::ReserveMemory(u32 num_bytes, u32 alignment)
   const u32 required_bytes = num_bytes + alignment;
 
   // Check for sane allocations
-  if (required_bytes > m_size)
+  if (required_bytes > std::max(m_size, m_max_size))
   {
     Log_ErrorPrintf("Attempting to allocate %u bytes from a %u byte stream buffer", static_cast<u32>(num_bytes),
                     static_cast<u32>(m_size));
@@ -162,6 +180,21 @@ bool VulkanStreamBuffer::ReserveMemory(u32 num_bytes, u32 alignment)
     }
   }
 
+  // Out of space without waiting on the GPU. If growth is permitted, switch to a larger buffer
+  // instead of stalling; the old one goes onto the deferred-destruction list, so in-flight draws
+  // and copies keep their data. Callers re-fetch the handle/pointer after reserving, so the swap
+  // is transparent to them.
+  if (m_size < m_max_size)
+  {
+    const u32 new_size = std::min(std::max(m_size * 2, required_bytes), m_max_size);
+    Log_DevFmt("Growing {} byte stream buffer to {} bytes due to allocation pressure", m_size, new_size);
+    if (Create(m_usage, new_size, m_max_size))
+    {
+      m_current_space = m_size;
+      return true;
+    }
+  }
+
   // Can we find a fence to wait on that will give us enough memory?
   if (WaitForClearSpace(required_bytes))
   {
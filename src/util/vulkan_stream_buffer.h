@@ -30,7 +30,11 @@ public:
   ALWAYS_INLINE u32 GetCurrentSpace() const { return m_current_space; }
   ALWAYS_INLINE u32 GetCurrentOffset() const { return m_current_offset; }
 
-  bool Create(VkBufferUsageFlags usage, u32 size);
+  /// When max_size is greater than size, the buffer grows (doubling, up to max_size) instead of
+  /// stalling behind the GPU when an allocation cannot be satisfied without waiting. Only safe for
+  /// buffers whose handle is re-fetched after every ReserveMemory() call, i.e. not for anything
+  /// referenced by a persistent descriptor set or bound once per command buffer.
+  bool Create(VkBufferUsageFlags usage, u32 size, u32 max_size = 0);
   void Destroy(bool defer);
 
   bool ReserveMemory(u32 num_bytes, u32 alignment);
@@ -45,10 +49,12 @@ private:
   bool WaitForClearSpace(u32 num_bytes);
 
   u32 m_size = 0;
+  u32 m_max_size = 0;
   u32 m_current_offset = 0;
   u32 m_current_space = 0;
   u32 m_current_gpu_position = 0;
 
+  VkBufferUsageFlags m_usage = 0;
   VmaAllocation m_allocation = VK_NULL_HANDLE;
   VkBuffer m_buffer = VK_NULL_HANDLE;
   u8* m_host_pointer = nullptr;
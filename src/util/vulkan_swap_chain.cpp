@@ -76,6 +76,7 @@ static VkPresentModeKHR GetPreferredPresentModeForVsyncMode(DisplaySyncMode mode
     VK_PRESENT_MODE_IMMEDIATE_KHR,    // Disabled
     VK_PRESENT_MODE_FIFO_KHR,         // VSync
     VK_PRESENT_MODE_FIFO_RELAXED_KHR, // VSyncRelaxed
+    VK_PRESENT_MODE_MAILBOX_KHR,      // Mailbox
     VK_PRESENT_MODE_IMMEDIATE_KHR,    // VRR ??
   }};
 
@@ -309,10 +310,11 @@ std::optional<VkPresentModeKHR> VulkanSwapChain::SelectPresentMode(VkSurfaceKHR
     // Prefer mailbox over fifo for adaptive vsync/no-vsync.
     selected_mode = VK_PRESENT_MODE_MAILBOX_KHR;
   }
-  else if (requested_mode == VK_PRESENT_MODE_FIFO_RELAXED_KHR && CheckForMode(VK_PRESENT_MODE_FIFO_KHR))
+  else if ((requested_mode == VK_PRESENT_MODE_FIFO_RELAXED_KHR || requested_mode == VK_PRESENT_MODE_MAILBOX_KHR) &&
+           CheckForMode(VK_PRESENT_MODE_FIFO_KHR))
   {
-    // Fallback to FIFO if we're using any kind of vsync.
-    // This should never fail, FIFO is mandated.
+    // Fallback to FIFO if we're using any kind of vsync, or mailbox was asked for but is
+    // unavailable, since neither should tear. This should never fail, FIFO is mandated.
     selected_mode = VK_PRESENT_MODE_FIFO_KHR;
   }
   else
@@ -468,6 +470,9 @@ bool VulkanSwapChain::CreateSwapChain()
   if (old_swap_chain != VK_NULL_HANDLE)
     vkDestroySwapchainKHR(dev.GetVulkanDevice(), old_swap_chain, nullptr);
 
+  // Present identifiers are scoped to a swapchain, so restart the sequence.
+  m_next_present_id = 1;
+
   m_format = surface_format->format;
   m_window_info.surface_width = std::max(1u, size.width);
   m_window_info.surface_height = std::max(1u, size.height);
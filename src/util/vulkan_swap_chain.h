@@ -59,6 +59,10 @@ public:
     return &m_semaphores[m_current_semaphore].rendering_finished_semaphore;
   }
 
+  // Returns the identifier to attach to the next present, for use with VK_KHR_present_wait.
+  // Identifiers are monotonically increasing, and reset when the swap chain is recreated.
+  ALWAYS_INLINE u64 GetNextPresentId() { return m_next_present_id++; }
+
   // Returns true if the current present mode is synchronizing (adaptive or hard).
   ALWAYS_INLINE bool IsPresentModeSynchronizing() const
   {
@@ -115,6 +119,7 @@ private:
   VkPresentModeKHR m_actual_present_mode = VK_PRESENT_MODE_IMMEDIATE_KHR;
   u32 m_current_image = 0;
   u32 m_current_semaphore = 0;
+  u64 m_next_present_id = 1;
 
   std::optional<VkResult> m_image_acquire_result;
   std::optional<bool> m_exclusive_fullscreen_control;
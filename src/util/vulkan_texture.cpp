@@ -242,40 +242,18 @@ void VulkanTexture::CopyTextureDataForUpload(void* dst, const void* src, u32 wid
 VkBuffer VulkanTexture::AllocateUploadStagingBuffer(const void* data, u32 pitch, u32 upload_pitch, u32 width,
                                                     u32 height) const
 {
+  VulkanDevice& dev = VulkanDevice::GetInstance();
   const u32 size = upload_pitch * height;
-  const VkBufferCreateInfo bci = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-                                  nullptr,
-                                  0,
-                                  static_cast<VkDeviceSize>(size),
-                                  VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                  VK_SHARING_MODE_EXCLUSIVE,
-                                  0,
-                                  nullptr};
-
-  // Don't worry about setting the coherent bit for this upload, the main reason we had
-  // that set in StreamBuffer was for MoltenVK, which would upload the whole buffer on
-  // smaller uploads, but we're writing to the whole thing anyway.
-  VmaAllocationCreateInfo aci = {};
-  aci.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
-  aci.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
 
-  VmaAllocationInfo ai;
-  VkBuffer buffer;
-  VmaAllocation allocation;
-  VkResult res = vmaCreateBuffer(VulkanDevice::GetInstance().GetAllocator(), &bci, &aci, &buffer, &allocation, &ai);
-  if (res != VK_SUCCESS)
-  {
-    LOG_VULKAN_ERROR(res, "(AllocateUploadStagingBuffer) vmaCreateBuffer() failed: ");
+  VulkanDevice::UploadStagingBuffer sbuf;
+  if (!dev.AcquireUploadStagingBuffer(size, &sbuf))
     return VK_NULL_HANDLE;
-  }
 
-  // Immediately queue it for freeing after the command buffer finishes, since it's only needed for the copy.
-  VulkanDevice::GetInstance().DeferBufferDestruction(buffer, allocation);
+  CopyTextureDataForUpload(sbuf.map_ptr, data, width, height, pitch, upload_pitch);
 
-  // And write the data.
-  CopyTextureDataForUpload(ai.pMappedData, data, width, height, pitch, upload_pitch);
-  vmaFlushAllocation(VulkanDevice::GetInstance().GetAllocator(), allocation, 0, size);
-  return buffer;
+  // Immediately queue it for recycling after the command buffer finishes, since it's only needed for the copy.
+  dev.ReleaseUploadStagingBuffer(sbuf, size);
+  return sbuf.buffer;
 }
 
 void VulkanTexture::UpdateFromBuffer(VkCommandBuffer cmdbuf, u32 x, u32 y, u32 width, u32 height, u32 layer, u32 level,
@@ -300,6 +278,69 @@ void VulkanTexture::UpdateFromBuffer(VkCommandBuffer cmdbuf, u32 x, u32 y, u32 w
     TransitionSubresourcesToLayout(cmdbuf, layer, 1, level, 1, Layout::TransferDst, old_layout);
 }
 
+void VulkanTexture::UpdateFromTransferQueue(u32 pitch, VkBuffer buffer, u32 buffer_offset)
+{
+  VulkanDevice& dev = VulkanDevice::GetInstance();
+  const VkCommandBuffer tcmdbuf = dev.GetCurrentTransferCommandBuffer();
+  constexpr VkImageSubresourceRange srr = {VK_IMAGE_ASPECT_COLOR_BIT, 0u, 1u, 0u, 1u};
+
+  // Old contents are discarded, so transition away from UNDEFINED regardless of the tracked layout.
+  // Only transfer-legal stages can be used on this queue.
+  const VkImageMemoryBarrier to_transfer_dst = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                                                nullptr,
+                                                0u,
+                                                VK_ACCESS_TRANSFER_WRITE_BIT,
+                                                VK_IMAGE_LAYOUT_UNDEFINED,
+                                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                VK_QUEUE_FAMILY_IGNORED,
+                                                VK_QUEUE_FAMILY_IGNORED,
+                                                m_image,
+                                                srr};
+  vkCmdPipelineBarrier(tcmdbuf, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+                       nullptr, 1, &to_transfer_dst);
+
+  const VkBufferImageCopy bic = {static_cast<VkDeviceSize>(buffer_offset),
+                                 pitch / GetPixelSize(),
+                                 m_height,
+                                 {VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u},
+                                 {0, 0, 0},
+                                 {m_width, m_height, 1u}};
+  vkCmdCopyBufferToImage(tcmdbuf, buffer, m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &bic);
+
+  // Release ownership to the graphics queue family...
+  const VkImageMemoryBarrier release = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                                        nullptr,
+                                        VK_ACCESS_TRANSFER_WRITE_BIT,
+                                        0u,
+                                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                        dev.GetTransferQueueFamilyIndex(),
+                                        dev.GetGraphicsQueueFamilyIndex(),
+                                        m_image,
+                                        srr};
+  vkCmdPipelineBarrier(tcmdbuf, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0,
+                       nullptr, 1, &release);
+
+  // ... with the matching acquire in the init buffer, which executes after the semaphore wait.
+  const VkImageMemoryBarrier acquire = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                                        nullptr,
+                                        0u,
+                                        VK_ACCESS_SHADER_READ_BIT,
+                                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                        dev.GetTransferQueueFamilyIndex(),
+                                        dev.GetGraphicsQueueFamilyIndex(),
+                                        m_image,
+                                        srr};
+  vkCmdPipelineBarrier(dev.GetCurrentInitCommandBuffer(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                       VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &acquire);
+
+  // A second update in the same command buffer has to take the graphics-queue path, otherwise the
+  // single release above would need to pair with multiple acquires.
+  m_use_fence_counter = dev.GetCurrentFenceCounter();
+  m_layout = Layout::ShaderReadOnly;
+}
+
 bool VulkanTexture::Update(u32 x, u32 y, u32 width, u32 height, const void* data, u32 pitch, u32 layer, u32 level)
 {
   DebugAssert(layer < m_layers && level < m_levels);
@@ -342,6 +383,17 @@ bool VulkanTexture::Update(u32 x, u32 y, u32 width, u32 height, const void* data
   GPUDevice::GetStatistics().buffer_streamed += required_size;
   GPUDevice::GetStatistics().num_uploads++;
 
+  // Full-texture uploads can go to the dedicated transfer queue, overlapping the copy with rendering.
+  // Contents are replaced wholesale, so there's no need to acquire the old contents from the graphics
+  // queue family, only to release the new ones back to it.
+  if (dev.HasTransferQueue() && (m_type == Type::Texture || m_type == Type::DynamicTexture) &&
+      m_use_fence_counter != dev.GetCurrentFenceCounter() && x == 0 && y == 0 && width == m_width &&
+      height == m_height && m_layers == 1 && m_levels == 1)
+  {
+    UpdateFromTransferQueue(upload_pitch, buffer, buffer_offset);
+    return true;
+  }
+
   const VkCommandBuffer cmdbuf = GetCommandBufferForUpdate();
 
   // if we're an rt and have been cleared, and the full rect isn't being uploaded, do the clear
@@ -1156,6 +1208,11 @@ void VulkanDownloadTexture::Flush()
     dev.WaitForFenceCounter(m_copy_fence_counter);
 }
 
+bool VulkanDownloadTexture::IsDataReady()
+{
+  return (!m_needs_flush || VulkanDevice::GetInstance().GetCompletedFenceCounter() >= m_copy_fence_counter);
+}
+
 void VulkanDownloadTexture::SetDebugName(std::string_view name)
 {
   if (name.empty())
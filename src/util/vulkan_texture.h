@@ -86,6 +86,7 @@ private:
   VkBuffer AllocateUploadStagingBuffer(const void* data, u32 pitch, u32 upload_pitch, u32 width, u32 height) const;
   void UpdateFromBuffer(VkCommandBuffer cmdbuf, u32 x, u32 y, u32 width, u32 height, u32 layer, u32 level, u32 pitch,
                         VkBuffer buffer, u32 buffer_offset);
+  void UpdateFromTransferQueue(u32 pitch, VkBuffer buffer, u32 buffer_offset);
 
   VkImage m_image = VK_NULL_HANDLE;
   VmaAllocation m_allocation = VK_NULL_HANDLE;
@@ -166,6 +167,7 @@ public:
   void Unmap() override;
 
   void Flush() override;
+  bool IsDataReady() override;
 
   void SetDebugName(std::string_view name) override;
 
@@ -4,6 +4,9 @@
 #include "wav_writer.h"
 #include "common/file_system.h"
 #include "common/log.h"
+
+#include <algorithm>
+
 Log_SetChannel(WAVWriter);
 
 namespace {
@@ -43,7 +46,7 @@ WAVWriter::~WAVWriter()
     Close();
 }
 
-bool WAVWriter::Open(const char* filename, u32 sample_rate, u32 num_channels)
+bool WAVWriter::Open(const char* filename, u32 sample_rate, u32 num_channels, u32 buffer_frames)
 {
   if (IsOpen())
     Close();
@@ -65,6 +68,9 @@ bool WAVWriter::Open(const char* filename, u32 sample_rate, u32 num_channels)
     return false;
   }
 
+  if (buffer_frames > 0)
+    StartFlushThread(buffer_frames);
+
   return true;
 }
 
@@ -73,6 +79,8 @@ void WAVWriter::Close()
   if (!IsOpen())
     return;
 
+  StopFlushThread();
+
   if (std::fseek(m_file, 0, SEEK_SET) != 0 || !WriteHeader())
     Log_ErrorPrintf("Failed to re-write header on file, file may be unplayable");
 
@@ -85,12 +93,115 @@ void WAVWriter::Close()
 
 void WAVWriter::WriteFrames(const s16* samples, u32 num_frames)
 {
+  if (!m_flush_thread_started)
+  {
+    const u32 num_frames_written =
+      static_cast<u32>(std::fwrite(samples, sizeof(s16) * m_num_channels, num_frames, m_file));
+    if (num_frames_written != num_frames)
+      Log_ErrorPrintf("Only wrote %u of %u frames to output file", num_frames_written, num_frames);
+
+    m_num_frames += num_frames_written;
+    return;
+  }
+
+  const u32 capacity = static_cast<u32>(m_write_buffer.capacity());
+  u32 remaining_samples = num_frames * m_num_channels;
+  while (remaining_samples > 0)
+  {
+    const u32 this_copy = std::min(capacity - static_cast<u32>(m_write_buffer.size()), remaining_samples);
+    m_write_buffer.insert(m_write_buffer.end(), samples, samples + this_copy);
+    samples += this_copy;
+    remaining_samples -= this_copy;
+
+    if (static_cast<u32>(m_write_buffer.size()) == capacity)
+      QueueBufferFlush();
+  }
+
+  m_num_frames += num_frames;
+}
+
+void WAVWriter::WriteBufferToFile(const std::vector<SampleType>& buffer)
+{
+  const u32 num_frames = static_cast<u32>(buffer.size()) / m_num_channels;
   const u32 num_frames_written =
-    static_cast<u32>(std::fwrite(samples, sizeof(s16) * m_num_channels, num_frames, m_file));
+    static_cast<u32>(std::fwrite(buffer.data(), sizeof(SampleType) * m_num_channels, num_frames, m_file));
   if (num_frames_written != num_frames)
     Log_ErrorPrintf("Only wrote %u of %u frames to output file", num_frames_written, num_frames);
+}
+
+void WAVWriter::QueueBufferFlush()
+{
+  std::unique_lock<std::mutex> lock(m_flush_mutex);
+
+  // Both buffers full means the storage can't keep up; this is the only case where the caller has to wait.
+  if (m_flush_pending)
+  {
+    Log_WarningPrintf("Flush thread is not keeping up, waiting for the previous buffer to be written");
+    m_flush_done.wait(lock, [this]() { return !m_flush_pending; });
+  }
+
+  m_write_buffer.swap(m_flush_buffer);
+  m_flush_pending = true;
+  m_flush_thread_wake.notify_one();
+}
+
+void WAVWriter::StartFlushThread(u32 buffer_frames)
+{
+  const u32 buffer_samples = buffer_frames * m_num_channels;
+  m_write_buffer.reserve(buffer_samples);
+  m_flush_buffer.reserve(buffer_samples);
+  m_flush_pending = false;
+  m_flush_thread_shutdown = false;
+  m_flush_thread_started = m_flush_thread.Start([this]() { FlushThreadEntryPoint(); });
+  if (!m_flush_thread_started)
+  {
+    Log_ErrorPrintf("Failed to start flush thread, falling back to synchronous writes.");
+    m_write_buffer = {};
+    m_flush_buffer = {};
+  }
+}
+
+void WAVWriter::StopFlushThread()
+{
+  if (!m_flush_thread_started)
+    return;
 
-  m_num_frames += num_frames_written;
+  {
+    std::unique_lock<std::mutex> lock(m_flush_mutex);
+    m_flush_thread_shutdown = true;
+    m_flush_thread_wake.notify_one();
+  }
+
+  m_flush_thread.Join();
+  m_flush_thread_started = false;
+
+  // anything left in the write buffer goes out synchronously
+  if (!m_write_buffer.empty())
+    WriteBufferToFile(m_write_buffer);
+  m_write_buffer = {};
+  m_flush_buffer = {};
+}
+
+void WAVWriter::FlushThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("WAV Flush");
+
+  std::unique_lock<std::mutex> lock(m_flush_mutex);
+  for (;;)
+  {
+    m_flush_thread_wake.wait(lock, [this]() { return (m_flush_pending || m_flush_thread_shutdown); });
+    if (!m_flush_pending)
+      break;
+
+    // The producer won't touch the flush buffer while the flush is pending, so write it without the lock.
+    lock.unlock();
+    WriteBufferToFile(m_flush_buffer);
+    lock.lock();
+
+    m_flush_buffer.clear();
+    m_flush_pending = false;
+    m_flush_done.notify_one();
+  }
 }
 
 bool WAVWriter::WriteHeader()
@@ -2,12 +2,21 @@
 // SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
 
 #pragma once
+#include "common/threading.h"
 #include "common/types.h"
+#include <condition_variable>
 #include <cstdio>
+#include <mutex>
+#include <vector>
 
 class WAVWriter
 {
 public:
+  enum : u32
+  {
+    DEFAULT_BUFFER_FRAMES = 32768,
+  };
+
   WAVWriter();
   ~WAVWriter();
 
@@ -16,7 +25,7 @@ public:
   ALWAYS_INLINE u32 GetNumFrames() const { return m_num_frames; }
   ALWAYS_INLINE bool IsOpen() const { return (m_file != nullptr); }
 
-  bool Open(const char* filename, u32 sample_rate, u32 num_channels);
+  bool Open(const char* filename, u32 sample_rate, u32 num_channels, u32 buffer_frames = DEFAULT_BUFFER_FRAMES);
   void Close();
 
   void WriteFrames(const s16* samples, u32 num_frames);
@@ -25,9 +34,26 @@ private:
   using SampleType = s16;
 
   bool WriteHeader();
+  void WriteBufferToFile(const std::vector<SampleType>& buffer);
+  void QueueBufferFlush();
+  void StartFlushThread(u32 buffer_frames);
+  void StopFlushThread();
+  void FlushThreadEntryPoint();
 
   std::FILE* m_file = nullptr;
   u32 m_sample_rate = 0;
   u32 m_num_channels = 0;
   u32 m_num_frames = 0;
+
+  // Frames are appended to the write buffer without locking; when it fills, the buffers are swapped under the
+  // mutex and the flush thread writes the full one out, so slow storage never stalls the caller.
+  Threading::Thread m_flush_thread;
+  std::mutex m_flush_mutex;
+  std::condition_variable m_flush_thread_wake;
+  std::condition_variable m_flush_done;
+  bool m_flush_pending = false;
+  bool m_flush_thread_shutdown = false;
+  bool m_flush_thread_started = false;
+  std::vector<SampleType> m_write_buffer;
+  std::vector<SampleType> m_flush_buffer;
 };
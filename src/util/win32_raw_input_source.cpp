@@ -5,12 +5,12 @@
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 #include "core/host.h"
 #include "core/system.h"
 #include "input_manager.h"
 #include <cmath>
 #include <hidusage.h>
-#include <malloc.h>
 
 Log_SetChannel(Win32RawInputSource);
 
@@ -22,27 +22,25 @@ static constexpr const u32 ALL_BUTTON_MASKS = RI_MOUSE_BUTTON_1_DOWN | RI_MOUSE_
                                               RI_MOUSE_BUTTON_4_DOWN | RI_MOUSE_BUTTON_4_UP | RI_MOUSE_BUTTON_5_DOWN |
                                               RI_MOUSE_BUTTON_5_UP;
 
+// Window between queue drains on the message thread. An 8KHz mouse then costs one wakeup and one
+// buffered read per interval, instead of a window-procedure round trip for every packet.
+static constexpr DWORD POLL_INTERVAL_MS = 2;
+
 Win32RawInputSource::Win32RawInputSource() = default;
 
 Win32RawInputSource::~Win32RawInputSource() = default;
 
 bool Win32RawInputSource::Initialize(SettingsInterface& si, std::unique_lock<std::mutex>& settings_lock)
 {
-  if (!RegisterDummyClass())
-  {
-    Log_ErrorPrintf("(Win32RawInputSource) Failed to register dummy window class");
-    return false;
-  }
-
-  if (!CreateDummyWindow())
-  {
-    Log_ErrorPrintf("(Win32RawInputSource) Failed to create dummy window");
-    return false;
-  }
-
-  if (!OpenDevices())
+  // The dummy window has to be created on the message thread, since raw input is delivered to the
+  // queue of the thread which created the registered window. The thread reports back whether
+  // window/device setup succeeded before we return.
+  std::promise<bool> init_result;
+  std::future<bool> init_future = init_result.get_future();
+  m_message_thread = std::thread(&Win32RawInputSource::MessageThreadProc, this, &init_result);
+  if (!init_future.get())
   {
-    Log_ErrorPrintf("(Win32RawInputSource) Failed to open devices");
+    m_message_thread.join();
     return false;
   }
 
@@ -60,13 +58,17 @@ bool Win32RawInputSource::ReloadDevices()
 
 void Win32RawInputSource::Shutdown()
 {
-  CloseDevices();
-  DestroyDummyWindow();
+  if (!m_message_thread.joinable())
+    return;
+
+  // The thread unregisters the devices and destroys the window on its way out.
+  PostThreadMessageW(m_message_thread_id, WM_QUIT, 0, 0);
+  m_message_thread.join();
 }
 
 void Win32RawInputSource::PollEvents()
 {
-  // noop, handled by message pump
+  // noop, handled by the message thread
 }
 
 std::vector<std::pair<std::string, std::string>> Win32RawInputSource::EnumerateDevices()
@@ -125,11 +127,7 @@ bool Win32RawInputSource::CreateDummyWindow()
 {
   m_dummy_window = CreateWindowExW(0, WINDOW_CLASS_NAME, WINDOW_CLASS_NAME, WS_OVERLAPPED, CW_USEDEFAULT, CW_USEDEFAULT,
                                    CW_USEDEFAULT, CW_USEDEFAULT, HWND_MESSAGE, NULL, GetModuleHandleW(nullptr), NULL);
-  if (!m_dummy_window)
-    return false;
-
-  SetWindowLongPtrW(m_dummy_window, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
-  return true;
+  return (m_dummy_window != NULL);
 }
 
 void Win32RawInputSource::DestroyDummyWindow()
@@ -143,22 +141,122 @@ void Win32RawInputSource::DestroyDummyWindow()
 
 LRESULT CALLBACK Win32RawInputSource::DummyWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
-  if (msg != WM_INPUT)
-    return DefWindowProcW(hwnd, msg, wParam, lParam);
+  // WM_INPUT never makes it here - the message thread pulls the packets out of the queue in bulk
+  // with GetRawInputBuffer() and removes the messages without dispatching them.
+  return DefWindowProcW(hwnd, msg, wParam, lParam);
+}
 
-  UINT size = 0;
-  GetRawInputData((HRAWINPUT)lParam, RID_INPUT, nullptr, &size, sizeof(RAWINPUTHEADER));
+void Win32RawInputSource::MessageThreadProc(std::promise<bool>* init_result)
+{
+  Threading::SetNameOfCurrentThread("Win32 Raw Input");
+  m_message_thread_id = GetCurrentThreadId();
 
-  PRAWINPUT data = static_cast<PRAWINPUT>(_alloca(size));
-  GetRawInputData((HRAWINPUT)lParam, RID_INPUT, data, &size, sizeof(RAWINPUTHEADER));
+  bool initialized = false;
+  if (!RegisterDummyClass())
+    Log_ErrorPrintf("(Win32RawInputSource) Failed to register dummy window class");
+  else if (!CreateDummyWindow())
+    Log_ErrorPrintf("(Win32RawInputSource) Failed to create dummy window");
+  else if (!OpenDevices())
+    Log_ErrorPrintf("(Win32RawInputSource) Failed to open devices");
+  else
+    initialized = true;
+
+  init_result->set_value(initialized);
+  if (!initialized)
+  {
+    DestroyDummyWindow();
+    return;
+  }
+
+  for (;;)
+  {
+    if (MsgWaitForMultipleObjects(0, nullptr, FALSE, INFINITE, QS_ALLINPUT) == WAIT_FAILED)
+      break;
 
-  // we shouldn't get any WM_INPUT messages prior to SetWindowLongPtr(), so this'll be fine
-  Win32RawInputSource* ris = reinterpret_cast<Win32RawInputSource*>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
-  if (ris->ProcessRawInputEvent(data))
-    return 0;
+    // Give a burst a chance to accumulate in the queue instead of waking once per packet.
+    Sleep(POLL_INTERVAL_MS);
 
-  // forward through to normal message processing
-  return DefWindowProcW(hwnd, msg, wParam, lParam);
+    DrainBufferedRawInput();
+
+    // Remove the WM_INPUT messages whose payloads the buffered read just consumed, and pump
+    // anything else (e.g. the WM_QUIT posted by Shutdown()) as normal.
+    bool quit = false;
+    MSG msg;
+    while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
+    {
+      if (msg.message == WM_QUIT)
+      {
+        quit = true;
+        break;
+      }
+      else if (msg.message == WM_INPUT)
+      {
+        continue;
+      }
+
+      TranslateMessage(&msg);
+      DispatchMessageW(&msg);
+    }
+    if (quit)
+      break;
+
+    // Pick up packets which arrived between the drain and the peek above, since their messages
+    // are gone and won't wake us again.
+    DrainBufferedRawInput();
+
+    // One coalesced delta per mouse per interval, instead of one per packet.
+    FlushCoalescedDeltas();
+  }
+
+  CloseDevices();
+  DestroyDummyWindow();
+}
+
+bool Win32RawInputSource::DrainBufferedRawInput()
+{
+  bool processed_any = false;
+  for (;;)
+  {
+    alignas(8) u8 buffer[4096];
+    UINT size = sizeof(buffer);
+    const UINT count = GetRawInputBuffer(reinterpret_cast<PRAWINPUT>(buffer), &size, sizeof(RAWINPUTHEADER));
+    if (count == 0 || count == static_cast<UINT>(-1))
+      break;
+
+    PRAWINPUT event = reinterpret_cast<PRAWINPUT>(buffer);
+    for (UINT i = 0; i < count; i++)
+    {
+      ProcessRawInputEvent(event);
+      event = NEXTRAWINPUTBLOCK(event);
+    }
+
+    processed_any = true;
+  }
+
+  return processed_any;
+}
+
+void Win32RawInputSource::FlushCoalescedDelta(u32 mouse_index, MouseState& state)
+{
+  if (state.pending_dx != 0)
+  {
+    InputManager::UpdatePointerRelativeDelta(mouse_index, InputPointerAxis::X, static_cast<float>(state.pending_dx),
+                                             true);
+    state.pending_dx = 0;
+  }
+  if (state.pending_dy != 0)
+  {
+    InputManager::UpdatePointerRelativeDelta(mouse_index, InputPointerAxis::Y, static_cast<float>(state.pending_dy),
+                                             true);
+    state.pending_dy = 0;
+  }
+}
+
+void Win32RawInputSource::FlushCoalescedDeltas()
+{
+  const u32 mouse_index = 0;
+  for (MouseState& state : m_mice)
+    FlushCoalescedDelta(mouse_index, state);
 }
 
 bool Win32RawInputSource::OpenDevices()
@@ -180,7 +278,7 @@ bool Win32RawInputSource::OpenDevices()
       m_num_keyboards++;
 #endif
     if (rid.dwType == RIM_TYPEMOUSE)
-      m_mice.push_back({rid.hDevice, 0u, 0, 0});
+      m_mice.push_back({rid.hDevice});
   }
 
   Log_DevPrintf("(Win32RawInputSource) Found %u keyboards and %zu mice", m_num_keyboards, m_mice.size());
@@ -245,28 +343,34 @@ bool Win32RawInputSource::ProcessRawInputEvent(const RAWINPUT* event)
         (rm.usButtonFlags & (rm.usButtonFlags ^ std::exchange(state.button_state, rm.usButtonFlags))) &
         ALL_BUTTON_MASKS;
 
-      // when the VM isn't running, allow events to run as normal (so we don't break the UI)
+      // when the VM isn't running, drop the events (so we don't break the UI)
       if (System::GetState() != System::State::Running)
         return false;
 
-      while (button_mask != 0)
+      if (button_mask != 0)
       {
-        unsigned long bit_index;
-        _BitScanForward(&bit_index, button_mask);
-
-        // these are ordered down..up for each button
-        const u32 button_number = bit_index >> 1;
-        const bool button_pressed = (bit_index & 1u) != 0;
-        InputManager::InvokeEvents(InputManager::MakePointerButtonKey(mouse_index, button_number),
+        // Deliver any movement accumulated so far before the edge, so a flick-and-click lands
+        // where the flick ended.
+        FlushCoalescedDelta(mouse_index, state);
+
+        while (button_mask != 0)
+        {
+          unsigned long bit_index;
+          _BitScanForward(&bit_index, button_mask);
+
+          // these are ordered down..up for each button
+          const u32 button_number = bit_index >> 1;
+          const bool button_pressed = (bit_index & 1u) != 0;
+          InputManager::QueueEvent(InputManager::MakePointerButtonKey(mouse_index, button_number),
                                    static_cast<float>(button_pressed), GenericInputBinding::Unknown);
 
-        button_mask &= ~(1u << bit_index);
+          button_mask &= ~(1u << bit_index);
+        }
       }
 
-      if (dx != 0)
-        InputManager::UpdatePointerRelativeDelta(mouse_index, InputPointerAxis::X, static_cast<float>(dx), true);
-      if (dy != 0)
-        InputManager::UpdatePointerRelativeDelta(mouse_index, InputPointerAxis::Y, static_cast<float>(dy), true);
+      // Movement is coalesced and delivered once per poll interval by the message thread.
+      state.pending_dx += dx;
+      state.pending_dy += dy;
 
       return true;
     }
@@ -6,7 +6,9 @@
 #include "input_source.h"
 #include <array>
 #include <functional>
+#include <future>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 class SettingsInterface;
@@ -38,10 +40,14 @@ public:
 private:
   struct MouseState
   {
-    HANDLE device;
-    u32 button_state;
-    s32 last_x;
-    s32 last_y;
+    HANDLE device = nullptr;
+    u32 button_state = 0;
+    s32 last_x = 0;
+    s32 last_y = 0;
+
+    // Deltas accumulated from buffered reads, delivered once per poll interval.
+    s32 pending_dx = 0;
+    s32 pending_dy = 0;
   };
 
   static bool RegisterDummyClass();
@@ -52,10 +58,18 @@ private:
   bool OpenDevices();
   void CloseDevices();
 
+  void MessageThreadProc(std::promise<bool>* init_result);
+  bool DrainBufferedRawInput();
+  void FlushCoalescedDelta(u32 mouse_index, MouseState& state);
+  void FlushCoalescedDeltas();
+
   bool ProcessRawInputEvent(const RAWINPUT* event);
 
   HWND m_dummy_window = {};
   u32 m_num_keyboards = 0;
 
   std::vector<MouseState> m_mice;
+
+  std::thread m_message_thread;
+  DWORD m_message_thread_id = 0;
 };
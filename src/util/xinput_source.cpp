@@ -10,6 +10,7 @@
 
 #include "IconsPromptFont.h"
 
+#include <bit>
 #include <cmath>
 
 Log_SetChannel(XInputSource);
@@ -56,7 +57,7 @@ static const char* s_button_names[XInputSource::NUM_BUTTONS] = {
   "Y",             // XINPUT_GAMEPAD_Y
   "Guide",         // XINPUT_GAMEPAD_GUIDE
 };
-static const u16 s_button_masks[XInputSource::NUM_BUTTONS] = {
+static constexpr u16 s_button_masks[XInputSource::NUM_BUTTONS] = {
   XINPUT_GAMEPAD_DPAD_UP,
   XINPUT_GAMEPAD_DPAD_DOWN,
   XINPUT_GAMEPAD_DPAD_LEFT,
@@ -73,6 +74,27 @@ static const u16 s_button_masks[XInputSource::NUM_BUTTONS] = {
   XINPUT_GAMEPAD_Y,
   0x400, // XINPUT_GAMEPAD_GUIDE
 };
+
+// Button number for each wButtons bit, so state changes only walk the bits that actually
+// flipped instead of comparing all buttons. 0xFF = bit has no button.
+static constexpr std::array<u8, 16> MakeButtonNumbersByBit()
+{
+  std::array<u8, 16> ret = {};
+  for (u32 bit = 0; bit < 16; bit++)
+  {
+    ret[bit] = 0xFF;
+    for (u32 button = 0; button < XInputSource::NUM_BUTTONS; button++)
+    {
+      if (s_button_masks[button] == (1u << bit))
+      {
+        ret[bit] = static_cast<u8>(button);
+        break;
+      }
+    }
+  }
+  return ret;
+}
+static constexpr std::array<u8, 16> s_button_numbers_by_bit = MakeButtonNumbersByBit();
 static constexpr const char* s_button_icons[] = {
   ICON_PF_XBOX_DPAD_UP,       // XINPUT_GAMEPAD_DPAD_UP
   ICON_PF_XBOX_DPAD_DOWN,     // XINPUT_GAMEPAD_DPAD_DOWN
@@ -219,9 +241,8 @@ void XInputSource::PollEvents()
 
     if (result == ERROR_SUCCESS)
     {
-      if (!was_connected)
-        HandleControllerConnection(i);
-
+      // Packet number comparison inside makes unchanged states cheap - we bail before
+      // any button/axis comparisons.
       CheckForStateChanges(i, new_state);
     }
     else
@@ -474,23 +495,23 @@ void XInputSource::CheckForStateChanges(u32 index, const XINPUT_STATE& new_state
 
 #undef CHECK_AXIS
 
-  const u16 old_button_bits = ogp.wButtons;
   const u16 new_button_bits = ngp.wButtons;
-  if (old_button_bits != new_button_bits)
+  u16 changed_button_bits = ogp.wButtons ^ new_button_bits;
+  while (changed_button_bits != 0)
   {
-    for (u32 button = 0; button < NUM_BUTTONS; button++)
-    {
-      const u16 button_mask = s_button_masks[button];
-      if ((old_button_bits & button_mask) != (new_button_bits & button_mask))
-      {
-        const GenericInputBinding generic_key = (button < std::size(s_xinput_generic_binding_button_mapping)) ?
-                                                  s_xinput_generic_binding_button_mapping[button] :
-                                                  GenericInputBinding::Unknown;
-        const float value = ((new_button_bits & button_mask) != 0) ? 1.0f : 0.0f;
-        InputManager::InvokeEvents(MakeGenericControllerButtonKey(InputSourceType::XInput, index, button), value,
-                                   generic_key);
-      }
-    }
+    const u32 bit_index = std::countr_zero(changed_button_bits);
+    changed_button_bits &= static_cast<u16>(changed_button_bits - 1u);
+
+    const u8 button = s_button_numbers_by_bit[bit_index];
+    if (button == 0xFF)
+      continue;
+
+    const GenericInputBinding generic_key = (button < std::size(s_xinput_generic_binding_button_mapping)) ?
+                                              s_xinput_generic_binding_button_mapping[button] :
+                                              GenericInputBinding::Unknown;
+    const float value = ((new_button_bits & (1u << bit_index)) != 0) ? 1.0f : 0.0f;
+    InputManager::InvokeEvents(MakeGenericControllerButtonKey(InputSourceType::XInput, index, button), value,
+                               generic_key);
   }
 
   cd.last_state = new_state;
@@ -46,6 +46,21 @@ public:
   {
     u32 remaining = ByteCount;
     const u8* read_ptr = static_cast<const u8*>(pSource);
+
+    // Feed large blocks (system RAM, VRAM, etc in save states) to the compressor directly from the
+    // caller's buffer instead of staging them. Flush anything already buffered first so the output
+    // ordering is preserved.
+    if (remaining >= INPUT_BUFFER_SIZE)
+    {
+      if (m_input_buffer_wpos > 0 && !Compress(ZSTD_e_continue))
+        return 0;
+      if (!CompressBuffer(read_ptr, remaining, ZSTD_e_continue))
+        return 0;
+
+      m_position += remaining;
+      return ByteCount;
+    }
+
     for (;;)
     {
       const u32 copy_size = std::min(INPUT_BUFFER_SIZE - m_input_buffer_wpos, remaining);
@@ -92,11 +107,21 @@ private:
   };
 
   bool Compress(ZSTD_EndDirective action)
+  {
+    if (!CompressBuffer(m_input_buffer, m_input_buffer_wpos, action))
+      return false;
+
+    m_position += m_input_buffer_wpos;
+    m_input_buffer_wpos = 0;
+    return true;
+  }
+
+  bool CompressBuffer(const void* data, size_t size, ZSTD_EndDirective action)
   {
     if (m_errorState || m_done)
       return false;
 
-    ZSTD_inBuffer inbuf = {m_input_buffer, m_input_buffer_wpos, 0};
+    ZSTD_inBuffer inbuf = {data, size, 0};
 
     for (;;)
     {
@@ -139,8 +164,6 @@ private:
       }
     }
 
-    m_position += m_input_buffer_wpos;
-    m_input_buffer_wpos = 0;
     return true;
   }
 